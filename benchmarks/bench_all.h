@@ -17,6 +17,7 @@ int benchmark_filters_comprehensive(void);
 int benchmark_moving_average(void);
 int benchmark_adaptive_filter(void);
 int benchmark_convolution(void);
+int benchmark_channel_estimation(void);
 
 /* Modulation and FEC Benchmarks */
 int benchmark_modulation_comprehensive(void);
@@ -116,11 +116,8 @@ static int run_fft_benchmark(size_t fft_size, int num_threads,
                                  mem_after - mem_before : 0;
     
     // Calculate statistics
-    benchmark_calculate_statistics(times, BENCHMARK_ITERATIONS,
-                                   &metrics->avg_time_ms,
-                                   &metrics->stddev_time_ms,
-                                   &metrics->min_time_ms,
-                                   &metrics->max_time_ms);
+    benchmark_metrics_finalize(metrics, times, BENCHMARK_ITERATIONS, &timer,
+                               "fft_%zu_%dthreads", fft_size, num_threads);
     
     // Calculate throughput (samples per second)
     metrics->throughput_samples_sec = 
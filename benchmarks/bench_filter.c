@@ -3,13 +3,15 @@
  * @brief Filter performance benchmarks
  * 
  * Benchmarks filtering operations including moving average, adaptive filter,
- * and convolution with various window sizes and data lengths.
+ * convolution and least-squares channel estimation with various window
+ * sizes and data lengths.
  */
 
 #include "benchmark.h"
 #include "../src/signal_processing/signal_processing.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 /* ============================================================================
  * Filter Benchmark Configuration
@@ -24,6 +26,9 @@ static const int NUM_WINDOW_SIZES = 5;
 static const int FILTER_LENGTHS[] = {16, 32, 64, 128};
 static const int NUM_FILTER_LENGTHS = 4;
 
+static const size_t CHANNEL_LENGTHS[] = {8, 32, 128, 512};
+static const int NUM_CHANNEL_LENGTHS = 4;
+
 static const int BENCHMARK_ITERATIONS = 100;
 static const int WARMUP_ITERATIONS = 10;
 
@@ -98,11 +103,9 @@ static int run_moving_average_benchmark(size_t data_length, int window_size,
     }
     
     // Calculate statistics
-    benchmark_calculate_statistics(times, BENCHMARK_ITERATIONS,
-                                   &metrics->avg_time_ms,
-                                   &metrics->stddev_time_ms,
-                                   &metrics->min_time_ms,
-                                   &metrics->max_time_ms);
+    benchmark_metrics_finalize(metrics, times, BENCHMARK_ITERATIONS, &timer,
+                               "moving_average_%zu_w%d_%dthreads",
+                               data_length, window_size, num_threads);
     
     // Calculate throughput
     metrics->throughput_samples_sec = 
@@ -282,11 +285,9 @@ static int run_adaptive_filter_benchmark(size_t data_length, int filter_length,
     }
     
     // Calculate statistics
-    benchmark_calculate_statistics(times, BENCHMARK_ITERATIONS,
-                                   &metrics->avg_time_ms,
-                                   &metrics->stddev_time_ms,
-                                   &metrics->min_time_ms,
-                                   &metrics->max_time_ms);
+    benchmark_metrics_finalize(metrics, times, BENCHMARK_ITERATIONS, &timer,
+                               "adaptive_filter_%zu_l%d_%dthreads",
+                               data_length, filter_length, num_threads);
     
     // Calculate throughput
     metrics->throughput_samples_sec = 
@@ -463,11 +464,9 @@ static int run_convolution_benchmark(size_t signal_length, size_t kernel_length,
     }
     
     // Calculate statistics
-    benchmark_calculate_statistics(times, BENCHMARK_ITERATIONS,
-                                   &metrics->avg_time_ms,
-                                   &metrics->stddev_time_ms,
-                                   &metrics->min_time_ms,
-                                   &metrics->max_time_ms);
+    benchmark_metrics_finalize(metrics, times, BENCHMARK_ITERATIONS, &timer,
+                               "convolution_%zu_k%zu_%dthreads",
+                               signal_length, kernel_length, num_threads);
     
     // Calculate throughput
     metrics->throughput_samples_sec = 
@@ -528,6 +527,134 @@ int benchmark_convolution(void) {
     return FSO_SUCCESS;
 }
 
+/* ============================================================================
+ * Channel Estimation Benchmark
+ * ============================================================================ */
+
+/**
+ * @brief Run least-squares channel estimation benchmark
+ */
+static int run_channel_estimation_benchmark(size_t signal_length, size_t channel_length,
+                                            PerformanceMetrics* metrics) {
+    SignalProcessor sp;
+    double complex* transmitted = NULL;
+    double complex* received = NULL;
+    double complex* estimate = NULL;
+    double* times = NULL;
+    int result = FSO_SUCCESS;
+    
+    benchmark_metrics_init(metrics);
+    metrics->num_threads = 1;
+    metrics->data_size_bytes = signal_length * sizeof(double complex);
+    metrics->iterations = BENCHMARK_ITERATIONS;
+    
+    transmitted = (double complex*)malloc(signal_length * sizeof(double complex));
+    received = (double complex*)malloc(signal_length * sizeof(double complex));
+    estimate = (double complex*)malloc(channel_length * sizeof(double complex));
+    times = (double*)malloc(BENCHMARK_ITERATIONS * sizeof(double));
+    
+    if (!transmitted || !received || !estimate || !times) {
+        result = FSO_ERROR_MEMORY;
+        goto cleanup;
+    }
+    
+    // Pseudo-random QPSK training sequence through an exponential delay profile
+    unsigned int state = 12345;
+    for (size_t i = 0; i < signal_length; i++) {
+        state = state * 1103515245u + 12345u;
+        transmitted[i] = ((state >> 16) & 1 ? 1.0 : -1.0) +
+                         ((state >> 17) & 1 ? 1.0 : -1.0) * I;
+    }
+    for (size_t n = 0; n < signal_length; n++) {
+        double complex sum = 0.0;
+        for (size_t k = 0; k < channel_length && k <= n; k++) {
+            sum += exp(-(double)k / (double)channel_length) * transmitted[n - k];
+        }
+        received[n] = sum;
+    }
+    
+    if (sp_init(&sp, 1, signal_length) != FSO_SUCCESS) {
+        result = FSO_ERROR_NOT_INITIALIZED;
+        goto cleanup;
+    }
+    
+    // Warmup (plans and workspace are created here)
+    for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+        sp_channel_estimate_ls(&sp, received, transmitted, signal_length,
+                               estimate, channel_length);
+    }
+    
+    BenchmarkTimer timer;
+    benchmark_timer_init(&timer);
+    
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        benchmark_timer_start(&timer);
+        
+        int ls_result = sp_channel_estimate_ls(&sp, received, transmitted, signal_length,
+                                               estimate, channel_length);
+        
+        benchmark_timer_stop(&timer);
+        
+        if (ls_result == FSO_SUCCESS) {
+            metrics->success_count++;
+        } else {
+            metrics->failure_count++;
+        }
+        
+        times[i] = benchmark_timer_elapsed_ms(&timer);
+    }
+    
+    benchmark_metrics_finalize(metrics, times, BENCHMARK_ITERATIONS, &timer,
+                               "channel_ls_%zu_L%zu", signal_length, channel_length);
+    
+    metrics->throughput_samples_sec =
+        benchmark_calculate_throughput_samples(signal_length, metrics->avg_time_ms);
+    
+    sp_free(&sp);
+    
+cleanup:
+    free(transmitted);
+    free(received);
+    free(estimate);
+    free(times);
+    
+    return result;
+}
+
+/**
+ * @brief Benchmark least-squares channel estimation over delay spreads
+ * 
+ * Channels of SP_LS_FFT_MIN_TAPS taps or more take the FFT correlation
+ * path, so the time should grow with the frame length but barely with L.
+ */
+int benchmark_channel_estimation(void) {
+    printf("\n");
+    printf("================================================================================\n");
+    printf("  Channel Estimation Benchmarks\n");
+    printf("================================================================================\n");
+    printf("\n");
+    
+    printf("Testing least-squares estimation (per frame):\n");
+    printf("--------------------------------------------------------------------------------\n");
+    
+    for (int i = 0; i < NUM_DATA_LENGTHS; i++) {
+        size_t signal_length = DATA_LENGTHS[i];
+        
+        printf("  Frame %6zu:", signal_length);
+        for (int j = 0; j < NUM_CHANNEL_LENGTHS; j++) {
+            size_t channel_length = CHANNEL_LENGTHS[j];
+            
+            PerformanceMetrics metrics;
+            run_channel_estimation_benchmark(signal_length, channel_length, &metrics);
+            printf("  L=%-3zu %8.3f ms", channel_length, metrics.avg_time_ms);
+        }
+        printf("\n");
+    }
+    
+    printf("\n");
+    return FSO_SUCCESS;
+}
+
 /**
  * @brief Run all filter benchmarks
  */
@@ -549,5 +676,10 @@ int benchmark_filters_comprehensive(void) {
         return result;
     }
     
+    result = benchmark_channel_estimation();
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
     return FSO_SUCCESS;
 }
@@ -3,11 +3,15 @@
  * @brief Implementation of benchmarking infrastructure
  */
 
+// clock_gettime() and syscall() under -std=c11
+#define _DEFAULT_SOURCE
+
 #include "benchmark.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdarg.h>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -21,6 +25,84 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/* ============================================================================
+ * Hardware Counters
+ * ============================================================================ */
+
+/** Counter file descriptors (-1 when unavailable) */
+static int counter_fds[BENCHMARK_NUM_COUNTERS] = { -1, -1, -1, -1 };
+
+/** Bit mask of open counters, or -1 before the first open */
+static int counter_mask = -1;
+
+static const char* counter_names[BENCHMARK_NUM_COUNTERS] = {
+    "cycles", "instructions", "cache_misses", "branch_misses"
+};
+
+const char* benchmark_counter_name(BenchmarkCounter counter) {
+    if ((int)counter < 0 || counter >= BENCHMARK_NUM_COUNTERS) {
+        return "unknown";
+    }
+    return counter_names[counter];
+}
+
+int benchmark_counters_available(void) {
+    if (counter_mask >= 0) {
+        return counter_mask;
+    }
+    
+    counter_mask = 0;
+#ifdef __linux__
+    static const uint64_t configs[BENCHMARK_NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    
+    for (int i = 0; i < BENCHMARK_NUM_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        
+        counter_fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counter_fds[i] >= 0) {
+            counter_mask |= 1 << i;
+        }
+    }
+#endif
+    
+    if (counter_mask == 0) {
+        FSO_LOG_WARNING("BENCHMARK", "Hardware counters unavailable; timing only");
+    }
+    
+    return counter_mask;
+}
+
+/**
+ * @brief Read the open counters (unavailable ones read as 0)
+ */
+static void benchmark_counters_read(uint64_t values[BENCHMARK_NUM_COUNTERS]) {
+    for (int i = 0; i < BENCHMARK_NUM_COUNTERS; i++) {
+        values[i] = 0;
+#ifdef __linux__
+        if (counter_fds[i] >= 0 && read(counter_fds[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t)) {
+            values[i] = 0;
+        }
+#endif
+    }
+}
+
 /* ============================================================================
  * Timer Functions
  * ============================================================================ */
@@ -30,6 +112,7 @@ int benchmark_timer_init(BenchmarkTimer* timer) {
     
     memset(timer, 0, sizeof(BenchmarkTimer));
     timer->is_running = 0;
+    benchmark_counters_available();
     
     return FSO_SUCCESS;
 }
@@ -37,6 +120,11 @@ int benchmark_timer_init(BenchmarkTimer* timer) {
 int benchmark_timer_start(BenchmarkTimer* timer) {
     FSO_CHECK_NULL(timer);
     
+    // Counters are read outside the timed interval
+    if (counter_mask > 0) {
+        benchmark_counters_read(timer->counter_start);
+    }
+    
     if (clock_gettime(CLOCK_MONOTONIC, &timer->start_time) != 0) {
         FSO_LOG_ERROR("BENCHMARK", "Failed to get start time");
         return FSO_ERROR_IO;
@@ -59,6 +147,15 @@ int benchmark_timer_stop(BenchmarkTimer* timer) {
         return FSO_ERROR_IO;
     }
     
+    if (counter_mask > 0) {
+        uint64_t end[BENCHMARK_NUM_COUNTERS];
+        benchmark_counters_read(end);
+        for (int i = 0; i < BENCHMARK_NUM_COUNTERS; i++) {
+            timer->counter_totals[i] += end[i] - timer->counter_start[i];
+        }
+        timer->counter_intervals++;
+    }
+    
     timer->is_running = 0;
     return FSO_SUCCESS;
 }
@@ -213,6 +310,342 @@ int benchmark_calculate_statistics(const double* times, int count,
     return FSO_SUCCESS;
 }
 
+/**
+ * @brief k-th smallest of values[0..count) (reorders values)
+ */
+static double benchmark_select(double* values, int count, int k) {
+    int lo = 0;
+    int hi = count - 1;
+    while (lo < hi) {
+        double pivot = values[lo + (hi - lo) / 2];
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                double tmp = values[i];
+                values[i] = values[j];
+                values[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return values[k];
+}
+
+/**
+ * @brief Median of values[0..count) (reorders values)
+ */
+static double benchmark_median(double* values, int count) {
+    double upper = benchmark_select(values, count, count / 2);
+    if (count % 2) {
+        return upper;
+    }
+    
+    // The lower middle is the largest value below the upper middle
+    double lower = values[0];
+    for (int i = 1; i < count / 2; i++) {
+        if (values[i] > lower) lower = values[i];
+    }
+    return 0.5 * (lower + upper);
+}
+
+int benchmark_calculate_robust_statistics(const double* times, int count,
+                                          double* median, double* ci_low,
+                                          double* ci_high, int* outliers) {
+    FSO_CHECK_NULL(times);
+    FSO_CHECK_NULL(median);
+    FSO_CHECK_NULL(ci_low);
+    FSO_CHECK_NULL(ci_high);
+    FSO_CHECK_PARAM(count > 0);
+    
+    double* work = (double*)malloc(count * sizeof(double));
+    double* kept = (double*)malloc(count * sizeof(double));
+    double* medians = (double*)malloc(BENCHMARK_BOOTSTRAP_RESAMPLES * sizeof(double));
+    if (!work || !kept || !medians) {
+        free(work);
+        free(kept);
+        free(medians);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    // Median absolute deviation of the raw measurements
+    memcpy(work, times, count * sizeof(double));
+    double center = benchmark_median(work, count);
+    for (int i = 0; i < count; i++) {
+        work[i] = fabs(times[i] - center);
+    }
+    double mad = benchmark_median(work, count);
+    
+    // Reject by modified z-score; a zero MAD keeps everything
+    int num_kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (mad <= 0.0 || 0.6745 * fabs(times[i] - center) / mad <= BENCHMARK_OUTLIER_Z) {
+            kept[num_kept++] = times[i];
+        }
+    }
+    if (outliers) {
+        *outliers = count - num_kept;
+    }
+    
+    memcpy(work, kept, num_kept * sizeof(double));
+    *median = benchmark_median(work, num_kept);
+    
+    // Bootstrap the median with a fixed-seed xorshift generator
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int b = 0; b < BENCHMARK_BOOTSTRAP_RESAMPLES; b++) {
+        for (int i = 0; i < num_kept; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            work[i] = kept[state % (uint64_t)num_kept];
+        }
+        medians[b] = benchmark_median(work, num_kept);
+    }
+    int low_index = (int)(0.025 * BENCHMARK_BOOTSTRAP_RESAMPLES);
+    int high_index = (int)(0.975 * BENCHMARK_BOOTSTRAP_RESAMPLES) - 1;
+    *ci_low = benchmark_select(medians, BENCHMARK_BOOTSTRAP_RESAMPLES, low_index);
+    *ci_high = benchmark_select(medians, BENCHMARK_BOOTSTRAP_RESAMPLES, high_index);
+    
+    free(work);
+    free(kept);
+    free(medians);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Recorded Results
+ * ============================================================================ */
+
+static PerformanceMetrics* recorded_metrics = NULL;
+static char** recorded_labels = NULL;
+static int recorded_count = 0;
+static int recorded_capacity = 0;
+
+/**
+ * @brief Append a copy of metrics under label
+ */
+static int benchmark_results_record(const PerformanceMetrics* metrics, const char* label) {
+    if (recorded_count == recorded_capacity) {
+        int capacity = recorded_capacity ? 2 * recorded_capacity : 32;
+        PerformanceMetrics* grown_metrics = (PerformanceMetrics*)realloc(
+            recorded_metrics, capacity * sizeof(PerformanceMetrics));
+        if (!grown_metrics) {
+            return FSO_ERROR_MEMORY;
+        }
+        recorded_metrics = grown_metrics;
+        char** grown_labels = (char**)realloc(recorded_labels, capacity * sizeof(char*));
+        if (!grown_labels) {
+            return FSO_ERROR_MEMORY;
+        }
+        recorded_labels = grown_labels;
+        recorded_capacity = capacity;
+    }
+    
+    char* copy = (char*)malloc(strlen(label) + 1);
+    if (!copy) {
+        return FSO_ERROR_MEMORY;
+    }
+    strcpy(copy, label);
+    recorded_metrics[recorded_count] = *metrics;
+    recorded_labels[recorded_count] = copy;
+    recorded_count++;
+    
+    return FSO_SUCCESS;
+}
+
+int benchmark_metrics_finalize(PerformanceMetrics* metrics,
+                               const double* times, int count,
+                               BenchmarkTimer* timer,
+                               const char* label_format, ...) {
+    FSO_CHECK_NULL(metrics);
+    FSO_CHECK_NULL(times);
+    FSO_CHECK_NULL(label_format);
+    FSO_CHECK_PARAM(count > 0);
+    
+    int result = benchmark_calculate_statistics(times, count,
+                                                &metrics->avg_time_ms,
+                                                &metrics->stddev_time_ms,
+                                                &metrics->min_time_ms,
+                                                &metrics->max_time_ms);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    result = benchmark_calculate_robust_statistics(times, count,
+                                                   &metrics->median_time_ms,
+                                                   &metrics->ci_low_ms,
+                                                   &metrics->ci_high_ms,
+                                                   &metrics->outlier_count);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    // Per-iteration counter averages; the timer starts over for its next use
+    metrics->counters_valid = 0;
+    memset(metrics->counters, 0, sizeof(metrics->counters));
+    if (timer && timer->counter_intervals > 0) {
+        metrics->counters_valid = benchmark_counters_available();
+        for (int i = 0; i < BENCHMARK_NUM_COUNTERS; i++) {
+            metrics->counters[i] = (double)timer->counter_totals[i] / timer->counter_intervals;
+        }
+    }
+    if (timer) {
+        memset(timer->counter_totals, 0, sizeof(timer->counter_totals));
+        timer->counter_intervals = 0;
+    }
+    
+    char label[128];
+    va_list args;
+    va_start(args, label_format);
+    vsnprintf(label, sizeof(label), label_format, args);
+    va_end(args);
+    
+    return benchmark_results_record(metrics, label);
+}
+
+int benchmark_results_count(void) {
+    return recorded_count;
+}
+
+int benchmark_results_save_json(const char* filename) {
+    FSO_CHECK_NULL(filename);
+    
+    if (recorded_count == 0) {
+        FSO_LOG_WARNING("BENCHMARK", "No recorded results to save");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    return benchmark_save_json(filename, recorded_metrics, recorded_count,
+                               (const char**)recorded_labels);
+}
+
+void benchmark_results_clear(void) {
+    for (int i = 0; i < recorded_count; i++) {
+        free(recorded_labels[i]);
+    }
+    free(recorded_labels);
+    free(recorded_metrics);
+    recorded_labels = NULL;
+    recorded_metrics = NULL;
+    recorded_count = 0;
+    recorded_capacity = 0;
+}
+
+/* ============================================================================
+ * Baseline Comparison
+ * ============================================================================ */
+
+/**
+ * @brief Read a numeric field "key": value between start and end
+ * 
+ * @return 1 with *value set, 0 if the key is absent
+ */
+static int benchmark_json_number(const char* start, const char* end,
+                                 const char* key, double* value) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* found = strstr(start, pattern);
+    if (!found || (end && found >= end)) {
+        return 0;
+    }
+    char* parsed;
+    *value = strtod(found + strlen(pattern), &parsed);
+    return parsed != found + strlen(pattern);
+}
+
+int benchmark_compare_baseline(const char* filename, double threshold, int* regressions) {
+    FSO_CHECK_NULL(filename);
+    FSO_CHECK_NULL(regressions);
+    FSO_CHECK_PARAM(threshold >= 0.0);
+    
+    *regressions = 0;
+    
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        FSO_LOG_ERROR("BENCHMARK", "Failed to open baseline: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char* text = (size > 0) ? (char*)malloc(size + 1) : NULL;
+    if (!text || fread(text, 1, size, fp) != (size_t)size) {
+        FSO_LOG_ERROR("BENCHMARK", "Failed to read baseline: %s", filename);
+        free(text);
+        fclose(fp);
+        return FSO_ERROR_IO;
+    }
+    text[size] = '\0';
+    fclose(fp);
+    
+    printf("\n");
+    printf("================================================================================\n");
+    printf("  Baseline Comparison: %s (threshold %.1f%%)\n", filename, threshold * 100.0);
+    printf("================================================================================\n");
+    printf("\n");
+    printf("%-32s %12s %12s %9s  %s\n", "Benchmark", "Baseline", "Current", "Change", "Verdict");
+    
+    int matched = 0;
+    for (int i = 0; i < recorded_count; i++) {
+        const PerformanceMetrics* current = &recorded_metrics[i];
+        
+        // Find this label's object; it ends where the next label starts
+        char pattern[160];
+        snprintf(pattern, sizeof(pattern), "\"label\": \"%s\"", recorded_labels[i]);
+        const char* entry = strstr(text, pattern);
+        char current_buf[32], base_buf[32];
+        benchmark_format_time(current->median_time_ms, current_buf);
+        if (!entry) {
+            printf("%-32s %12s %12s %9s  %s\n", recorded_labels[i], "-",
+                   current_buf, "-", "new");
+            continue;
+        }
+        const char* next = strstr(entry + strlen(pattern), "\"label\":");
+        
+        double base_median, base_high;
+        if (!benchmark_json_number(entry, next, "median_ms", &base_median) &&
+            !benchmark_json_number(entry, next, "avg_ms", &base_median)) {
+            continue;
+        }
+        if (!benchmark_json_number(entry, next, "ci_high_ms", &base_high)) {
+            base_high = base_median;
+        }
+        matched++;
+        
+        double change = (base_median > 0.0) ? current->median_time_ms / base_median - 1.0 : 0.0;
+        const char* verdict = "ok";
+        if (change > threshold && current->ci_low_ms > base_high) {
+            verdict = "REGRESSION";
+            (*regressions)++;
+        } else if (change > threshold) {
+            verdict = "noise";
+        } else if (change < -threshold) {
+            verdict = "faster";
+        }
+        
+        benchmark_format_time(base_median, base_buf);
+        printf("%-32s %12s %12s %+8.1f%%  %s\n", recorded_labels[i],
+               base_buf, current_buf, change * 100.0, verdict);
+    }
+    
+    printf("\n%d of %d benchmarks matched the baseline, %d regressed\n\n",
+           matched, recorded_count, *regressions);
+    
+    free(text);
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Logging and Reporting Functions
  * ============================================================================ */
@@ -257,6 +690,33 @@ void benchmark_print_metrics(const PerformanceMetrics* metrics,
     benchmark_format_time(metrics->stddev_time_ms, time_buf);
     printf("  Std deviation:     %s\n", time_buf);
     
+    if (metrics->median_time_ms > 0.0) {
+        char low_buf[32], high_buf[32];
+        benchmark_format_time(metrics->median_time_ms, time_buf);
+        benchmark_format_time(metrics->ci_low_ms, low_buf);
+        benchmark_format_time(metrics->ci_high_ms, high_buf);
+        printf("  Median time:       %s (95%% CI %s - %s, %d outliers)\n",
+               time_buf, low_buf, high_buf, metrics->outlier_count);
+    }
+    
+    // Hardware counters
+    if (metrics->counters_valid) {
+        printf("  Counters/iter:    ");
+        for (int i = 0; i < BENCHMARK_NUM_COUNTERS; i++) {
+            if (metrics->counters_valid & (1 << i)) {
+                printf(" %s=%.0f", counter_names[i], metrics->counters[i]);
+            }
+        }
+        printf("\n");
+        int ipc_mask = (1 << BENCHMARK_COUNTER_CYCLES) | (1 << BENCHMARK_COUNTER_INSTRUCTIONS);
+        if ((metrics->counters_valid & ipc_mask) == ipc_mask &&
+            metrics->counters[BENCHMARK_COUNTER_CYCLES] > 0.0) {
+            printf("  IPC:               %.2f\n",
+                   metrics->counters[BENCHMARK_COUNTER_INSTRUCTIONS] /
+                   metrics->counters[BENCHMARK_COUNTER_CYCLES]);
+        }
+    }
+    
     // Throughput metrics
     if (metrics->throughput_mbps > 0.0) {
         printf("  Throughput:        %.2f Mbps\n", metrics->throughput_mbps);
@@ -365,7 +825,9 @@ int benchmark_save_csv(const char* filename,
     // Write header
     fprintf(fp, "Label,Threads,AvgTime_ms,MinTime_ms,MaxTime_ms,StdDev_ms,");
     fprintf(fp, "Throughput_Mbps,Throughput_Samples_sec,Throughput_Ops_sec,");
-    fprintf(fp, "PeakMemory_bytes,Speedup,Efficiency,Iterations,SuccessCount\n");
+    fprintf(fp, "PeakMemory_bytes,Speedup,Efficiency,Iterations,SuccessCount,");
+    fprintf(fp, "Median_ms,CILow_ms,CIHigh_ms,Outliers,");
+    fprintf(fp, "Cycles,Instructions,CacheMisses,BranchMisses\n");
     
     // Write data
     for (int i = 0; i < count; i++) {
@@ -384,12 +846,28 @@ int benchmark_save_csv(const char* filename,
                 metrics[i].throughput_samples_sec,
                 metrics[i].throughput_ops_sec);
         
-        fprintf(fp, "%zu,%.6f,%.6f,%d,%d\n",
+        fprintf(fp, "%zu,%.6f,%.6f,%d,%d,",
                 metrics[i].peak_memory_bytes,
                 metrics[i].speedup_factor,
                 metrics[i].parallel_efficiency,
                 metrics[i].iterations,
                 metrics[i].success_count);
+        
+        fprintf(fp, "%.6f,%.6f,%.6f,%d",
+                metrics[i].median_time_ms,
+                metrics[i].ci_low_ms,
+                metrics[i].ci_high_ms,
+                metrics[i].outlier_count);
+        
+        // Unavailable counters are left empty
+        for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+            if (metrics[i].counters_valid & (1 << c)) {
+                fprintf(fp, ",%.0f", metrics[i].counters[c]);
+            } else {
+                fprintf(fp, ",");
+            }
+        }
+        fprintf(fp, "\n");
     }
     
     fclose(fp);
@@ -425,8 +903,22 @@ int benchmark_save_json(const char* filename,
         fprintf(fp, "        \"avg_ms\": %.6f,\n", metrics[i].avg_time_ms);
         fprintf(fp, "        \"min_ms\": %.6f,\n", metrics[i].min_time_ms);
         fprintf(fp, "        \"max_ms\": %.6f,\n", metrics[i].max_time_ms);
-        fprintf(fp, "        \"stddev_ms\": %.6f\n", metrics[i].stddev_time_ms);
+        fprintf(fp, "        \"stddev_ms\": %.6f,\n", metrics[i].stddev_time_ms);
+        fprintf(fp, "        \"median_ms\": %.6f,\n", metrics[i].median_time_ms);
+        fprintf(fp, "        \"ci_low_ms\": %.6f,\n", metrics[i].ci_low_ms);
+        fprintf(fp, "        \"ci_high_ms\": %.6f,\n", metrics[i].ci_high_ms);
+        fprintf(fp, "        \"outliers\": %d\n", metrics[i].outlier_count);
         fprintf(fp, "      },\n");
+        fprintf(fp, "      \"counters\": {");
+        int first = 1;
+        for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+            if (metrics[i].counters_valid & (1 << c)) {
+                fprintf(fp, "%s\n        \"%s\": %.0f", first ? "" : ",",
+                        counter_names[c], metrics[i].counters[c]);
+                first = 0;
+            }
+        }
+        fprintf(fp, "%s},\n", first ? "" : "\n      ");
         fprintf(fp, "      \"throughput\": {\n");
         fprintf(fp, "        \"mbps\": %.6f,\n", metrics[i].throughput_mbps);
         fprintf(fp, "        \"samples_per_sec\": %.6f,\n", metrics[i].throughput_samples_sec);
@@ -17,6 +17,25 @@
  * Performance Metrics Structure
  * ============================================================================ */
 
+/** Number of hardware performance counters sampled per benchmark */
+#define BENCHMARK_NUM_COUNTERS 4
+
+/** Bootstrap resamples for the median confidence interval */
+#define BENCHMARK_BOOTSTRAP_RESAMPLES 1000
+
+/** Modified z-score above which an iteration is rejected as an outlier */
+#define BENCHMARK_OUTLIER_Z 3.5
+
+/**
+ * @brief Hardware performance counters (perf_event_open on Linux)
+ */
+typedef enum {
+    BENCHMARK_COUNTER_CYCLES = 0,      /**< CPU cycles */
+    BENCHMARK_COUNTER_INSTRUCTIONS,    /**< Retired instructions */
+    BENCHMARK_COUNTER_CACHE_MISSES,    /**< Last-level cache misses */
+    BENCHMARK_COUNTER_BRANCH_MISSES    /**< Mispredicted branches */
+} BenchmarkCounter;
+
 /**
  * @brief Performance metrics for a benchmark run
  */
@@ -28,6 +47,16 @@ typedef struct {
     double avg_time_ms;            /**< Average execution time */
     double stddev_time_ms;         /**< Standard deviation of execution time */
     
+    // Robust timing metrics (outliers rejected)
+    double median_time_ms;         /**< Median execution time */
+    double ci_low_ms;              /**< Lower bound of the 95% bootstrap CI of the median */
+    double ci_high_ms;             /**< Upper bound of the 95% bootstrap CI of the median */
+    int outlier_count;             /**< Iterations rejected as outliers */
+    
+    // Hardware counters, averaged per iteration
+    int counters_valid;            /**< Bit i set if counter i was sampled */
+    double counters[BENCHMARK_NUM_COUNTERS]; /**< Indexed by BenchmarkCounter */
+    
     // Throughput metrics
     double throughput_mbps;        /**< Throughput in megabits per second */
     double throughput_samples_sec; /**< Throughput in samples per second */
@@ -68,6 +97,11 @@ typedef struct {
     struct timespec start_time;    /**< Start timestamp */
     struct timespec end_time;      /**< End timestamp */
     int is_running;                /**< Timer running flag */
+    
+    // Hardware counters accumulated over start/stop intervals
+    uint64_t counter_start[BENCHMARK_NUM_COUNTERS];  /**< Counter values at start */
+    uint64_t counter_totals[BENCHMARK_NUM_COUNTERS]; /**< Counts summed over intervals */
+    int counter_intervals;         /**< Start/stop intervals counted */
 } BenchmarkTimer;
 
 /* ============================================================================
@@ -116,6 +150,28 @@ double benchmark_timer_elapsed_us(const BenchmarkTimer* timer);
  */
 uint64_t benchmark_timer_elapsed_ns(const BenchmarkTimer* timer);
 
+/* ============================================================================
+ * Hardware Counter Functions
+ * ============================================================================ */
+
+/**
+ * @brief Check which hardware counters are available
+ * 
+ * Counters open on the first call (or the first benchmark_timer_init()).
+ * They count user-space events of the calling thread; they are unavailable
+ * off Linux or when perf_event_paranoid forbids them.
+ * 
+ * @return Bit mask of available BenchmarkCounter values (0 if none)
+ */
+int benchmark_counters_available(void);
+
+/**
+ * @brief Get the name of a hardware counter
+ * @param counter Counter index
+ * @return Counter name, as used in JSON output
+ */
+const char* benchmark_counter_name(BenchmarkCounter counter);
+
 /* ============================================================================
  * Memory Tracking Functions
  * ============================================================================ */
@@ -189,6 +245,88 @@ int benchmark_calculate_statistics(const double* times, int count,
                                    double* avg, double* stddev,
                                    double* min, double* max);
 
+/**
+ * @brief Calculate outlier-robust statistics from timing measurements
+ * 
+ * Rejects iterations whose modified z-score (0.6745·|x - median| / MAD)
+ * exceeds BENCHMARK_OUTLIER_Z, then takes the median of the rest and a 95%
+ * confidence interval from BENCHMARK_BOOTSTRAP_RESAMPLES bootstrap
+ * resamples. The resampling uses a fixed seed, so results are repeatable.
+ * 
+ * @param times Array of timing measurements in milliseconds
+ * @param count Number of measurements
+ * @param median Output: median of the retained measurements
+ * @param ci_low Output: lower bound of the median's confidence interval
+ * @param ci_high Output: upper bound of the median's confidence interval
+ * @param outliers Output: number of rejected measurements (may be NULL)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int benchmark_calculate_robust_statistics(const double* times, int count,
+                                          double* median, double* ci_low,
+                                          double* ci_high, int* outliers);
+
+/**
+ * @brief Fill the timing and counter metrics of a finished benchmark
+ * 
+ * Computes the classic and robust statistics of times, moves the counts
+ * accumulated by timer into per-iteration averages (resetting the timer's
+ * totals), and records a copy of the metrics under the formatted label
+ * for benchmark_results_save_json() and benchmark_compare_baseline().
+ * 
+ * @param metrics Metrics to fill
+ * @param times Array of timing measurements in milliseconds
+ * @param count Number of measurements
+ * @param timer Timer used for the measurements (may be NULL)
+ * @param label_format printf-style label of the benchmark
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int benchmark_metrics_finalize(PerformanceMetrics* metrics,
+                               const double* times, int count,
+                               BenchmarkTimer* timer,
+                               const char* label_format, ...);
+
+/* ============================================================================
+ * Recorded Results and Baselines
+ * ============================================================================ */
+
+/**
+ * @brief Number of benchmarks recorded by benchmark_metrics_finalize()
+ * @return Number of recorded results
+ */
+int benchmark_results_count(void);
+
+/**
+ * @brief Save every recorded result in benchmark_save_json() format
+ * 
+ * Results are copied when finalized, before callers derive throughput,
+ * so the file carries timing, counters and iteration counts.
+ * 
+ * @param filename Output filename
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int benchmark_results_save_json(const char* filename);
+
+/**
+ * @brief Free the recorded results
+ */
+void benchmark_results_clear(void);
+
+/**
+ * @brief Compare recorded results against a stored JSON baseline
+ * 
+ * Matches benchmarks by label in a file written by benchmark_save_json().
+ * A benchmark regresses when its median is more than threshold slower
+ * than the baseline median and its confidence interval lies entirely
+ * above the baseline's, so run-to-run noise does not count. Baselines
+ * without robust statistics compare against their average time.
+ * 
+ * @param filename Baseline JSON file
+ * @param threshold Allowed relative slowdown (0.05 = 5%)
+ * @param regressions Output: number of regressed benchmarks
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int benchmark_compare_baseline(const char* filename, double threshold, int* regressions);
+
 /* ============================================================================
  * Logging and Reporting Functions
  * ============================================================================ */
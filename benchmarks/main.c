@@ -265,11 +265,18 @@ static void print_usage(const char* program_name) {
     printf("  -E, --e2e               Run end-to-end benchmarks only\n");
     printf("  -q, --quick             Run quick benchmarks (faster)\n");
     printf("  -r, --report            Generate reports and visualizations\n");
+    printf("  --save-json FILE        Save every benchmark's results to FILE\n");
+    printf("  --baseline FILE         Compare against a saved JSON baseline\n");
+    printf("  --fail-threshold PCT    Allowed slowdown vs baseline (default 5%%)\n");
+    printf("\n");
+    printf("Exit status is 2 when a benchmark regresses against the baseline.\n");
     printf("\n");
     printf("Examples:\n");
     printf("  %s --all                # Run all benchmarks\n", program_name);
     printf("  %s --fft --quick        # Quick FFT benchmark\n", program_name);
     printf("  %s --e2e                # End-to-end latency only\n", program_name);
+    printf("  %s --quick --save-json base.json\n", program_name);
+    printf("  %s --quick --baseline base.json --fail-threshold 5%%\n", program_name);
     printf("\n");
 }
 
@@ -289,6 +296,9 @@ int main(int argc, char* argv[]) {
     int run_e2e = 0;
     int quick_mode = 0;
     int generate_reports = 0;
+    const char* save_json = NULL;
+    const char* baseline = NULL;
+    double fail_threshold = 0.05;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -315,6 +325,19 @@ int main(int argc, char* argv[]) {
             quick_mode = 1;
         } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--report") == 0) {
             generate_reports = 1;
+        } else if (strcmp(argv[i], "--save-json") == 0 && i + 1 < argc) {
+            save_json = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline = argv[++i];
+        } else if (strcmp(argv[i], "--fail-threshold") == 0 && i + 1 < argc) {
+            // Percent, with or without a trailing '%'
+            char* end;
+            double percent = strtod(argv[++i], &end);
+            if (end == argv[i] || (*end != '\0' && strcmp(end, "%") != 0) || percent < 0.0) {
+                printf("Invalid fail threshold: %s\n", argv[i]);
+                return 1;
+            }
+            fail_threshold = percent / 100.0;
         } else {
             printf("Unknown option: %s\n", argv[i]);
             print_usage(argv[0]);
@@ -407,11 +430,31 @@ int main(int argc, char* argv[]) {
         printf("To generate plots, run: gnuplot *.gnu\n");
     }
     
+    // Save results and check them against the baseline
+    if (save_json && benchmark_results_save_json(save_json) != FSO_SUCCESS) {
+        FSO_LOG_ERROR("MAIN", "Failed to save results to %s", save_json);
+        result = FSO_ERROR_IO;
+    }
+    
+    int regressions = 0;
+    if (baseline) {
+        if (benchmark_compare_baseline(baseline, fail_threshold, &regressions) != FSO_SUCCESS) {
+            result = FSO_ERROR_IO;
+        } else if (regressions > 0) {
+            FSO_LOG_ERROR("MAIN", "%d benchmark(s) regressed more than %.1f%% against %s",
+                         regressions, fail_threshold * 100.0, baseline);
+        }
+    }
+    benchmark_results_clear();
+    
     printf("\n");
     printf("================================================================================\n");
     printf("  Benchmarks Complete!\n");
     printf("================================================================================\n");
     printf("\n");
     
+    if (regressions > 0) {
+        return 2;
+    }
     return result == FSO_SUCCESS ? 0 : 1;
 }
@@ -23,14 +23,195 @@ static void print_usage(const char* program_name) {
     printf("  -l, --list               List available scenarios\n");
     printf("  -b, --batch              Run all scenarios in batch mode\n");
     printf("  -o, --output <base>      Output base filename (default: results)\n");
+    printf("  -j, --threads <n>        Packet worker threads (0 = all, default: 1)\n");
+    printf("      --affinity <mode>    Pin pool workers: none, compact (fill one NUMA\n");
+    printf("                           node first) or scatter (default: none)\n");
+    printf("      --simd <level>       Kernel family: scalar, sse4.2, avx2, avx512 or\n");
+    printf("                           neon (default: best supported, or $FSO_SIMD)\n");
+    printf("  -p, --pipeline <n>       Run as a stage pipeline with n decoder workers\n");
+    printf("  -e, --target-errors <n>  Stop each run after n bit errors\n");
+    printf("  -c, --target-ci <r>      Stop when the 95%% BER interval is within +/-r\n");
+    printf("                           (num_packets becomes the maximum budget)\n");
+    printf("  -d, --soft               Soft-decision decoding from demodulator LLRs\n");
+    printf("      --precision <mode>   Signal path format: double, single (float symbols),\n");
+    printf("                           int16 or int8 (float symbols, quantized LDPC\n");
+    printf("                           messages; need --soft) (default: double)\n");
+    printf("  -a, --amc                Adapt modulation and code rate to the predicted\n");
+    printf("                           channel SNR (default ladder: 2-PPM and OOK at\n");
+    printf("                           code rates 1/2 to 5/6)\n");
+    printf("      --amc-interval <n>   Packets per AMC feedback report (default: 16)\n");
+    printf("      --harq               Hybrid ARQ with incremental redundancy (soft LDPC,\n");
+    printf("                           rate 1/2 mother code sent from rate 5/6, no\n");
+    printf("                           interleaver)\n");
+    printf("      --harq-max <n>       Transmissions per packet, first included (default: 4)\n");
+    printf("      --harq-rtt <s>       Seconds from a transmission to its retransmission\n");
+    printf("                           (default: 1e-3)\n");
+    printf("  -i, --importance <s>     Importance sampling with fades tilted by s sigma\n");
+    printf("                           (e.g. -2 for deep-fade outage analysis)\n");
+    printf("  -w, --sweep              Sweep distance, weather, code rate and modulation\n");
+    printf("                           around the scenario (writes <base>_sweep.csv)\n");
+    printf("  -k, --chunk <n>          Packets per distributed sweep unit (MPI builds,\n");
+    printf("                           default %d)\n", SIM_DIST_CHUNK_PACKETS);
+    printf("  -r, --stream <file>      Stream per-packet results to a binary file instead\n");
+    printf("                           of keeping them in memory\n");
+    printf("  -x, --convert <file>     Convert a results stream to <base>_timeseries.csv\n");
+    printf("                           and <base>_packets.csv, then exit\n");
+    printf("      --checkpoint <file>  Save resumable run state to a file between blocks\n");
+    printf("      --checkpoint-interval <s>\n");
+    printf("                           Seconds between checkpoints (default: 60)\n");
+    printf("      --resume <file>      Continue the run saved in a checkpoint file\n");
+    printf("      --cache <dir>        Reuse sweep and batch results stored in dir and\n");
+    printf("                           store new ones (extends entries that need more\n");
+    printf("                           packets)\n");
+    printf("      --replay <file>      Run a recorded capture through the scenario's\n");
+    printf("                           receive chain instead of simulating\n");
+    printf("      --replay-frames <n>  Replay at most n frames (default: whole capture)\n");
+    printf("      --replay-reference   Count bit errors against the simulator's own\n");
+    printf("                           payloads (loopback captures)\n");
+    printf("      --fir <file>         Receive filter taps (whitespace separated) applied\n");
+    printf("                           to replayed samples\n");
+    printf("  -t, --trace <file>       Write stage zones as Chrome trace JSON\n");
+    printf("                           (needs a make PROFILE=1 build)\n");
     printf("  -v, --verbose            Enable verbose output\n");
     printf("  -h, --help               Show this help message\n\n");
     printf("Examples:\n");
     printf("  %s --scenario clear\n", program_name);
     printf("  %s --batch --output batch_results\n", program_name);
+    printf("  %s --scenario clear --sweep --threads 0\n", program_name);
+    printf("  %s --scenario clear --sweep --cache sim_cache\n", program_name);
+    printf("  %s --resume run.ckpt --threads 0\n", program_name);
+    printf("  %s --scenario clear --replay rx.cap --threads 0\n", program_name);
     printf("  %s --list\n\n", program_name);
 }
 
+/* ============================================================================
+ * Capture Replay
+ * ============================================================================ */
+
+/**
+ * @brief Read whitespace-separated filter taps
+ * @return Number of taps (0 on error); *taps must be freed by the caller
+ */
+static int load_fir_taps(const char* filename, double** taps) {
+    *taps = NULL;
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return 0;
+    }
+    
+    int count = 0;
+    int capacity = 0;
+    double value;
+    while (fscanf(fp, "%lf", &value) == 1) {
+        if (count == capacity) {
+            capacity = (capacity > 0) ? 2 * capacity : 64;
+            double* grown = (double*)realloc(*taps, (size_t)capacity * sizeof(double));
+            if (grown == NULL) {
+                count = 0;
+                break;
+            }
+            *taps = grown;
+        }
+        (*taps)[count++] = value;
+    }
+    fclose(fp);
+    
+    if (count == 0) {
+        free(*taps);
+        *taps = NULL;
+    }
+    return count;
+}
+
+static int run_replay(const SimConfig* config, const char* capture_file, const char* fir_file,
+                      long long max_frames, int reference) {
+    SimReplayConfig replay = {
+        .capture_file = capture_file,
+        .max_frames = max_frames,
+        .reference = reference
+    };
+    
+    double* taps = NULL;
+    if (fir_file != NULL) {
+        replay.num_fir_taps = load_fir_taps(fir_file, &taps);
+        if (replay.num_fir_taps == 0) {
+            fprintf(stderr, "Failed to read filter taps: %s\n", fir_file);
+            return 1;
+        }
+        replay.fir_taps = taps;
+    }
+    
+    printf("Replaying capture %s...\n\n", capture_file);
+    SimReplayStats stats;
+    int result = sim_run_replay(config, &replay, &stats);
+    free(taps);
+    if (result != FSO_SUCCESS) {
+        fprintf(stderr, "Replay failed with error code: %d\n", result);
+        return 1;
+    }
+    
+    sim_replay_print_stats(&stats);
+    return 0;
+}
+
+/* ============================================================================
+ * Parameter Sweep
+ * ============================================================================ */
+
+static int run_default_sweep(const SimConfig* base, int num_threads, int chunk_packets,
+                             const char* output_base) {
+    static const double distances[] = { 500.0, 1000.0, 2000.0, 5000.0 };
+    static const WeatherCondition weathers[] = {
+        WEATHER_CLEAR, WEATHER_FOG, WEATHER_RAIN, WEATHER_SNOW, WEATHER_HIGH_TURBULENCE
+    };
+    static const double code_rates[] = { 0.5, 0.75 };
+    static const ModulationType modulations[] = { MOD_OOK, MOD_PPM, MOD_DPSK };
+    
+    SimSweepGrid grid = {
+        .distances = distances, .num_distances = 4,
+        .weathers = weathers, .num_weathers = 5,
+        .code_rates = code_rates, .num_code_rates = 2,
+        .modulations = modulations, .num_modulations = 3
+    };
+    
+    SimConfig* configs = NULL;
+    int num_configs = 0;
+    if (sim_sweep_expand(base, &grid, &configs, &num_configs) != FSO_SUCCESS) {
+        fprintf(stderr, "Failed to expand sweep grid\n");
+        return 1;
+    }
+    
+    SimSweepRow* rows = (SimSweepRow*)calloc(num_configs, sizeof(SimSweepRow));
+    if (rows == NULL) {
+        fprintf(stderr, "Failed to allocate sweep rows\n");
+        free(configs);
+        return 1;
+    }
+    
+    // Under mpirun every rank runs the sweep; rank 0 reports it
+    int rank = sim_dist_rank();
+    if (rank == 0) {
+        printf("Running sweep over %d configurations on %d process(es)...\n",
+               num_configs, sim_dist_size());
+    }
+    int successful = sim_run_sweep_distributed(configs, num_configs, num_threads,
+                                               chunk_packets, rows);
+    
+    if (rank == 0) {
+        sim_sweep_print_table(rows, num_configs);
+        
+        char csv_filename[256];
+        snprintf(csv_filename, sizeof(csv_filename), "%s_sweep.csv", output_base);
+        sim_sweep_export_csv(rows, num_configs, csv_filename);
+        
+        printf("Sweep complete: %d / %d configurations successful\n", successful, num_configs);
+    }
+    
+    free(rows);
+    free(configs);
+    return 0;
+}
+
 /* ============================================================================
  * Main Function
  * ============================================================================ */
@@ -39,12 +220,43 @@ int main(int argc, char* argv[]) {
     // Set default log level
     fso_set_log_level(LOG_INFO);
     
+    // Join the process group when launched under mpirun (make MPI=1)
+    if (sim_dist_init(&argc, &argv) != FSO_SUCCESS) {
+        return 1;
+    }
+    atexit(sim_dist_finalize);
+    
     // Default options
     const char* scenario_name = NULL;
     const char* output_base = "results";
     int list_scenarios = 0;
     int batch_mode = 0;
     int verbose = 0;
+    int num_threads = 1;
+    int pipeline_decoders = 0;
+    int sweep_mode = 0;
+    int target_bit_errors = 0;
+    double target_relative_error = 0.0;
+    double fade_shift = 0.0;
+    int soft_decision = 0;
+    int amc = 0;
+    int amc_interval = 0;
+    int harq = 0;
+    int harq_max = 0;
+    double harq_rtt = -1.0;
+    FSOPrecision precision = FSO_PRECISION_DOUBLE;
+    const char* trace_file = NULL;
+    const char* stream_file = NULL;
+    const char* convert_file = NULL;
+    int chunk_packets = 0;
+    const char* checkpoint_file = NULL;
+    double checkpoint_interval = -1.0;
+    const char* resume_file = NULL;
+    const char* replay_file = NULL;
+    const char* fir_file = NULL;
+    long long replay_frames = 0;
+    int replay_reference = 0;
+    FSOAffinityMode affinity = FSO_AFFINITY_NONE;
     
     // Parse command-line arguments
     for (int i = 1; i < argc; i++) {
@@ -55,6 +267,20 @@ int main(int argc, char* argv[]) {
             list_scenarios = 1;
         } else if (strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--batch") == 0) {
             batch_mode = 1;
+        } else if (strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--sweep") == 0) {
+            sweep_mode = 1;
+        } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--soft") == 0) {
+            soft_decision = 1;
+        } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--amc") == 0) {
+            amc = 1;
+        } else if (strcmp(argv[i], "--amc-interval") == 0 && i + 1 < argc) {
+            amc_interval = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--harq") == 0) {
+            harq = 1;
+        } else if (strcmp(argv[i], "--harq-max") == 0 && i + 1 < argc) {
+            harq_max = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--harq-rtt") == 0 && i + 1 < argc) {
+            harq_rtt = atof(argv[++i]);
         } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
             verbose = 1;
             fso_set_log_level(LOG_DEBUG);
@@ -62,6 +288,85 @@ int main(int argc, char* argv[]) {
             scenario_name = argv[++i];
         } else if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) && i + 1 < argc) {
             output_base = argv[++i];
+        } else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--pipeline") == 0) && i + 1 < argc) {
+            pipeline_decoders = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "--target-errors") == 0) && i + 1 < argc) {
+            target_bit_errors = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--target-ci") == 0) && i + 1 < argc) {
+            target_relative_error = atof(argv[++i]);
+        } else if ((strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--importance") == 0) && i + 1 < argc) {
+            fade_shift = atof(argv[++i]);
+        } else if ((strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--chunk") == 0) && i + 1 < argc) {
+            chunk_packets = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--stream") == 0) && i + 1 < argc) {
+            stream_file = argv[++i];
+        } else if ((strcmp(argv[i], "-x") == 0 || strcmp(argv[i], "--convert") == 0) && i + 1 < argc) {
+            convert_file = argv[++i];
+        } else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--trace") == 0) && i + 1 < argc) {
+            trace_file = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_file = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            checkpoint_interval = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            resume_file = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_file = argv[++i];
+        } else if (strcmp(argv[i], "--replay-frames") == 0 && i + 1 < argc) {
+            replay_frames = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--replay-reference") == 0) {
+            replay_reference = 1;
+        } else if (strcmp(argv[i], "--fir") == 0 && i + 1 < argc) {
+            fir_file = argv[++i];
+        } else if (strcmp(argv[i], "--precision") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "double") == 0) {
+                precision = FSO_PRECISION_DOUBLE;
+            } else if (strcmp(mode, "single") == 0) {
+                precision = FSO_PRECISION_SINGLE;
+            } else if (strcmp(mode, "int16") == 0) {
+                precision = FSO_PRECISION_INT16;
+            } else if (strcmp(mode, "int8") == 0) {
+                precision = FSO_PRECISION_INT8;
+            } else {
+                fprintf(stderr, "Unknown precision: %s\n", mode);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            FSOSimdLevel level;
+            if (fso_cpu_parse_simd_level(name, &level) != FSO_SUCCESS) {
+                fprintf(stderr, "Unknown SIMD level: %s\n", name);
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (fso_cpu_set_simd_level(level) != FSO_SUCCESS) {
+                fprintf(stderr, "SIMD level %s is not supported on this CPU (best: %s)\n",
+                        fso_cpu_simd_name(level), fso_cpu_simd_name(fso_cpu_best_level()));
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            const char* dir = argv[++i];
+            if (sim_cache_set_dir(dir) != FSO_SUCCESS) {
+                fprintf(stderr, "Cannot use cache directory: %s\n", dir);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--affinity") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "none") == 0) {
+                affinity = FSO_AFFINITY_NONE;
+            } else if (strcmp(mode, "compact") == 0) {
+                affinity = FSO_AFFINITY_COMPACT;
+            } else if (strcmp(mode, "scatter") == 0) {
+                affinity = FSO_AFFINITY_SCATTER;
+            } else {
+                fprintf(stderr, "Unknown affinity mode: %s\n", mode);
+                print_usage(argv[0]);
+                return 1;
+            }
         } else {
             fprintf(stderr, "Unknown option: %s\n", argv[i]);
             print_usage(argv[0]);
@@ -69,6 +374,39 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Verbose runs log from every worker; queue messages per thread so the
+    // workers do not serialize on stderr
+    if (verbose && fso_log_async_start(NULL) == FSO_SUCCESS) {
+        atexit(fso_log_async_stop);
+    }
+    
+    // Start the shared worker pool before any run touches memory, so pinned
+    // workers first-touch their buffers on their own NUMA node
+    FSOThreadPoolConfig pool_config = { num_threads > 1 ? num_threads : 0, affinity };
+    if (fso_threadpool_init(&pool_config) != FSO_SUCCESS) {
+        fprintf(stderr, "Failed to start worker pool\n");
+        return 1;
+    }
+    atexit(fso_threadpool_shutdown);
+    
+    // Only sweeps spread over ranks; everything else runs on rank 0
+    if (sim_dist_rank() != 0 && !sweep_mode) {
+        return 0;
+    }
+    
+    // Handle stream conversion
+    if (convert_file != NULL) {
+        char points_csv[256], packets_csv[256];
+        snprintf(points_csv, sizeof(points_csv), "%s_timeseries.csv", output_base);
+        snprintf(packets_csv, sizeof(packets_csv), "%s_packets.csv", output_base);
+        if (sim_stream_export_csv(convert_file, points_csv, packets_csv) != FSO_SUCCESS) {
+            fprintf(stderr, "Failed to convert results stream: %s\n", convert_file);
+            return 1;
+        }
+        printf("Wrote %s and %s\n", points_csv, packets_csv);
+        return 0;
+    }
+    
     // Handle list scenarios
     if (list_scenarios) {
         sim_list_scenarios();
@@ -105,9 +443,40 @@ int main(int argc, char* argv[]) {
         printf("No scenario specified, using default: %s\n\n", scenario_name);
     }
     
-    // Load scenario configuration
+    // Load scenario configuration, or the configuration of the run to resume
     SimConfig config;
-    int result = sim_load_scenario(&config, scenario_name);
+    int result;
+    if (resume_file != NULL) {
+        result = sim_checkpoint_read_config(resume_file, &config);
+        if (result != FSO_SUCCESS) {
+            fprintf(stderr, "Failed to read checkpoint: %s\n", resume_file);
+            return 1;
+        }
+        config.control.verbose = verbose;
+        config.control.num_threads = num_threads;
+        if (checkpoint_interval >= 0.0) {
+            config.control.checkpoint_interval = checkpoint_interval;
+        }
+        sim_config_print(&config);
+        printf("Resuming simulation...\n\n");
+        
+        SimResults results;
+        result = sim_run_resume(&config, &results);
+        if (result != FSO_SUCCESS) {
+            fprintf(stderr, "Simulation failed with error code: %d\n", result);
+            return 1;
+        }
+        sim_results_print(&results);
+        printf("Generating visualizations...\n");
+        if (sim_generate_all_visualizations(&config, &results, output_base) != FSO_SUCCESS) {
+            fprintf(stderr, "Warning: Failed to generate some visualizations\n");
+        }
+        sim_results_free(&results);
+        printf("\nSimulation complete!\n");
+        return 0;
+    }
+    
+    result = sim_load_scenario(&config, scenario_name);
     if (result != FSO_SUCCESS) {
         fprintf(stderr, "Failed to load scenario: %s\n", scenario_name);
         fprintf(stderr, "Use --list to see available scenarios\n");
@@ -115,16 +484,89 @@ int main(int argc, char* argv[]) {
     }
     
     config.control.verbose = verbose;
+    config.control.num_threads = num_threads;
+    config.control.target_bit_errors = target_bit_errors;
+    config.control.target_relative_error = target_relative_error;
+    config.system.soft_decision = soft_decision;
+    config.system.precision = precision;
+    if (amc) {
+        config.system.amc.enabled = 1;
+        if (amc_interval > 0) {
+            config.system.amc.feedback_interval = amc_interval;
+        }
+        if (pipeline_decoders > 0) {
+            fprintf(stderr, "Warning: Adaptive runs are not pipelined; using sim_run()\n");
+            pipeline_decoders = 0;
+        }
+    }
+    if (harq) {
+        // Incremental redundancy punctures a low-rate LDPC mother code
+        config.system.harq.enabled = 1;
+        config.system.fec_type = FEC_LDPC;
+        config.system.code_rate = 0.5;
+        config.system.soft_decision = 1;
+        config.system.use_interleaver = 0;
+        if (harq_max > 0) {
+            config.system.harq.max_transmissions = harq_max;
+        }
+        if (harq_rtt >= 0.0) {
+            config.system.harq.round_trip_time = harq_rtt;
+        }
+        if (pipeline_decoders > 0) {
+            fprintf(stderr, "Warning: HARQ runs are not pipelined; using sim_run()\n");
+            pipeline_decoders = 0;
+        }
+    }
+    if (stream_file != NULL) {
+        snprintf(config.control.results_stream, sizeof(config.control.results_stream),
+                 "%s", stream_file);
+    }
+    if (fade_shift != 0.0) {
+        config.control.importance_sampling = 1;
+        config.control.is_fade_shift = fade_shift;
+    }
+    if (checkpoint_file != NULL) {
+        snprintf(config.control.checkpoint_file, sizeof(config.control.checkpoint_file),
+                 "%s", checkpoint_file);
+        if (pipeline_decoders > 0 || sweep_mode) {
+            fprintf(stderr, "Warning: Pipelined runs and sweeps are not checkpointed\n");
+        }
+    }
+    if (checkpoint_interval >= 0.0) {
+        config.control.checkpoint_interval = checkpoint_interval;
+    }
+    
+    if (replay_file != NULL) {
+        sim_config_print(&config);
+        return run_replay(&config, replay_file, fir_file, replay_frames, replay_reference);
+    }
+    
+    if (sweep_mode) {
+        return run_default_sweep(&config, num_threads, chunk_packets, output_base);
+    }
     
     // Print configuration
     sim_config_print(&config);
     
+    // Keep individual zone entries for the trace (about 6 MB per thread)
+    if (trace_file != NULL && fso_profile_trace_enable(1 << 18) != FSO_SUCCESS) {
+        trace_file = NULL;
+    }
+    
     // Run simulation
     SimResults results;
     printf("Running simulation...\n\n");
     
+    SimPipelineStats pipeline_stats;
+    
     if (config.system.enable_tracking) {
         result = sim_run_with_tracking(&config, &results);
+    } else if (pipeline_decoders > 0) {
+        SimPipelineConfig pipeline = { .queue_depth = 0, .decoder_workers = pipeline_decoders };
+        result = sim_run_pipelined(&config, &pipeline, &results, &pipeline_stats);
+        if (result == FSO_SUCCESS) {
+            sim_pipeline_print_stats(&pipeline_stats);
+        }
     } else {
         result = sim_run(&config, &results);
     }
@@ -137,6 +579,10 @@ int main(int argc, char* argv[]) {
     // Print results
     sim_results_print(&results);
     
+    if (trace_file != NULL && fso_profile_write_trace(trace_file) != FSO_SUCCESS) {
+        fprintf(stderr, "Warning: Failed to write trace file: %s\n", trace_file);
+    }
+    
     // Generate visualizations
     printf("Generating visualizations...\n");
     result = sim_generate_all_visualizations(&config, &results, output_base);
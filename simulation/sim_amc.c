@@ -0,0 +1,346 @@
+/**
+ * @file sim_amc.c
+ * @brief Adaptive modulation and coding controller
+ *
+ * Closes the loop between the receiver and the transmitter of an
+ * sim_run(): every decoded packet yields an estimate of the pulse SNR
+ * γ = A²/σ², the estimates reach the transmitter once per feedback
+ * interval, and the transmitter picks the mode of the next interval from
+ * a short-horizon prediction of γ.
+ *
+ * Estimators:
+ * - Soft-decision OOK: bit LLRs L = (A/σ²)(r - A/2) are consistent
+ *   Gaussian, L ~ N(±μ, 2μ) with μ = γ/2, so E[L²] = μ² + 2μ gives
+ *   μ = sqrt(1 + E[L²]) - 1 without knowing the transmitted bits.
+ * - Otherwise: decision-directed moments of the received samples. Samples
+ *   are split into pulse and empty slots (the largest slot of each PPM
+ *   symbol; a two-means threshold for OOK), A is the difference of the
+ *   class means and σ² their pooled variance. Misclassified samples make
+ *   these read high at low SNR (2-PPM: about +1.5 dB at 4 dB, within
+ *   0.5 dB from 8 dB up).
+ *
+ * Predictor: Holt's linear exponential smoothing of γ in dB,
+ *   level ← α y + (1 - α)(level + trend)
+ *   trend ← β Δlevel + (1 - β) trend
+ *   γ̂(h) = level + h trend
+ *
+ * Selection: the highest mode whose threshold the prediction clears.
+ * Stepping up needs hysteresis_db of extra margin; stepping down happens
+ * as soon as the prediction falls below the current mode's threshold.
+ */
+
+#include "simulator.h"
+#include "../src/fec/ldpc.h"
+#include <string.h>
+#include <math.h>
+
+#define MODULE_NAME "AMC"
+
+/** Two-means refinements of the OOK decision threshold */
+#define SIM_AMC_THRESHOLD_PASSES 3
+
+/* ============================================================================
+ * Mode Ladder
+ * ============================================================================ */
+
+int sim_amc_default_ladder(SimAMCMode modes[SIM_AMC_MAX_MODES]) {
+    // Pulse SNR needed by each mode: the antipodal SNR a practical LDPC code
+    // of the rate needs (about 2.0, 4.3, 5.3 and 6.7 dB for rates 1/2-5/6)
+    // plus the level spacing of the modulation. 2-PPM compares two slots
+    // (+3 dB); OOK thresholds between 0 and A (+6 dB). Under the
+    // simulator's peak-limited slots higher PPM orders carry no more bits
+    // per slot than 2-PPM at a worse symbol error rate, and 2-PPM at 3/4 or
+    // 5/6 needs more SNR than OOK at 1/2, so those modes are left out.
+    static const SimAMCMode ladder[] = {
+        { MOD_PPM, 2, LDPC_RATE_1_2, 5.0 },
+        { MOD_PPM, 2, LDPC_RATE_2_3, 7.3 },
+        { MOD_OOK, 0, LDPC_RATE_1_2, 8.0 },
+        { MOD_OOK, 0, LDPC_RATE_2_3, 10.3 },
+        { MOD_OOK, 0, LDPC_RATE_3_4, 11.3 },
+        { MOD_OOK, 0, LDPC_RATE_5_6, 12.7 }
+    };
+    int count = (int)(sizeof(ladder) / sizeof(ladder[0]));
+    
+    memcpy(modes, ladder, sizeof(ladder));
+    return count;
+}
+
+/**
+ * @brief Payload bits per channel sample of a mode
+ */
+static double sim_amc_efficiency(const SimAMCMode* mode) {
+    if (mode->modulation != MOD_PPM) {
+        return mode->code_rate;
+    }
+    
+    int bits = 0;
+    for (int order = mode->ppm_order; order > 1; order >>= 1) {
+        bits++;
+    }
+    return mode->code_rate * (double)bits / (double)mode->ppm_order;
+}
+
+void sim_amc_mode_config(const SimConfig* config, const SimAMCMode* mode, SimConfig* mode_config) {
+    *mode_config = *config;
+    mode_config->system.modulation = mode->modulation;
+    mode_config->system.ppm_order = (mode->modulation == MOD_PPM) ?
+                                    mode->ppm_order : config->system.ppm_order;
+    mode_config->system.code_rate = mode->code_rate;
+}
+
+void sim_amc_sizing_config(const SimAMCController* amc, const SimConfig* config,
+                           SimConfig* sizing) {
+    *sizing = *config;
+    
+    // Buffers grow with slots per byte (highest PPM order, else OOK) and
+    // with codeword length (lowest rate)
+    int max_order = 0;
+    double min_rate = 1.0;
+    for (int m = 0; m < amc->num_modes; m++) {
+        if (amc->modes[m].modulation == MOD_PPM) {
+            max_order = FSO_MAX(max_order, amc->modes[m].ppm_order);
+        }
+        min_rate = FSO_MIN(min_rate, amc->modes[m].code_rate);
+    }
+    sizing->system.modulation = (max_order > 0) ? MOD_PPM : MOD_OOK;
+    sizing->system.ppm_order = (max_order > 0) ? max_order : config->system.ppm_order;
+    sizing->system.code_rate = min_rate;
+}
+
+/* ============================================================================
+ * Controller
+ * ============================================================================ */
+
+int sim_amc_init(SimAMCController* amc, const SimConfig* config) {
+    FSO_CHECK_NULL(amc);
+    FSO_CHECK_NULL(config);
+    
+    const SimAMCConfig* params = &config->system.amc;
+    FSO_CHECK_PARAM(params->num_modes >= 0 && params->num_modes <= SIM_AMC_MAX_MODES);
+    FSO_CHECK_PARAM(params->feedback_interval >= 1);
+    
+    memset(amc, 0, sizeof(SimAMCController));
+    if (params->num_modes > 0) {
+        memcpy(amc->modes, params->modes, (size_t)params->num_modes * sizeof(SimAMCMode));
+        amc->num_modes = params->num_modes;
+    } else {
+        amc->num_modes = sim_amc_default_ladder(amc->modes);
+    }
+    
+    amc->hysteresis_db = params->hysteresis_db;
+    amc->smoothing = params->smoothing;
+    amc->trend_smoothing = params->trend_smoothing;
+    amc->horizon = (params->prediction_horizon > 0) ?
+                   (double)params->prediction_horizon : 0.5 * (double)params->feedback_interval;
+    
+    // No report yet: start in the most robust mode
+    amc->current = 0;
+    
+    for (int m = 1; m < amc->num_modes; m++) {
+        if (sim_amc_efficiency(&amc->modes[m]) <= sim_amc_efficiency(&amc->modes[m - 1])) {
+            FSO_LOG_WARNING(MODULE_NAME, "Mode %d carries no more payload per sample than mode %d",
+                           m, m - 1);
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+void sim_amc_observe(SimAMCController* amc, double snr_db) {
+    if (amc == NULL || !isfinite(snr_db)) {
+        return;
+    }
+    
+    if (amc->observations == 0) {
+        amc->level = snr_db;
+        amc->trend = 0.0;
+    } else {
+        double previous = amc->level;
+        amc->level = amc->smoothing * snr_db +
+                     (1.0 - amc->smoothing) * (amc->level + amc->trend);
+        amc->trend = amc->trend_smoothing * (amc->level - previous) +
+                     (1.0 - amc->trend_smoothing) * amc->trend;
+    }
+    amc->observations++;
+}
+
+double sim_amc_predict(const SimAMCController* amc) {
+    if (amc == NULL || amc->observations == 0) {
+        return -INFINITY;
+    }
+    
+    return amc->level + amc->horizon * amc->trend;
+}
+
+int sim_amc_select(SimAMCController* amc) {
+    if (amc == NULL) {
+        return 0;
+    }
+    if (amc->observations == 0) {
+        return amc->current;
+    }
+    
+    double predicted = sim_amc_predict(amc);
+    int mode = amc->current;
+    
+    if (predicted < amc->modes[mode].min_snr_db) {
+        // Step down at once, to the highest mode the prediction still clears
+        while (mode > 0 && predicted < amc->modes[mode].min_snr_db) {
+            mode--;
+        }
+    } else {
+        // Step up only with margin, so estimate noise does not flap modes
+        while (mode + 1 < amc->num_modes &&
+               predicted >= amc->modes[mode + 1].min_snr_db + amc->hysteresis_db) {
+            mode++;
+        }
+    }
+    
+    if (mode != amc->current) {
+        FSO_LOG_DEBUG(MODULE_NAME, "Predicted %.2f dB: mode %d -> %d", predicted, amc->current, mode);
+        amc->switches++;
+        amc->current = mode;
+    }
+    return mode;
+}
+
+/* ============================================================================
+ * Channel-State Estimation
+ * ============================================================================ */
+
+/**
+ * @brief Received sample i, whichever precision the packet holds
+ */
+static inline double sim_amc_sample(const SimPacket* packet, size_t i) {
+    return (packet->rx_symbols != NULL) ? packet->rx_symbols[i] : (double)packet->rx_symbols_f32[i];
+}
+
+/**
+ * @brief Pulse SNR in dB from pulse/empty class sums, clamped to the SNR histogram range
+ */
+static double sim_amc_class_snr(double on_sum, double on_sq, size_t on_count,
+                                double off_sum, double off_sq, size_t off_count) {
+    if (on_count == 0 || off_count == 0 || on_count + off_count < 3) {
+        return SIM_SNR_HIST_MIN_DB;
+    }
+    
+    double on_mean = on_sum / (double)on_count;
+    double off_mean = off_sum / (double)off_count;
+    double scatter = (on_sq - on_sum * on_mean) + (off_sq - off_sum * off_mean);
+    double variance = scatter / (double)(on_count + off_count - 2);
+    double amplitude = on_mean - off_mean;
+    if (amplitude <= 0.0) {
+        return SIM_SNR_HIST_MIN_DB;
+    }
+    if (variance <= 0.0) {
+        return SIM_SNR_HIST_MAX_DB;
+    }
+    
+    double snr_db = fso_linear_to_db(amplitude * amplitude / variance);
+    return FSO_MAX(FSO_MIN(snr_db, SIM_SNR_HIST_MAX_DB), SIM_SNR_HIST_MIN_DB);
+}
+
+/**
+ * @brief PPM: the largest slot of each symbol is the pulse
+ */
+static double sim_amc_estimate_ppm(const SimPacket* packet, int order) {
+    double on_sum = 0.0, on_sq = 0.0, off_sum = 0.0, off_sq = 0.0;
+    size_t symbols = packet->symbol_len / (size_t)order;
+    
+    for (size_t s = 0; s < symbols; s++) {
+        size_t base = s * (size_t)order;
+        size_t peak = base;
+        for (size_t j = base + 1; j < base + (size_t)order; j++) {
+            if (sim_amc_sample(packet, j) > sim_amc_sample(packet, peak)) {
+                peak = j;
+            }
+        }
+        for (size_t j = base; j < base + (size_t)order; j++) {
+            double r = sim_amc_sample(packet, j);
+            if (j == peak) {
+                on_sum += r;
+                on_sq += r * r;
+            } else {
+                off_sum += r;
+                off_sq += r * r;
+            }
+        }
+    }
+    
+    return sim_amc_class_snr(on_sum, on_sq, symbols, off_sum, off_sq,
+                             symbols * (size_t)(order - 1));
+}
+
+/**
+ * @brief OOK: split samples at a two-means threshold
+ *
+ * Codeword duty cycles need not be 1/2, so the threshold starts at the
+ * sample mean and moves to the midpoint of the class means.
+ */
+static double sim_amc_estimate_ook(const SimPacket* packet) {
+    size_t n = packet->symbol_len;
+    double threshold = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        threshold += sim_amc_sample(packet, i);
+    }
+    threshold /= (double)n;
+    
+    double on_sum = 0.0, on_sq = 0.0, off_sum = 0.0, off_sq = 0.0;
+    size_t on_count = 0;
+    for (int pass = 0; pass < SIM_AMC_THRESHOLD_PASSES; pass++) {
+        on_sum = on_sq = off_sum = off_sq = 0.0;
+        on_count = 0;
+        for (size_t i = 0; i < n; i++) {
+            double r = sim_amc_sample(packet, i);
+            if (r > threshold) {
+                on_sum += r;
+                on_sq += r * r;
+                on_count++;
+            } else {
+                off_sum += r;
+                off_sq += r * r;
+            }
+        }
+        if (on_count == 0 || on_count == n) {
+            break;
+        }
+        threshold = 0.5 * (on_sum / (double)on_count + off_sum / (double)(n - on_count));
+    }
+    
+    return sim_amc_class_snr(on_sum, on_sq, on_count, off_sum, off_sq, n - on_count);
+}
+
+/**
+ * @brief Soft-decision OOK: consistent-Gaussian LLR moments
+ */
+static double sim_amc_estimate_llr(const SimPacket* packet) {
+    size_t n = packet->fec_input_len * 8;
+    double sum_sq = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum_sq += (double)packet->llr[i] * (double)packet->llr[i];
+    }
+    
+    double mu = sqrt(1.0 + sum_sq / (double)n) - 1.0;
+    if (mu <= 0.0) {
+        return SIM_SNR_HIST_MIN_DB;
+    }
+    
+    double snr_db = fso_linear_to_db(2.0 * mu);
+    return FSO_MAX(FSO_MIN(snr_db, SIM_SNR_HIST_MAX_DB), SIM_SNR_HIST_MIN_DB);
+}
+
+double sim_amc_estimate_snr(const SimPacket* packet, const SimConfig* config) {
+    if (packet == NULL || config == NULL || packet->status != FSO_SUCCESS ||
+        packet->symbol_len == 0) {
+        return SIM_SNR_HIST_MIN_DB;
+    }
+    
+    if (config->system.soft_decision && config->system.modulation == MOD_OOK &&
+        packet->llr != NULL && packet->fec_input_len > 0) {
+        return sim_amc_estimate_llr(packet);
+    }
+    if (config->system.modulation == MOD_PPM) {
+        return sim_amc_estimate_ppm(packet, config->system.ppm_order);
+    }
+    return sim_amc_estimate_ook(packet);
+}
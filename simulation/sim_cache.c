@@ -0,0 +1,481 @@
+/**
+ * @file sim_cache.c
+ * @brief Content-addressed cache of simulation results
+ *
+ * Entries are named by sim_cache_key() and hold the canonical key bytes,
+ * so a hash collision reads as a miss. Entry file layout (host byte
+ * order; entries are shared by the same build only):
+ *   header:  "FSORC001", u32 byte-order mark, u32 sizeof(SimResults),
+ *            u32 key length, key bytes
+ *   run:     u64 run seed, i64 packets covered, i32 1 if arrays follow
+ *   results: SimResults bytes (pointers are ignored on load),
+ *            u64 history length + points, u64 packet count + packets
+ *   end:     "FSORCEND"
+ *
+ * Packets draw from (seed, packet) RNG streams and the fading chain is
+ * replayed from packet 0, so a fixed-budget entry of n packets merged
+ * with a run of packets [n, m) under the same seed matches a run of m.
+ */
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define cache_mkdir(path) _mkdir(path)
+#define cache_pid() _getpid()
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define cache_mkdir(path) mkdir(path, 0777)
+#define cache_pid() getpid()
+#endif
+
+#define MODULE_NAME "Cache"
+
+#define SIM_CACHE_MAGIC "FSORC001"
+#define SIM_CACHE_END_MAGIC "FSORCEND"
+#define SIM_CACHE_MAGIC_LEN 8
+#define SIM_CACHE_BOM 0x01020304u
+#define SIM_CACHE_KEY_MAX 1024
+
+static char cache_root[256];
+
+/**
+ * @brief Canonical encoding of the fields that affect results
+ */
+typedef struct {
+    unsigned char bytes[SIM_CACHE_KEY_MAX];
+    uint32_t length;
+} SimCacheKey;
+
+/* ============================================================================
+ * Key
+ * ============================================================================ */
+
+static void cache_key_put(SimCacheKey* key, const void* data, size_t size) {
+    if (key->length + size <= sizeof(key->bytes)) {
+        memcpy(key->bytes + key->length, data, size);
+        key->length += (uint32_t)size;
+    }
+}
+
+static void cache_key_int(SimCacheKey* key, long long value) {
+    int64_t v = value;
+    cache_key_put(key, &v, sizeof(v));
+}
+
+static void cache_key_double(SimCacheKey* key, double value) {
+    // -0.0 and 0.0 configure the same run
+    double v = (value == 0.0) ? 0.0 : value;
+    cache_key_put(key, &v, sizeof(v));
+}
+
+/**
+ * @brief Whether packet ranges of the configuration merge into a whole run
+ */
+static int cache_splittable(const SimConfig* config) {
+    return !config->system.enable_tracking && !config->system.amc.enabled &&
+           !config->system.harq.enabled &&
+           config->control.target_bit_errors <= 0 && config->control.target_relative_error <= 0.0;
+}
+
+/**
+ * @brief Encode config field by field, so padding and paths never matter
+ */
+static void cache_key_build(const SimConfig* config, SimCacheKey* key) {
+    const LinkConfig* link = &config->link;
+    const EnvironmentConfig* env = &config->environment;
+    const SystemConfig* sys = &config->system;
+    const SimulationControl* ctl = &config->control;
+
+    key->length = 0;
+    cache_key_put(key, "fso " FSO_VERSION_STRING, sizeof("fso " FSO_VERSION_STRING));
+
+    cache_key_double(key, link->link_distance);
+    cache_key_double(key, link->transmit_power);
+    cache_key_double(key, link->receiver_sensitivity);
+    cache_key_double(key, link->wavelength);
+    cache_key_double(key, link->beam_divergence);
+    cache_key_double(key, link->receiver_aperture);
+
+    cache_key_int(key, env->weather);
+    cache_key_double(key, env->turbulence_strength);
+    cache_key_double(key, env->temperature);
+    cache_key_double(key, env->humidity);
+    cache_key_double(key, env->visibility);
+    cache_key_double(key, env->rainfall_rate);
+    cache_key_double(key, env->snowfall_rate);
+    cache_key_double(key, env->correlation_time);
+    cache_key_int(key, env->fading_model);
+    cache_key_double(key, env->malaga_omega);
+    cache_key_double(key, env->malaga_rho);
+    cache_key_int(key, env->intra_packet_fading);
+    cache_key_int(key, env->fade_block_symbols);
+
+    cache_key_int(key, sys->modulation);
+    cache_key_int(key, sys->ppm_order);
+    cache_key_int(key, sys->fec_type);
+    cache_key_double(key, sys->code_rate);
+    cache_key_int(key, sys->use_interleaver);
+    cache_key_int(key, sys->interleaver_depth);
+    cache_key_int(key, sys->interleaver_type);
+    cache_key_int(key, sys->soft_decision);
+    cache_key_int(key, sys->precision);
+    cache_key_int(key, sys->enable_tracking);
+    cache_key_double(key, sys->tracking_update_rate);
+    cache_key_int(key, sys->amc.enabled);
+    if (sys->amc.enabled) {
+        cache_key_int(key, sys->amc.num_modes);
+        for (int m = 0; m < sys->amc.num_modes && m < SIM_AMC_MAX_MODES; m++) {
+            cache_key_int(key, sys->amc.modes[m].modulation);
+            cache_key_int(key, sys->amc.modes[m].ppm_order);
+            cache_key_double(key, sys->amc.modes[m].code_rate);
+            cache_key_double(key, sys->amc.modes[m].min_snr_db);
+        }
+        cache_key_double(key, sys->amc.hysteresis_db);
+        cache_key_int(key, sys->amc.feedback_interval);
+        cache_key_double(key, sys->amc.smoothing);
+        cache_key_double(key, sys->amc.trend_smoothing);
+        cache_key_int(key, sys->amc.prediction_horizon);
+    }
+    cache_key_int(key, sys->harq.enabled);
+    if (sys->harq.enabled) {
+        cache_key_int(key, sys->harq.max_transmissions);
+        cache_key_double(key, sys->harq.initial_rate);
+        cache_key_double(key, sys->harq.round_trip_time);
+    }
+
+    // A fixed budget only sets how far the same packet sequence runs
+    if (cache_splittable(config)) {
+        cache_key_int(key, 1);
+        cache_key_double(key, ctl->simulation_time / ctl->num_packets);
+    } else {
+        cache_key_int(key, 0);
+        cache_key_double(key, ctl->simulation_time);
+        cache_key_int(key, ctl->num_packets);
+    }
+    cache_key_double(key, ctl->sample_rate);
+    cache_key_int(key, ctl->packet_size);
+    cache_key_double(key, ctl->noise_floor);
+    cache_key_int(key, ctl->random_seed);
+    cache_key_int(key, ctl->target_bit_errors);
+    cache_key_double(key, ctl->target_relative_error);
+    cache_key_double(key, ctl->confidence_level);
+    cache_key_int(key, ctl->importance_sampling);
+    cache_key_double(key, ctl->is_fade_shift);
+    cache_key_double(key, ctl->is_noise_shift);
+}
+
+/**
+ * @brief FNV-1a over the key bytes
+ */
+static uint64_t cache_key_hash(const SimCacheKey* key) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < key->length; i++) {
+        hash ^= key->bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t sim_cache_key(const SimConfig* config) {
+    if (config == NULL) {
+        return 0;
+    }
+    SimCacheKey key;
+    cache_key_build(config, &key);
+    return cache_key_hash(&key);
+}
+
+/* ============================================================================
+ * File Helpers
+ * ============================================================================ */
+
+static int cache_write(FILE* fp, const void* data, size_t size, size_t count) {
+    return (count == 0 || fwrite(data, size, count, fp) == count) ? FSO_SUCCESS : FSO_ERROR_IO;
+}
+
+static int cache_read(FILE* fp, void* data, size_t size, size_t count) {
+    return (count == 0 || fread(data, size, count, fp) == count) ? FSO_SUCCESS : FSO_ERROR_IO;
+}
+
+static void cache_entry_path(const SimCacheKey* key, char* path, size_t size) {
+    snprintf(path, size, "%s/%016llx.fsrc", cache_root,
+             (unsigned long long)cache_key_hash(key));
+}
+
+/**
+ * @brief Open an entry and read it up to the results
+ *
+ * @return FSO_SUCCESS, or FSO_ERROR_IO for a missing, foreign or corrupt entry
+ */
+static int cache_open_entry(const SimCacheKey* key, FILE** out, uint64_t* run_seed,
+                            int64_t* packets, int32_t* has_arrays) {
+    char path[sizeof(cache_root) + 32];
+    cache_entry_path(key, path, sizeof(path));
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return FSO_ERROR_IO;
+    }
+
+    char magic[SIM_CACHE_MAGIC_LEN];
+    uint32_t header[3];
+    unsigned char stored[SIM_CACHE_KEY_MAX];
+    int result = cache_read(fp, magic, 1, sizeof(magic));
+    if (result == FSO_SUCCESS) result = cache_read(fp, header, sizeof(uint32_t), 3);
+    if (result == FSO_SUCCESS &&
+        (memcmp(magic, SIM_CACHE_MAGIC, SIM_CACHE_MAGIC_LEN) != 0 ||
+         header[0] != SIM_CACHE_BOM || header[1] != sizeof(SimResults) ||
+         header[2] != key->length)) {
+        result = FSO_ERROR_IO;
+    }
+    if (result == FSO_SUCCESS) result = cache_read(fp, stored, 1, key->length);
+    if (result == FSO_SUCCESS && memcmp(stored, key->bytes, key->length) != 0) {
+        FSO_LOG_DEBUG(MODULE_NAME, "Key collision on %s", path);
+        result = FSO_ERROR_IO;
+    }
+    if (result == FSO_SUCCESS) result = cache_read(fp, run_seed, sizeof(*run_seed), 1);
+    if (result == FSO_SUCCESS) result = cache_read(fp, packets, sizeof(*packets), 1);
+    if (result == FSO_SUCCESS) result = cache_read(fp, has_arrays, sizeof(*has_arrays), 1);
+    if (result != FSO_SUCCESS) {
+        fclose(fp);
+        return result;
+    }
+
+    *out = fp;
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Directory
+ * ============================================================================ */
+
+int sim_cache_set_dir(const char* dir) {
+    if (dir == NULL || dir[0] == '\0') {
+        cache_root[0] = '\0';
+        return FSO_SUCCESS;
+    }
+    FSO_CHECK_PARAM(strlen(dir) < sizeof(cache_root));
+
+    if (cache_mkdir(dir) != 0 && errno != EEXIST) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create cache directory: %s", dir);
+        return FSO_ERROR_IO;
+    }
+    snprintf(cache_root, sizeof(cache_root), "%s", dir);
+
+    FSO_LOG_INFO(MODULE_NAME, "Caching results in %s", cache_root);
+    return FSO_SUCCESS;
+}
+
+const char* sim_cache_dir(void) {
+    return (cache_root[0] != '\0') ? cache_root : NULL;
+}
+
+/**
+ * @brief Whether config's results can come from the cache
+ *
+ * A streamed run must write its rows, which an entry does not hold.
+ */
+static int cache_usable(const SimConfig* config) {
+    return cache_root[0] != '\0' && config->control.results_stream[0] == '\0';
+}
+
+/* ============================================================================
+ * Load
+ * ============================================================================ */
+
+int sim_cache_load(const SimConfig* config, int keep_history, SimResults* results,
+                   uint64_t* run_seed, int* cached_packets) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(results);
+    FSO_CHECK_NULL(run_seed);
+    FSO_CHECK_NULL(cached_packets);
+
+    if (!cache_usable(config)) {
+        return FSO_ERROR_UNSUPPORTED;
+    }
+
+    SimCacheKey key;
+    cache_key_build(config, &key);
+
+    FILE* fp = NULL;
+    uint64_t seed = 0;
+    int64_t packets_covered = 0;
+    int32_t has_arrays = 0;
+    int result = cache_open_entry(&key, &fp, &seed, &packets_covered, &has_arrays);
+    if (result != FSO_SUCCESS) {
+        return FSO_ERROR_IO;
+    }
+
+    // Exact budgets serve anyone; smaller fixed budgets serve aggregates
+    // for a top-up; arrays need an exact entry that kept them
+    int num_packets = config->control.num_packets;
+    int usable = (packets_covered == num_packets) ||
+                 (packets_covered > 0 && packets_covered < num_packets && !keep_history);
+    if (!usable || (keep_history && !has_arrays)) {
+        fclose(fp);
+        return FSO_ERROR_IO;
+    }
+
+    result = keep_history ? sim_results_init_run(results, config, 1)
+                          : sim_results_init(results, 0, 0);
+    if (result != FSO_SUCCESS) {
+        fclose(fp);
+        return result;
+    }
+
+    // Stored aggregates over the fresh results, keeping its own buffers
+    TimeSeriesPoint* history_buffer = results->history;
+    size_t history_capacity = results->history_capacity;
+    PacketStats* packet_buffer = results->packet_stats;
+    uint64_t points = 0;
+    uint64_t packets = 0;
+    result = cache_read(fp, results, sizeof(SimResults), 1);
+    results->history = history_buffer;
+    results->history_capacity = history_capacity;
+    results->packet_stats = packet_buffer;
+    results->stream = NULL;
+    results->history_length = 0;
+    results->num_packet_stats = 0;
+
+    if (result == FSO_SUCCESS) result = cache_read(fp, &points, sizeof(points), 1);
+    if (result == FSO_SUCCESS && keep_history) {
+        if (points > history_capacity) {
+            result = FSO_ERROR_IO;
+        } else {
+            result = cache_read(fp, history_buffer, sizeof(TimeSeriesPoint), (size_t)points);
+        }
+    } else if (result == FSO_SUCCESS && points > 0 &&
+               fseek(fp, (long)(points * sizeof(TimeSeriesPoint)), SEEK_CUR) != 0) {
+        result = FSO_ERROR_IO;
+    }
+    if (result == FSO_SUCCESS) result = cache_read(fp, &packets, sizeof(packets), 1);
+    if (result == FSO_SUCCESS && keep_history) {
+        if (packets > (uint64_t)num_packets) {
+            result = FSO_ERROR_IO;
+        } else {
+            result = cache_read(fp, packet_buffer, sizeof(PacketStats), (size_t)packets);
+        }
+    } else if (result == FSO_SUCCESS && packets > 0 &&
+               fseek(fp, (long)(packets * sizeof(PacketStats)), SEEK_CUR) != 0) {
+        result = FSO_ERROR_IO;
+    }
+    if (keep_history) {
+        results->history_length = (size_t)points;
+        results->num_packet_stats = (size_t)packets;
+    }
+
+    char magic[SIM_CACHE_MAGIC_LEN];
+    if (result == FSO_SUCCESS &&
+        (cache_read(fp, magic, 1, sizeof(magic)) != FSO_SUCCESS ||
+         memcmp(magic, SIM_CACHE_END_MAGIC, SIM_CACHE_MAGIC_LEN) != 0)) {
+        result = FSO_ERROR_IO;
+    }
+    fclose(fp);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_WARNING(MODULE_NAME, "Ignoring truncated or corrupt entry %016llx",
+                        (unsigned long long)cache_key_hash(&key));
+        sim_results_free(results);
+        return FSO_ERROR_IO;
+    }
+
+    *run_seed = seed;
+    *cached_packets = (int)packets_covered;
+    FSO_LOG_DEBUG(MODULE_NAME, "Entry %016llx: %d/%d packets",
+                  (unsigned long long)cache_key_hash(&key), *cached_packets, num_packets);
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Store
+ * ============================================================================ */
+
+int sim_cache_store(const SimConfig* config, uint64_t run_seed, const SimResults* results) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(results);
+
+    if (!cache_usable(config)) {
+        return FSO_ERROR_UNSUPPORTED;
+    }
+
+    SimCacheKey key;
+    cache_key_build(config, &key);
+
+    int64_t packets_covered = config->control.num_packets;
+    int32_t has_arrays = (results->history != NULL && results->packet_stats != NULL);
+
+    // Never replace an entry that serves more runs than this one would
+    FILE* fp = NULL;
+    uint64_t old_seed = 0;
+    int64_t old_packets = 0;
+    int32_t old_arrays = 0;
+    if (cache_open_entry(&key, &fp, &old_seed, &old_packets, &old_arrays) == FSO_SUCCESS) {
+        fclose(fp);
+        if (old_packets > packets_covered ||
+            (old_packets == packets_covered && old_arrays >= has_arrays)) {
+            return FSO_SUCCESS;
+        }
+    }
+
+    char path[sizeof(cache_root) + 32];
+    char tmp_file[sizeof(path) + 32];
+    static int tmp_counter = 0;
+    int tmp_id;
+#ifdef _OPENMP
+    #pragma omp atomic capture
+#endif
+    tmp_id = tmp_counter++;
+    cache_entry_path(&key, path, sizeof(path));
+    snprintf(tmp_file, sizeof(tmp_file), "%s.%d.%d.tmp", path, (int)cache_pid(), tmp_id);
+    fp = fopen(tmp_file, "wb");
+    if (fp == NULL) {
+        FSO_LOG_WARNING(MODULE_NAME, "Failed to create cache entry: %s", tmp_file);
+        return FSO_ERROR_IO;
+    }
+
+    uint32_t header[3] = { SIM_CACHE_BOM, (uint32_t)sizeof(SimResults), key.length };
+    uint64_t seed = run_seed;
+    uint64_t points = has_arrays ? results->history_length : 0;
+    uint64_t packets = has_arrays ? results->num_packet_stats : 0;
+
+    int result = cache_write(fp, SIM_CACHE_MAGIC, 1, SIM_CACHE_MAGIC_LEN);
+    if (result == FSO_SUCCESS) result = cache_write(fp, header, sizeof(uint32_t), 3);
+    if (result == FSO_SUCCESS) result = cache_write(fp, key.bytes, 1, key.length);
+    if (result == FSO_SUCCESS) result = cache_write(fp, &seed, sizeof(seed), 1);
+    if (result == FSO_SUCCESS) result = cache_write(fp, &packets_covered, sizeof(packets_covered), 1);
+    if (result == FSO_SUCCESS) result = cache_write(fp, &has_arrays, sizeof(has_arrays), 1);
+    if (result == FSO_SUCCESS) result = cache_write(fp, results, sizeof(SimResults), 1);
+    if (result == FSO_SUCCESS) result = cache_write(fp, &points, sizeof(points), 1);
+    if (result == FSO_SUCCESS) {
+        result = cache_write(fp, results->history, sizeof(TimeSeriesPoint), (size_t)points);
+    }
+    if (result == FSO_SUCCESS) result = cache_write(fp, &packets, sizeof(packets), 1);
+    if (result == FSO_SUCCESS) {
+        result = cache_write(fp, results->packet_stats, sizeof(PacketStats), (size_t)packets);
+    }
+    if (result == FSO_SUCCESS) result = cache_write(fp, SIM_CACHE_END_MAGIC, 1, SIM_CACHE_MAGIC_LEN);
+    if (fclose(fp) != 0 && result == FSO_SUCCESS) {
+        result = FSO_ERROR_IO;
+    }
+
+    // Readers never see a partial entry
+    if (result == FSO_SUCCESS) {
+        remove(path);
+        if (rename(tmp_file, path) != 0) {
+            result = FSO_ERROR_IO;
+        }
+    }
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_WARNING(MODULE_NAME, "Failed to write cache entry: %s", path);
+        remove(tmp_file);
+        return result;
+    }
+
+    FSO_LOG_DEBUG(MODULE_NAME, "Stored %lld packets in %s", (long long)packets_covered, path);
+    return FSO_SUCCESS;
+}
@@ -0,0 +1,332 @@
+/**
+ * @file sim_checkpoint.c
+ * @brief Checkpoint and resume of long simulation runs
+ *
+ * Checkpoint file layout (host byte order; resume needs the same build):
+ *   header:  "FSOCKP01", u32 byte-order mark, u32 sizeof(SimConfig),
+ *            u32 sizeof(SimResults), u32 sizeof(ChannelModel)
+ *   config:  SimConfig with the resolved run seed
+ *   run:     u64 run seed, i64 next packet
+ *   channel: last fade, last log-amplitude, i32 history index,
+ *            i32 history length, history_length doubles of fade history
+ *   results: SimResults bytes (pointers are ignored on restore),
+ *            u64 history length + points, u64 packet count + packets
+ *   stream:  i64 sync offset, u64 rows per table (results stream only)
+ *   end:     "FSOCKEND"
+ *
+ * Packets draw from (seed, packet) RNG streams, so a run's random state
+ * is its seed and next packet; the correlated fading chain is the only
+ * state carried from packet to packet.
+ */
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODULE_NAME "Checkpoint"
+
+#define SIM_CHECKPOINT_MAGIC "FSOCKP01"
+#define SIM_CHECKPOINT_END_MAGIC "FSOCKEND"
+#define SIM_CHECKPOINT_MAGIC_LEN 8
+#define SIM_CHECKPOINT_BOM 0x01020304u
+
+/* ============================================================================
+ * File Helpers
+ * ============================================================================ */
+
+static int ckpt_write(FILE* fp, const void* data, size_t size, size_t count) {
+    return (count == 0 || fwrite(data, size, count, fp) == count) ? FSO_SUCCESS : FSO_ERROR_IO;
+}
+
+static int ckpt_read(FILE* fp, void* data, size_t size, size_t count) {
+    return (count == 0 || fread(data, size, count, fp) == count) ? FSO_SUCCESS : FSO_ERROR_IO;
+}
+
+/**
+ * @brief Read and check the header and configuration of a checkpoint
+ */
+static int ckpt_read_header(FILE* fp, const char* filename, SimConfig* config) {
+    char magic[SIM_CHECKPOINT_MAGIC_LEN];
+    uint32_t header[4];
+    if (ckpt_read(fp, magic, 1, sizeof(magic)) != FSO_SUCCESS ||
+        memcmp(magic, SIM_CHECKPOINT_MAGIC, SIM_CHECKPOINT_MAGIC_LEN) != 0 ||
+        ckpt_read(fp, header, sizeof(uint32_t), 4) != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Not a checkpoint file: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    if (header[0] != SIM_CHECKPOINT_BOM || header[1] != sizeof(SimConfig) ||
+        header[2] != sizeof(SimResults) || header[3] != sizeof(ChannelModel)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Checkpoint %s was written by a different build", filename);
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    if (ckpt_read(fp, config, sizeof(SimConfig), 1) != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Truncated checkpoint: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Save
+ * ============================================================================ */
+
+int sim_checkpoint_save(const SimConfig* config, uint64_t run_seed, int next_packet,
+                        const ChannelModel* channel, SimResults* results) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(channel);
+    FSO_CHECK_NULL(results);
+    FSO_CHECK_PARAM(config->control.checkpoint_file[0] != '\0');
+    FSO_CHECK_PARAM(next_packet >= 0);
+
+    // Rows up to the checkpoint must be on disk before it names them
+    long long stream_offset = 0;
+    if (results->stream != NULL) {
+        int result = sim_stream_writer_sync(results->stream, &stream_offset);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+
+    char tmp_file[sizeof(config->control.checkpoint_file) + 8];
+    snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", config->control.checkpoint_file);
+    FILE* fp = fopen(tmp_file, "wb");
+    if (fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create checkpoint: %s", tmp_file);
+        return FSO_ERROR_IO;
+    }
+
+    // Store the seed actually used, so time-based runs resume identically
+    SimConfig saved = *config;
+    saved.control.random_seed = (unsigned int)run_seed;
+
+    uint32_t header[4] = { SIM_CHECKPOINT_BOM, (uint32_t)sizeof(SimConfig),
+                           (uint32_t)sizeof(SimResults), (uint32_t)sizeof(ChannelModel) };
+    uint64_t seed = run_seed;
+    int64_t next = next_packet;
+    int32_t history[2] = { channel->history_index, channel->history_length };
+    double fade_state[2] = { channel->last_fade_value, channel->last_log_amplitude };
+    uint64_t points = results->history_length;
+    uint64_t packets = results->num_packet_stats;
+
+    int result = ckpt_write(fp, SIM_CHECKPOINT_MAGIC, 1, SIM_CHECKPOINT_MAGIC_LEN);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, header, sizeof(uint32_t), 4);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, &saved, sizeof(SimConfig), 1);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, &seed, sizeof(seed), 1);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, &next, sizeof(next), 1);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, fade_state, sizeof(double), 2);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, history, sizeof(int32_t), 2);
+    if (result == FSO_SUCCESS && channel->history_length > 0) {
+        result = ckpt_write(fp, channel->fade_history, sizeof(double),
+                            (size_t)channel->history_length);
+    }
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, results, sizeof(SimResults), 1);
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, &points, sizeof(points), 1);
+    if (result == FSO_SUCCESS) {
+        result = ckpt_write(fp, results->history, sizeof(TimeSeriesPoint), (size_t)points);
+    }
+    if (result == FSO_SUCCESS) result = ckpt_write(fp, &packets, sizeof(packets), 1);
+    if (result == FSO_SUCCESS) {
+        result = ckpt_write(fp, results->packet_stats, sizeof(PacketStats), (size_t)packets);
+    }
+    if (result == FSO_SUCCESS && results->stream != NULL) {
+        int64_t offset = stream_offset;
+        result = ckpt_write(fp, &offset, sizeof(offset), 1);
+        if (result == FSO_SUCCESS) {
+            result = ckpt_write(fp, results->stream->total_rows, sizeof(unsigned long long),
+                                SIM_STREAM_TABLE_COUNT);
+        }
+    }
+    if (result == FSO_SUCCESS) {
+        result = ckpt_write(fp, SIM_CHECKPOINT_END_MAGIC, 1, SIM_CHECKPOINT_MAGIC_LEN);
+    }
+    if (fclose(fp) != 0 && result == FSO_SUCCESS) {
+        result = FSO_ERROR_IO;
+    }
+
+    // Replace the previous checkpoint only once the new one is complete
+    if (result == FSO_SUCCESS) {
+        remove(config->control.checkpoint_file);
+        if (rename(tmp_file, config->control.checkpoint_file) != 0) {
+            result = FSO_ERROR_IO;
+        }
+    }
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to write checkpoint: %s",
+                      config->control.checkpoint_file);
+        remove(tmp_file);
+        return result;
+    }
+
+    FSO_LOG_DEBUG(MODULE_NAME, "Checkpoint at packet %d written to %s", next_packet,
+                  config->control.checkpoint_file);
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Restore
+ * ============================================================================ */
+
+int sim_checkpoint_read_config(const char* filename, SimConfig* config) {
+    FSO_CHECK_NULL(filename);
+    FSO_CHECK_NULL(config);
+
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open checkpoint: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    int result = ckpt_read_header(fp, filename, config);
+    fclose(fp);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+
+    // Keep checkpointing to the file the run resumes from
+    snprintf(config->control.checkpoint_file, sizeof(config->control.checkpoint_file),
+             "%s", filename);
+    return FSO_SUCCESS;
+}
+
+int sim_checkpoint_restore(const SimConfig* config, ChannelModel* channel,
+                           SimResults* results, int* next_packet) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(channel);
+    FSO_CHECK_NULL(results);
+    FSO_CHECK_NULL(next_packet);
+
+    const char* filename = config->control.checkpoint_file;
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open checkpoint: %s", filename);
+        return FSO_ERROR_IO;
+    }
+
+    SimConfig saved;
+    int result = ckpt_read_header(fp, filename, &saved);
+    if (result != FSO_SUCCESS) {
+        fclose(fp);
+        return result;
+    }
+
+    // Only scheduling and reporting settings may change across a resume
+    uint64_t seed = 0;
+    int64_t next = 0;
+    double fade_state[2];
+    int32_t history[2];
+    saved.control.num_threads = config->control.num_threads;
+    saved.control.verbose = config->control.verbose;
+    saved.control.checkpoint_interval = config->control.checkpoint_interval;
+    memcpy(saved.control.checkpoint_file, config->control.checkpoint_file,
+           sizeof(saved.control.checkpoint_file));
+    if (memcmp(&saved, config, sizeof(SimConfig)) != 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Configuration differs from checkpoint %s", filename);
+        result = FSO_ERROR_INVALID_PARAM;
+    }
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, &seed, sizeof(seed), 1);
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, &next, sizeof(next), 1);
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, fade_state, sizeof(double), 2);
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, history, sizeof(int32_t), 2);
+    if (result == FSO_SUCCESS &&
+        (next < 0 || next > config->control.num_packets ||
+         history[1] != channel->history_length ||
+         history[0] < 0 || (history[1] > 0 && history[0] >= history[1]))) {
+        FSO_LOG_ERROR(MODULE_NAME, "Inconsistent run state in checkpoint %s", filename);
+        result = FSO_ERROR_IO;
+    }
+    if (result == FSO_SUCCESS && channel->history_length > 0) {
+        result = ckpt_read(fp, channel->fade_history, sizeof(double),
+                           (size_t)channel->history_length);
+    }
+    if (result != FSO_SUCCESS) {
+        fclose(fp);
+        return result;
+    }
+    channel->last_fade_value = fade_state[0];
+    channel->last_log_amplitude = fade_state[1];
+    channel->history_index = history[0];
+
+    // Fresh results for the configuration; the stream reopens at its sync
+    // point instead of starting over
+    int streaming = (config->control.results_stream[0] != '\0');
+    result = streaming ? sim_results_init(results, 0, 0)
+                       : sim_results_init_run(results, config, 1);
+    if (result != FSO_SUCCESS) {
+        fclose(fp);
+        return result;
+    }
+
+    // Saved aggregates over the fresh results, keeping its own buffers
+    TimeSeriesPoint* history_buffer = results->history;
+    size_t history_capacity = results->history_capacity;
+    PacketStats* packet_buffer = results->packet_stats;
+    uint64_t points = 0;
+    uint64_t packets = 0;
+    result = ckpt_read(fp, results, sizeof(SimResults), 1);
+    results->history = history_buffer;
+    results->history_capacity = history_capacity;
+    results->packet_stats = packet_buffer;
+    results->stream = NULL;
+    results->history_length = 0;
+    results->num_packet_stats = 0;
+
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, &points, sizeof(points), 1);
+    if (result == FSO_SUCCESS && points > history_capacity) result = FSO_ERROR_IO;
+    if (result == FSO_SUCCESS) {
+        result = ckpt_read(fp, history_buffer, sizeof(TimeSeriesPoint), (size_t)points);
+    }
+    if (result == FSO_SUCCESS) result = ckpt_read(fp, &packets, sizeof(packets), 1);
+    if (result == FSO_SUCCESS && packets > (uint64_t)(packet_buffer ? config->control.num_packets : 0)) {
+        result = FSO_ERROR_IO;
+    }
+    if (result == FSO_SUCCESS) {
+        result = ckpt_read(fp, packet_buffer, sizeof(PacketStats), (size_t)packets);
+    }
+    results->history_length = (size_t)points;
+    results->num_packet_stats = (int)packets;
+
+    int64_t stream_offset = 0;
+    unsigned long long stream_rows[SIM_STREAM_TABLE_COUNT];
+    if (result == FSO_SUCCESS && streaming) {
+        result = ckpt_read(fp, &stream_offset, sizeof(stream_offset), 1);
+        if (result == FSO_SUCCESS) {
+            result = ckpt_read(fp, stream_rows, sizeof(unsigned long long), SIM_STREAM_TABLE_COUNT);
+        }
+    }
+    char magic[SIM_CHECKPOINT_MAGIC_LEN];
+    if (result == FSO_SUCCESS &&
+        (ckpt_read(fp, magic, 1, sizeof(magic)) != FSO_SUCCESS ||
+         memcmp(magic, SIM_CHECKPOINT_END_MAGIC, SIM_CHECKPOINT_MAGIC_LEN) != 0)) {
+        result = FSO_ERROR_IO;
+    }
+    fclose(fp);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Truncated or corrupt checkpoint: %s", filename);
+        sim_results_free(results);
+        return result;
+    }
+
+    if (streaming) {
+        results->stream = (SimStreamWriter*)malloc(sizeof(SimStreamWriter));
+        if (results->stream == NULL) {
+            sim_results_free(results);
+            return FSO_ERROR_MEMORY;
+        }
+        unsigned int flags = (config->system.enable_tracking ? SIM_STREAM_FLAG_TRACKING : 0u) |
+                             (config->control.importance_sampling ? SIM_STREAM_FLAG_IMPORTANCE : 0u) |
+                             (config->system.harq.enabled ? SIM_STREAM_FLAG_HARQ : 0u);
+        result = sim_stream_writer_reopen(results->stream, config->control.results_stream, flags,
+                                          (long long)stream_offset, stream_rows);
+        if (result != FSO_SUCCESS) {
+            free(results->stream);
+            results->stream = NULL;
+            sim_results_free(results);
+            return result;
+        }
+    }
+
+    *next_packet = (int)next;
+    FSO_LOG_INFO(MODULE_NAME, "Restored checkpoint %s at packet %d/%d", filename,
+                 *next_packet, config->control.num_packets);
+    return FSO_SUCCESS;
+}
@@ -26,12 +26,19 @@
 #define DEFAULT_HUMIDITY 0.5
 #define DEFAULT_VISIBILITY 10000.0
 #define DEFAULT_CORRELATION_TIME 0.001      // 1 ms
+#define DEFAULT_MALAGA_OMEGA 0.86
+#define DEFAULT_MALAGA_RHO 0.6
 
 #define DEFAULT_MODULATION MOD_OOK
 #define DEFAULT_PPM_ORDER 4
 #define DEFAULT_FEC_TYPE FEC_REED_SOLOMON
 #define DEFAULT_CODE_RATE 0.8
 #define DEFAULT_INTERLEAVER_DEPTH 10
+#define DEFAULT_AMC_HYSTERESIS_DB 1.0
+#define DEFAULT_AMC_FEEDBACK_INTERVAL 16
+#define DEFAULT_HARQ_MAX_TRANSMISSIONS 4
+#define DEFAULT_HARQ_INITIAL_RATE (5.0 / 6.0)
+#define DEFAULT_HARQ_ROUND_TRIP_TIME 1e-3  // 1 ms
 
 #define DEFAULT_SIMULATION_TIME 1.0         // 1 second
 #define DEFAULT_SAMPLE_RATE 1e6             // 1 MHz
@@ -66,6 +73,11 @@ int sim_config_init_defaults(SimConfig* config) {
     config->environment.rainfall_rate = 0.0;
     config->environment.snowfall_rate = 0.0;
     config->environment.correlation_time = DEFAULT_CORRELATION_TIME;
+    config->environment.fading_model = CHANNEL_FADING_LOG_NORMAL;
+    config->environment.malaga_omega = DEFAULT_MALAGA_OMEGA;
+    config->environment.malaga_rho = DEFAULT_MALAGA_RHO;
+    config->environment.intra_packet_fading = 0;
+    config->environment.fade_block_symbols = 1;
     
     // System configuration
     config->system.modulation = DEFAULT_MODULATION;
@@ -74,8 +86,21 @@ int sim_config_init_defaults(SimConfig* config) {
     config->system.code_rate = DEFAULT_CODE_RATE;
     config->system.use_interleaver = 1;
     config->system.interleaver_depth = DEFAULT_INTERLEAVER_DEPTH;
+    config->system.interleaver_type = INTERLEAVER_BLOCK;
+    config->system.soft_decision = 0;
+    config->system.precision = FSO_PRECISION_DOUBLE;
     config->system.enable_tracking = 0;
     config->system.tracking_update_rate = 100.0;
+    memset(&config->system.amc, 0, sizeof(SimAMCConfig));  // Fixed mode, default ladder
+    config->system.amc.hysteresis_db = DEFAULT_AMC_HYSTERESIS_DB;
+    config->system.amc.feedback_interval = DEFAULT_AMC_FEEDBACK_INTERVAL;
+    config->system.amc.smoothing = 0.5;
+    config->system.amc.trend_smoothing = 0.1;
+    config->system.amc.prediction_horizon = 0;
+    config->system.harq.enabled = 0;
+    config->system.harq.max_transmissions = DEFAULT_HARQ_MAX_TRANSMISSIONS;
+    config->system.harq.initial_rate = DEFAULT_HARQ_INITIAL_RATE;
+    config->system.harq.round_trip_time = DEFAULT_HARQ_ROUND_TRIP_TIME;
     
     // Simulation control
     config->control.simulation_time = DEFAULT_SIMULATION_TIME;
@@ -84,6 +109,16 @@ int sim_config_init_defaults(SimConfig* config) {
     config->control.num_packets = DEFAULT_NUM_PACKETS;
     config->control.noise_floor = DEFAULT_NOISE_FLOOR;
     config->control.random_seed = 0;  // Time-based
+    config->control.num_threads = 1;
+    config->control.target_bit_errors = 0;      // Fixed packet count
+    config->control.target_relative_error = 0.0;
+    config->control.confidence_level = 0.95;
+    config->control.importance_sampling = 0;
+    config->control.is_fade_shift = -2.0;   // Used only with importance_sampling
+    config->control.is_noise_shift = 0.0;
+    config->control.results_stream[0] = '\0';  // Keep results in memory
+    config->control.checkpoint_file[0] = '\0'; // No checkpoints
+    config->control.checkpoint_interval = 60.0;
     config->control.verbose = 0;
     
     FSO_LOG_INFO("SimConfig", "Initialized with default values");
@@ -94,6 +129,125 @@ int sim_config_init_defaults(SimConfig* config) {
  * Configuration Validation
  * ============================================================================ */
 
+/**
+ * @brief Validate the adaptive modulation and coding parameters
+ */
+static int validate_amc(const SimConfig* config) {
+    const SimAMCConfig* amc = &config->system.amc;
+    
+    if (amc->num_modes < 0 || amc->num_modes > SIM_AMC_MAX_MODES) {
+        FSO_LOG_ERROR("SimConfig", "AMC ladder must have 0 to %d modes, got %d",
+                     SIM_AMC_MAX_MODES, amc->num_modes);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    for (int m = 0; m < amc->num_modes; m++) {
+        const SimAMCMode* mode = &amc->modes[m];
+        if (mode->modulation != MOD_OOK && mode->modulation != MOD_PPM) {
+            FSO_LOG_ERROR("SimConfig", "AMC mode %d: only OOK and PPM can adapt", m);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+        if (mode->modulation == MOD_PPM && mode->ppm_order != 2 && mode->ppm_order != 4 &&
+            mode->ppm_order != 8 && mode->ppm_order != 16) {
+            FSO_LOG_ERROR("SimConfig", "AMC mode %d: PPM order must be 2, 4, 8, or 16, got %d",
+                         m, mode->ppm_order);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+        if (mode->code_rate <= 0.0 || mode->code_rate >= 1.0) {
+            FSO_LOG_ERROR("SimConfig", "AMC mode %d: code rate must be between 0 and 1, got %.2f",
+                         m, mode->code_rate);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+        if (!isfinite(mode->min_snr_db) ||
+            (m > 0 && mode->min_snr_db < amc->modes[m - 1].min_snr_db)) {
+            FSO_LOG_ERROR("SimConfig", "AMC thresholds must be finite and non-decreasing (mode %d)", m);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    if (amc->feedback_interval < 1 || amc->feedback_interval > SIM_AMC_MAX_INTERVAL) {
+        FSO_LOG_ERROR("SimConfig", "AMC feedback interval must be between 1 and %d packets, got %d",
+                     SIM_AMC_MAX_INTERVAL, amc->feedback_interval);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (!isfinite(amc->hysteresis_db) || amc->hysteresis_db < 0.0 ||
+        !(amc->smoothing > 0.0 && amc->smoothing <= 1.0) ||
+        !(amc->trend_smoothing >= 0.0 && amc->trend_smoothing <= 1.0) ||
+        amc->prediction_horizon < 0) {
+        FSO_LOG_ERROR("SimConfig", "AMC needs hysteresis >= 0, 0 < alpha <= 1, 0 <= beta <= 1 "
+                     "and a non-negative horizon");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // One estimate per packet describes a block-faded packet only
+    if (config->environment.intra_packet_fading) {
+        FSO_LOG_ERROR("SimConfig", "Adaptive modulation needs block fading (disable intra-packet fading)");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // The controller state is not part of a checkpoint
+    if (config->control.checkpoint_file[0] != '\0') {
+        FSO_LOG_ERROR("SimConfig", "Adaptive modulation runs cannot be checkpointed");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Validate the hybrid ARQ parameters
+ */
+static int validate_harq(const SimConfig* config) {
+    const SimHARQConfig* harq = &config->system.harq;
+    
+    if (harq->max_transmissions < 2 || harq->max_transmissions > SIM_HARQ_MAX_TRANSMISSIONS) {
+        FSO_LOG_ERROR("SimConfig", "HARQ transmissions must be between 2 and %d, got %d",
+                     SIM_HARQ_MAX_TRANSMISSIONS, harq->max_transmissions);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Retransmissions add parity of the mother code, so the first must be punctured
+    if (!(harq->initial_rate > config->system.code_rate && harq->initial_rate < 1.0)) {
+        FSO_LOG_ERROR("SimConfig", "HARQ initial rate must be above the code rate (%.3f) and "
+                     "below 1, got %.3f", config->system.code_rate, harq->initial_rate);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (!isfinite(harq->round_trip_time) || harq->round_trip_time < 0.0) {
+        FSO_LOG_ERROR("SimConfig", "HARQ round-trip time must be non-negative, got %.3e s",
+                     harq->round_trip_time);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Incremental redundancy needs a punctured code and soft combining
+    if (config->system.fec_type != FEC_LDPC || !config->system.soft_decision) {
+        FSO_LOG_ERROR("SimConfig", "HARQ requires soft-decision LDPC decoding");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Transmissions are segments of the codeword in puncturing order, with
+    // one fade and unbiased draws each
+    if (config->system.use_interleaver) {
+        FSO_LOG_ERROR("SimConfig", "HARQ cannot be combined with the interleaver");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    if (config->environment.intra_packet_fading) {
+        FSO_LOG_ERROR("SimConfig", "HARQ needs block fading (disable intra-packet fading)");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    if (config->control.importance_sampling) {
+        FSO_LOG_ERROR("SimConfig", "HARQ cannot be combined with importance sampling");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    if (config->system.amc.enabled || config->system.enable_tracking) {
+        FSO_LOG_ERROR("SimConfig", "HARQ cannot be combined with adaptive modulation or beam tracking");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    return FSO_SUCCESS;
+}
+
 int sim_config_validate(const SimConfig* config) {
     if (config == NULL) {
         FSO_LOG_ERROR("SimConfig", "NULL config pointer");
@@ -151,6 +305,20 @@ int sim_config_validate(const SimConfig* config) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    if (config->environment.fading_model < CHANNEL_FADING_LOG_NORMAL ||
+        config->environment.fading_model > CHANNEL_FADING_MALAGA) {
+        FSO_LOG_ERROR("SimConfig", "Invalid fading model: %d", config->environment.fading_model);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->environment.fading_model == CHANNEL_FADING_MALAGA &&
+        (config->environment.malaga_omega <= 0.0 || config->environment.malaga_omega >= 1.0 ||
+         config->environment.malaga_rho < 0.0 || config->environment.malaga_rho >= 1.0)) {
+        FSO_LOG_ERROR("SimConfig", "Malaga parameters need 0 < Omega < 1 and 0 <= rho < 1, got %.3f, %.3f",
+                     config->environment.malaga_omega, config->environment.malaga_rho);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
     if (config->environment.temperature < -50.0 || config->environment.temperature > 50.0) {
         FSO_LOG_ERROR("SimConfig", "Temperature must be between -50°C and 50°C, got %.1f°C",
                      config->environment.temperature);
@@ -175,6 +343,12 @@ int sim_config_validate(const SimConfig* config) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    if (config->environment.intra_packet_fading && config->environment.fade_block_symbols < 1) {
+        FSO_LOG_ERROR("SimConfig", "Fade sub-blocks need at least 1 symbol, got %d",
+                     config->environment.fade_block_symbols);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
     // Validate system parameters
     if (config->system.modulation < MOD_OOK || config->system.modulation > MOD_DPSK) {
         FSO_LOG_ERROR("SimConfig", "Invalid modulation type: %d", config->system.modulation);
@@ -207,12 +381,64 @@ int sim_config_validate(const SimConfig* config) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    // Custom tables are installed through the FEC API, not the config
+    if (config->system.interleaver_type < INTERLEAVER_BLOCK ||
+        config->system.interleaver_type > INTERLEAVER_CONVOLUTIONAL) {
+        FSO_LOG_ERROR("SimConfig", "Invalid interleaver type: %d", config->system.interleaver_type);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->system.soft_decision) {
+        if (config->system.modulation == MOD_DPSK) {
+            FSO_LOG_ERROR("SimConfig", "Soft-decision decoding is not available for DPSK");
+            return FSO_ERROR_INVALID_PARAM;
+        }
+        if (config->control.noise_floor <= 0.0) {
+            FSO_LOG_ERROR("SimConfig", "Soft-decision decoding requires a positive noise floor");
+            return FSO_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    if (config->system.precision < FSO_PRECISION_DOUBLE ||
+        config->system.precision > FSO_PRECISION_INT8) {
+        FSO_LOG_ERROR("SimConfig", "Invalid precision: %d", config->system.precision);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->system.precision != FSO_PRECISION_DOUBLE && config->system.modulation == MOD_DPSK) {
+        FSO_LOG_ERROR("SimConfig", "Reduced precision is not available for DPSK");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Quantized LLRs only exist on the soft LDPC path
+    if ((config->system.precision == FSO_PRECISION_INT16 ||
+         config->system.precision == FSO_PRECISION_INT8) &&
+        (!config->system.soft_decision || config->system.fec_type != FEC_LDPC)) {
+        FSO_LOG_ERROR("SimConfig", "%s precision requires soft-decision LDPC decoding",
+                     sim_precision_string(config->system.precision));
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
     if (config->system.tracking_update_rate <= 0.0 || config->system.tracking_update_rate > 1000.0) {
         FSO_LOG_ERROR("SimConfig", "Tracking update rate must be between 0 and 1000 Hz, got %.1f Hz",
                      config->system.tracking_update_rate);
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    if (config->system.amc.enabled) {
+        int result = validate_amc(config);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    if (config->system.harq.enabled) {
+        int result = validate_harq(config);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
     // Validate simulation control parameters
     if (config->control.simulation_time <= 0.0) {
         FSO_LOG_ERROR("SimConfig", "Simulation time must be positive, got %.3f s",
@@ -232,9 +458,12 @@ int sim_config_validate(const SimConfig* config) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    if (config->control.num_packets < 1 || config->control.num_packets > 1000000) {
-        FSO_LOG_ERROR("SimConfig", "Number of packets must be between 1 and 1000000, got %d",
-                     config->control.num_packets);
+    // In-memory history bounds the run; a results stream keeps only aggregates
+    int max_packets = (config->control.results_stream[0] != '\0') ?
+                      SIM_MAX_STREAM_PACKETS : SIM_MAX_PACKETS;
+    if (config->control.num_packets < 1 || config->control.num_packets > max_packets) {
+        FSO_LOG_ERROR("SimConfig", "Number of packets must be between 1 and %d, got %d",
+                     max_packets, config->control.num_packets);
         return FSO_ERROR_INVALID_PARAM;
     }
     
@@ -244,6 +473,53 @@ int sim_config_validate(const SimConfig* config) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    if (config->control.num_threads < 0) {
+        FSO_LOG_ERROR("SimConfig", "Thread count must be non-negative, got %d",
+                     config->control.num_threads);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->control.target_bit_errors < 0) {
+        FSO_LOG_ERROR("SimConfig", "Target bit errors must be non-negative, got %d",
+                     config->control.target_bit_errors);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->control.target_relative_error < 0.0) {
+        FSO_LOG_ERROR("SimConfig", "Target relative error must be non-negative, got %.3f",
+                     config->control.target_relative_error);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->control.target_relative_error > 0.0 &&
+        (config->control.confidence_level <= 0.0 || config->control.confidence_level >= 1.0)) {
+        FSO_LOG_ERROR("SimConfig", "Confidence level must be between 0 and 1, got %.3f",
+                     config->control.confidence_level);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->control.importance_sampling &&
+        (!isfinite(config->control.is_fade_shift) || !isfinite(config->control.is_noise_shift) ||
+         fabs(config->control.is_fade_shift) > 10.0 || fabs(config->control.is_noise_shift) > 10.0)) {
+        FSO_LOG_ERROR("SimConfig", "Importance-sampling shifts must be within +/-10 sigma, got %.3f / %.3f",
+                     config->control.is_fade_shift, config->control.is_noise_shift);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // The fade tilt weights one draw per packet, not a sub-block trace
+    if (config->control.importance_sampling && config->control.is_fade_shift != 0.0 &&
+        sim_fade_profile_length(config) > 0) {
+        FSO_LOG_ERROR("SimConfig", "Fade-tilted importance sampling needs block fading "
+                     "(disable intra-packet fading or set is_fade_shift to 0)");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+
+    if (!isfinite(config->control.checkpoint_interval) || config->control.checkpoint_interval < 0.0) {
+        FSO_LOG_ERROR("SimConfig", "Checkpoint interval must be non-negative, got %.3f s",
+                     config->control.checkpoint_interval);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+
     FSO_LOG_INFO("SimConfig", "Configuration validated successfully");
     return FSO_SUCCESS;
 }
@@ -292,6 +568,7 @@ int sim_config_create_preset(SimConfig* config, const char* scenario_name) {
         config->environment.weather = WEATHER_HIGH_TURBULENCE;
         config->environment.turbulence_strength = 1e-13;
         config->environment.temperature = 35.0;
+        config->environment.fading_model = CHANNEL_FADING_GAMMA_GAMMA;  // Beyond log-normal validity
         config->link.link_distance = 1500.0;
         config->system.enable_tracking = 1;  // Enable tracking for high turbulence
         FSO_LOG_INFO("SimConfig", "Created 'high_turbulence' preset configuration");
@@ -338,6 +615,12 @@ void sim_config_print(const SimConfig* config) {
     printf("  Temperature:          %.1f °C\n", config->environment.temperature);
     printf("  Humidity:             %.1f%%\n", config->environment.humidity * 100.0);
     printf("  Visibility:           %.1f m\n", config->environment.visibility);
+    printf("  Fading Model:         %s", channel_get_fading_model_name(config->environment.fading_model));
+    if (config->environment.fading_model == CHANNEL_FADING_MALAGA) {
+        printf(" (Omega %.2f, rho %.2f)", config->environment.malaga_omega,
+               config->environment.malaga_rho);
+    }
+    printf("\n");
     if (config->environment.rainfall_rate > 0.0) {
         printf("  Rainfall Rate:        %.1f mm/hr\n", config->environment.rainfall_rate);
     }
@@ -345,6 +628,15 @@ void sim_config_print(const SimConfig* config) {
         printf("  Snowfall Rate:        %.1f mm/hr\n", config->environment.snowfall_rate);
     }
     printf("  Correlation Time:     %.3f ms\n", config->environment.correlation_time * 1000.0);
+    if (config->environment.intra_packet_fading) {
+        size_t blocks = sim_fade_profile_length(config);
+        if (blocks > 0) {
+            printf("  Intra-Packet Fading:  %zu sub-blocks of %d symbol(s)\n", blocks,
+                   config->environment.fade_block_symbols);
+        } else {
+            printf("  Intra-Packet Fading:  block fading (coherence >> packet)\n");
+        }
+    }
     printf("\n");
     
     printf("System Configuration:\n");
@@ -357,14 +649,29 @@ void sim_config_print(const SimConfig* config) {
     printf("  Code Rate:            %.2f\n", config->system.code_rate);
     printf("  Interleaver:          %s", config->system.use_interleaver ? "Enabled" : "Disabled");
     if (config->system.use_interleaver) {
-        printf(" (depth %d)", config->system.interleaver_depth);
+        printf(" (%s, depth %d)", interleaver_type_string(config->system.interleaver_type),
+               config->system.interleaver_depth);
     }
     printf("\n");
+    printf("  Decoder Input:        %s\n", config->system.soft_decision ? "Soft (LLR)" : "Hard");
+    printf("  Precision:            %s\n", sim_precision_string(config->system.precision));
     printf("  Beam Tracking:        %s", config->system.enable_tracking ? "Enabled" : "Disabled");
     if (config->system.enable_tracking) {
         printf(" (%.1f Hz)", config->system.tracking_update_rate);
     }
     printf("\n");
+    if (config->system.amc.enabled) {
+        SimAMCMode ladder[SIM_AMC_MAX_MODES];
+        int num_modes = (config->system.amc.num_modes > 0) ? config->system.amc.num_modes :
+                        sim_amc_default_ladder(ladder);
+        printf("  Adaptive Mod/Coding:  %d modes, feedback every %d packets, %.1f dB hysteresis\n",
+               num_modes, config->system.amc.feedback_interval, config->system.amc.hysteresis_db);
+    }
+    if (config->system.harq.enabled) {
+        printf("  Hybrid ARQ:           up to %d transmissions from rate %.3f, %.3e s round trip\n",
+               config->system.harq.max_transmissions, config->system.harq.initial_rate,
+               config->system.harq.round_trip_time);
+    }
     printf("\n");
     
     printf("Simulation Control:\n");
@@ -378,6 +685,35 @@ void sim_config_print(const SimConfig* config) {
     printf("  Random Seed:          %u%s\n", 
            config->control.random_seed,
            config->control.random_seed == 0 ? " (time-based)" : "");
+    printf("  Threads:              %d%s\n", config->control.num_threads,
+           config->control.num_threads == 0 ? " (all available)" : "");
+    printf("  SIMD Kernels:         %s\n", fso_cpu_simd_name(fso_cpu_simd_level()));
+    if (config->control.target_bit_errors > 0 || config->control.target_relative_error > 0.0) {
+        printf("  Stopping Rule:        ");
+        if (config->control.target_bit_errors > 0) {
+            printf("%d bit errors", config->control.target_bit_errors);
+        }
+        if (config->control.target_bit_errors > 0 && config->control.target_relative_error > 0.0) {
+            printf(" or ");
+        }
+        if (config->control.target_relative_error > 0.0) {
+            printf("+/-%.1f%% at %.1f%% confidence",
+                   config->control.target_relative_error * 100.0,
+                   config->control.confidence_level * 100.0);
+        }
+        printf(" (max %d packets)\n", config->control.num_packets);
+    }
+    if (config->control.importance_sampling) {
+        printf("  Importance Sampling:  fade shift %.2f sigma, noise shift %.2f sigma\n",
+               config->control.is_fade_shift, config->control.is_noise_shift);
+    }
+    if (config->control.results_stream[0] != '\0') {
+        printf("  Results Stream:       %s\n", config->control.results_stream);
+    }
+    if (config->control.checkpoint_file[0] != '\0') {
+        printf("  Checkpoint:           %s (every %.0f s)\n", config->control.checkpoint_file,
+               config->control.checkpoint_interval);
+    }
     printf("  Verbose:              %s\n", config->control.verbose ? "Yes" : "No");
     printf("\n");
 }
@@ -403,6 +739,16 @@ const char* sim_fec_string(FECType type) {
     }
 }
 
+const char* sim_precision_string(FSOPrecision precision) {
+    switch (precision) {
+        case FSO_PRECISION_DOUBLE: return "Double";
+        case FSO_PRECISION_SINGLE: return "Single";
+        case FSO_PRECISION_INT16:  return "Int16";
+        case FSO_PRECISION_INT8:   return "Int8";
+        default:                   return "Unknown";
+    }
+}
+
 const char* sim_weather_string(WeatherCondition weather) {
     switch (weather) {
         case WEATHER_CLEAR:           return "Clear";
@@ -0,0 +1,406 @@
+/**
+ * @file sim_distributed.c
+ * @brief Sweeps across processes (MPI, optional)
+ *
+ * Rank 0 coordinates and the other ranks work. The coordinator splits the
+ * sweep into units: a packet range of a fixed-budget configuration, or a
+ * whole configuration when a stopping rule or tracking makes packets
+ * depend on each other. Units go out in configuration order to whichever
+ * worker reports back first. Workers run a unit on all their threads and
+ * return aggregates-only SimResults; the coordinator merges the ranges of
+ * a configuration in packet order, whatever order they arrive in, and
+ * summarizes each configuration into a sweep row once complete.
+ *
+ * Every packet draws from (run seed, packet) RNG streams and each range
+ * replays the fading chain from packet 0, so the outcome does not depend
+ * on the number of ranks or on the schedule. Rank 0 resolves time-based
+ * seeds and broadcasts them.
+ *
+ * Results travel as raw SimResults bytes, so all ranks must share one
+ * build and architecture. Built without FSO_ENABLE_MPI (make MPI=1), the
+ * group is a single process and sweeps run through sim_run_sweep().
+ */
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef FSO_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#define MODULE_NAME "Distributed"
+
+/* ============================================================================
+ * Process Group
+ * ============================================================================ */
+
+#ifdef FSO_ENABLE_MPI
+static int sim_dist_owns_mpi = 0;
+#endif
+
+int sim_dist_init(int* argc, char*** argv) {
+#ifdef FSO_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        int provided;
+        if (MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided) != MPI_SUCCESS) {
+            FSO_LOG_ERROR(MODULE_NAME, "MPI_Init failed");
+            return FSO_ERROR_NOT_INITIALIZED;
+        }
+        sim_dist_owns_mpi = 1;
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+    return FSO_SUCCESS;
+}
+
+void sim_dist_finalize(void) {
+#ifdef FSO_ENABLE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (sim_dist_owns_mpi && !finalized) {
+        MPI_Finalize();
+    }
+#endif
+}
+
+int sim_dist_rank(void) {
+#ifdef FSO_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized) {
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        return rank;
+    }
+#endif
+    return 0;
+}
+
+int sim_dist_size(void) {
+#ifdef FSO_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized) {
+        int size;
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        return size;
+    }
+#endif
+    return 1;
+}
+
+#ifdef FSO_ENABLE_MPI
+
+/* ============================================================================
+ * Work Units
+ * ============================================================================ */
+
+/* Message tags */
+#define SIM_DIST_TAG_WORK 1
+#define SIM_DIST_TAG_RESULT 2
+
+/**
+ * @brief One unit of work: packets [begin, end) of a configuration
+ *
+ * unit < 0 tells a worker to stop.
+ */
+typedef struct {
+    int unit;
+    int config;
+    int begin;
+    int end;
+} SimDistUnit;
+
+/**
+ * @brief A worker's answer for one unit
+ */
+typedef struct {
+    int unit;
+    int status;
+    SimResults results;          /* Aggregates only; pointers are cleared */
+} SimDistReply;
+
+/**
+ * @brief Whether a configuration's packets can run as independent ranges
+ */
+static int sim_dist_splittable(const SimConfig* config) {
+    return !config->system.enable_tracking && !config->system.amc.enabled &&
+           !config->system.harq.enabled && config->control.target_bit_errors <= 0 &&
+           config->control.target_relative_error <= 0.0;
+}
+
+/**
+ * @brief Worker loop: run units until told to stop
+ */
+static void sim_dist_worker(const SimConfig* configs, const unsigned int* seeds,
+                            int num_threads) {
+    SimDistReply* reply = (SimDistReply*)malloc(sizeof(SimDistReply));
+    if (reply == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate reply buffer");
+        MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+        return;
+    }
+
+    for (;;) {
+        SimDistUnit unit;
+        MPI_Recv(&unit, (int)sizeof(unit), MPI_BYTE, 0, SIM_DIST_TAG_WORK,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        if (unit.unit < 0) {
+            break;
+        }
+
+        SimConfig config = configs[unit.config];
+        config.control.random_seed = seeds[unit.config];
+        config.control.num_threads = num_threads;
+        config.control.results_stream[0] = '\0';
+
+        memset(reply, 0, sizeof(SimDistReply));
+        reply->unit = unit.unit;
+        if (unit.begin == 0 && unit.end == config.control.num_packets &&
+            !sim_dist_splittable(&config)) {
+            reply->status = sim_run_aggregates(&config, &reply->results);
+        } else {
+            reply->status = sim_run_packet_range(&config, unit.begin, unit.end,
+                                                 &reply->results);
+        }
+
+        // Drop any arrays the run kept; the aggregates travel by value
+        if (reply->status == FSO_SUCCESS) {
+            sim_results_free(&reply->results);
+        }
+        MPI_Send(reply, (int)sizeof(SimDistReply), MPI_BYTE, 0, SIM_DIST_TAG_RESULT,
+                 MPI_COMM_WORLD);
+    }
+
+    free(reply);
+}
+
+/**
+ * @brief Coordinator state for one configuration
+ */
+typedef struct {
+    int first_unit;              /* Index of the configuration's first unit */
+    int num_units;               /* Units of the configuration */
+    int next_merge;              /* Units merged so far (in packet order) */
+    int status;                  /* First error of any unit */
+    SimResults merged;           /* Running merge of units [0, next_merge) */
+} SimDistConfigState;
+
+/**
+ * @brief Fold every unit of a configuration that is ready, in order
+ *
+ * @return 1 once all of the configuration's units are folded
+ */
+static int sim_dist_fold_ready(SimDistConfigState* state, SimDistReply** pending) {
+    while (state->next_merge < state->num_units &&
+           pending[state->first_unit + state->next_merge] != NULL) {
+        SimDistReply* reply = pending[state->first_unit + state->next_merge];
+        if (reply->status != FSO_SUCCESS) {
+            if (state->status == FSO_SUCCESS) {
+                state->status = reply->status;
+            }
+        } else if (state->status == FSO_SUCCESS) {
+            if (state->num_units == 1) {
+                // A whole run keeps its stop reason and timing as is
+                state->merged = reply->results;
+            } else {
+                int result = sim_results_merge(&state->merged, &reply->results);
+                if (result != FSO_SUCCESS) {
+                    state->status = result;
+                }
+            }
+        }
+        free(reply);
+        pending[state->first_unit + state->next_merge] = NULL;
+        state->next_merge++;
+    }
+    return state->next_merge == state->num_units;
+}
+
+/**
+ * @brief Coordinator loop: hand out units, merge replies, fill rows
+ */
+static int sim_dist_coordinate(const SimConfig* configs, int num_configs, int chunk_packets,
+                               int num_workers, SimSweepRow* rows) {
+    SimDistConfigState* states =
+        (SimDistConfigState*)calloc((size_t)num_configs, sizeof(SimDistConfigState));
+    if (states == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate sweep state");
+        MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+        return 0;
+    }
+
+    // Lay out the units: ranges of chunk_packets, or one whole run
+    int num_units = 0;
+    for (int c = 0; c < num_configs; c++) {
+        int packets = configs[c].control.num_packets;
+        states[c].first_unit = num_units;
+        states[c].num_units = (sim_dist_splittable(&configs[c]) && packets > chunk_packets) ?
+                              (packets + chunk_packets - 1) / chunk_packets : 1;
+        states[c].status = FSO_SUCCESS;
+        if (states[c].num_units > 1) {
+            sim_results_init(&states[c].merged, 0, 0);
+            states[c].merged.confidence_level = configs[c].control.confidence_level;
+            states[c].merged.importance_sampling = configs[c].control.importance_sampling;
+        }
+        num_units += states[c].num_units;
+    }
+
+    SimDistUnit* units = (SimDistUnit*)malloc((size_t)num_units * sizeof(SimDistUnit));
+    SimDistReply** pending = (SimDistReply**)calloc((size_t)num_units, sizeof(SimDistReply*));
+    if (units == NULL || pending == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate unit table");
+        MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+        return 0;
+    }
+    for (int c = 0; c < num_configs; c++) {
+        int packets = configs[c].control.num_packets;
+        for (int k = 0; k < states[c].num_units; k++) {
+            SimDistUnit* unit = &units[states[c].first_unit + k];
+            unit->unit = states[c].first_unit + k;
+            unit->config = c;
+            unit->begin = (states[c].num_units == 1) ? 0 : k * chunk_packets;
+            unit->end = (states[c].num_units == 1) ? packets :
+                        FSO_MIN((k + 1) * chunk_packets, packets);
+        }
+    }
+
+    FSO_LOG_INFO(MODULE_NAME, "Running %d configurations as %d units on %d worker(s)",
+                 num_configs, num_units, num_workers);
+
+    const SimDistUnit stop = { -1, 0, 0, 0 };
+    int next_unit = 0;
+    int active = 0;
+    int successful = 0;
+
+    for (int w = 1; w <= num_workers; w++) {
+        const SimDistUnit* unit = (next_unit < num_units) ? &units[next_unit++] : &stop;
+        MPI_Send(unit, (int)sizeof(SimDistUnit), MPI_BYTE, w, SIM_DIST_TAG_WORK, MPI_COMM_WORLD);
+        if (unit->unit >= 0) {
+            active++;
+        }
+    }
+
+    while (active > 0) {
+        SimDistReply* reply = (SimDistReply*)malloc(sizeof(SimDistReply));
+        if (reply == NULL) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate reply buffer");
+            MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+            return 0;
+        }
+        MPI_Status status;
+        MPI_Recv(reply, (int)sizeof(SimDistReply), MPI_BYTE, MPI_ANY_SOURCE,
+                 SIM_DIST_TAG_RESULT, MPI_COMM_WORLD, &status);
+        active--;
+
+        // Keep the worker busy before merging
+        const SimDistUnit* unit = (next_unit < num_units) ? &units[next_unit++] : &stop;
+        MPI_Send(unit, (int)sizeof(SimDistUnit), MPI_BYTE, status.MPI_SOURCE,
+                 SIM_DIST_TAG_WORK, MPI_COMM_WORLD);
+        if (unit->unit >= 0) {
+            active++;
+        }
+
+        int c = units[reply->unit].config;
+        pending[reply->unit] = reply;
+        if (sim_dist_fold_ready(&states[c], pending)) {
+            if (states[c].status == FSO_SUCCESS) {
+                sim_results_calculate_metrics(&states[c].merged);
+                successful++;
+            }
+            sim_sweep_fill_row(&configs[c], c, states[c].status, &states[c].merged, &rows[c]);
+            FSO_LOG_INFO(MODULE_NAME, "Configuration %d complete (%d unit(s))",
+                         c, states[c].num_units);
+        }
+    }
+
+    free(pending);
+    free(units);
+    free(states);
+    return successful;
+}
+
+#endif /* FSO_ENABLE_MPI */
+
+/* ============================================================================
+ * Public Interface
+ * ============================================================================ */
+
+int sim_run_sweep_distributed(const SimConfig* configs, int num_configs, int num_threads,
+                              int chunk_packets, SimSweepRow* rows) {
+    int rank = sim_dist_rank();
+    int size = sim_dist_size();
+    if (configs == NULL || num_configs <= 0 || (rank == 0 && rows == NULL)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Invalid parameters for distributed sweep");
+        return 0;
+    }
+
+    // A single process is an ordinary sweep
+    if (size < 2) {
+        return sim_run_sweep(configs, num_configs, num_threads, rows);
+    }
+
+#ifdef FSO_ENABLE_MPI
+    if (chunk_packets <= 0) {
+        chunk_packets = SIM_DIST_CHUNK_PACKETS;
+    }
+
+    // Every rank must hold the same sweep
+    int counts[2] = { num_configs, chunk_packets };
+    MPI_Bcast(counts, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    if (counts[0] != num_configs) {
+        FSO_LOG_ERROR(MODULE_NAME, "Rank %d has %d configurations, rank 0 has %d",
+                      rank, num_configs, counts[0]);
+        MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_INVALID_PARAM);
+        return 0;
+    }
+    chunk_packets = counts[1];
+
+    // Time-based seeds are resolved once, on rank 0
+    unsigned int* seeds = (unsigned int*)malloc((size_t)num_configs * sizeof(unsigned int));
+    if (seeds == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate seeds");
+        MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+        return 0;
+    }
+    if (rank == 0) {
+        for (int c = 0; c < num_configs; c++) {
+            seeds[c] = (unsigned int)sim_run_seed(&configs[c]);
+        }
+    }
+    MPI_Bcast(seeds, num_configs, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+
+    int successful = 0;
+    if (rank == 0) {
+        // Rows for configurations the coordinator summarizes with resolved seeds
+        SimConfig* resolved = (SimConfig*)malloc((size_t)num_configs * sizeof(SimConfig));
+        if (resolved == NULL) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate configurations");
+            MPI_Abort(MPI_COMM_WORLD, FSO_ERROR_MEMORY);
+            return 0;
+        }
+        for (int c = 0; c < num_configs; c++) {
+            resolved[c] = configs[c];
+            resolved[c].control.random_seed = seeds[c];
+        }
+        successful = sim_dist_coordinate(resolved, num_configs, chunk_packets, size - 1, rows);
+        free(resolved);
+        FSO_LOG_INFO(MODULE_NAME, "Distributed sweep completed: %d / %d configurations successful",
+                     successful, num_configs);
+    } else {
+        sim_dist_worker(configs, seeds, num_threads);
+    }
+
+    free(seeds);
+    return successful;
+#else
+    (void)chunk_packets;
+    return 0;
+#endif
+}
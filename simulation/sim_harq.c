@@ -0,0 +1,116 @@
+/**
+ * @file sim_harq.c
+ * @brief Hybrid ARQ transmission schedule and soft combining
+ *
+ * Incremental redundancy over a rate-compatible punctured LDPC family,
+ * with the mother codeword read as a circular buffer in
+ * fec_rate_compatible_order(): every transmission sends the next
+ * segment_length positions, wrapping to the start of the buffer. The
+ * first carries the information bits and enough parity for
+ * initial_rate; retransmissions add parity not yet sent (incremental
+ * redundancy) until the buffer wraps, and after that repeat positions
+ * already sent (Chase combining). Wrapping also resends the information
+ * bits, so a packet whose first transmission was lost in a fade can
+ * still be recovered.
+ *
+ * Combining: LLRs of independent observations of a bit add, so each
+ * transmission's LLRs are summed into a codeword-order buffer that starts
+ * at zero (an erasure for every bit not yet sent), and the decoder always
+ * sees the whole mother codeword.
+ *
+ * Codeword bytes carry one code bit each (see ldpc_encode()), so a
+ * transmission's segment is a list of codeword bytes and each byte's 8
+ * LLRs are combined at its codeword position.
+ */
+
+#include "simulator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MODULE_NAME "HARQ"
+
+int sim_harq_schedule_init(SimHARQSchedule* schedule, const FECCodec* codec,
+                           const SimHARQConfig* harq) {
+    FSO_CHECK_NULL(schedule);
+    FSO_CHECK_NULL(codec);
+    FSO_CHECK_NULL(harq);
+    FSO_CHECK_PARAM(harq->max_transmissions >= 2 &&
+                    harq->max_transmissions <= SIM_HARQ_MAX_TRANSMISSIONS);
+    FSO_CHECK_PARAM(harq->initial_rate > 0.0 && harq->initial_rate <= 1.0);
+    
+    memset(schedule, 0, sizeof(SimHARQSchedule));
+    
+    const int n = codec->code_length;
+    const int k = codec->data_length;
+    schedule->order = (int*)malloc((size_t)n * sizeof(int));
+    if (schedule->order == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate the transmission order");
+        return FSO_ERROR_MEMORY;
+    }
+    
+    int result = fec_rate_compatible_order(codec, schedule->order);
+    if (result != FSO_SUCCESS) {
+        sim_harq_schedule_free(schedule);
+        return result;
+    }
+    
+    // Every transmission is as long as the first, at initial_rate
+    int segment = (int)ceil((double)k / harq->initial_rate);
+    schedule->code_length = n;
+    schedule->segment_length = FSO_MAX(FSO_MIN(segment, n), k);
+    schedule->num_rounds = harq->max_transmissions;
+    schedule->round_trip_time = harq->round_trip_time;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "%d transmissions of %d of %d code bits (rate %.3f each)",
+                  schedule->num_rounds, schedule->segment_length, n,
+                  (double)k / schedule->segment_length);
+    
+    return FSO_SUCCESS;
+}
+
+void sim_harq_schedule_free(SimHARQSchedule* schedule) {
+    if (schedule == NULL) {
+        return;
+    }
+    
+    free(schedule->order);
+    memset(schedule, 0, sizeof(SimHARQSchedule));
+}
+
+size_t sim_harq_gather(const SimHARQSchedule* schedule, int round, const uint8_t* codeword,
+                       uint8_t* segment) {
+    if (schedule == NULL || round < 0 || round >= schedule->num_rounds) {
+        return 0;
+    }
+    
+    const int n = schedule->code_length;
+    int position = (int)(((long long)round * schedule->segment_length) % n);
+    for (int i = 0; i < schedule->segment_length; i++) {
+        segment[i] = codeword[schedule->order[position]];
+        position = (position + 1 < n) ? position + 1 : 0;
+    }
+    return (size_t)schedule->segment_length;
+}
+
+void sim_harq_combine(const SimHARQSchedule* schedule, int round, const float* llr,
+                      float* combined) {
+    if (schedule == NULL || round < 0 || round >= schedule->num_rounds) {
+        return;
+    }
+    
+    const int n = schedule->code_length;
+    if (round == 0) {
+        memset(combined, 0, (size_t)n * 8 * sizeof(float));
+    }
+    
+    int position = (int)(((long long)round * schedule->segment_length) % n);
+    for (int i = 0; i < schedule->segment_length; i++) {
+        float* bits = combined + (size_t)schedule->order[position] * 8;
+        const float* received = llr + (size_t)i * 8;
+        for (int b = 0; b < 8; b++) {
+            bits[b] += received[b];
+        }
+        position = (position + 1 < n) ? position + 1 : 0;
+    }
+}
@@ -0,0 +1,215 @@
+/**
+ * @file sim_metrics.c
+ * @brief Mergeable online metric accumulators
+ *
+ * Every accumulator summarizes its samples in fixed memory and combines
+ * with another of its kind, so per-worker or per-run partial results
+ * reduce without keeping the samples:
+ *
+ *   SimKahanSum     compensated sum (Neumaier)
+ *   SimRunningStat  count, mean, variance, min, max (Welford / Chan)
+ *   SimHistogram    fixed-range histogram for quantiles
+ */
+
+#include "simulator.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Compensated Sum
+ * ============================================================================ */
+
+void sim_kahan_add(SimKahanSum* sum, double value) {
+    double t = sum->sum + value;
+    // Keep the low-order bits lost by whichever operand is smaller
+    if (fabs(sum->sum) >= fabs(value)) {
+        sum->compensation += (sum->sum - t) + value;
+    } else {
+        sum->compensation += (value - t) + sum->sum;
+    }
+    sum->sum = t;
+}
+
+void sim_kahan_merge(SimKahanSum* dst, const SimKahanSum* src) {
+    sim_kahan_add(dst, src->sum);
+    dst->compensation += src->compensation;
+}
+
+double sim_kahan_value(const SimKahanSum* sum) {
+    return sum->sum + sum->compensation;
+}
+
+/* ============================================================================
+ * Running Statistic
+ * ============================================================================ */
+
+void sim_stat_init(SimRunningStat* stat) {
+    stat->count = 0;
+    stat->mean = 0.0;
+    stat->m2 = 0.0;
+    stat->min = INFINITY;
+    stat->max = -INFINITY;
+}
+
+void sim_stat_add(SimRunningStat* stat, double value) {
+    stat->count++;
+    double delta = value - stat->mean;
+    stat->mean += delta / (double)stat->count;
+    stat->m2 += delta * (value - stat->mean);
+
+    if (value < stat->min) {
+        stat->min = value;
+    }
+    if (value > stat->max) {
+        stat->max = value;
+    }
+}
+
+void sim_stat_merge(SimRunningStat* dst, const SimRunningStat* src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+
+    // Chan et al. pairwise update
+    double n_a = (double)dst->count;
+    double n_b = (double)src->count;
+    double n = n_a + n_b;
+    double delta = src->mean - dst->mean;
+    dst->mean += delta * n_b / n;
+    dst->m2 += src->m2 + delta * delta * n_a * n_b / n;
+    dst->count += src->count;
+
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+double sim_stat_variance(const SimRunningStat* stat) {
+    if (stat->count < 2) {
+        return 0.0;
+    }
+    return stat->m2 / (double)(stat->count - 1);
+}
+
+/* ============================================================================
+ * Histogram
+ * ============================================================================ */
+
+int sim_histogram_init(SimHistogram* hist, double lo, double hi, int log_scale) {
+    FSO_CHECK_NULL(hist);
+    if (!(hi > lo) || (log_scale && lo <= 0.0)) {
+        FSO_LOG_ERROR("SimMetrics", "Invalid histogram range [%g, %g)", lo, hi);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+
+    memset(hist, 0, sizeof(SimHistogram));
+    hist->lo = lo;
+    hist->hi = hi;
+    hist->log_scale = log_scale ? 1 : 0;
+    hist->min = INFINITY;
+    hist->max = -INFINITY;
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Position of a value in bin units (may fall outside [0, BINS))
+ */
+static double sim_histogram_position(const SimHistogram* hist, double value) {
+    if (hist->log_scale) {
+        return (log10(value) - log10(hist->lo)) /
+               (log10(hist->hi) - log10(hist->lo)) * SIM_HISTOGRAM_BINS;
+    }
+    return (value - hist->lo) / (hist->hi - hist->lo) * SIM_HISTOGRAM_BINS;
+}
+
+/**
+ * @brief Midpoint of a bin (geometric for log bins)
+ */
+static double sim_histogram_bin_value(const SimHistogram* hist, int bin) {
+    double fraction = ((double)bin + 0.5) / SIM_HISTOGRAM_BINS;
+    if (hist->log_scale) {
+        return hist->lo * pow(hist->hi / hist->lo, fraction);
+    }
+    return hist->lo + (hist->hi - hist->lo) * fraction;
+}
+
+void sim_histogram_add(SimHistogram* hist, double value) {
+    if (isnan(value)) {
+        return;
+    }
+
+    hist->count++;
+    if (value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+
+    if (value < hist->lo) {
+        hist->underflow++;
+        return;
+    }
+    double position = sim_histogram_position(hist, value);
+    if (position >= SIM_HISTOGRAM_BINS) {
+        hist->overflow++;
+        return;
+    }
+    hist->bins[(int)position]++;
+}
+
+int sim_histogram_merge(SimHistogram* dst, const SimHistogram* src) {
+    FSO_CHECK_NULL(dst);
+    FSO_CHECK_NULL(src);
+    if (dst->lo != src->lo || dst->hi != src->hi || dst->log_scale != src->log_scale) {
+        FSO_LOG_ERROR("SimMetrics", "Cannot merge histograms with different ranges");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+
+    dst->count += src->count;
+    dst->underflow += src->underflow;
+    dst->overflow += src->overflow;
+    for (int i = 0; i < SIM_HISTOGRAM_BINS; i++) {
+        dst->bins[i] += src->bins[i];
+    }
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+    return FSO_SUCCESS;
+}
+
+double sim_histogram_quantile(const SimHistogram* hist, double q) {
+    if (hist == NULL || hist->count == 0) {
+        return NAN;
+    }
+    q = FSO_CLAMP(q, 0.0, 1.0);
+
+    // Rank of the quantile, 1-based; out-of-range samples map to the extremes
+    unsigned long long rank = (unsigned long long)ceil(q * (double)hist->count);
+    if (rank == 0) {
+        rank = 1;
+    }
+    if (rank <= hist->underflow) {
+        return hist->min;
+    }
+
+    unsigned long long seen = hist->underflow;
+    for (int i = 0; i < SIM_HISTOGRAM_BINS; i++) {
+        seen += hist->bins[i];
+        if (seen >= rank) {
+            double value = sim_histogram_bin_value(hist, i);
+            return FSO_CLAMP(value, hist->min, hist->max);
+        }
+    }
+    return hist->max;
+}
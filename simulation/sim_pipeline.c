@@ -0,0 +1,706 @@
+/**
+ * @file sim_pipeline.c
+ * @brief Pipelined simulation with one thread per stage
+ *
+ * Stages are connected by lock-free single-producer/single-consumer rings
+ * carrying indices of preallocated packet slots:
+ *
+ *   free -> TRANSMIT -> CHANNEL -> DEMODULATE -> DECODE[r] -> COLLECT -> free
+ *
+ * Packet k goes to decoder k % R and the collector reads the decoder rings
+ * in the same order, so every ring keeps one producer and one consumer and
+ * results arrive in packet order. The channel stage advances the fading
+ * process in packet order, keeping it temporally correct.
+ *
+ * The transmitter ends the stream with an end marker that every stage
+ * forwards. Under a stopping rule the collector raises a stop flag at the
+ * first packet meeting a target; the transmitter then sends the marker and
+ * the collector discards the packets still in flight.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#define SIM_PIPELINE_HAVE_THREADS 1
+#endif
+
+#define MODULE_NAME "Pipeline"
+
+/* Defaults and limits */
+#define SIM_PIPELINE_DEFAULT_DEPTH 16
+#define SIM_PIPELINE_MAX_DECODERS 64
+
+/* Busy-wait iterations before yielding the CPU */
+#define SIM_RING_SPINS 64
+
+/* Slot index marking the end of the packet stream */
+#define SIM_RING_END (-1)
+
+/* ============================================================================
+ * SPSC Ring
+ * ============================================================================ */
+
+/**
+ * @brief Single-producer/single-consumer ring of slot indices
+ *
+ * head is written only by the consumer and tail only by the producer; each
+ * side also owns its own counters, so no field is written by both.
+ */
+typedef struct {
+    _Alignas(64) atomic_size_t head;  /**< Next index to pop (consumer) */
+    _Alignas(64) atomic_size_t tail;  /**< Next index to push (producer) */
+    _Alignas(64) int* slots;          /**< Ring storage */
+    size_t capacity;                  /**< Power-of-two capacity */
+    size_t mask;                      /**< capacity - 1 */
+    long long push_stalls;            /**< Producer: pushes that waited */
+    _Alignas(64) long long pop_stalls; /**< Consumer: pops that waited */
+    long long pops;                   /**< Consumer: completed pops */
+    double occupancy_sum;             /**< Consumer: fill fraction summed per pop */
+} SimRing;
+
+static void sim_relax(int* spins) {
+    if (++(*spins) < SIM_RING_SPINS) {
+        return;
+    }
+    *spins = 0;
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static int sim_ring_init(SimRing* ring, size_t min_capacity) {
+    memset(ring, 0, sizeof(SimRing));
+    
+    size_t capacity = 1;
+    while (capacity < min_capacity) {
+        capacity <<= 1;
+    }
+    
+    ring->slots = (int*)malloc(capacity * sizeof(int));
+    if (ring->slots == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    
+    return FSO_SUCCESS;
+}
+
+static void sim_ring_free(SimRing* ring) {
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+static void sim_ring_push(SimRing* ring, int value) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    
+    if (tail - atomic_load_explicit(&ring->head, memory_order_acquire) >= ring->capacity) {
+        ring->push_stalls++;
+        int spins = 0;
+        while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) >= ring->capacity) {
+            sim_relax(&spins);
+        }
+    }
+    
+    ring->slots[tail & ring->mask] = value;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+static int sim_ring_pop(SimRing* ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    
+    if (tail == head) {
+        ring->pop_stalls++;
+        int spins = 0;
+        while ((tail = atomic_load_explicit(&ring->tail, memory_order_acquire)) == head) {
+            sim_relax(&spins);
+        }
+    }
+    
+    int value = ring->slots[head & ring->mask];
+    if (value != SIM_RING_END) {
+        ring->occupancy_sum += (double)(tail - head) / (double)ring->capacity;
+        ring->pops++;
+    }
+    
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return value;
+}
+
+/* ============================================================================
+ * Pipeline State
+ * ============================================================================ */
+
+typedef struct {
+    const SimConfig* config;
+    SimResults* results;
+    ChannelModel channel;
+    uint64_t run_seed;
+    double time_per_packet;
+    int num_packets;
+    int num_decoders;
+    
+    SimPacket* packets;               /**< Preallocated packet slots */
+    int num_slots;
+    
+    SimLink tx_link;                  /**< Encoder/modulator chain */
+    SimLink rx_link;                  /**< Demodulator/deinterleaver chain */
+    SimLink* decoder_links;           /**< One FEC decoder per replica */
+    
+    SimRing free_ring;                /**< COLLECT -> TRANSMIT */
+    SimRing tx_ring;                  /**< TRANSMIT -> CHANNEL */
+    SimRing channel_ring;             /**< CHANNEL -> DEMODULATE */
+    SimRing* decode_rings;            /**< DEMODULATE -> DECODE[r] */
+    SimRing* output_rings;            /**< DECODE[r] -> COLLECT */
+    
+    double busy[SIM_NUM_STAGES];      /**< Per-stage busy time (decoders summed) */
+    double* decoder_busy;             /**< Per-decoder busy time */
+    long long symbols;                /**< Symbols delivered to COLLECT */
+    int collected;                    /**< Packets COLLECT accepted before stopping */
+    int adaptive;                     /**< Flag: a stopping rule is set */
+    atomic_int stop;                  /**< Set by COLLECT once a target is met */
+    atomic_int start;                 /**< Stage threads: 0 wait, 1 run, -1 abort */
+} SimPipeline;
+
+static double sim_now(void) {
+#ifdef SIM_PIPELINE_HAVE_THREADS
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#elif defined(_OPENMP)
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static void sim_pipeline_free(SimPipeline* pipe) {
+    if (pipe->packets != NULL) {
+        for (int i = 0; i < pipe->num_slots; i++) {
+            sim_packet_free(&pipe->packets[i]);
+        }
+    }
+    if (pipe->decoder_links != NULL) {
+        for (int r = 0; r < pipe->num_decoders; r++) {
+            sim_link_free(&pipe->decoder_links[r]);
+        }
+    }
+    if (pipe->decode_rings != NULL && pipe->output_rings != NULL) {
+        for (int r = 0; r < pipe->num_decoders; r++) {
+            sim_ring_free(&pipe->decode_rings[r]);
+            sim_ring_free(&pipe->output_rings[r]);
+        }
+    }
+    
+    sim_link_free(&pipe->tx_link);
+    sim_link_free(&pipe->rx_link);
+    sim_ring_free(&pipe->free_ring);
+    sim_ring_free(&pipe->tx_ring);
+    sim_ring_free(&pipe->channel_ring);
+    channel_free(&pipe->channel);
+    
+    free(pipe->packets);
+    free(pipe->decoder_links);
+    free(pipe->decode_rings);
+    free(pipe->output_rings);
+    free(pipe->decoder_busy);
+}
+
+static int sim_pipeline_init(SimPipeline* pipe, const SimConfig* config,
+                             int queue_depth, int num_decoders) {
+    memset(pipe, 0, sizeof(SimPipeline));
+    pipe->config = config;
+    pipe->num_packets = config->control.num_packets;
+    pipe->num_decoders = num_decoders;
+    pipe->time_per_packet = config->control.simulation_time / config->control.num_packets;
+    pipe->adaptive = (config->control.target_bit_errors > 0 ||
+                      config->control.target_relative_error > 0.0);
+    atomic_init(&pipe->stop, 0);
+    atomic_init(&pipe->start, 0);
+    
+    // Enough slots for every ring between TRANSMIT and COLLECT to fill
+    pipe->num_slots = queue_depth * (3 + num_decoders);
+    
+    int result = sim_channel_init(&pipe->channel, config);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    pipe->packets = (SimPacket*)calloc((size_t)pipe->num_slots, sizeof(SimPacket));
+    pipe->decoder_links = (SimLink*)calloc((size_t)num_decoders, sizeof(SimLink));
+    pipe->decode_rings = (SimRing*)calloc((size_t)num_decoders, sizeof(SimRing));
+    pipe->output_rings = (SimRing*)calloc((size_t)num_decoders, sizeof(SimRing));
+    pipe->decoder_busy = (double*)calloc((size_t)num_decoders, sizeof(double));
+    if (!pipe->packets || !pipe->decoder_links || !pipe->decode_rings ||
+        !pipe->output_rings || !pipe->decoder_busy) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate pipeline state");
+        return FSO_ERROR_MEMORY;
+    }
+    
+    for (int i = 0; i < pipe->num_slots; i++) {
+        result = sim_packet_init(&pipe->packets[i], config);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    result = sim_link_init(&pipe->tx_link, config);
+    if (result == FSO_SUCCESS) {
+        result = sim_link_init(&pipe->rx_link, config);
+    }
+    for (int r = 0; r < num_decoders && result == FSO_SUCCESS; r++) {
+        result = sim_link_init(&pipe->decoder_links[r], config);
+    }
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    if (sim_ring_init(&pipe->free_ring, (size_t)pipe->num_slots) != FSO_SUCCESS ||
+        sim_ring_init(&pipe->tx_ring, (size_t)queue_depth) != FSO_SUCCESS ||
+        sim_ring_init(&pipe->channel_ring, (size_t)queue_depth) != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate rings");
+        return FSO_ERROR_MEMORY;
+    }
+    for (int r = 0; r < num_decoders; r++) {
+        if (sim_ring_init(&pipe->decode_rings[r], (size_t)queue_depth) != FSO_SUCCESS ||
+            sim_ring_init(&pipe->output_rings[r], (size_t)queue_depth) != FSO_SUCCESS) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate rings");
+            return FSO_ERROR_MEMORY;
+        }
+    }
+    
+    // All slots start out free
+    for (int i = 0; i < pipe->num_slots; i++) {
+        sim_ring_push(&pipe->free_ring, i);
+    }
+    pipe->free_ring.push_stalls = 0;
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Stage Loops
+ * ============================================================================ */
+
+static void sim_pipeline_transmit(SimPipeline* pipe) {
+    for (int k = 0; k < pipe->num_packets; k++) {
+        if (atomic_load_explicit(&pipe->stop, memory_order_acquire)) {
+            break;
+        }
+        int slot = sim_ring_pop(&pipe->free_ring);
+        double start = sim_now();
+        sim_stage_transmit(&pipe->tx_link, pipe->config, pipe->run_seed, k,
+                           &pipe->packets[slot]);
+        pipe->busy[SIM_STAGE_TRANSMIT] += sim_now() - start;
+        sim_ring_push(&pipe->tx_ring, slot);
+    }
+    sim_ring_push(&pipe->tx_ring, SIM_RING_END);
+}
+
+static void sim_pipeline_channel(SimPipeline* pipe) {
+    for (int k = 0; ; k++) {
+        int slot = sim_ring_pop(&pipe->tx_ring);
+        if (slot == SIM_RING_END) {
+            sim_ring_push(&pipe->channel_ring, SIM_RING_END);
+            break;
+        }
+        double start = sim_now();
+        SimPacket* packet = &pipe->packets[slot];
+        packet->fading = sim_stage_fade(&pipe->channel, pipe->config, pipe->run_seed, k,
+                                        pipe->time_per_packet, packet->fade_profile,
+                                        &packet->log_weight);
+        sim_stage_channel(&pipe->channel, pipe->config, pipe->run_seed, packet);
+        pipe->busy[SIM_STAGE_CHANNEL] += sim_now() - start;
+        sim_ring_push(&pipe->channel_ring, slot);
+    }
+}
+
+static void sim_pipeline_demodulate(SimPipeline* pipe) {
+    for (int k = 0; ; k++) {
+        int slot = sim_ring_pop(&pipe->channel_ring);
+        if (slot == SIM_RING_END) {
+            for (int r = 0; r < pipe->num_decoders; r++) {
+                sim_ring_push(&pipe->decode_rings[r], SIM_RING_END);
+            }
+            break;
+        }
+        double start = sim_now();
+        sim_stage_demodulate(&pipe->rx_link, pipe->config, &pipe->packets[slot]);
+        pipe->busy[SIM_STAGE_DEMODULATE] += sim_now() - start;
+        sim_ring_push(&pipe->decode_rings[k % pipe->num_decoders], slot);
+    }
+}
+
+static void sim_pipeline_decode(SimPipeline* pipe, int replica) {
+    for (;;) {
+        int slot = sim_ring_pop(&pipe->decode_rings[replica]);
+        if (slot == SIM_RING_END) {
+            sim_ring_push(&pipe->output_rings[replica], SIM_RING_END);
+            break;
+        }
+        double start = sim_now();
+        sim_stage_decode(&pipe->decoder_links[replica], pipe->config, &pipe->packets[slot]);
+        pipe->decoder_busy[replica] += sim_now() - start;
+        sim_ring_push(&pipe->output_rings[replica], slot);
+    }
+}
+
+static void sim_pipeline_collect_one(SimPipeline* pipe, int k, int slot) {
+    const SimConfig* config = pipe->config;
+    double start = sim_now();
+    SimPacket* packet = &pipe->packets[slot];
+    
+    if (config->control.verbose && (k % 10 == 0)) {
+        printf("Processing packet %d/%d (%.1f%%)\n",
+               k + 1, pipe->num_packets, 100.0 * (k + 1) / pipe->num_packets);
+    }
+    
+    PacketStats stats;
+    TimeSeriesPoint point;
+    pipe->collected++;
+    if (sim_stage_collect(config, pipe->time_per_packet, packet,
+                          &stats, &point) == FSO_SUCCESS) {
+        sim_results_add_packet(pipe->results, &stats);
+        sim_results_add_point(pipe->results, &point);
+        pipe->symbols += (long long)packet->symbol_len;
+        
+        if (pipe->adaptive && sim_results_check_stop(pipe->results, &config->control)) {
+            atomic_store_explicit(&pipe->stop, 1, memory_order_release);
+        }
+    }
+    
+    pipe->busy[SIM_STAGE_COLLECT] += sim_now() - start;
+}
+
+static void sim_pipeline_collect(SimPipeline* pipe) {
+    for (int k = 0; ; k++) {
+        int slot = sim_ring_pop(&pipe->output_rings[k % pipe->num_decoders]);
+        if (slot == SIM_RING_END) {
+            break;
+        }
+        // After a stop, drain the packets still in flight
+        if (!atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+            sim_pipeline_collect_one(pipe, k, slot);
+        }
+        sim_ring_push(&pipe->free_ring, slot);
+    }
+}
+
+#ifdef SIM_PIPELINE_HAVE_THREADS
+/**
+ * @brief One stage thread: TRANSMIT, CHANNEL, DEMODULATE or a decoder
+ */
+typedef struct {
+    SimPipeline* pipe;
+    int role;                         /**< 0-2 for the fixed stages, 3 + r for decoder r */
+} SimStageThread;
+
+static void* sim_pipeline_thread(void* arg) {
+    SimStageThread* thread = (SimStageThread*)arg;
+    SimPipeline* pipe = thread->pipe;
+    
+    // Hold until every stage has a thread; a partial launch would deadlock
+    int spins = 0;
+    int go;
+    while ((go = atomic_load_explicit(&pipe->start, memory_order_acquire)) == 0) {
+        sim_relax(&spins);
+    }
+    if (go < 0) {
+        return NULL;
+    }
+    
+    if (thread->role == 0) {
+        sim_pipeline_transmit(pipe);
+    } else if (thread->role == 1) {
+        sim_pipeline_channel(pipe);
+    } else if (thread->role == 2) {
+        sim_pipeline_demodulate(pipe);
+    } else {
+        sim_pipeline_decode(pipe, thread->role - 3);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run the stages on their own threads, COLLECT on the caller
+ * @return 1 if the run happened, 0 if the threads could not all be started
+ */
+static int sim_pipeline_run_threaded(SimPipeline* pipe) {
+    pthread_t threads[3 + SIM_PIPELINE_MAX_DECODERS];
+    SimStageThread roles[3 + SIM_PIPELINE_MAX_DECODERS];
+    const int count = 3 + pipe->num_decoders;
+    
+    int started = 0;
+    while (started < count) {
+        roles[started].pipe = pipe;
+        roles[started].role = started;
+        if (pthread_create(&threads[started], NULL, sim_pipeline_thread,
+                           &roles[started]) != 0) {
+            break;
+        }
+        started++;
+    }
+    
+    const int threaded = (started == count);
+    atomic_store_explicit(&pipe->start, threaded ? 1 : -1, memory_order_release);
+    if (threaded) {
+        sim_pipeline_collect(pipe);
+    }
+    
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return threaded;
+}
+#endif
+
+/**
+ * @brief Run every stage in sequence on the calling thread
+ * 
+ * Packets still pass through the rings (one at a time, so nothing
+ * blocks), keeping the statistics comparable with the threaded run.
+ */
+static void sim_pipeline_run_serial(SimPipeline* pipe) {
+    for (int k = 0; k < pipe->num_packets; k++) {
+        int replica = k % pipe->num_decoders;
+        double start;
+        
+        int slot = sim_ring_pop(&pipe->free_ring);
+        start = sim_now();
+        sim_stage_transmit(&pipe->tx_link, pipe->config, pipe->run_seed, k,
+                           &pipe->packets[slot]);
+        pipe->busy[SIM_STAGE_TRANSMIT] += sim_now() - start;
+        sim_ring_push(&pipe->tx_ring, slot);
+        
+        slot = sim_ring_pop(&pipe->tx_ring);
+        start = sim_now();
+        pipe->packets[slot].fading = sim_stage_fade(&pipe->channel, pipe->config,
+                                                    pipe->run_seed, k, pipe->time_per_packet,
+                                                    pipe->packets[slot].fade_profile,
+                                                    &pipe->packets[slot].log_weight);
+        sim_stage_channel(&pipe->channel, pipe->config, pipe->run_seed, &pipe->packets[slot]);
+        pipe->busy[SIM_STAGE_CHANNEL] += sim_now() - start;
+        sim_ring_push(&pipe->channel_ring, slot);
+        
+        slot = sim_ring_pop(&pipe->channel_ring);
+        start = sim_now();
+        sim_stage_demodulate(&pipe->rx_link, pipe->config, &pipe->packets[slot]);
+        pipe->busy[SIM_STAGE_DEMODULATE] += sim_now() - start;
+        sim_ring_push(&pipe->decode_rings[replica], slot);
+        
+        slot = sim_ring_pop(&pipe->decode_rings[replica]);
+        start = sim_now();
+        sim_stage_decode(&pipe->decoder_links[replica], pipe->config, &pipe->packets[slot]);
+        pipe->decoder_busy[replica] += sim_now() - start;
+        sim_ring_push(&pipe->output_rings[replica], slot);
+        
+        slot = sim_ring_pop(&pipe->output_rings[replica]);
+        sim_pipeline_collect_one(pipe, k, slot);
+        sim_ring_push(&pipe->free_ring, slot);
+        
+        if (atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+/* ============================================================================
+ * Public Interface
+ * ============================================================================ */
+
+static void sim_fill_stage(SimStageStats* stage, const char* name, int workers,
+                           const SimRing* input, const SimRing* output,
+                           double busy) {
+    stage->name = name;
+    stage->workers = workers;
+    stage->packets += input->pops;
+    stage->input_stalls += input->pop_stalls;
+    stage->output_stalls += (output != NULL) ? output->push_stalls : 0;
+    stage->avg_occupancy += (input->pops > 0) ? input->occupancy_sum / (double)input->pops : 0.0;
+    stage->busy_time += busy;
+}
+
+int sim_run_pipelined(const SimConfig* config, const SimPipelineConfig* pipeline,
+                      SimResults* results, SimPipelineStats* stats) {
+    if (config == NULL || results == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "NULL pointer in sim_run_pipelined");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    int result = sim_config_validate(config);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Configuration validation failed");
+        return result;
+    }
+    
+    // Stages run one fixed codec chain; mode decisions need sim_run()'s blocks
+    if (config->system.amc.enabled) {
+        FSO_LOG_ERROR(MODULE_NAME, "Adaptive modulation runs need sim_run()");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    // Each stage runs once per packet; retransmissions loop back through them
+    if (config->system.harq.enabled) {
+        FSO_LOG_ERROR(MODULE_NAME, "Hybrid ARQ runs need sim_run()");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    int queue_depth = (pipeline != NULL && pipeline->queue_depth > 0) ?
+                      pipeline->queue_depth : SIM_PIPELINE_DEFAULT_DEPTH;
+    int num_decoders = (pipeline != NULL && pipeline->decoder_workers > 0) ?
+                       pipeline->decoder_workers : 1;
+    if (num_decoders > SIM_PIPELINE_MAX_DECODERS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Too many decoder workers: %d (max %d)",
+                     num_decoders, SIM_PIPELINE_MAX_DECODERS);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    result = sim_results_init_run(results, config, 1);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to initialize results");
+        return result;
+    }
+    results->start_time = (double)clock() / CLOCKS_PER_SEC;
+    fso_profile_reset();
+    
+    SimPipeline pipe;
+    result = sim_pipeline_init(&pipe, config, queue_depth, num_decoders);
+    if (result != FSO_SUCCESS) {
+        sim_pipeline_free(&pipe);
+        sim_results_free(results);
+        return result;
+    }
+    pipe.results = results;
+    results->confidence_level = config->control.confidence_level;
+    results->importance_sampling = config->control.importance_sampling;
+    pipe.run_seed = sim_run_seed(config);
+    fso_random_init((unsigned int)pipe.run_seed);
+    
+    // TRANSMIT, CHANNEL, DEMODULATE, COLLECT plus the decoder replicas
+    const int needed = 4 + num_decoders;
+    int threaded = 0;
+    
+    FSO_LOG_INFO(MODULE_NAME, "Starting pipeline: %d packets, %d decoder(s), depth %d",
+                 pipe.num_packets, num_decoders, queue_depth);
+    
+    double wall_start = sim_now();
+    
+#ifdef SIM_PIPELINE_HAVE_THREADS
+    threaded = sim_pipeline_run_threaded(&pipe);
+#endif
+    
+    if (!threaded) {
+        FSO_LOG_INFO(MODULE_NAME, "Running stages sequentially (%d threads unavailable)",
+                     needed);
+        sim_pipeline_run_serial(&pipe);
+    }
+    
+    double wall_time = sim_now() - wall_start;
+    
+    sim_results_calculate_metrics(results);
+    result = sim_results_finish_run(results);
+    results->end_time = (double)clock() / CLOCKS_PER_SEC;
+    results->simulation_duration = results->end_time - results->start_time;
+    fso_profile_snapshot(results->stage_profile);
+    
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(SimPipelineStats));
+        stats->threaded = threaded;
+        stats->wall_time = wall_time;
+        stats->packets_per_second = (wall_time > 0.0) ? pipe.collected / wall_time : 0.0;
+        stats->symbols_per_second = (wall_time > 0.0) ? (double)pipe.symbols / wall_time : 0.0;
+    
+        sim_fill_stage(&stats->stages[SIM_STAGE_TRANSMIT], "transmit", 1,
+                       &pipe.free_ring, &pipe.tx_ring, pipe.busy[SIM_STAGE_TRANSMIT]);
+        sim_fill_stage(&stats->stages[SIM_STAGE_CHANNEL], "channel", 1,
+                       &pipe.tx_ring, &pipe.channel_ring, pipe.busy[SIM_STAGE_CHANNEL]);
+    
+        // Demodulate feeds every decoder ring
+        SimStageStats* demod = &stats->stages[SIM_STAGE_DEMODULATE];
+        sim_fill_stage(demod, "demodulate", 1, &pipe.channel_ring, NULL,
+                       pipe.busy[SIM_STAGE_DEMODULATE]);
+        for (int r = 0; r < num_decoders; r++) {
+            demod->output_stalls += pipe.decode_rings[r].push_stalls;
+        }
+    
+        // Decoder figures are combined over the replicas
+        SimStageStats* decode = &stats->stages[SIM_STAGE_DECODE];
+        for (int r = 0; r < num_decoders; r++) {
+            sim_fill_stage(decode, "decode", num_decoders, &pipe.decode_rings[r],
+                           &pipe.output_rings[r], pipe.decoder_busy[r]);
+        }
+        decode->avg_occupancy /= num_decoders;
+        
+        // The collector reads every decoder output ring
+        SimStageStats* collect = &stats->stages[SIM_STAGE_COLLECT];
+        collect->name = "collect";
+        collect->workers = 1;
+        collect->output_stalls = pipe.free_ring.push_stalls;
+        collect->busy_time = pipe.busy[SIM_STAGE_COLLECT];
+        for (int r = 0; r < num_decoders; r++) {
+            const SimRing* ring = &pipe.output_rings[r];
+            collect->packets += ring->pops;
+            collect->input_stalls += ring->pop_stalls;
+            collect->avg_occupancy += (ring->pops > 0) ?
+                                      ring->occupancy_sum / (double)ring->pops : 0.0;
+        }
+        collect->avg_occupancy /= num_decoders;
+    }
+    
+    sim_pipeline_free(&pipe);
+    
+    if (result != FSO_SUCCESS) {
+        sim_results_free(results);
+        return result;
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Pipeline completed: %d packets in %.3f s (%s)",
+                 results->total_packets, wall_time, threaded ? "threaded" : "sequential");
+    
+    return FSO_SUCCESS;
+}
+
+void sim_pipeline_print_stats(const SimPipelineStats* stats) {
+    if (stats == NULL) {
+        printf("NULL pipeline statistics\n");
+        return;
+    }
+    
+    printf("\n");
+    printf("=== Pipeline Statistics (%s) ===\n", stats->threaded ? "threaded" : "sequential");
+    printf("  Wall Time:            %.3f s\n", stats->wall_time);
+    printf("  Packet Rate:          %.1f packets/s\n", stats->packets_per_second);
+    printf("  Symbol Rate:          %.3e symbols/s\n", stats->symbols_per_second);
+    printf("\n");
+    printf("  %-12s %7s %10s %10s %10s %9s %9s\n", "Stage", "Workers", "Packets",
+           "In-Stalls", "Out-Stalls", "Occupancy", "Busy (s)");
+    
+    for (int i = 0; i < SIM_NUM_STAGES; i++) {
+        const SimStageStats* stage = &stats->stages[i];
+        printf("  %-12s %7d %10lld %10lld %10lld %8.1f%% %9.3f\n",
+               stage->name ? stage->name : "-", stage->workers, stage->packets,
+               stage->input_stalls, stage->output_stalls,
+               stage->avg_occupancy * 100.0, stage->busy_time);
+    }
+    printf("\n");
+}
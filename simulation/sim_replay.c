@@ -0,0 +1,465 @@
+/**
+ * @file sim_replay.c
+ * @brief Replay of recorded captures through the receive chain
+ *
+ * A capture is memory-mapped and cut into packet frames of
+ * sim_packet_samples() samples. Frames are processed in chunks:
+ *
+ *   prefetch chunk c+1 -> [filter chunk c] -> demodulate + decode on the pool
+ *   -> release chunk c
+ *
+ * so the kernel reads ahead while the workers decode, and consumed pages
+ * leave the page cache. The streaming FIR runs serially on the calling
+ * thread because its state carries across frames; without it, workers read
+ * their frames straight from the mapping.
+ */
+
+#include "simulator.h"
+#include "../src/signal_processing/signal_processing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define MODULE_NAME "Replay"
+
+/* Frames per chunk (prefetch and release granularity) */
+#define SIM_REPLAY_CHUNK_FRAMES 64
+
+static double sim_replay_now(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Per-worker codec chain, packet buffers and counters
+ */
+typedef struct {
+    SimLink link;
+    SimPacket packet;
+    double* rx_symbols;          /**< The packet's own buffer (restored after a mapped frame) */
+    float* rx_symbols_f32;       /**< The packet's own buffer (single precision) */
+    long long frames;
+    long long failed;
+    long long uncorrectable;
+    long long corrected_errors;
+    long long total_iterations;
+    long long bit_errors;
+    long long bits_compared;
+} SimReplayWorker;
+
+typedef struct {
+    SimReplayWorker* workers;
+    int* status;
+    const SimConfig* config;
+} SimReplayInitJob;
+
+static void sim_replay_init_range(void* context, size_t begin, size_t end, int worker) {
+    SimReplayInitJob* job = (SimReplayInitJob*)context;
+    (void)worker;
+    
+    for (size_t w = begin; w < end; w++) {
+        SimReplayWorker* rw = &job->workers[w];
+        memset(rw, 0, sizeof(SimReplayWorker));
+        job->status[w] = sim_link_init(&rw->link, job->config);
+        if (job->status[w] != FSO_SUCCESS) {
+            continue;
+        }
+        job->status[w] = sim_packet_init(&rw->packet, job->config);
+        if (job->status[w] != FSO_SUCCESS) {
+            sim_link_free(&rw->link);
+            continue;
+        }
+        rw->rx_symbols = rw->packet.rx_symbols;
+        rw->rx_symbols_f32 = rw->packet.rx_symbols_f32;
+    }
+}
+
+/**
+ * @brief Frames of one chunk, claimed by pool workers
+ *
+ * Frame samples come from staging (filtered doubles) when it is set, and
+ * from the mapping otherwise.
+ */
+typedef struct {
+    SimReplayWorker* workers;
+    const SimConfig* config;
+    const SimReplayConfig* replay;
+    const FSOCaptureReader* reader;
+    const double* staging;
+    uint64_t run_seed;
+    long long first_frame;
+    size_t frame_samples;
+    double amplitude;
+    double snr_db;
+    int single;
+} SimReplayChunkJob;
+
+/**
+ * @brief Point the packet's received symbols at frame samples, converting
+ *        into the packet's own buffer when the formats differ
+ */
+static void sim_replay_load_frame(const SimReplayChunkJob* job, SimReplayWorker* worker,
+                                  size_t chunk_index) {
+    SimPacket* packet = &worker->packet;
+    size_t n = job->frame_samples;
+    size_t first = (size_t)(job->first_frame + (long long)chunk_index) * n;
+    
+    if (job->staging != NULL) {
+        const double* src = job->staging + chunk_index * n;
+        if (!job->single) {
+            packet->rx_symbols = (double*)src;
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                worker->rx_symbols_f32[i] = (float)src[i];
+            }
+        }
+        return;
+    }
+    
+    switch (job->reader->info.type) {
+        case FSO_CAPTURE_REAL_F64: {
+            // Copy-on-write mapping: the demodulator may treat it as its own buffer
+            double* src = (double*)fso_capture_samples(job->reader, first);
+            if (!job->single) {
+                packet->rx_symbols = src;
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    worker->rx_symbols_f32[i] = (float)src[i];
+                }
+            }
+            break;
+        }
+        case FSO_CAPTURE_REAL_F32: {
+            float* src = (float*)fso_capture_samples(job->reader, first);
+            if (job->single) {
+                packet->rx_symbols_f32 = src;
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    worker->rx_symbols[i] = src[i];
+                }
+            }
+            break;
+        }
+        case FSO_CAPTURE_COMPLEX_F64: {
+            // The detector output is the in-phase component
+            SignalBuffer view;
+            fso_capture_view(job->reader, first, n, &view);
+            for (size_t i = 0; i < n; i++) {
+                if (job->single) {
+                    worker->rx_symbols_f32[i] = (float)view.samples[i].real;
+                } else {
+                    worker->rx_symbols[i] = view.samples[i].real;
+                }
+            }
+            break;
+        }
+    }
+}
+
+static void sim_replay_range(void* context, size_t begin, size_t end, int worker) {
+    const SimReplayChunkJob* job = (const SimReplayChunkJob*)context;
+    SimReplayWorker* rw = &job->workers[worker];
+    SimPacket* packet = &rw->packet;
+    const SimConfig* config = job->config;
+    
+    for (size_t i = begin; i < end; i++) {
+        int frame = (int)(job->first_frame + (long long)i);
+        
+        // The reference payload is the one sim_run() sends as this packet
+        if (job->replay->reference) {
+            sim_stage_transmit(&rw->link, config, job->run_seed, frame, packet);
+        } else {
+            packet->status = FSO_SUCCESS;
+        }
+        packet->packet_id = frame;
+        packet->fec_stats = (FECStats){0};
+        packet->channel_gain = job->amplitude;
+        packet->snr_db = job->snr_db;
+        packet->symbol_len = job->frame_samples;
+        sim_replay_load_frame(job, rw, i);
+        
+        sim_stage_demodulate(&rw->link, config, packet);
+        sim_stage_decode(&rw->link, config, packet);
+        packet->rx_symbols = rw->rx_symbols;
+        packet->rx_symbols_f32 = rw->rx_symbols_f32;
+        
+        rw->frames++;
+        if (packet->status != FSO_SUCCESS) {
+            rw->failed++;
+            continue;
+        }
+        rw->uncorrectable += packet->fec_stats.uncorrectable ? 1 : 0;
+        rw->corrected_errors += packet->fec_stats.errors_corrected;
+        rw->total_iterations += packet->fec_stats.iterations;
+        if (job->replay->reference) {
+            PacketStats packet_stats;
+            TimeSeriesPoint point;
+            sim_stage_collect(config, 0.0, packet, &packet_stats, &point);
+            rw->bit_errors += packet_stats.bit_errors;
+            rw->bits_compared += packet_stats.bits_transmitted;
+        }
+    }
+}
+
+/**
+ * @brief Filter capture samples [first, first + count) into out
+ *
+ * Non-double formats are widened through scratch (count doubles) first.
+ */
+static int sim_replay_filter(SPFirStream* fir, const FSOCaptureReader* reader,
+                             size_t first, size_t count, double* scratch, double* out) {
+    const double* in = scratch;
+    
+    switch (reader->info.type) {
+        case FSO_CAPTURE_REAL_F64:
+            in = (const double*)fso_capture_samples(reader, first);
+            break;
+        case FSO_CAPTURE_REAL_F32: {
+            const float* src = (const float*)fso_capture_samples(reader, first);
+            for (size_t i = 0; i < count; i++) {
+                scratch[i] = src[i];
+            }
+            break;
+        }
+        case FSO_CAPTURE_COMPLEX_F64: {
+            SignalBuffer view;
+            fso_capture_view(reader, first, count, &view);
+            for (size_t i = 0; i < count; i++) {
+                scratch[i] = view.samples[i].real;
+            }
+            break;
+        }
+    }
+    
+    return sp_fir_stream_push(fir, in, out, count);
+}
+
+int sim_run_replay(const SimConfig* config, const SimReplayConfig* replay,
+                   SimReplayStats* stats) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(replay);
+    FSO_CHECK_NULL(replay->capture_file);
+    FSO_CHECK_NULL(stats);
+    FSO_CHECK_PARAM(replay->num_fir_taps >= 0);
+    FSO_CHECK_PARAM(replay->num_fir_taps == 0 || replay->fir_taps != NULL);
+    FSO_CHECK_PARAM(replay->amplitude >= 0.0 && replay->noise_variance >= 0.0);
+    FSO_CHECK_PARAM(replay->max_frames >= 0);
+    
+    memset(stats, 0, sizeof(SimReplayStats));
+    
+    int result = sim_config_validate(config);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Configuration validation failed");
+        return result;
+    }
+    if (replay->reference && config->control.random_seed == 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Reference comparison needs a fixed random_seed");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // The receiver sees recorded samples: one gain per frame, the given noise
+    SimConfig link_config = *config;
+    link_config.environment.intra_packet_fading = 0;
+    if (replay->noise_variance > 0.0) {
+        link_config.control.noise_floor = replay->noise_variance;
+    }
+    double amplitude = (replay->amplitude > 0.0) ? replay->amplitude : 1.0;
+    double snr_db = fso_linear_to_db(amplitude * amplitude / link_config.control.noise_floor);
+    
+    FSOCaptureReader reader;
+    result = fso_capture_open(&reader, replay->capture_file);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    if (reader.info.sample_rate != config->control.sample_rate) {
+        FSO_LOG_WARNING(MODULE_NAME, "Capture sample rate %.6g Hz differs from the configured %.6g Hz",
+                        reader.info.sample_rate, config->control.sample_rate);
+    }
+    
+    // Frames start after the filter's group delay, so filtered frame k
+    // lines up with raw frame k
+    size_t frame_samples = sim_packet_samples(&link_config);
+    size_t delay = (replay->num_fir_taps > 0) ? (size_t)(replay->num_fir_taps - 1) / 2 : 0;
+    size_t available = (reader.info.num_samples > delay) ?
+                       (size_t)(reader.info.num_samples - delay) : 0;
+    long long total_frames = (long long)(available / frame_samples);
+    if (replay->max_frames > 0) {
+        total_frames = FSO_MIN(total_frames, replay->max_frames);
+    }
+    total_frames = FSO_MIN(total_frames, (long long)INT32_MAX);
+    if (total_frames == 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "%s holds no complete %zu-sample frame",
+                      replay->capture_file, frame_samples);
+        fso_capture_close(&reader);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    fso_threadpool_init(NULL);
+    int num_threads = (config->control.num_threads > 0) ?
+                      config->control.num_threads : fso_threadpool_size();
+    num_threads = FSO_MIN(num_threads, fso_threadpool_size());
+    num_threads = (int)FSO_MIN((long long)num_threads, total_frames);
+    
+    FSO_LOG_INFO(MODULE_NAME, "Replaying %lld frames of %zu samples from %s on %d thread(s)",
+                 total_frames, frame_samples, replay->capture_file, num_threads);
+    
+    size_t chunk_frames = (size_t)FSO_MIN((long long)SIM_REPLAY_CHUNK_FRAMES, total_frames);
+    size_t chunk_samples = chunk_frames * frame_samples;
+    SimReplayWorker* workers = (SimReplayWorker*)calloc((size_t)num_threads,
+                                                        sizeof(SimReplayWorker));
+    int* worker_status = (int*)malloc((size_t)num_threads * sizeof(int));
+    double* staging = NULL;
+    double* scratch = NULL;
+    SPFirStream fir;
+    int has_fir = 0;
+    int num_workers = 0;
+    
+    if (workers == NULL || worker_status == NULL) {
+        result = FSO_ERROR_MEMORY;
+    } else if (replay->num_fir_taps > 0) {
+        staging = (double*)malloc(chunk_samples * sizeof(double));
+        scratch = (double*)malloc(FSO_MAX(chunk_samples, delay) * sizeof(double));
+        result = (staging && scratch) ? sp_fir_stream_init(&fir, NULL, replay->fir_taps,
+                                                           replay->num_fir_taps) :
+                                        FSO_ERROR_MEMORY;
+        has_fir = (result == FSO_SUCCESS);
+    }
+    
+    if (result == FSO_SUCCESS) {
+        // Worker slot w is set up on pool worker w, which later runs its frames
+        SimReplayInitJob init_job = { workers, worker_status, &link_config };
+        fso_parallel_for((size_t)num_threads, 0, num_threads, sim_replay_init_range, &init_job);
+        for (int w = 0; w < num_threads; w++) {
+            if (worker_status[w] != FSO_SUCCESS) {
+                result = worker_status[w];
+            }
+        }
+        num_workers = num_threads;
+    }
+    
+    // Prime the filter with the delay samples; their outputs precede frame 0
+    if (result == FSO_SUCCESS && has_fir && delay > 0) {
+        double* primed = staging;
+        size_t done = 0;
+        while (done < delay && result == FSO_SUCCESS) {
+            size_t n = FSO_MIN(delay - done, chunk_samples);
+            result = sim_replay_filter(&fir, &reader, done, n, scratch, primed);
+            done += n;
+        }
+    }
+    
+    SimReplayChunkJob job = {
+        .workers = workers,
+        .config = &link_config,
+        .replay = replay,
+        .reader = &reader,
+        .staging = has_fir ? staging : NULL,
+        .run_seed = sim_run_seed(&link_config),
+        .frame_samples = frame_samples,
+        .amplitude = amplitude,
+        .snr_db = snr_db,
+        .single = (link_config.system.precision != FSO_PRECISION_DOUBLE)
+    };
+    
+    double start = sim_replay_now();
+    if (result == FSO_SUCCESS) {
+        fso_capture_prefetch(&reader, delay, chunk_samples);
+    }
+    for (long long c0 = 0; c0 < total_frames && result == FSO_SUCCESS;
+         c0 += (long long)chunk_frames) {
+        size_t frames = (size_t)FSO_MIN((long long)chunk_frames, total_frames - c0);
+        size_t first = delay + (size_t)c0 * frame_samples;
+        size_t count = frames * frame_samples;
+        
+        // Read ahead of the workers by one chunk
+        fso_capture_prefetch(&reader, first + count, chunk_samples);
+        if (has_fir) {
+            result = sim_replay_filter(&fir, &reader, first, count, scratch, staging);
+            if (result != FSO_SUCCESS) {
+                break;
+            }
+        }
+        
+        job.first_frame = c0;
+        fso_parallel_for(frames, 1, num_threads, sim_replay_range, &job);
+        fso_capture_release(&reader, first, count);
+        stats->samples += (long long)count;
+    }
+    stats->wall_time = sim_replay_now() - start;
+    
+    if (result == FSO_SUCCESS) {
+        for (int w = 0; w < num_workers; w++) {
+            stats->frames += workers[w].frames;
+            stats->failed += workers[w].failed;
+            stats->uncorrectable += workers[w].uncorrectable;
+            stats->corrected_errors += workers[w].corrected_errors;
+            stats->total_iterations += workers[w].total_iterations;
+            stats->bit_errors += workers[w].bit_errors;
+            stats->bits_compared += workers[w].bits_compared;
+        }
+        stats->capture_start = reader.info.timestamp + (double)delay / reader.info.sample_rate;
+        stats->capture_duration = (double)stats->samples / reader.info.sample_rate;
+        if (stats->wall_time > 0.0) {
+            stats->read_mb_per_second = (double)stats->samples * (double)reader.sample_size /
+                                        stats->wall_time / 1e6;
+            stats->payload_mbps = (double)(stats->frames - stats->failed) *
+                                  config->control.packet_size * 8.0 / stats->wall_time / 1e6;
+        }
+    } else {
+        FSO_LOG_ERROR(MODULE_NAME, "Replay of %s failed (%d)", replay->capture_file, result);
+    }
+    
+    for (int w = 0; w < num_workers; w++) {
+        if (worker_status[w] == FSO_SUCCESS) {
+            sim_packet_free(&workers[w].packet);
+            sim_link_free(&workers[w].link);
+        }
+    }
+    if (has_fir) {
+        sp_fir_stream_free(&fir);
+    }
+    free(staging);
+    free(scratch);
+    free(worker_status);
+    free(workers);
+    fso_capture_close(&reader);
+    
+    return result;
+}
+
+void sim_replay_print_stats(const SimReplayStats* stats) {
+    if (stats == NULL) {
+        printf("NULL replay statistics\n");
+        return;
+    }
+    
+    printf("\n");
+    printf("=== Capture Replay ===\n");
+    printf("  Frames:               %lld (%lld failed)\n", stats->frames, stats->failed);
+    printf("  Samples:              %lld\n", stats->samples);
+    printf("  Capture Span:         %.6f s from t = %.6f s\n",
+           stats->capture_duration, stats->capture_start);
+    printf("  Uncorrectable:        %lld\n", stats->uncorrectable);
+    printf("  Corrected Errors:     %lld\n", stats->corrected_errors);
+    if (stats->frames > 0 && stats->total_iterations > 0) {
+        printf("  Avg Iterations:       %.2f\n",
+               (double)stats->total_iterations / (double)stats->frames);
+    }
+    if (stats->bits_compared > 0) {
+        printf("  Bit Errors:           %lld / %lld (BER %.3e)\n", stats->bit_errors,
+               stats->bits_compared, (double)stats->bit_errors / (double)stats->bits_compared);
+    }
+    printf("  Wall Time:            %.3f s\n", stats->wall_time);
+    printf("  Read Rate:            %.1f MB/s\n", stats->read_mb_per_second);
+    printf("  Payload Rate:         %.2f Mbit/s\n", stats->payload_mbps);
+    printf("\n");
+}
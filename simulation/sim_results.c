@@ -20,26 +20,30 @@ int sim_results_init(SimResults* results, size_t history_capacity, int num_packe
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    if (history_capacity == 0 || num_packets <= 0) {
-        FSO_LOG_ERROR("SimResults", "Invalid capacity or num_packets");
+    if (num_packets < 0) {
+        FSO_LOG_ERROR("SimResults", "Invalid num_packets");
         return FSO_ERROR_INVALID_PARAM;
     }
     
     // Initialize all fields to zero
     memset(results, 0, sizeof(SimResults));
     
-    // Allocate time-series history
-    results->history = (TimeSeriesPoint*)calloc(history_capacity, sizeof(TimeSeriesPoint));
-    if (results->history == NULL) {
-        FSO_LOG_ERROR("SimResults", "Failed to allocate history array");
-        return FSO_ERROR_MEMORY;
+    // Allocate time-series history (none: aggregates only)
+    if (history_capacity > 0) {
+        results->history = (TimeSeriesPoint*)calloc(history_capacity, sizeof(TimeSeriesPoint));
+        if (results->history == NULL) {
+            FSO_LOG_ERROR("SimResults", "Failed to allocate history array");
+            return FSO_ERROR_MEMORY;
+        }
     }
     results->history_capacity = history_capacity;
     results->history_length = 0;
     
     // Allocate packet statistics
-    results->packet_stats = (PacketStats*)calloc(num_packets, sizeof(PacketStats));
-    if (results->packet_stats == NULL) {
+    if (num_packets > 0) {
+        results->packet_stats = (PacketStats*)calloc(num_packets, sizeof(PacketStats));
+    }
+    if (num_packets > 0 && results->packet_stats == NULL) {
         FSO_LOG_ERROR("SimResults", "Failed to allocate packet stats array");
         free(results->history);
         results->history = NULL;
@@ -47,22 +51,99 @@ int sim_results_init(SimResults* results, size_t history_capacity, int num_packe
     }
     results->num_packet_stats = 0;
     
-    // Initialize min/max values
+    // Initialize min/max values and the online accumulators
     results->min_snr = INFINITY;
     results->max_snr = -INFINITY;
     results->min_ber = INFINITY;
     results->max_ber = -INFINITY;
+    sim_stat_init(&results->snr_stat);
+    sim_stat_init(&results->throughput_stat);
+    sim_stat_init(&results->azimuth_stat);
+    sim_stat_init(&results->elevation_stat);
+    sim_stat_init(&results->ber_stat);
+    sim_histogram_init(&results->snr_hist, SIM_SNR_HIST_MIN_DB, SIM_SNR_HIST_MAX_DB, 0);
+    sim_histogram_init(&results->ber_hist, SIM_BER_HIST_MIN, SIM_BER_HIST_MAX, 1);
+    sim_stat_init(&results->latency_stat);
+    sim_histogram_init(&results->latency_hist, SIM_LATENCY_HIST_MIN_S, SIM_LATENCY_HIST_MAX_S, 1);
     
     FSO_LOG_INFO("SimResults", "Initialized with capacity %zu history points, %d packets",
                  history_capacity, num_packets);
     return FSO_SUCCESS;
 }
 
+int sim_results_init_run(SimResults* results, const SimConfig* config, int keep_history) {
+    if (results == NULL || config == NULL) {
+        FSO_LOG_ERROR("SimResults", "NULL pointer in init_run");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    const char* stream_file = config->control.results_stream;
+    int in_memory = keep_history && stream_file[0] == '\0';
+    int result = in_memory ?
+        sim_results_init(results, (size_t)config->control.num_packets * 10,
+                         config->control.num_packets) :
+        sim_results_init(results, 0, 0);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    // Adaptive runs count packets per mode of the ladder they use
+    const SimAMCConfig* amc = &config->system.amc;
+    if (amc->enabled) {
+        results->amc_enabled = 1;
+        if (amc->num_modes > 0) {
+            results->amc_num_modes = FSO_MIN(amc->num_modes, SIM_AMC_MAX_MODES);
+            memcpy(results->amc_modes, amc->modes,
+                   (size_t)results->amc_num_modes * sizeof(SimAMCMode));
+        } else {
+            results->amc_num_modes = sim_amc_default_ladder(results->amc_modes);
+        }
+    }
+    if (config->system.harq.enabled) {
+        results->harq_enabled = 1;
+        results->harq_max_transmissions = config->system.harq.max_transmissions;
+    }
+    if (stream_file[0] == '\0') {
+        return FSO_SUCCESS;
+    }
+    
+    // Rows go to the stream as the run progresses; only aggregates stay here
+    results->stream = (SimStreamWriter*)malloc(sizeof(SimStreamWriter));
+    if (results->stream == NULL) {
+        sim_results_free(results);
+        return FSO_ERROR_MEMORY;
+    }
+    unsigned int flags = (config->system.enable_tracking ? SIM_STREAM_FLAG_TRACKING : 0u) |
+                         (config->control.importance_sampling ? SIM_STREAM_FLAG_IMPORTANCE : 0u) |
+                         (amc->enabled ? SIM_STREAM_FLAG_AMC : 0u) |
+                         (config->system.harq.enabled ? SIM_STREAM_FLAG_HARQ : 0u);
+    result = sim_stream_writer_open(results->stream, stream_file, flags);
+    if (result != FSO_SUCCESS) {
+        free(results->stream);
+        results->stream = NULL;
+        sim_results_free(results);
+    }
+    return result;
+}
+
+int sim_results_finish_run(SimResults* results) {
+    if (results == NULL || results->stream == NULL) {
+        return FSO_SUCCESS;
+    }
+    
+    int result = sim_stream_writer_close(results->stream);
+    free(results->stream);
+    results->stream = NULL;
+    return result;
+}
+
 void sim_results_free(SimResults* results) {
     if (results == NULL) {
         return;
     }
     
+    sim_results_finish_run(results);
+    
     if (results->history != NULL) {
         free(results->history);
         results->history = NULL;
@@ -90,6 +171,31 @@ int sim_results_add_point(SimResults* results, const TimeSeriesPoint* point) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    // Online aggregates, in arrival order
+    if (results->num_points == 0) {
+        results->first_timestamp = point->timestamp;
+    }
+    results->last_timestamp = point->timestamp;
+    results->num_points++;
+    sim_stat_add(&results->snr_stat, point->snr_db);
+    sim_stat_add(&results->throughput_stat, point->throughput);
+    sim_stat_add(&results->azimuth_stat, point->beam_azimuth);
+    sim_stat_add(&results->elevation_stat, point->beam_elevation);
+    sim_histogram_add(&results->snr_hist, point->snr_db);
+    if (point->ber < results->min_ber) {
+        results->min_ber = point->ber;
+    }
+    if (point->ber > results->max_ber) {
+        results->max_ber = point->ber;
+    }
+    
+    if (results->stream != NULL) {
+        sim_stream_write_point(results->stream, point);
+    }
+    if (results->history == NULL) {
+        return FSO_SUCCESS;
+    }
+    
     // Check if we need to reallocate
     if (results->history_length >= results->history_capacity) {
         size_t new_capacity = results->history_capacity * 2;
@@ -119,32 +225,164 @@ int sim_results_add_packet(SimResults* results, const PacketStats* stats) {
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    if (results->packet_stats == NULL) {
-        FSO_LOG_ERROR("SimResults", "Packet stats array not initialized");
-        return FSO_ERROR_NOT_INITIALIZED;
+    // Keep the row in memory and/or stream it
+    if (results->packet_stats != NULL) {
+        size_t index = results->num_packet_stats;
+        results->packet_stats[index] = *stats;
+        results->num_packet_stats++;
+    }
+    if (results->stream != NULL) {
+        sim_stream_write_packet(results->stream, stats);
     }
-    
-    // Add packet stats
-    size_t index = results->num_packet_stats;
-    results->packet_stats[index] = *stats;
-    results->num_packet_stats++;
     
     // Update counters
     results->total_packets++;
     results->total_bits += stats->bits_transmitted;
     results->total_bit_errors += stats->bit_errors;
     
+    // Likelihood-ratio weight (1 without importance sampling)
+    double weight = exp(stats->log_weight);
+    sim_kahan_add(&results->sum_weights, weight);
+    sim_kahan_add(&results->sum_sq_weights, weight * weight);
+    sim_kahan_add(&results->weighted_bit_errors, weight * stats->bit_errors);
+    
     if (stats->fec_uncorrectable) {
         results->packets_lost++;
+        sim_kahan_add(&results->weighted_packets_lost, weight);
     } else {
         results->packets_received++;
     }
     
     results->fec_corrected_errors += stats->fec_corrected_errors;
+    results->fec_iterations += stats->fec_iterations;
+    
+    // Goodput counts only packets that arrive intact
+    sim_kahan_add(&results->total_airtime, stats->airtime);
+    if (stats->bit_errors == 0 && !stats->fec_uncorrectable) {
+        results->delivered_bits += stats->bits_transmitted;
+    }
+    if (stats->amc_mode >= 0 && stats->amc_mode < SIM_AMC_MAX_MODES) {
+        results->amc_mode_packets[stats->amc_mode]++;
+    }
+    
+    // Transmissions per packet, and latency of the packets that got through
+    results->harq_transmissions += stats->harq_transmissions;
+    if (stats->harq_transmissions >= 1 && stats->harq_transmissions <= SIM_HARQ_MAX_TRANSMISSIONS) {
+        results->harq_transmission_packets[stats->harq_transmissions - 1]++;
+    }
+    if (!stats->fec_uncorrectable) {
+        sim_stat_add(&results->latency_stat, stats->latency);
+        sim_histogram_add(&results->latency_hist, stats->latency);
+    }
+    
+    // Second moments for the BER confidence interval
+    double bits = (double)stats->bits_transmitted;
+    double errors = weight * (double)stats->bit_errors;
+    sim_kahan_add(&results->sum_sq_bit_errors, errors * errors);
+    sim_kahan_add(&results->sum_bits_bit_errors, bits * errors);
+    sim_kahan_add(&results->sum_sq_bits, bits * bits);
+    
+    // Per-packet BER distribution
+    sim_stat_add(&results->ber_stat, stats->ber);
+    sim_histogram_add(&results->ber_hist, stats->ber);
     
     return FSO_SUCCESS;
 }
 
+/* ============================================================================
+ * Confidence Interval and Stopping Rule
+ * ============================================================================ */
+
+/**
+ * @brief Standard normal quantile (Acklam's rational approximation)
+ * 
+ * Relative error below 1.2e-9 over (0, 1).
+ */
+static double normal_quantile(double p) {
+    static const double a[] = { -3.969683028665376e+01,  2.209460984245205e+02,
+                                -2.759285104469687e+02,  1.383577518672690e+02,
+                                -3.066479806614716e+01,  2.506628277459239e+00 };
+    static const double b[] = { -5.447609879822406e+01,  1.615858368580409e+02,
+                                -1.556989798598866e+02,  6.680131188771972e+01,
+                                -1.328068155288572e+01 };
+    static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01,
+                                -2.400758277161838e+00, -2.549732539343734e+00,
+                                 4.374664141464968e+00,  2.938163982698783e+00 };
+    static const double d[] = {  7.784695709041462e-03,  3.224671290700398e-01,
+                                 2.445134137142996e+00,  3.754408661907416e+00 };
+    const double p_low = 0.02425;
+    
+    if (p < p_low) {
+        double q = sqrt(-2.0 * log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - p_low) {
+        return -normal_quantile(1.0 - p);
+    }
+    
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+/**
+ * @brief Update ber_ci_half_width and ber_relative_error
+ * 
+ * BER is the ratio estimator sum(w_i e_i) / sum(b_i) over packets; its
+ * variance is sum((w_i e_i - BER * b_i)^2) / (n (n - 1) mean(b)^2).
+ */
+static void update_confidence(SimResults* results, double z) {
+    long long n = results->total_packets;
+    if (n < 2 || results->total_bits <= 0) {
+        results->ber_ci_half_width = INFINITY;
+        results->ber_relative_error = INFINITY;
+        return;
+    }
+    
+    double ber = sim_kahan_value(&results->weighted_bit_errors) / (double)results->total_bits;
+    double residual = sim_kahan_value(&results->sum_sq_bit_errors)
+                    - 2.0 * ber * sim_kahan_value(&results->sum_bits_bit_errors)
+                    + ber * ber * sim_kahan_value(&results->sum_sq_bits);
+    double mean_bits = (double)results->total_bits / (double)n;
+    double variance = FSO_MAX(residual, 0.0) / ((double)n * (double)(n - 1) * mean_bits * mean_bits);
+    
+    results->ber_ci_half_width = z * sqrt(variance);
+    results->ber_relative_error = (ber > 0.0) ? results->ber_ci_half_width / ber : INFINITY;
+}
+
+static double confidence_z(double level) {
+    if (level <= 0.0 || level >= 1.0) {
+        level = 0.95;
+    }
+    return normal_quantile(0.5 + 0.5 * level);
+}
+
+int sim_results_check_stop(SimResults* results, const SimulationControl* control) {
+    if (results == NULL || control == NULL) {
+        return 0;
+    }
+    
+    if (control->target_bit_errors > 0 &&
+        results->total_bit_errors >= control->target_bit_errors) {
+        results->stop_reason = SIM_STOP_BIT_ERRORS;
+        return 1;
+    }
+    
+    if (control->target_relative_error > 0.0 &&
+        results->total_bit_errors >= SIM_STOP_MIN_CI_ERRORS &&
+        results->total_packets >= SIM_STOP_MIN_CI_PACKETS) {
+        update_confidence(results, confidence_z(control->confidence_level));
+        if (results->ber_relative_error <= control->target_relative_error) {
+            results->stop_reason = SIM_STOP_CONFIDENCE;
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /* ============================================================================
  * Metrics Calculation
  * ============================================================================ */
@@ -160,62 +398,61 @@ int sim_results_calculate_metrics(SimResults* results) {
         return FSO_SUCCESS;
     }
     
-    // Calculate packet loss rate
-    results->packet_loss_rate = (double)results->packets_lost / (double)results->total_packets;
+    // Calculate packet loss rate and average BER. Each packet counts with
+    // its likelihood-ratio weight, so importance-sampled runs give unbiased
+    // estimates under the true distributions (weights are 1 otherwise)
+    results->packet_loss_rate = sim_kahan_value(&results->weighted_packets_lost) /
+                               (double)results->total_packets;
     
-    // Calculate average BER
     if (results->total_bits > 0) {
-        results->avg_ber = (double)results->total_bit_errors / (double)results->total_bits;
+        results->avg_ber = sim_kahan_value(&results->weighted_bit_errors) /
+                           (double)results->total_bits;
     }
     
-    // Calculate averages from time-series data
-    if (results->history_length > 0) {
-        double sum_snr = 0.0;
-        double sum_throughput = 0.0;
-        double sum_beam_az = 0.0;
-        double sum_beam_el = 0.0;
-        
-        for (size_t i = 0; i < results->history_length; i++) {
-            TimeSeriesPoint* point = &results->history[i];
-            
-            sum_snr += point->snr_db;
-            sum_throughput += point->throughput;
-            
-            if (results->tracking_enabled) {
-                sum_beam_az += point->beam_azimuth;
-                sum_beam_el += point->beam_elevation;
-            }
-            
-            // Update min/max
-            if (point->snr_db < results->min_snr) {
-                results->min_snr = point->snr_db;
-            }
-            if (point->snr_db > results->max_snr) {
-                results->max_snr = point->snr_db;
-            }
-            
-            if (point->ber < results->min_ber) {
-                results->min_ber = point->ber;
-            }
-            if (point->ber > results->max_ber) {
-                results->max_ber = point->ber;
-            }
-        }
-        
-        results->avg_snr = sum_snr / results->history_length;
-        results->avg_throughput = sum_throughput / results->history_length;
+    double sum_weights = sim_kahan_value(&results->sum_weights);
+    double sum_sq_weights = sim_kahan_value(&results->sum_sq_weights);
+    results->effective_samples = (sum_sq_weights > 0.0) ?
+        sum_weights * sum_weights / sum_sq_weights : 0.0;
+    
+    // Confidence interval of the BER estimate
+    update_confidence(results, confidence_z(results->confidence_level));
+    
+    // Average iterations of the iterative (LDPC) decoder
+    results->avg_fec_iterations = (double)results->fec_iterations / (double)results->total_packets;
+    
+    // Delivered payload per second of channel time
+    double airtime = sim_kahan_value(&results->total_airtime);
+    results->goodput = (airtime > 0.0) ? (double)results->delivered_bits / airtime : 0.0;
+    
+    // Per-packet BER quantiles
+    results->ber_p50 = sim_histogram_quantile(&results->ber_hist, 0.50);
+    results->ber_p99 = sim_histogram_quantile(&results->ber_hist, 0.99);
+    
+    // Transmissions per packet and delivery latency quantiles
+    results->avg_harq_transmissions = (double)results->harq_transmissions /
+                                      (double)results->total_packets;
+    if (results->latency_hist.count > 0) {
+        results->latency_p50 = sim_histogram_quantile(&results->latency_hist, 0.50);
+        results->latency_p99 = sim_histogram_quantile(&results->latency_hist, 0.99);
+    }
+    
+    // Averages, spread and quantiles from the online time-series aggregates
+    if (results->num_points > 0) {
+        results->avg_snr = results->snr_stat.mean;
+        results->std_snr = sqrt(sim_stat_variance(&results->snr_stat));
+        results->min_snr = results->snr_stat.min;
+        results->max_snr = results->snr_stat.max;
+        results->snr_p01 = sim_histogram_quantile(&results->snr_hist, 0.01);
+        results->snr_p50 = sim_histogram_quantile(&results->snr_hist, 0.50);
+        results->avg_throughput = results->throughput_stat.mean;
         
         if (results->tracking_enabled) {
-            results->avg_beam_azimuth = sum_beam_az / results->history_length;
-            results->avg_beam_elevation = sum_beam_el / results->history_length;
+            results->avg_beam_azimuth = results->azimuth_stat.mean;
+            results->avg_beam_elevation = results->elevation_stat.mean;
         }
-    }
-    
-    // Calculate simulation duration
-    if (results->history_length > 0) {
-        results->simulation_duration = 
-            results->history[results->history_length - 1].timestamp - 
-            results->history[0].timestamp;
+        
+        // Calculate simulation duration
+        results->simulation_duration = results->last_timestamp - results->first_timestamp;
     }
     
     FSO_LOG_INFO("SimResults", "Calculated metrics: BER=%.3e, SNR=%.2f dB, PLR=%.3f",
@@ -224,6 +461,89 @@ int sim_results_calculate_metrics(SimResults* results) {
     return FSO_SUCCESS;
 }
 
+int sim_results_merge(SimResults* dst, const SimResults* src) {
+    if (dst == NULL || src == NULL) {
+        FSO_LOG_ERROR("SimResults", "NULL pointer in merge");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+
+    int result = sim_histogram_merge(&dst->snr_hist, &src->snr_hist);
+    if (result == FSO_SUCCESS) {
+        result = sim_histogram_merge(&dst->ber_hist, &src->ber_hist);
+    }
+    if (result == FSO_SUCCESS) {
+        result = sim_histogram_merge(&dst->latency_hist, &src->latency_hist);
+    }
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+
+    // Counters
+    dst->total_packets += src->total_packets;
+    dst->packets_received += src->packets_received;
+    dst->packets_lost += src->packets_lost;
+    dst->total_bits += src->total_bits;
+    dst->total_bit_errors += src->total_bit_errors;
+    dst->fec_corrected_errors += src->fec_corrected_errors;
+    dst->fec_iterations += src->fec_iterations;
+    dst->tracking_updates += src->tracking_updates;
+    dst->reacquisitions += src->reacquisitions;
+    dst->importance_sampling |= src->importance_sampling;
+    dst->tracking_enabled |= src->tracking_enabled;
+    dst->delivered_bits += src->delivered_bits;
+    dst->amc_switches += src->amc_switches;
+    if (src->amc_enabled && !dst->amc_enabled) {
+        dst->amc_enabled = 1;
+        dst->amc_num_modes = src->amc_num_modes;
+        memcpy(dst->amc_modes, src->amc_modes, sizeof(dst->amc_modes));
+    }
+    for (int m = 0; m < SIM_AMC_MAX_MODES; m++) {
+        dst->amc_mode_packets[m] += src->amc_mode_packets[m];
+    }
+    if (src->harq_enabled && !dst->harq_enabled) {
+        dst->harq_enabled = 1;
+        dst->harq_max_transmissions = src->harq_max_transmissions;
+    }
+    dst->harq_transmissions += src->harq_transmissions;
+    for (int t = 0; t < SIM_HARQ_MAX_TRANSMISSIONS; t++) {
+        dst->harq_transmission_packets[t] += src->harq_transmission_packets[t];
+    }
+
+    // Compensated sums
+    sim_kahan_merge(&dst->sum_sq_bit_errors, &src->sum_sq_bit_errors);
+    sim_kahan_merge(&dst->sum_bits_bit_errors, &src->sum_bits_bit_errors);
+    sim_kahan_merge(&dst->sum_sq_bits, &src->sum_sq_bits);
+    sim_kahan_merge(&dst->weighted_bit_errors, &src->weighted_bit_errors);
+    sim_kahan_merge(&dst->weighted_packets_lost, &src->weighted_packets_lost);
+    sim_kahan_merge(&dst->sum_weights, &src->sum_weights);
+    sim_kahan_merge(&dst->sum_sq_weights, &src->sum_sq_weights);
+    sim_kahan_merge(&dst->total_airtime, &src->total_airtime);
+
+    // Distributions
+    sim_stat_merge(&dst->snr_stat, &src->snr_stat);
+    sim_stat_merge(&dst->throughput_stat, &src->throughput_stat);
+    sim_stat_merge(&dst->azimuth_stat, &src->azimuth_stat);
+    sim_stat_merge(&dst->elevation_stat, &src->elevation_stat);
+    sim_stat_merge(&dst->ber_stat, &src->ber_stat);
+    sim_stat_merge(&dst->latency_stat, &src->latency_stat);
+    dst->min_ber = FSO_MIN(dst->min_ber, src->min_ber);
+    dst->max_ber = FSO_MAX(dst->max_ber, src->max_ber);
+
+    // Time span covered by both
+    if (src->num_points > 0) {
+        if (dst->num_points == 0) {
+            dst->first_timestamp = src->first_timestamp;
+            dst->last_timestamp = src->last_timestamp;
+        } else {
+            dst->first_timestamp = FSO_MIN(dst->first_timestamp, src->first_timestamp);
+            dst->last_timestamp = FSO_MAX(dst->last_timestamp, src->last_timestamp);
+        }
+        dst->num_points += src->num_points;
+    }
+
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Results Output
  * ============================================================================ */
@@ -249,9 +569,20 @@ void sim_results_print(const SimResults* results) {
     printf("Bit Error Statistics:\n");
     printf("  Total Bits:           %lld\n", results->total_bits);
     printf("  Total Bit Errors:     %lld\n", results->total_bit_errors);
+    if (results->importance_sampling) {
+        printf("  Weighted Bit Errors:  %.3e\n", sim_kahan_value(&results->weighted_bit_errors));
+        printf("  Effective Samples:    %.1f of %d packets\n",
+               results->effective_samples, results->total_packets);
+    }
     printf("  Average BER:          %.3e\n", results->avg_ber);
+    if (isfinite(results->ber_ci_half_width)) {
+        printf("  BER CI (%.0f%%):         +/-%.3e (+/-%.1f%%)\n",
+               (results->confidence_level > 0.0 ? results->confidence_level : 0.95) * 100.0,
+               results->ber_ci_half_width, results->ber_relative_error * 100.0);
+    }
     printf("  Min BER:              %.3e\n", results->min_ber);
     printf("  Max BER:              %.3e\n", results->max_ber);
+    printf("  Packet BER p50/p99:   %.3e / %.3e\n", results->ber_p50, results->ber_p99);
     printf("\n");
     
     printf("FEC Statistics:\n");
@@ -259,15 +590,56 @@ void sim_results_print(const SimResults* results) {
     printf("  Correction Rate:      %.1f%%\n",
            results->total_bit_errors > 0 ? 
            (100.0 * results->fec_corrected_errors / results->total_bit_errors) : 0.0);
+    if (results->fec_iterations > 0) {
+        printf("  Avg Decoder Iters:    %.2f\n", results->avg_fec_iterations);
+    }
     printf("\n");
     
     printf("Signal Quality:\n");
     printf("  Average SNR:          %.2f dB\n", results->avg_snr);
     printf("  Min SNR:              %.2f dB\n", results->min_snr);
     printf("  Max SNR:              %.2f dB\n", results->max_snr);
+    printf("  SNR Std Dev:          %.2f dB\n", results->std_snr);
+    printf("  SNR p01/p50:          %.2f / %.2f dB\n", results->snr_p01, results->snr_p50);
     printf("  Average Throughput:   %.3e bits/s\n", results->avg_throughput);
+    printf("  Goodput:              %.3e bits/s (%lld bits delivered in %.3e s airtime)\n",
+           results->goodput, results->delivered_bits, sim_kahan_value(&results->total_airtime));
     printf("\n");
     
+    if (results->amc_enabled) {
+        printf("Adaptive Modulation and Coding:\n");
+        printf("  Mode Switches:        %d\n", results->amc_switches);
+        for (int m = 0; m < results->amc_num_modes; m++) {
+            const SimAMCMode* mode = &results->amc_modes[m];
+            char name[32];
+            if (mode->modulation == MOD_PPM) {
+                snprintf(name, sizeof(name), "%d-PPM r=%.3f", mode->ppm_order, mode->code_rate);
+            } else {
+                snprintf(name, sizeof(name), "%s r=%.3f", sim_modulation_string(mode->modulation),
+                         mode->code_rate);
+            }
+            printf("  %-20s  %lld packets (>= %.1f dB)\n", name, results->amc_mode_packets[m],
+                   mode->min_snr_db);
+        }
+        printf("\n");
+    }
+    
+    if (results->harq_enabled) {
+        printf("Hybrid ARQ:\n");
+        printf("  Avg Transmissions:    %.3f per packet (max %d)\n",
+               results->avg_harq_transmissions, results->harq_max_transmissions);
+        for (int t = 0; t < results->harq_max_transmissions && t < SIM_HARQ_MAX_TRANSMISSIONS; t++) {
+            char label[32];
+            snprintf(label, sizeof(label), "%d Transmission%s:", t + 1, t == 0 ? "" : "s");
+            printf("  %-22s%lld packets\n", label, results->harq_transmission_packets[t]);
+        }
+        if (results->latency_stat.count > 0) {
+            printf("  Latency mean/p50/p99: %.3e / %.3e / %.3e s\n", results->latency_stat.mean,
+                   results->latency_p50, results->latency_p99);
+        }
+        printf("\n");
+    }
+    
     if (results->tracking_enabled) {
         printf("Beam Tracking:\n");
         printf("  Average Azimuth:      %.3f rad (%.2f deg)\n",
@@ -279,61 +651,153 @@ void sim_results_print(const SimResults* results) {
         printf("\n");
     }
     
+    if (results->stop_reason != SIM_STOP_BUDGET) {
+        printf("Stopping Rule:\n");
+        printf("  Stopped Early:        %s target after %d packets\n",
+               results->stop_reason == SIM_STOP_BIT_ERRORS ? "bit-error" : "confidence",
+               results->total_packets);
+        printf("\n");
+    }
+    
     printf("Timing:\n");
     printf("  Simulation Duration:  %.3f s\n", results->simulation_duration);
-    printf("  History Points:       %zu\n", results->history_length);
+    printf("  History Points:       %zu%s\n", results->num_points,
+           results->history == NULL ? " (streamed or aggregates only)" : "");
     printf("\n");
+    
+    int profiled = 0;
+    for (int zone = 0; zone < FSO_PROF_ZONE_COUNT; zone++) {
+        profiled |= (results->stage_profile[zone].count > 0);
+    }
+    if (profiled) {
+        printf("Stage Latency (us):\n");
+        printf("  %-14s %10s %10s %10s %10s %10s\n",
+               "Stage", "Count", "Mean", "p50", "p99", "Total ms");
+        for (int zone = 0; zone < FSO_PROF_ZONE_COUNT; zone++) {
+            const FSOProfileStats* stage = &results->stage_profile[zone];
+            if (stage->count == 0) {
+                continue;
+            }
+            printf("  %-14s %10llu %10.3f %10.3f %10.3f %10.3f\n",
+                   fso_profile_zone_name((FSOProfileZone)zone),
+                   (unsigned long long)stage->count, stage->mean_ns * 1e-3,
+                   stage->p50_ns * 1e-3, stage->p99_ns * 1e-3, stage->total_ns * 1e-6);
+        }
+        printf("\n");
+    }
 }
 
 /* ============================================================================
  * CSV Export
  * ============================================================================ */
 
+/**
+ * @brief Open a CSV file with a large stdio buffer
+ */
+static FILE* sim_csv_open(const char* filename) {
+    FILE* fp = fopen(filename, "w");
+    if (fp == NULL) {
+        FSO_LOG_ERROR("SimResults", "Failed to open file: %s", filename);
+        return NULL;
+    }
+    setvbuf(fp, NULL, _IOFBF, 1 << 20);
+    return fp;
+}
+
+static void sim_csv_write_points_header(FILE* fp, int tracking) {
+    fprintf(fp, "timestamp,ber,snr_db,received_power,throughput");
+    if (tracking) {
+        fprintf(fp, ",beam_azimuth,beam_elevation,signal_strength");
+    }
+    fprintf(fp, "\n");
+}
+
+static void sim_csv_write_point(FILE* fp, const TimeSeriesPoint* point, int tracking) {
+    fprintf(fp, "%.6f,%.6e,%.3f,%.6e,%.3e",
+            point->timestamp,
+            point->ber,
+            point->snr_db,
+            point->received_power,
+            point->throughput);
+    
+    if (tracking) {
+        fprintf(fp, ",%.6f,%.6f,%.6f",
+                point->beam_azimuth,
+                point->beam_elevation,
+                point->signal_strength);
+    }
+    
+    fprintf(fp, "\n");
+}
+
+static void sim_csv_write_packets_header(FILE* fp, int importance_sampling, int amc, int harq) {
+    fprintf(fp, "packet_id,bits_transmitted,bits_received,bit_errors,ber,snr_db,");
+    fprintf(fp, "received_power,fec_corrected_errors,fec_uncorrectable,fec_iterations,airtime%s%s%s\n",
+            importance_sampling ? ",log_weight" : "", amc ? ",amc_mode,amc_snr_db" : "",
+            harq ? ",harq_transmissions,latency" : "");
+}
+
+static void sim_csv_write_packet(FILE* fp, const PacketStats* stats, int importance_sampling,
+                                 int amc, int harq) {
+    fprintf(fp, "%d,%d,%d,%d,%.6e,%.3f,%.6e,%d,%d,%d",
+            stats->packet_id,
+            stats->bits_transmitted,
+            stats->bits_received,
+            stats->bit_errors,
+            stats->ber,
+            stats->snr_db,
+            stats->received_power,
+            stats->fec_corrected_errors,
+            stats->fec_uncorrectable,
+            stats->fec_iterations);
+    fprintf(fp, ",%.6e", stats->airtime);
+    if (importance_sampling) {
+        fprintf(fp, ",%.6e", stats->log_weight);
+    }
+    if (amc) {
+        fprintf(fp, ",%d,%.3f", stats->amc_mode, stats->amc_snr_db);
+    }
+    if (harq) {
+        fprintf(fp, ",%d,%.6e", stats->harq_transmissions, stats->latency);
+    }
+    fprintf(fp, "\n");
+}
+
+/**
+ * @brief Close a CSV file, reporting buffered write errors
+ */
+static int sim_csv_close(FILE* fp, const char* filename) {
+    int failed = ferror(fp);
+    failed |= (fclose(fp) != 0);
+    if (failed) {
+        FSO_LOG_ERROR("SimResults", "Failed to write file: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    return FSO_SUCCESS;
+}
+
 int sim_results_export_csv(const SimResults* results, const char* filename) {
     if (results == NULL || filename == NULL) {
         FSO_LOG_ERROR("SimResults", "NULL pointer in export_csv");
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    FILE* fp = fopen(filename, "w");
+    FILE* fp = sim_csv_open(filename);
     if (fp == NULL) {
-        FSO_LOG_ERROR("SimResults", "Failed to open file: %s", filename);
         return FSO_ERROR_IO;
     }
     
-    // Write header
-    fprintf(fp, "timestamp,ber,snr_db,received_power,throughput");
-    if (results->tracking_enabled) {
-        fprintf(fp, ",beam_azimuth,beam_elevation,signal_strength");
-    }
-    fprintf(fp, "\n");
-    
-    // Write data points
+    // Write header and data points
+    sim_csv_write_points_header(fp, results->tracking_enabled);
     for (size_t i = 0; i < results->history_length; i++) {
-        const TimeSeriesPoint* point = &results->history[i];
-        
-        fprintf(fp, "%.6f,%.6e,%.3f,%.6e,%.3e",
-                point->timestamp,
-                point->ber,
-                point->snr_db,
-                point->received_power,
-                point->throughput);
-        
-        if (results->tracking_enabled) {
-            fprintf(fp, ",%.6f,%.6f,%.6f",
-                    point->beam_azimuth,
-                    point->beam_elevation,
-                    point->signal_strength);
-        }
-        
-        fprintf(fp, "\n");
+        sim_csv_write_point(fp, &results->history[i], results->tracking_enabled);
     }
     
-    fclose(fp);
+    int result = sim_csv_close(fp, filename);
     FSO_LOG_INFO("SimResults", "Exported %zu time-series points to %s",
                  results->history_length, filename);
     
-    return FSO_SUCCESS;
+    return result;
 }
 
 int sim_results_export_packets_csv(const SimResults* results, const char* filename) {
@@ -342,35 +806,96 @@ int sim_results_export_packets_csv(const SimResults* results, const char* filena
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    FILE* fp = fopen(filename, "w");
+    FILE* fp = sim_csv_open(filename);
     if (fp == NULL) {
-        FSO_LOG_ERROR("SimResults", "Failed to open file: %s", filename);
         return FSO_ERROR_IO;
     }
     
-    // Write header
-    fprintf(fp, "packet_id,bits_transmitted,bits_received,bit_errors,ber,snr_db,");
-    fprintf(fp, "received_power,fec_corrected_errors,fec_uncorrectable\n");
-    
-    // Write packet data
+    // Write header and packet data
+    sim_csv_write_packets_header(fp, results->importance_sampling, results->amc_enabled,
+                                 results->harq_enabled);
     for (size_t i = 0; i < results->num_packet_stats; i++) {
-        const PacketStats* stats = &results->packet_stats[i];
-        
-        fprintf(fp, "%d,%d,%d,%d,%.6e,%.3f,%.6e,%d,%d\n",
-                stats->packet_id,
-                stats->bits_transmitted,
-                stats->bits_received,
-                stats->bit_errors,
-                stats->ber,
-                stats->snr_db,
-                stats->received_power,
-                stats->fec_corrected_errors,
-                stats->fec_uncorrectable);
-    }
-    
-    fclose(fp);
+        sim_csv_write_packet(fp, &results->packet_stats[i], results->importance_sampling,
+                             results->amc_enabled, results->harq_enabled);
+    }
+    
+    int result = sim_csv_close(fp, filename);
     FSO_LOG_INFO("SimResults", "Exported %zu packet statistics to %s",
                  results->num_packet_stats, filename);
     
-    return FSO_SUCCESS;
+    return result;
+}
+
+int sim_stream_export_csv(const char* stream_file, const char* points_csv,
+                          const char* packets_csv) {
+    if (stream_file == NULL) {
+        FSO_LOG_ERROR("SimResults", "NULL pointer in stream_export_csv");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    SimStreamReader reader;
+    int result = sim_stream_reader_open(&reader, stream_file);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    int tracking = (reader.flags & SIM_STREAM_FLAG_TRACKING) != 0;
+    int importance_sampling = (reader.flags & SIM_STREAM_FLAG_IMPORTANCE) != 0;
+    int amc = (reader.flags & SIM_STREAM_FLAG_AMC) != 0;
+    int harq = (reader.flags & SIM_STREAM_FLAG_HARQ) != 0;
+    
+    PacketStats* packets = (PacketStats*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(PacketStats));
+    TimeSeriesPoint* points = (TimeSeriesPoint*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(TimeSeriesPoint));
+    FILE* points_fp = (points_csv != NULL) ? sim_csv_open(points_csv) : NULL;
+    FILE* packets_fp = (packets_csv != NULL) ? sim_csv_open(packets_csv) : NULL;
+    if (packets == NULL || points == NULL) {
+        result = FSO_ERROR_MEMORY;
+    } else if ((points_csv != NULL && points_fp == NULL) ||
+               (packets_csv != NULL && packets_fp == NULL)) {
+        result = FSO_ERROR_IO;
+    }
+    
+    if (points_fp != NULL) {
+        sim_csv_write_points_header(points_fp, tracking);
+    }
+    if (packets_fp != NULL) {
+        sim_csv_write_packets_header(packets_fp, importance_sampling, amc, harq);
+    }
+    
+    // One chunk at a time, so memory does not grow with the run
+    size_t num_points = 0, num_packets = 0;
+    while (result == FSO_SUCCESS) {
+        SimStreamTable table;
+        size_t rows;
+        result = sim_stream_reader_next(&reader, &table, packets, points, &rows);
+        if (result != FSO_SUCCESS || rows == 0) {
+            break;
+        }
+        if (table == SIM_STREAM_POINTS) {
+            for (size_t i = 0; i < rows && points_fp != NULL; i++) {
+                sim_csv_write_point(points_fp, &points[i], tracking);
+            }
+            num_points += rows;
+        } else {
+            for (size_t i = 0; i < rows && packets_fp != NULL; i++) {
+                sim_csv_write_packet(packets_fp, &packets[i], importance_sampling, amc, harq);
+            }
+            num_packets += rows;
+        }
+    }
+    
+    if (points_fp != NULL && sim_csv_close(points_fp, points_csv) != FSO_SUCCESS) {
+        result = FSO_ERROR_IO;
+    }
+    if (packets_fp != NULL && sim_csv_close(packets_fp, packets_csv) != FSO_SUCCESS) {
+        result = FSO_ERROR_IO;
+    }
+    sim_stream_reader_close(&reader);
+    free(packets);
+    free(points);
+    
+    if (result == FSO_SUCCESS) {
+        FSO_LOG_INFO("SimResults", "Converted %s: %zu time-series points, %zu packets",
+                     stream_file, num_points, num_packets);
+    }
+    return result;
 }
@@ -91,6 +91,7 @@ static void configure_high_turbulence_scenario(SimConfig* config) {
     config->environment.temperature = 35.0;  // Hot day
     config->environment.humidity = 0.3;
     config->environment.correlation_time = 0.0005;  // Fast fading
+    config->environment.fading_model = CHANNEL_FADING_GAMMA_GAMMA;  // Log-normal is invalid here
     
     config->link.link_distance = 1500.0;
     config->link.transmit_power = 0.002;  // 2 mW
@@ -246,19 +247,12 @@ const char* sim_get_scenario_description(const char* scenario_name) {
  * Batch Simulation
  * ============================================================================ */
 
-/**
- * @brief Batch simulation results
- */
-typedef struct {
-    char scenario_name[64];
-    SimResults results;
-    int success;
-} BatchResult;
-
 /**
  * @brief Run batch simulation across multiple scenarios
  * 
- * Runs simulations for all specified scenarios and collects results.
+ * Runs all specified scenarios concurrently through sim_run_configs(),
+ * then prints each configuration and its results and exports its CSVs
+ * in scenario order.
  * 
  * @param scenario_names Array of scenario names to run
  * @param num_scenarios Number of scenarios
@@ -274,44 +268,60 @@ int sim_run_batch(const char** scenario_names, int num_scenarios,
         return 0;
     }
     
-    int successful = 0;
-    
     FSO_LOG_INFO("Scenarios", "Starting batch simulation: %d scenarios", num_scenarios);
     
+    SimConfig* configs = (SimConfig*)malloc(num_scenarios * sizeof(SimConfig));
+    SimResults* results = (SimResults*)calloc(num_scenarios, sizeof(SimResults));
+    int* status = (int*)malloc(num_scenarios * sizeof(int));
+    int* config_index = (int*)malloc(num_scenarios * sizeof(int));
+    if (configs == NULL || results == NULL || status == NULL || config_index == NULL) {
+        FSO_LOG_ERROR("Scenarios", "Failed to allocate batch buffers");
+        free(configs); free(results); free(status); free(config_index);
+        return 0;
+    }
+    
+    // Load every scenario; only the ones that load are run
+    int num_configs = 0;
     for (int i = 0; i < num_scenarios; i++) {
-        const char* scenario_name = scenario_names[i];
         BatchResult* batch_result = &batch_results[i];
         
         // Copy scenario name
-        strncpy(batch_result->scenario_name, scenario_name, 
+        strncpy(batch_result->scenario_name, scenario_names[i], 
                 sizeof(batch_result->scenario_name) - 1);
         batch_result->scenario_name[sizeof(batch_result->scenario_name) - 1] = '\0';
+        batch_result->success = 0;
+        config_index[i] = -1;
+        
+        if (sim_load_scenario(&configs[num_configs], scenario_names[i]) != FSO_SUCCESS) {
+            FSO_LOG_ERROR("Scenarios", "Failed to load scenario: %s", scenario_names[i]);
+            continue;
+        }
+        config_index[i] = num_configs++;
+    }
+    
+    int successful = 0;
+    if (num_configs > 0) {
+        sim_run_configs(configs, num_configs, 0, results, status);
+    }
+    
+    for (int i = 0; i < num_scenarios; i++) {
+        const char* scenario_name = scenario_names[i];
+        BatchResult* batch_result = &batch_results[i];
+        int c = config_index[i];
+        if (c < 0) {
+            continue;
+        }
         
         printf("\n");
         printf("========================================\n");
-        printf("Running scenario: %s\n", scenario_name);
+        printf("Scenario: %s\n", scenario_name);
         printf("========================================\n");
         
-        // Load scenario configuration
-        SimConfig config;
-        int result = sim_load_scenario(&config, scenario_name);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR("Scenarios", "Failed to load scenario: %s", scenario_name);
-            batch_result->success = 0;
-            continue;
-        }
-        
         // Print configuration
-        sim_config_print(&config);
+        sim_config_print(&configs[c]);
         
-        // Run simulation
-        if (config.system.enable_tracking) {
-            result = sim_run_with_tracking(&config, &batch_result->results);
-        } else {
-            result = sim_run(&config, &batch_result->results);
-        }
-        
-        if (result == FSO_SUCCESS) {
+        if (status[c] == FSO_SUCCESS) {
+            batch_result->results = results[c];
             batch_result->success = 1;
             successful++;
             
@@ -330,10 +340,14 @@ int sim_run_batch(const char** scenario_names, int num_scenarios,
             
         } else {
             FSO_LOG_ERROR("Scenarios", "Simulation failed for scenario: %s", scenario_name);
-            batch_result->success = 0;
         }
     }
     
+    free(configs);
+    free(results);
+    free(status);
+    free(config_index);
+    
     printf("\n");
     printf("========================================\n");
     printf("Batch Simulation Complete\n");
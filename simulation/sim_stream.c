@@ -0,0 +1,471 @@
+/**
+ * @file sim_stream.c
+ * @brief Streaming columnar results files
+ *
+ * Layout (host byte order):
+ *
+ *   header:  "FSORES01", u32 byte-order mark 0x01020304, u32 flags,
+ *            u32 chunk_rows, u32 table count, then per table
+ *            u32 table id, u32 column count, and per column
+ *            char name[24], u32 type (0 = int32, 1 = float64)
+ *   chunk:   u32 table id, u32 rows, then each column's rows contiguously
+ *   end:     "FSOREND1", u32 table count, u32 0, u64 rows per table
+ *
+ * Chunks of the two tables interleave in the order they fill. A file cut
+ * short by a crash still reads up to its last complete chunk, and a
+ * checkpointed run truncates back to its last sync point on resume.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MODULE_NAME "SimStream"
+
+#define SIM_STREAM_MAGIC "FSORES01"
+#define SIM_STREAM_END_MAGIC "FSOREND1"
+#define SIM_STREAM_BYTE_ORDER 0x01020304u
+#define SIM_STREAM_NAME_LEN 24
+#define SIM_STREAM_IO_BUFFER (1 << 20)
+
+/* ============================================================================
+ * Schema
+ * ============================================================================ */
+
+typedef enum {
+    SIM_COLUMN_INT32 = 0,
+    SIM_COLUMN_FLOAT64 = 1
+} SimColumnType;
+
+/**
+ * @brief One column: a struct field written as a contiguous array
+ */
+typedef struct {
+    const char* name;
+    SimColumnType type;
+    size_t offset;
+} SimStreamColumn;
+
+static const SimStreamColumn sim_packet_columns[] = {
+    { "packet_id",            SIM_COLUMN_INT32,   offsetof(PacketStats, packet_id) },
+    { "bits_transmitted",     SIM_COLUMN_INT32,   offsetof(PacketStats, bits_transmitted) },
+    { "bits_received",        SIM_COLUMN_INT32,   offsetof(PacketStats, bits_received) },
+    { "bit_errors",           SIM_COLUMN_INT32,   offsetof(PacketStats, bit_errors) },
+    { "ber",                  SIM_COLUMN_FLOAT64, offsetof(PacketStats, ber) },
+    { "snr_db",               SIM_COLUMN_FLOAT64, offsetof(PacketStats, snr_db) },
+    { "received_power",       SIM_COLUMN_FLOAT64, offsetof(PacketStats, received_power) },
+    { "fec_corrected_errors", SIM_COLUMN_INT32,   offsetof(PacketStats, fec_corrected_errors) },
+    { "fec_uncorrectable",    SIM_COLUMN_INT32,   offsetof(PacketStats, fec_uncorrectable) },
+    { "fec_iterations",       SIM_COLUMN_INT32,   offsetof(PacketStats, fec_iterations) },
+    { "log_weight",           SIM_COLUMN_FLOAT64, offsetof(PacketStats, log_weight) },
+    { "airtime",              SIM_COLUMN_FLOAT64, offsetof(PacketStats, airtime) },
+    { "amc_mode",             SIM_COLUMN_INT32,   offsetof(PacketStats, amc_mode) },
+    { "amc_snr_db",           SIM_COLUMN_FLOAT64, offsetof(PacketStats, amc_snr_db) },
+    { "harq_transmissions",   SIM_COLUMN_INT32,   offsetof(PacketStats, harq_transmissions) },
+    { "latency",              SIM_COLUMN_FLOAT64, offsetof(PacketStats, latency) }
+};
+
+static const SimStreamColumn sim_point_columns[] = {
+    { "timestamp",            SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, timestamp) },
+    { "ber",                  SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, ber) },
+    { "snr_db",               SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, snr_db) },
+    { "received_power",       SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, received_power) },
+    { "throughput",           SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, throughput) },
+    { "beam_azimuth",         SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, beam_azimuth) },
+    { "beam_elevation",       SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, beam_elevation) },
+    { "signal_strength",      SIM_COLUMN_FLOAT64, offsetof(TimeSeriesPoint, signal_strength) }
+};
+
+/**
+ * @brief Column list, count and row stride of a table
+ */
+static const SimStreamColumn* sim_stream_schema(SimStreamTable table, size_t* num_columns,
+                                                size_t* stride) {
+    if (table == SIM_STREAM_PACKETS) {
+        *num_columns = sizeof(sim_packet_columns) / sizeof(sim_packet_columns[0]);
+        *stride = sizeof(PacketStats);
+        return sim_packet_columns;
+    }
+    *num_columns = sizeof(sim_point_columns) / sizeof(sim_point_columns[0]);
+    *stride = sizeof(TimeSeriesPoint);
+    return sim_point_columns;
+}
+
+_Static_assert(sizeof(int) == sizeof(int32_t), "int32 columns are copied from int fields");
+
+static size_t sim_column_size(SimColumnType type) {
+    return (type == SIM_COLUMN_INT32) ? sizeof(int32_t) : sizeof(double);
+}
+
+/* ============================================================================
+ * Writer
+ * ============================================================================ */
+
+static void sim_stream_put(SimStreamWriter* writer, const void* data, size_t size) {
+    if (writer->error == FSO_SUCCESS && fwrite(data, 1, size, writer->fp) != size) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to write results stream");
+        writer->error = FSO_ERROR_IO;
+    }
+}
+
+static void sim_stream_put_u32(SimStreamWriter* writer, uint32_t value) {
+    sim_stream_put(writer, &value, sizeof(value));
+}
+
+/**
+ * @brief Write the buffered rows of a table as one chunk
+ */
+static void sim_stream_flush_table(SimStreamWriter* writer, SimStreamTable table) {
+    size_t rows = writer->buffered[table];
+    if (rows == 0) {
+        return;
+    }
+    
+    size_t num_columns, stride;
+    const SimStreamColumn* columns = sim_stream_schema(table, &num_columns, &stride);
+    const unsigned char* base = (table == SIM_STREAM_PACKETS) ?
+                                (const unsigned char*)writer->packets :
+                                (const unsigned char*)writer->points;
+    
+    sim_stream_put_u32(writer, (uint32_t)table);
+    sim_stream_put_u32(writer, (uint32_t)rows);
+    for (size_t c = 0; c < num_columns; c++) {
+        size_t size = sim_column_size(columns[c].type);
+        for (size_t r = 0; r < rows; r++) {
+            memcpy(writer->column + r * size, base + r * stride + columns[c].offset, size);
+        }
+        sim_stream_put(writer, writer->column, rows * size);
+    }
+    
+    writer->total_rows[table] += rows;
+    writer->buffered[table] = 0;
+}
+
+int sim_stream_writer_open(SimStreamWriter* writer, const char* filename, unsigned int flags) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(filename);
+    
+    memset(writer, 0, sizeof(SimStreamWriter));
+    writer->flags = flags;
+    writer->packets = (PacketStats*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(PacketStats));
+    writer->points = (TimeSeriesPoint*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(TimeSeriesPoint));
+    writer->column = (unsigned char*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(double));
+    if (writer->packets == NULL || writer->points == NULL || writer->column == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate stream buffers");
+        free(writer->packets); free(writer->points); free(writer->column);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    writer->fp = fopen(filename, "wb");
+    if (writer->fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open results stream: %s", filename);
+        free(writer->packets); free(writer->points); free(writer->column);
+        return FSO_ERROR_IO;
+    }
+    setvbuf(writer->fp, NULL, _IOFBF, SIM_STREAM_IO_BUFFER);
+    
+    // Header: layout first, so readers and external tools need no schema
+    sim_stream_put(writer, SIM_STREAM_MAGIC, 8);
+    sim_stream_put_u32(writer, SIM_STREAM_BYTE_ORDER);
+    sim_stream_put_u32(writer, flags);
+    sim_stream_put_u32(writer, SIM_STREAM_CHUNK_ROWS);
+    sim_stream_put_u32(writer, SIM_STREAM_TABLE_COUNT);
+    for (int t = 0; t < SIM_STREAM_TABLE_COUNT; t++) {
+        size_t num_columns, stride;
+        const SimStreamColumn* columns = sim_stream_schema((SimStreamTable)t, &num_columns, &stride);
+        sim_stream_put_u32(writer, (uint32_t)t);
+        sim_stream_put_u32(writer, (uint32_t)num_columns);
+        for (size_t c = 0; c < num_columns; c++) {
+            char name[SIM_STREAM_NAME_LEN] = {0};
+            strncpy(name, columns[c].name, SIM_STREAM_NAME_LEN - 1);
+            sim_stream_put(writer, name, SIM_STREAM_NAME_LEN);
+            sim_stream_put_u32(writer, (uint32_t)columns[c].type);
+        }
+    }
+    
+    if (writer->error != FSO_SUCCESS) {
+        return sim_stream_writer_close(writer);
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Streaming results to %s", filename);
+    return FSO_SUCCESS;
+}
+
+int sim_stream_write_packet(SimStreamWriter* writer, const PacketStats* stats) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(stats);
+    
+    writer->packets[writer->buffered[SIM_STREAM_PACKETS]++] = *stats;
+    if (writer->buffered[SIM_STREAM_PACKETS] == SIM_STREAM_CHUNK_ROWS) {
+        sim_stream_flush_table(writer, SIM_STREAM_PACKETS);
+    }
+    return writer->error;
+}
+
+int sim_stream_write_point(SimStreamWriter* writer, const TimeSeriesPoint* point) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(point);
+    
+    writer->points[writer->buffered[SIM_STREAM_POINTS]++] = *point;
+    if (writer->buffered[SIM_STREAM_POINTS] == SIM_STREAM_CHUNK_ROWS) {
+        sim_stream_flush_table(writer, SIM_STREAM_POINTS);
+    }
+    return writer->error;
+}
+
+int sim_stream_writer_close(SimStreamWriter* writer) {
+    FSO_CHECK_NULL(writer);
+    if (writer->fp == NULL) {
+        return writer->error;
+    }
+    
+    sim_stream_flush_table(writer, SIM_STREAM_PACKETS);
+    sim_stream_flush_table(writer, SIM_STREAM_POINTS);
+    
+    sim_stream_put(writer, SIM_STREAM_END_MAGIC, 8);
+    sim_stream_put_u32(writer, SIM_STREAM_TABLE_COUNT);
+    sim_stream_put_u32(writer, 0);
+    for (int t = 0; t < SIM_STREAM_TABLE_COUNT; t++) {
+        uint64_t rows = writer->total_rows[t];
+        sim_stream_put(writer, &rows, sizeof(rows));
+    }
+    
+    if (fclose(writer->fp) != 0 && writer->error == FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to close results stream");
+        writer->error = FSO_ERROR_IO;
+    }
+    writer->fp = NULL;
+    
+    free(writer->packets);
+    free(writer->points);
+    free(writer->column);
+    writer->packets = NULL;
+    writer->points = NULL;
+    writer->column = NULL;
+    
+    FSO_LOG_INFO(MODULE_NAME, "Results stream closed: %llu packets, %llu points",
+                 writer->total_rows[SIM_STREAM_PACKETS], writer->total_rows[SIM_STREAM_POINTS]);
+    return writer->error;
+}
+
+int sim_stream_writer_sync(SimStreamWriter* writer, long long* offset) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(writer->fp);
+    FSO_CHECK_NULL(offset);
+    
+    sim_stream_flush_table(writer, SIM_STREAM_PACKETS);
+    sim_stream_flush_table(writer, SIM_STREAM_POINTS);
+    if (writer->error == FSO_SUCCESS && fflush(writer->fp) != 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to flush results stream");
+        writer->error = FSO_ERROR_IO;
+    }
+    
+    *offset = (long long)ftell(writer->fp);
+    if (*offset < 0 && writer->error == FSO_SUCCESS) {
+        writer->error = FSO_ERROR_IO;
+    }
+    return writer->error;
+}
+
+int sim_stream_writer_reopen(SimStreamWriter* writer, const char* filename, unsigned int flags,
+                             long long offset, const unsigned long long* total_rows) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(filename);
+    FSO_CHECK_NULL(total_rows);
+    
+    memset(writer, 0, sizeof(SimStreamWriter));
+    writer->flags = flags;
+    writer->packets = (PacketStats*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(PacketStats));
+    writer->points = (TimeSeriesPoint*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(TimeSeriesPoint));
+    writer->column = (unsigned char*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(double));
+    if (writer->packets == NULL || writer->points == NULL || writer->column == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate stream buffers");
+        free(writer->packets); free(writer->points); free(writer->column);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    // Drop whatever the interrupted run wrote after the sync point
+    writer->fp = fopen(filename, "r+b");
+    int truncated = 0;
+    if (writer->fp != NULL) {
+        setvbuf(writer->fp, NULL, _IOFBF, SIM_STREAM_IO_BUFFER);
+#ifdef _WIN32
+        truncated = (_chsize_s(_fileno(writer->fp), offset) == 0);
+#else
+        truncated = (ftruncate(fileno(writer->fp), (off_t)offset) == 0);
+#endif
+    }
+    if (!truncated || fseek(writer->fp, (long)offset, SEEK_SET) != 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to reopen results stream: %s", filename);
+        if (writer->fp != NULL) {
+            fclose(writer->fp);
+        }
+        free(writer->packets); free(writer->points); free(writer->column);
+        return FSO_ERROR_IO;
+    }
+    
+    for (int t = 0; t < SIM_STREAM_TABLE_COUNT; t++) {
+        writer->total_rows[t] = total_rows[t];
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Resuming results stream %s at %llu packets", filename,
+                 writer->total_rows[SIM_STREAM_PACKETS]);
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Reader
+ * ============================================================================ */
+
+static int sim_stream_get(SimStreamReader* reader, void* data, size_t size) {
+    return fread(data, 1, size, reader->fp) == size;
+}
+
+int sim_stream_reader_open(SimStreamReader* reader, const char* filename) {
+    FSO_CHECK_NULL(reader);
+    FSO_CHECK_NULL(filename);
+    
+    memset(reader, 0, sizeof(SimStreamReader));
+    reader->fp = fopen(filename, "rb");
+    if (reader->fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open results stream: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    setvbuf(reader->fp, NULL, _IOFBF, SIM_STREAM_IO_BUFFER);
+    
+    char magic[8];
+    uint32_t byte_order, flags, chunk_rows, num_tables;
+    if (!sim_stream_get(reader, magic, 8) || memcmp(magic, SIM_STREAM_MAGIC, 8) != 0 ||
+        !sim_stream_get(reader, &byte_order, 4) || !sim_stream_get(reader, &flags, 4) ||
+        !sim_stream_get(reader, &chunk_rows, 4) || !sim_stream_get(reader, &num_tables, 4)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Not a results stream: %s", filename);
+        sim_stream_reader_close(reader);
+        return FSO_ERROR_IO;
+    }
+    
+    // This reader decodes its own layout; other tools follow the header
+    int supported = (byte_order == SIM_STREAM_BYTE_ORDER &&
+                     chunk_rows <= SIM_STREAM_CHUNK_ROWS &&
+                     num_tables == SIM_STREAM_TABLE_COUNT);
+    for (uint32_t t = 0; t < num_tables && supported; t++) {
+        size_t num_columns, stride;
+        const SimStreamColumn* columns = sim_stream_schema((SimStreamTable)t, &num_columns, &stride);
+        uint32_t table_id, file_columns;
+        if (!sim_stream_get(reader, &table_id, 4) || !sim_stream_get(reader, &file_columns, 4) ||
+            table_id != t || file_columns != num_columns) {
+            supported = 0;
+            break;
+        }
+        for (size_t c = 0; c < num_columns && supported; c++) {
+            char name[SIM_STREAM_NAME_LEN];
+            uint32_t type;
+            supported = sim_stream_get(reader, name, SIM_STREAM_NAME_LEN) &&
+                        sim_stream_get(reader, &type, 4) &&
+                        strncmp(name, columns[c].name, SIM_STREAM_NAME_LEN) == 0 &&
+                        type == (uint32_t)columns[c].type;
+        }
+    }
+    if (!supported) {
+        FSO_LOG_ERROR(MODULE_NAME, "Unsupported results stream layout: %s", filename);
+        sim_stream_reader_close(reader);
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    reader->column = (unsigned char*)malloc(SIM_STREAM_CHUNK_ROWS * sizeof(double));
+    if (reader->column == NULL) {
+        sim_stream_reader_close(reader);
+        return FSO_ERROR_MEMORY;
+    }
+    reader->flags = flags;
+    
+    return FSO_SUCCESS;
+}
+
+int sim_stream_reader_next(SimStreamReader* reader, SimStreamTable* table,
+                           PacketStats* packets, TimeSeriesPoint* points, size_t* rows) {
+    FSO_CHECK_NULL(reader);
+    FSO_CHECK_NULL(reader->fp);
+    FSO_CHECK_NULL(table);
+    FSO_CHECK_NULL(packets);
+    FSO_CHECK_NULL(points);
+    FSO_CHECK_NULL(rows);
+    
+    *rows = 0;
+    if (reader->complete) {
+        return FSO_SUCCESS;
+    }
+    
+    unsigned char record[8];
+    if (!sim_stream_get(reader, record, sizeof(record))) {
+        FSO_LOG_WARNING(MODULE_NAME, "Results stream ends without an end record (truncated run?)");
+        return FSO_SUCCESS;
+    }
+    
+    if (memcmp(record, SIM_STREAM_END_MAGIC, 8) == 0) {
+        uint32_t num_tables, reserved;
+        if (!sim_stream_get(reader, &num_tables, 4) || !sim_stream_get(reader, &reserved, 4) ||
+            num_tables != SIM_STREAM_TABLE_COUNT) {
+            return FSO_ERROR_IO;
+        }
+        for (int t = 0; t < SIM_STREAM_TABLE_COUNT; t++) {
+            uint64_t count;
+            if (!sim_stream_get(reader, &count, sizeof(count))) {
+                return FSO_ERROR_IO;
+            }
+            reader->total_rows[t] = count;
+        }
+        reader->complete = 1;
+        return FSO_SUCCESS;
+    }
+    
+    uint32_t table_id, count;
+    memcpy(&table_id, record, 4);
+    memcpy(&count, record + 4, 4);
+    if (table_id >= SIM_STREAM_TABLE_COUNT || count == 0 || count > SIM_STREAM_CHUNK_ROWS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Corrupt results stream chunk");
+        return FSO_ERROR_IO;
+    }
+    
+    size_t num_columns, stride;
+    const SimStreamColumn* columns = sim_stream_schema((SimStreamTable)table_id, &num_columns, &stride);
+    unsigned char* base = (table_id == SIM_STREAM_PACKETS) ?
+                          (unsigned char*)packets : (unsigned char*)points;
+    memset(base, 0, count * stride);
+    
+    for (size_t c = 0; c < num_columns; c++) {
+        size_t size = sim_column_size(columns[c].type);
+        if (!sim_stream_get(reader, reader->column, count * size)) {
+            FSO_LOG_WARNING(MODULE_NAME, "Results stream ends inside a chunk (truncated run?)");
+            return FSO_SUCCESS;
+        }
+        for (size_t r = 0; r < count; r++) {
+            memcpy(base + r * stride + columns[c].offset, reader->column + r * size, size);
+        }
+    }
+    
+    *table = (SimStreamTable)table_id;
+    *rows = count;
+    return FSO_SUCCESS;
+}
+
+void sim_stream_reader_close(SimStreamReader* reader) {
+    if (reader == NULL) {
+        return;
+    }
+    if (reader->fp != NULL) {
+        fclose(reader->fp);
+        reader->fp = NULL;
+    }
+    free(reader->column);
+    reader->column = NULL;
+}
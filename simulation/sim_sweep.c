@@ -0,0 +1,742 @@
+/**
+ * @file sim_sweep.c
+ * @brief Parameter sweeps over many configurations
+ *
+ * Configurations are scheduled as OpenMP tasks. Each configuration task
+ * generates its fade trace serially (the correlated fading chain is
+ * sequential in time), then splits its packets into fixed-size subtasks.
+ * Any idle thread picks up subtasks from any configuration in flight, so
+ * one long configuration spreads over all cores instead of finishing
+ * alone. Subtask results land in per-packet slots and are merged in
+ * packet order, so every configuration's results are identical to a
+ * sim_run() of it regardless of thread count or schedule. With a result
+ * cache directory set, each configuration is first looked up there (see
+ * sim_cache.c) and only missing or short entries are simulated.
+ */
+
+#include "simulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define MODULE_NAME "Sweep"
+
+/** Packets per subtask */
+#define SIM_SWEEP_CHUNK 256
+
+/* ============================================================================
+ * Grid Expansion
+ * ============================================================================ */
+
+int sim_sweep_expand(const SimConfig* base, const SimSweepGrid* grid,
+                     SimConfig** configs, int* num_configs) {
+    FSO_CHECK_NULL(base);
+    FSO_CHECK_NULL(grid);
+    FSO_CHECK_NULL(configs);
+    FSO_CHECK_NULL(num_configs);
+    FSO_CHECK_PARAM(grid->num_distances >= 0 && grid->num_weathers >= 0 &&
+                    grid->num_code_rates >= 0 && grid->num_modulations >= 0);
+    FSO_CHECK_PARAM(grid->num_distances == 0 || grid->distances != NULL);
+    FSO_CHECK_PARAM(grid->num_weathers == 0 || grid->weathers != NULL);
+    FSO_CHECK_PARAM(grid->num_code_rates == 0 || grid->code_rates != NULL);
+    FSO_CHECK_PARAM(grid->num_modulations == 0 || grid->modulations != NULL);
+    
+    *configs = NULL;
+    *num_configs = 0;
+    
+    // Empty axes keep the base value
+    int nd = FSO_MAX(grid->num_distances, 1);
+    int nw = FSO_MAX(grid->num_weathers, 1);
+    int nr = FSO_MAX(grid->num_code_rates, 1);
+    int nm = FSO_MAX(grid->num_modulations, 1);
+    size_t total = (size_t)nd * nw * nr * nm;
+    
+    SimConfig* out = (SimConfig*)malloc(total * sizeof(SimConfig));
+    if (out == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate %zu configurations", total);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    size_t k = 0;
+    for (int d = 0; d < nd; d++) {
+        for (int w = 0; w < nw; w++) {
+            for (int r = 0; r < nr; r++) {
+                for (int m = 0; m < nm; m++) {
+                    SimConfig* config = &out[k++];
+                    *config = *base;
+                    // One stream file cannot hold several runs
+                    config->control.results_stream[0] = '\0';
+                    if (grid->num_distances > 0) {
+                        config->link.link_distance = grid->distances[d];
+                    }
+                    if (grid->num_weathers > 0) {
+                        config->environment.weather = grid->weathers[w];
+                    }
+                    if (grid->num_code_rates > 0) {
+                        config->system.code_rate = grid->code_rates[r];
+                    }
+                    if (grid->num_modulations > 0) {
+                        config->system.modulation = grid->modulations[m];
+                    }
+                }
+            }
+        }
+    }
+    
+    *configs = out;
+    *num_configs = (int)total;
+    
+    FSO_LOG_INFO(MODULE_NAME, "Expanded sweep grid %dx%dx%dx%d into %d configurations",
+                 nd, nw, nr, nm, *num_configs);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Task Scheduling
+ * ============================================================================ */
+
+/**
+ * @brief State for one configuration in flight
+ */
+typedef struct {
+    const SimConfig* config;
+    ChannelModel channel;
+    uint64_t run_seed;
+    int first_packet;            /* Packet id of slot 0 in the arrays below */
+    double time_per_packet;
+    double* fades;
+    double* fade_profiles;
+    size_t profile_len;
+    double* fade_weights;
+    PacketStats* stats;
+    TimeSeriesPoint* points;
+    int* packet_status;
+    int chunk_error;
+} SimSweepJob;
+
+/**
+ * @brief Run packets [begin, end) of a configuration
+ *
+ * Owns its codec chain and packet buffers and only reads the channel.
+ */
+static void sim_sweep_run_chunk(SimSweepJob* job, int begin, int end) {
+    SimLink link;
+    SimPacket packet;
+    
+    int result = sim_link_init(&link, job->config);
+    if (result == FSO_SUCCESS) {
+        result = sim_packet_init(&packet, job->config);
+        if (result != FSO_SUCCESS) {
+            sim_link_free(&link);
+        }
+    }
+    if (result != FSO_SUCCESS) {
+#ifdef _OPENMP
+        #pragma omp atomic write
+#endif
+        job->chunk_error = result;
+        return;
+    }
+    
+    for (int i = begin; i < end; i++) {
+        int slot = i - job->first_packet;
+        sim_stage_transmit(&link, job->config, job->run_seed, i, &packet);
+        packet.fading = job->fades[slot];
+        packet.log_weight = job->fade_weights[slot];
+        if (packet.fade_blocks > 0) {
+            memcpy(packet.fade_profile, job->fade_profiles + (size_t)slot * job->profile_len,
+                   job->profile_len * sizeof(double));
+        }
+        sim_stage_channel(&job->channel, job->config, job->run_seed, &packet);
+        sim_stage_demodulate(&link, job->config, &packet);
+        sim_stage_decode(&link, job->config, &packet);
+        job->packet_status[slot] = sim_stage_collect(job->config, job->time_per_packet,
+                                                     &packet, &job->stats[slot],
+                                                     &job->points[slot]);
+    }
+    
+    sim_packet_free(&packet);
+    sim_link_free(&link);
+}
+
+static void sim_sweep_job_free(SimSweepJob* job) {
+    free(job->fades);
+    free(job->fade_profiles);
+    free(job->fade_weights);
+    free(job->stats);
+    free(job->points);
+    free(job->packet_status);
+}
+
+/**
+ * @brief Run one configuration, spawning packet subtasks
+ *
+ * Mirrors sim_run(): same validation, seeding, fade trace and merge order.
+ * Without keep_history only the aggregates (and a configured stream) are
+ * kept, which is all a sweep row needs.
+ */
+static int sim_sweep_run_config(const SimConfig* config, SimResults* results, int keep_history) {
+    int result = sim_config_validate(config);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Configuration validation failed");
+        return result;
+    }
+    
+    // Tracking, adaptive and HARQ runs keep their own loop (the controller
+    // decides each block from the blocks before it; retransmissions follow
+    // each packet's fade)
+    if (config->system.enable_tracking || config->system.amc.enabled ||
+        config->system.harq.enabled) {
+        SimConfig serial = *config;
+        serial.control.num_threads = 1;
+        return serial.system.enable_tracking ? sim_run_with_tracking(&serial, results) :
+                                               sim_run(&serial, results);
+    }
+    
+    int num_packets = config->control.num_packets;
+    SimSweepJob job;
+    memset(&job, 0, sizeof(job));
+    job.config = config;
+    job.run_seed = sim_run_seed(config);
+    job.time_per_packet = config->control.simulation_time / num_packets;
+    job.chunk_error = FSO_SUCCESS;
+    
+    result = sim_results_init_run(results, config, keep_history);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to initialize results");
+        return result;
+    }
+    
+    results->start_time = (double)clock() / CLOCKS_PER_SEC;
+    
+    result = sim_channel_init(&job.channel, config);
+    if (result != FSO_SUCCESS) {
+        sim_results_free(results);
+        return result;
+    }
+    
+    job.fades = (double*)malloc((size_t)num_packets * sizeof(double));
+    job.profile_len = sim_fade_profile_length(config);
+    if (job.profile_len > 0) {
+        job.fade_profiles = (double*)malloc((size_t)num_packets * job.profile_len * sizeof(double));
+    }
+    job.fade_weights = (double*)malloc((size_t)num_packets * sizeof(double));
+    job.stats = (PacketStats*)malloc((size_t)num_packets * sizeof(PacketStats));
+    job.points = (TimeSeriesPoint*)malloc((size_t)num_packets * sizeof(TimeSeriesPoint));
+    job.packet_status = (int*)malloc((size_t)num_packets * sizeof(int));
+    if (!job.fades || !job.fade_weights || !job.stats || !job.points || !job.packet_status ||
+        (job.profile_len > 0 && !job.fade_profiles)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate buffers");
+        sim_sweep_job_free(&job);
+        channel_free(&job.channel);
+        sim_results_free(results);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    // Under a stopping rule, run in rounds that double in size and stop at
+    // the first packet meeting a target, exactly as sim_run() does
+    results->confidence_level = config->control.confidence_level;
+    results->importance_sampling = config->control.importance_sampling;
+    int adaptive = (config->control.target_bit_errors > 0 ||
+                    config->control.target_relative_error > 0.0);
+    int round_size = adaptive ? SIM_SWEEP_CHUNK : num_packets;
+    int stopped = 0;
+    
+    for (int round_start = 0; round_start < num_packets && !stopped;
+         round_start += round_size, round_size *= 2) {
+        int round_end = FSO_MIN(round_start + round_size, num_packets);
+        
+        // Fade trace: the correlated fading chain is sequential in time
+        for (int i = round_start; i < round_end; i++) {
+            job.fades[i] = sim_stage_fade(&job.channel, config, job.run_seed, i,
+                                          job.time_per_packet,
+                                          job.fade_profiles ?
+                                          job.fade_profiles + (size_t)i * job.profile_len : NULL,
+                                          &job.fade_weights[i]);
+        }
+        
+        // Packet subtasks; the waiting thread runs them too
+        for (int begin = round_start; begin < round_end; begin += SIM_SWEEP_CHUNK) {
+            int end = FSO_MIN(begin + SIM_SWEEP_CHUNK, round_end);
+#ifdef _OPENMP
+            #pragma omp task default(none) firstprivate(begin, end) shared(job)
+#endif
+            sim_sweep_run_chunk(&job, begin, end);
+        }
+#ifdef _OPENMP
+        #pragma omp taskwait
+#endif
+        
+        if (job.chunk_error != FSO_SUCCESS) {
+            break;
+        }
+        
+        for (int i = round_start; i < round_end; i++) {
+            if (job.packet_status[i] == FSO_SUCCESS) {
+                sim_results_add_packet(results, &job.stats[i]);
+                sim_results_add_point(results, &job.points[i]);
+                if (adaptive && sim_results_check_stop(results, &config->control)) {
+                    stopped = 1;
+                    break;
+                }
+            }
+        }
+    }
+    
+    result = job.chunk_error;
+    if (result == FSO_SUCCESS) {
+        sim_results_calculate_metrics(results);
+        result = sim_results_finish_run(results);
+        
+        results->end_time = (double)clock() / CLOCKS_PER_SEC;
+        results->simulation_duration = results->end_time - results->start_time;
+    } else {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to initialize packet workers");
+    }
+    if (result != FSO_SUCCESS) {
+        sim_results_free(results);
+    }
+    
+    sim_sweep_job_free(&job);
+    channel_free(&job.channel);
+    
+    return result;
+}
+
+/**
+ * @brief Run packets [begin, end) of a configuration as subtasks
+ *
+ * Spawns its packet subtasks into the enclosing parallel region and
+ * waits for them.
+ */
+static int sim_sweep_run_range(const SimConfig* config, int begin, int end, SimResults* results) {
+    int result = sim_config_validate(config);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Configuration validation failed");
+        return result;
+    }
+    int num_packets = config->control.num_packets;
+    FSO_CHECK_PARAM(begin >= 0 && begin < end && end <= num_packets);
+
+    // The stop point, the tracking loop and the AMC mode depend on every
+    // earlier packet; retransmissions need sim_run()'s packet loop
+    if (config->system.enable_tracking || config->system.amc.enabled ||
+        config->system.harq.enabled ||
+        config->control.target_bit_errors > 0 || config->control.target_relative_error > 0.0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Packet ranges need a fixed budget, no tracking, AMC or HARQ");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+
+    int count = end - begin;
+    SimSweepJob job;
+    memset(&job, 0, sizeof(job));
+    job.config = config;
+    job.run_seed = sim_run_seed(config);
+    job.first_packet = begin;
+    job.time_per_packet = config->control.simulation_time / num_packets;
+    job.chunk_error = FSO_SUCCESS;
+
+    result = sim_results_init(results, 0, 0);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    results->start_time = (double)clock() / CLOCKS_PER_SEC;
+    results->confidence_level = config->control.confidence_level;
+    results->importance_sampling = config->control.importance_sampling;
+
+    result = sim_channel_init(&job.channel, config);
+    if (result != FSO_SUCCESS) {
+        sim_results_free(results);
+        return result;
+    }
+
+    job.fades = (double*)malloc((size_t)count * sizeof(double));
+    job.profile_len = sim_fade_profile_length(config);
+    if (job.profile_len > 0) {
+        job.fade_profiles = (double*)malloc((size_t)count * job.profile_len * sizeof(double));
+    }
+    job.fade_weights = (double*)malloc((size_t)count * sizeof(double));
+    job.stats = (PacketStats*)malloc((size_t)count * sizeof(PacketStats));
+    job.points = (TimeSeriesPoint*)malloc((size_t)count * sizeof(TimeSeriesPoint));
+    job.packet_status = (int*)malloc((size_t)count * sizeof(int));
+    if (!job.fades || !job.fade_weights || !job.stats || !job.points || !job.packet_status ||
+        (job.profile_len > 0 && !job.fade_profiles)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate buffers");
+        sim_sweep_job_free(&job);
+        channel_free(&job.channel);
+        sim_results_free(results);
+        return FSO_ERROR_MEMORY;
+    }
+
+    // Replay the fading chain up to begin (cheap next to decoding), so the
+    // range sees the same fades as a whole-run sim_run()
+    for (int i = 0; i < end; i++) {
+        int slot = FSO_MAX(i - begin, 0);
+        job.fades[slot] = sim_stage_fade(&job.channel, config, job.run_seed, i,
+                                         job.time_per_packet,
+                                         job.fade_profiles ?
+                                         job.fade_profiles + (size_t)slot * job.profile_len : NULL,
+                                         &job.fade_weights[slot]);
+    }
+
+    for (int chunk = begin; chunk < end; chunk += SIM_SWEEP_CHUNK) {
+        int chunk_end = FSO_MIN(chunk + SIM_SWEEP_CHUNK, end);
+#ifdef _OPENMP
+        #pragma omp task default(none) firstprivate(chunk, chunk_end) shared(job)
+#endif
+        sim_sweep_run_chunk(&job, chunk, chunk_end);
+    }
+#ifdef _OPENMP
+    #pragma omp taskwait
+#endif
+
+    result = job.chunk_error;
+    if (result == FSO_SUCCESS) {
+        for (int slot = 0; slot < count; slot++) {
+            if (job.packet_status[slot] == FSO_SUCCESS) {
+                sim_results_add_packet(results, &job.stats[slot]);
+                sim_results_add_point(results, &job.points[slot]);
+            }
+        }
+        sim_results_calculate_metrics(results);
+        results->end_time = (double)clock() / CLOCKS_PER_SEC;
+        results->simulation_duration = results->end_time - results->start_time;
+    } else {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to initialize packet workers");
+        sim_results_free(results);
+    }
+
+    sim_sweep_job_free(&job);
+    channel_free(&job.channel);
+
+    return result;
+}
+
+int sim_run_packet_range(const SimConfig* config, int begin, int end, SimResults* results) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(results);
+
+    int result = FSO_SUCCESS;
+#ifdef _OPENMP
+    int num_threads = (config->control.num_threads > 0) ?
+                      config->control.num_threads : omp_get_max_threads();
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#endif
+    result = sim_sweep_run_range(config, begin, end, results);
+
+    return result;
+}
+
+int sim_run_aggregates(const SimConfig* config, SimResults* results) {
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(results);
+
+    int result = FSO_SUCCESS;
+#ifdef _OPENMP
+    int num_threads = (config->control.num_threads > 0) ?
+                      config->control.num_threads : omp_get_max_threads();
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#endif
+    result = sim_sweep_run_config(config, results, 0);
+
+    return result;
+}
+
+/**
+ * @brief Run one configuration through the result cache
+ *
+ * Serves a cached entry, tops a smaller fixed-budget entry up with the
+ * missing packets, or runs the configuration; new results are stored.
+ * The seed is resolved first so a time-based entry can be topped up.
+ *
+ * @param cached Set to 1 on a hit, 2 after a top-up, 0 otherwise
+ */
+static int sim_sweep_run_cached(const SimConfig* config, SimResults* results, int keep_history,
+                                int* cached) {
+    uint64_t run_seed = 0;
+    int cached_packets = 0;
+    *cached = 0;
+    int result = sim_cache_load(config, keep_history, results, &run_seed, &cached_packets);
+    if (result == FSO_ERROR_UNSUPPORTED) {
+        return sim_sweep_run_config(config, results, keep_history);
+    }
+    int num_packets = config->control.num_packets;
+    if (result == FSO_SUCCESS && cached_packets == num_packets) {
+        *cached = 1;
+        return FSO_SUCCESS;
+    }
+    
+    SimConfig resolved = *config;
+    if (result == FSO_SUCCESS) {
+        resolved.control.random_seed = (unsigned int)run_seed;
+        
+        SimResults extra;
+        result = sim_sweep_run_range(&resolved, cached_packets, num_packets, &extra);
+        if (result == FSO_SUCCESS) {
+            result = sim_results_merge(results, &extra);
+            results->simulation_duration += extra.simulation_duration;
+            sim_results_free(&extra);
+        }
+        if (result != FSO_SUCCESS) {
+            sim_results_free(results);
+            return result;
+        }
+        sim_results_calculate_metrics(results);
+        *cached = 2;
+    } else {
+        resolved.control.random_seed = (unsigned int)sim_run_seed(config);
+        result = sim_sweep_run_config(&resolved, results, keep_history);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    // A failed store only costs a rerun next time
+    sim_cache_store(config, resolved.control.random_seed, results);
+    return FSO_SUCCESS;
+}
+
+void sim_sweep_fill_row(const SimConfig* config, int index, int status,
+                        const SimResults* results, SimSweepRow* row) {
+    memset(row, 0, sizeof(SimSweepRow));
+    row->config_index = index;
+    row->link_distance = config->link.link_distance;
+    row->weather = config->environment.weather;
+    row->code_rate = config->system.code_rate;
+    row->modulation = config->system.modulation;
+    row->status = status;
+    
+    if (status == FSO_SUCCESS) {
+        row->total_packets = results->total_packets;
+        row->packets_lost = results->packets_lost;
+        row->total_bits = results->total_bits;
+        row->total_bit_errors = results->total_bit_errors;
+        row->avg_ber = results->avg_ber;
+        row->avg_snr = results->avg_snr;
+        row->snr_p01 = results->snr_p01;
+        row->ber_p99 = results->ber_p99;
+        row->avg_throughput = results->avg_throughput;
+        row->packet_loss_rate = results->packet_loss_rate;
+        row->avg_fec_iterations = results->avg_fec_iterations;
+        row->ber_ci_half_width = results->ber_ci_half_width;
+        row->stop_reason = results->stop_reason;
+    }
+}
+
+/**
+ * @brief Schedule entry: configurations start largest first
+ */
+typedef struct {
+    int num_packets;
+    int index;
+} SimSweepOrder;
+
+static int sim_sweep_compare_order(const void* a, const void* b) {
+    const SimSweepOrder* oa = (const SimSweepOrder*)a;
+    const SimSweepOrder* ob = (const SimSweepOrder*)b;
+    if (oa->num_packets != ob->num_packets) {
+        return (oa->num_packets > ob->num_packets) ? -1 : 1;
+    }
+    return (oa->index > ob->index) - (oa->index < ob->index);
+}
+
+/**
+ * @brief Shared driver for sim_run_configs() and sim_run_sweep()
+ *
+ * With rows set, each configuration is summarized and its results freed
+ * as it completes; otherwise results are kept.
+ */
+static int sim_sweep_execute(const SimConfig* configs, int num_configs, int num_threads,
+                             SimResults* results, int* status, SimSweepRow* rows) {
+    if (configs == NULL || num_configs <= 0 || (results == NULL && rows == NULL)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Invalid parameters for sweep");
+        return 0;
+    }
+    
+    // Largest configurations first so the heavy runs start early
+    SimSweepOrder* order = (SimSweepOrder*)malloc((size_t)num_configs * sizeof(SimSweepOrder));
+    int* codes = (status != NULL) ? status : (int*)malloc((size_t)num_configs * sizeof(int));
+    if (order == NULL || codes == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate sweep schedule");
+        free(order);
+        if (codes != status) {
+            free(codes);
+        }
+        return 0;
+    }
+    for (int i = 0; i < num_configs; i++) {
+        order[i].num_packets = configs[i].control.num_packets;
+        order[i].index = i;
+    }
+    qsort(order, (size_t)num_configs, sizeof(SimSweepOrder), sim_sweep_compare_order);
+    
+#ifdef _OPENMP
+    if (num_threads <= 0) {
+        num_threads = omp_get_max_threads();
+    }
+#else
+    num_threads = 1;
+#endif
+    
+    FSO_LOG_INFO(MODULE_NAME, "Running %d configurations on %d thread(s)",
+                 num_configs, num_threads);
+    
+    int cache_hits = 0;
+    int cache_topups = 0;
+    
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#endif
+    for (int k = 0; k < num_configs; k++) {
+        int i = order[k].index;
+#ifdef _OPENMP
+        #pragma omp task default(none) firstprivate(i) \
+                         shared(configs, results, codes, rows, cache_hits, cache_topups)
+#endif
+        {
+            SimResults local;
+            SimResults* out = (results != NULL) ? &results[i] : &local;
+            int cached = 0;
+            codes[i] = sim_sweep_run_cached(&configs[i], out, results != NULL, &cached);
+            if (cached == 1) {
+#ifdef _OPENMP
+                #pragma omp atomic
+#endif
+                cache_hits++;
+            } else if (cached == 2) {
+#ifdef _OPENMP
+                #pragma omp atomic
+#endif
+                cache_topups++;
+            }
+            if (rows != NULL) {
+                sim_sweep_fill_row(&configs[i], i, codes[i], out, &rows[i]);
+                if (results == NULL && codes[i] == FSO_SUCCESS) {
+                    sim_results_free(out);
+                }
+            }
+        }
+    }
+    
+    int successful = 0;
+    for (int i = 0; i < num_configs; i++) {
+        if (codes[i] == FSO_SUCCESS) {
+            successful++;
+        }
+    }
+    
+    free(order);
+    if (codes != status) {
+        free(codes);
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Sweep completed: %d / %d configurations successful",
+                 successful, num_configs);
+    if (sim_cache_dir() != NULL) {
+        FSO_LOG_INFO(MODULE_NAME, "Result cache: %d hit(s), %d topped up, %d simulated",
+                     cache_hits, cache_topups, num_configs - cache_hits - cache_topups);
+    }
+    
+    return successful;
+}
+
+/* ============================================================================
+ * Public Interface
+ * ============================================================================ */
+
+int sim_run_configs(const SimConfig* configs, int num_configs, int num_threads,
+                    SimResults* results, int* status) {
+    if (results == NULL || status == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "NULL pointer in sim_run_configs");
+        return 0;
+    }
+    return sim_sweep_execute(configs, num_configs, num_threads, results, status, NULL);
+}
+
+int sim_run_sweep(const SimConfig* configs, int num_configs, int num_threads,
+                  SimSweepRow* rows) {
+    if (rows == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "NULL pointer in sim_run_sweep");
+        return 0;
+    }
+    return sim_sweep_execute(configs, num_configs, num_threads, NULL, NULL, rows);
+}
+
+/* ============================================================================
+ * Consolidated Table
+ * ============================================================================ */
+
+void sim_sweep_print_table(const SimSweepRow* rows, int num_rows) {
+    if (rows == NULL || num_rows <= 0) {
+        return;
+    }
+    
+    printf("\n");
+    printf("=== Sweep Results ===\n");
+    printf("\n");
+    printf("%5s %10s %-16s %6s %-5s %10s %10s %10s %10s\n",
+           "#", "Dist (m)", "Weather", "Rate", "Mod", "BER", "SNR (dB)", "PLR", "Status");
+    
+    for (int i = 0; i < num_rows; i++) {
+        const SimSweepRow* row = &rows[i];
+        if (row->status == FSO_SUCCESS) {
+            printf("%5d %10.1f %-16s %6.3f %-5s %10.3e %10.2f %10.3f %10s\n",
+                   row->config_index, row->link_distance,
+                   sim_weather_string(row->weather), row->code_rate,
+                   sim_modulation_string(row->modulation),
+                   row->avg_ber, row->avg_snr, row->packet_loss_rate, "SUCCESS");
+        } else {
+            printf("%5d %10.1f %-16s %6.3f %-5s %10s %10s %10s %10s\n",
+                   row->config_index, row->link_distance,
+                   sim_weather_string(row->weather), row->code_rate,
+                   sim_modulation_string(row->modulation),
+                   "-", "-", "-", "FAILED");
+        }
+    }
+    
+    printf("\n");
+}
+
+int sim_sweep_export_csv(const SimSweepRow* rows, int num_rows, const char* filename) {
+    FSO_CHECK_NULL(rows);
+    FSO_CHECK_NULL(filename);
+    FSO_CHECK_PARAM(num_rows >= 0);
+    
+    FILE* fp = fopen(filename, "w");
+    if (fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open file: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    
+    fprintf(fp, "config,distance,weather,code_rate,modulation,status,packets,packets_lost,"
+                "bits,bit_errors,ber,ber_ci,snr_db,throughput,packet_loss_rate,fec_iterations,"
+                "stop_reason,snr_p01_db,ber_p99\n");
+    
+    for (int i = 0; i < num_rows; i++) {
+        const SimSweepRow* row = &rows[i];
+        fprintf(fp, "%d,%.3f,%s,%.6f,%s,%d,%d,%d,%lld,%lld,%.6e,%.6e,%.4f,%.6e,%.6f,%.4f,%d,%.4f,%.6e\n",
+                row->config_index, row->link_distance,
+                sim_weather_string(row->weather), row->code_rate,
+                sim_modulation_string(row->modulation), row->status,
+                row->total_packets, row->packets_lost,
+                row->total_bits, row->total_bit_errors,
+                row->avg_ber, row->ber_ci_half_width, row->avg_snr, row->avg_throughput,
+                row->packet_loss_rate, row->avg_fec_iterations, (int)row->stop_reason,
+                row->snr_p01, row->ber_p99);
+    }
+    
+    fclose(fp);
+    
+    FSO_LOG_INFO(MODULE_NAME, "Exported %d sweep rows to %s", num_rows, filename);
+    
+    return FSO_SUCCESS;
+}
@@ -7,10 +7,17 @@
  */
 
 #include "simulator.h"
+#include "../src/turbulence/phase_screen.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+/* Phase screen for turbulence-induced beam wander */
+#define TRACKING_SCREEN_APERTURE_POINTS 8   // Grid points across the receive aperture
+#define TRACKING_SCREEN_MIN_SIZE 64
+#define TRACKING_SCREEN_MAX_SIZE 512        // Longer runs wrap around the frozen screen
+
 /* ============================================================================
  * Beam Tracking Simulation Context
  * ============================================================================ */
@@ -24,6 +31,15 @@ typedef struct {
     double current_misalignment_az;
     double current_misalignment_el;
     int reacquisition_count;
+    int signal_evaluations;        // Calls to tracking_signal_callback
+    double drift_az;               // Accumulated slow drift (rad)
+    double drift_el;
+    SignalProcessor* sp;           // Runs the phase screen FFTs
+    PhaseScreen* screen;           // Frozen-flow turbulence screen (NULL: random jitter)
+    double aperture;               // Receiver aperture diameter (m)
+    double wavelength;             // Optical wavelength (m)
+    uint64_t run_seed;             // Seeds the per-packet tracking streams
+    int updates;                   // Tracking steps taken
 } TrackingContext;
 
 /* ============================================================================
@@ -31,14 +47,9 @@ typedef struct {
  * ============================================================================ */
 
 /**
- * @brief Callback function to measure signal strength at beam position
- * 
- * This simulates measuring the received signal strength when the beam
- * is pointed at a specific azimuth and elevation angle.
+ * @brief Noiseless received signal strength with the beam at a position
  */
-static double tracking_signal_callback(double azimuth, double elevation, void* user_data) {
-    TrackingContext* ctx = (TrackingContext*)user_data;
-    
+static double tracking_beam_pattern(const TrackingContext* ctx, double azimuth, double elevation) {
     // Calculate angular error from optimal position
     double az_error = azimuth - ctx->initial_azimuth;
     double el_error = elevation - ctx->initial_elevation;
@@ -47,8 +58,20 @@ static double tracking_signal_callback(double azimuth, double elevation, void* u
     // Signal strength decreases with angular error (Gaussian beam pattern)
     // Assuming beam divergence of 1 mrad
     double beam_width = 0.001;  // 1 mrad
-    double signal_strength = exp(-2.0 * angular_error * angular_error / 
-                                 (beam_width * beam_width));
+    return exp(-2.0 * angular_error * angular_error / (beam_width * beam_width));
+}
+
+/**
+ * @brief Callback function to measure signal strength at beam position
+ * 
+ * This simulates measuring the received signal strength when the beam
+ * is pointed at a specific azimuth and elevation angle.
+ */
+static double tracking_signal_callback(double azimuth, double elevation, void* user_data) {
+    TrackingContext* ctx = (TrackingContext*)user_data;
+    ctx->signal_evaluations++;
+    
+    double signal_strength = tracking_beam_pattern(ctx, azimuth, elevation);
     
     // Add some noise
     signal_strength += fso_random_gaussian(0.0, 0.05);
@@ -57,10 +80,94 @@ static double tracking_signal_callback(double azimuth, double elevation, void* u
     return signal_strength;
 }
 
+/**
+ * @brief Batched measurement at tracker positions for scans and dithers
+ * 
+ * The beam lands at the commanded position plus the current misalignment.
+ * Positions are measured in order: the noise draws share the RNG state.
+ */
+static int tracking_signal_batch_callback(const double* azimuths, const double* elevations,
+                                          size_t count, double* strengths, void* user_data) {
+    TrackingContext* ctx = (TrackingContext*)user_data;
+    for (size_t i = 0; i < count; i++) {
+        strengths[i] = tracking_signal_callback(azimuths[i] + ctx->current_misalignment_az,
+                                                elevations[i] + ctx->current_misalignment_el,
+                                                user_data);
+    }
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Beam Tracking Simulation Functions
  * ============================================================================ */
 
+/**
+ * @brief Set up the phase screen that drives beam wander
+ * 
+ * r0 comes from the link's C_n², wavelength and distance. The screen flows
+ * at one Fresnel zone, sqrt(λL), per correlation time and is sized to cover
+ * the run, so each tracking step only samples the aperture.
+ * 
+ * @param config Simulation configuration
+ * @param ctx Tracking context
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+static int sim_tracking_init_screen(const SimConfig* config, TrackingContext* ctx) {
+    double cn2 = config->environment.turbulence_strength;
+    double correlation_time = config->environment.correlation_time;
+    ctx->aperture = config->link.receiver_aperture;
+    ctx->wavelength = config->link.wavelength;
+    
+    if (cn2 <= 0.0 || correlation_time <= 0.0 || ctx->aperture <= 0.0) {
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    double r0 = phase_screen_fried_parameter(cn2, ctx->wavelength, config->link.link_distance);
+    double spacing = ctx->aperture / TRACKING_SCREEN_APERTURE_POINTS;
+    double speed = sqrt(ctx->wavelength * config->link.link_distance) / correlation_time;
+    
+    double span = speed * config->control.simulation_time / spacing +
+                  2 * TRACKING_SCREEN_APERTURE_POINTS;
+    size_t size = TRACKING_SCREEN_MIN_SIZE;
+    while (size < span && size < TRACKING_SCREEN_MAX_SIZE) {
+        size *= 2;
+    }
+    
+    PhaseScreenParams params;
+    phase_screen_params_init(&params, size, spacing, r0);
+    params.wind_x = speed;
+    
+    ctx->sp = (SignalProcessor*)malloc(sizeof(SignalProcessor));
+    ctx->screen = (PhaseScreen*)malloc(sizeof(PhaseScreen));
+    if (ctx->sp == NULL || ctx->screen == NULL) {
+        free(ctx->sp);
+        free(ctx->screen);
+        ctx->sp = NULL;
+        ctx->screen = NULL;
+        return FSO_ERROR_MEMORY;
+    }
+    
+    int result = sp_init(ctx->sp, 0, size);
+    if (result == FSO_SUCCESS) {
+        result = phase_screen_init(ctx->screen, ctx->sp, &params, ctx->run_seed);
+        if (result != FSO_SUCCESS) {
+            sp_free(ctx->sp);
+        }
+    }
+    if (result != FSO_SUCCESS) {
+        free(ctx->sp);
+        free(ctx->screen);
+        ctx->sp = NULL;
+        ctx->screen = NULL;
+        return result;
+    }
+    
+    FSO_LOG_INFO("SimTracking", "Beam wander from %zux%zu phase screen: r0 %.3g m, %.3g m/s flow",
+                 size, size, r0, speed);
+    
+    return FSO_SUCCESS;
+}
+
 /**
  * @brief Initialize beam tracking for simulation
  * 
@@ -74,6 +181,7 @@ static int sim_tracking_init(const SimConfig* config, TrackingContext* ctx) {
     }
     
     memset(ctx, 0, sizeof(TrackingContext));
+    ctx->run_seed = sim_run_seed(config);
     
     // Initialize beam tracker
     ctx->tracker = (BeamTracker*)malloc(sizeof(BeamTracker));
@@ -109,10 +217,28 @@ static int sim_tracking_init(const SimConfig* config, TrackingContext* ctx) {
                              config->system.tracking_update_rate,
                              0.01); // Integral limit
     
+    // Predictive tracking: dither a fifth of the 1 mrad beam, a few times
+    // fewer measurements than a gradient step every update
+    BeamKalmanParams kalman;
+    beam_kalman_params_init(&kalman, config->system.tracking_update_rate, 0.0002);
+    kalman.beam_width = 0.001;
+    result = beam_track_configure_kalman(ctx->tracker, &kalman);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("SimTracking", "Failed to configure predictive tracking");
+        beam_track_free(ctx->tracker);
+        free(ctx->tracker);
+        return result;
+    }
+    
     // Set misalignment parameters based on turbulence
     ctx->misalignment_rate = config->environment.turbulence_strength * 1e10;  // Scale to rad/s
     ctx->misalignment_amplitude = 0.002;  // 2 mrad amplitude
     
+    // Turbulent beam wander; without a screen the random jitter stands in
+    if (sim_tracking_init_screen(config, ctx) != FSO_SUCCESS) {
+        FSO_LOG_DEBUG("SimTracking", "No phase screen, modeling beam wander as random jitter");
+    }
+    
     // Set signal threshold for misalignment detection
     beam_track_set_threshold(ctx->tracker, 0.3);  // 30% of peak signal
     
@@ -126,25 +252,40 @@ static int sim_tracking_init(const SimConfig* config, TrackingContext* ctx) {
  * @brief Update beam misalignment due to environmental disturbances
  * 
  * Simulates beam drift and random perturbations due to atmospheric turbulence,
- * platform vibrations, etc.
+ * platform vibrations, etc. With a phase screen, turbulence enters as the
+ * angle of arrival over the receive aperture while the frozen screen flows
+ * past; otherwise as a Gaussian random walk.
  * 
  * @param ctx Tracking context
  * @param time_step Time step in seconds
  */
 static void sim_tracking_update_misalignment(TrackingContext* ctx, double time_step) {
     // Add slow drift
-    ctx->current_misalignment_az += ctx->misalignment_rate * time_step;
-    ctx->current_misalignment_el += ctx->misalignment_rate * time_step * 0.7;
+    ctx->drift_az += ctx->misalignment_rate * time_step;
+    ctx->drift_el += ctx->misalignment_rate * time_step * 0.7;
+    
+    // Beam wander: angle of arrival as the frozen screen flows past
+    PhaseScreenAperture wavefront = {0};
+    int wander = 0;
+    if (ctx->screen != NULL) {
+        phase_screen_advance(ctx->screen, time_step);
+        wander = phase_screen_aperture(ctx->screen, 0.0, 0.0, ctx->aperture, ctx->wavelength,
+                                       &wavefront) == FSO_SUCCESS;
+    }
     
-    // Add random perturbations (high-frequency jitter)
-    ctx->current_misalignment_az += fso_random_gaussian(0.0, 
-        ctx->misalignment_amplitude * sqrt(time_step));
-    ctx->current_misalignment_el += fso_random_gaussian(0.0, 
-        ctx->misalignment_amplitude * sqrt(time_step));
+    if (!wander) {
+        // Add random perturbations (high-frequency jitter)
+        ctx->drift_az += fso_random_gaussian(0.0, 
+            ctx->misalignment_amplitude * sqrt(time_step));
+        ctx->drift_el += fso_random_gaussian(0.0, 
+            ctx->misalignment_amplitude * sqrt(time_step));
+    }
     
     // Clamp to reasonable range
-    ctx->current_misalignment_az = FSO_CLAMP(ctx->current_misalignment_az, -0.01, 0.01);
-    ctx->current_misalignment_el = FSO_CLAMP(ctx->current_misalignment_el, -0.01, 0.01);
+    ctx->drift_az = FSO_CLAMP(ctx->drift_az, -0.01, 0.01);
+    ctx->drift_el = FSO_CLAMP(ctx->drift_el, -0.01, 0.01);
+    ctx->current_misalignment_az = FSO_CLAMP(ctx->drift_az + wavefront.tilt_x, -0.01, 0.01);
+    ctx->current_misalignment_el = FSO_CLAMP(ctx->drift_el + wavefront.tilt_y, -0.01, 0.01);
 }
 
 /**
@@ -177,23 +318,35 @@ static int sim_tracking_update(TrackingContext* ctx, double time_step,
     if (is_misaligned && !ctx->tracker->reacquisition_mode) {
         FSO_LOG_WARNING("SimTracking", "Beam misalignment detected, initiating reacquisition");
         
-        // Perform reacquisition
-        int result = beam_track_reacquire(ctx->tracker,
-                                         0.02,  // ±10 mrad azimuth search
-                                         0.02,  // ±10 mrad elevation search
-                                         0.002, // 2 mrad resolution
-                                         tracking_signal_callback,
-                                         ctx);
+        // Perform reacquisition: a 1.5 mrad grid (fine enough not to step
+        // over the 1 mrad beam) refined once to 0.5 mrad
+        BeamScanParams scan;
+        beam_scan_params_init(&scan, BEAM_SCAN_HIERARCHICAL, 0.0005);
+        scan.coarse_resolution = 0.0015;
+        int result = beam_track_reacquire_batch(ctx->tracker,
+                                                0.02,  // ±10 mrad azimuth search
+                                                0.02,  // ±10 mrad elevation search
+                                                &scan,
+                                                tracking_signal_batch_callback,
+                                                ctx, NULL);
         
         if (result == FSO_SUCCESS) {
             ctx->reacquisition_count++;
+            
+            // Restart the predictor from the reacquired position
+            beam_track_configure_kalman(ctx->tracker, &ctx->tracker->kalman->params);
             FSO_LOG_INFO("SimTracking", "Beam reacquisition successful");
         } else {
             FSO_LOG_ERROR("SimTracking", "Beam reacquisition failed");
         }
     } else {
-        // Normal tracking update using gradient descent
-        beam_track_update(ctx->tracker, *signal_strength);
+        // Normal tracking update: follow the predicted sway, dithering
+        // only every few steps
+        int result = beam_track_kalman_update(ctx->tracker, tracking_signal_batch_callback,
+                                              ctx, NULL);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
     }
     
     return FSO_SUCCESS;
@@ -214,6 +367,30 @@ static double sim_tracking_calculate_gain(double signal_strength) {
     return FSO_MAX(signal_strength, min_gain);
 }
 
+/**
+ * @brief Pointing step for sim_run_pointed(): one tracking update per packet
+ * 
+ * Measurements and jitter draw from the packet's tracking stream, so the
+ * run stays reproducible. The gain is the noiseless beam pattern where the
+ * beam lands after the update.
+ */
+static double sim_tracking_pointing(void* context, int packet_id, double time_step,
+                                    double* azimuth, double* elevation) {
+    TrackingContext* ctx = (TrackingContext*)context;
+    fso_random_select_stream(ctx->run_seed, (uint32_t)packet_id, FSO_RNG_STREAM_TRACKING);
+    
+    double measured;
+    if (sim_tracking_update(ctx, time_step, &measured) == FSO_SUCCESS) {
+        ctx->updates++;
+    }
+    
+    *azimuth = ctx->tracker->azimuth;
+    *elevation = ctx->tracker->elevation;
+    return sim_tracking_calculate_gain(
+        tracking_beam_pattern(ctx, ctx->tracker->azimuth + ctx->current_misalignment_az,
+                              ctx->tracker->elevation + ctx->current_misalignment_el));
+}
+
 /**
  * @brief Free beam tracking resources
  * 
@@ -229,6 +406,18 @@ static void sim_tracking_free(TrackingContext* ctx) {
         free(ctx->tracker);
         ctx->tracker = NULL;
     }
+    
+    if (ctx->screen != NULL) {
+        phase_screen_free(ctx->screen);
+        free(ctx->screen);
+        ctx->screen = NULL;
+    }
+    
+    if (ctx->sp != NULL) {
+        sp_free(ctx->sp);
+        free(ctx->sp);
+        ctx->sp = NULL;
+    }
 }
 
 /* ============================================================================
@@ -265,17 +454,14 @@ int sim_run_with_tracking(const SimConfig* config, SimResults* results) {
         return result;
     }
     
-    // Run simulation with tracking (simplified version - full implementation
-    // would integrate with the complete sim_run loop)
-    results->tracking_enabled = 1;
-    
-    // For now, call standard simulation and add tracking metrics
-    result = sim_run(config, results);
+    // The tracking loop steps once per packet and its pointing loss
+    // scales each packet's fade
+    result = sim_run_pointed(config, results, sim_tracking_pointing, &tracking_ctx);
     
     if (result == FSO_SUCCESS) {
         // Add tracking-specific metrics
         results->reacquisitions = tracking_ctx.reacquisition_count;
-        results->tracking_updates = config->control.num_packets;
+        results->tracking_updates = tracking_ctx.updates;
         
         FSO_LOG_INFO("Simulator", "Tracking simulation completed: %d reacquisitions",
                      tracking_ctx.reacquisition_count);
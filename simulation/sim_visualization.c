@@ -377,19 +377,30 @@ int sim_generate_all_visualizations(const SimConfig* config,
     char filename[256];
     int result;
     
-    // Export CSV files
-    snprintf(filename, sizeof(filename), "%s_timeseries.csv", base_filename);
-    result = sim_results_export_csv(results, filename);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR("Visualization", "Failed to export time-series CSV");
-        return result;
-    }
-    
-    snprintf(filename, sizeof(filename), "%s_packets.csv", base_filename);
-    result = sim_results_export_packets_csv(results, filename);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR("Visualization", "Failed to export packets CSV");
-        return result;
+    // Export CSV files; streamed runs convert their results file
+    if (config->control.results_stream[0] != '\0') {
+        char packets_file[256];
+        snprintf(filename, sizeof(filename), "%s_timeseries.csv", base_filename);
+        snprintf(packets_file, sizeof(packets_file), "%s_packets.csv", base_filename);
+        result = sim_stream_export_csv(config->control.results_stream, filename, packets_file);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR("Visualization", "Failed to convert results stream to CSV");
+            return result;
+        }
+    } else {
+        snprintf(filename, sizeof(filename), "%s_timeseries.csv", base_filename);
+        result = sim_results_export_csv(results, filename);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR("Visualization", "Failed to export time-series CSV");
+            return result;
+        }
+        
+        snprintf(filename, sizeof(filename), "%s_packets.csv", base_filename);
+        result = sim_results_export_packets_csv(results, filename);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR("Visualization", "Failed to export packets CSV");
+            return result;
+        }
     }
     
     // Generate gnuplot scripts
@@ -21,35 +21,61 @@
  * @brief Generate random data packet
  */
 static void generate_random_packet(uint8_t* data, size_t length) {
+    fso_random_bytes_fill(data, length);
+}
+
+/**
+ * @brief Received samples rx = tx * gain + noise
+ * 
+ * @param noise Precomputed AWGN samples
+ */
+static void apply_gain_awgn(const double* tx, const double* noise, double* rx,
+                            size_t length, double gain) {
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
     for (size_t i = 0; i < length; i++) {
-        data[i] = (uint8_t)fso_random_int(0, 255);
+        rx[i] = tx[i] * gain + noise[i];
     }
 }
 
 /**
- * @brief Count bit errors between two data buffers
+ * @brief Single-precision apply_gain_awgn()
  */
-static int count_bit_errors(const uint8_t* data1, const uint8_t* data2, size_t length) {
-    int errors = 0;
+static void apply_gain_awgn_f32(const float* tx, const float* noise, float* rx,
+                                size_t length, double gain) {
+    const float g = (float)gain;
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
     for (size_t i = 0; i < length; i++) {
-        uint8_t diff = data1[i] ^ data2[i];
-        // Count set bits in diff
-        while (diff) {
-            errors += diff & 1;
-            diff >>= 1;
-        }
+        rx[i] = tx[i] * g + noise[i];
     }
-    return errors;
 }
 
 /**
- * @brief Add AWGN to signal
+ * @brief Mean power of float symbols (double accumulator)
  */
-static void add_awgn(double* signal, size_t length, double noise_power) {
-    double noise_stddev = sqrt(noise_power);
+static double signal_power_f32(const float* symbols, size_t length) {
+    if (length == 0) {
+        return 0.0;
+    }
+    
+    double sum = 0.0;
+#ifdef _OPENMP
+    #pragma omp simd reduction(+:sum)
+#endif
     for (size_t i = 0; i < length; i++) {
-        signal[i] += fso_random_gaussian(0.0, noise_stddev);
+        sum += (double)symbols[i] * (double)symbols[i];
     }
+    return sum / (double)length;
+}
+
+/**
+ * @brief Whether the symbol buffers hold floats
+ */
+static inline int sim_single_symbols(const SimConfig* config) {
+    return config->system.precision != FSO_PRECISION_DOUBLE;
 }
 
 /**
@@ -86,81 +112,198 @@ static int calculate_buffer_sizes(const SimConfig* config,
     return FSO_SUCCESS;
 }
 
-/* ============================================================================
- * Main Simulation Function
- * ============================================================================ */
+/**
+ * @brief FEC codeword length for a configuration
+ */
+static int sim_code_length(const SimConfig* config) {
+    return (int)((double)config->control.packet_size / config->system.code_rate);
+}
 
 /**
- * @brief Run complete FSO link simulation
- * 
- * Implements the main simulation loop:
- * 1. Generate random data packets
- * 2. Apply FEC encoding
- * 3. Modulate data to optical symbols
- * 4. Apply channel effects (fading, attenuation, noise)
- * 5. Demodulate received signal
- * 6. Apply FEC decoding
- * 7. Compare with original data and collect metrics
- * 
- * @param config Simulation configuration
- * @param results Output results structure
- * @return FSO_SUCCESS on success, error code otherwise
+ * @brief Payload bits per payload byte
  * 
- * @note Requirement 6.1: Complete transmitter and receiver chain
- * @note Requirement 6.3: Channel propagation with atmospheric effects
+ * The LDPC codec takes one information bit per byte (its LSB); other
+ * codecs carry every bit.
  */
-int sim_run(const SimConfig* config, SimResults* results) {
-    if (config == NULL || results == NULL) {
-        FSO_LOG_ERROR("Simulator", "NULL pointer in sim_run");
-        return FSO_ERROR_INVALID_PARAM;
+static int sim_payload_bits_per_byte(const SimConfig* config) {
+    return (config->system.fec_type == FEC_LDPC) ? 1 : 8;
+}
+
+/**
+ * @brief Samples per modulation symbol (PPM slots, 1 otherwise)
+ */
+static size_t sim_samples_per_symbol(const SimConfig* config) {
+    return (config->system.modulation == MOD_PPM) ? (size_t)config->system.ppm_order : 1;
+}
+
+/**
+ * @brief Modulation symbols carrying one codeword
+ */
+static size_t sim_codeword_symbols(const SimConfig* config) {
+    size_t bits = (size_t)sim_code_length(config) * 8;
+    if (config->system.modulation != MOD_PPM) {
+        return bits;
     }
     
-    // Validate configuration
-    int result = sim_config_validate(config);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR("Simulator", "Configuration validation failed");
-        return result;
+    size_t bits_per_symbol = 0;
+    for (int order = config->system.ppm_order; order > 1; order >>= 1) {
+        bits_per_symbol++;
+    }
+    return (bits + bits_per_symbol - 1) / bits_per_symbol;
+}
+
+size_t sim_packet_samples(const SimConfig* config) {
+    return (config != NULL) ? sim_codeword_symbols(config) * sim_samples_per_symbol(config) : 0;
+}
+
+size_t sim_fade_profile_length(const SimConfig* config) {
+    if (config == NULL || !config->environment.intra_packet_fading ||
+        config->control.num_packets <= 0) {
+        return 0;
     }
     
-    FSO_LOG_INFO("Simulator", "Starting simulation with %d packets", 
-                 config->control.num_packets);
+    // Block fading when the fade is effectively constant over a packet
+    double packet_duration = config->control.simulation_time / config->control.num_packets;
+    if (config->environment.correlation_time >= SIM_BLOCK_FADING_RATIO * packet_duration) {
+        return 0;
+    }
     
-    // Initialize random number generator
-    if (config->control.random_seed == 0) {
-        fso_random_init((unsigned int)time(NULL));
-    } else {
-        fso_random_init(config->control.random_seed);
+    size_t block_symbols = (size_t)FSO_MAX(config->environment.fade_block_symbols, 1);
+    size_t blocks = (sim_codeword_symbols(config) + block_symbols - 1) / block_symbols;
+    return (blocks > 1) ? blocks : 0;
+}
+
+/**
+ * @brief Round a region size up to the workspace alignment
+ */
+static size_t sim_workspace_round(size_t bytes) {
+    return (bytes + FSO_WORKSPACE_ALIGN - 1) & ~(size_t)(FSO_WORKSPACE_ALIGN - 1);
+}
+
+/* ============================================================================
+ * Packet Workspace
+ * ============================================================================ */
+
+int sim_workspace_init(FSOPacketWorkspace* workspace, size_t capacity) {
+    FSO_CHECK_NULL(workspace);
+    FSO_CHECK_PARAM(capacity > 0);
+    
+    memset(workspace, 0, sizeof(FSOPacketWorkspace));
+    capacity = sim_workspace_round(capacity);
+    
+    workspace->base = (uint8_t*)aligned_alloc(FSO_WORKSPACE_ALIGN, capacity);
+    if (workspace->base == NULL) {
+        FSO_LOG_ERROR("Simulator", "Failed to allocate %zu-byte packet workspace", capacity);
+        return FSO_ERROR_MEMORY;
     }
+    workspace->capacity = capacity;
     
-    // Initialize results
-    result = sim_results_init(results, config->control.num_packets * 10, 
-                             config->control.num_packets);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR("Simulator", "Failed to initialize results");
-        return result;
+    return FSO_SUCCESS;
+}
+
+void* sim_workspace_take(FSOPacketWorkspace* workspace, size_t bytes) {
+    if (workspace == NULL || workspace->base == NULL) {
+        return NULL;
     }
     
-    results->start_time = (double)clock() / CLOCKS_PER_SEC;
+    size_t rounded = sim_workspace_round(bytes);
+    if (rounded > workspace->capacity - workspace->used) {
+        return NULL;
+    }
+    
+    void* region = workspace->base + workspace->used;
+    workspace->used += rounded;
+    return region;
+}
+
+void sim_workspace_free(FSOPacketWorkspace* workspace) {
+    if (workspace == NULL) {
+        return;
+    }
+    
+    free(workspace->base);
+    memset(workspace, 0, sizeof(FSOPacketWorkspace));
+}
+
+/** Regions carved from each packet workspace */
+#define SIM_PACKET_REGIONS 13
+
+/**
+ * @brief Region sizes of one packet, in sim_packet_init() carve order
+ */
+static void sim_packet_region_sizes(const SimConfig* config, size_t sizes[SIM_PACKET_REGIONS]) {
+    size_t max_symbols, max_encoded;
+    calculate_buffer_sizes(config, &max_symbols, &max_encoded);
+    
+    sizes[0] = config->control.packet_size;                  // tx_data
+    sizes[1] = max_encoded;                                  // encoded_data
+    size_t symbol_size = sim_single_symbols(config) ? sizeof(float) : sizeof(double);
+    sizes[2] = max_symbols * symbol_size;                    // tx_symbols
+    sizes[3] = max_symbols * symbol_size;                    // rx_symbols
+    sizes[4] = max_symbols * symbol_size;                    // noise_samples
+    sizes[5] = max_encoded;                                  // demod_data
+    sizes[6] = config->control.packet_size;                  // decoded_data
+    
+    // LLRs hold 8 per codeword byte, plus one PPM symbol of overhang
+    sizes[7] = config->system.soft_decision ? (max_encoded * 8 + 8) * sizeof(float) : 0;
+    
+    // One mark bit per position of an interleaver block
+    sizes[8] = config->system.use_interleaver ?
+        ((size_t)sim_code_length(config) * (size_t)config->system.interleaver_depth + 7) / 8 : 0;
+    
+    // Fade and amplitude gain per sub-block (intra-packet fading only)
+    sizes[9] = sim_fade_profile_length(config) * sizeof(double);
+    sizes[10] = sizes[9];
+    
+    // Combined codeword LLRs and the code bits of one transmission (HARQ only)
+    size_t harq_code = config->system.harq.enabled ? (size_t)sim_code_length(config) : 0;
+    sizes[11] = harq_code * 8 * sizeof(float);
+    sizes[12] = harq_code;
+}
+
+size_t sim_packet_workspace_size(const SimConfig* config) {
+    if (config == NULL) {
+        return 0;
+    }
+    
+    size_t sizes[SIM_PACKET_REGIONS];
+    sim_packet_region_sizes(config, sizes);
+    
+    size_t total = 0;
+    for (int i = 0; i < SIM_PACKET_REGIONS; i++) {
+        total += sim_workspace_round(sizes[i]);
+    }
+    return total;
+}
+
+/* ============================================================================
+ * Packet Stages
+ * ============================================================================ */
+
+int sim_link_init(SimLink* link, const SimConfig* config) {
+    FSO_CHECK_NULL(link);
+    FSO_CHECK_NULL(config);
+    
+    memset(link, 0, sizeof(SimLink));
     
     // Initialize modulator
-    Modulator modulator;
+    int result;
     if (config->system.modulation == MOD_PPM) {
-        result = modulator_init_ppm(&modulator, config->control.sample_rate, 
+        result = modulator_init_ppm(&link->modulator, config->control.sample_rate, 
                                    config->system.ppm_order);
     } else {
-        result = modulator_init(&modulator, config->system.modulation, 
+        result = modulator_init(&link->modulator, config->system.modulation, 
                                config->control.sample_rate);
     }
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR("Simulator", "Failed to initialize modulator");
-        sim_results_free(results);
         return result;
     }
+    link->has_modulator = 1;
     
     // Initialize FEC codec
-    FECCodec fec_codec;
     int data_len = config->control.packet_size;
-    int code_len = (int)((double)data_len / config->system.code_rate);
+    int code_len = sim_code_length(config);
     
     // For Reed-Solomon, use default configuration
     RSConfig rs_config = {
@@ -171,232 +314,1224 @@ int sim_run(const SimConfig* config, SimResults* results) {
         .fcr = 1
     };
     
-    result = fec_init(&fec_codec, config->system.fec_type, data_len, code_len, &rs_config);
+    // For LDPC, decode with the layered schedule and report iterations
+    LDPCConfig ldpc_config = {
+        .num_variable_nodes = code_len,
+        .num_check_nodes = code_len - data_len,
+        .max_iterations = 50,
+        .convergence_threshold = 0.001,
+        .parity_check_matrix = NULL,
+        .matrix_rows = code_len - data_len,
+        .matrix_cols = code_len,
+        .check_node_algorithm = LDPC_CHECK_SUM_PRODUCT,
+        .schedule = LDPC_SCHEDULE_LAYERED,
+        .llr_format = (config->system.precision == FSO_PRECISION_INT16) ? LDPC_LLR_INT16 :
+                      (config->system.precision == FSO_PRECISION_INT8) ? LDPC_LLR_INT8 :
+                      LDPC_LLR_FLOAT,
+        .matrix_seed = 1
+    };
+    
+    void* fec_config = (config->system.fec_type == FEC_LDPC) ?
+                       (void*)&ldpc_config : (void*)&rs_config;
+    
+    result = fec_init(&link->fec_codec, config->system.fec_type, data_len, code_len, fec_config);
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR("Simulator", "Failed to initialize FEC codec");
-        modulator_free(&modulator);
-        sim_results_free(results);
+        sim_link_free(link);
         return result;
     }
+    link->has_fec = 1;
     
     // Initialize interleaver if enabled
-    InterleaverConfig interleaver;
     if (config->system.use_interleaver) {
-        result = interleaver_init(&interleaver, code_len, config->system.interleaver_depth);
+        // Seeded from the run seed so every worker's link builds the same table
+        result = interleaver_init_permutation(&link->interleaver, config->system.interleaver_type,
+                                              code_len, config->system.interleaver_depth,
+                                              config->control.random_seed, 0);
         if (result != FSO_SUCCESS) {
             FSO_LOG_ERROR("Simulator", "Failed to initialize interleaver");
-            fec_free(&fec_codec);
-            modulator_free(&modulator);
-            sim_results_free(results);
+            sim_link_free(link);
             return result;
         }
+        link->has_interleaver = 1;
     }
     
-    // Initialize channel model
-    ChannelModel channel;
-    result = channel_init_extended(&channel, 
-                                   config->link.link_distance,
-                                   config->link.wavelength,
-                                   config->environment.weather,
-                                   config->environment.turbulence_strength,
-                                   config->environment.correlation_time);
+    return FSO_SUCCESS;
+}
+
+void sim_link_free(SimLink* link) {
+    if (link == NULL) {
+        return;
+    }
+    
+    if (link->has_interleaver) {
+        interleaver_free(&link->interleaver);
+    }
+    if (link->has_fec) {
+        fec_free(&link->fec_codec);
+    }
+    if (link->has_modulator) {
+        modulator_free(&link->modulator);
+    }
+    
+    memset(link, 0, sizeof(SimLink));
+}
+
+int sim_packet_init(SimPacket* packet, const SimConfig* config) {
+    FSO_CHECK_NULL(packet);
+    FSO_CHECK_NULL(config);
+    
+    memset(packet, 0, sizeof(SimPacket));
+    calculate_buffer_sizes(config, &packet->max_symbols, &packet->max_encoded);
+    
+    int result = sim_workspace_init(&packet->workspace, sim_packet_workspace_size(config));
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    // Carve the views; the workspace was sized for exactly these regions
+    size_t sizes[SIM_PACKET_REGIONS];
+    sim_packet_region_sizes(config, sizes);
+    FSOPacketWorkspace* ws = &packet->workspace;
+    
+    packet->tx_data = (uint8_t*)sim_workspace_take(ws, sizes[0]);
+    packet->encoded_data = (uint8_t*)sim_workspace_take(ws, sizes[1]);
+    if (sim_single_symbols(config)) {
+        packet->tx_symbols_f32 = (float*)sim_workspace_take(ws, sizes[2]);
+        packet->rx_symbols_f32 = (float*)sim_workspace_take(ws, sizes[3]);
+        packet->noise_samples_f32 = (float*)sim_workspace_take(ws, sizes[4]);
+    } else {
+        packet->tx_symbols = (double*)sim_workspace_take(ws, sizes[2]);
+        packet->rx_symbols = (double*)sim_workspace_take(ws, sizes[3]);
+        packet->noise_samples = (double*)sim_workspace_take(ws, sizes[4]);
+    }
+    packet->demod_data = (uint8_t*)sim_workspace_take(ws, sizes[5]);
+    packet->decoded_data = (uint8_t*)sim_workspace_take(ws, sizes[6]);
+    if (sizes[7] > 0) {
+        packet->llr = (float*)sim_workspace_take(ws, sizes[7]);
+    }
+    if (sizes[8] > 0) {
+        packet->interleave_marks = (uint8_t*)sim_workspace_take(ws, sizes[8]);
+    }
+    if (sizes[9] > 0) {
+        packet->fade_profile = (double*)sim_workspace_take(ws, sizes[9]);
+        packet->gain_profile = (double*)sim_workspace_take(ws, sizes[10]);
+        packet->fade_blocks = sim_fade_profile_length(config);
+        packet->fade_block_len = (size_t)FSO_MAX(config->environment.fade_block_symbols, 1) *
+                                 sim_samples_per_symbol(config);
+    }
+    if (sizes[11] > 0) {
+        packet->harq_llr = (float*)sim_workspace_take(ws, sizes[11]);
+        packet->harq_segment = (uint8_t*)sim_workspace_take(ws, sizes[12]);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+void sim_packet_free(SimPacket* packet) {
+    if (packet == NULL) {
+        return;
+    }
+    
+    sim_workspace_free(&packet->workspace);
+    
+    memset(packet, 0, sizeof(SimPacket));
+}
+
+int sim_channel_init(ChannelModel* channel, const SimConfig* config) {
+    FSO_CHECK_NULL(channel);
+    FSO_CHECK_NULL(config);
+    
+    int result = channel_init_extended(channel, 
+                                       config->link.link_distance,
+                                       config->link.wavelength,
+                                       config->environment.weather,
+                                       config->environment.turbulence_strength,
+                                       config->environment.correlation_time);
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR("Simulator", "Failed to initialize channel model");
-        if (config->system.use_interleaver) interleaver_free(&interleaver);
-        fec_free(&fec_codec);
-        modulator_free(&modulator);
-        sim_results_free(results);
         return result;
     }
     
     // Set additional channel parameters
-    channel_set_atmospheric_params(&channel, config->environment.temperature,
+    channel_set_atmospheric_params(channel, config->environment.temperature,
                                    config->environment.humidity);
-    channel_set_weather_params(&channel, config->environment.visibility,
+    channel_set_weather_params(channel, config->environment.visibility,
                               config->environment.rainfall_rate,
                               config->environment.snowfall_rate);
-    channel_set_beam_divergence(&channel, config->link.beam_divergence);
-    channel_update_calculations(&channel);
+    channel_set_beam_divergence(channel, config->link.beam_divergence);
+    channel_set_noise_power(channel, config->control.noise_floor);
     
-    // Calculate buffer sizes
-    size_t max_symbols, max_encoded;
-    calculate_buffer_sizes(config, &max_symbols, &max_encoded);
-    
-    // Allocate buffers
-    uint8_t* tx_data = (uint8_t*)malloc(config->control.packet_size);
-    uint8_t* encoded_data = (uint8_t*)malloc(max_encoded);
-    uint8_t* interleaved_data = (uint8_t*)malloc(max_encoded);
-    double* tx_symbols = (double*)malloc(max_symbols * sizeof(double));
-    double* rx_symbols = (double*)malloc(max_symbols * sizeof(double));
-    uint8_t* deinterleaved_data = (uint8_t*)malloc(max_encoded);
-    uint8_t* decoded_data = (uint8_t*)malloc(config->control.packet_size);
-    
-    if (!tx_data || !encoded_data || !interleaved_data || !tx_symbols || 
-        !rx_symbols || !deinterleaved_data || !decoded_data) {
-        FSO_LOG_ERROR("Simulator", "Failed to allocate buffers");
-        free(tx_data); free(encoded_data); free(interleaved_data);
-        free(tx_symbols); free(rx_symbols); free(deinterleaved_data); free(decoded_data);
-        channel_free(&channel);
-        if (config->system.use_interleaver) interleaver_free(&interleaver);
-        fec_free(&fec_codec);
-        modulator_free(&modulator);
-        sim_results_free(results);
-        return FSO_ERROR_MEMORY;
+    // The fading model builds its sampling table once, here
+    if (config->environment.fading_model == CHANNEL_FADING_MALAGA) {
+        channel_set_malaga_params(channel, config->environment.malaga_omega,
+                                  config->environment.malaga_rho);
+    }
+    result = channel_set_fading_model(channel, config->environment.fading_model);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Failed to set up the fading model");
+        channel_free(channel);
+        return result;
     }
     
-    // Main simulation loop
-    double time_per_packet = config->control.simulation_time / config->control.num_packets;
+    return FSO_SUCCESS;
+}
+
+uint64_t sim_run_seed(const SimConfig* config) {
+    return (config->control.random_seed == 0) ?
+           (uint64_t)time(NULL) : (uint64_t)config->control.random_seed;
+}
+
+double sim_stage_fade(ChannelModel* channel, const SimConfig* config, uint64_t run_seed,
+                      int packet_id, double time_per_packet, double* profile,
+                      double* log_weight) {
+    FSO_PROF_BEGIN(FSO_PROF_FADE);
+    fso_random_select_stream(run_seed, (uint32_t)packet_id, FSO_RNG_STREAM_CHANNEL);
     
-    for (int packet_id = 0; packet_id < config->control.num_packets; packet_id++) {
-        double current_time = packet_id * time_per_packet;
+    // Intra-packet fading: one trace sample per sub-block, spanning the packet
+    size_t blocks = sim_fade_profile_length(config);
+    if (blocks > 0 && profile != NULL && time_per_packet > 0.0) {
+        *log_weight = 0.0;
+        channel_generate_fade_trace(channel, time_per_packet / (double)blocks, blocks, profile);
         
-        if (config->control.verbose && (packet_id % 10 == 0)) {
-            printf("Processing packet %d/%d (%.1f%%)\n", 
-                   packet_id + 1, config->control.num_packets,
-                   100.0 * (packet_id + 1) / config->control.num_packets);
+        double sum = 0.0;
+        for (size_t k = 0; k < blocks; k++) {
+            sum += profile[k];
         }
+        FSO_PROF_END(FSO_PROF_FADE);
+        return sum / (double)blocks;
+    }
+    
+    double fading = (time_per_packet > 0.0) ?
+                    channel_generate_correlated_fading(channel, time_per_packet) :
+                    channel_generate_fading(channel);
+    
+    *log_weight = 0.0;
+    if (config->control.importance_sampling && config->control.is_fade_shift != 0.0) {
+        fading = channel_tilt_fade(channel, config->control.is_fade_shift, log_weight);
+    }
+    
+    FSO_PROF_END(FSO_PROF_FADE);
+    return fading;
+}
+
+/**
+ * @brief Generate, encode and interleave a packet's payload
+ * 
+ * @param encoded_len Output codeword length in bytes
+ */
+static int sim_stage_encode(SimLink* link, const SimConfig* config, uint64_t run_seed,
+                            int packet_id, SimPacket* packet, size_t* encoded_len) {
+    packet->packet_id = packet_id;
+    packet->status = FSO_SUCCESS;
+    packet->harq_round = 0;
+    packet->fec_stats = (FECStats){0};
+    
+    // Step 1: Generate random data packet
+    fso_random_select_stream(run_seed, (uint32_t)packet_id, FSO_RNG_STREAM_DATA);
+    generate_random_packet(packet->tx_data, config->control.packet_size);
+    if (config->system.fec_type == FEC_LDPC) {
+        for (int i = 0; i < config->control.packet_size; i++) {
+            packet->tx_data[i] &= 1;
+        }
+    }
+    
+    // Step 2: Apply FEC encoding
+    *encoded_len = packet->max_encoded;
+    FSO_PROF_BEGIN(FSO_PROF_ENCODE);
+    int result = fec_encode(&link->fec_codec, packet->tx_data, config->control.packet_size,
+                           packet->encoded_data, encoded_len);
+    FSO_PROF_END(FSO_PROF_ENCODE);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "FEC encoding failed for packet %d", packet_id);
+        packet->status = result;
+        return result;
+    }
+    
+    // Step 2b: Apply interleaving in place if enabled
+    if (config->system.use_interleaver) {
+        FSO_PROF_BEGIN(FSO_PROF_INTERLEAVE);
+        interleave_inplace(&link->interleaver, packet->encoded_data, *encoded_len,
+                           packet->interleave_marks);
+        FSO_PROF_END(FSO_PROF_INTERLEAVE);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Modulate bytes (the codeword, or one HARQ transmission of it)
+ */
+static int sim_stage_modulate(SimLink* link, const SimConfig* config, const uint8_t* data,
+                              size_t length, SimPacket* packet) {
+    // Step 3: Modulate data to optical symbols
+    FSO_PROF_BEGIN(FSO_PROF_MODULATE);
+    int result;
+    if (sim_single_symbols(config)) {
+        result = modulate_f32(&link->modulator, data, length,
+                              packet->tx_symbols_f32, &packet->symbol_len);
+    } else {
+        result = modulate(&link->modulator, data, length,
+                         packet->tx_symbols, &packet->symbol_len);
+    }
+    FSO_PROF_END(FSO_PROF_MODULATE);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Modulation failed for packet %d", packet->packet_id);
+        packet->status = result;
+        return result;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+int sim_stage_transmit(SimLink* link, const SimConfig* config, uint64_t run_seed,
+                       int packet_id, SimPacket* packet) {
+    size_t encoded_len;
+    int result = sim_stage_encode(link, config, run_seed, packet_id, packet, &encoded_len);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    return sim_stage_modulate(link, config, packet->encoded_data, encoded_len, packet);
+}
+
+/**
+ * @brief Sample range [begin, end) of fade sub-block k
+ * 
+ * The last sub-block runs to the end of the packet.
+ */
+static void sim_fade_block_range(const SimPacket* packet, size_t k, size_t* begin, size_t* end) {
+    *begin = FSO_MIN(k * packet->fade_block_len, packet->symbol_len);
+    *end = (k + 1 == packet->fade_blocks) ? packet->symbol_len :
+           FSO_MIN(*begin + packet->fade_block_len, packet->symbol_len);
+}
+
+int sim_stage_channel(const ChannelModel* channel, const SimConfig* config,
+                      uint64_t run_seed, SimPacket* packet) {
+    if (packet->status != FSO_SUCCESS) {
+        return packet->status;
+    }
+    
+    // Step 4: Apply channel effects
+    FSO_PROF_BEGIN(FSO_PROF_CHANNEL);
+    const int single = sim_single_symbols(config);
+    double signal_power = single ? signal_power_f32(packet->tx_symbols_f32, packet->symbol_len) :
+                                   fso_signal_power_real(packet->tx_symbols, packet->symbol_len);
+    double tx_power = config->link.transmit_power * signal_power;
+    
+    // Apply fading and attenuation; receiver noise draws share one stream
+    // per transmission
+    fso_random_select_stream(run_seed, (uint32_t)packet->packet_id,
+                             FSO_RNG_STREAM_ROUND(FSO_RNG_STREAM_NOISE, packet->harq_round));
+    packet->rx_power = channel_apply_fade(channel, tx_power, packet->fading,
+                                          config->control.noise_floor);
+    
+    // Scale received symbols and add AWGN in one pass, per sub-block when
+    // the fade varies within the packet
+    packet->channel_gain = sqrt(packet->rx_power / tx_power);
+    if (single) {
+        fso_random_gaussian_fill_f32(packet->noise_samples_f32, packet->symbol_len,
+                                     sqrt(config->control.noise_floor));
+    } else {
+        fso_random_gaussian_fill(packet->noise_samples, packet->symbol_len,
+                                 sqrt(config->control.noise_floor));
+    }
+    
+    if (packet->fade_blocks > 0) {
+        for (size_t k = 0; k < packet->fade_blocks; k++) {
+            packet->gain_profile[k] = packet->channel_gain *
+                                      sqrt(packet->fade_profile[k] / packet->fading);
+        }
+        for (size_t k = 0; k < packet->fade_blocks; k++) {
+            size_t begin, end;
+            sim_fade_block_range(packet, k, &begin, &end);
+            if (single) {
+                apply_gain_awgn_f32(packet->tx_symbols_f32 + begin,
+                                    packet->noise_samples_f32 + begin,
+                                    packet->rx_symbols_f32 + begin, end - begin,
+                                    packet->gain_profile[k]);
+            } else {
+                apply_gain_awgn(packet->tx_symbols + begin, packet->noise_samples + begin,
+                                packet->rx_symbols + begin, end - begin, packet->gain_profile[k]);
+            }
+        }
+    } else if (single) {
+        apply_gain_awgn_f32(packet->tx_symbols_f32, packet->noise_samples_f32,
+                            packet->rx_symbols_f32, packet->symbol_len, packet->channel_gain);
+    } else {
+        apply_gain_awgn(packet->tx_symbols, packet->noise_samples, packet->rx_symbols,
+                        packet->symbol_len, packet->channel_gain);
+    }
+    
+    // Importance sampling: move each noise sample's mean by δ toward the
+    // midpoint between the lowest and highest symbol levels. With z the unbiased draw, the sample
+    // n = z + δ has log-likelihood ratio -(δ² + 2zδ) / (2σ²)
+    if (config->control.importance_sampling && config->control.is_noise_shift != 0.0 &&
+        config->control.noise_floor > 0.0) {
+        double sigma = sqrt(config->control.noise_floor);
+        double delta = config->control.is_noise_shift * sigma;
+        double lowest = INFINITY, highest = -INFINITY;
+        for (size_t i = 0; i < packet->symbol_len; i++) {
+            double symbol = single ? packet->tx_symbols_f32[i] : packet->tx_symbols[i];
+            lowest = FSO_MIN(lowest, symbol);
+            highest = FSO_MAX(highest, symbol);
+        }
+        double midpoint = 0.5 * (lowest + highest);
         
-        // Step 1: Generate random data packet
-        generate_random_packet(tx_data, config->control.packet_size);
-        
-        // Step 2: Apply FEC encoding
-        size_t encoded_len;
-        FECStats fec_stats = {0};
-        result = fec_encode(&fec_codec, tx_data, config->control.packet_size,
-                           encoded_data, &encoded_len);
+        double cross = 0.0;
+        size_t shifted = 0;
+        for (size_t i = 0; i < packet->symbol_len; i++) {
+            double gain = (packet->fade_blocks > 0) ?
+                packet->gain_profile[FSO_MIN(i / packet->fade_block_len, packet->fade_blocks - 1)] :
+                packet->channel_gain;
+            double level = (single ? packet->tx_symbols_f32[i] : packet->tx_symbols[i]) * gain;
+            double d = (level > midpoint * gain) ? -delta : (level < midpoint * gain) ? delta : 0.0;
+            if (d == 0.0) {
+                continue;
+            }
+            if (single) {
+                packet->rx_symbols_f32[i] += (float)d;
+                cross += packet->noise_samples_f32[i] * d;
+            } else {
+                packet->rx_symbols[i] += d;
+                cross += packet->noise_samples[i] * d;
+            }
+            shifted++;
+        }
+        packet->log_weight -= ((double)shifted * delta * delta + 2.0 * cross) /
+                              (2.0 * config->control.noise_floor);
+    }
+    
+    // Calculate SNR
+    double snr_linear = packet->rx_power / config->control.noise_floor;
+    packet->snr_db = fso_linear_to_db(snr_linear);
+    
+    FSO_PROF_END(FSO_PROF_CHANNEL);
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Soft-decision demodulation: bit LLRs instead of bytes
+ * 
+ * The receiver knows the packet's amplitude gain (the fade estimate) and
+ * the noise floor, so symbol levels map straight to LLRs. Under
+ * intra-packet fading each sub-block is demodulated with its own gain;
+ * sub-blocks hold whole symbols, so the LLRs concatenate.
+ */
+static int sim_stage_demodulate_soft(SimLink* link, const SimConfig* config, SimPacket* packet) {
+    SoftDemodParams params = {
+        .amplitude = packet->channel_gain,
+        .noise_variance = config->control.noise_floor
+    };
+    
+    size_t llr_len = 0;
+    int result = FSO_SUCCESS;
+    FSO_PROF_BEGIN(FSO_PROF_DEMODULATE);
+    if (packet->fade_blocks > 0) {
+        for (size_t k = 0; k < packet->fade_blocks && result == FSO_SUCCESS; k++) {
+            size_t begin, end, block_llrs;
+            sim_fade_block_range(packet, k, &begin, &end);
+            if (end == begin) {
+                break;
+            }
+            params.amplitude = packet->gain_profile[k];
+            if (sim_single_symbols(config)) {
+                result = demodulate_soft_f32(&link->modulator, packet->rx_symbols_f32 + begin,
+                                             end - begin, &params, packet->llr + llr_len,
+                                             &block_llrs);
+            } else {
+                result = demodulate_soft(&link->modulator, packet->rx_symbols + begin,
+                                         end - begin, &params, packet->llr + llr_len,
+                                         &block_llrs);
+            }
+            llr_len += block_llrs;
+        }
+    } else if (sim_single_symbols(config)) {
+        result = demodulate_soft_f32(&link->modulator, packet->rx_symbols_f32, packet->symbol_len,
+                                     &params, packet->llr, &llr_len);
+    } else {
+        result = demodulate_soft(&link->modulator, packet->rx_symbols, packet->symbol_len,
+                                 &params, packet->llr, &llr_len);
+    }
+    FSO_PROF_END(FSO_PROF_DEMODULATE);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Soft demodulation failed for packet %d", packet->packet_id);
+        packet->status = result;
+        return result;
+    }
+    
+    // PPM may overhang the codeword by a partial symbol; whole bytes only
+    packet->fec_llr = packet->llr;
+    packet->fec_input_len = llr_len / 8;
+    
+    if (config->system.use_interleaver) {
+        FSO_PROF_BEGIN(FSO_PROF_DEINTERLEAVE);
+        deinterleave_llr_inplace(&link->interleaver, packet->llr, packet->fec_input_len,
+                                 packet->interleave_marks);
+        FSO_PROF_END(FSO_PROF_DEINTERLEAVE);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+int sim_stage_demodulate(SimLink* link, const SimConfig* config, SimPacket* packet) {
+    if (packet->status != FSO_SUCCESS) {
+        return packet->status;
+    }
+    
+    // Step 5: Demodulate received signal
+    if (config->system.soft_decision) {
+        return sim_stage_demodulate_soft(link, config, packet);
+    }
+    
+    size_t demod_len;
+    FSO_PROF_BEGIN(FSO_PROF_DEMODULATE);
+    int result = sim_single_symbols(config) ?
+        demodulate_f32(&link->modulator, packet->rx_symbols_f32, packet->symbol_len,
+                       packet->demod_data, &demod_len, packet->snr_db) :
+        demodulate(&link->modulator, packet->rx_symbols, packet->symbol_len,
+                   packet->demod_data, &demod_len, packet->snr_db);
+    FSO_PROF_END(FSO_PROF_DEMODULATE);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Demodulation failed for packet %d", packet->packet_id);
+        packet->status = result;
+        return result;
+    }
+    
+    // Step 5b: Apply deinterleaving in place if enabled
+    packet->fec_input = packet->demod_data;
+    packet->fec_input_len = demod_len;
+    
+    if (config->system.use_interleaver) {
+        FSO_PROF_BEGIN(FSO_PROF_DEINTERLEAVE);
+        deinterleave_inplace(&link->interleaver, packet->demod_data, demod_len,
+                             packet->interleave_marks);
+        FSO_PROF_END(FSO_PROF_DEINTERLEAVE);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+int sim_stage_decode(SimLink* link, const SimConfig* config, SimPacket* packet) {
+    if (packet->status != FSO_SUCCESS) {
+        return packet->status;
+    }
+    
+    // Step 6: Apply FEC decoding (failures are counted, not dropped)
+    packet->decoded_len = (size_t)config->control.packet_size;
+    FSO_PROF_BEGIN(FSO_PROF_DECODE);
+    if (config->system.soft_decision) {
+        fec_decode_soft(&link->fec_codec, packet->fec_llr, packet->fec_input_len * 8,
+                       packet->decoded_data, &packet->decoded_len, &packet->fec_stats);
+    } else {
+        fec_decode(&link->fec_codec, packet->fec_input, packet->fec_input_len,
+                  packet->decoded_data, &packet->decoded_len, &packet->fec_stats);
+    }
+    FSO_PROF_END(FSO_PROF_DECODE);
+    
+    return FSO_SUCCESS;
+}
+
+int sim_stage_collect(const SimConfig* config, double time_per_packet,
+                      const SimPacket* packet, PacketStats* stats,
+                      TimeSeriesPoint* point) {
+    if (packet->status != FSO_SUCCESS) {
+        return packet->status;
+    }
+    
+    // Step 7: Compare with original data and collect metrics
+    int bit_errors = (int)fso_count_bit_errors(packet->tx_data, packet->decoded_data,
+                                               FSO_MIN((size_t)config->control.packet_size,
+                                                       packet->decoded_len));
+    int bits_per_byte = sim_payload_bits_per_byte(config);
+    int total_bits = config->control.packet_size * bits_per_byte;
+    double ber = (double)bit_errors / (double)total_bits;
+    
+    // Record packet statistics
+    double airtime = (double)packet->symbol_len / config->control.sample_rate;
+    *stats = (PacketStats){
+        .packet_id = packet->packet_id,
+        .bits_transmitted = total_bits,
+        .bits_received = (int)packet->decoded_len * bits_per_byte,
+        .bit_errors = bit_errors,
+        .ber = ber,
+        .snr_db = packet->snr_db,
+        .received_power = packet->rx_power,
+        .fec_corrected_errors = packet->fec_stats.errors_corrected,
+        .fec_uncorrectable = packet->fec_stats.uncorrectable,
+        .fec_iterations = packet->fec_stats.iterations,
+        .log_weight = packet->log_weight,
+        .airtime = airtime,
+        .amc_mode = -1,
+        .amc_snr_db = 0.0,
+        .harq_transmissions = 1,
+        .latency = airtime
+    };
+    
+    // Record time-series point
+    *point = (TimeSeriesPoint){
+        .timestamp = packet->packet_id * time_per_packet,
+        .ber = ber,
+        .snr_db = packet->snr_db,
+        .received_power = packet->rx_power,
+        .throughput = (double)total_bits / time_per_packet,
+        .beam_azimuth = 0.0,
+        .beam_elevation = 0.0,
+        .signal_strength = packet->channel_gain
+    };
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Packet Workers
+ * ============================================================================ */
+
+/** Packets whose fades are generated per serial pass before parallel processing */
+#define SIM_PACKET_BLOCK 4096
+
+/** First block size under a stopping rule; blocks then double up to SIM_PACKET_BLOCK */
+#define SIM_STOP_FIRST_BLOCK 64
+
+/** Sub-block fades staged per block under intra-packet fading (bounds the block size) */
+#define SIM_FADE_PROFILE_BUDGET (1 << 20)
+
+/**
+ * @brief Mode configurations of an adaptive run
+ */
+typedef struct {
+    int num_modes;
+    SimConfig* configs;          /* One per ladder mode */
+    SimConfig sizing;            /* Packet buffers that fit every mode */
+} SimModeSet;
+
+static void sim_mode_set_free(SimModeSet* set) {
+    free(set->configs);
+    memset(set, 0, sizeof(SimModeSet));
+}
+
+static int sim_mode_set_init(SimModeSet* set, const SimAMCController* amc,
+                             const SimConfig* config) {
+    memset(set, 0, sizeof(SimModeSet));
+    
+    set->configs = (SimConfig*)malloc((size_t)amc->num_modes * sizeof(SimConfig));
+    if (set->configs == NULL) {
+        FSO_LOG_ERROR("Simulator", "Failed to allocate AMC mode configurations");
+        return FSO_ERROR_MEMORY;
+    }
+    set->num_modes = amc->num_modes;
+    
+    for (int m = 0; m < amc->num_modes; m++) {
+        sim_amc_mode_config(config, &amc->modes[m], &set->configs[m]);
+    }
+    sim_amc_sizing_config(amc, config, &set->sizing);
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Per-thread codec chain and packet workspace
+ * 
+ * Adaptive runs build one codec chain per mode up front and size the
+ * packet for the largest, so a mode switch is an index change.
+ */
+typedef struct {
+    SimLink link;
+    SimLink* mode_links;         /* One chain per mode (adaptive runs only) */
+    int num_mode_links;
+    SimPacket packet;
+} SimWorker;
+
+static void sim_worker_free(SimWorker* worker) {
+    sim_packet_free(&worker->packet);
+    sim_link_free(&worker->link);
+    for (int m = 0; m < worker->num_mode_links; m++) {
+        sim_link_free(&worker->mode_links[m]);
+    }
+    free(worker->mode_links);
+    worker->mode_links = NULL;
+    worker->num_mode_links = 0;
+}
+
+static int sim_worker_init(SimWorker* worker, const SimConfig* config, const SimModeSet* modes) {
+    memset(worker, 0, sizeof(SimWorker));
+    
+    if (modes == NULL) {
+        int result = sim_link_init(&worker->link, config);
         if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR("Simulator", "FEC encoding failed for packet %d", packet_id);
-            continue;
+            return result;
         }
-        
-        // Step 2b: Apply interleaving if enabled
-        uint8_t* modulation_input = encoded_data;
-        size_t modulation_input_len = encoded_len;
-        
-        if (config->system.use_interleaver) {
-            result = interleave(&interleaver, encoded_data, encoded_len,
-                               interleaved_data, max_encoded);
-            if (result == FSO_SUCCESS) {
-                modulation_input = interleaved_data;
+    } else {
+        // LDPC graphs come from the shared graph cache, so per-worker
+        // chains cost decoder state only
+        worker->mode_links = (SimLink*)calloc((size_t)modes->num_modes, sizeof(SimLink));
+        if (worker->mode_links == NULL) {
+            return FSO_ERROR_MEMORY;
+        }
+        for (int m = 0; m < modes->num_modes; m++) {
+            int result = sim_link_init(&worker->mode_links[m], &modes->configs[m]);
+            if (result != FSO_SUCCESS) {
+                sim_worker_free(worker);
+                return result;
             }
+            worker->num_mode_links++;
         }
+    }
+    
+    int result = sim_packet_init(&worker->packet, modes ? &modes->sizing : config);
+    if (result != FSO_SUCCESS) {
+        sim_worker_free(worker);
+        return result;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Run one packet through every stage with a precomputed fade
+ * 
+ * fade_profile holds the packet's sub-block fades under intra-packet
+ * fading and is ignored otherwise. link and config are the worker's chain
+ * and configuration for the packet's mode.
+ * 
+ * Only reads the channel, and draws from the packet's own RNG streams, so
+ * packets may run on any thread in any order with identical results.
+ * 
+ * @return FSO_SUCCESS if stats and point were filled, error code if the
+ *         packet was dropped
+ */
+static int sim_process_packet(SimWorker* worker, SimLink* link, const SimConfig* config,
+                              const ChannelModel* channel, uint64_t run_seed,
+                              int packet_id, double fading, const double* fade_profile,
+                              double fade_log_weight, double time_per_packet,
+                              PacketStats* stats, TimeSeriesPoint* point) {
+    SimPacket* packet = &worker->packet;
+    
+    sim_stage_transmit(link, config, run_seed, packet_id, packet);
+    packet->fading = fading;
+    packet->log_weight = fade_log_weight;
+    if (packet->fade_blocks > 0) {
+        memcpy(packet->fade_profile, fade_profile, packet->fade_blocks * sizeof(double));
+    }
+    sim_stage_channel(channel, config, run_seed, packet);
+    sim_stage_demodulate(link, config, packet);
+    sim_stage_decode(link, config, packet);
+    
+    return sim_stage_collect(config, time_per_packet, packet, stats, point);
+}
+
+/**
+ * @brief Run one packet through its hybrid ARQ transmissions
+ * 
+ * The codeword is encoded once. Each transmission sends the schedule's
+ * next segment and the receiver decodes from the LLRs of every
+ * transmission so far. The receiver ACKs a payload that passes an ideal
+ * CRC (decoded without errors) and the packet counts as lost if the last
+ * transmission is NACKed too; a NACK brings the next transmission
+ * round_trip_time after the end of the last, with the fade carried
+ * forward from the packet's own log-amplitude over that gap.
+ * 
+ * Each transmission draws from its own round of the packet's streams, so
+ * results are as order- and thread-independent as sim_process_packet().
+ * 
+ * @return FSO_SUCCESS if stats and point were filled, error code if the
+ *         packet was dropped
+ */
+static int sim_process_packet_harq(SimWorker* worker, const SimConfig* config,
+                                   const ChannelModel* channel, const SimHARQSchedule* schedule,
+                                   uint64_t run_seed, int packet_id, double fading,
+                                   double log_amplitude, double time_per_packet,
+                                   PacketStats* stats, TimeSeriesPoint* point) {
+    SimPacket* packet = &worker->packet;
+    SimLink* link = &worker->link;
+    
+    size_t encoded_len;
+    int result = sim_stage_encode(link, config, run_seed, packet_id, packet, &encoded_len);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    packet->log_weight = 0.0;
+    
+    double airtime = 0.0;
+    double latency = 0.0;
+    double round_airtime = 0.0;
+    int transmissions = 0;
+    int acked = 0;
+    
+    while (!acked && transmissions < schedule->num_rounds) {
+        int round = transmissions++;
+        if (round > 0) {
+            fso_random_select_stream(run_seed, (uint32_t)packet_id,
+                                     FSO_RNG_STREAM_ROUND(FSO_RNG_STREAM_CHANNEL, round));
+            fading = channel_continue_fade(channel, &log_amplitude,
+                                           round_airtime + schedule->round_trip_time);
+            latency += schedule->round_trip_time;
+        }
+        packet->harq_round = round;
+        packet->fading = fading;
         
-        // Step 3: Modulate data to optical symbols
-        size_t symbol_len;
-        result = modulate(&modulator, modulation_input, modulation_input_len,
-                         tx_symbols, &symbol_len);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR("Simulator", "Modulation failed for packet %d", packet_id);
-            continue;
+        size_t segment_len = sim_harq_gather(schedule, round, packet->encoded_data,
+                                             packet->harq_segment);
+        sim_stage_modulate(link, config, packet->harq_segment, segment_len, packet);
+        sim_stage_channel(channel, config, run_seed, packet);
+        sim_stage_demodulate(link, config, packet);
+        if (packet->status != FSO_SUCCESS) {
+            return packet->status;
         }
         
-        // Step 4: Apply channel effects
-        double signal_power = fso_signal_power_real(tx_symbols, symbol_len);
-        double tx_power = config->link.transmit_power * signal_power;
+        round_airtime = (double)packet->symbol_len / config->control.sample_rate;
+        airtime += round_airtime;
+        latency += round_airtime;
         
-        // Apply channel fading and attenuation
-        double rx_power = channel_apply_effects(&channel, tx_power,
-                                               config->control.noise_floor,
-                                               time_per_packet);
+        // Decode the whole mother codeword; positions not yet sent are erased
+        sim_harq_combine(schedule, round, packet->llr, packet->harq_llr);
+        packet->fec_llr = packet->harq_llr;
+        packet->fec_input_len = (size_t)schedule->code_length;
+        sim_stage_decode(link, config, packet);
         
-        // Scale received symbols
-        double channel_gain = sqrt(rx_power / tx_power);
-        for (size_t i = 0; i < symbol_len; i++) {
-            rx_symbols[i] = tx_symbols[i] * channel_gain;
+        // ACK from an ideal CRC: the decoder may also settle on a wrong
+        // codeword (all-zero from erased LLRs satisfies every check)
+        acked = !packet->fec_stats.uncorrectable &&
+                fso_count_bit_errors(packet->tx_data, packet->decoded_data,
+                                     FSO_MIN((size_t)config->control.packet_size,
+                                             packet->decoded_len)) == 0;
+    }
+    
+    result = sim_stage_collect(config, time_per_packet, packet, stats, point);
+    if (result == FSO_SUCCESS) {
+        // Still NACKed after the last transmission: the packet is lost
+        stats->fec_uncorrectable = !acked;
+        stats->airtime = airtime;
+        stats->harq_transmissions = transmissions;
+        stats->latency = latency;
+    }
+    return result;
+}
+
+/* ============================================================================
+ * Main Simulation Function
+ * ============================================================================ */
+
+/**
+ * @brief Run complete FSO link simulation
+ * 
+ * Implements the main simulation loop:
+ * 1. Generate random data packets
+ * 2. Apply FEC encoding
+ * 3. Modulate data to optical symbols
+ * 4. Apply channel effects (fading, attenuation, noise)
+ * 5. Demodulate received signal
+ * 6. Apply FEC decoding
+ * 7. Compare with original data and collect metrics
+ * 
+ * Packets are processed in blocks: the temporally correlated fade trace
+ * for a block is generated serially, then the block's packets run on
+ * config->control.num_threads workers of the shared pool, each with its
+ * own codec chain and buffers (allocated on that worker, so they are
+ * NUMA-local when the pool is pinned). Results are merged in packet
+ * order and are identical for any thread count.
+ * 
+ * With control.target_bit_errors or control.target_relative_error set,
+ * num_packets is the maximum budget: blocks start at 64 packets and
+ * double, and the run ends at the first packet (in packet order) where a
+ * target is met. results->stop_reason records which.
+ * 
+ * With control.checkpoint_file set, the run state is saved after a block
+ * once control.checkpoint_interval seconds have passed since the last
+ * save; with resume set, the run continues from that file.
+ *
+ * With system.amc.enabled, blocks are one feedback interval long. Each
+ * block is sent in the mode sim_amc_select() picks from the estimates of
+ * the blocks before it, and its packets' estimates are fed back in packet
+ * order during the merge, so adaptive runs are deterministic as well.
+ *
+ * With system.harq.enabled, a packet's retransmissions run on the same
+ * worker right after its first transmission: the fade pass records each
+ * packet's log-amplitude, and later transmissions continue that fade
+ * over their own airtime and round trips (sim_process_packet_harq()).
+ *
+ * @param config Simulation configuration
+ * @param results Output results structure
+ * @param resume Continue from control.checkpoint_file (0 = start fresh)
+ * @return FSO_SUCCESS on success, error code otherwise
+ * 
+ * @note Requirement 6.1: Complete transmitter and receiver chain
+ * @note Requirement 6.3: Channel propagation with atmospheric effects
+ */
+/**
+ * @brief Per-worker setup run on the pool, so each worker allocates and
+ *        first touches its own codec chain and buffers
+ */
+typedef struct {
+    SimWorker* workers;
+    int* status;
+    const SimConfig* config;
+    const SimModeSet* modes;
+} SimWorkerInitJob;
+
+static void sim_worker_init_range(void* context, size_t begin, size_t end, int worker) {
+    SimWorkerInitJob* job = (SimWorkerInitJob*)context;
+    (void)worker;
+    
+    for (size_t w = begin; w < end; w++) {
+        job->status[w] = sim_worker_init(&job->workers[w], job->config, job->modes);
+    }
+}
+
+/**
+ * @brief Packets of one block, claimed by pool workers in chunks
+ */
+typedef struct {
+    SimWorker* workers;
+    const SimConfig* config;
+    const ChannelModel* channel;
+    uint64_t run_seed;
+    int block_start;
+    const double* fades;
+    const double* fade_profiles;
+    size_t profile_len;
+    const double* fade_weights;
+    double time_per_packet;
+    PacketStats* block_stats;
+    TimeSeriesPoint* block_points;
+    int* block_status;
+    const SimModeSet* modes;
+    int mode;                    /* Ladder mode of the block (-1 without AMC) */
+    const SimHARQSchedule* harq; /* Transmission schedule (NULL without HARQ) */
+    const double* log_amplitudes; /* Log-amplitude of each packet's fade (HARQ only) */
+} SimBlockJob;
+
+static void sim_block_range(void* context, size_t begin, size_t end, int worker) {
+    const SimBlockJob* job = (const SimBlockJob*)context;
+    SimWorker* own = &job->workers[worker];
+    SimLink* link = (job->mode >= 0) ? &own->mode_links[job->mode] : &own->link;
+    const SimConfig* config = (job->mode >= 0) ? &job->modes->configs[job->mode] : job->config;
+    
+    for (size_t i = begin; i < end; i++) {
+        if (job->harq != NULL) {
+            job->block_status[i] = sim_process_packet_harq(own, config, job->channel, job->harq,
+                                                           job->run_seed, job->block_start + (int)i,
+                                                           job->fades[i], job->log_amplitudes[i],
+                                                           job->time_per_packet,
+                                                           &job->block_stats[i],
+                                                           &job->block_points[i]);
+            continue;
         }
         
-        // Add AWGN
-        add_awgn(rx_symbols, symbol_len, config->control.noise_floor);
-        
-        // Calculate SNR
-        double rx_signal_power = fso_signal_power_real(rx_symbols, symbol_len);
-        double snr_linear = rx_power / config->control.noise_floor;
-        double snr_db = fso_linear_to_db(snr_linear);
+        job->block_status[i] = sim_process_packet(own, link, config, job->channel,
+                                                  job->run_seed, job->block_start + (int)i,
+                                                  job->fades[i],
+                                                  job->fade_profiles ?
+                                                  job->fade_profiles + i * job->profile_len : NULL,
+                                                  job->fade_weights[i], job->time_per_packet,
+                                                  &job->block_stats[i], &job->block_points[i]);
         
-        // Step 5: Demodulate received signal
-        size_t demod_len;
-        result = demodulate(&modulator, rx_symbols, symbol_len,
-                           deinterleaved_data, &demod_len, snr_db);
+        // The receiver's channel-state report for the transmitter
+        if (job->mode >= 0 && job->block_status[i] == FSO_SUCCESS) {
+            job->block_stats[i].amc_mode = job->mode;
+            job->block_stats[i].amc_snr_db = sim_amc_estimate_snr(&own->packet, config);
+        }
+    }
+}
+
+/**
+ * @brief The block-parallel run behind sim_run(), sim_run_resume() and
+ * sim_run_pointed()
+ * 
+ * @param pointing Per-packet pointing step (NULL for none)
+ * @param pointing_context State passed to pointing
+ */
+static int sim_run_blocks(const SimConfig* config, SimResults* results, int resume,
+                          SimPointingFn pointing, void* pointing_context) {
+    if (config == NULL || results == NULL) {
+        FSO_LOG_ERROR("Simulator", "NULL pointer in sim_run");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Validate configuration
+    int result = sim_config_validate(config);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Configuration validation failed");
+        return result;
+    }
+    
+    // Resolve worker count (0 = the whole pool); a pool started earlier,
+    // for example with core affinity, keeps its size and placement
+    fso_threadpool_init(NULL);
+    int num_threads = (config->control.num_threads > 0) ?
+                      config->control.num_threads : fso_threadpool_size();
+    num_threads = FSO_MIN(num_threads, fso_threadpool_size());
+    num_threads = FSO_MIN(num_threads, config->control.num_packets);
+    
+    FSO_LOG_INFO("Simulator", "Starting simulation with %d packets on %d thread(s)", 
+                 config->control.num_packets, num_threads);
+    
+    // Initialize random number generator; each packet then draws from its
+    // own (run, packet, stream) sequences so results do not depend on order
+    uint64_t run_seed = sim_run_seed(config);
+    fso_random_init((unsigned int)run_seed);
+    
+    // Initialize channel model (shared; only the fade pass modifies it)
+    ChannelModel channel;
+    result = sim_channel_init(&channel, config);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    // Initialize results (in memory, or streamed to control.results_stream),
+    // or restore them with the fading state from the checkpoint
+    int first_packet = 0;
+    result = resume ? sim_checkpoint_restore(config, &channel, results, &first_packet)
+                    : sim_results_init_run(results, config, 1);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("Simulator", "Failed to initialize results");
+        channel_free(&channel);
+        return result;
+    }
+    
+    results->start_time = (double)clock() / CLOCKS_PER_SEC;
+    results->tracking_enabled = (pointing != NULL);
+    fso_profile_reset();
+    
+    // Adaptive modulation: one configuration per mode, and one block per
+    // feedback interval so each block is sent in the mode chosen from the
+    // reports of the blocks before it
+    const int amc_enabled = config->system.amc.enabled;
+    SimAMCController amc;
+    SimModeSet mode_set;
+    memset(&mode_set, 0, sizeof(mode_set));
+    if (amc_enabled) {
+        result = sim_amc_init(&amc, config);
+        if (result == FSO_SUCCESS) {
+            result = sim_mode_set_init(&mode_set, &amc, config);
+        }
         if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR("Simulator", "Demodulation failed for packet %d", packet_id);
-            continue;
+            channel_free(&channel);
+            sim_results_free(results);
+            return result;
         }
+    }
+    
+    // Per-thread workers and per-block staging (merged in packet order);
+    // sub-block fades cap the block size, which does not change results
+    size_t profile_len = sim_fade_profile_length(config);
+    size_t block_capacity = FSO_MIN((size_t)SIM_PACKET_BLOCK, (size_t)config->control.num_packets);
+    if (profile_len > 0) {
+        block_capacity = FSO_MAX(FSO_MIN(block_capacity, SIM_FADE_PROFILE_BUDGET / profile_len), 1);
+    }
+    if (amc_enabled) {
+        block_capacity = FSO_MIN(block_capacity, (size_t)config->system.amc.feedback_interval);
+    }
+    SimWorker* workers = (SimWorker*)calloc((size_t)num_threads, sizeof(SimWorker));
+    double* fades = (double*)malloc(block_capacity * sizeof(double));
+    double* fade_profiles = (profile_len > 0) ?
+        (double*)malloc(block_capacity * profile_len * sizeof(double)) : NULL;
+    double* fade_weights = (double*)malloc(block_capacity * sizeof(double));
+    PacketStats* block_stats = (PacketStats*)malloc(block_capacity * sizeof(PacketStats));
+    TimeSeriesPoint* block_points = (TimeSeriesPoint*)malloc(block_capacity * sizeof(TimeSeriesPoint));
+    int* block_status = (int*)malloc(block_capacity * sizeof(int));
+    int* worker_status = (int*)malloc((size_t)num_threads * sizeof(int));
+    const int harq_enabled = config->system.harq.enabled;
+    double* log_amplitudes = harq_enabled ? (double*)malloc(block_capacity * sizeof(double)) : NULL;
+    double* beam_angles = pointing ? (double*)malloc(2 * block_capacity * sizeof(double)) : NULL;
+    SimHARQSchedule harq;
+    memset(&harq, 0, sizeof(harq));
+    
+    int num_workers = 0;
+    if (workers && fades && fade_weights && block_stats && block_points && block_status &&
+        worker_status && (fade_profiles || profile_len == 0) && (log_amplitudes || !harq_enabled) &&
+        (beam_angles || !pointing)) {
+        // Worker slot w is set up on pool worker w, which later runs its packets
+        SimWorkerInitJob init_job = { workers, worker_status, config,
+                                      amc_enabled ? &mode_set : NULL };
+        fso_parallel_for((size_t)num_threads, 0, num_threads, sim_worker_init_range, &init_job);
         
-        // Step 5b: Apply deinterleaving if enabled
-        uint8_t* fec_input = deinterleaved_data;
-        size_t fec_input_len = demod_len;
-        
-        if (config->system.use_interleaver) {
-            result = deinterleave(&interleaver, deinterleaved_data, demod_len,
-                                 encoded_data, max_encoded);
-            if (result == FSO_SUCCESS) {
-                fec_input = encoded_data;
+        for (int w = 0; w < num_threads; w++) {
+            if (worker_status[w] != FSO_SUCCESS) {
+                result = worker_status[w];
             }
         }
+        num_workers = num_threads;
         
-        // Step 6: Apply FEC decoding
-        size_t decoded_len;
-        result = fec_decode(&fec_codec, fec_input, fec_input_len,
-                           decoded_data, &decoded_len, &fec_stats);
+        // Every worker's chain has the same mother code
+        if (result == FSO_SUCCESS && harq_enabled) {
+            result = sim_harq_schedule_init(&harq, &workers[0].link.fec_codec, &config->system.harq);
+        }
+    } else {
+        FSO_LOG_ERROR("Simulator", "Failed to allocate buffers");
+        result = FSO_ERROR_MEMORY;
+    }
+    
+    if (result != FSO_SUCCESS) {
+        for (int w = 0; w < num_workers; w++) {
+            if (worker_status[w] == FSO_SUCCESS) {
+                sim_worker_free(&workers[w]);
+            }
+        }
+        free(workers); free(fades); free(fade_profiles); free(fade_weights);
+        free(block_stats); free(block_points); free(block_status); free(worker_status);
+        free(log_amplitudes); free(beam_angles);
+        sim_harq_schedule_free(&harq);
+        sim_mode_set_free(&mode_set);
+        channel_free(&channel);
+        sim_results_free(results);
+        return result;
+    }
+    
+    // Main simulation loop
+    double time_per_packet = config->control.simulation_time / config->control.num_packets;
+    results->confidence_level = config->control.confidence_level;
+    results->importance_sampling = config->control.importance_sampling;
+    
+    // Under a stopping rule, blocks start small and double so little work
+    // is wasted past the stopping packet at low SNR (AMC blocks stay one
+    // feedback interval)
+    int adaptive = (config->control.target_bit_errors > 0 ||
+                    config->control.target_relative_error > 0.0);
+    int stopped = 0;
+    int block_size = (adaptive && !amc_enabled) ? FSO_MIN(SIM_STOP_FIRST_BLOCK, (int)block_capacity)
+                                                : (int)block_capacity;
+    int checkpointing = (config->control.checkpoint_file[0] != '\0');
+    if (checkpointing && pointing != NULL) {
+        FSO_LOG_WARNING("Simulator", "Pointing state is not checkpointed; running without checkpoints");
+        checkpointing = 0;
+    }
+    time_t last_checkpoint = time(NULL);
+    
+    for (int block_start = first_packet; block_start < config->control.num_packets && !stopped;
+         block_start += block_size, block_size = FSO_MIN(block_size * 2, (int)block_capacity)) {
+        int block_len = FSO_MIN(block_size, config->control.num_packets - block_start);
         
-        // Step 7: Compare with original data and collect metrics
-        int bit_errors = count_bit_errors(tx_data, decoded_data, 
-                                         FSO_MIN(config->control.packet_size, decoded_len));
-        int total_bits = config->control.packet_size * 8;
-        double ber = (double)bit_errors / (double)total_bits;
+        // Fade trace: the correlated fading chain is sequential in time
+        for (int i = 0; i < block_len; i++) {
+            fades[i] = sim_stage_fade(&channel, config, run_seed, block_start + i,
+                                      time_per_packet,
+                                      fade_profiles ? fade_profiles + (size_t)i * profile_len : NULL,
+                                      &fade_weights[i]);
+            if (log_amplitudes != NULL) {
+                log_amplitudes[i] = channel.last_log_amplitude;
+            }
+            
+            // The pointing loop follows the same time order as the fades
+            if (pointing != NULL) {
+                double gain = pointing(pointing_context, block_start + i, time_per_packet,
+                                       &beam_angles[2 * i], &beam_angles[2 * i + 1]);
+                fades[i] *= gain;
+                for (size_t k = 0; fade_profiles != NULL && k < profile_len; k++) {
+                    fade_profiles[(size_t)i * profile_len + k] *= gain;
+                }
+            }
+        }
         
-        // Record packet statistics
-        PacketStats packet_stats = {
-            .packet_id = packet_id,
-            .bits_transmitted = total_bits,
-            .bits_received = decoded_len * 8,
-            .bit_errors = bit_errors,
-            .ber = ber,
-            .snr_db = snr_db,
-            .received_power = rx_power,
-            .fec_corrected_errors = fec_stats.errors_corrected,
-            .fec_uncorrectable = fec_stats.uncorrectable
+        // Packets within the block are independent
+        SimBlockJob block_job = {
+            workers, config, &channel, run_seed, block_start, fades, fade_profiles,
+            profile_len, fade_weights, time_per_packet, block_stats, block_points, block_status,
+            &mode_set, amc_enabled ? sim_amc_select(&amc) : -1,
+            harq_enabled ? &harq : NULL, log_amplitudes
         };
-        sim_results_add_packet(results, &packet_stats);
+        fso_parallel_for((size_t)block_len, 16, num_threads, sim_block_range, &block_job);
         
-        // Record time-series point
-        TimeSeriesPoint ts_point = {
-            .timestamp = current_time,
-            .ber = ber,
-            .snr_db = snr_db,
-            .received_power = rx_power,
-            .throughput = (double)total_bits / time_per_packet,
-            .beam_azimuth = 0.0,
-            .beam_elevation = 0.0,
-            .signal_strength = channel_gain
-        };
-        sim_results_add_point(results, &ts_point);
+        for (int i = 0; i < block_len; i++) {
+            int packet_id = block_start + i;
+            if (config->control.verbose && (packet_id % 10 == 0)) {
+                printf("Processing packet %d/%d (%.1f%%)\n", 
+                       packet_id + 1, config->control.num_packets,
+                       100.0 * (packet_id + 1) / config->control.num_packets);
+            }
+            if (block_status[i] == FSO_SUCCESS) {
+                if (amc_enabled) {
+                    sim_amc_observe(&amc, block_stats[i].amc_snr_db);
+                }
+                if (beam_angles != NULL) {
+                    block_points[i].beam_azimuth = beam_angles[2 * i];
+                    block_points[i].beam_elevation = beam_angles[2 * i + 1];
+                }
+                sim_results_add_packet(results, &block_stats[i]);
+                sim_results_add_point(results, &block_points[i]);
+                
+                // Stop at the first packet meeting a target, independent of
+                // how the block was scheduled
+                if (adaptive && sim_results_check_stop(results, &config->control)) {
+                    stopped = 1;
+                    break;
+                }
+            }
+        }
+        
+        // Block boundaries are the only points where the run state is whole
+        int next_packet = block_start + block_len;
+        if (checkpointing && !stopped && next_packet < config->control.num_packets &&
+            difftime(time(NULL), last_checkpoint) >= config->control.checkpoint_interval) {
+            if (sim_checkpoint_save(config, run_seed, next_packet, &channel, results) != FSO_SUCCESS) {
+                FSO_LOG_WARNING("Simulator", "Checkpoint at packet %d failed; continuing", next_packet);
+            }
+            last_checkpoint = time(NULL);
+        }
+    }
+    
+    if (amc_enabled) {
+        results->amc_switches = amc.switches;
     }
     
     // Calculate final metrics
     sim_results_calculate_metrics(results);
+    result = sim_results_finish_run(results);
     
     results->end_time = (double)clock() / CLOCKS_PER_SEC;
     results->simulation_duration = results->end_time - results->start_time;
+    fso_profile_snapshot(results->stage_profile);
     
     // Cleanup
-    free(tx_data);
-    free(encoded_data);
-    free(interleaved_data);
-    free(tx_symbols);
-    free(rx_symbols);
-    free(deinterleaved_data);
-    free(decoded_data);
+    for (int w = 0; w < num_workers; w++) {
+        sim_worker_free(&workers[w]);
+    }
+    free(workers);
+    free(fades);
+    free(fade_profiles);
+    free(fade_weights);
+    free(block_stats);
+    free(block_points);
+    free(block_status);
+    free(worker_status);
+    free(log_amplitudes);
+    free(beam_angles);
+    sim_harq_schedule_free(&harq);
+    sim_mode_set_free(&mode_set);
     
     channel_free(&channel);
-    if (config->system.use_interleaver) {
-        interleaver_free(&interleaver);
+    
+    if (result != FSO_SUCCESS) {
+        sim_results_free(results);
+        return result;
     }
-    fec_free(&fec_codec);
-    modulator_free(&modulator);
     
     FSO_LOG_INFO("Simulator", "Simulation completed: %d packets, BER=%.3e, SNR=%.2f dB",
                  results->total_packets, results->avg_ber, results->avg_snr);
     
     return FSO_SUCCESS;
 }
+
+int sim_run(const SimConfig* config, SimResults* results) {
+    return sim_run_blocks(config, results, 0, NULL, NULL);
+}
+
+int sim_run_pointed(const SimConfig* config, SimResults* results,
+                    SimPointingFn pointing, void* context) {
+    return sim_run_blocks(config, results, 0, pointing, context);
+}
+
+int sim_run_resume(const SimConfig* config, SimResults* results) {
+    if (config == NULL || results == NULL || config->control.checkpoint_file[0] == '\0') {
+        FSO_LOG_ERROR("Simulator", "Resume needs a configuration with a checkpoint file");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    int result = sim_run_blocks(config, results, 1, NULL, NULL);
+    if (result == FSO_SUCCESS && config->system.enable_tracking) {
+        // As sim_run_with_tracking() reports the run it wraps
+        results->tracking_enabled = 1;
+        results->tracking_updates = config->control.num_packets;
+    }
+    return result;
+}
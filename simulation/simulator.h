@@ -23,6 +23,14 @@
 #include "../src/turbulence/channel.h"
 #include "../src/beam_tracking/beam_tracking.h"
 
+/** Bit errors and packets required before the BER confidence interval is trusted */
+#define SIM_STOP_MIN_CI_ERRORS 10
+#define SIM_STOP_MIN_CI_PACKETS 30
+
+/** Packet budget per run: in-memory history, and streamed results (aggregates only) */
+#define SIM_MAX_PACKETS 1000000
+#define SIM_MAX_STREAM_PACKETS 1000000000
+
 /* ============================================================================
  * Simulator Configuration Structures
  * ============================================================================ */
@@ -51,8 +59,73 @@ typedef struct {
     double rainfall_rate;        /**< Rainfall rate in mm/hr */
     double snowfall_rate;        /**< Snowfall rate in mm/hr */
     double correlation_time;     /**< Temporal correlation time in seconds */
+    ChannelFadingModel fading_model; /**< Irradiance fading distribution */
+    double malaga_omega;         /**< Málaga LOS power fraction Ω (0-1) */
+    double malaga_rho;           /**< Málaga coupled scatter fraction ρ [0-1) */
+    int intra_packet_fading;     /**< Vary the fade within each packet (0 or 1) */
+    int fade_block_symbols;      /**< Symbols sharing one gain under intra-packet fading (1 = per symbol) */
 } EnvironmentConfig;
 
+/** Most modes in an adaptive modulation and coding ladder */
+#define SIM_AMC_MAX_MODES 16
+
+/** Longest AMC feedback interval in packets (one decision per packet block) */
+#define SIM_AMC_MAX_INTERVAL 4096
+
+/**
+ * @brief One modulation and coding mode of an AMC ladder
+ * 
+ * Thresholds are on the pulse SNR γ = A²/σ² (received '1' level squared
+ * over the noise variance per sample). Symbols are 0/1 levels scaled by
+ * the channel gain whatever the modulation, so γ describes the channel
+ * alone and one estimate serves every mode.
+ */
+typedef struct {
+    ModulationType modulation;   /**< MOD_OOK or MOD_PPM */
+    int ppm_order;               /**< PPM order (PPM modes only) */
+    double code_rate;            /**< FEC code rate */
+    double min_snr_db;           /**< Lowest predicted pulse SNR (dB) the mode is chosen at */
+} SimAMCMode;
+
+/**
+ * @brief Adaptive modulation and coding parameters
+ * 
+ * The receiver estimates γ from every packet and reports it once per
+ * feedback_interval packets; the transmitter predicts γ a short horizon
+ * ahead and sends the next interval in the most efficient mode whose
+ * threshold the prediction clears. Modes replace system.modulation,
+ * ppm_order and code_rate; the FEC type and the rest of the chain stay.
+ */
+typedef struct {
+    int enabled;                 /**< Adapt the mode per feedback interval (0 or 1) */
+    int num_modes;               /**< Modes in the ladder (0 = sim_amc_default_ladder()) */
+    SimAMCMode modes[SIM_AMC_MAX_MODES]; /**< Ladder, most robust (lowest threshold) first */
+    double hysteresis_db;        /**< Margin over a higher mode's threshold before stepping up */
+    int feedback_interval;       /**< Packets per channel-state report and mode decision */
+    double smoothing;            /**< Level gain α of the SNR predictor (0-1] */
+    double trend_smoothing;      /**< Trend gain β of the SNR predictor [0-1] */
+    int prediction_horizon;      /**< Packets ahead to predict (0 = half the feedback interval) */
+} SimAMCConfig;
+
+/** Most transmissions of one packet under hybrid ARQ */
+#define SIM_HARQ_MAX_TRANSMISSIONS 16
+
+/**
+ * @brief Hybrid ARQ with incremental redundancy
+ * 
+ * The LDPC code at system.code_rate is the mother code. The first
+ * transmission sends it punctured to initial_rate; each NACK is answered
+ * one round_trip_time later with the next as many code bits of the
+ * mother codeword, read as a circular buffer, and the receiver decodes
+ * from the LLRs of every transmission so far.
+ */
+typedef struct {
+    int enabled;                 /**< Retransmit undecodable packets (0 or 1) */
+    int max_transmissions;       /**< Transmissions per packet, first included (2 to SIM_HARQ_MAX_TRANSMISSIONS) */
+    double initial_rate;         /**< Punctured code rate of the first transmission */
+    double round_trip_time;      /**< Seconds from the end of a transmission to its retransmission */
+} SimHARQConfig;
+
 /**
  * @brief System configuration parameters
  */
@@ -63,8 +136,13 @@ typedef struct {
     double code_rate;            /**< FEC code rate */
     int use_interleaver;         /**< Enable interleaving (0 or 1) */
     int interleaver_depth;       /**< Interleaver depth */
+    InterleaverType interleaver_type; /**< Interleaver permutation (default block) */
+    int soft_decision;           /**< Decode from demodulator LLRs instead of hard bytes (0 or 1) */
+    FSOPrecision precision;      /**< Symbol and decoder message format (default double) */
     int enable_tracking;         /**< Enable beam tracking (0 or 1) */
     double tracking_update_rate; /**< Beam tracking update rate in Hz */
+    SimAMCConfig amc;            /**< Adaptive modulation and coding (off by default) */
+    SimHARQConfig harq;          /**< Hybrid ARQ (off by default) */
 } SystemConfig;
 
 /**
@@ -77,6 +155,16 @@ typedef struct {
     int num_packets;             /**< Number of packets to simulate */
     double noise_floor;          /**< Noise floor in watts */
     unsigned int random_seed;    /**< Random seed (0 for time-based) */
+    int num_threads;             /**< Packet worker threads (0 = all available) */
+    int target_bit_errors;       /**< Stop after this many bit errors (0 = off) */
+    double target_relative_error; /**< Stop when BER CI half-width / BER is below this (0 = off) */
+    double confidence_level;     /**< Confidence level of the BER interval (e.g. 0.95) */
+    int importance_sampling;     /**< Draw fades/noise from biased distributions (0 or 1) */
+    double is_fade_shift;        /**< Log-amplitude mean shift in σ_χ units (negative = deeper fades) */
+    double is_noise_shift;       /**< AWGN mean shift toward the decision midpoint, in noise σ units */
+    char results_stream[256];    /**< Stream per-packet results to this file ("" = keep in memory) */
+    char checkpoint_file[256];   /**< Write resumable checkpoints of sim_run() here ("" = off) */
+    double checkpoint_interval;  /**< Wall-clock seconds between checkpoints (0 = every block) */
     int verbose;                 /**< Verbose output (0 or 1) */
 } SimulationControl;
 
@@ -99,6 +187,18 @@ typedef struct {
  * Simulation Results Structures
  * ============================================================================ */
 
+/**
+ * @brief Why a simulation run ended
+ * 
+ * With target_bit_errors or target_relative_error set, num_packets is the
+ * maximum budget and the run stops at the first packet meeting a target.
+ */
+typedef enum {
+    SIM_STOP_BUDGET = 0,         /**< All num_packets were simulated */
+    SIM_STOP_BIT_ERRORS = 1,     /**< target_bit_errors was reached */
+    SIM_STOP_CONFIDENCE = 2      /**< target_relative_error was reached */
+} SimStopReason;
+
 /**
  * @brief Packet-level statistics
  */
@@ -112,6 +212,13 @@ typedef struct {
     double received_power;       /**< Received power in watts */
     int fec_corrected_errors;    /**< Errors corrected by FEC */
     int fec_uncorrectable;       /**< Flag: 1 if FEC failed */
+    int fec_iterations;          /**< Decoder iterations (iterative codes, 0 otherwise) */
+    double log_weight;           /**< Log-likelihood ratio (importance sampling, 0 otherwise) */
+    double airtime;              /**< Channel time the packet occupied in seconds */
+    int amc_mode;                /**< Ladder index the packet was sent in (-1 without AMC) */
+    double amc_snr_db;           /**< Receiver's pulse SNR estimate in dB (AMC only, 0 otherwise) */
+    int harq_transmissions;      /**< Transmissions the packet took (1 without HARQ) */
+    double latency;              /**< Seconds from the first transmission's start to the last one's end */
 } PacketStats;
 
 /**
@@ -128,6 +235,116 @@ typedef struct {
     double signal_strength;      /**< Signal strength (normalized) */
 } TimeSeriesPoint;
 
+/* ============================================================================
+ * Metric Accumulators
+ * ============================================================================ */
+
+/** Bins of a SimHistogram */
+#define SIM_HISTOGRAM_BINS 1024
+
+/** Histogram ranges: SNR in dB (linear bins), per-packet BER (log bins) */
+#define SIM_SNR_HIST_MIN_DB -50.0
+#define SIM_SNR_HIST_MAX_DB 150.0
+#define SIM_BER_HIST_MIN 1e-12
+#define SIM_BER_HIST_MAX 1.0
+
+/** Delivery latency histogram range in seconds (log bins) */
+#define SIM_LATENCY_HIST_MIN_S 1e-9
+#define SIM_LATENCY_HIST_MAX_S 1e3
+
+/**
+ * @brief Compensated sum (Neumaier's variant of Kahan summation)
+ *
+ * The value is sum + compensation. Rounding error stays O(eps) however
+ * many terms are added or partial sums merged.
+ */
+typedef struct {
+    double sum;                  /**< Running sum */
+    double compensation;         /**< Accumulated low-order bits */
+} SimKahanSum;
+
+/**
+ * @brief Count, mean, variance and range (Welford, merged with Chan's update)
+ */
+typedef struct {
+    long long count;             /**< Samples added */
+    double mean;                 /**< Running mean */
+    double m2;                   /**< Sum of squared deviations from the mean */
+    double min;                  /**< Smallest sample (INFINITY when empty) */
+    double max;                  /**< Largest sample (-INFINITY when empty) */
+} SimRunningStat;
+
+/**
+ * @brief Fixed-range histogram for quantiles
+ *
+ * Bins are linear over [lo, hi) or, with log_scale, linear in log10 (zero
+ * and values below lo land in the underflow count). Histograms with the
+ * same range merge by adding counts; quantiles are bin midpoints clamped
+ * to the observed range.
+ */
+typedef struct {
+    double lo;                   /**< Lower edge of the first bin */
+    double hi;                   /**< Upper edge of the last bin */
+    int log_scale;               /**< 1: bins are uniform in log10 */
+    unsigned long long count;    /**< Samples added */
+    unsigned long long underflow; /**< Samples below lo */
+    unsigned long long overflow; /**< Samples at or above hi */
+    double min;                  /**< Smallest sample */
+    double max;                  /**< Largest sample */
+    unsigned long long bins[SIM_HISTOGRAM_BINS]; /**< Counts per bin */
+} SimHistogram;
+
+/* ============================================================================
+ * Streaming Results
+ * ============================================================================ */
+
+/** Rows per column chunk */
+#define SIM_STREAM_CHUNK_ROWS 4096
+
+/** Stream header flags selecting the optional CSV columns */
+#define SIM_STREAM_FLAG_TRACKING   0x1u
+#define SIM_STREAM_FLAG_IMPORTANCE 0x2u
+#define SIM_STREAM_FLAG_AMC        0x4u
+#define SIM_STREAM_FLAG_HARQ       0x8u
+
+/**
+ * @brief Tables of a results stream
+ */
+typedef enum {
+    SIM_STREAM_PACKETS = 0,      /**< PacketStats rows */
+    SIM_STREAM_POINTS = 1,       /**< TimeSeriesPoint rows */
+    SIM_STREAM_TABLE_COUNT
+} SimStreamTable;
+
+/**
+ * @brief Buffered writer of a columnar results file
+ * 
+ * Rows are buffered per table and written as column chunks of up to
+ * SIM_STREAM_CHUNK_ROWS rows, so memory stays fixed however long the
+ * run is. Write errors are sticky and reported by close.
+ */
+typedef struct {
+    FILE* fp;                    /**< Output file */
+    unsigned int flags;          /**< SIM_STREAM_FLAG_* */
+    int error;                   /**< First write error (FSO_SUCCESS if none) */
+    PacketStats* packets;        /**< Buffered packet rows */
+    TimeSeriesPoint* points;     /**< Buffered time-series rows */
+    size_t buffered[SIM_STREAM_TABLE_COUNT];        /**< Rows waiting per table */
+    unsigned long long total_rows[SIM_STREAM_TABLE_COUNT]; /**< Rows written per table */
+    unsigned char* column;       /**< Column transpose scratch */
+} SimStreamWriter;
+
+/**
+ * @brief Chunk-at-a-time reader of a columnar results file
+ */
+typedef struct {
+    FILE* fp;                    /**< Input file */
+    unsigned int flags;          /**< SIM_STREAM_FLAG_* from the header */
+    int complete;                /**< 1 once the end record was read */
+    unsigned long long total_rows[SIM_STREAM_TABLE_COUNT]; /**< Row counts (from the end record) */
+    unsigned char* column;       /**< Column read scratch */
+} SimStreamReader;
+
 /**
  * @brief Simulation results and metrics
  * 
@@ -157,6 +374,26 @@ typedef struct {
     long long total_bits;        /**< Total bits transmitted */
     long long total_bit_errors;  /**< Total bit errors */
     long long fec_corrected_errors; /**< Total errors corrected by FEC */
+    long long fec_iterations;    /**< Total decoder iterations over all packets */
+    double avg_fec_iterations;   /**< Average decoder iterations per packet */
+    
+    // Confidence of the BER estimate (packets as independent samples)
+    double ber_ci_half_width;    /**< BER confidence-interval half-width */
+    double ber_relative_error;   /**< ber_ci_half_width / avg_ber */
+    double confidence_level;     /**< Confidence level of the interval (0 = 0.95) */
+    SimStopReason stop_reason;   /**< Why the run ended */
+    SimKahanSum sum_sq_bit_errors;   /**< Sum of squared per-packet (weighted) bit errors */
+    SimKahanSum sum_bits_bit_errors; /**< Sum of per-packet bits x (weighted) bit errors */
+    SimKahanSum sum_sq_bits;         /**< Sum of squared per-packet bits */
+    
+    // Importance sampling: each packet's errors and loss count with its
+    // likelihood-ratio weight w (w = 1 without importance sampling)
+    int importance_sampling;     /**< Flag: 1 if packets carry likelihood-ratio weights */
+    SimKahanSum weighted_bit_errors;   /**< Sum of w x bit errors */
+    SimKahanSum weighted_packets_lost; /**< Sum of w over lost packets */
+    SimKahanSum sum_weights;     /**< Sum of w */
+    SimKahanSum sum_sq_weights;  /**< Sum of w² */
+    double effective_samples;    /**< Effective sample size (sum w)² / sum w² */
     
     // Beam tracking metrics (if enabled)
     int tracking_enabled;        /**< Flag: 1 if tracking was enabled */
@@ -165,21 +402,330 @@ typedef struct {
     int tracking_updates;        /**< Number of tracking updates */
     int reacquisitions;          /**< Number of beam reacquisitions */
     
-    // Time-series history
+    // Goodput: payload of error-free packets over the channel time used
+    long long delivered_bits;    /**< Payload bits of packets decoded without errors */
+    SimKahanSum total_airtime;   /**< Channel time of all packets in seconds */
+    double goodput;              /**< delivered_bits / total_airtime in bits/second */
+    
+    // Adaptive modulation and coding (if enabled)
+    int amc_enabled;             /**< Flag: 1 if packets were sent in adaptive modes */
+    int amc_num_modes;           /**< Modes in the ladder */
+    SimAMCMode amc_modes[SIM_AMC_MAX_MODES]; /**< Ladder the run used */
+    long long amc_mode_packets[SIM_AMC_MAX_MODES]; /**< Packets sent per mode */
+    int amc_switches;            /**< Mode changes between feedback intervals */
+    
+    // Hybrid ARQ (if enabled); latency covers delivered packets only
+    int harq_enabled;            /**< Flag: 1 if undecodable packets were retransmitted */
+    int harq_max_transmissions;  /**< Transmissions allowed per packet */
+    long long harq_transmission_packets[SIM_HARQ_MAX_TRANSMISSIONS]; /**< Packets by transmissions taken (index = count - 1) */
+    long long harq_transmissions; /**< Transmissions over all packets */
+    double avg_harq_transmissions; /**< Average transmissions per packet */
+    SimRunningStat latency_stat; /**< Delivery latency in seconds */
+    SimHistogram latency_hist;   /**< Delivery latency quantiles */
+    double latency_p50;          /**< Median delivery latency in seconds */
+    double latency_p99;          /**< 99th-percentile delivery latency in seconds */
+    
+    // Distribution summaries (from the accumulators below)
+    double std_snr;              /**< Standard deviation of point SNR in dB */
+    double snr_p01;              /**< 1st-percentile SNR in dB (deep-fade tail) */
+    double snr_p50;              /**< Median SNR in dB */
+    double ber_p50;              /**< Median per-packet BER */
+    double ber_p99;              /**< 99th-percentile per-packet BER */
+    
+    // Online aggregates (kept whether or not history is stored, and
+    // mergeable across workers or runs with sim_results_merge())
+    size_t num_points;           /**< Time-series points added */
+    SimRunningStat snr_stat;     /**< Point SNR in dB */
+    SimRunningStat throughput_stat; /**< Point throughput */
+    SimRunningStat azimuth_stat; /**< Point beam azimuth */
+    SimRunningStat elevation_stat; /**< Point beam elevation */
+    SimRunningStat ber_stat;     /**< Per-packet BER */
+    SimHistogram snr_hist;       /**< Point SNR quantiles */
+    SimHistogram ber_hist;       /**< Per-packet BER quantiles */
+    double first_timestamp;      /**< Timestamp of the first point */
+    double last_timestamp;       /**< Timestamp of the last point */
+    
+    // Time-series history (NULL when only aggregates are kept)
     TimeSeriesPoint* history;    /**< Array of time-series data points */
     size_t history_length;       /**< Number of points in history */
     size_t history_capacity;     /**< Allocated capacity for history */
     
-    // Packet-level statistics
+    // Packet-level statistics (NULL when only aggregates are kept)
     PacketStats* packet_stats;   /**< Array of per-packet statistics */
     size_t num_packet_stats;     /**< Number of packet statistics */
+    SimStreamWriter* stream;     /**< Streaming sink for points and packets (NULL = none) */
     
     // Timing information
     double simulation_duration;  /**< Actual simulation duration in seconds */
     double start_time;           /**< Simulation start timestamp */
     double end_time;             /**< Simulation end timestamp */
+    
+    // Per-stage latency (all counts stay 0 unless built with FSO_ENABLE_PROFILING)
+    FSOProfileStats stage_profile[FSO_PROF_ZONE_COUNT]; /**< Indexed by FSOProfileZone */
 } SimResults;
 
+/* ============================================================================
+ * Packet Processing Structures
+ * ============================================================================ */
+
+/**
+ * @brief Link codec chain (modulator, FEC codec, optional interleaver)
+ * 
+ * Codecs carry per-call state, so each thread or pipeline stage owns one.
+ */
+typedef struct {
+    Modulator modulator;         /**< Modulator/demodulator */
+    FECCodec fec_codec;          /**< FEC encoder/decoder */
+    InterleaverConfig interleaver; /**< Interleaver (if enabled) */
+    int has_modulator;           /**< Flag: modulator initialized */
+    int has_fec;                 /**< Flag: FEC codec initialized */
+    int has_interleaver;         /**< Flag: interleaver initialized */
+} SimLink;
+
+/** Alignment of every region handed out by a packet workspace */
+#define FSO_WORKSPACE_ALIGN 64
+
+/** Correlation time, in packet durations, above which intra-packet fading uses one gain */
+#define SIM_BLOCK_FADING_RATIO 100.0
+
+/**
+ * @brief Aligned arena backing one packet's buffers
+ * 
+ * A single allocation sized once from the configuration and carved into
+ * FSO_WORKSPACE_ALIGN-aligned regions, so a worker's packet needs no
+ * allocations after setup.
+ */
+typedef struct {
+    uint8_t* base;               /**< Aligned block (NULL until initialized) */
+    size_t capacity;             /**< Bytes in the block */
+    size_t used;                 /**< Bytes handed out so far */
+} FSOPacketWorkspace;
+
+/**
+ * @brief One packet in flight with its preallocated buffers
+ * 
+ * The buffers are views into the packet's workspace. Stage functions fill
+ * them in order, interleaving and deinterleaving in place; a failed stage
+ * sets status and later stages pass the packet through untouched.
+ */
+typedef struct {
+    int packet_id;               /**< Packet identifier */
+    int status;                  /**< FSO_SUCCESS, or the first stage error */
+    double fading;               /**< Fading coefficient for this packet (mean over its sub-blocks) */
+    double log_weight;           /**< Log-likelihood ratio of the biased draws (0 if unbiased) */
+    size_t max_symbols;          /**< Symbol buffer capacity */
+    size_t max_encoded;          /**< Encoded buffer capacity */
+    FSOPacketWorkspace workspace; /**< Arena owning every buffer below */
+    uint8_t* tx_data;            /**< Transmitted payload */
+    uint8_t* encoded_data;       /**< FEC codeword, interleaved in place */
+    double* tx_symbols;          /**< Transmitted symbols */
+    double* rx_symbols;          /**< Received symbols */
+    double* noise_samples;       /**< AWGN scratch */
+    float* tx_symbols_f32;       /**< Transmitted symbols (single-precision path; NULL otherwise) */
+    float* rx_symbols_f32;       /**< Received symbols (single-precision path) */
+    float* noise_samples_f32;    /**< AWGN scratch (single-precision path) */
+    uint8_t* demod_data;         /**< Demodulated bytes, deinterleaved in place */
+    float* llr;                  /**< Demodulated bit LLRs, deinterleaved in place (soft decision only) */
+    uint8_t* interleave_marks;   /**< In-place interleaver scratch (interleaver only) */
+    double* fade_profile;        /**< Fading per sub-block (intra-packet fading only) */
+    double* gain_profile;        /**< Amplitude gain per sub-block (intra-packet fading only) */
+    float* harq_llr;             /**< LLRs combined over transmissions, in codeword order (HARQ only) */
+    uint8_t* harq_segment;       /**< Code bits of the current transmission (HARQ only) */
+    int harq_round;              /**< Transmission being sent (0 = first) */
+    size_t fade_blocks;          /**< Sub-blocks per packet (0 = one gain for the whole packet) */
+    size_t fade_block_len;       /**< Samples per sub-block */
+    uint8_t* decoded_data;       /**< Decoded payload */
+    const uint8_t* fec_input;    /**< Decoder input (view of demod_data) */
+    const float* fec_llr;        /**< Soft decoder input (view of llr) */
+    size_t symbol_len;           /**< Number of symbols */
+    size_t fec_input_len;        /**< Decoder input length in bytes (8 LLRs each when soft) */
+    size_t decoded_len;          /**< Decoded payload length */
+    double rx_power;             /**< Received power in watts */
+    double snr_db;               /**< SNR in dB */
+    double channel_gain;         /**< Amplitude gain applied to symbols */
+    FECStats fec_stats;          /**< Decoder statistics */
+} SimPacket;
+
+/**
+ * @brief Adaptive modulation and coding controller state
+ * 
+ * Lives with the transmitter: estimates arrive in packet order through
+ * sim_amc_observe() and each feedback interval's mode comes from
+ * sim_amc_select().
+ */
+typedef struct {
+    SimAMCMode modes[SIM_AMC_MAX_MODES]; /**< Ladder, most robust first */
+    int num_modes;               /**< Modes in the ladder */
+    double hysteresis_db;        /**< Step-up margin in dB */
+    double smoothing;            /**< Level gain α */
+    double trend_smoothing;      /**< Trend gain β */
+    double horizon;              /**< Prediction horizon in packets */
+    int current;                 /**< Mode of the interval being sent */
+    int observations;            /**< Estimates folded into the predictor */
+    double level;                /**< Smoothed pulse SNR in dB */
+    double trend;                /**< Pulse SNR trend in dB per packet */
+    int switches;                /**< Mode changes so far */
+} SimAMCController;
+
+/**
+ * @brief Hybrid ARQ transmission schedule
+ * 
+ * Transmission r sends the segment_length entries of order starting at
+ * r * segment_length, wrapping around at code_length. Built once per run
+ * from the mother code and shared read-only by every worker.
+ */
+typedef struct {
+    int* order;                  /**< Codeword positions in transmission order (code_length) */
+    int code_length;             /**< Mother codeword length in bytes (one code bit each) */
+    int segment_length;          /**< Codeword positions per transmission */
+    int num_rounds;              /**< Transmissions per packet at most */
+    double round_trip_time;      /**< Seconds from a transmission's end to the next one's start */
+} SimHARQSchedule;
+
+/* ============================================================================
+ * Pipeline Structures
+ * ============================================================================ */
+
+/**
+ * @brief Pipeline stages
+ */
+typedef enum {
+    SIM_STAGE_TRANSMIT = 0,      /**< Generate, encode, interleave, modulate */
+    SIM_STAGE_CHANNEL = 1,       /**< Fading, attenuation, AWGN */
+    SIM_STAGE_DEMODULATE = 2,    /**< Demodulate, deinterleave */
+    SIM_STAGE_DECODE = 3,        /**< FEC decode (replicated) */
+    SIM_STAGE_COLLECT = 4,       /**< Error counting and result merge */
+    SIM_NUM_STAGES = 5
+} SimStageId;
+
+/**
+ * @brief Pipeline configuration
+ */
+typedef struct {
+    int queue_depth;             /**< Packet slots per ring (0 = default 16) */
+    int decoder_workers;         /**< Replicated decode stages (0 = default 1) */
+} SimPipelineConfig;
+
+/**
+ * @brief Per-stage pipeline counters
+ */
+typedef struct {
+    const char* name;            /**< Stage name */
+    int workers;                 /**< Threads running this stage */
+    long long packets;           /**< Packets processed */
+    long long input_stalls;      /**< Waits on an empty input ring */
+    long long output_stalls;     /**< Waits on a full output ring */
+    double avg_occupancy;        /**< Mean input ring fill (0-1) seen per packet */
+    double busy_time;            /**< Seconds spent processing (summed over workers) */
+} SimStageStats;
+
+/**
+ * @brief Pipeline run statistics
+ */
+typedef struct {
+    SimStageStats stages[SIM_NUM_STAGES]; /**< Per-stage counters */
+    int threaded;                /**< 1 if stages ran on their own threads */
+    double wall_time;            /**< Wall-clock run time in seconds */
+    double packets_per_second;   /**< Sustained packet rate */
+    double symbols_per_second;   /**< Sustained symbol rate */
+} SimPipelineStats;
+
+/* ============================================================================
+ * Capture Replay Structures
+ * ============================================================================ */
+
+/**
+ * @brief Capture replay options
+ * 
+ * The capture holds received detector samples normalized like the
+ * simulator's rx symbols, one packet frame (sim_packet_samples()) after
+ * another from sample 0.
+ */
+typedef struct {
+    const char* capture_file;    /**< Capture to replay */
+    const double* fir_taps;      /**< Receive filter ahead of the demodulator (NULL = none) */
+    int num_fir_taps;            /**< Filter length; its (n - 1) / 2 group delay is skipped */
+    double amplitude;            /**< Symbol amplitude in the capture (0 = 1.0) */
+    double noise_variance;       /**< Noise variance per sample (0 = control.noise_floor) */
+    long long max_frames;        /**< Frames to replay (0 = the whole capture) */
+    int reference;               /**< Count bit errors against the payloads sim_run() would send */
+} SimReplayConfig;
+
+/**
+ * @brief Capture replay statistics
+ */
+typedef struct {
+    long long frames;            /**< Frames through the receive chain */
+    long long samples;           /**< Capture samples consumed */
+    long long failed;            /**< Frames a stage rejected */
+    long long uncorrectable;     /**< Frames the decoder flagged uncorrectable */
+    long long corrected_errors;  /**< Errors corrected by the decoder */
+    long long total_iterations;  /**< Decoder iterations (iterative codes) */
+    long long bit_errors;        /**< Payload bit errors (reference only) */
+    long long bits_compared;     /**< Payload bits compared (reference only) */
+    double capture_start;        /**< Capture time of the first frame in seconds */
+    double capture_duration;     /**< Capture time covered by the frames in seconds */
+    double wall_time;            /**< Wall-clock replay time in seconds */
+    double read_mb_per_second;   /**< Capture bytes consumed per second (MB/s) */
+    double payload_mbps;         /**< Decoded payload rate (Mbit/s) */
+} SimReplayStats;
+
+/* ============================================================================
+ * Sweep and Batch Structures
+ * ============================================================================ */
+
+/**
+ * @brief Parameter grid for a sweep
+ * 
+ * Each axis overrides one field of the base configuration. An axis with
+ * zero entries keeps the base value. The grid expands to the Cartesian
+ * product with distance varying slowest and modulation fastest.
+ */
+typedef struct {
+    const double* distances;             /**< Link distances in meters */
+    int num_distances;                   /**< Number of distances */
+    const WeatherCondition* weathers;    /**< Weather conditions */
+    int num_weathers;                    /**< Number of weather conditions */
+    const double* code_rates;            /**< FEC code rates */
+    int num_code_rates;                  /**< Number of code rates */
+    const ModulationType* modulations;   /**< Modulation schemes */
+    int num_modulations;                 /**< Number of modulation schemes */
+} SimSweepGrid;
+
+/**
+ * @brief One row of the consolidated sweep table
+ */
+typedef struct {
+    int config_index;            /**< Index into the swept configuration array */
+    double link_distance;        /**< Link distance in meters */
+    WeatherCondition weather;    /**< Weather condition */
+    double code_rate;            /**< FEC code rate */
+    ModulationType modulation;   /**< Modulation scheme */
+    int status;                  /**< FSO_SUCCESS, or the run's error code */
+    int total_packets;           /**< Packets transmitted */
+    int packets_lost;            /**< Packets lost */
+    long long total_bits;        /**< Bits transmitted */
+    long long total_bit_errors;  /**< Bit errors */
+    double avg_ber;              /**< Average bit error rate */
+    double ber_ci_half_width;    /**< BER confidence-interval half-width */
+    double avg_snr;              /**< Average SNR in dB */
+    double avg_throughput;       /**< Average throughput in bits/second */
+    double packet_loss_rate;     /**< Packet loss rate (0-1) */
+    double avg_fec_iterations;   /**< Average decoder iterations per packet */
+    SimStopReason stop_reason;   /**< Why the run ended */
+    double snr_p01;              /**< 1st-percentile SNR in dB */
+    double ber_p99;              /**< 99th-percentile per-packet BER */
+} SimSweepRow;
+
+/**
+ * @brief Batch simulation results
+ */
+typedef struct {
+    char scenario_name[64];      /**< Scenario name */
+    SimResults results;          /**< Results (valid when success is 1) */
+    int success;                 /**< Flag: 1 if the scenario ran */
+} BatchResult;
+
 /* ============================================================================
  * Configuration Functions
  * ============================================================================ */
@@ -258,19 +804,44 @@ int sim_config_create_preset(SimConfig* config, const char* scenario_name);
 /**
  * @brief Initialize simulation results structure
  * 
- * Allocates memory for time-series history and packet statistics.
+ * Allocates memory for time-series history and packet statistics. A
+ * zero capacity or packet count keeps only the online aggregates for that
+ * table.
  * 
  * @param results Pointer to SimResults structure to initialize
- * @param history_capacity Initial capacity for time-series history
- * @param num_packets Expected number of packets
+ * @param history_capacity Initial capacity for time-series history (0 = none)
+ * @param num_packets Expected number of packets (0 = no per-packet array)
  * @return FSO_SUCCESS on success, error code otherwise
  */
 int sim_results_init(SimResults* results, size_t history_capacity, int num_packets);
 
+/**
+ * @brief Initialize results for a run of config
+ * 
+ * Keeps history and packet statistics in memory, unless
+ * control.results_stream names a file: rows then go to that stream and
+ * only the aggregates stay in memory.
+ * 
+ * @param results Pointer to SimResults structure to initialize
+ * @param config Configuration of the run
+ * @param keep_history 0 to keep only aggregates even without a stream
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_results_init_run(SimResults* results, const SimConfig* config, int keep_history);
+
+/**
+ * @brief Flush and close the results stream, if any
+ * 
+ * @param results Pointer to SimResults structure
+ * @return FSO_SUCCESS, or the first stream write error
+ */
+int sim_results_finish_run(SimResults* results);
+
 /**
  * @brief Free simulation results resources
  * 
- * Releases all memory allocated for results structure.
+ * Releases all memory allocated for results structure and closes a
+ * stream left open.
  * 
  * @param results Pointer to SimResults structure to free
  */
@@ -299,6 +870,21 @@ int sim_results_add_point(SimResults* results, const TimeSeriesPoint* point);
  */
 int sim_results_add_packet(SimResults* results, const PacketStats* stats);
 
+/**
+ * @brief Update the BER confidence interval and check the stopping targets
+ * 
+ * Treats packets as independent samples of a ratio estimator, so error
+ * bursts within a packet widen the interval as they should. The interval
+ * is only trusted after SIM_STOP_MIN_CI_ERRORS errors over at least
+ * SIM_STOP_MIN_CI_PACKETS packets.
+ * Call after each sim_results_add_packet() in packet order.
+ * 
+ * @param results Pointer to SimResults structure
+ * @param control Simulation control holding the targets
+ * @return 1 if a target is met (stop_reason is set), 0 otherwise
+ */
+int sim_results_check_stop(SimResults* results, const SimulationControl* control);
+
 /**
  * @brief Calculate aggregated metrics from collected data
  * 
@@ -312,6 +898,75 @@ int sim_results_add_packet(SimResults* results, const PacketStats* stats);
  */
 int sim_results_calculate_metrics(SimResults* results);
 
+/**
+ * @brief Fold the aggregates of src into dst
+ *
+ * Combines counters, compensated sums, running statistics and histograms,
+ * so results of workers, seeds or machines reduce without their packet
+ * arrays. History, packet arrays and streams are not touched. Call
+ * sim_results_calculate_metrics() on dst afterwards.
+ *
+ * @param dst Accumulated results
+ * @param src Results to add
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_results_merge(SimResults* dst, const SimResults* src);
+
+/* ============================================================================
+ * Metric Accumulator Functions
+ * ============================================================================ */
+
+/** @brief Add a term to a compensated sum */
+void sim_kahan_add(SimKahanSum* sum, double value);
+
+/** @brief Add the partial sum src to dst */
+void sim_kahan_merge(SimKahanSum* dst, const SimKahanSum* src);
+
+/** @brief Value of a compensated sum */
+double sim_kahan_value(const SimKahanSum* sum);
+
+/** @brief Reset a running statistic to empty */
+void sim_stat_init(SimRunningStat* stat);
+
+/** @brief Add a sample to a running statistic */
+void sim_stat_add(SimRunningStat* stat, double value);
+
+/** @brief Fold the samples summarized by src into dst */
+void sim_stat_merge(SimRunningStat* dst, const SimRunningStat* src);
+
+/** @brief Sample variance of a running statistic (0 below two samples) */
+double sim_stat_variance(const SimRunningStat* stat);
+
+/**
+ * @brief Reset a histogram to empty over [lo, hi)
+ *
+ * @param hist Histogram to initialize
+ * @param lo Lower edge (> 0 with log_scale)
+ * @param hi Upper edge (> lo)
+ * @param log_scale 1 for bins uniform in log10
+ * @return FSO_SUCCESS, or FSO_ERROR_INVALID_PARAM for a bad range
+ */
+int sim_histogram_init(SimHistogram* hist, double lo, double hi, int log_scale);
+
+/** @brief Add a sample to a histogram */
+void sim_histogram_add(SimHistogram* hist, double value);
+
+/**
+ * @brief Add the counts of src to dst
+ *
+ * @return FSO_SUCCESS, or FSO_ERROR_INVALID_PARAM if the ranges differ
+ */
+int sim_histogram_merge(SimHistogram* dst, const SimHistogram* src);
+
+/**
+ * @brief Approximate quantile of a histogram
+ *
+ * @param hist Histogram
+ * @param q Quantile in [0, 1]
+ * @return Quantile estimate, or NAN for an empty histogram
+ */
+double sim_histogram_quantile(const SimHistogram* hist, double q);
+
 /**
  * @brief Print results summary
  * 
@@ -345,25 +1000,980 @@ int sim_results_export_csv(const SimResults* results, const char* filename);
  */
 int sim_results_export_packets_csv(const SimResults* results, const char* filename);
 
+/**
+ * @brief Convert a results stream to the CSV files of the exporters above
+ * 
+ * Produces the same columns and formatting as sim_results_export_csv()
+ * and sim_results_export_packets_csv(), so the plotting scripts work on
+ * streamed runs.
+ * 
+ * @param stream_file Results stream written during the run
+ * @param points_csv Time-series CSV path (NULL to skip)
+ * @param packets_csv Packet CSV path (NULL to skip)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stream_export_csv(const char* stream_file, const char* points_csv,
+                          const char* packets_csv);
+
 /* ============================================================================
- * Utility Functions
+ * Results Stream Functions
  * ============================================================================ */
 
 /**
- * @brief Get string representation of modulation type
+ * @brief Create a results stream and write its header
  * 
- * @param type Modulation type
- * @return String representation
+ * The file holds a header describing every column (name and type), then
+ * column chunks of the two tables in the order they filled, then an end
+ * record with the row counts. Values are in host byte order; the header
+ * carries a byte-order mark.
+ * 
+ * @param writer Writer to initialize
+ * @param filename Output path
+ * @param flags SIM_STREAM_FLAG_* recorded in the header
+ * @return FSO_SUCCESS on success, error code otherwise
  */
-const char* sim_modulation_string(ModulationType type);
+int sim_stream_writer_open(SimStreamWriter* writer, const char* filename, unsigned int flags);
 
 /**
- * @brief Get string representation of FEC type
+ * @brief Append one packet row
  * 
- * @param type FEC type
- * @return String representation
+ * @return FSO_SUCCESS, or the sticky write error
  */
-const char* sim_fec_string(FECType type);
+int sim_stream_write_packet(SimStreamWriter* writer, const PacketStats* stats);
+
+/**
+ * @brief Append one time-series row
+ * 
+ * @return FSO_SUCCESS, or the sticky write error
+ */
+int sim_stream_write_point(SimStreamWriter* writer, const TimeSeriesPoint* point);
+
+/**
+ * @brief Flush buffered rows, write the end record and close the file
+ * 
+ * @param writer Writer to close
+ * @return FSO_SUCCESS, or the first write error
+ */
+int sim_stream_writer_close(SimStreamWriter* writer);
+
+/**
+ * @brief Open a results stream and validate its header
+ * 
+ * @param reader Reader to initialize
+ * @param filename Stream path
+ * @return FSO_SUCCESS, FSO_ERROR_IO, or FSO_ERROR_UNSUPPORTED for a
+ *         foreign layout
+ */
+int sim_stream_reader_open(SimStreamReader* reader, const char* filename);
+
+/**
+ * @brief Read the next chunk
+ * 
+ * Fills packets or points, depending on the chunk's table. Both arrays
+ * hold SIM_STREAM_CHUNK_ROWS rows. At the end of the stream *rows is 0;
+ * reader->complete tells whether the end record was present.
+ * 
+ * @param reader Open reader
+ * @param table Output table of the chunk
+ * @param packets Packet rows (used for SIM_STREAM_PACKETS chunks)
+ * @param points Time-series rows (used for SIM_STREAM_POINTS chunks)
+ * @param rows Output number of rows read
+ * @return FSO_SUCCESS on success, error code for a corrupt file
+ */
+int sim_stream_reader_next(SimStreamReader* reader, SimStreamTable* table,
+                           PacketStats* packets, TimeSeriesPoint* points, size_t* rows);
+
+/**
+ * @brief Write out buffered rows and flush the file
+ * 
+ * After a sync the file holds every row appended so far, as whole chunks.
+ * 
+ * @param writer Open writer
+ * @param offset Output file offset of the sync point
+ * @return FSO_SUCCESS, or the sticky write error
+ */
+int sim_stream_writer_sync(SimStreamWriter* writer, long long* offset);
+
+/**
+ * @brief Reopen a stream at a sync point to continue appending
+ * 
+ * Truncates the file to offset, dropping chunks written after the sync.
+ * 
+ * @param writer Writer to initialize
+ * @param filename Stream path
+ * @param flags SIM_STREAM_FLAG_* of the stream
+ * @param offset Offset returned by sim_stream_writer_sync()
+ * @param total_rows Rows per table at the sync point
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stream_writer_reopen(SimStreamWriter* writer, const char* filename, unsigned int flags,
+                             long long offset, const unsigned long long* total_rows);
+
+/**
+ * @brief Close a results stream reader
+ */
+void sim_stream_reader_close(SimStreamReader* reader);
+
+/* ============================================================================
+ * Simulation Functions
+ * ============================================================================ */
+
+/**
+ * @brief Run complete FSO link simulation
+ * 
+ * @param config Simulation configuration
+ * @param results Output results structure
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run(const SimConfig* config, SimResults* results);
+
+/**
+ * @brief Run the simulation as a pipeline of stage threads
+ * 
+ * Each stage runs on its own thread, connected by lock-free
+ * single-producer/single-consumer rings of preallocated packet slots. The
+ * decode stage can be replicated; packets are dealt round-robin to the
+ * decoders and collected in the same order, so results match sim_run(),
+ * including where a stopping rule ends the run.
+ * Stage threads are plain pthreads, independent of OpenMP and the worker
+ * pool; where they cannot all be started the stages run in sequence on
+ * the calling thread.
+ * 
+ * @param config Simulation configuration
+ * @param pipeline Pipeline configuration (NULL for defaults)
+ * @param results Output results structure
+ * @param stats Output per-stage statistics (may be NULL)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_pipelined(const SimConfig* config, const SimPipelineConfig* pipeline,
+                      SimResults* results, SimPipelineStats* stats);
+
+/**
+ * @brief Print pipeline statistics
+ * 
+ * @param stats Statistics from sim_run_pipelined()
+ */
+void sim_pipeline_print_stats(const SimPipelineStats* stats);
+
+/**
+ * @brief Replay a recorded capture through the receive chain
+ * 
+ * The capture is memory-mapped and streamed in chunks of frames: the next
+ * chunk is prefetched while the current one is decoded on the worker
+ * pool, and consumed pages are released, so files larger than memory run
+ * at disk bandwidth. Each frame is optionally FIR filtered, then
+ * demodulated and decoded with the link configured by config. Without a
+ * filter, real captures in the configured precision are handed to the
+ * demodulator straight from the mapping.
+ * 
+ * With replay->reference set, frame k is compared against the payload of
+ * packet k under config's random_seed (a loopback capture of the
+ * simulator's own transmitter).
+ * 
+ * @param config Link configuration (fading and channel settings unused)
+ * @param replay Replay options
+ * @param stats Output statistics
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_replay(const SimConfig* config, const SimReplayConfig* replay,
+                   SimReplayStats* stats);
+
+/**
+ * @brief Print capture replay statistics
+ * 
+ * @param stats Statistics from sim_run_replay()
+ */
+void sim_replay_print_stats(const SimReplayStats* stats);
+
+/**
+ * @brief Run beam-tracked simulation
+ * 
+ * Falls back to sim_run() when tracking is disabled.
+ * 
+ * @param config Simulation configuration
+ * @param results Output results structure
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_with_tracking(const SimConfig* config, SimResults* results);
+
+/* ============================================================================
+ * Sweep and Batch Functions
+ * ============================================================================ */
+
+/**
+ * @brief Expand a parameter grid into configurations
+ * 
+ * @param base Base configuration for every grid point
+ * @param grid Parameter grid
+ * @param configs Output array of configurations (caller frees with free())
+ * @param num_configs Output number of configurations
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_sweep_expand(const SimConfig* base, const SimSweepGrid* grid,
+                     SimConfig** configs, int* num_configs);
+
+/**
+ * @brief Run many configurations concurrently
+ * 
+ * Every configuration is split into packet-range subtasks that idle
+ * threads pick up from any configuration, so one long run does not leave
+ * cores idle at the end. Configurations start largest first. Each
+ * configuration's results are identical to a sim_run() of it. Tracking
+ * configurations run as a single task through sim_run_with_tracking().
+ * With sim_cache_set_dir() set, cached configurations are served (or
+ * topped up) from the result cache instead of rerun.
+ * 
+ * @param configs Configurations to run
+ * @param num_configs Number of configurations
+ * @param num_threads Worker threads (0 = all available)
+ * @param results Output array of num_configs results; entry i is valid
+ *                when status[i] is FSO_SUCCESS and must then be freed
+ * @param status Output array of num_configs per-configuration error codes
+ * @return Number of configurations that ran successfully
+ */
+int sim_run_configs(const SimConfig* configs, int num_configs, int num_threads,
+                    SimResults* results, int* status);
+
+/**
+ * @brief Run a sweep and summarize each configuration as a table row
+ * 
+ * Scheduled like sim_run_configs(), but each configuration's results are
+ * summarized into its row and freed as soon as it completes, so memory
+ * stays bounded by the number of configurations in flight.
+ * 
+ * @param configs Configurations to run
+ * @param num_configs Number of configurations
+ * @param num_threads Worker threads (0 = all available)
+ * @param rows Output array of num_configs rows, in configuration order
+ * @return Number of configurations that ran successfully
+ */
+int sim_run_sweep(const SimConfig* configs, int num_configs, int num_threads,
+                  SimSweepRow* rows);
+
+/**
+ * @brief Print the consolidated sweep table
+ * 
+ * @param rows Sweep rows
+ * @param num_rows Number of rows
+ */
+void sim_sweep_print_table(const SimSweepRow* rows, int num_rows);
+
+/**
+ * @brief Export the consolidated sweep table to CSV
+ * 
+ * @param rows Sweep rows
+ * @param num_rows Number of rows
+ * @param filename Path to output CSV file
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_sweep_export_csv(const SimSweepRow* rows, int num_rows, const char* filename);
+
+/**
+ * @brief Summarize one configuration's results as a sweep row
+ *
+ * @param config Configuration that was run
+ * @param index Index of the configuration in the sweep
+ * @param status FSO_SUCCESS, or the run's error code (results unused then)
+ * @param results Results of the run
+ * @param row Output row
+ */
+void sim_sweep_fill_row(const SimConfig* config, int index, int status,
+                        const SimResults* results, SimSweepRow* row);
+
+/**
+ * @brief Run packets [begin, end) of a configuration, keeping aggregates only
+ *
+ * The fading chain is replayed from packet 0 and every packet draws from
+ * its own (run seed, packet) RNG streams, so merging the ranges of a run
+ * with sim_results_merge() matches a whole sim_run() of it (up to
+ * summation order). Uses control.num_threads threads.
+ *
+ * @param config Configuration (fixed budget, tracking disabled)
+ * @param begin First packet
+ * @param end One past the last packet (<= control.num_packets)
+ * @param results Output aggregates-only results (free with sim_results_free)
+ * @return FSO_SUCCESS, or FSO_ERROR_UNSUPPORTED under a stopping rule or
+ *         with tracking
+ */
+int sim_run_packet_range(const SimConfig* config, int begin, int end, SimResults* results);
+
+/**
+ * @brief Run a whole configuration, keeping aggregates only
+ *
+ * Same schedule as a sweep entry, on control.num_threads threads.
+ *
+ * @param config Configuration to run
+ * @param results Output aggregates-only results (free with sim_results_free)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_aggregates(const SimConfig* config, SimResults* results);
+
+/* ============================================================================
+ * Checkpoint Functions
+ * ============================================================================ */
+
+/**
+ * @brief Save the state of a sim_run() between blocks
+ * 
+ * Records the configuration (with the resolved seed), the next packet,
+ * the channel's fading state, the accumulators in results, and either the
+ * in-memory history and packet arrays or the results stream's sync
+ * point. Packets draw from (seed, packet) RNG streams, so no generator
+ * position is needed. The file is written to <file>.tmp and renamed over
+ * the previous checkpoint, so an interruption leaves the last one intact.
+ * 
+ * @param config Configuration of the run (control.checkpoint_file names the file)
+ * @param run_seed Resolved run seed
+ * @param next_packet First packet not yet merged into results
+ * @param channel Channel model after the fade of packet next_packet - 1
+ * @param results Results so far (a results stream is synced)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_checkpoint_save(const SimConfig* config, uint64_t run_seed, int next_packet,
+                        const ChannelModel* channel, SimResults* results);
+
+/**
+ * @brief Read the configuration stored in a checkpoint
+ * 
+ * @param filename Checkpoint path
+ * @param config Output configuration (seed resolved, checkpoint_file set)
+ * @return FSO_SUCCESS, FSO_ERROR_IO, or FSO_ERROR_UNSUPPORTED for a
+ *         checkpoint from a different build
+ */
+int sim_checkpoint_read_config(const char* filename, SimConfig* config);
+
+/**
+ * @brief Restore a run's state from its checkpoint
+ * 
+ * @param config Configuration from sim_checkpoint_read_config()
+ * @param channel Channel initialized for config; its fading state is restored
+ * @param results Output results, set up as sim_results_init_run() would
+ *                and filled with the saved state
+ * @param next_packet Output first packet to simulate
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_checkpoint_restore(const SimConfig* config, ChannelModel* channel,
+                           SimResults* results, int* next_packet);
+
+/**
+ * @brief Continue a checkpointed sim_run()
+ * 
+ * Resumes from config->control.checkpoint_file and keeps checkpointing
+ * there. The results are bit-identical to an uninterrupted run; only
+ * num_threads, verbose and checkpoint_interval may differ from the
+ * configuration read with sim_checkpoint_read_config().
+ * 
+ * @param config Configuration from sim_checkpoint_read_config()
+ * @param results Output results structure
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_resume(const SimConfig* config, SimResults* results);
+
+/* ============================================================================
+ * Result Cache Functions
+ * ============================================================================ */
+
+/**
+ * @brief Set the result cache directory
+ *
+ * sim_run_configs() and sim_run_sweep() (and so sim_run_batch()) look
+ * each configuration up here before simulating it and store what they
+ * run. The cache is off until a directory is set; call this before
+ * starting runs. The directory is created if missing.
+ *
+ * @param dir Cache directory (NULL or "" turns the cache off)
+ * @return FSO_SUCCESS on success, FSO_ERROR_IO if it cannot be created
+ */
+int sim_cache_set_dir(const char* dir);
+
+/**
+ * @brief Current result cache directory
+ *
+ * @return Directory, or NULL when the cache is off
+ */
+const char* sim_cache_dir(void);
+
+/**
+ * @brief Content hash of a configuration
+ *
+ * Hashes a canonical encoding of every field that affects results, the
+ * seed as configured and FSO_VERSION_STRING. Threads, verbosity and
+ * output paths are left out. Fixed-budget configurations without
+ * tracking are keyed by their time per packet instead of num_packets and
+ * simulation_time, so one entry serves every budget of the same run.
+ *
+ * @param config Configuration
+ * @return 64-bit key (names the entry file)
+ */
+uint64_t sim_cache_key(const SimConfig* config);
+
+/**
+ * @brief Load a configuration's results from the cache
+ *
+ * An entry covering exactly num_packets is a hit. A fixed-budget entry
+ * covering fewer packets is also returned without keep_history, for the
+ * caller to top up with packets [cached_packets, num_packets) under
+ * run_seed; with keep_history it is a miss.
+ *
+ * @param config Configuration
+ * @param keep_history Require the history and packet arrays
+ * @param results Output results (aggregates only without keep_history;
+ *                free with sim_results_free)
+ * @param run_seed Output seed the entry was simulated with
+ * @param cached_packets Output packets covered by the entry
+ * @return FSO_SUCCESS when results were loaded, FSO_ERROR_IO on a miss,
+ *         FSO_ERROR_UNSUPPORTED when the cache is off or config streams
+ *         its results
+ */
+int sim_cache_load(const SimConfig* config, int keep_history, SimResults* results,
+                   uint64_t* run_seed, int* cached_packets);
+
+/**
+ * @brief Store a configuration's results in the cache
+ *
+ * Written to a temporary file and renamed over the entry. An existing
+ * entry with more packets, or with arrays when results has none, is kept.
+ *
+ * @param config Configuration (key as configured)
+ * @param run_seed Seed the results were simulated with
+ * @param results Results covering control.num_packets packets
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_cache_store(const SimConfig* config, uint64_t run_seed, const SimResults* results);
+
+/* ============================================================================
+ * Distributed Sweep Functions
+ * ============================================================================ */
+
+/** Default packets per distributed work unit */
+#define SIM_DIST_CHUNK_PACKETS 16384
+
+/**
+ * @brief Initialize the process group (MPI_Init with FSO_ENABLE_MPI)
+ *
+ * Without FSO_ENABLE_MPI this is a single process of rank 0.
+ *
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_dist_init(int* argc, char*** argv);
+
+/**
+ * @brief Shut the process group down (safe to call more than once)
+ */
+void sim_dist_finalize(void);
+
+/** @brief Rank of this process (0 = coordinator) */
+int sim_dist_rank(void);
+
+/** @brief Number of processes in the group */
+int sim_dist_size(void);
+
+/**
+ * @brief Run a sweep across all processes
+ *
+ * Every rank calls this with the same configurations. Rank 0 resolves the
+ * run seeds, splits each fixed-budget configuration into packet ranges of
+ * chunk_packets and hands ranges out to the other ranks as they become
+ * free; configurations with a stopping rule or tracking go out whole.
+ * Workers return aggregates-only results, which rank 0 merges in range
+ * order into one row per configuration. With a single process, or without
+ * FSO_ENABLE_MPI, this is sim_run_sweep().
+ *
+ * @param configs Configurations to run (identical on every rank)
+ * @param num_configs Number of configurations
+ * @param num_threads Threads per process (0 = all available)
+ * @param chunk_packets Packets per work unit (0 = SIM_DIST_CHUNK_PACKETS)
+ * @param rows Output rows on rank 0 (unused on other ranks)
+ * @return Number of successful configurations on rank 0, 0 elsewhere
+ */
+int sim_run_sweep_distributed(const SimConfig* configs, int num_configs, int num_threads,
+                              int chunk_packets, SimSweepRow* rows);
+
+/**
+ * @brief Print the names and descriptions of the predefined scenarios
+ */
+void sim_list_scenarios(void);
+
+/**
+ * @brief Load a predefined scenario
+ * 
+ * @param config Output configuration
+ * @param scenario_name Scenario name
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_load_scenario(SimConfig* config, const char* scenario_name);
+
+/**
+ * @brief Get the description of a predefined scenario
+ * 
+ * @param scenario_name Scenario name
+ * @return Description, or NULL if the scenario is unknown
+ */
+const char* sim_get_scenario_description(const char* scenario_name);
+
+/**
+ * @brief Run several predefined scenarios concurrently
+ * 
+ * Scenarios run through sim_run_configs(); configurations, results and
+ * CSVs are then printed and written in scenario order.
+ * 
+ * @param scenario_names Scenario names
+ * @param num_scenarios Number of scenarios
+ * @param batch_results Output array of num_scenarios results
+ * @return Number of successful simulations
+ */
+int sim_run_batch(const char** scenario_names, int num_scenarios,
+                  BatchResult* batch_results);
+
+/**
+ * @brief Run all predefined scenarios
+ * 
+ * @param batch_results Output array (size >= number of scenarios)
+ * @return Number of successful simulations
+ */
+int sim_run_all_scenarios(BatchResult* batch_results);
+
+/**
+ * @brief Free batch results
+ * 
+ * @param batch_results Array of batch results
+ * @param num_results Number of results
+ */
+void sim_free_batch_results(BatchResult* batch_results, int num_results);
+
+/**
+ * @brief Print batch results summary
+ * 
+ * @param batch_results Array of batch results
+ * @param num_results Number of results
+ */
+void sim_print_batch_summary(const BatchResult* batch_results, int num_results);
+
+/* ============================================================================
+ * Packet Stage Functions
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the codec chain described by a configuration
+ * 
+ * @param link Link to initialize
+ * @param config Simulation configuration
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_link_init(SimLink* link, const SimConfig* config);
+
+/**
+ * @brief Free a codec chain
+ * 
+ * @param link Link to free
+ */
+void sim_link_free(SimLink* link);
+
+/**
+ * @brief Initialize the channel model described by a configuration
+ * 
+ * @param channel Channel to initialize
+ * @param config Simulation configuration
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_channel_init(ChannelModel* channel, const SimConfig* config);
+
+/**
+ * @brief Resolve the run seed (time-based when random_seed is 0)
+ * 
+ * @param config Simulation configuration
+ * @return Run seed for the per-packet RNG streams
+ */
+uint64_t sim_run_seed(const SimConfig* config);
+
+/**
+ * @brief Advance the channel's fading process by one packet
+ * 
+ * Must be called in packet order: the correlated fading chain is
+ * sequential in time. Draws from the packet's channel RNG stream. Under
+ * importance sampling the returned fade is tilted by
+ * control.is_fade_shift (the chain itself is not) and *log_weight holds
+ * its log-likelihood ratio.
+ * 
+ * Under intra-packet fading, the packet interval is split into
+ * sim_fade_profile_length() sub-blocks and their fades are written to
+ * profile from one channel_generate_fade_trace() call.
+ * 
+ * @param channel Channel model (fading state is updated)
+ * @param config Simulation configuration
+ * @param run_seed Run seed for the packet's RNG streams
+ * @param packet_id Packet identifier
+ * @param time_per_packet Packet interval in seconds (0 for uncorrelated)
+ * @param profile Output sub-block fades (sim_fade_profile_length() entries;
+ *                NULL when that is 0)
+ * @param log_weight Output log-likelihood ratio of the fade (0 if unbiased)
+ * @return Fading coefficient for the packet (the profile mean if one is drawn)
+ */
+double sim_stage_fade(ChannelModel* channel, const SimConfig* config, uint64_t run_seed,
+                      int packet_id, double time_per_packet, double* profile,
+                      double* log_weight);
+
+/**
+ * @brief One pointing-loop step of a tracked run
+ * 
+ * Called once per packet, in packet order, from sim_run()'s serial fade
+ * pass, so the loop may keep state across packets.
+ * 
+ * @param context Caller state passed to sim_run_pointed()
+ * @param packet_id Packet identifier
+ * @param time_step Packet interval in seconds
+ * @param azimuth Output beam azimuth for the packet's time-series point
+ * @param elevation Output beam elevation for the packet's time-series point
+ * @return Pointing gain (0-1) applied to the packet's fade
+ */
+typedef double (*SimPointingFn)(void* context, int packet_id, double time_step,
+                                double* azimuth, double* elevation);
+
+/**
+ * @brief sim_run() with a pointing loop stepped once per packet
+ * 
+ * Each packet's fade (and fade profile) is scaled by the gain the pointing
+ * function returns, and its time-series point records the beam position.
+ * The results are marked tracking_enabled. Checkpoints do not hold the
+ * pointing state, so a pointed run is not checkpointed.
+ * 
+ * @param config Simulation configuration
+ * @param results Output results structure
+ * @param pointing Pointing step (NULL runs plain sim_run())
+ * @param context State passed to pointing
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_run_pointed(const SimConfig* config, SimResults* results,
+                    SimPointingFn pointing, void* context);
+
+/**
+ * @brief Fade sub-blocks per packet under intra-packet fading
+ * 
+ * Returns 0 (one gain per packet) when intra-packet fading is off, or
+ * when the correlation time is at least SIM_BLOCK_FADING_RATIO packet
+ * durations, so the fade barely moves within a packet.
+ * 
+ * @param config Simulation configuration
+ * @return Sub-blocks per packet, or 0 for block fading
+ */
+size_t sim_fade_profile_length(const SimConfig* config);
+
+/**
+ * @brief Received samples carrying one packet's codeword
+ * 
+ * Modulation symbols times samples per symbol (PPM slots); the frame
+ * length of a replayed capture.
+ * 
+ * @param config Simulation configuration
+ * @return Samples per packet
+ */
+size_t sim_packet_samples(const SimConfig* config);
+
+/**
+ * @brief Allocate a packet workspace
+ * 
+ * @param workspace Workspace to initialize
+ * @param capacity Bytes to reserve (rounded up to FSO_WORKSPACE_ALIGN)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_workspace_init(FSOPacketWorkspace* workspace, size_t capacity);
+
+/**
+ * @brief Carve an aligned region out of a workspace
+ * 
+ * @param workspace Initialized workspace
+ * @param bytes Region size
+ * @return Pointer to the region, or NULL if the workspace is exhausted
+ */
+void* sim_workspace_take(FSOPacketWorkspace* workspace, size_t bytes);
+
+/**
+ * @brief Release a workspace and every region taken from it
+ * 
+ * @param workspace Workspace to free
+ */
+void sim_workspace_free(FSOPacketWorkspace* workspace);
+
+/**
+ * @brief Workspace bytes needed by one packet of a configuration
+ * 
+ * @param config Simulation configuration
+ * @return Capacity for sim_workspace_init()
+ */
+size_t sim_packet_workspace_size(const SimConfig* config);
+
+/**
+ * @brief Allocate buffers for one in-flight packet
+ * 
+ * All buffers are carved from one workspace of
+ * sim_packet_workspace_size() bytes.
+ * 
+ * @param packet Packet to initialize
+ * @param config Simulation configuration
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_packet_init(SimPacket* packet, const SimConfig* config);
+
+/**
+ * @brief Free packet buffers
+ * 
+ * @param packet Packet to free
+ */
+void sim_packet_free(SimPacket* packet);
+
+/**
+ * @brief Generate, encode, interleave and modulate a packet
+ * 
+ * Resets the packet state and draws its payload from the packet's data
+ * RNG stream.
+ * 
+ * @param link Codec chain
+ * @param config Simulation configuration
+ * @param run_seed Run seed for the packet's RNG streams
+ * @param packet_id Packet identifier
+ * @param packet Packet slot
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stage_transmit(SimLink* link, const SimConfig* config, uint64_t run_seed,
+                       int packet_id, SimPacket* packet);
+
+/**
+ * @brief Apply channel loss and AWGN using packet->fading
+ * 
+ * Reads the channel without modifying it. With packet->fade_blocks set,
+ * each sub-block is scaled by its own gain from packet->fade_profile
+ * (kept in packet->gain_profile for the demodulator); the gain and the
+ * noise are applied in one pass over the symbols. Under importance sampling with
+ * control.is_noise_shift set, each noise sample's mean is moved toward
+ * the midpoint of the received symbol levels and the noise
+ * log-likelihood ratio is added to packet->log_weight, which the caller
+ * sets to the fade's log weight beforehand.
+ * 
+ * @param channel Channel model
+ * @param config Simulation configuration
+ * @param run_seed Run seed for the packet's RNG streams
+ * @param packet Packet slot
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stage_channel(const ChannelModel* channel, const SimConfig* config,
+                      uint64_t run_seed, SimPacket* packet);
+
+/**
+ * @brief Demodulate and deinterleave a packet
+ * 
+ * With system.soft_decision set, produces bit LLRs (packet->fec_llr) from
+ * the packet's channel gain and the noise floor instead of hard bytes.
+ * 
+ * @param link Codec chain
+ * @param config Simulation configuration
+ * @param packet Packet slot
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stage_demodulate(SimLink* link, const SimConfig* config, SimPacket* packet);
+
+/**
+ * @brief FEC-decode a packet
+ * 
+ * @param link Codec chain
+ * @param config Simulation configuration
+ * @param packet Packet slot
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_stage_decode(SimLink* link, const SimConfig* config, SimPacket* packet);
+
+/**
+ * @brief Count errors and fill the packet's statistics and time-series point
+ * 
+ * @param config Simulation configuration
+ * @param time_per_packet Packet interval in seconds
+ * @param packet Packet slot
+ * @param stats Output packet statistics
+ * @param point Output time-series point
+ * @return FSO_SUCCESS if the packet is recorded, its error status otherwise
+ */
+int sim_stage_collect(const SimConfig* config, double time_per_packet,
+                      const SimPacket* packet, PacketStats* stats,
+                      TimeSeriesPoint* point);
+
+/* ============================================================================
+ * Adaptive Modulation and Coding Functions
+ * ============================================================================ */
+
+/**
+ * @brief Fill the default mode ladder
+ * 
+ * 2-PPM and OOK with the standard LDPC rates (LDPC_RATE_1_2 to
+ * LDPC_RATE_5_6), thresholds from typical LDPC decoding SNRs. They are a
+ * starting point, not a calibration of this simulator's codecs.
+ * 
+ * @param modes Output ladder
+ * @return Number of modes
+ */
+int sim_amc_default_ladder(SimAMCMode modes[SIM_AMC_MAX_MODES]);
+
+/**
+ * @brief Configuration of one mode: the run's configuration with the
+ *        mode's modulation, PPM order and code rate
+ * 
+ * @param config Run configuration
+ * @param mode Ladder mode
+ * @param mode_config Output configuration
+ */
+void sim_amc_mode_config(const SimConfig* config, const SimAMCMode* mode, SimConfig* mode_config);
+
+/**
+ * @brief Configuration whose packet buffers fit every mode of a ladder
+ * 
+ * Highest PPM order (OOK if no PPM mode) and lowest code rate; packets
+ * initialized with it can be sent in any mode.
+ * 
+ * @param amc Initialized controller
+ * @param config Run configuration
+ * @param sizing Output configuration for sim_packet_init()
+ */
+void sim_amc_sizing_config(const SimAMCController* amc, const SimConfig* config,
+                           SimConfig* sizing);
+
+/**
+ * @brief Set up a controller from system.amc
+ * 
+ * @param amc Controller to initialize
+ * @param config Run configuration
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_amc_init(SimAMCController* amc, const SimConfig* config);
+
+/**
+ * @brief Fold one packet's pulse SNR estimate into the predictor
+ * 
+ * @param amc Controller
+ * @param snr_db Estimate from sim_amc_estimate_snr()
+ */
+void sim_amc_observe(SimAMCController* amc, double snr_db);
+
+/**
+ * @brief Predicted pulse SNR in dB at the prediction horizon
+ * 
+ * @param amc Controller
+ * @return Prediction, -INFINITY before the first estimate
+ */
+double sim_amc_predict(const SimAMCController* amc);
+
+/**
+ * @brief Choose the mode of the next feedback interval
+ * 
+ * @param amc Controller
+ * @return Ladder index (the most robust mode before any estimate)
+ */
+int sim_amc_select(SimAMCController* amc);
+
+/**
+ * @brief Receiver-side pulse SNR estimate of a demodulated packet
+ * 
+ * From the LLRs for soft-decision OOK, from decision-directed sample
+ * moments otherwise; needs no knowledge of the transmitted data.
+ * 
+ * @param packet Packet after sim_stage_demodulate()
+ * @param config Configuration the packet was sent with
+ * @return Pulse SNR in dB, clamped to [SIM_SNR_HIST_MIN_DB, SIM_SNR_HIST_MAX_DB]
+ */
+double sim_amc_estimate_snr(const SimPacket* packet, const SimConfig* config);
+
+/* ============================================================================
+ * Hybrid ARQ Functions
+ * ============================================================================ */
+
+/**
+ * @brief Split a mother codeword into incremental-redundancy transmissions
+ * 
+ * Every transmission sends ceil(k / initial_rate) positions of the
+ * rate-compatible order, continuing where the last one stopped and
+ * wrapping around at the end of the codeword.
+ * 
+ * @param schedule Schedule to initialize
+ * @param codec Initialized LDPC codec of the mother code
+ * @param harq HARQ parameters
+ * @return FSO_SUCCESS on success, FSO_ERROR_UNSUPPORTED for codecs other
+ *         than LDPC
+ */
+int sim_harq_schedule_init(SimHARQSchedule* schedule, const FECCodec* codec,
+                           const SimHARQConfig* harq);
+
+/**
+ * @brief Free a schedule
+ * @param schedule Schedule to free
+ */
+void sim_harq_schedule_free(SimHARQSchedule* schedule);
+
+/**
+ * @brief Codeword bytes of one transmission, in transmission order
+ * 
+ * @param schedule Initialized schedule
+ * @param round Transmission index (0 = first)
+ * @param codeword Encoded mother codeword
+ * @param segment Output bytes (segment_length)
+ * @return Bytes written (0 for an invalid round)
+ */
+size_t sim_harq_gather(const SimHARQSchedule* schedule, int round, const uint8_t* codeword,
+                       uint8_t* segment);
+
+/**
+ * @brief Add one transmission's LLRs into the combined codeword LLRs
+ * 
+ * Round 0 clears combined first, so positions not yet sent stay erased;
+ * positions sent again add to their earlier LLRs.
+ * 
+ * @param schedule Initialized schedule
+ * @param round Transmission index (0 = first)
+ * @param llr Demodulated LLRs of the transmission's segment (8 per byte)
+ * @param combined Codeword-order LLRs (8 * code_length)
+ */
+void sim_harq_combine(const SimHARQSchedule* schedule, int round, const float* llr,
+                      float* combined);
+
+/* ============================================================================
+ * Visualization Functions
+ * ============================================================================ */
+
+/**
+ * @brief Generate all visualization outputs for a simulation
+ * 
+ * @param config Simulation configuration
+ * @param results Simulation results
+ * @param base_filename Base filename for outputs (without extension)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sim_generate_all_visualizations(const SimConfig* config,
+                                    const SimResults* results,
+                                    const char* base_filename);
+
+/* ============================================================================
+ * Utility Functions
+ * ============================================================================ */
+
+/**
+ * @brief Get string representation of modulation type
+ * 
+ * @param type Modulation type
+ * @return String representation
+ */
+const char* sim_modulation_string(ModulationType type);
+
+/**
+ * @brief Get string representation of FEC type
+ * 
+ * @param type FEC type
+ * @return String representation
+ */
+const char* sim_fec_string(FECType type);
+
+/**
+ * @brief Get string representation of a signal path precision
+ * 
+ * @param precision Precision mode
+ * @return String representation
+ */
+const char* sim_precision_string(FSOPrecision precision);
 
 /**
  * @brief Get string representation of weather condition
@@ -5,6 +5,7 @@
 
 #include "beam_tracking.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 /* ============================================================================
@@ -78,18 +79,303 @@ int beam_track_find_peak(const BeamTracker* tracker,
     return FSO_SUCCESS;
 }
 
+/* ============================================================================
+ * Batched Measurement
+ * ============================================================================ */
+
+/** Single-point callback behind the batched interface */
+typedef struct {
+    BeamScanCallback callback;
+    void* user_data;
+} BeamScanPointAdapter;
+
+static int beam_scan_point_adapter(const double* azimuths, const double* elevations,
+                                   size_t count, double* strengths, void* user_data) {
+    const BeamScanPointAdapter* adapter = (const BeamScanPointAdapter*)user_data;
+    for (size_t i = 0; i < count; i++) {
+        strengths[i] = adapter->callback(azimuths[i], elevations[i], adapter->user_data);
+    }
+    return FSO_SUCCESS;
+}
+
+/** State shared by the scan strategies */
+typedef struct {
+    BeamTracker* tracker;
+    BeamScanBatchCallback callback;
+    void* user_data;
+    size_t batch_size;
+    int raster;                  /**< Record into the map as beam_track_scan() always did */
+    BeamScanStats stats;
+    int points_mapped;
+    double best_az;
+    double best_el;
+    double best_strength;
+} BeamScanState;
+
+/**
+ * @brief Measure positions in batches, record them and track the best one
+ */
+static int beam_scan_measure(BeamScanState* state, const double* azimuths,
+                             const double* elevations, size_t count, double* strengths) {
+    for (size_t offset = 0; offset < count; offset += state->batch_size) {
+        size_t n = FSO_MIN(state->batch_size, count - offset);
+        int result = state->callback(azimuths + offset, elevations + offset, n,
+                                     strengths + offset, state->user_data);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR("BeamTracking", "Scan measurement failed: %d", result);
+            return result;
+        }
+        state->stats.batches++;
+    }
+    state->stats.points_measured += (int)count;
+    
+    const SignalMap* map = state->tracker->strength_map;
+    for (size_t i = 0; i < count; i++) {
+        // Only the raster grid is meant to cover the map; other patterns
+        // record what lands inside it
+        if (state->raster ||
+            (azimuths[i] >= map->azimuth_min && azimuths[i] <= map->azimuth_max &&
+             elevations[i] >= map->elevation_min && elevations[i] <= map->elevation_max)) {
+            if (signal_map_set(state->tracker->strength_map, azimuths[i], elevations[i],
+                               strengths[i]) == FSO_SUCCESS) {
+                state->points_mapped++;
+            }
+        }
+        if (strengths[i] > state->best_strength) {
+            state->best_strength = strengths[i];
+            state->best_az = azimuths[i];
+            state->best_el = elevations[i];
+        }
+        
+        FSO_LOG_DEBUG("BeamTracking", "Scan point: az=%.3f, el=%.3f, strength=%.3f",
+                     azimuths[i], elevations[i], strengths[i]);
+    }
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Scan Strategies
+ * ============================================================================ */
+
+static int beam_scan_raster(BeamScanState* state, double az_range, double el_range,
+                            double resolution, double* az, double* el, double* strengths) {
+    double az_min = state->tracker->azimuth - az_range / 2.0;
+    double el_min = state->tracker->elevation - el_range / 2.0;
+    int az_points = (int)ceil(az_range / resolution) + 1;
+    int el_points = (int)ceil(el_range / resolution) + 1;
+    
+    FSO_LOG_INFO("BeamTracking", "Starting beam scan: %dx%d points, "
+                "az=[%.3f, %.3f], el=[%.3f, %.3f], res=%.6f",
+                az_points, el_points, az_min, az_min + az_range,
+                el_min, el_min + el_range, resolution);
+    
+    // Row by row, in the order of the original point-by-point scan
+    size_t count = 0;
+    for (int el_idx = 0; el_idx < el_points; el_idx++) {
+        for (int az_idx = 0; az_idx < az_points; az_idx++) {
+            az[count] = az_min + az_idx * resolution;
+            el[count] = el_min + el_idx * resolution;
+            if (++count == state->batch_size) {
+                int result = beam_scan_measure(state, az, el, count, strengths);
+                if (result != FSO_SUCCESS) {
+                    return result;
+                }
+                count = 0;
+            }
+        }
+    }
+    return (count > 0) ? beam_scan_measure(state, az, el, count, strengths) : FSO_SUCCESS;
+}
+
+static int beam_scan_hierarchical(BeamScanState* state, double az_range, double el_range,
+                                  const BeamScanParams* params) {
+    double center_az = state->tracker->azimuth;
+    double center_el = state->tracker->elevation;
+    double half_az = az_range / 2.0;
+    double half_el = el_range / 2.0;
+    int ratio = params->refine_ratio;
+    int window = 2 * ratio + 1;
+    
+    // Level positions are integer multiples of the level step around the
+    // start position, so refinement windows of nearby candidates coincide
+    double step = FSO_MAX(params->coarse_resolution, params->resolution);
+    int na = (int)floor(half_az / step + 1e-9);
+    int nb = (int)floor(half_el / step + 1e-9);
+    size_t coarse_points = (size_t)(2 * na + 1) * (size_t)(2 * nb + 1);
+    size_t refine_points = (size_t)params->top_k * (size_t)window * (size_t)window;
+    size_t capacity = FSO_MAX(coarse_points, refine_points);
+    
+    long long* ia = (long long*)malloc(capacity * sizeof(long long));
+    long long* ib = (long long*)malloc(capacity * sizeof(long long));
+    double* az = (double*)malloc(capacity * sizeof(double));
+    double* el = (double*)malloc(capacity * sizeof(double));
+    double* strengths = (double*)malloc(capacity * sizeof(double));
+    long long* candidates = (long long*)malloc(2 * (size_t)params->top_k * sizeof(long long));
+    if (!ia || !ib || !az || !el || !strengths || !candidates) {
+        FSO_LOG_ERROR("BeamTracking", "Failed to allocate scan buffers");
+        free(ia); free(ib); free(az); free(el); free(strengths); free(candidates);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_LOG_INFO("BeamTracking", "Starting hierarchical scan: %dx%d coarse points, "
+                "res=%.6f -> %.6f, top-%d, ratio %d",
+                2 * na + 1, 2 * nb + 1, step, params->resolution, params->top_k, ratio);
+    
+    size_t count = 0;
+    for (int b = -nb; b <= nb; b++) {
+        for (int a = -na; a <= na; a++) {
+            ia[count] = a;
+            ib[count] = b;
+            count++;
+        }
+    }
+    
+    int result = FSO_SUCCESS;
+    for (;;) {
+        for (size_t i = 0; i < count; i++) {
+            az[i] = center_az + (double)ia[i] * step;
+            el[i] = center_el + (double)ib[i] * step;
+        }
+        result = beam_scan_measure(state, az, el, count, strengths);
+        state->stats.levels++;
+        if (result != FSO_SUCCESS || step <= params->resolution * (1.0 + 1e-9)) {
+            break;
+        }
+        
+        // Top-K of this level to the front
+        size_t k = FSO_MIN((size_t)params->top_k, count);
+        for (size_t c = 0; c < k; c++) {
+            size_t best = c;
+            for (size_t i = c + 1; i < count; i++) {
+                if (strengths[i] > strengths[best]) {
+                    best = i;
+                }
+            }
+            long long ta = ia[c], tb = ib[c];
+            double ts = strengths[c];
+            ia[c] = ia[best]; ib[c] = ib[best]; strengths[c] = strengths[best];
+            ia[best] = ta; ib[best] = tb; strengths[best] = ts;
+        }
+        
+        // Next level: ±one current step around each candidate, without
+        // measuring a position twice
+        step /= (double)ratio;
+        for (size_t c = 0; c < k; c++) {
+            candidates[2 * c] = ia[c] * ratio;
+            candidates[2 * c + 1] = ib[c] * ratio;
+        }
+        count = 0;
+        for (size_t c = 0; c < k; c++) {
+            for (int db = -ratio; db <= ratio; db++) {
+                for (int da = -ratio; da <= ratio; da++) {
+                    long long a = candidates[2 * c] + da;
+                    long long b = candidates[2 * c + 1] + db;
+                    if (fabs((double)a * step) > half_az + 1e-12 ||
+                        fabs((double)b * step) > half_el + 1e-12) {
+                        continue;
+                    }
+                    size_t j = 0;
+                    while (j < count && (ia[j] != a || ib[j] != b)) {
+                        j++;
+                    }
+                    if (j == count) {
+                        ia[count] = a;
+                        ib[count] = b;
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+    
+    free(ia); free(ib); free(az); free(el); free(strengths); free(candidates);
+    return result;
+}
+
+static int beam_scan_spiral(BeamScanState* state, double az_range, double el_range,
+                            const BeamScanParams* params, double* az, double* el,
+                            double* strengths) {
+    double center_az = state->tracker->azimuth;
+    double center_el = state->tracker->elevation;
+    double step = params->resolution;
+    int na = (int)floor(az_range / 2.0 / step + 1e-9);
+    int nb = (int)floor(el_range / 2.0 / step + 1e-9);
+    int rings = FSO_MAX(na, nb);
+    double threshold = (params->stop_threshold > 0.0) ?
+                       params->stop_threshold : state->tracker->signal_threshold;
+    
+    FSO_LOG_INFO("BeamTracking", "Starting spiral scan: %d rings, res=%.6f, stop at %.3f",
+                rings, step, threshold);
+    
+    // Ring r walks the square max(|a|, |b|) = r: up the right side, left
+    // along the top, down the left side and right along the bottom
+    size_t count = 0;
+    for (int r = 0; r <= rings; r++) {
+        int perimeter = (r == 0) ? 1 : 8 * r;
+        for (int p = 0; p < perimeter; p++) {
+            int a = 0, b = 0;
+            if (r > 0) {
+                int side = p / (2 * r);
+                int t = p % (2 * r);
+                switch (side) {
+                    case 0:  a = r;         b = -r + 1 + t; break;
+                    case 1:  a = r - 1 - t; b = r;          break;
+                    case 2:  a = -r;        b = r - 1 - t;  break;
+                    default: a = -r + 1 + t; b = -r;        break;
+                }
+            }
+            if (abs(a) > na || abs(b) > nb) {
+                continue;
+            }
+            
+            az[count] = center_az + a * step;
+            el[count] = center_el + b * step;
+            int last = (r == rings && p == perimeter - 1);
+            if (++count == state->batch_size || last) {
+                int result = beam_scan_measure(state, az, el, count, strengths);
+                if (result != FSO_SUCCESS) {
+                    return result;
+                }
+                count = 0;
+                if (threshold > 0.0 && state->best_strength >= threshold) {
+                    state->stats.early_stop = 1;
+                    return FSO_SUCCESS;
+                }
+            }
+        }
+    }
+    return (count > 0) ? beam_scan_measure(state, az, el, count, strengths) : FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Beam Scanning
  * ============================================================================ */
 
-int beam_track_scan(BeamTracker* tracker,
-                    double az_range,
-                    double el_range,
-                    double resolution,
-                    BeamScanCallback callback,
-                    void* user_data) {
+void beam_scan_params_init(BeamScanParams* params, BeamScanMode mode, double resolution) {
+    if (params == NULL) {
+        return;
+    }
+    
+    params->mode = mode;
+    params->resolution = resolution;
+    params->refine_ratio = BEAM_SCAN_DEFAULT_REFINE_RATIO;
+    params->coarse_resolution = resolution * BEAM_SCAN_DEFAULT_REFINE_RATIO *
+                                BEAM_SCAN_DEFAULT_REFINE_RATIO;
+    params->top_k = BEAM_SCAN_DEFAULT_TOP_K;
+    params->stop_threshold = 0.0;
+    params->batch_size = BEAM_SCAN_DEFAULT_BATCH;
+}
+
+int beam_track_scan_batch(BeamTracker* tracker,
+                          double az_range,
+                          double el_range,
+                          const BeamScanParams* params,
+                          BeamScanBatchCallback callback,
+                          void* user_data,
+                          BeamScanStats* stats) {
     FSO_CHECK_NULL(tracker);
     FSO_CHECK_NULL(tracker->strength_map);
+    FSO_CHECK_NULL(params);
     FSO_CHECK_NULL(callback);
     
     if (az_range <= 0.0 || el_range <= 0.0) {
@@ -98,58 +384,76 @@ int beam_track_scan(BeamTracker* tracker,
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    if (resolution <= 0.0) {
-        FSO_LOG_ERROR("BeamTracking", "Invalid scan resolution: %.6f", resolution);
+    if (params->resolution <= 0.0) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid scan resolution: %.6f", params->resolution);
         return FSO_ERROR_INVALID_PARAM;
     }
     
-    // Calculate scan bounds centered on current position
-    double az_min = tracker->azimuth - az_range / 2.0;
-    double az_max = tracker->azimuth + az_range / 2.0;
-    double el_min = tracker->elevation - el_range / 2.0;
-    double el_max = tracker->elevation + el_range / 2.0;
-    
-    // Calculate number of scan points
-    int az_points = (int)ceil(az_range / resolution) + 1;
-    int el_points = (int)ceil(el_range / resolution) + 1;
+    if (params->mode == BEAM_SCAN_HIERARCHICAL &&
+        (params->refine_ratio < 2 || params->top_k < 1 || params->coarse_resolution <= 0.0)) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid hierarchical scan: ratio=%d, top_k=%d, coarse=%.6f",
+                     params->refine_ratio, params->top_k, params->coarse_resolution);
+        return FSO_ERROR_INVALID_PARAM;
+    }
     
-    FSO_LOG_INFO("BeamTracking", "Starting beam scan: %dx%d points, "
-                "az=[%.3f, %.3f], el=[%.3f, %.3f], res=%.6f",
-                az_points, el_points, az_min, az_max, el_min, el_max, resolution);
+    BeamScanState state;
+    memset(&state, 0, sizeof(state));
+    state.tracker = tracker;
+    state.callback = callback;
+    state.user_data = user_data;
+    state.batch_size = (params->batch_size > 0) ? params->batch_size : BEAM_SCAN_DEFAULT_BATCH;
+    state.raster = (params->mode == BEAM_SCAN_RASTER);
+    state.best_strength = -INFINITY;
     
     // Clear existing map data
     signal_map_clear(tracker->strength_map);
     
-    // Perform scan
-    int points_scanned = 0;
-    for (int el_idx = 0; el_idx < el_points; el_idx++) {
-        double elevation = el_min + el_idx * resolution;
-        
-        for (int az_idx = 0; az_idx < az_points; az_idx++) {
-            double azimuth = az_min + az_idx * resolution;
-            
-            // Measure signal strength at this position using callback
-            double strength = callback(azimuth, elevation, user_data);
-            
-            // Update signal map
-            int result = signal_map_set(tracker->strength_map, azimuth, elevation, strength);
-            if (result == FSO_SUCCESS) {
-                points_scanned++;
-            }
-            
-            FSO_LOG_DEBUG("BeamTracking", "Scan point [%d,%d]: az=%.3f, el=%.3f, strength=%.3f",
-                         az_idx, el_idx, azimuth, elevation, strength);
+    int result;
+    if (params->mode == BEAM_SCAN_HIERARCHICAL) {
+        result = beam_scan_hierarchical(&state, az_range, el_range, params);
+    } else if (params->mode == BEAM_SCAN_RASTER || params->mode == BEAM_SCAN_SPIRAL) {
+        double* az = (double*)malloc(state.batch_size * sizeof(double));
+        double* el = (double*)malloc(state.batch_size * sizeof(double));
+        double* strengths = (double*)malloc(state.batch_size * sizeof(double));
+        if (!az || !el || !strengths) {
+            FSO_LOG_ERROR("BeamTracking", "Failed to allocate scan buffers");
+            result = FSO_ERROR_MEMORY;
+        } else if (state.raster) {
+            state.stats.levels = 1;
+            result = beam_scan_raster(&state, az_range, el_range, params->resolution,
+                                      az, el, strengths);
+        } else {
+            state.stats.levels = 1;
+            result = beam_scan_spiral(&state, az_range, el_range, params, az, el, strengths);
         }
+        free(az); free(el); free(strengths);
+    } else {
+        FSO_LOG_ERROR("BeamTracking", "Unknown scan mode: %d", (int)params->mode);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (stats) {
+        *stats = state.stats;
+    }
+    if (result != FSO_SUCCESS) {
+        return result;
     }
     
     tracker->scan_count++;
     
-    FSO_LOG_INFO("BeamTracking", "Scan complete: %d points scanned (scan #%d)",
-                points_scanned, tracker->scan_count);
+    FSO_LOG_INFO("BeamTracking", "Scan complete: %d points scanned in %d batches (scan #%d)",
+                state.stats.points_measured, state.stats.batches, tracker->scan_count);
     
-    // Find peak in scanned data
-    double peak_az, peak_el, peak_strength;
-    int result = beam_track_find_peak(tracker, &peak_az, &peak_el, &peak_strength);
+    // The raster peak comes from the map; the other patterns keep the
+    // exact position of their best measurement
+    double peak_az = state.best_az;
+    double peak_el = state.best_el;
+    double peak_strength = state.best_strength;
+    if (state.raster) {
+        result = beam_track_find_peak(tracker, &peak_az, &peak_el, &peak_strength);
+    } else {
+        result = (state.stats.points_measured > 0) ? FSO_SUCCESS : FSO_ERROR_CONVERGENCE;
+    }
     if (result == FSO_SUCCESS) {
         // Update tracker position to peak
         tracker->azimuth = peak_az;
@@ -162,3 +466,18 @@ int beam_track_scan(BeamTracker* tracker,
     
     return FSO_SUCCESS;
 }
+
+int beam_track_scan(BeamTracker* tracker,
+                    double az_range,
+                    double el_range,
+                    double resolution,
+                    BeamScanCallback callback,
+                    void* user_data) {
+    FSO_CHECK_NULL(callback);
+    
+    BeamScanParams params;
+    beam_scan_params_init(&params, BEAM_SCAN_RASTER, resolution);
+    BeamScanPointAdapter adapter = { callback, user_data };
+    return beam_track_scan_batch(tracker, az_range, el_range, &params,
+                                 beam_scan_point_adapter, &adapter, NULL);
+}
@@ -301,6 +301,9 @@ int beam_track_init(BeamTracker* tracker,
         return FSO_ERROR_MEMORY;
     }
     
+    // Predictive tracking is off until configured
+    tracker->kalman = NULL;
+    
     // Initialize misalignment detection
     tracker->signal_threshold = 0.1;  // Default threshold (10% of max)
     tracker->misaligned = 0;
@@ -326,5 +329,9 @@ void beam_track_free(BeamTracker* tracker) {
             pid_free(tracker->pid);
             tracker->pid = NULL;
         }
+        if (tracker->kalman) {
+            free(tracker->kalman);
+            tracker->kalman = NULL;
+        }
     }
 }
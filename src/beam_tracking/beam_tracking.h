@@ -52,6 +52,42 @@ typedef struct {
     double dt;                 /**< Time step (1/update_rate) */
 } PIDController;
 
+/**
+ * @brief Motion model of the predictive (Kalman) tracker
+ */
+typedef enum {
+    BEAM_KALMAN_CONSTANT_VELOCITY = 2,     /**< Angle and rate; white acceleration */
+    BEAM_KALMAN_CONSTANT_ACCELERATION = 3  /**< Angle, rate and acceleration; white jerk */
+} BeamKalmanModel;
+
+/**
+ * @brief Predictive tracker configuration
+ */
+typedef struct {
+    BeamKalmanModel model;     /**< Motion model of the optimal pointing direction */
+    double update_rate;        /**< Control loop update rate (Hz) */
+    double process_noise;      /**< Spectral density of the driving noise (rad²/s³ CV, rad²/s⁵ CA) */
+    double measurement_noise;  /**< Variance of one dither position fix (rad²) */
+    int dither_interval;       /**< Control steps per dither measurement (>= 1) */
+    double dither_angle;       /**< Dither offset from the pointing direction (radians) */
+    double beam_width;         /**< Gaussian 1/e² beam radius (radians, 0 = estimate from dithers) */
+} BeamKalmanParams;
+
+/**
+ * @brief Predictive tracker state: one filter per axis (azimuth, elevation)
+ */
+typedef struct {
+    BeamKalmanParams params;   /**< Configuration */
+    double state[2][3];        /**< Angle, rate, acceleration of the optimum per axis */
+    double covariance[2][3][3]; /**< State covariance per axis */
+    int steps_since_dither;    /**< Control steps since the last dither */
+    int measurements;          /**< Signal measurements taken */
+    int dithers;               /**< Dither cycles */
+    int rejected;              /**< Dither axes without a usable peak curvature */
+    double curvature[2];       /**< Smoothed ln-strength curvature across a dither, per axis */
+    double innovation[2];      /**< Last position innovation per axis (radians) */
+} BeamKalman;
+
 /**
  * @brief Beam tracker state and configuration
  * 
@@ -86,6 +122,9 @@ typedef struct {
     // PID controller
     PIDController* pid;        /**< PID feedback controller */
     
+    // Predictive tracker
+    BeamKalman* kalman;        /**< Kalman tracker (NULL unless configured) */
+    
     // Misalignment detection
     double signal_threshold;   /**< Minimum acceptable signal strength */
     int misaligned;            /**< Flag indicating misalignment detected */
@@ -96,6 +135,52 @@ typedef struct {
     int scan_count;            /**< Total number of full scans performed */
 } BeamTracker;
 
+/**
+ * @brief State of many trackers as structure-of-arrays
+ * 
+ * Per-tracker state lives in parallel arrays of length count, so one pass
+ * advances every link with SIMD (and OpenMP threads for large banks).
+ * Tuning is shared across the bank. A bank keeps no signal maps: gradient
+ * updates take gradients measured by the caller.
+ */
+typedef struct {
+    size_t count;              /**< Number of trackers */
+    
+    // Per-tracker state
+    double* azimuth;           /**< Azimuth angles (radians) */
+    double* elevation;         /**< Elevation angles (radians) */
+    double* signal_strength;   /**< Last measured signal strengths */
+    double* step_size;         /**< Adaptive gradient step sizes */
+    double* velocity_az;       /**< Azimuth momentum terms */
+    double* velocity_el;       /**< Elevation momentum terms */
+    double* integral_az;       /**< PID azimuth integrals */
+    double* integral_el;       /**< PID elevation integrals */
+    double* prev_error_az;     /**< PID previous azimuth errors */
+    double* prev_error_el;     /**< PID previous elevation errors */
+    double* signal_threshold;  /**< Misalignment thresholds */
+    int* convergence_count;    /**< Iterations since last significant update */
+    int* misaligned;           /**< Misalignment flags */
+    int* update_count;         /**< Tracking updates per tracker */
+    
+    // Shared gradient descent tuning
+    double momentum;           /**< Momentum coefficient (0-1) */
+    double step_size_min;      /**< Minimum step size */
+    double step_size_max;      /**< Maximum step size */
+    double step_adapt_factor;  /**< Step size adaptation factor */
+    int convergence_threshold; /**< Iterations required to declare convergence */
+    double convergence_epsilon; /**< Minimum change to reset convergence counter */
+    
+    // Shared PID tuning
+    double kp;                 /**< Proportional gain */
+    double ki;                 /**< Integral gain */
+    double kd;                 /**< Derivative gain */
+    double dt;                 /**< Time step (1/update_rate) */
+    double integral_limit;     /**< Anti-windup limit for integral term */
+    
+    double* storage;           /**< Backing block of the double arrays */
+    int* int_storage;          /**< Backing block of the int arrays */
+} BeamTrackerBank;
+
 /* ============================================================================
  * Initialization and Cleanup
  * ============================================================================ */
@@ -365,6 +450,60 @@ int beam_track_reset_pid(BeamTracker* tracker);
  */
 typedef double (*BeamScanCallback)(double azimuth, double elevation, void* user_data);
 
+/**
+ * @brief Batched callback function for beam scanning
+ * 
+ * Measures signal strength at count beam positions in one call, so the
+ * hardware or a simulated link can evaluate many angles together (e.g. in
+ * parallel, or along one sweep of the steering mirror).
+ * 
+ * @param azimuths Azimuth angles to measure (radians)
+ * @param elevations Elevation angles to measure (radians)
+ * @param count Number of positions
+ * @param strengths Output: measured signal strength per position
+ * @param user_data User-provided context data
+ * @return FSO_SUCCESS, or an error code that aborts the scan
+ */
+typedef int (*BeamScanBatchCallback)(const double* azimuths, const double* elevations,
+                                     size_t count, double* strengths, void* user_data);
+
+/** Default scan parameters (see beam_scan_params_init) */
+#define BEAM_SCAN_DEFAULT_REFINE_RATIO 3
+#define BEAM_SCAN_DEFAULT_TOP_K 3
+#define BEAM_SCAN_DEFAULT_BATCH 256
+
+/**
+ * @brief Beam scan search strategy
+ */
+typedef enum {
+    BEAM_SCAN_RASTER = 0,        /**< Exhaustive grid at the final resolution */
+    BEAM_SCAN_HIERARCHICAL = 1,  /**< Coarse grid, then finer grids around the top-K candidates */
+    BEAM_SCAN_SPIRAL = 2         /**< Outward square spiral, stopping once a point reaches the threshold */
+} BeamScanMode;
+
+/**
+ * @brief Beam scan parameters
+ */
+typedef struct {
+    BeamScanMode mode;           /**< Search strategy */
+    double resolution;           /**< Final angular resolution (radians) */
+    double coarse_resolution;    /**< First-level resolution of a hierarchical scan (radians) */
+    int refine_ratio;            /**< Resolution divisor between hierarchical levels (>= 2) */
+    int top_k;                   /**< Candidates refined per hierarchical level */
+    double stop_threshold;       /**< Spiral stop strength (0 = tracker signal_threshold) */
+    size_t batch_size;           /**< Maximum positions per callback (0 = BEAM_SCAN_DEFAULT_BATCH) */
+} BeamScanParams;
+
+/**
+ * @brief Cost of a beam scan
+ */
+typedef struct {
+    int points_measured;         /**< Positions measured */
+    int batches;                 /**< Callback invocations */
+    int levels;                  /**< Grids scanned (hierarchical), 1 otherwise */
+    int early_stop;              /**< 1 if a spiral scan stopped at the threshold */
+} BeamScanStats;
+
 /**
  * @brief Perform full angular scan to build signal strength map
  * 
@@ -388,6 +527,52 @@ int beam_track_scan(BeamTracker* tracker,
                     BeamScanCallback callback,
                     void* user_data);
 
+/**
+ * @brief Initialize beam scan parameters with defaults
+ * 
+ * Hierarchical scans start at resolution * refine_ratio² (two refinement
+ * levels) and refine the BEAM_SCAN_DEFAULT_TOP_K best positions per level.
+ * 
+ * @param params Parameters to initialize
+ * @param mode Search strategy
+ * @param resolution Final angular resolution (radians)
+ */
+void beam_scan_params_init(BeamScanParams* params, BeamScanMode mode, double resolution);
+
+/**
+ * @brief Perform an angular scan with batched measurements
+ * 
+ * Searches the specified azimuth and elevation ranges around the current
+ * position and moves the tracker to the strongest position found.
+ * 
+ * - Raster: the beam_track_scan() grid, measured in batches; the peak is
+ *   taken from the signal map.
+ * - Hierarchical: a coarse grid, then grids refine_ratio times finer over
+ *   ±one coarser step around the top_k positions of the previous level,
+ *   down to the final resolution.
+ * - Spiral: positions at the final resolution in an outward square
+ *   spiral, stopping after the first batch that reaches stop_threshold.
+ * 
+ * Hierarchical and spiral scans move to the best measured position and
+ * record measurements that fall inside the signal map.
+ * 
+ * @param tracker Beam tracker
+ * @param az_range Angular range for azimuth scan (radians, ±range/2 from current)
+ * @param el_range Angular range for elevation scan (radians, ±range/2 from current)
+ * @param params Scan parameters
+ * @param callback Function to measure signal strength at a batch of positions
+ * @param user_data User data passed to callback function
+ * @param stats Output: scan cost (may be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_track_scan_batch(BeamTracker* tracker,
+                          double az_range,
+                          double el_range,
+                          const BeamScanParams* params,
+                          BeamScanBatchCallback callback,
+                          void* user_data,
+                          BeamScanStats* stats);
+
 /**
  * @brief Find peak signal strength in the signal map
  * 
@@ -420,6 +605,58 @@ int beam_track_update_map(BeamTracker* tracker,
                           double elevation,
                           double strength);
 
+/* ============================================================================
+ * Predictive (Kalman) Tracking
+ * ============================================================================ */
+
+/**
+ * @brief Initialize predictive tracker parameters with defaults
+ * 
+ * Constant-velocity model, a dither every 16 control steps, process noise
+ * 10·dither_angle² per s³, a measurement noise of (dither_angle / 4)² and
+ * a beam width estimated from the dithers.
+ * 
+ * @param params Parameters to initialize
+ * @param update_rate Control loop update rate (Hz)
+ * @param dither_angle Dither offset (radians), a fraction of the beam width
+ */
+void beam_kalman_params_init(BeamKalmanParams* params, double update_rate, double dither_angle);
+
+/**
+ * @brief Enable predictive tracking
+ * 
+ * Starts a filter per axis at the current beam position, at rest. A
+ * tracker configured again restarts its filter.
+ * 
+ * @param tracker Beam tracker
+ * @param params Predictive tracker parameters
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_track_configure_kalman(BeamTracker* tracker, const BeamKalmanParams* params);
+
+/**
+ * @brief One control step of the predictive tracker
+ * 
+ * Predicts the optimal pointing direction one step ahead and points the
+ * beam there. Every dither_interval steps it measures the signal at the
+ * predicted direction and at ±dither_angle on each axis (one batch of
+ * five), fits a Gaussian peak per axis from the log-strengths, and
+ * corrects the filter with the fitted peak position (at most four dither
+ * offsets away). Steps in between
+ * take no measurements, so platform sway is followed at the control rate
+ * with a fraction of the measurements of beam_track_update().
+ * 
+ * @param tracker Beam tracker with beam_track_configure_kalman() applied
+ * @param callback Function to measure signal strength at a batch of positions
+ * @param user_data User data for callback
+ * @param measured Output: 1 if this step measured (may be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_track_kalman_update(BeamTracker* tracker,
+                             BeamScanBatchCallback callback,
+                             void* user_data,
+                             int* measured);
+
 /* ============================================================================
  * Misalignment Detection and Recovery
  * ============================================================================ */
@@ -472,6 +709,30 @@ int beam_track_reacquire(BeamTracker* tracker,
                          BeamScanCallback callback,
                          void* user_data);
 
+/**
+ * @brief Perform beam reacquisition with a batched scan
+ * 
+ * Same procedure as beam_track_reacquire(), with the search done by
+ * beam_track_scan_batch(). Hierarchical or spiral scans cut the number
+ * of measurements, and so the outage, after a deep misalignment.
+ * 
+ * @param tracker Beam tracker
+ * @param az_search_range Azimuth search range (radians)
+ * @param el_search_range Elevation search range (radians)
+ * @param params Scan parameters
+ * @param callback Function to measure signal strength at a batch of positions
+ * @param user_data User data for callback
+ * @param stats Output: scan cost (may be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_track_reacquire_batch(BeamTracker* tracker,
+                               double az_search_range,
+                               double el_search_range,
+                               const BeamScanParams* params,
+                               BeamScanBatchCallback callback,
+                               void* user_data,
+                               BeamScanStats* stats);
+
 /**
  * @brief Perform initial calibration routine
  * 
@@ -511,4 +772,118 @@ int beam_track_get_status(const BeamTracker* tracker,
                           int* is_converged,
                           int* is_reacquiring);
 
+/* ============================================================================
+ * Tracker Banks
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a bank of trackers
+ * 
+ * Every tracker starts with the defaults of beam_track_init() and the
+ * default PID controller.
+ * 
+ * @param bank Bank to initialize
+ * @param count Number of trackers (> 0)
+ * @param initial_az Initial azimuths (count entries, NULL for 0)
+ * @param initial_el Initial elevations (count entries, NULL for 0)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_init(BeamTrackerBank* bank, size_t count,
+                   const double* initial_az, const double* initial_el);
+
+/**
+ * @brief Free a bank's arrays
+ * 
+ * @param bank Bank to free
+ */
+void beam_bank_free(BeamTrackerBank* bank);
+
+/**
+ * @brief Set the bank's PID gains and reset every controller
+ * 
+ * @param bank Tracker bank
+ * @param kp Proportional gain
+ * @param ki Integral gain
+ * @param kd Derivative gain
+ * @param update_rate Control loop update rate (Hz)
+ * @param integral_limit Anti-windup limit for integral term
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_configure_pid(BeamTrackerBank* bank,
+                            double kp, double ki, double kd,
+                            double update_rate, double integral_limit);
+
+/**
+ * @brief Gradient descent step for every tracker
+ * 
+ * Same step as beam_track_update() (adaptive step size, momentum,
+ * convergence), with the gradient at each tracker's position supplied
+ * instead of estimated from a signal map.
+ * 
+ * @param bank Tracker bank
+ * @param strengths Measured signal strengths (count entries, >= 0)
+ * @param grad_az Azimuth gradients of the signal strength (count entries)
+ * @param grad_el Elevation gradients of the signal strength (count entries)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_update(BeamTrackerBank* bank, const double* strengths,
+                     const double* grad_az, const double* grad_el);
+
+/**
+ * @brief PID control step for every tracker
+ * 
+ * Same step as beam_track_pid_update() for each tracker.
+ * 
+ * @param bank Tracker bank
+ * @param target_az Target azimuths (count entries)
+ * @param target_el Target elevations (count entries)
+ * @param strengths Measured signal strengths (count entries, >= 0)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_pid_update(BeamTrackerBank* bank,
+                         const double* target_az, const double* target_el,
+                         const double* strengths);
+
+/**
+ * @brief Misalignment check for every tracker
+ * 
+ * Stores each strength and sets each misaligned flag as
+ * beam_track_check_misalignment() does.
+ * 
+ * @param bank Tracker bank
+ * @param strengths Measured signal strengths (count entries, >= 0)
+ * @param num_misaligned Output: number of misaligned trackers (may be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_check_misalignment(BeamTrackerBank* bank, const double* strengths,
+                                 size_t* num_misaligned);
+
+/**
+ * @brief Copy one bank tracker into a single-tracker view
+ * 
+ * Fills the state and tuning of an initialized tracker (including its PID
+ * controller) from tracker index, so the single-tracker API (scans,
+ * reacquisition, Kalman tracking) can run on one link. The tracker's own
+ * signal map is kept.
+ * 
+ * @param bank Tracker bank
+ * @param index Tracker index
+ * @param tracker Initialized tracker to fill
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_load(const BeamTrackerBank* bank, size_t index, BeamTracker* tracker);
+
+/**
+ * @brief Write a single-tracker view back into the bank
+ * 
+ * Copies the per-tracker state (not the shared tuning) of tracker into
+ * bank index.
+ * 
+ * @param bank Tracker bank
+ * @param index Tracker index
+ * @param tracker Tracker to copy from
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+int beam_bank_store(BeamTrackerBank* bank, size_t index, const BeamTracker* tracker);
+
 #endif /* BEAM_TRACKING_H */
@@ -130,15 +130,10 @@ int beam_track_is_converged(const BeamTracker* tracker) {
  * Gradient Descent Update
  * ============================================================================ */
 
-int beam_track_update(BeamTracker* tracker, double measured_strength) {
-    FSO_CHECK_NULL(tracker);
-    FSO_CHECK_NULL(tracker->strength_map);
-    
-    if (measured_strength < 0.0) {
-        FSO_LOG_ERROR("BeamTracking", "Invalid signal strength: %.3f", measured_strength);
-        return FSO_ERROR_INVALID_PARAM;
-    }
-    
+/**
+ * @brief One gradient-ascent step on a validated measurement
+ */
+static int beam_track_gradient_step(BeamTracker* tracker, double measured_strength) {
     // Store previous signal strength for improvement calculation
     double prev_strength = tracker->signal_strength;
     
@@ -227,3 +222,19 @@ int beam_track_update(BeamTracker* tracker, double measured_strength) {
     
     return FSO_SUCCESS;
 }
+
+int beam_track_update(BeamTracker* tracker, double measured_strength) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(tracker->strength_map);
+    
+    if (measured_strength < 0.0) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid signal strength: %.3f", measured_strength);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_TRACKING);
+    int result = beam_track_gradient_step(tracker, measured_strength);
+    FSO_PROF_END(FSO_PROF_TRACKING);
+    
+    return result;
+}
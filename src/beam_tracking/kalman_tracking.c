@@ -0,0 +1,311 @@
+/**
+ * @file kalman_tracking.c
+ * @brief Implementation of predictive (Kalman) beam tracking
+ *
+ * Each axis runs a linear Kalman filter on the optimal pointing angle:
+ * [angle, rate] under white acceleration, or [angle, rate, acceleration]
+ * under white jerk. The beam follows the prediction at the control rate;
+ * periodic dither measurements supply position fixes. For a Gaussian beam,
+ * ln S is a parabola in the pointing offset, so three samples at -δ, 0, +δ
+ * give the offset without knowing the beam width:
+ *
+ *   d = δ (ln S₊ - ln S₋) / (2 c),   c = ln S₊ + ln S₋ - 2 ln S₀
+ *
+ * The curvature c depends only on the beam and δ: c = -4δ²/w² for a 1/e²
+ * radius w. A small dither measures it poorly, so without a configured
+ * beam width it is averaged across dithers.
+ */
+
+#include "beam_tracking.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/** Floor applied before taking the log of a measured strength */
+#define KALMAN_MIN_STRENGTH 1e-12
+
+/** Weight of a new dither in the curvature average, once past the running mean */
+#define KALMAN_CURVATURE_WEIGHT 0.1
+
+/** Largest position fix offset, in dither angles */
+#define KALMAN_MAX_FIX_OFFSET 4.0
+
+/* ============================================================================
+ * Filter Operations
+ * ============================================================================ */
+
+/**
+ * @brief Transition matrix and process noise for one step of dt
+ */
+static void kalman_model(const BeamKalmanParams* params, double F[3][3], double Q[3][3]) {
+    double dt = 1.0 / params->update_rate;
+    double q = params->process_noise;
+    memset(F, 0, 9 * sizeof(double));
+    memset(Q, 0, 9 * sizeof(double));
+    
+    F[0][0] = 1.0; F[0][1] = dt;
+    F[1][1] = 1.0;
+    if (params->model == BEAM_KALMAN_CONSTANT_ACCELERATION) {
+        F[0][2] = 0.5 * dt * dt;
+        F[1][2] = dt;
+        F[2][2] = 1.0;
+    
+        // Discretized white jerk
+        Q[0][0] = q * pow(dt, 5) / 20.0;
+        Q[0][1] = Q[1][0] = q * pow(dt, 4) / 8.0;
+        Q[0][2] = Q[2][0] = q * pow(dt, 3) / 6.0;
+        Q[1][1] = q * pow(dt, 3) / 3.0;
+        Q[1][2] = Q[2][1] = q * dt * dt / 2.0;
+        Q[2][2] = q * dt;
+    } else {
+        // Discretized white acceleration
+        Q[0][0] = q * pow(dt, 3) / 3.0;
+        Q[0][1] = Q[1][0] = q * dt * dt / 2.0;
+        Q[1][1] = q * dt;
+    }
+}
+
+/**
+ * @brief x = F x, P = F P Fᵀ + Q for one axis
+ */
+static void kalman_predict(BeamKalman* kf, int axis, const double F[3][3], const double Q[3][3]) {
+    int n = (int)kf->params.model;
+    double* x = kf->state[axis];
+    double (*P)[3] = kf->covariance[axis];
+    
+    double fx[3] = {0.0, 0.0, 0.0};
+    double fp[3][3] = {{0.0}};
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            fx[i] += F[i][k] * x[k];
+            for (int j = 0; j < n; j++) {
+                fp[i][j] += F[i][k] * P[k][j];
+            }
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        x[i] = fx[i];
+        for (int j = 0; j < n; j++) {
+            double sum = Q[i][j];
+            for (int k = 0; k < n; k++) {
+                sum += fp[i][k] * F[j][k];
+            }
+            P[i][j] = sum;
+        }
+    }
+}
+
+/**
+ * @brief Correct one axis with a position fix z (H = [1 0 0])
+ */
+static void kalman_correct(BeamKalman* kf, int axis, double z) {
+    int n = (int)kf->params.model;
+    double* x = kf->state[axis];
+    double (*P)[3] = kf->covariance[axis];
+    
+    double innovation = z - x[0];
+    double s = P[0][0] + kf->params.measurement_noise;
+    double gain[3];
+    for (int i = 0; i < n; i++) {
+        gain[i] = P[i][0] / s;
+    }
+    
+    // P = (I - K H) P, row 0 of P read before it changes
+    double row0[3];
+    for (int j = 0; j < n; j++) {
+        row0[j] = P[0][j];
+    }
+    for (int i = 0; i < n; i++) {
+        x[i] += gain[i] * innovation;
+        for (int j = 0; j < n; j++) {
+            P[i][j] -= gain[i] * row0[j];
+        }
+    }
+    kf->innovation[axis] = innovation;
+}
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+void beam_kalman_params_init(BeamKalmanParams* params, double update_rate, double dither_angle) {
+    if (!params) {
+        return;
+    }
+    
+    params->model = BEAM_KALMAN_CONSTANT_VELOCITY;
+    params->update_rate = update_rate;
+    params->process_noise = 10.0 * dither_angle * dither_angle;
+    params->measurement_noise = (dither_angle / 4.0) * (dither_angle / 4.0);
+    params->dither_interval = 16;
+    params->dither_angle = dither_angle;
+    params->beam_width = 0.0;
+}
+
+int beam_track_configure_kalman(BeamTracker* tracker, const BeamKalmanParams* params) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(params);
+    
+    if (params->model != BEAM_KALMAN_CONSTANT_VELOCITY &&
+        params->model != BEAM_KALMAN_CONSTANT_ACCELERATION) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid Kalman model: %d", (int)params->model);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (params->update_rate <= 0.0 || params->process_noise < 0.0 ||
+        params->measurement_noise <= 0.0 || params->dither_interval < 1 ||
+        params->dither_angle <= 0.0 || params->beam_width < 0.0) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid Kalman parameters: rate=%.3f Hz, q=%.3e, r=%.3e, "
+                     "interval=%d, dither=%.6f",
+                     params->update_rate, params->process_noise, params->measurement_noise,
+                     params->dither_interval, params->dither_angle);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    if (!tracker->kalman) {
+        tracker->kalman = (BeamKalman*)malloc(sizeof(BeamKalman));
+        if (!tracker->kalman) {
+            FSO_LOG_ERROR("BeamTracking", "Failed to allocate Kalman tracker");
+            return FSO_ERROR_MEMORY;
+        }
+    }
+    
+    // params may point into the filter being restarted
+    BeamKalman* kf = tracker->kalman;
+    BeamKalmanParams config = *params;
+    memset(kf, 0, sizeof(BeamKalman));
+    kf->params = config;
+    
+    // Start at the current position, at rest, and dither on the first step.
+    // Initial spread: one dither offset in angle, four per second (and per
+    // second²) in rate and acceleration
+    double spread = config.dither_angle * config.dither_angle;
+    kf->state[0][0] = tracker->azimuth;
+    kf->state[1][0] = tracker->elevation;
+    for (int axis = 0; axis < 2; axis++) {
+        kf->covariance[axis][0][0] = spread;
+        kf->covariance[axis][1][1] = 16.0 * spread;
+        kf->covariance[axis][2][2] = 16.0 * spread;
+    }
+    kf->steps_since_dither = config.dither_interval;
+    if (config.beam_width > 0.0) {
+        double ratio = config.dither_angle / config.beam_width;
+        kf->curvature[0] = kf->curvature[1] = -4.0 * ratio * ratio;
+    }
+    
+    FSO_LOG_INFO("BeamTracking", "Configured Kalman tracking: %s model, dither %.6f rad every %d steps",
+                config.model == BEAM_KALMAN_CONSTANT_VELOCITY ? "constant-velocity"
+                                                              : "constant-acceleration",
+                config.dither_angle, config.dither_interval);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Predictive Tracking Update
+ * ============================================================================ */
+
+/**
+ * @brief Pointing offset from three log-strengths along one axis
+ *
+ * @return 1 with *offset set, 0 while the curvature shows no peak
+ */
+static int kalman_peak_offset(BeamKalman* kf, int axis, double center, double plus,
+                              double minus, double* offset) {
+    double l0 = log(FSO_MAX(center, KALMAN_MIN_STRENGTH));
+    double lp = log(FSO_MAX(plus, KALMAN_MIN_STRENGTH));
+    double lm = log(FSO_MAX(minus, KALMAN_MIN_STRENGTH));
+    double curvature = lp + lm - 2.0 * l0;
+    
+    // Running mean over the first dithers, then an exponential average
+    double* average = &kf->curvature[axis];
+    if (kf->params.beam_width <= 0.0) {
+        double weight = FSO_MAX(1.0 / kf->dithers, KALMAN_CURVATURE_WEIGHT);
+        *average += weight * (curvature - *average);
+    }
+    if (!(*average < 0.0)) {
+        return 0;
+    }
+    
+    double limit = KALMAN_MAX_FIX_OFFSET * kf->params.dither_angle;
+    *offset = FSO_CLAMP(kf->params.dither_angle * (lp - lm) / (2.0 * *average), -limit, limit);
+    return 1;
+}
+
+int beam_track_kalman_update(BeamTracker* tracker,
+                             BeamScanBatchCallback callback,
+                             void* user_data,
+                             int* measured) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(tracker->kalman);
+    FSO_CHECK_NULL(callback);
+    
+    FSO_PROF_BEGIN(FSO_PROF_TRACKING);
+    
+    BeamKalman* kf = tracker->kalman;
+    double F[3][3], Q[3][3];
+    kalman_model(&kf->params, F, Q);
+    
+    // Predict the optimum one control step ahead and point there
+    for (int axis = 0; axis < 2; axis++) {
+        kalman_predict(kf, axis, F, Q);
+    }
+    tracker->azimuth = kf->state[0][0];
+    tracker->elevation = kf->state[1][0];
+    
+    int dither = (++kf->steps_since_dither >= kf->params.dither_interval);
+    if (measured) {
+        *measured = dither;
+    }
+    
+    if (dither) {
+        kf->steps_since_dither = 0;
+        kf->dithers++;
+    
+        // Center, then ±δ in azimuth and in elevation
+        double delta = kf->params.dither_angle;
+        double az[5] = { tracker->azimuth, tracker->azimuth + delta, tracker->azimuth - delta,
+                         tracker->azimuth, tracker->azimuth };
+        double el[5] = { tracker->elevation, tracker->elevation, tracker->elevation,
+                         tracker->elevation + delta, tracker->elevation - delta };
+        double strengths[5];
+        int result = callback(az, el, 5, strengths, user_data);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR("BeamTracking", "Dither measurement failed: %d", result);
+            FSO_PROF_END(FSO_PROF_TRACKING);
+            return result;
+        }
+        kf->measurements += 5;
+    
+        tracker->signal_strength = strengths[0];
+        if (signal_map_set(tracker->strength_map, tracker->azimuth, tracker->elevation,
+                           strengths[0]) != FSO_SUCCESS) {
+            FSO_LOG_DEBUG("BeamTracking", "Dither center outside signal map");
+        }
+    
+        // Fix the optimum at pointing minus the fitted offset, per axis
+        double pointing[2] = { tracker->azimuth, tracker->elevation };
+        for (int axis = 0; axis < 2; axis++) {
+            double offset;
+            if (kalman_peak_offset(kf, axis, strengths[0], strengths[1 + 2 * axis],
+                                   strengths[2 + 2 * axis], &offset)) {
+                kalman_correct(kf, axis, pointing[axis] - offset);
+            } else {
+                kf->rejected++;
+            }
+        }
+        tracker->azimuth = kf->state[0][0];
+        tracker->elevation = kf->state[1][0];
+    }
+    
+    tracker->update_count++;
+    FSO_PROF_END(FSO_PROF_TRACKING);
+    
+    FSO_LOG_DEBUG("BeamTracking", "Kalman update: pos=(%.6f, %.6f), rate=(%.6f, %.6f), "
+                 "innovation=(%.6f, %.6f), dither=%d",
+                 tracker->azimuth, tracker->elevation,
+                 kf->state[0][1], kf->state[1][1],
+                 kf->innovation[0], kf->innovation[1], dither);
+    
+    return FSO_SUCCESS;
+}
@@ -90,6 +90,49 @@ int beam_track_get_status(const BeamTracker* tracker,
  * Reacquisition
  * ============================================================================ */
 
+/**
+ * @brief Enter reacquisition mode and clear the controller state
+ */
+static void reacquire_begin(BeamTracker* tracker) {
+    tracker->reacquisition_mode = 1;
+    
+    // Reset PID controller to avoid accumulated errors
+    if (tracker->pid) {
+        pid_reset(tracker->pid);
+    }
+    
+    // Reset convergence tracking
+    tracker->convergence_count = 0;
+}
+
+/**
+ * @brief Leave reacquisition mode, judging the scan's peak
+ */
+static int reacquire_finish(BeamTracker* tracker, int scan_result) {
+    if (scan_result != FSO_SUCCESS) {
+        FSO_LOG_ERROR("BeamTracking", "Reacquisition scan failed");
+        tracker->reacquisition_mode = 0;
+        return scan_result;
+    }
+    
+    // Check if we found a signal above threshold
+    if (tracker->signal_strength < tracker->signal_threshold) {
+        FSO_LOG_WARNING("BeamTracking", "Reacquisition failed: peak strength %.3f < threshold %.3f",
+                       tracker->signal_strength, tracker->signal_threshold);
+        tracker->reacquisition_mode = 0;
+        return FSO_ERROR_CONVERGENCE;
+    }
+    
+    // Signal found, exit reacquisition mode
+    tracker->reacquisition_mode = 0;
+    tracker->misaligned = 0;
+    
+    FSO_LOG_INFO("BeamTracking", "Reacquisition successful: az=%.3f, el=%.3f, strength=%.3f",
+                tracker->azimuth, tracker->elevation, tracker->signal_strength);
+    
+    return FSO_SUCCESS;
+}
+
 int beam_track_reacquire(BeamTracker* tracker,
                          double az_search_range,
                          double el_search_range,
@@ -113,42 +156,35 @@ int beam_track_reacquire(BeamTracker* tracker,
     FSO_LOG_INFO("BeamTracking", "Starting reacquisition: search_range=(%.3f, %.3f), res=%.6f",
                 az_search_range, el_search_range, resolution);
     
-    // Enter reacquisition mode
-    tracker->reacquisition_mode = 1;
-    
-    // Reset PID controller to avoid accumulated errors
-    if (tracker->pid) {
-        pid_reset(tracker->pid);
-    }
-    
-    // Reset convergence tracking
-    tracker->convergence_count = 0;
+    reacquire_begin(tracker);
     
     // Perform full scan to find signal
     int result = beam_track_scan(tracker, az_search_range, el_search_range,
                                  resolution, callback, user_data);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR("BeamTracking", "Reacquisition scan failed");
-        tracker->reacquisition_mode = 0;
-        return result;
-    }
-    
-    // Check if we found a signal above threshold
-    if (tracker->signal_strength < tracker->signal_threshold) {
-        FSO_LOG_WARNING("BeamTracking", "Reacquisition failed: peak strength %.3f < threshold %.3f",
-                       tracker->signal_strength, tracker->signal_threshold);
-        tracker->reacquisition_mode = 0;
-        return FSO_ERROR_CONVERGENCE;
-    }
+    return reacquire_finish(tracker, result);
+}
+
+int beam_track_reacquire_batch(BeamTracker* tracker,
+                               double az_search_range,
+                               double el_search_range,
+                               const BeamScanParams* params,
+                               BeamScanBatchCallback callback,
+                               void* user_data,
+                               BeamScanStats* stats) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(callback);
     
-    // Signal found, exit reacquisition mode
-    tracker->reacquisition_mode = 0;
-    tracker->misaligned = 0;
+    FSO_LOG_INFO("BeamTracking", "Starting reacquisition: search_range=(%.3f, %.3f), "
+                "res=%.6f, mode=%d", az_search_range, el_search_range,
+                params->resolution, (int)params->mode);
     
-    FSO_LOG_INFO("BeamTracking", "Reacquisition successful: az=%.3f, el=%.3f, strength=%.3f",
-                tracker->azimuth, tracker->elevation, tracker->signal_strength);
+    reacquire_begin(tracker);
     
-    return FSO_SUCCESS;
+    // The scan validates the range and parameters
+    int result = beam_track_scan_batch(tracker, az_search_range, el_search_range,
+                                       params, callback, user_data, stats);
+    return reacquire_finish(tracker, result);
 }
 
 /* ============================================================================
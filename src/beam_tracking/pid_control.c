@@ -78,6 +78,8 @@ int beam_track_pid_update(BeamTracker* tracker,
         return FSO_ERROR_INVALID_PARAM;
     }
     
+    FSO_PROF_BEGIN(FSO_PROF_TRACKING);
+    
     // Update current signal strength
     tracker->signal_strength = measured_strength;
     
@@ -99,6 +101,7 @@ int beam_track_pid_update(BeamTracker* tracker,
     result = pid_update(tracker->pid, error_az, error_el, &control_az, &control_el);
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR("BeamTracking", "PID update failed");
+        FSO_PROF_END(FSO_PROF_TRACKING);
         return result;
     }
     
@@ -117,6 +120,7 @@ int beam_track_pid_update(BeamTracker* tracker,
     }
     
     tracker->update_count++;
+    FSO_PROF_END(FSO_PROF_TRACKING);
     
     FSO_LOG_DEBUG("BeamTracking", "PID update: pos=(%.6f, %.6f), target=(%.6f, %.6f), "
                  "error=(%.6f, %.6f), control=(%.6f, %.6f), strength=%.3f",
@@ -0,0 +1,403 @@
+/**
+ * @file tracker_bank.c
+ * @brief Implementation of structure-of-arrays tracker banks
+ *
+ * The per-link loops mirror beam_track_update(), beam_track_pid_update()
+ * and beam_track_check_misalignment() with the branches written as
+ * selects, so each loop vectorizes across trackers. Banks of at least
+ * BEAM_BANK_PARALLEL_MIN trackers are also split across OpenMP threads.
+ */
+
+#include "beam_tracking.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/** Bank size from which the per-tracker loops use OpenMP threads */
+#define BEAM_BANK_PARALLEL_MIN 4096
+
+/** Number of per-tracker double arrays in a bank */
+#define BEAM_BANK_DOUBLE_ARRAYS 11
+
+/** Number of per-tracker int arrays in a bank */
+#define BEAM_BANK_INT_ARRAYS 3
+
+/* ============================================================================
+ * Initialization and Cleanup
+ * ============================================================================ */
+
+int beam_bank_init(BeamTrackerBank* bank, size_t count,
+                   const double* initial_az, const double* initial_el) {
+    FSO_CHECK_NULL(bank);
+    
+    if (count == 0) {
+        FSO_LOG_ERROR("BeamTracking", "Tracker bank needs at least one tracker");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    memset(bank, 0, sizeof(BeamTrackerBank));
+    bank->storage = (double*)calloc(count * BEAM_BANK_DOUBLE_ARRAYS, sizeof(double));
+    bank->int_storage = (int*)calloc(count * BEAM_BANK_INT_ARRAYS, sizeof(int));
+    if (!bank->storage || !bank->int_storage) {
+        FSO_LOG_ERROR("BeamTracking", "Failed to allocate tracker bank of %zu", count);
+        beam_bank_free(bank);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    bank->count = count;
+    bank->azimuth = bank->storage;
+    bank->elevation = bank->azimuth + count;
+    bank->signal_strength = bank->elevation + count;
+    bank->step_size = bank->signal_strength + count;
+    bank->velocity_az = bank->step_size + count;
+    bank->velocity_el = bank->velocity_az + count;
+    bank->integral_az = bank->velocity_el + count;
+    bank->integral_el = bank->integral_az + count;
+    bank->prev_error_az = bank->integral_el + count;
+    bank->prev_error_el = bank->prev_error_az + count;
+    bank->signal_threshold = bank->prev_error_el + count;
+    bank->convergence_count = bank->int_storage;
+    bank->misaligned = bank->convergence_count + count;
+    bank->update_count = bank->misaligned + count;
+    
+    // Same defaults as beam_track_init()
+    bank->momentum = 0.9;
+    bank->step_size_min = 0.001;
+    bank->step_size_max = 0.1;
+    bank->step_adapt_factor = 1.1;
+    bank->convergence_threshold = 10;
+    bank->convergence_epsilon = 1e-4;
+    bank->kp = 1.0;
+    bank->ki = 0.1;
+    bank->kd = 0.05;
+    bank->dt = 1.0 / 100.0;
+    bank->integral_limit = 1.0;
+    
+    for (size_t i = 0; i < count; i++) {
+        bank->azimuth[i] = initial_az ? initial_az[i] : 0.0;
+        bank->elevation[i] = initial_el ? initial_el[i] : 0.0;
+        bank->step_size[i] = 0.01;
+        bank->signal_threshold[i] = 0.1;
+    }
+    
+    FSO_LOG_INFO("BeamTracking", "Initialized tracker bank of %zu", count);
+    
+    return FSO_SUCCESS;
+}
+
+void beam_bank_free(BeamTrackerBank* bank) {
+    if (bank) {
+        free(bank->storage);
+        free(bank->int_storage);
+        memset(bank, 0, sizeof(BeamTrackerBank));
+    }
+}
+
+int beam_bank_configure_pid(BeamTrackerBank* bank,
+                            double kp, double ki, double kd,
+                            double update_rate, double integral_limit) {
+    FSO_CHECK_NULL(bank);
+    
+    if (update_rate <= 0.0) {
+        FSO_LOG_ERROR("BeamTracking", "Invalid PID update rate: %.3f Hz", update_rate);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    bank->kp = kp;
+    bank->ki = ki;
+    bank->kd = kd;
+    bank->dt = 1.0 / update_rate;
+    bank->integral_limit = integral_limit;
+    
+    // Reset state when parameters change
+    size_t n = bank->count;
+    memset(bank->integral_az, 0, n * sizeof(double));
+    memset(bank->integral_el, 0, n * sizeof(double));
+    memset(bank->prev_error_az, 0, n * sizeof(double));
+    memset(bank->prev_error_el, 0, n * sizeof(double));
+    
+    FSO_LOG_INFO("BeamTracking", "Configured bank PID: Kp=%.3f, Ki=%.3f, Kd=%.3f, rate=%.1f Hz",
+                kp, ki, kd, update_rate);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Bank Updates
+ * ============================================================================ */
+
+/**
+ * @brief Reject a strength array with a negative entry
+ */
+static int beam_bank_check_strengths(const BeamTrackerBank* bank, const double* strengths) {
+    for (size_t i = 0; i < bank->count; i++) {
+        if (!(strengths[i] >= 0.0)) {
+            FSO_LOG_ERROR("BeamTracking", "Invalid signal strength for tracker %zu: %.3f",
+                         i, strengths[i]);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+    }
+    return FSO_SUCCESS;
+}
+
+int beam_bank_update(BeamTrackerBank* bank, const double* strengths,
+                     const double* grad_az, const double* grad_el) {
+    FSO_CHECK_NULL(bank);
+    FSO_CHECK_NULL(strengths);
+    FSO_CHECK_NULL(grad_az);
+    FSO_CHECK_NULL(grad_el);
+    
+    int result = beam_bank_check_strengths(bank, strengths);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_TRACKING);
+    
+    const size_t n = bank->count;
+    const double momentum = bank->momentum;
+    const double step_min = bank->step_size_min;
+    const double step_max = bank->step_size_max;
+    const double factor = bank->step_adapt_factor;
+    const double epsilon = bank->convergence_epsilon;
+    const int threshold = bank->convergence_threshold;
+    double* azimuth = bank->azimuth;
+    double* elevation = bank->elevation;
+    double* strength = bank->signal_strength;
+    double* step_size = bank->step_size;
+    double* velocity_az = bank->velocity_az;
+    double* velocity_el = bank->velocity_el;
+    int* convergence = bank->convergence_count;
+    int* updates = bank->update_count;
+    
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(n >= BEAM_BANK_PARALLEL_MIN) schedule(static)
+#endif
+    for (size_t i = 0; i < n; i++) {
+        double improvement = strengths[i] - strength[i];
+        strength[i] = strengths[i];
+        
+        // Adapt step size based on improvement
+        double step = step_size[i];
+        int count = convergence[i] + 1;
+        step = (improvement > 0.0) ? step * factor :
+               (improvement < -epsilon) ? step / factor : step;
+        count = (improvement > 0.0 || improvement < -epsilon) ? 0 : count;
+        step = FSO_CLAMP(step, step_min, step_max);
+        step_size[i] = step;
+        
+        // Converged trackers hold; a vanishing gradient counts toward convergence
+        double gaz = grad_az[i];
+        double gel = grad_el[i];
+        int active = (count < threshold);
+        int moving = active && (gaz * gaz + gel * gel >= 1e-12);
+        count += (active && !moving);
+        
+        // v_new = β*v_old + α*∇S(θ), θ_new = θ_old + v_new
+        double vaz = momentum * velocity_az[i] + step * gaz;
+        double vel = momentum * velocity_el[i] + step * gel;
+        double change = vaz * vaz + vel * vel;
+        velocity_az[i] = moving ? vaz : velocity_az[i];
+        velocity_el[i] = moving ? vel : velocity_el[i];
+        azimuth[i] += moving ? vaz : 0.0;
+        elevation[i] += moving ? vel : 0.0;
+        count = moving ? ((change < epsilon * epsilon) ? count + 1 : 0) : count;
+        
+        convergence[i] = count;
+        updates[i]++;
+    }
+    
+    FSO_PROF_END(FSO_PROF_TRACKING);
+    
+    FSO_LOG_DEBUG("BeamTracking", "Bank gradient update of %zu trackers", n);
+    
+    return FSO_SUCCESS;
+}
+
+int beam_bank_pid_update(BeamTrackerBank* bank,
+                         const double* target_az, const double* target_el,
+                         const double* strengths) {
+    FSO_CHECK_NULL(bank);
+    FSO_CHECK_NULL(target_az);
+    FSO_CHECK_NULL(target_el);
+    FSO_CHECK_NULL(strengths);
+    
+    int result = beam_bank_check_strengths(bank, strengths);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_TRACKING);
+    
+    const size_t n = bank->count;
+    const double kp = bank->kp;
+    const double ki = bank->ki;
+    const double kd = bank->kd;
+    const double dt = bank->dt;
+    const double rate = 1.0 / bank->dt;
+    const double limit = bank->integral_limit;
+    const double epsilon = bank->convergence_epsilon;
+    double* azimuth = bank->azimuth;
+    double* elevation = bank->elevation;
+    double* strength = bank->signal_strength;
+    double* integral_az = bank->integral_az;
+    double* integral_el = bank->integral_el;
+    double* prev_error_az = bank->prev_error_az;
+    double* prev_error_el = bank->prev_error_el;
+    int* convergence = bank->convergence_count;
+    int* updates = bank->update_count;
+    
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(n >= BEAM_BANK_PARALLEL_MIN) schedule(static)
+#endif
+    for (size_t i = 0; i < n; i++) {
+        strength[i] = strengths[i];
+        
+        double error_az = target_az[i] - azimuth[i];
+        double error_el = target_el[i] - elevation[i];
+        
+        // Integral terms with anti-windup
+        double iaz = FSO_CLAMP(integral_az[i] + error_az * dt, -limit, limit);
+        double iel = FSO_CLAMP(integral_el[i] + error_el * dt, -limit, limit);
+        integral_az[i] = iaz;
+        integral_el[i] = iel;
+        
+        double derivative_az = (error_az - prev_error_az[i]) * rate;
+        double derivative_el = (error_el - prev_error_el[i]) * rate;
+        prev_error_az[i] = error_az;
+        prev_error_el[i] = error_el;
+        
+        double control_az = kp * error_az + ki * iaz + kd * derivative_az;
+        double control_el = kp * error_el + ki * iel + kd * derivative_el;
+        azimuth[i] += control_az;
+        elevation[i] += control_el;
+        
+        double change = control_az * control_az + control_el * control_el;
+        convergence[i] = (change < epsilon * epsilon) ? convergence[i] + 1 : 0;
+        updates[i]++;
+    }
+    
+    FSO_PROF_END(FSO_PROF_TRACKING);
+    
+    FSO_LOG_DEBUG("BeamTracking", "Bank PID update of %zu trackers", n);
+    
+    return FSO_SUCCESS;
+}
+
+int beam_bank_check_misalignment(BeamTrackerBank* bank, const double* strengths,
+                                 size_t* num_misaligned) {
+    FSO_CHECK_NULL(bank);
+    FSO_CHECK_NULL(strengths);
+    
+    int result = beam_bank_check_strengths(bank, strengths);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    const size_t n = bank->count;
+    double* strength = bank->signal_strength;
+    const double* threshold = bank->signal_threshold;
+    int* misaligned = bank->misaligned;
+    size_t total = 0;
+    size_t detected = 0;
+    
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(n >= BEAM_BANK_PARALLEL_MIN) schedule(static) \
+        reduction(+:total, detected)
+#endif
+    for (size_t i = 0; i < n; i++) {
+        strength[i] = strengths[i];
+        int below = (strengths[i] < threshold[i]);
+        detected += (below && !misaligned[i]);
+        total += below;
+        misaligned[i] = below;
+    }
+    
+    if (detected > 0) {
+        FSO_LOG_WARNING("BeamTracking", "Misalignment detected on %zu of %zu trackers (%zu total)",
+                       detected, n, total);
+    }
+    
+    if (num_misaligned) {
+        *num_misaligned = total;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Single-Tracker Views
+ * ============================================================================ */
+
+int beam_bank_load(const BeamTrackerBank* bank, size_t index, BeamTracker* tracker) {
+    FSO_CHECK_NULL(bank);
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(tracker->pid);
+    
+    if (index >= bank->count) {
+        FSO_LOG_ERROR("BeamTracking", "Tracker index %zu out of bank of %zu", index, bank->count);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    tracker->azimuth = bank->azimuth[index];
+    tracker->elevation = bank->elevation[index];
+    tracker->signal_strength = bank->signal_strength[index];
+    tracker->step_size = bank->step_size[index];
+    tracker->velocity_az = bank->velocity_az[index];
+    tracker->velocity_el = bank->velocity_el[index];
+    tracker->convergence_count = bank->convergence_count[index];
+    tracker->signal_threshold = bank->signal_threshold[index];
+    tracker->misaligned = bank->misaligned[index];
+    tracker->update_count = bank->update_count[index];
+    
+    tracker->momentum = bank->momentum;
+    tracker->step_size_min = bank->step_size_min;
+    tracker->step_size_max = bank->step_size_max;
+    tracker->step_adapt_factor = bank->step_adapt_factor;
+    tracker->convergence_threshold = bank->convergence_threshold;
+    tracker->convergence_epsilon = bank->convergence_epsilon;
+    
+    PIDController* pid = tracker->pid;
+    pid->kp = bank->kp;
+    pid->ki = bank->ki;
+    pid->kd = bank->kd;
+    pid->dt = bank->dt;
+    pid->update_rate = 1.0 / bank->dt;
+    pid->integral_limit = bank->integral_limit;
+    pid->integral_az = bank->integral_az[index];
+    pid->integral_el = bank->integral_el[index];
+    pid->prev_error_az = bank->prev_error_az[index];
+    pid->prev_error_el = bank->prev_error_el[index];
+    
+    return FSO_SUCCESS;
+}
+
+int beam_bank_store(BeamTrackerBank* bank, size_t index, const BeamTracker* tracker) {
+    FSO_CHECK_NULL(bank);
+    FSO_CHECK_NULL(tracker);
+    
+    if (index >= bank->count) {
+        FSO_LOG_ERROR("BeamTracking", "Tracker index %zu out of bank of %zu", index, bank->count);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    bank->azimuth[index] = tracker->azimuth;
+    bank->elevation[index] = tracker->elevation;
+    bank->signal_strength[index] = tracker->signal_strength;
+    bank->step_size[index] = tracker->step_size;
+    bank->velocity_az[index] = tracker->velocity_az;
+    bank->velocity_el[index] = tracker->velocity_el;
+    bank->convergence_count[index] = tracker->convergence_count;
+    bank->signal_threshold[index] = tracker->signal_threshold;
+    bank->misaligned[index] = tracker->misaligned;
+    bank->update_count[index] = tracker->update_count;
+    
+    if (tracker->pid) {
+        bank->integral_az[index] = tracker->pid->integral_az;
+        bank->integral_el[index] = tracker->pid->integral_el;
+        bank->prev_error_az[index] = tracker->pid->prev_error_az;
+        bank->prev_error_el[index] = tracker->pid->prev_error_el;
+    }
+    
+    return FSO_SUCCESS;
+}
@@ -11,6 +11,11 @@
 #include "ldpc.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /* ============================================================================
  * Module Constants
@@ -18,6 +23,412 @@
 
 #define FEC_MODULE "FEC"
 
+/** Side of the register-level transpose tile */
+#define FEC_TILE 8
+
+/** Side of the cache-level super-tile: 64 rows of one 64-byte line each */
+#define FEC_SUPER_TILE 64
+
+/** Full restarts of the S-random construction before S is lowered */
+#define FEC_S_RANDOM_ATTEMPTS 8
+
+/* ============================================================================
+ * Helper Functions
+ * ============================================================================ */
+
+/**
+ * @brief Hard-decide 8 LLRs per byte (negative LLR -> 1), MSB first
+ */
+static void fec_slice_llr(const float* llr, size_t num_bytes, uint8_t* bytes)
+{
+    for (size_t i = 0; i < num_bytes; i++) {
+        unsigned int byte = 0;
+        for (int b = 0; b < 8; b++) {
+            byte = (byte << 1) | (unsigned int)(llr[b] < 0.0f);
+        }
+        bytes[i] = (uint8_t)byte;
+        llr += 8;
+    }
+}
+
+/**
+ * @brief Transpose every full rows x cols block of elem_size-byte elements in place
+ * 
+ * Element p of a block moves to (p % cols) * rows + p / cols. Cycles of
+ * that permutation are followed one element at a time; marks (one bit
+ * per block position) records the positions already placed, so no copy
+ * of the block is needed.
+ */
+static void fec_transpose_blocks_inplace(uint8_t* data, size_t elem_size, int rows, int cols,
+                                         size_t num_blocks, uint8_t* marks)
+{
+    const size_t block_len = (size_t)rows * (size_t)cols;
+    uint8_t carry[32];
+    uint8_t displaced[32];
+    
+    /* A 1 x n or n x 1 transpose is the identity */
+    if (rows == 1 || cols == 1) {
+        return;
+    }
+    
+    for (size_t block = 0; block < num_blocks; block++) {
+        uint8_t* base = data + block * block_len * elem_size;
+        memset(marks, 0, (block_len + 7) / 8);
+        
+        for (size_t start = 0; start < block_len; start++) {
+            if (marks[start >> 3] & (1u << (start & 7))) {
+                continue;
+            }
+            
+            memcpy(carry, base + start * elem_size, elem_size);
+            size_t pos = start;
+            do {
+                size_t dest = (pos % (size_t)cols) * (size_t)rows + pos / (size_t)cols;
+                memcpy(displaced, base + dest * elem_size, elem_size);
+                memcpy(base + dest * elem_size, carry, elem_size);
+                memcpy(carry, displaced, elem_size);
+                marks[dest >> 3] |= (uint8_t)(1u << (dest & 7));
+                pos = dest;
+            } while (pos != start);
+        }
+    }
+}
+
+/**
+ * @brief Transpose an 8x8 byte tile
+ */
+static inline void fec_transpose_tile8(const uint8_t* in, size_t in_stride,
+                                       uint8_t* out, size_t out_stride)
+{
+#if defined(__SSE2__)
+    __m128i r0 = _mm_loadl_epi64((const __m128i*)(in + 0 * in_stride));
+    __m128i r1 = _mm_loadl_epi64((const __m128i*)(in + 1 * in_stride));
+    __m128i r2 = _mm_loadl_epi64((const __m128i*)(in + 2 * in_stride));
+    __m128i r3 = _mm_loadl_epi64((const __m128i*)(in + 3 * in_stride));
+    __m128i r4 = _mm_loadl_epi64((const __m128i*)(in + 4 * in_stride));
+    __m128i r5 = _mm_loadl_epi64((const __m128i*)(in + 5 * in_stride));
+    __m128i r6 = _mm_loadl_epi64((const __m128i*)(in + 6 * in_stride));
+    __m128i r7 = _mm_loadl_epi64((const __m128i*)(in + 7 * in_stride));
+    
+    /* Interleave bytes, then pairs, then quads: each step doubles the
+     * run of one column's bytes that sit together */
+    __m128i t0 = _mm_unpacklo_epi8(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi8(r2, r3);
+    __m128i t2 = _mm_unpacklo_epi8(r4, r5);
+    __m128i t3 = _mm_unpacklo_epi8(r6, r7);
+    __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+    __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+    __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+    __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+    __m128i v0 = _mm_unpacklo_epi32(u0, u2);    /* columns 0, 1 */
+    __m128i v1 = _mm_unpackhi_epi32(u0, u2);    /* columns 2, 3 */
+    __m128i v2 = _mm_unpacklo_epi32(u1, u3);    /* columns 4, 5 */
+    __m128i v3 = _mm_unpackhi_epi32(u1, u3);    /* columns 6, 7 */
+    
+    _mm_storel_epi64((__m128i*)(out + 0 * out_stride), v0);
+    _mm_storel_epi64((__m128i*)(out + 1 * out_stride), _mm_unpackhi_epi64(v0, v0));
+    _mm_storel_epi64((__m128i*)(out + 2 * out_stride), v1);
+    _mm_storel_epi64((__m128i*)(out + 3 * out_stride), _mm_unpackhi_epi64(v1, v1));
+    _mm_storel_epi64((__m128i*)(out + 4 * out_stride), v2);
+    _mm_storel_epi64((__m128i*)(out + 5 * out_stride), _mm_unpackhi_epi64(v2, v2));
+    _mm_storel_epi64((__m128i*)(out + 6 * out_stride), v3);
+    _mm_storel_epi64((__m128i*)(out + 7 * out_stride), _mm_unpackhi_epi64(v3, v3));
+#else
+    for (int r = 0; r < FEC_TILE; r++) {
+        for (int c = 0; c < FEC_TILE; c++) {
+            out[c * out_stride + r] = in[r * in_stride + c];
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Transpose a rows x cols byte matrix into cols x rows
+ * 
+ * out[c * rows + r] = in[r * cols + c]. The matrix is walked in 64x64
+ * super-tiles so both sides of a deep interleaver stay cache-resident,
+ * each split into 8x8 register tiles; ragged edges are done bytewise.
+ */
+static void fec_transpose_u8(const uint8_t* in, uint8_t* out, size_t rows, size_t cols)
+{
+    for (size_t rb = 0; rb < rows; rb += FEC_SUPER_TILE) {
+        size_t r_end = rb + FEC_SUPER_TILE < rows ? rb + FEC_SUPER_TILE : rows;
+        
+        for (size_t cb = 0; cb < cols; cb += FEC_SUPER_TILE) {
+            size_t c_end = cb + FEC_SUPER_TILE < cols ? cb + FEC_SUPER_TILE : cols;
+            size_t r = rb;
+            
+            for (; r + FEC_TILE <= r_end; r += FEC_TILE) {
+                size_t c = cb;
+                for (; c + FEC_TILE <= c_end; c += FEC_TILE) {
+                    fec_transpose_tile8(in + r * cols + c, cols, out + c * rows + r, rows);
+                }
+                for (; c < c_end; c++) {
+                    for (size_t i = r; i < r + FEC_TILE; i++) {
+                        out[c * rows + i] = in[i * cols + c];
+                    }
+                }
+            }
+            for (; r < r_end; r++) {
+                for (size_t c = cb; c < c_end; c++) {
+                    out[c * rows + r] = in[r * cols + c];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transpose a rows x cols matrix of elem_size-byte elements
+ * 
+ * Element counterpart of fec_transpose_u8(), used for the 8-LLR groups
+ * that stand for one byte.
+ */
+static void fec_transpose_elems(const uint8_t* in, uint8_t* out, size_t rows, size_t cols,
+                                size_t elem_size)
+{
+    for (size_t rb = 0; rb < rows; rb += FEC_TILE) {
+        size_t r_end = rb + FEC_TILE < rows ? rb + FEC_TILE : rows;
+        
+        for (size_t cb = 0; cb < cols; cb += FEC_TILE) {
+            size_t c_end = cb + FEC_TILE < cols ? cb + FEC_TILE : cols;
+            
+            for (size_t r = rb; r < r_end; r++) {
+                for (size_t c = cb; c < c_end; c++) {
+                    memcpy(out + (c * rows + r) * elem_size,
+                           in + (r * cols + c) * elem_size, elem_size);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Apply a frame permutation as a gather or a scatter
+ * 
+ * With gather set, out[i] = in[table[i]] (interleaving); otherwise
+ * out[table[i]] = in[i] (deinterleaving).
+ */
+static void fec_permute_elems(const uint8_t* in, uint8_t* out, const int* table,
+                              size_t frame_len, size_t elem_size, int gather)
+{
+    if (elem_size == 1) {
+        if (gather) {
+            for (size_t i = 0; i < frame_len; i++) {
+                out[i] = in[table[i]];
+            }
+        } else {
+            for (size_t i = 0; i < frame_len; i++) {
+                out[table[i]] = in[i];
+            }
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < frame_len; i++) {
+        size_t src = gather ? (size_t)table[i] : i;
+        size_t dst = gather ? i : (size_t)table[i];
+        memcpy(out + dst * elem_size, in + src * elem_size, elem_size);
+    }
+}
+
+/**
+ * @brief Frame permutation shared by the out-of-place interleaver calls
+ * 
+ * Full frames go through the table or, for the block type, the tiled
+ * transpose (rows x cols, as seen by the caller's direction); a
+ * trailing partial frame is copied unchanged.
+ */
+static void fec_interleave_frames(const InterleaverConfig* config, const uint8_t* input,
+                                  size_t input_len, uint8_t* output, size_t elem_size,
+                                  size_t rows, size_t cols, int gather)
+{
+    size_t frame_len = (size_t)config->block_size * (size_t)config->depth;
+    size_t full_frames = input_len / frame_len;
+    size_t remaining = input_len % frame_len;
+    size_t frame_bytes = frame_len * elem_size;
+    
+    for (size_t frame = 0; frame < full_frames; frame++) {
+        const uint8_t* in = input + frame * frame_bytes;
+        uint8_t* out = output + frame * frame_bytes;
+        
+        if (config->permutation_table != NULL) {
+            fec_permute_elems(in, out, config->permutation_table, frame_len, elem_size, gather);
+        } else if (elem_size == 1) {
+            fec_transpose_u8(in, out, rows, cols);
+        } else {
+            fec_transpose_elems(in, out, rows, cols, elem_size);
+        }
+    }
+    
+    if (remaining > 0) {
+        memcpy(output + full_frames * frame_bytes, input + full_frames * frame_bytes,
+               remaining * elem_size);
+    }
+}
+
+/**
+ * @brief Apply a frame permutation table to every full frame in place
+ * 
+ * Same cycle walk as fec_transpose_blocks_inplace(), with positions read
+ * from the table: a gather cycle pulls each element from table[pos], a
+ * scatter cycle pushes it to table[pos].
+ */
+static void fec_permute_blocks_inplace(uint8_t* data, size_t elem_size, const int* table,
+                                       size_t frame_len, size_t num_frames, int gather,
+                                       uint8_t* marks)
+{
+    uint8_t carry[32];
+    uint8_t displaced[32];
+    
+    for (size_t frame = 0; frame < num_frames; frame++) {
+        uint8_t* base = data + frame * frame_len * elem_size;
+        memset(marks, 0, (frame_len + 7) / 8);
+        
+        for (size_t start = 0; start < frame_len; start++) {
+            if (marks[start >> 3] & (1u << (start & 7))) {
+                continue;
+            }
+            
+            size_t pos = start;
+            if (gather) {
+                memcpy(carry, base + start * elem_size, elem_size);
+                for (;;) {
+                    size_t src = (size_t)table[pos];
+                    marks[pos >> 3] |= (uint8_t)(1u << (pos & 7));
+                    if (src == start) {
+                        memcpy(base + pos * elem_size, carry, elem_size);
+                        break;
+                    }
+                    memcpy(base + pos * elem_size, base + src * elem_size, elem_size);
+                    pos = src;
+                }
+            } else {
+                memcpy(carry, base + start * elem_size, elem_size);
+                do {
+                    size_t dest = (size_t)table[pos];
+                    memcpy(displaced, base + dest * elem_size, elem_size);
+                    memcpy(base + dest * elem_size, carry, elem_size);
+                    memcpy(carry, displaced, elem_size);
+                    marks[dest >> 3] |= (uint8_t)(1u << (dest & 7));
+                    pos = dest;
+                } while (pos != start);
+            }
+        }
+    }
+}
+
+/**
+ * @brief xorshift32 step for the random permutation builders
+ */
+static inline uint32_t fec_xorshift32(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Fill table with a uniform random permutation (Fisher-Yates)
+ */
+static void fec_build_random(int* table, size_t n, uint32_t* state)
+{
+    for (size_t i = 0; i < n; i++) {
+        table[i] = (int)i;
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = fec_xorshift32(state) % (uint32_t)(i + 1);
+        int tmp = table[i];
+        table[i] = table[j];
+        table[j] = tmp;
+    }
+}
+
+/**
+ * @brief Fill table with an S-random permutation
+ * 
+ * Each output position takes a random unused input whose index differs
+ * by more than S from the inputs placed in the previous S positions. A
+ * construction that paints itself into a corner restarts; after
+ * FEC_S_RANDOM_ATTEMPTS restarts S is lowered by one.
+ * 
+ * @return The spread actually achieved, or -1 on allocation failure
+ */
+static int fec_build_s_random(int* table, size_t n, int spread, uint32_t* state)
+{
+    int* pool = (int*)malloc(n * sizeof(int));
+    if (pool == NULL) {
+        return -1;
+    }
+    
+    for (int s = spread; s > 0; s--) {
+        for (int attempt = 0; attempt < FEC_S_RANDOM_ATTEMPTS; attempt++) {
+            size_t pool_len = n;
+            for (size_t i = 0; i < n; i++) {
+                pool[i] = (int)i;
+            }
+            
+            size_t placed = 0;
+            while (placed < n) {
+                size_t offset = fec_xorshift32(state) % (uint32_t)pool_len;
+                size_t lookback = placed < (size_t)s ? placed : (size_t)s;
+                int found = 0;
+                
+                for (size_t k = 0; k < pool_len && !found; k++) {
+                    size_t slot = (offset + k) % pool_len;
+                    int candidate = pool[slot];
+                    int ok = 1;
+                    for (size_t j = placed - lookback; j < placed; j++) {
+                        if (abs(candidate - table[j]) <= s) {
+                            ok = 0;
+                            break;
+                        }
+                    }
+                    if (ok) {
+                        table[placed++] = candidate;
+                        pool[slot] = pool[--pool_len];
+                        found = 1;
+                    }
+                }
+                if (!found) {
+                    break;
+                }
+            }
+            
+            if (placed == n) {
+                free(pool);
+                return s;
+            }
+        }
+    }
+    
+    /* S = 0 is no constraint at all */
+    free(pool);
+    fec_build_random(table, n, state);
+    return 0;
+}
+
+/**
+ * @brief Fill table with a tail-biting convolutional permutation
+ * 
+ * Byte p of the frame rides branch b = p % depth at slot p / depth and
+ * leaves at slot (p / depth + b * cell) mod block_size of the same
+ * branch, so consecutive bytes end up cell * depth + 1 positions apart.
+ */
+static void fec_build_convolutional(int* table, int block_size, int depth, int cell)
+{
+    for (int k = 0; k < block_size; k++) {
+        for (int b = 0; b < depth; b++) {
+            size_t src = (size_t)k * depth + b;
+            size_t slot = ((size_t)k + (size_t)b * (size_t)cell) % (size_t)block_size;
+            table[slot * depth + b] = (int)src;
+        }
+    }
+}
+
 /* ============================================================================
  * FEC Functions
  * ============================================================================ */
@@ -71,16 +482,9 @@ FSOErrorCode fec_init(FECCodec* codec, FECType type, int data_length,
                 return result;
             }
             
-            /* Generate standard LDPC matrix for the code rate */
-            result = ldpc_generate_standard_matrix(ldpc_codec, codec->code_rate);
-            if (result != FSO_SUCCESS) {
-                ldpc_free(ldpc_codec);
-                free(ldpc_codec);
-                return result;
-            }
-            
-            /* Generate generator matrix for encoding */
-            result = ldpc_generate_generator_matrix(ldpc_codec);
+            /* Parity-check and generator matrices, shared with other codecs
+             * of the same code through the graph cache */
+            result = ldpc_acquire_standard_code(ldpc_codec, codec->code_rate);
             if (result != FSO_SUCCESS) {
                 ldpc_free(ldpc_codec);
                 free(ldpc_codec);
@@ -207,16 +611,18 @@ FSOErrorCode fec_decode(FECCodec* codec, const uint8_t* received, size_t receive
             }
             break;
             
-        case FEC_LDPC:
-            result = ldpc_decode((LDPCCodec*)codec->codec_state, received, received_len,
+        case FEC_LDPC: {
+            LDPCCodec* ldpc_codec = (LDPCCodec*)codec->codec_state;
+            result = ldpc_decode(ldpc_codec, received, received_len,
                                 decoded, *decoded_len, &errors_corrected);
             if (stats) {
                 stats->errors_corrected = errors_corrected;
                 stats->errors_detected = errors_corrected;
-                stats->uncorrectable = (result != FSO_SUCCESS);
-                /* LDPC-specific stats would be filled here */
+                stats->uncorrectable = (result != FSO_SUCCESS) || !ldpc_codec->last_converged;
+                stats->iterations = ldpc_codec->last_iterations;
             }
             break;
+        }
             
         default:
             FSO_LOG_ERROR(FEC_MODULE, "Unsupported FEC type for decoding: %d", codec->type);
@@ -232,6 +638,231 @@ FSOErrorCode fec_decode(FECCodec* codec, const uint8_t* received, size_t receive
     return result;
 }
 
+FSOErrorCode fec_decode_soft(FECCodec* codec, const float* llr, size_t llr_len,
+                             uint8_t* decoded, size_t* decoded_len, FECStats* stats)
+{
+    FSO_CHECK_NULL(codec);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_NULL(decoded_len);
+    FSO_CHECK_PARAM(codec->is_initialized);
+    FSO_CHECK_PARAM(llr_len == (size_t)codec->code_length * 8);
+    FSO_CHECK_PARAM(*decoded_len >= (size_t)codec->data_length);
+    
+    if (stats) {
+        memset(stats, 0, sizeof(FECStats));
+    }
+    
+    FSOErrorCode result = FSO_SUCCESS;
+    int errors_corrected = 0;
+    
+    switch (codec->type) {
+        case FEC_REED_SOLOMON: {
+            /* Algebraic decoder: slice the LLR signs back into symbols */
+            const size_t n = (size_t)codec->code_length;
+            uint8_t stack_word[256] = {0};
+            uint8_t* word = stack_word;
+            if (n > sizeof(stack_word)) {
+                word = (uint8_t*)malloc(n);
+                if (!word) {
+                    FSO_LOG_ERROR(FEC_MODULE, "Failed to allocate soft-decision workspace");
+                    return FSO_ERROR_MEMORY;
+                }
+            }
+            
+            fec_slice_llr(llr, n, word);
+            result = rs_decode((RSCodec*)codec->codec_state, word, n,
+                              decoded, *decoded_len, &errors_corrected);
+            if (stats) {
+                stats->errors_corrected = errors_corrected;
+                stats->errors_detected = errors_corrected;
+                stats->uncorrectable = (result != FSO_SUCCESS);
+            }
+            
+            if (word != stack_word) {
+                free(word);
+            }
+            break;
+        }
+            
+        case FEC_LDPC: {
+            /* One code bit per byte, carried in the byte's LSB */
+            LDPCCodec* ldpc_codec = (LDPCCodec*)codec->codec_state;
+            int iterations = 0;
+            int converged = 0;
+            if (ldpc_codec->llr_format == LDPC_LLR_FLOAT) {
+                result = ldpc_decode_soft(ldpc_codec, llr + 7, 8, decoded, *decoded_len,
+                                         &errors_corrected);
+                iterations = ldpc_codec->last_iterations;
+                converged = ldpc_codec->last_converged;
+            } else {
+                /* Quantized LLRs: a one-word batch through the fixed-point decoder */
+                result = ldpc_decode_batch_soft(ldpc_codec, llr + 7, 8, 1, decoded,
+                                               &iterations, &converged);
+                for (int i = 0; result == FSO_SUCCESS && i < ldpc_codec->k; i++) {
+                    errors_corrected += (decoded[i] != (llr[(size_t)i * 8 + 7] < 0.0f));
+                }
+            }
+            if (stats) {
+                stats->errors_corrected = errors_corrected;
+                stats->errors_detected = errors_corrected;
+                stats->uncorrectable = (result != FSO_SUCCESS) || !converged;
+                stats->iterations = iterations;
+            }
+            break;
+        }
+            
+        default:
+            FSO_LOG_ERROR(FEC_MODULE, "Unsupported FEC type for decoding: %d", codec->type);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    if (result == FSO_SUCCESS) {
+        *decoded_len = codec->data_length;
+        FSO_LOG_DEBUG(FEC_MODULE, "Soft-decoded %zu LLRs to %zu bytes using %s, corrected %d errors",
+                     llr_len, *decoded_len, fec_type_string(codec->type), errors_corrected);
+    }
+    
+    return result;
+}
+
+FSOErrorCode fec_decode_erasures(FECCodec* codec, const uint8_t* received, size_t received_len,
+                                 const int* erasure_positions, int num_erasures,
+                                 uint8_t* decoded, size_t* decoded_len, FECStats* stats)
+{
+    FSO_CHECK_NULL(codec);
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_NULL(decoded_len);
+    FSO_CHECK_PARAM(codec->is_initialized);
+    FSO_CHECK_PARAM(received_len == (size_t)codec->code_length);
+    FSO_CHECK_PARAM(*decoded_len >= (size_t)codec->data_length);
+    FSO_CHECK_PARAM(num_erasures >= 0);
+    
+    if (num_erasures == 0) {
+        return fec_decode(codec, received, received_len, decoded, decoded_len, stats);
+    }
+    
+    if (codec->type != FEC_REED_SOLOMON) {
+        FSO_LOG_ERROR(FEC_MODULE, "Erasure decoding not supported for %s",
+                     fec_type_string(codec->type));
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    if (stats) {
+        memset(stats, 0, sizeof(FECStats));
+    }
+    
+    int errors_corrected = 0;
+    FSOErrorCode result = rs_decode_erasures((RSCodec*)codec->codec_state, received, received_len,
+                                             erasure_positions, num_erasures,
+                                             decoded, *decoded_len, &errors_corrected);
+    if (stats) {
+        stats->errors_corrected = errors_corrected;
+        stats->errors_detected = errors_corrected;
+        stats->uncorrectable = (result != FSO_SUCCESS);
+    }
+    
+    if (result == FSO_SUCCESS) {
+        *decoded_len = codec->data_length;
+        FSO_LOG_DEBUG(FEC_MODULE, "Decoded %zu bytes with %d erasures, corrected %d symbols",
+                     received_len, num_erasures, errors_corrected);
+    }
+    
+    return result;
+}
+
+FSOErrorCode fec_decode_batch(FECCodec* codec, const uint8_t* received, size_t num_codewords,
+                              uint8_t* decoded, FECStats* stats)
+{
+    FSO_CHECK_NULL(codec);
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(codec->is_initialized);
+    FSO_CHECK_PARAM(num_codewords > 0);
+    
+    const size_t n = (size_t)codec->code_length;
+    const size_t k = (size_t)codec->data_length;
+    
+    if (stats) {
+        memset(stats, 0, num_codewords * sizeof(FECStats));
+    }
+    
+    if (codec->type != FEC_LDPC) {
+        /* No batched kernel: decode word by word */
+        for (size_t w = 0; w < num_codewords; w++) {
+            size_t decoded_len = k;
+            FSOErrorCode result = fec_decode(codec, received + w * n, n, decoded + w * k,
+                                             &decoded_len, stats ? &stats[w] : NULL);
+            if (result == FSO_ERROR_CONVERGENCE) {
+                /* Uncorrectable word: already flagged in its stats entry */
+                continue;
+            }
+            if (result != FSO_SUCCESS) {
+                return result;
+            }
+        }
+        return FSO_SUCCESS;
+    }
+    
+    LDPCCodec* ldpc_codec = (LDPCCodec*)codec->codec_state;
+    int* iterations = NULL;
+    int* converged = NULL;
+    
+    if (stats) {
+        iterations = (int*)malloc(num_codewords * sizeof(int));
+        converged = (int*)malloc(num_codewords * sizeof(int));
+        if (!iterations || !converged) {
+            free(iterations);
+            free(converged);
+            FSO_LOG_ERROR(FEC_MODULE, "Failed to allocate batch statistics");
+            return FSO_ERROR_MEMORY;
+        }
+    }
+    
+    FSOErrorCode result = ldpc_decode_batch(ldpc_codec, received, num_codewords,
+                                            decoded, iterations, converged);
+    
+    if (result == FSO_SUCCESS && stats) {
+        for (size_t w = 0; w < num_codewords; w++) {
+            int errors_corrected = 0;
+            for (size_t i = 0; i < k; i++) {
+                if ((received[w * n + i] != 0) != decoded[w * k + i]) {
+                    errors_corrected++;
+                }
+            }
+            stats[w].errors_corrected = errors_corrected;
+            stats[w].errors_detected = errors_corrected;
+            stats[w].uncorrectable = !converged[w];
+            stats[w].iterations = iterations[w];
+        }
+    }
+    
+    free(iterations);
+    free(converged);
+    
+    if (result == FSO_SUCCESS) {
+        FSO_LOG_DEBUG(FEC_MODULE, "Batch decoded %zu codewords using %s",
+                     num_codewords, fec_type_string(codec->type));
+    }
+    
+    return result;
+}
+
+FSOErrorCode fec_rate_compatible_order(const FECCodec* codec, int* order)
+{
+    FSO_CHECK_NULL(codec);
+    FSO_CHECK_NULL(order);
+    FSO_CHECK_PARAM(codec->is_initialized);
+    
+    if (codec->type != FEC_LDPC) {
+        FSO_LOG_ERROR(FEC_MODULE, "Rate-compatible puncturing requires an LDPC codec");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    return ldpc_rate_compatible_order((const LDPCCodec*)codec->codec_state, order);
+}
+
 FSOErrorCode fec_validate_config(FECType type, int data_length, int code_length, 
                                  void* config)
 {
@@ -329,7 +960,8 @@ FSOErrorCode interleaver_init(InterleaverConfig* config, int block_size, int dep
     config->block_size = block_size;
     config->depth = depth;
     
-    /* Allocate permutation table (not used for block interleaver, but reserved for future) */
+    /* The block interleaver is computed; only the other types need a table */
+    config->type = INTERLEAVER_BLOCK;
     config->permutation_table = NULL;
     
     FSO_LOG_INFO(FEC_MODULE, "Interleaver initialized: block_size=%d, depth=%d",
@@ -338,6 +970,116 @@ FSOErrorCode interleaver_init(InterleaverConfig* config, int block_size, int dep
     return FSO_SUCCESS;
 }
 
+FSOErrorCode interleaver_init_permutation(InterleaverConfig* config, InterleaverType type,
+                                          int block_size, int depth,
+                                          unsigned int seed, int param)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_PARAM(block_size > 0);
+    FSO_CHECK_PARAM(depth > 0);
+    FSO_CHECK_PARAM(type >= INTERLEAVER_BLOCK && type < INTERLEAVER_CUSTOM);
+    FSO_CHECK_PARAM(param >= 0);
+    
+    if (type == INTERLEAVER_BLOCK) {
+        return interleaver_init(config, block_size, depth);
+    }
+    
+    size_t frame_len = (size_t)block_size * (size_t)depth;
+    FSO_CHECK_PARAM(frame_len <= (size_t)INT32_MAX);
+    
+    memset(config, 0, sizeof(InterleaverConfig));
+    config->permutation_table = (int*)malloc(frame_len * sizeof(int));
+    if (config->permutation_table == NULL) {
+        FSO_LOG_ERROR(FEC_MODULE, "Failed to allocate %zu-entry permutation table", frame_len);
+        return FSO_ERROR_MEMORY;
+    }
+    config->block_size = block_size;
+    config->depth = depth;
+    config->type = type;
+    
+    /* xorshift has no zero state */
+    uint32_t state = seed ? (uint32_t)seed : 0x9E3779B9u;
+    
+    if (type == INTERLEAVER_RANDOM) {
+        fec_build_random(config->permutation_table, frame_len, &state);
+    } else if (type == INTERLEAVER_S_RANDOM) {
+        int spread = param ? param : (int)sqrt((double)frame_len / 8.0);
+        int achieved = fec_build_s_random(config->permutation_table, frame_len, spread, &state);
+        if (achieved < 0) {
+            interleaver_free(config);
+            return FSO_ERROR_MEMORY;
+        }
+        if (achieved < spread) {
+            FSO_LOG_WARNING(FEC_MODULE, "S-random spread %d not reached, using S=%d",
+                           spread, achieved);
+        }
+        param = achieved;
+    } else {
+        fec_build_convolutional(config->permutation_table, block_size, depth, param ? param : 1);
+    }
+    
+    FSO_LOG_INFO(FEC_MODULE, "Interleaver initialized: %s, block_size=%d, depth=%d, param=%d",
+                interleaver_type_string(type), block_size, depth, param);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode interleaver_set_permutation(InterleaverConfig* config, const int* table,
+                                         int block_size, int depth)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(table);
+    FSO_CHECK_PARAM(block_size > 0);
+    FSO_CHECK_PARAM(depth > 0);
+    
+    size_t frame_len = (size_t)block_size * (size_t)depth;
+    FSO_CHECK_PARAM(frame_len <= (size_t)INT32_MAX);
+    
+    /* Every position must be hit exactly once */
+    uint8_t* seen = (uint8_t*)calloc((frame_len + 7) / 8, 1);
+    if (seen == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    for (size_t i = 0; i < frame_len; i++) {
+        int v = table[i];
+        if (v < 0 || (size_t)v >= frame_len || (seen[v >> 3] & (1u << (v & 7)))) {
+            FSO_LOG_ERROR(FEC_MODULE, "Interleaver table is not a permutation (entry %zu = %d)",
+                         i, v);
+            free(seen);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+        seen[v >> 3] |= (uint8_t)(1u << (v & 7));
+    }
+    free(seen);
+    
+    memset(config, 0, sizeof(InterleaverConfig));
+    config->permutation_table = (int*)malloc(frame_len * sizeof(int));
+    if (config->permutation_table == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    memcpy(config->permutation_table, table, frame_len * sizeof(int));
+    config->block_size = block_size;
+    config->depth = depth;
+    config->type = INTERLEAVER_CUSTOM;
+    
+    FSO_LOG_INFO(FEC_MODULE, "Interleaver initialized: custom table, block_size=%d, depth=%d",
+                block_size, depth);
+    
+    return FSO_SUCCESS;
+}
+
+const char* interleaver_type_string(InterleaverType type)
+{
+    switch (type) {
+        case INTERLEAVER_BLOCK: return "Block";
+        case INTERLEAVER_RANDOM: return "Random";
+        case INTERLEAVER_S_RANDOM: return "S-random";
+        case INTERLEAVER_CONVOLUTIONAL: return "Convolutional";
+        case INTERLEAVER_CUSTOM: return "Custom";
+        default: return "Unknown";
+    }
+}
+
 FSOErrorCode interleaver_free(InterleaverConfig* config)
 {
     FSO_CHECK_NULL(config);
@@ -376,35 +1118,13 @@ FSOErrorCode interleave(const InterleaverConfig* config, const uint8_t* input,
      * Read column-wise:
      * Output: [0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11]
      * 
-     * This distributes burst errors across multiple codewords.
+     * This distributes burst errors across multiple codewords. The
+     * transpose runs in cache-sized tiles; table-driven types instead
+     * gather output[i] = input[table[i]] within each frame.
      */
     
-    int total_size = config->block_size * config->depth;
-    size_t full_blocks = input_len / total_size;
-    size_t remaining = input_len % total_size;
-    
-    size_t out_idx = 0;
-    size_t in_idx = 0;
-    
-    /* Process full blocks */
-    for (size_t block = 0; block < full_blocks; block++) {
-        /* Read column-wise from the conceptual matrix */
-        for (int col = 0; col < config->block_size; col++) {
-            for (int row = 0; row < config->depth; row++) {
-                /* Calculate input position: block_start + row * block_size + col */
-                size_t src_idx = in_idx + row * config->block_size + col;
-                output[out_idx++] = input[src_idx];
-            }
-        }
-        in_idx += total_size;
-    }
-    
-    /* Handle remaining bytes (partial block) - copy directly without interleaving */
-    if (remaining > 0) {
-        for (size_t i = 0; i < remaining; i++) {
-            output[out_idx++] = input[in_idx + i];
-        }
-    }
+    fec_interleave_frames(config, input, input_len, output, 1,
+                          (size_t)config->depth, (size_t)config->block_size, 1);
     
     FSO_LOG_DEBUG(FEC_MODULE, "Interleaved %zu bytes", input_len);
     
@@ -434,36 +1154,115 @@ FSOErrorCode deinterleave(const InterleaverConfig* config, const uint8_t* input,
      * 
      * Write row-wise:
      * Output: [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11]
+     * 
+     * Table-driven types scatter output[table[i]] = input[i].
      */
     
-    int total_size = config->block_size * config->depth;
-    size_t full_blocks = input_len / total_size;
-    size_t remaining = input_len % total_size;
-    
-    size_t in_idx = 0;
-    size_t out_idx = 0;
-    
-    /* Process full blocks */
-    for (size_t block = 0; block < full_blocks; block++) {
-        /* Write row-wise to the output (reverse of column-wise reading) */
-        for (int col = 0; col < config->block_size; col++) {
-            for (int row = 0; row < config->depth; row++) {
-                /* Calculate output position: block_start + row * block_size + col */
-                size_t dst_idx = out_idx + row * config->block_size + col;
-                output[dst_idx] = input[in_idx++];
-            }
-        }
-        out_idx += total_size;
+    fec_interleave_frames(config, input, input_len, output, 1,
+                          (size_t)config->block_size, (size_t)config->depth, 0);
+    
+    FSO_LOG_DEBUG(FEC_MODULE, "Deinterleaved %zu bytes", input_len);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode deinterleave_llr(const InterleaverConfig* config, const float* input,
+                              size_t input_len, float* output, size_t output_len)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(config->block_size > 0);
+    FSO_CHECK_PARAM(config->depth > 0);
+    FSO_CHECK_PARAM(output_len >= input_len);
+    
+    /* Same permutation as deinterleave(), moving each byte's 8 LLRs together */
+    fec_interleave_frames(config, (const uint8_t*)input, input_len, (uint8_t*)output,
+                          8 * sizeof(float), (size_t)config->block_size,
+                          (size_t)config->depth, 0);
+    
+    FSO_LOG_DEBUG(FEC_MODULE, "Deinterleaved LLRs of %zu bytes", input_len);
+    
+    return FSO_SUCCESS;
+}
+
+size_t interleaver_inplace_scratch_size(const InterleaverConfig* config)
+{
+    if (config == NULL || config->block_size <= 0 || config->depth <= 0) {
+        return 0;
     }
+    return ((size_t)config->block_size * (size_t)config->depth + 7) / 8;
+}
+
+FSOErrorCode interleave_inplace(const InterleaverConfig* config, uint8_t* data,
+                                size_t data_len, uint8_t* scratch)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(scratch);
+    FSO_CHECK_PARAM(config->block_size > 0);
+    FSO_CHECK_PARAM(config->depth > 0);
     
-    /* Handle remaining bytes (partial block) - copy directly without deinterleaving */
-    if (remaining > 0) {
-        for (size_t i = 0; i < remaining; i++) {
-            output[out_idx + i] = input[in_idx++];
-        }
+    /* Same layout as interleave(): each full block is a depth x block_size
+     * matrix read column-wise (or the table's gather); a partial tail
+     * block stays in place */
+    size_t total_size = (size_t)config->block_size * (size_t)config->depth;
+    if (config->permutation_table != NULL) {
+        fec_permute_blocks_inplace(data, 1, config->permutation_table, total_size,
+                                   data_len / total_size, 1, scratch);
+    } else {
+        fec_transpose_blocks_inplace(data, 1, config->depth, config->block_size,
+                                     data_len / total_size, scratch);
     }
     
-    FSO_LOG_DEBUG(FEC_MODULE, "Deinterleaved %zu bytes", input_len);
+    FSO_LOG_DEBUG(FEC_MODULE, "Interleaved %zu bytes in place", data_len);
     
     return FSO_SUCCESS;
-}
\ No newline at end of file
+}
+
+FSOErrorCode deinterleave_inplace(const InterleaverConfig* config, uint8_t* data,
+                                  size_t data_len, uint8_t* scratch)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(scratch);
+    FSO_CHECK_PARAM(config->block_size > 0);
+    FSO_CHECK_PARAM(config->depth > 0);
+    
+    /* The inverse of a depth x block_size transpose is a block_size x depth one */
+    size_t total_size = (size_t)config->block_size * (size_t)config->depth;
+    if (config->permutation_table != NULL) {
+        fec_permute_blocks_inplace(data, 1, config->permutation_table, total_size,
+                                   data_len / total_size, 0, scratch);
+    } else {
+        fec_transpose_blocks_inplace(data, 1, config->block_size, config->depth,
+                                     data_len / total_size, scratch);
+    }
+    
+    FSO_LOG_DEBUG(FEC_MODULE, "Deinterleaved %zu bytes in place", data_len);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode deinterleave_llr_inplace(const InterleaverConfig* config, float* llr,
+                                      size_t data_len, uint8_t* scratch)
+{
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(scratch);
+    FSO_CHECK_PARAM(config->block_size > 0);
+    FSO_CHECK_PARAM(config->depth > 0);
+    
+    size_t total_size = (size_t)config->block_size * (size_t)config->depth;
+    if (config->permutation_table != NULL) {
+        fec_permute_blocks_inplace((uint8_t*)llr, 8 * sizeof(float), config->permutation_table,
+                                   total_size, data_len / total_size, 0, scratch);
+    } else {
+        fec_transpose_blocks_inplace((uint8_t*)llr, 8 * sizeof(float), config->block_size,
+                                     config->depth, data_len / total_size, scratch);
+    }
+    
+    FSO_LOG_DEBUG(FEC_MODULE, "Deinterleaved LLRs of %zu bytes in place", data_len);
+    
+    return FSO_SUCCESS;
+}
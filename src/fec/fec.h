@@ -60,6 +60,50 @@ typedef struct {
     int fcr;                /**< First consecutive root index */
 } RSConfig;
 
+/**
+ * @brief LDPC check-node update algorithm
+ * 
+ * The min-sum variants trade a small coding loss for an O(degree)
+ * two-minimum update without transcendental functions.
+ */
+typedef enum {
+    LDPC_CHECK_SUM_PRODUCT = 0,     /**< Exact sum-product (log-domain phi function) */
+    LDPC_CHECK_NORMALIZED_MIN_SUM,  /**< Min-sum with multiplicative correction */
+    LDPC_CHECK_OFFSET_MIN_SUM       /**< Min-sum with subtractive correction */
+} LDPCCheckNodeAlgorithm;
+
+/**
+ * @brief LDPC message-passing schedule
+ */
+typedef enum {
+    LDPC_SCHEDULE_FLOODING = 0,     /**< All checks, then all variables, per iteration */
+    LDPC_SCHEDULE_LAYERED           /**< Row-serial: posteriors updated after every check row */
+} LDPCSchedule;
+
+/**
+ * @brief Message format used by the batched LDPC decoder
+ * 
+ * The fixed-point formats always use a min-sum check update; a
+ * sum-product configuration falls back to normalized min-sum.
+ */
+typedef enum {
+    LDPC_LLR_FLOAT = 0,             /**< 32-bit floating-point messages */
+    LDPC_LLR_INT16,                 /**< 16-bit saturating fixed-point messages */
+    LDPC_LLR_INT8                   /**< Fixed-point messages saturated to the 8-bit range */
+} LDPCLLRFormat;
+
+/**
+ * @brief Where batched LDPC decoding runs
+ * 
+ * The CUDA backend needs a build with CUDA=1 and a visible device;
+ * otherwise the codec falls back to the CPU. Both produce identical
+ * decisions for a given message format.
+ */
+typedef enum {
+    LDPC_BACKEND_CPU = 0,           /**< Lane-parallel decoding on the worker pool */
+    LDPC_BACKEND_CUDA               /**< One GPU thread per codeword, graph resident on the device */
+} LDPCBackend;
+
 /**
  * @brief LDPC configuration parameters
  */
@@ -71,15 +115,40 @@ typedef struct {
     int* parity_check_matrix; /**< Sparse parity check matrix representation */
     int matrix_rows;        /**< Number of rows in parity check matrix */
     int matrix_cols;        /**< Number of columns in parity check matrix */
+    LDPCCheckNodeAlgorithm check_node_algorithm; /**< Check-node update rule (default sum-product) */
+    double min_sum_scale;   /**< Normalized min-sum factor in (0, 1] (0 = default) */
+    double min_sum_offset;  /**< Offset min-sum correction, >= 0 (0 = default) */
+    LDPCSchedule schedule;  /**< Message-passing schedule (default flooding) */
+    int layer_size;         /**< Check rows per layer for the layered early exit (0 = 1) */
+    LDPCLLRFormat llr_format; /**< Message format for batched and fixed-point soft decoding (default float) */
+    unsigned int matrix_seed; /**< Random H construction seed (0 = structured construction) */
+    int lifting_size;       /**< Quasi-cyclic lifting size Z; n and k must be multiples of Z (0 = unstructured H) */
+    LDPCBackend backend;    /**< Batch decode backend (default CPU) */
 } LDPCConfig;
 
+/**
+ * @brief Interleaver permutation family
+ * 
+ * The block interleaver is computed (a cache-tiled transpose); every
+ * other type runs from a permutation table over one
+ * block_size x depth frame.
+ */
+typedef enum {
+    INTERLEAVER_BLOCK = 0,          /**< Row-in, column-out block interleaver */
+    INTERLEAVER_RANDOM,             /**< Seeded uniform random permutation */
+    INTERLEAVER_S_RANDOM,           /**< Random with spread: neighbours within S land more than S apart */
+    INTERLEAVER_CONVOLUTIONAL,      /**< Tail-biting convolutional: branch b delayed by b * J slots */
+    INTERLEAVER_CUSTOM              /**< Caller-supplied table (interleaver_set_permutation()) */
+} InterleaverType;
+
 /**
  * @brief Interleaver configuration parameters
  */
 typedef struct {
     int block_size;         /**< Size of each interleaver block */
     int depth;              /**< Interleaver depth (number of blocks) */
-    int* permutation_table; /**< Permutation table for interleaving */
+    InterleaverType type;   /**< Permutation family */
+    int* permutation_table; /**< Output position -> input position over one frame (NULL for block) */
 } InterleaverConfig;
 
 /* ============================================================================
@@ -145,6 +214,49 @@ FSOErrorCode fec_encode(FECCodec* codec, const uint8_t* data, size_t data_len,
 FSOErrorCode fec_decode(FECCodec* codec, const uint8_t* received, size_t received_len,
                         uint8_t* decoded, size_t* decoded_len, FECStats* stats);
 
+/**
+ * @brief Decode data from per-bit log-likelihood ratios
+ * 
+ * Soft-input counterpart of fec_decode(). llr holds one LLR per bit of the
+ * received codeword bytes, MSB first, as written by demodulate_soft()
+ * (positive favours 0). LDPC codecs feed the LLR of each byte's code bit
+ * straight into belief propagation (quantized first when the codec's
+ * llr_format is fixed-point); Reed-Solomon codecs slice the signs back
+ * into symbols for the algebraic decoder.
+ * 
+ * @param codec Pointer to initialized FEC codec
+ * @param llr Received bit LLRs
+ * @param llr_len Number of LLRs (8 * code_length)
+ * @param decoded Output buffer for decoded data
+ * @param decoded_len Pointer to store actual decoded length
+ * @param stats Pointer to store decoding statistics (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode fec_decode_soft(FECCodec* codec, const float* llr, size_t llr_len,
+                             uint8_t* decoded, size_t* decoded_len, FECStats* stats);
+
+/**
+ * @brief Decode data with known erasure positions
+ * 
+ * Like fec_decode(), but symbols the demodulator flagged as unreliable are
+ * passed as erasures. Reed-Solomon codecs correct e errors and f erasures
+ * as long as 2e + f <= num_roots. Codecs without erasure support return
+ * FSO_ERROR_UNSUPPORTED when num_erasures is non-zero.
+ * 
+ * @param codec Pointer to initialized FEC codec
+ * @param received Received data to decode
+ * @param received_len Length of received data
+ * @param erasure_positions Indices of erased symbols in received (can be NULL if num_erasures is 0)
+ * @param num_erasures Number of erased symbols
+ * @param decoded Output buffer for decoded data
+ * @param decoded_len Pointer to store actual decoded length
+ * @param stats Pointer to store decoding statistics (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode fec_decode_erasures(FECCodec* codec, const uint8_t* received, size_t received_len,
+                                 const int* erasure_positions, int num_erasures,
+                                 uint8_t* decoded, size_t* decoded_len, FECStats* stats);
+
 /**
  * @brief Validate FEC configuration
  * 
@@ -197,6 +309,41 @@ double fec_calculate_code_rate(int data_length, int code_length);
  */
 int fec_is_initialized(const FECCodec* codec);
 
+/**
+ * @brief Decode a batch of codewords
+ * 
+ * Decodes num_codewords received words stored back to back (code_length
+ * each) into back-to-back data blocks (data_length each). LDPC codecs
+ * decode the words together with one codeword per SIMD lane, with lane
+ * groups spread over the shared worker pool, or on the GPU when the codec
+ * was configured with LDPC_BACKEND_CUDA; other codec types fall back to
+ * one fec_decode() call per word.
+ * 
+ * @param codec Pointer to initialized FEC codec
+ * @param received Received codewords (num_codewords * code_length)
+ * @param num_codewords Number of codewords in the batch
+ * @param decoded Output decoded data (num_codewords * data_length)
+ * @param stats Optional array of num_codewords statistics entries (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode fec_decode_batch(FECCodec* codec, const uint8_t* received, size_t num_codewords,
+                              uint8_t* decoded, FECStats* stats);
+
+/**
+ * @brief Codeword transmission order for incremental redundancy
+ * 
+ * Fills order with the code_length codeword positions so that every
+ * prefix of at least data_length entries is a rate-compatible punctured
+ * code (see ldpc_rate_compatible_order()). Positions left out of a
+ * prefix are decoded as erasures (zero LLR).
+ * 
+ * @param codec Pointer to initialized FEC codec
+ * @param order Output codeword positions (code_length entries)
+ * @return FSO_SUCCESS on success, FSO_ERROR_UNSUPPORTED for codecs
+ *         other than LDPC
+ */
+FSOErrorCode fec_rate_compatible_order(const FECCodec* codec, int* order);
+
 /* ============================================================================
  * Interleaving Functions
  * ============================================================================ */
@@ -213,6 +360,56 @@ int fec_is_initialized(const FECCodec* codec);
  */
 FSOErrorCode interleaver_init(InterleaverConfig* config, int block_size, int depth);
 
+/**
+ * @brief Initialize a table-driven interleaver
+ * 
+ * Builds a permutation over frames of block_size * depth bytes. The
+ * parameter's meaning depends on the type: the spread S for
+ * INTERLEAVER_S_RANDOM (0 = sqrt(frame / 8)) and the cell size J for
+ * INTERLEAVER_CONVOLUTIONAL, where byte p travels on branch p % depth
+ * (0 = 1). It is ignored otherwise. INTERLEAVER_BLOCK gives the same
+ * result as interleaver_init(), and INTERLEAVER_CUSTOM is set up with
+ * interleaver_set_permutation() instead.
+ * 
+ * S-random construction is quadratic in the frame size; it suits
+ * codeword-scale frames rather than multi-megabyte ones.
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param type Permutation family
+ * @param block_size Size of each block to interleave
+ * @param depth Interleaver depth
+ * @param seed Seed for the random types
+ * @param param Spread S or cell size J (see above)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode interleaver_init_permutation(InterleaverConfig* config, InterleaverType type,
+                                          int block_size, int depth,
+                                          unsigned int seed, int param);
+
+/**
+ * @brief Initialize an interleaver from a caller-supplied permutation
+ * 
+ * The table is copied. table[i] names the input position sent to output
+ * position i, and must be a permutation of 0 .. block_size * depth - 1.
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param table Permutation of block_size * depth entries
+ * @param block_size Size of each block to interleave
+ * @param depth Interleaver depth
+ * @return FSO_SUCCESS on success, FSO_ERROR_INVALID_PARAM if table is not
+ *         a permutation, error code otherwise
+ */
+FSOErrorCode interleaver_set_permutation(InterleaverConfig* config, const int* table,
+                                         int block_size, int depth);
+
+/**
+ * @brief Name of an interleaver type
+ * 
+ * @param type Permutation family
+ * @return Static string
+ */
+const char* interleaver_type_string(InterleaverType type);
+
 /**
  * @brief Free interleaver resources
  * 
@@ -226,7 +423,9 @@ FSOErrorCode interleaver_free(InterleaverConfig* config);
 /**
  * @brief Interleave data
  * 
- * Applies block interleaving to input data to distribute burst errors.
+ * Applies the configured permutation to each full frame of
+ * block_size * depth bytes to distribute burst errors. A trailing
+ * partial frame is copied unchanged.
  * 
  * @param config Pointer to interleaver configuration
  * @param input Input data to interleave
@@ -253,6 +452,75 @@ FSOErrorCode interleave(const InterleaverConfig* config, const uint8_t* input,
 FSOErrorCode deinterleave(const InterleaverConfig* config, const uint8_t* input,
                           size_t input_len, uint8_t* output, size_t output_len);
 
+/**
+ * @brief Deinterleave per-bit LLRs
+ * 
+ * Applies the deinterleave() byte permutation to LLR data, where each
+ * byte is represented by its 8 bit LLRs.
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param input Interleaved LLRs (8 * input_len)
+ * @param input_len Length of the interleaved data in bytes
+ * @param output Output buffer for deinterleaved LLRs
+ * @param output_len Length of the output buffer in bytes (8 LLRs each)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode deinterleave_llr(const InterleaverConfig* config, const float* input,
+                              size_t input_len, float* output, size_t output_len);
+
+/**
+ * @brief Scratch bytes needed by the in-place interleaver variants
+ * 
+ * @param config Pointer to interleaver configuration
+ * @return Size of the position bitmap (one bit per block element), 0 if
+ *         config is invalid
+ */
+size_t interleaver_inplace_scratch_size(const InterleaverConfig* config);
+
+/**
+ * @brief Interleave data in place
+ * 
+ * Produces the same output as interleave() without a second buffer by
+ * following the permutation's cycles. The scratch bitmap is caller-owned
+ * so repeated calls allocate nothing.
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param data Data to interleave, overwritten with the result
+ * @param data_len Length of data
+ * @param scratch Workspace of interleaver_inplace_scratch_size() bytes
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode interleave_inplace(const InterleaverConfig* config, uint8_t* data,
+                                size_t data_len, uint8_t* scratch);
+
+/**
+ * @brief Deinterleave data in place
+ * 
+ * In-place counterpart of deinterleave(); see interleave_inplace().
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param data Interleaved data, overwritten with the original order
+ * @param data_len Length of data
+ * @param scratch Workspace of interleaver_inplace_scratch_size() bytes
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode deinterleave_inplace(const InterleaverConfig* config, uint8_t* data,
+                                  size_t data_len, uint8_t* scratch);
+
+/**
+ * @brief Deinterleave per-bit LLRs in place
+ * 
+ * In-place counterpart of deinterleave_llr().
+ * 
+ * @param config Pointer to interleaver configuration
+ * @param llr Interleaved LLRs (8 per byte), overwritten with the original order
+ * @param data_len Length of the interleaved data in bytes
+ * @param scratch Workspace of interleaver_inplace_scratch_size() bytes
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode deinterleave_llr_inplace(const InterleaverConfig* config, float* llr,
+                                      size_t data_len, uint8_t* scratch);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
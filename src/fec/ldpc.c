@@ -7,9 +7,16 @@
  */
 
 #include "ldpc.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 /* ============================================================================
  * Module Constants
@@ -39,7 +46,23 @@ static const struct {
  * ============================================================================ */
 
 static FSOErrorCode ldpc_create_regular_matrix(LDPCCodec* ldpc, int dv, int dc);
-static FSOErrorCode ldpc_gaussian_elimination(SparseMatrix* H, SparseMatrix* G, int k);
+static FSOErrorCode ldpc_create_random_regular_matrix(LDPCCodec* ldpc, int dv, int dc);
+static void ldpc_detach_graph(LDPCCodec* ldpc);
+static FSOErrorCode ldpc_gaussian_elimination(SparseMatrix* H, int k, uint64_t* parity_rows,
+                                              int parity_words, int* columns_swapped);
+static FSOErrorCode ldpc_build_generator_csr(LDPCCodec* ldpc);
+static void ldpc_check_update_sum_product(LDPCCodec* ldpc, int row_begin, int row_end);
+static void ldpc_check_update_min_sum(LDPCCodec* ldpc, int row_begin, int row_end,
+                                      double scale, double offset);
+static FSOErrorCode ldpc_check_update_rows(LDPCCodec* ldpc, int row_begin, int row_end);
+static FSOErrorCode ldpc_decode_flooding(LDPCCodec* ldpc, int* iterations, int* converged);
+static FSOErrorCode ldpc_decode_layered(LDPCCodec* ldpc, int* iterations, int* converged);
+static inline double ldpc_phi(double x);
+static inline double ldpc_phi_inverse(double sum_phi);
+static void ldpc_batch_workspace_free(void* workspace);
+static FSOErrorCode ldpc_create_qc_matrix(LDPCCodec* ldpc);
+static void ldpc_qc_encode(LDPCCodec* ldpc, const uint8_t* data, uint8_t* encoded);
+static FSOErrorCode ldpc_decode_qc_layered(LDPCCodec* ldpc, int* iterations, int* converged);
 static int gcd(int a, int b);
 
 /* ============================================================================
@@ -52,6 +75,15 @@ FSOErrorCode ldpc_init(LDPCCodec* ldpc, const LDPCConfig* config, int n, int k)
     FSO_CHECK_NULL(config);
     FSO_CHECK_PARAM(n > k && k > 0);
     FSO_CHECK_PARAM(n <= LDPC_MAX_CODE_LENGTH);
+    FSO_CHECK_PARAM(config->lifting_size >= 0);
+    
+    if (config->lifting_size > 0) {
+        int Z = config->lifting_size;
+        if (n % Z != 0 || k % Z != 0 || (n - k) / Z < LDPC_QC_MIN_BASE_ROWS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "LDPC(%d,%d) has no QC base graph for Z=%d", n, k, Z);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+    }
     
     memset(ldpc, 0, sizeof(LDPCCodec));
     
@@ -63,16 +95,34 @@ FSOErrorCode ldpc_init(LDPCCodec* ldpc, const LDPCConfig* config, int n, int k)
     ldpc->max_iterations = config->max_iterations > 0 ? config->max_iterations : LDPC_MAX_ITERATIONS;
     ldpc->convergence_threshold = config->convergence_threshold > 0 ? 
                                   config->convergence_threshold : LDPC_DEFAULT_CONVERGENCE_THRESHOLD;
+    ldpc->check_node_algorithm = config->check_node_algorithm;
+    ldpc->min_sum_scale = config->min_sum_scale > 0 ? 
+                          config->min_sum_scale : LDPC_DEFAULT_MIN_SUM_SCALE;
+    ldpc->min_sum_offset = config->min_sum_offset > 0 ? 
+                           config->min_sum_offset : LDPC_DEFAULT_MIN_SUM_OFFSET;
+    ldpc->schedule = config->schedule;
+    ldpc->layer_size = config->layer_size > 0 ? config->layer_size : 1;
+    ldpc->llr_format = config->llr_format;
+    ldpc->matrix_seed = config->matrix_seed;
+    ldpc->lifting_size = config->lifting_size;
+    ldpc->batch_workspace = NULL;
+    ldpc->backend = config->backend;
+    ldpc->device = NULL;
+    
+    if (ldpc->backend == LDPC_BACKEND_CUDA && ldpc_cuda_available() == 0) {
+        FSO_LOG_WARNING(LDPC_MODULE, "No CUDA device available, batch decoding stays on the CPU");
+        ldpc->backend = LDPC_BACKEND_CPU;
+    }
     
     /* Allocate parity-check matrix */
-    ldpc->H = (SparseMatrix*)malloc(sizeof(SparseMatrix));
+    ldpc->H = (SparseMatrix*)calloc(1, sizeof(SparseMatrix));
     if (!ldpc->H) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate parity-check matrix");
         return FSO_ERROR_MEMORY;
     }
     
     /* Allocate generator matrix */
-    ldpc->G = (SparseMatrix*)malloc(sizeof(SparseMatrix));
+    ldpc->G = (SparseMatrix*)calloc(1, sizeof(SparseMatrix));
     if (!ldpc->G) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate generator matrix");
         free(ldpc->H);
@@ -80,16 +130,14 @@ FSOErrorCode ldpc_init(LDPCCodec* ldpc, const LDPCConfig* config, int n, int k)
         return FSO_ERROR_MEMORY;
     }
     
-    /* Allocate workspace arrays */
-    ldpc->variable_to_check = (double*)calloc(n * ldpc->m, sizeof(double));
-    ldpc->check_to_variable = (double*)calloc(n * ldpc->m, sizeof(double));
+    /* Allocate workspace arrays (per-edge message arrays are allocated
+     * together with the message graph, once the edge count is known) */
     ldpc->posterior_llr = (double*)calloc(n, sizeof(double));
     ldpc->channel_llr = (double*)calloc(n, sizeof(double));
     ldpc->decoded_bits = (int*)calloc(n, sizeof(int));
     ldpc->syndrome = (int*)calloc(ldpc->m, sizeof(int));
     
-    if (!ldpc->variable_to_check || !ldpc->check_to_variable || 
-        !ldpc->posterior_llr || !ldpc->channel_llr || 
+    if (!ldpc->posterior_llr || !ldpc->channel_llr || 
         !ldpc->decoded_bits || !ldpc->syndrome) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate LDPC workspace");
         ldpc_free(ldpc);
@@ -99,18 +147,34 @@ FSOErrorCode ldpc_init(LDPCCodec* ldpc, const LDPCConfig* config, int n, int k)
     /* Allocate connectivity arrays */
     ldpc->var_degree = (int*)calloc(n, sizeof(int));
     ldpc->check_degree = (int*)calloc(ldpc->m, sizeof(int));
-    ldpc->var_to_check_edges = (int**)calloc(n, sizeof(int*));
-    ldpc->check_to_var_edges = (int**)calloc(ldpc->m, sizeof(int*));
+    ldpc->var_edge_ptr = (int*)calloc(n + 1, sizeof(int));
     
-    if (!ldpc->var_degree || !ldpc->check_degree || 
-        !ldpc->var_to_check_edges || !ldpc->check_to_var_edges) {
+    if (!ldpc->var_degree || !ldpc->check_degree || !ldpc->var_edge_ptr) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate connectivity arrays");
         ldpc_free(ldpc);
         return FSO_ERROR_MEMORY;
     }
     
-    FSO_LOG_INFO(LDPC_MODULE, "LDPC codec initialized: LDPC(%d,%d) rate=%.3f",
-                n, k, ldpc->code_rate);
+    /* QC base graph and its encoder/decoder workspaces */
+    if (ldpc->lifting_size > 0) {
+        const int Z = ldpc->lifting_size;
+        ldpc->base_rows = ldpc->m / Z;
+        ldpc->base_cols = n / Z;
+        ldpc->qc_shifts = (int16_t*)malloc((size_t)ldpc->base_rows * ldpc->base_cols *
+                                           sizeof(int16_t));
+        ldpc->qc_encode_work = (uint8_t*)malloc((size_t)(ldpc->m + n));
+        ldpc->qc_row_work = (double*)malloc(3 * (size_t)Z * sizeof(double));
+        
+        if (!ldpc->qc_shifts || !ldpc->qc_encode_work || !ldpc->qc_row_work) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate QC base graph");
+            ldpc_free(ldpc);
+            return FSO_ERROR_MEMORY;
+        }
+    }
+    
+    FSO_LOG_INFO(LDPC_MODULE, "LDPC codec initialized: LDPC(%d,%d) rate=%.3f, check node=%s",
+                n, k, ldpc->code_rate,
+                ldpc_check_node_algorithm_string(ldpc->check_node_algorithm));
     
     return FSO_SUCCESS;
 }
@@ -119,6 +183,11 @@ FSOErrorCode ldpc_free(LDPCCodec* ldpc)
 {
     FSO_CHECK_NULL(ldpc);
     
+    /* Shared structure belongs to the graph cache */
+    if (ldpc->graph) {
+        ldpc_detach_graph(ldpc);
+    }
+    
     /* Free sparse matrices */
     if (ldpc->H) {
         sparse_matrix_free(ldpc->H);
@@ -132,6 +201,16 @@ FSOErrorCode ldpc_free(LDPCCodec* ldpc)
         ldpc->G = NULL;
     }
     
+    if (ldpc->parity_rows) {
+        free(ldpc->parity_rows);
+        ldpc->parity_rows = NULL;
+    }
+    
+    if (ldpc->parity_accum) {
+        free(ldpc->parity_accum);
+        ldpc->parity_accum = NULL;
+    }
+    
     /* Free workspace arrays */
     if (ldpc->variable_to_check) {
         free(ldpc->variable_to_check);
@@ -164,26 +243,28 @@ FSOErrorCode ldpc_free(LDPCCodec* ldpc)
     }
     
     /* Free connectivity arrays */
-    if (ldpc->var_to_check_edges) {
-        for (int i = 0; i < ldpc->n; i++) {
-            if (ldpc->var_to_check_edges[i]) {
-                free(ldpc->var_to_check_edges[i]);
-            }
-        }
-        free(ldpc->var_to_check_edges);
-        ldpc->var_to_check_edges = NULL;
+    if (ldpc->var_edge_ptr) {
+        free(ldpc->var_edge_ptr);
+        ldpc->var_edge_ptr = NULL;
     }
     
-    if (ldpc->check_to_var_edges) {
-        for (int i = 0; i < ldpc->m; i++) {
-            if (ldpc->check_to_var_edges[i]) {
-                free(ldpc->check_to_var_edges[i]);
-            }
-        }
-        free(ldpc->check_to_var_edges);
-        ldpc->check_to_var_edges = NULL;
+    if (ldpc->var_edge_index) {
+        free(ldpc->var_edge_index);
+        ldpc->var_edge_index = NULL;
+    }
+    
+    if (ldpc->edge_check) {
+        free(ldpc->edge_check);
+        ldpc->edge_check = NULL;
     }
     
+    if (ldpc->batch_workspace) {
+        ldpc_batch_workspace_free(ldpc->batch_workspace);
+        ldpc->batch_workspace = NULL;
+    }
+    
+    ldpc_cuda_release(ldpc);
+    
     if (ldpc->var_degree) {
         free(ldpc->var_degree);
         ldpc->var_degree = NULL;
@@ -194,6 +275,11 @@ FSOErrorCode ldpc_free(LDPCCodec* ldpc)
         ldpc->check_degree = NULL;
     }
     
+    /* QC base graph (unless shared) and workspaces */
+    free(ldpc->qc_shifts);
+    free(ldpc->qc_encode_work);
+    free(ldpc->qc_row_work);
+    
     memset(ldpc, 0, sizeof(LDPCCodec));
     FSO_LOG_DEBUG(LDPC_MODULE, "LDPC codec freed");
     
@@ -205,17 +291,30 @@ FSOErrorCode ldpc_generate_standard_matrix(LDPCCodec* ldpc, double code_rate)
     FSO_CHECK_NULL(ldpc);
     FSO_CHECK_PARAM(code_rate > 0.0 && code_rate < 1.0);
     
+    /* Quasi-cyclic codes take their degrees from the base graph */
+    if (ldpc->lifting_size > 0) {
+        FSOErrorCode result = ldpc_create_qc_matrix(ldpc);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to create QC-LDPC matrix");
+            return result;
+        }
+        
+        FSO_LOG_INFO(LDPC_MODULE, "Generated %dx%d QC-LDPC base graph (Z=%d) for rate %.3f",
+                    ldpc->base_rows, ldpc->base_cols, ldpc->lifting_size, code_rate);
+        return FSO_SUCCESS;
+    }
+    
     /* Determine variable and check node degrees based on code rate */
     int dv, dc; /* Variable node degree, check node degree */
     
     if (fabs(code_rate - LDPC_RATE_1_2) < 1e-6) {
         dv = 3; dc = 6;  /* Regular (3,6) LDPC for rate 1/2 */
     } else if (fabs(code_rate - LDPC_RATE_2_3) < 1e-6) {
-        dv = 4; dc = 8;  /* Regular (4,8) LDPC for rate 2/3 */
+        dv = 3; dc = 9;  /* Regular (3,9) LDPC for rate 2/3 */
     } else if (fabs(code_rate - LDPC_RATE_3_4) < 1e-6) {
-        dv = 5; dc = 10; /* Regular (5,10) LDPC for rate 3/4 */
+        dv = 3; dc = 12; /* Regular (3,12) LDPC for rate 3/4 */
     } else if (fabs(code_rate - LDPC_RATE_5_6) < 1e-6) {
-        dv = 6; dc = 12; /* Regular (6,12) LDPC for rate 5/6 */
+        dv = 3; dc = 18; /* Regular (3,18) LDPC for rate 5/6 */
     } else {
         /* Default to (3,6) for other rates */
         dv = 3; dc = 6;
@@ -223,7 +322,9 @@ FSOErrorCode ldpc_generate_standard_matrix(LDPCCodec* ldpc, double code_rate)
     }
     
     /* Create regular LDPC matrix */
-    FSOErrorCode result = ldpc_create_regular_matrix(ldpc, dv, dc);
+    FSOErrorCode result = ldpc->matrix_seed ?
+                          ldpc_create_random_regular_matrix(ldpc, dv, dc) :
+                          ldpc_create_regular_matrix(ldpc, dv, dc);
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to create regular LDPC matrix");
         return result;
@@ -240,24 +341,52 @@ FSOErrorCode ldpc_generate_generator_matrix(LDPCCodec* ldpc)
     FSO_CHECK_NULL(ldpc);
     FSO_CHECK_NULL(ldpc->H);
     
-    /* Initialize generator matrix */
-    FSOErrorCode result = sparse_matrix_init(ldpc->G, ldpc->k, ldpc->n, ldpc->k * ldpc->k);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to initialize generator matrix");
-        return result;
+    /* QC codes encode from the dual-diagonal base graph */
+    if (ldpc->lifting_size > 0) {
+        FSO_LOG_DEBUG(LDPC_MODULE, "QC-LDPC code needs no generator matrix");
+        return FSO_SUCCESS;
+    }
+    
+    /* Packed parity rows, padded so every row starts on a 32-byte boundary */
+    int words = (ldpc->m + 63) / 64;
+    words = (words + LDPC_PARITY_WORD_ALIGN - 1) / LDPC_PARITY_WORD_ALIGN * LDPC_PARITY_WORD_ALIGN;
+    
+    free(ldpc->parity_rows);
+    free(ldpc->parity_accum);
+    ldpc->parity_words = words;
+    ldpc->parity_rows = (uint64_t*)aligned_alloc(32, (size_t)ldpc->k * words * sizeof(uint64_t));
+    ldpc->parity_accum = (uint64_t*)aligned_alloc(32, (size_t)words * sizeof(uint64_t));
+    if (!ldpc->parity_rows || !ldpc->parity_accum) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate packed parity rows");
+        return FSO_ERROR_MEMORY;
     }
+    memset(ldpc->parity_rows, 0, (size_t)ldpc->k * words * sizeof(uint64_t));
     
     /* Perform Gaussian elimination to get systematic form */
-    result = ldpc_gaussian_elimination(ldpc->H, ldpc->G, ldpc->k);
+    int columns_swapped = 0;
+    FSOErrorCode result = ldpc_gaussian_elimination(ldpc->H, ldpc->k, ldpc->parity_rows,
+                                                    words, &columns_swapped);
     if (result != FSO_SUCCESS) {
         FSO_LOG_ERROR(LDPC_MODULE, "Failed to perform Gaussian elimination");
         return result;
     }
     
-    /* Convert to CSR format for efficient multiplication */
-    result = sparse_matrix_to_csr(ldpc->G);
+    /* Column swaps relabel codeword bits; rebuild the graph to match */
+    if (columns_swapped > 0) {
+        result = sparse_matrix_to_csr(ldpc->H);
+        if (result == FSO_SUCCESS) {
+            result = ldpc_init_message_graph(ldpc);
+        }
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to rebuild H after column swaps");
+            return result;
+        }
+    }
+    
+    /* Sparse G = [I | P] for callers that walk the generator directly */
+    result = ldpc_build_generator_csr(ldpc);
     if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to convert generator matrix to CSR");
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to build generator matrix");
         return result;
     }
     
@@ -267,6 +396,26 @@ FSOErrorCode ldpc_generate_generator_matrix(LDPCCodec* ldpc)
     return FSO_SUCCESS;
 }
 
+/**
+ * @brief acc ^= row & mask over a whole packed parity row
+ */
+static inline void ldpc_xor_parity_row(uint64_t* acc, const uint64_t* row,
+                                       uint64_t mask, int words)
+{
+#ifdef __AVX2__
+    const __m256i m = _mm256_set1_epi64x((long long)mask);
+    for (int w = 0; w < words; w += LDPC_PARITY_WORD_ALIGN) {
+        __m256i a = _mm256_load_si256((const __m256i*)(acc + w));
+        __m256i r = _mm256_load_si256((const __m256i*)(row + w));
+        _mm256_store_si256((__m256i*)(acc + w), _mm256_xor_si256(a, _mm256_and_si256(r, m)));
+    }
+#else
+    for (int w = 0; w < words; w++) {
+        acc[w] ^= row[w] & mask;
+    }
+#endif
+}
+
 FSOErrorCode ldpc_encode(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
                          uint8_t* encoded, size_t* encoded_len)
 {
@@ -277,39 +426,35 @@ FSOErrorCode ldpc_encode(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
     FSO_CHECK_PARAM(data_len == (size_t)ldpc->k);
     FSO_CHECK_PARAM(*encoded_len >= (size_t)ldpc->n);
     
+    if (ldpc->lifting_size > 0) {
+        ldpc_qc_encode(ldpc, data, encoded);
+        *encoded_len = ldpc->n;
+        return FSO_SUCCESS;
+    }
+    
     /* Check if generator matrix is available */
-    if (!ldpc->G || !ldpc->G->row_ptr) {
+    if (!ldpc->parity_rows) {
         FSO_LOG_ERROR(LDPC_MODULE, "Generator matrix not initialized");
         return FSO_ERROR_NOT_INITIALIZED;
     }
     
-    /* Initialize all bits to zero */
-    memset(encoded, 0, ldpc->n * sizeof(uint8_t));
-    
     /* Copy information bits to the beginning (systematic encoding) */
     for (int i = 0; i < ldpc->k; i++) {
         encoded[i] = data[i] & 1; /* Ensure binary */
     }
     
-    /* Compute parity bits using generator matrix multiplication
-     * For systematic form G = [I | P], parity bits are computed as P * u
-     * where u is the information vector and P is the parity part of G */
+    /* Parity bits p = P^T * u: XOR the parity row of every set information bit */
+    const int words = ldpc->parity_words;
+    uint64_t* acc = ldpc->parity_accum;
+    memset(acc, 0, (size_t)words * sizeof(uint64_t));
     
-    /* Use direct binary arithmetic for efficiency */
     for (int i = 0; i < ldpc->k; i++) {
-        if (data[i] & 1) { /* If information bit is 1 */
-            /* Add corresponding row of P to parity bits (XOR operation) */
-            int row_start = ldpc->G->row_ptr[i];
-            int row_end = ldpc->G->row_ptr[i + 1];
-            
-            for (int j = row_start; j < row_end; j++) {
-                int col = ldpc->G->col_indices[j];
-                if (col >= ldpc->k && ldpc->G->values[j] == 1) {
-                    /* XOR with parity bit */
-                    encoded[col] ^= 1;
-                }
-            }
-        }
+        uint64_t mask = (uint64_t)0 - (uint64_t)(data[i] & 1);
+        ldpc_xor_parity_row(acc, ldpc->parity_rows + (size_t)i * words, mask, words);
+    }
+    
+    for (int j = 0; j < ldpc->m; j++) {
+        encoded[ldpc->k + j] = (uint8_t)((acc[j >> 6] >> (j & 63)) & 1);
     }
     
     /* Set actual encoded length */
@@ -347,6 +492,103 @@ FSOErrorCode ldpc_encode(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
     return FSO_SUCCESS;
 }
 
+FSOErrorCode ldpc_encode_packed(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
+                                uint8_t* encoded, size_t* encoded_len)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(encoded);
+    FSO_CHECK_NULL(encoded_len);
+    FSO_CHECK_PARAM(data_len == (size_t)(ldpc->k + 7) / 8);
+    FSO_CHECK_PARAM(*encoded_len >= (size_t)(ldpc->n + 7) / 8);
+    
+    /* QC: unpack, encode block-wise, repack */
+    if (ldpc->lifting_size > 0) {
+        uint8_t* bits = ldpc->qc_encode_work + ldpc->m;
+        for (int i = 0; i < ldpc->k; i++) {
+            bits[i] = (data[i >> 3] >> (7 - (i & 7))) & 1;
+        }
+        ldpc_qc_encode(ldpc, bits, bits);
+        
+        memset(encoded, 0, (size_t)(ldpc->n + 7) / 8);
+        for (int i = 0; i < ldpc->n; i++) {
+            encoded[i >> 3] |= (uint8_t)(bits[i] << (7 - (i & 7)));
+        }
+        *encoded_len = (size_t)(ldpc->n + 7) / 8;
+        return FSO_SUCCESS;
+    }
+    
+    if (!ldpc->parity_rows) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Generator matrix not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    const int k = ldpc->k;
+    const int words = ldpc->parity_words;
+    const size_t out_bytes = (size_t)(ldpc->n + 7) / 8;
+    uint64_t* acc = ldpc->parity_accum;
+    
+    memset(acc, 0, (size_t)words * sizeof(uint64_t));
+    
+    /* Eight masked row XORs per input byte */
+    for (int i = 0; i < k; i++) {
+        uint64_t bit = (data[i >> 3] >> (7 - (i & 7))) & 1;
+        ldpc_xor_parity_row(acc, ldpc->parity_rows + (size_t)i * words, (uint64_t)0 - bit, words);
+    }
+    
+    /* Systematic part */
+    memset(encoded, 0, out_bytes);
+    memcpy(encoded, data, (size_t)k / 8);
+    if (k & 7) {
+        encoded[k / 8] = data[k / 8] & (uint8_t)(0xFF << (8 - (k & 7)));
+    }
+    
+    /* Parity part starts at bit k */
+    for (int j = 0; j < ldpc->m; j++) {
+        int pos = k + j;
+        uint8_t bit = (uint8_t)((acc[j >> 6] >> (j & 63)) & 1);
+        encoded[pos >> 3] |= (uint8_t)(bit << (7 - (pos & 7)));
+    }
+    
+    *encoded_len = out_bytes;
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "Packed-encoded %d information bits to %d total bits",
+                 k, ldpc->n);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode ldpc_rate_compatible_order(const LDPCCodec* ldpc, int* order)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(order);
+    FSO_CHECK_PARAM(ldpc->k > 0 && ldpc->n > ldpc->k);
+    
+    int k = ldpc->k;
+    int m = ldpc->n - ldpc->k;
+    
+    for (int i = 0; i < k; i++) {
+        order[i] = i;
+    }
+    
+    /* Any stride coprime with m visits every parity position once */
+    int stride = (int)lround(m * 0.6180339887498949);
+    if (stride < 1) {
+        stride = 1;
+    }
+    while (gcd(stride, m) != 1) {
+        stride++;
+    }
+    
+    int position = 0;
+    for (int j = 0; j < m; j++) {
+        order[k + j] = k + position;
+        position = (int)(((long long)position + stride) % m);
+    }
+    
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Sparse Matrix Functions
  * ============================================================================ */
@@ -456,6 +698,17 @@ int sparse_matrix_get(const SparseMatrix* matrix, int row, int col)
     return 0; /* Not found */
 }
 
+static int sparse_element_compare(const void* a, const void* b)
+{
+    const SparseElement* x = (const SparseElement*)a;
+    const SparseElement* y = (const SparseElement*)b;
+    
+    if (x->row != y->row) {
+        return (x->row > y->row) - (x->row < y->row);
+    }
+    return (x->col > y->col) - (x->col < y->col);
+}
+
 FSOErrorCode sparse_matrix_to_csr(SparseMatrix* matrix)
 {
     FSO_CHECK_NULL(matrix);
@@ -465,18 +718,7 @@ FSOErrorCode sparse_matrix_to_csr(SparseMatrix* matrix)
     }
     
     /* Sort elements by row, then by column */
-    for (int i = 0; i < matrix->nnz - 1; i++) {
-        for (int j = i + 1; j < matrix->nnz; j++) {
-            if (matrix->elements[i].row > matrix->elements[j].row ||
-                (matrix->elements[i].row == matrix->elements[j].row &&
-                 matrix->elements[i].col > matrix->elements[j].col)) {
-                /* Swap elements */
-                SparseElement temp = matrix->elements[i];
-                matrix->elements[i] = matrix->elements[j];
-                matrix->elements[j] = temp;
-            }
-        }
-    }
+    qsort(matrix->elements, matrix->nnz, sizeof(SparseElement), sparse_element_compare);
     
     /* Build CSR arrays */
     int current_row = 0;
@@ -577,6 +819,22 @@ FSOErrorCode ldpc_validate_config(const LDPCConfig* config, int n, int k)
     FSO_CHECK_PARAM(n <= LDPC_MAX_CODE_LENGTH);
     FSO_CHECK_PARAM(config->max_iterations > 0 && config->max_iterations <= LDPC_MAX_ITERATIONS);
     FSO_CHECK_PARAM(config->convergence_threshold > 0.0);
+    FSO_CHECK_PARAM(config->check_node_algorithm >= LDPC_CHECK_SUM_PRODUCT &&
+                    config->check_node_algorithm <= LDPC_CHECK_OFFSET_MIN_SUM);
+    FSO_CHECK_PARAM(config->min_sum_scale >= 0.0 && config->min_sum_scale <= 1.0);
+    FSO_CHECK_PARAM(config->min_sum_offset >= 0.0);
+    FSO_CHECK_PARAM(config->schedule == LDPC_SCHEDULE_FLOODING ||
+                    config->schedule == LDPC_SCHEDULE_LAYERED);
+    FSO_CHECK_PARAM(config->layer_size >= 0);
+    FSO_CHECK_PARAM(config->llr_format >= LDPC_LLR_FLOAT &&
+                    config->llr_format <= LDPC_LLR_INT8);
+    FSO_CHECK_PARAM(config->lifting_size >= 0);
+    if (config->lifting_size > 0) {
+        FSO_CHECK_PARAM(n % config->lifting_size == 0 && k % config->lifting_size == 0);
+        FSO_CHECK_PARAM((n - k) / config->lifting_size >= LDPC_QC_MIN_BASE_ROWS);
+    }
+    FSO_CHECK_PARAM(config->backend == LDPC_BACKEND_CPU ||
+                    config->backend == LDPC_BACKEND_CUDA);
     
     double code_rate = (double)k / (double)n;
     FSO_CHECK_PARAM(code_rate > 0.0 && code_rate < 1.0);
@@ -585,234 +843,838 @@ FSOErrorCode ldpc_validate_config(const LDPCConfig* config, int n, int k)
 }
 
 /* ============================================================================
- * Static Helper Functions
+ * Code Construction Cache
  * ============================================================================ */
 
-static FSOErrorCode ldpc_create_regular_matrix(LDPCCodec* ldpc, int dv, int dc)
+#define LDPC_DUMP_MAGIC 0x4350444CU     /* "LDPC" */
+#define LDPC_DUMP_VERSION 1
+#define LDPC_DUMP_PATH_LENGTH 256
+
+/* Process-wide cache; every access holds graph_cache_lock */
+static pthread_mutex_t graph_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static LDPCGraph* graph_cache_head = NULL;
+static char graph_cache_directory[LDPC_DUMP_PATH_LENGTH] = "";
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t n;
+    int32_t k;
+    uint32_t seed;
+    int32_t nnz;
+    int32_t parity_words;
+    int32_t reserved;
+    double code_rate;
+} LDPCDumpHeader;
+
+static void ldpc_graph_destroy(LDPCGraph* graph)
 {
-    /* Create a regular LDPC matrix with variable degree dv and check degree dc
-     * Uses a structured construction with cyclic shifts to avoid short cycles */
-    
-    int m = ldpc->m;
-    int n = ldpc->n;
-    
-    /* Calculate number of edges */
-    int num_edges = n * dv;
-    if (num_edges != m * dc) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Invalid degree combination: n*dv != m*dc (%d != %d)", 
-                     num_edges, m * dc);
-        return FSO_ERROR_INVALID_PARAM;
+    if (graph->H) {
+        sparse_matrix_free(graph->H);
+        free(graph->H);
+    }
+    if (graph->G) {
+        sparse_matrix_free(graph->G);
+        free(graph->G);
+    }
+    free(graph->qc_shifts);
+    free(graph->parity_rows);
+    free(graph->var_degree);
+    free(graph->check_degree);
+    free(graph->var_edge_ptr);
+    free(graph->var_edge_index);
+    free(graph->edge_check);
+    free(graph);
+}
+
+/**
+ * @brief Point a codec's structural fields at a graph and take a reference
+ */
+static FSOErrorCode ldpc_attach_graph(LDPCCodec* ldpc, LDPCGraph* graph)
+{
+    /* Per-codec message buffers sized for the shared edge count */
+    int alloc_edges = graph->num_edges > 0 ? graph->num_edges : 1;
+    double* v2c = (double*)calloc(alloc_edges, sizeof(double));
+    double* c2v = (double*)calloc(alloc_edges, sizeof(double));
+    if (!v2c || !c2v) {
+        free(v2c);
+        free(c2v);
+        return FSO_ERROR_MEMORY;
     }
     
-    /* Initialize parity-check matrix */
-    FSOErrorCode result = sparse_matrix_init(ldpc->H, m, n, num_edges);
-    if (result != FSO_SUCCESS) {
-        return result;
+    /* Drop the structure the codec allocated for itself */
+    if (ldpc->H) {
+        sparse_matrix_free(ldpc->H);
+        free(ldpc->H);
+    }
+    if (ldpc->G) {
+        sparse_matrix_free(ldpc->G);
+        free(ldpc->G);
     }
+    free(ldpc->qc_shifts);
+    free(ldpc->parity_rows);
+    free(ldpc->var_degree);
+    free(ldpc->check_degree);
+    free(ldpc->var_edge_ptr);
+    free(ldpc->var_edge_index);
+    free(ldpc->edge_check);
+    free(ldpc->variable_to_check);
+    free(ldpc->check_to_variable);
+    ldpc_batch_workspace_free(ldpc->batch_workspace);
+    ldpc->batch_workspace = NULL;
+    ldpc_cuda_release(ldpc);
+    
+    /* QC codes have no parity rows to accumulate */
+    if (!ldpc->parity_accum && graph->parity_words > 0) {
+        ldpc->parity_accum = (uint64_t*)aligned_alloc(32, (size_t)graph->parity_words * sizeof(uint64_t));
+    }
+    
+    ldpc->H = graph->H;
+    ldpc->G = graph->G;
+    ldpc->qc_shifts = graph->qc_shifts;
+    ldpc->parity_rows = graph->parity_rows;
+    ldpc->parity_words = graph->parity_words;
+    ldpc->num_edges = graph->num_edges;
+    ldpc->var_degree = graph->var_degree;
+    ldpc->check_degree = graph->check_degree;
+    ldpc->var_edge_ptr = graph->var_edge_ptr;
+    ldpc->var_edge_index = graph->var_edge_index;
+    ldpc->edge_check = graph->edge_check;
+    ldpc->variable_to_check = v2c;
+    ldpc->check_to_variable = c2v;
+    ldpc->graph = graph;
+    graph->refcount++;
+    
+    return (ldpc->parity_accum || graph->parity_words == 0) ? FSO_SUCCESS : FSO_ERROR_MEMORY;
+}
+
+static void ldpc_detach_graph(LDPCCodec* ldpc)
+{
+    pthread_mutex_lock(&graph_cache_lock);
+    ldpc->graph->refcount--;
+    pthread_mutex_unlock(&graph_cache_lock);
+    
+    ldpc->H = NULL;
+    ldpc->G = NULL;
+    ldpc->qc_shifts = NULL;
+    ldpc->parity_rows = NULL;
+    ldpc->var_degree = NULL;
+    ldpc->check_degree = NULL;
+    ldpc->var_edge_ptr = NULL;
+    ldpc->var_edge_index = NULL;
+    ldpc->edge_check = NULL;
+    ldpc->graph = NULL;
+}
+
+/**
+ * @brief Move a freshly built codec's structure into a new cache entry
+ */
+static LDPCGraph* ldpc_graph_adopt(LDPCCodec* ldpc, double code_rate)
+{
+    LDPCGraph* graph = (LDPCGraph*)calloc(1, sizeof(LDPCGraph));
+    if (!graph) {
+        return NULL;
+    }
+    
+    graph->n = ldpc->n;
+    graph->k = ldpc->k;
+    graph->code_rate = code_rate;
+    graph->seed = ldpc->matrix_seed;
+    graph->lifting_size = ldpc->lifting_size;
+    graph->H = ldpc->H;
+    graph->G = ldpc->G;
+    graph->qc_shifts = ldpc->qc_shifts;
+    graph->parity_rows = ldpc->parity_rows;
+    graph->parity_words = ldpc->parity_words;
+    graph->num_edges = ldpc->num_edges;
+    graph->var_degree = ldpc->var_degree;
+    graph->check_degree = ldpc->check_degree;
+    graph->var_edge_ptr = ldpc->var_edge_ptr;
+    graph->var_edge_index = ldpc->var_edge_index;
+    graph->edge_check = ldpc->edge_check;
+    graph->refcount = 1;
+    
+    ldpc->graph = graph;
+    
+    return graph;
+}
+
+static void ldpc_dump_path(char* path, size_t size, int n, int k, unsigned int seed)
+{
+    snprintf(path, size, "%s/ldpc_n%d_k%d_s%u.bin", graph_cache_directory, n, k, seed);
+}
+
+FSOErrorCode ldpc_acquire_standard_code(LDPCCodec* ldpc, double code_rate)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_PARAM(code_rate > 0.0 && code_rate < 1.0);
+    FSO_CHECK_PARAM(ldpc->graph == NULL);
     
-    /* Improved regular construction using cyclic shifts to avoid 4-cycles */
-    int edge_count = 0;
-    int shift_increment = FSO_MAX(1, m / dv);
+    FSOErrorCode result = FSO_SUCCESS;
     
-    for (int v = 0; v < n; v++) {
-        for (int d = 0; d < dv; d++) {
-            /* Use cyclic shift pattern to distribute connections */
-            int base_check = (v * dv + d) % m;
-            int check_node = (base_check + d * shift_increment) % m;
-            
-            /* Avoid duplicate connections */
-            int duplicate = 0;
-            for (int prev = 0; prev < edge_count; prev++) {
-                if (ldpc->H->elements[prev].row == check_node && 
-                    ldpc->H->elements[prev].col == v) {
-                    duplicate = 1;
-                    break;
-                }
+    /* Held across a miss so concurrent codecs never build the same code twice */
+    pthread_mutex_lock(&graph_cache_lock);
+    LDPCGraph* graph = graph_cache_head;
+    while (graph && !(graph->n == ldpc->n && graph->k == ldpc->k &&
+                      graph->seed == ldpc->matrix_seed &&
+                      graph->lifting_size == ldpc->lifting_size &&
+                      fabs(graph->code_rate - code_rate) < 1e-9)) {
+        graph = graph->next;
+    }
+    
+    if (graph) {
+        result = ldpc_attach_graph(ldpc, graph);
+        FSO_LOG_DEBUG(LDPC_MODULE, "Graph cache hit for LDPC(%d,%d) seed %u (%d users)",
+                     ldpc->n, ldpc->k, ldpc->matrix_seed, graph->refcount);
+    } else {
+        char path[LDPC_DUMP_PATH_LENGTH + 64];
+        int from_disk = 0;
+        
+        /* Dumps hold G; QC codes have none and build in O(edges) */
+        const int dump = graph_cache_directory[0] && ldpc->lifting_size == 0;
+        if (dump) {
+            ldpc_dump_path(path, sizeof(path), ldpc->n, ldpc->k, ldpc->matrix_seed);
+            from_disk = (ldpc_load_code(ldpc, path) == FSO_SUCCESS);
+        }
+        
+        if (!from_disk) {
+            result = ldpc_generate_standard_matrix(ldpc, code_rate);
+            if (result == FSO_SUCCESS) {
+                result = ldpc_generate_generator_matrix(ldpc);
             }
-            
-            if (!duplicate) {
-                /* Set element in sparse matrix */
-                ldpc->H->elements[edge_count].row = check_node;
-                ldpc->H->elements[edge_count].col = v;
-                ldpc->H->elements[edge_count].value = 1;
-                edge_count++;
+            if (result == FSO_SUCCESS && dump &&
+                ldpc_save_code(ldpc, path) != FSO_SUCCESS) {
+                FSO_LOG_WARNING(LDPC_MODULE, "Could not write matrix dump %s", path);
+            }
+        }
+        
+        if (result == FSO_SUCCESS) {
+            graph = ldpc_graph_adopt(ldpc, code_rate);
+            if (graph) {
+                graph->next = graph_cache_head;
+                graph_cache_head = graph;
+                FSO_LOG_DEBUG(LDPC_MODULE, "Graph cache miss for LDPC(%d,%d) seed %u (%s)",
+                             ldpc->n, ldpc->k, ldpc->matrix_seed, from_disk ? "loaded" : "built");
             } else {
-                /* Find alternative check node */
-                for (int alt = 1; alt < m && edge_count < num_edges; alt++) {
-                    int alt_check = (check_node + alt) % m;
-                    int alt_duplicate = 0;
-                    
-                    for (int prev = 0; prev < edge_count; prev++) {
-                        if (ldpc->H->elements[prev].row == alt_check && 
-                            ldpc->H->elements[prev].col == v) {
-                            alt_duplicate = 1;
-                            break;
-                        }
-                    }
-                    
-                    if (!alt_duplicate) {
-                        ldpc->H->elements[edge_count].row = alt_check;
-                        ldpc->H->elements[edge_count].col = v;
-                        ldpc->H->elements[edge_count].value = 1;
-                        edge_count++;
-                        break;
-                    }
-                }
+                result = FSO_ERROR_MEMORY;
             }
         }
     }
+    pthread_mutex_unlock(&graph_cache_lock);
     
-    ldpc->H->nnz = edge_count;
-    
-    /* Convert to CSR format */
-    result = sparse_matrix_to_csr(ldpc->H);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to convert H matrix to CSR");
-        return result;
+    return result;
+}
+
+int ldpc_graph_cache_clear(void)
+{
+    int in_use = 0;
+    
+    pthread_mutex_lock(&graph_cache_lock);
+    LDPCGraph** link = &graph_cache_head;
+    while (*link) {
+        LDPCGraph* graph = *link;
+        if (graph->refcount > 0) {
+            in_use++;
+            link = &graph->next;
+        } else {
+            *link = graph->next;
+            ldpc_graph_destroy(graph);
+        }
     }
+    pthread_mutex_unlock(&graph_cache_lock);
     
-    /* Initialize connectivity arrays for message passing */
-    result = ldpc_init_message_graph(ldpc);
-    if (result != FSO_SUCCESS) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to initialize message passing graph");
-        return result;
-    }
+    return in_use;
+}
+
+FSOErrorCode ldpc_graph_cache_set_directory(const char* directory)
+{
+    FSO_CHECK_PARAM(directory == NULL || strlen(directory) < LDPC_DUMP_PATH_LENGTH);
     
-    FSO_LOG_INFO(LDPC_MODULE, "Created regular LDPC matrix: %d edges, avg var degree %.2f, avg check degree %.2f",
-                edge_count, (double)edge_count / n, (double)edge_count / m);
+    pthread_mutex_lock(&graph_cache_lock);
+    if (directory) {
+        strcpy(graph_cache_directory, directory);
+    } else {
+        graph_cache_directory[0] = '\0';
+    }
+    pthread_mutex_unlock(&graph_cache_lock);
     
     return FSO_SUCCESS;
 }
 
-static FSOErrorCode ldpc_gaussian_elimination(SparseMatrix* H, SparseMatrix* G, int k)
+FSOErrorCode ldpc_save_code(const LDPCCodec* ldpc, const char* path)
 {
-    /* Generate systematic generator matrix from parity-check matrix
-     * For systematic LDPC codes, we need G = [I | P] where H = [P^T | I]
-     * This is a simplified approach assuming the H matrix can be put in systematic form */
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(path);
     
-    int n = H->cols;
-    int m = H->rows;
+    /* QC codes are rebuilt from the shift table faster than a dump loads */
+    if (ldpc->lifting_size > 0) {
+        FSO_LOG_ERROR(LDPC_MODULE, "QC-LDPC codes have no generator rows to dump");
+        return FSO_ERROR_UNSUPPORTED;
+    }
     
-    /* Allocate temporary matrix for H manipulation */
-    int** H_temp = (int**)calloc(m, sizeof(int*));
-    if (!H_temp) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate temporary H matrix");
-        return FSO_ERROR_MEMORY;
+    if (!ldpc->H || !ldpc->H->row_ptr || !ldpc->parity_rows) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Code structure not generated");
+        return FSO_ERROR_NOT_INITIALIZED;
     }
     
-    for (int i = 0; i < m; i++) {
-        H_temp[i] = (int*)calloc(n, sizeof(int));
-        if (!H_temp[i]) {
-            /* Cleanup on failure */
-            for (int j = 0; j < i; j++) {
-                free(H_temp[j]);
-            }
-            free(H_temp);
-            return FSO_ERROR_MEMORY;
-        }
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return FSO_ERROR_IO;
     }
     
-    /* Copy H matrix to temporary dense format for manipulation */
-    for (int i = 0; i < H->nnz; i++) {
+    LDPCDumpHeader header = {0};
+    header.magic = LDPC_DUMP_MAGIC;
+    header.version = LDPC_DUMP_VERSION;
+    header.n = ldpc->n;
+    header.k = ldpc->k;
+    header.seed = ldpc->matrix_seed;
+    header.nnz = ldpc->H->nnz;
+    header.parity_words = ldpc->parity_words;
+    header.code_rate = ldpc->graph ? ldpc->graph->code_rate : ldpc->code_rate;
+    
+    size_t parity_count = (size_t)ldpc->k * ldpc->parity_words;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(ldpc->H->row_ptr, sizeof(int), ldpc->m + 1, file) == (size_t)(ldpc->m + 1) &&
+             fwrite(ldpc->H->col_indices, sizeof(int), ldpc->H->nnz, file) == (size_t)ldpc->H->nnz &&
+             fwrite(ldpc->parity_rows, sizeof(uint64_t), parity_count, file) == parity_count;
+    
+    if (fclose(file) != 0 || !ok) {
+        remove(path);
+        return FSO_ERROR_IO;
+    }
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "Wrote matrix dump %s", path);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode ldpc_load_code(LDPCCodec* ldpc, const char* path)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(path);
+    FSO_CHECK_NULL(ldpc->H);
+    FSO_CHECK_PARAM(ldpc->graph == NULL);
+    FSO_CHECK_PARAM(ldpc->lifting_size == 0);
+    
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return FSO_ERROR_IO;
+    }
+    
+    LDPCDumpHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != LDPC_DUMP_MAGIC || header.version != LDPC_DUMP_VERSION ||
+        header.n != ldpc->n || header.k != ldpc->k || header.seed != ldpc->matrix_seed ||
+        header.nnz <= 0 || header.parity_words != (((ldpc->m + 63) / 64 + LDPC_PARITY_WORD_ALIGN - 1) /
+                                                   LDPC_PARITY_WORD_ALIGN * LDPC_PARITY_WORD_ALIGN)) {
+        fclose(file);
+        FSO_LOG_WARNING(LDPC_MODULE, "Ignoring incompatible matrix dump %s", path);
+        return FSO_ERROR_IO;
+    }
+    
+    sparse_matrix_free(ldpc->H);
+    FSOErrorCode result = sparse_matrix_init(ldpc->H, ldpc->m, ldpc->n, header.nnz);
+    if (result != FSO_SUCCESS) {
+        fclose(file);
+        return result;
+    }
+    
+    size_t words = (size_t)header.parity_words;
+    size_t parity_count = (size_t)ldpc->k * words;
+    free(ldpc->parity_rows);
+    free(ldpc->parity_accum);
+    ldpc->parity_words = header.parity_words;
+    ldpc->parity_rows = (uint64_t*)aligned_alloc(32, parity_count * sizeof(uint64_t));
+    ldpc->parity_accum = (uint64_t*)aligned_alloc(32, words * sizeof(uint64_t));
+    if (!ldpc->parity_rows || !ldpc->parity_accum) {
+        fclose(file);
+        sparse_matrix_free(ldpc->H);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    int ok = fread(ldpc->H->row_ptr, sizeof(int), ldpc->m + 1, file) == (size_t)(ldpc->m + 1) &&
+             fread(ldpc->H->col_indices, sizeof(int), header.nnz, file) == (size_t)header.nnz &&
+             fread(ldpc->parity_rows, sizeof(uint64_t), parity_count, file) == parity_count;
+    fclose(file);
+    
+    /* Reject truncated or inconsistent CSR data before touching it */
+    ok = ok && ldpc->H->row_ptr[0] == 0 && ldpc->H->row_ptr[ldpc->m] == header.nnz;
+    for (int r = 0; ok && r < ldpc->m; r++) {
+        ok = ldpc->H->row_ptr[r] <= ldpc->H->row_ptr[r + 1];
+        for (int e = ldpc->H->row_ptr[r]; ok && e < ldpc->H->row_ptr[r + 1]; e++) {
+            int col = ldpc->H->col_indices[e];
+            ok = col >= 0 && col < ldpc->n;
+            ldpc->H->elements[e] = (SparseElement){ r, col, 1 };
+            ldpc->H->values[e] = 1;
+        }
+    }
+    
+    if (!ok) {
+        FSO_LOG_WARNING(LDPC_MODULE, "Corrupt matrix dump %s", path);
+        sparse_matrix_free(ldpc->H);
+        return FSO_ERROR_IO;
+    }
+    
+    result = ldpc_build_generator_csr(ldpc);
+    if (result == FSO_SUCCESS) {
+        result = ldpc_init_message_graph(ldpc);
+    }
+    
+    if (result == FSO_SUCCESS) {
+        FSO_LOG_DEBUG(LDPC_MODULE, "Loaded matrix dump %s", path);
+    }
+    
+    return result;
+}
+
+/* ============================================================================
+ * Static Helper Functions
+ * ============================================================================ */
+
+/**
+ * @brief Seeded random regular (dv, dc) construction
+ * 
+ * Check sockets are shuffled and dealt dv per column; any column that
+ * draws the same check twice swaps the clashing socket with a random
+ * other column. Unlike the cyclic construction, distinct columns are
+ * almost never identical, which keeps the minimum distance usable.
+ */
+static inline uint32_t ldpc_xorshift32(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static FSOErrorCode ldpc_create_random_regular_matrix(LDPCCodec* ldpc, int dv, int dc)
+{
+    int m = ldpc->m;
+    int n = ldpc->n;
+    int num_edges = n * dv;
+    
+    if (num_edges != m * dc) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Invalid degree combination: n*dv != m*dc (%d != %d)", 
+                     num_edges, m * dc);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    int* sockets = (int*)malloc(num_edges * sizeof(int));
+    if (!sockets) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    for (int e = 0; e < num_edges; e++) {
+        sockets[e] = e / dc;
+    }
+    
+    /* Private stream so the global generator is untouched */
+    uint32_t state = ldpc->matrix_seed;
+    
+    for (int e = num_edges - 1; e > 0; e--) {
+        int j = (int)(ldpc_xorshift32(&state) % (uint32_t)(e + 1));
+        int temp = sockets[e];
+        sockets[e] = sockets[j];
+        sockets[j] = temp;
+    }
+    
+    /* Repair repeated checks within a column */
+    int unresolved = 0;
+    for (int v = 0; v < n; v++) {
+        int* col = sockets + v * dv;
+        for (int d = 1; d < dv; d++) {
+            int attempts = 0;
+            for (;;) {
+                int clash = 0;
+                for (int q = 0; q < d; q++) {
+                    clash |= (col[q] == col[d]);
+                }
+                if (!clash) break;
+                
+                if (++attempts > 1000) {
+                    unresolved++;
+                    break;
+                }
+                
+                int pos = (int)(ldpc_xorshift32(&state) % (uint32_t)num_edges);
+                int w = pos / dv;
+                if (w == v) continue;
+                
+                /* Swap only if column w does not already hold col[d] ... */
+                int* other = sockets + w * dv;
+                int ok = 1;
+                for (int q = 0; q < dv; q++) {
+                    if (other[q] == col[d]) ok = 0;
+                }
+                /* ... and column v does not already hold the incoming check */
+                for (int q = 0; q < dv; q++) {
+                    if (q != d && col[q] == sockets[pos]) ok = 0;
+                }
+                if (ok) {
+                    int temp = sockets[pos];
+                    sockets[pos] = col[d];
+                    col[d] = temp;
+                }
+            }
+        }
+    }
+    
+    if (unresolved > 0) {
+        FSO_LOG_WARNING(LDPC_MODULE, "%d repeated check connections could not be repaired", unresolved);
+    }
+    
+    FSOErrorCode result = sparse_matrix_init(ldpc->H, m, n, num_edges);
+    if (result != FSO_SUCCESS) {
+        free(sockets);
+        return result;
+    }
+    
+    int edge_count = 0;
+    for (int v = 0; v < n; v++) {
+        for (int d = 0; d < dv; d++) {
+            int check_node = sockets[v * dv + d];
+            int repeated = 0;
+            for (int q = 0; q < d; q++) {
+                repeated |= (sockets[v * dv + q] == check_node);
+            }
+            if (repeated) continue; /* Parallel edges cancel over GF(2) */
+            
+            ldpc->H->elements[edge_count].row = check_node;
+            ldpc->H->elements[edge_count].col = v;
+            ldpc->H->elements[edge_count].value = 1;
+            edge_count++;
+        }
+    }
+    free(sockets);
+    
+    ldpc->H->nnz = edge_count;
+    
+    result = sparse_matrix_to_csr(ldpc->H);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to convert H matrix to CSR");
+        return result;
+    }
+    
+    result = ldpc_init_message_graph(ldpc);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to initialize message passing graph");
+        return result;
+    }
+    
+    FSO_LOG_INFO(LDPC_MODULE, "Created random regular LDPC matrix: %d edges, seed %u",
+                edge_count, ldpc->matrix_seed);
+    
+    return FSO_SUCCESS;
+}
+
+static FSOErrorCode ldpc_create_regular_matrix(LDPCCodec* ldpc, int dv, int dc)
+{
+    /* Create a regular LDPC matrix with variable degree dv and check degree dc
+     * Uses a structured construction with cyclic shifts to avoid short cycles */
+    
+    int m = ldpc->m;
+    int n = ldpc->n;
+    
+    /* Calculate number of edges */
+    int num_edges = n * dv;
+    if (num_edges != m * dc) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Invalid degree combination: n*dv != m*dc (%d != %d)", 
+                     num_edges, m * dc);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    /* Initialize parity-check matrix */
+    FSOErrorCode result = sparse_matrix_init(ldpc->H, m, n, num_edges);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    /* Improved regular construction using cyclic shifts to avoid 4-cycles */
+    int edge_count = 0;
+    int shift_increment = FSO_MAX(1, m / dv);
+    
+    for (int v = 0; v < n; v++) {
+        int column_start = edge_count;
+        for (int d = 0; d < dv; d++) {
+            /* Use cyclic shift pattern to distribute connections */
+            int base_check = (v * dv + d) % m;
+            int check_node = (base_check + d * shift_increment) % m;
+            
+            /* Avoid duplicate connections (only this column's edges can clash) */
+            int duplicate = 0;
+            for (int prev = column_start; prev < edge_count; prev++) {
+                if (ldpc->H->elements[prev].row == check_node && 
+                    ldpc->H->elements[prev].col == v) {
+                    duplicate = 1;
+                    break;
+                }
+            }
+            
+            if (!duplicate) {
+                /* Set element in sparse matrix */
+                ldpc->H->elements[edge_count].row = check_node;
+                ldpc->H->elements[edge_count].col = v;
+                ldpc->H->elements[edge_count].value = 1;
+                edge_count++;
+            } else {
+                /* Find alternative check node */
+                for (int alt = 1; alt < m && edge_count < num_edges; alt++) {
+                    int alt_check = (check_node + alt) % m;
+                    int alt_duplicate = 0;
+                    
+                    for (int prev = column_start; prev < edge_count; prev++) {
+                        if (ldpc->H->elements[prev].row == alt_check && 
+                            ldpc->H->elements[prev].col == v) {
+                            alt_duplicate = 1;
+                            break;
+                        }
+                    }
+                    
+                    if (!alt_duplicate) {
+                        ldpc->H->elements[edge_count].row = alt_check;
+                        ldpc->H->elements[edge_count].col = v;
+                        ldpc->H->elements[edge_count].value = 1;
+                        edge_count++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    
+    ldpc->H->nnz = edge_count;
+    
+    /* Convert to CSR format */
+    result = sparse_matrix_to_csr(ldpc->H);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to convert H matrix to CSR");
+        return result;
+    }
+    
+    /* Initialize connectivity arrays for message passing */
+    result = ldpc_init_message_graph(ldpc);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to initialize message passing graph");
+        return result;
+    }
+    
+    FSO_LOG_INFO(LDPC_MODULE, "Created regular LDPC matrix: %d edges, avg var degree %.2f, avg check degree %.2f",
+                edge_count, (double)edge_count / n, (double)edge_count / m);
+    
+    return FSO_SUCCESS;
+}
+
+static FSOErrorCode ldpc_gaussian_elimination(SparseMatrix* H, int k, uint64_t* parity_rows,
+                                              int parity_words, int* columns_swapped)
+{
+    /* Bring H into the form [A | I] over GF(2) (pivots in the parity columns)
+     * and read P = A^T off it: parity bit j of the pivot row for column k + j
+     * is the XOR of the information bits set in that row. Rows are packed
+     * into 64-bit words so every row operation is a word-wide XOR. When a
+     * parity column has no pivot, an information column is swapped in and
+     * the swap is applied to H, which relabels two codeword bits. */
+    
+    int n = H->cols;
+    int m = H->rows;
+    int row_words = (n + 63) / 64;
+    
+    uint64_t* H_temp = (uint64_t*)calloc((size_t)m * row_words, sizeof(uint64_t));
+    int* pivot_col = (int*)malloc(m * sizeof(int));
+    int* position = (int*)malloc(n * sizeof(int));
+    if (!H_temp || !pivot_col || !position) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate temporary H matrix");
+        free(H_temp);
+        free(pivot_col);
+        free(position);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    /* position[c]: column of the eliminated matrix that original column c moved to */
+    for (int c = 0; c < n; c++) {
+        position[c] = c;
+    }
+    *columns_swapped = 0;
+    
+    /* Copy H matrix to packed dense format for manipulation */
+    for (int i = 0; i < H->nnz; i++) {
         int row = H->elements[i].row;
         int col = H->elements[i].col;
-        if (row < m && col < n) {
-            H_temp[row][col] = H->elements[i].value;
+        if (row < m && col < n && H->elements[i].value) {
+            H_temp[(size_t)row * row_words + (col >> 6)] |= (uint64_t)1 << (col & 63);
         }
     }
     
-    /* Perform Gaussian elimination over GF(2) to get systematic form [P^T | I] */
+    /* Perform Gaussian elimination over GF(2) on the parity columns */
     int pivot_row = 0;
     for (int col = k; col < n && pivot_row < m; col++) {
+        int word = col >> 6;
+        uint64_t bit = (uint64_t)1 << (col & 63);
+        
         /* Find pivot */
-        int pivot_found = 0;
+        int found = -1;
         for (int row = pivot_row; row < m; row++) {
-            if (H_temp[row][col] == 1) {
-                /* Swap rows if needed */
-                if (row != pivot_row) {
-                    for (int c = 0; c < n; c++) {
-                        int temp = H_temp[pivot_row][c];
-                        H_temp[pivot_row][c] = H_temp[row][c];
-                        H_temp[row][c] = temp;
+            if (H_temp[(size_t)row * row_words + word] & bit) {
+                found = row;
+                break;
+            }
+        }
+        
+        if (found < 0) {
+            /* Borrow an information column with a 1 at or below pivot_row */
+            int swap_col = -1;
+            for (int c = 0; c < k && found < 0; c++) {
+                for (int row = pivot_row; row < m; row++) {
+                    if ((H_temp[(size_t)row * row_words + (c >> 6)] >> (c & 63)) & 1) {
+                        found = row;
+                        swap_col = c;
+                        break;
                     }
                 }
-                pivot_found = 1;
-                break;
             }
+            
+            if (found < 0) {
+                continue; /* Skip this column (parity bit stays zero) */
+            }
+            
+            uint64_t swap_bit = (uint64_t)1 << (swap_col & 63);
+            for (int row = 0; row < m; row++) {
+                uint64_t* r = H_temp + (size_t)row * row_words;
+                int a = (r[word] & bit) != 0;
+                int b = (r[swap_col >> 6] & swap_bit) != 0;
+                if (a != b) {
+                    r[word] ^= bit;
+                    r[swap_col >> 6] ^= swap_bit;
+                }
+            }
+            
+            for (int c = 0; c < n; c++) {
+                if (position[c] == col) {
+                    position[c] = swap_col;
+                } else if (position[c] == swap_col) {
+                    position[c] = col;
+                }
+            }
+            (*columns_swapped)++;
         }
         
-        if (!pivot_found) {
-            continue; /* Skip this column */
+        uint64_t* pivot = H_temp + (size_t)pivot_row * row_words;
+        if (found != pivot_row) {
+            uint64_t* other = H_temp + (size_t)found * row_words;
+            for (int w = 0; w < row_words; w++) {
+                uint64_t temp = pivot[w];
+                pivot[w] = other[w];
+                other[w] = temp;
+            }
         }
         
         /* Eliminate other 1s in this column */
         for (int row = 0; row < m; row++) {
-            if (row != pivot_row && H_temp[row][col] == 1) {
-                /* XOR rows (GF(2) addition) */
-                for (int c = 0; c < n; c++) {
-                    H_temp[row][c] ^= H_temp[pivot_row][c];
+            uint64_t* target = H_temp + (size_t)row * row_words;
+            if (row != pivot_row && (target[word] & bit)) {
+                for (int w = 0; w < row_words; w++) {
+                    target[w] ^= pivot[w];
                 }
             }
         }
         
+        pivot_col[pivot_row] = col;
         pivot_row++;
     }
     
-    /* Build generator matrix G = [I | P] where P is extracted from systematic H */
-    int nnz_count = 0;
+    if (pivot_row < m) {
+        FSO_LOG_WARNING(LDPC_MODULE, "H has rank %d < %d; %d parity bits fixed to zero",
+                       pivot_row, m, m - pivot_row);
+    }
     
-    /* Information part: identity matrix I */
-    for (int i = 0; i < k; i++) {
-        if (nnz_count < G->nnz) {
-            G->elements[nnz_count].row = i;
-            G->elements[nnz_count].col = i;
-            G->elements[nnz_count].value = 1;
-            nnz_count++;
-        }
-    }
-    
-    /* Parity part: P matrix (transpose of P^T from H) */
-    for (int i = 0; i < k && i < m; i++) {
-        for (int j = k; j < n; j++) {
-            if (H_temp[i][j] == 1 && nnz_count < G->nnz) {
-                G->elements[nnz_count].row = i;
-                G->elements[nnz_count].col = j;
-                G->elements[nnz_count].value = 1;
-                nnz_count++;
-            }
+    if (*columns_swapped > 0) {
+        for (int i = 0; i < H->nnz; i++) {
+            H->elements[i].col = position[H->elements[i].col];
         }
+        FSO_LOG_DEBUG(LDPC_MODULE, "Swapped %d columns of H into systematic form", *columns_swapped);
     }
     
-    G->nnz = nnz_count;
-    
-    /* Cleanup temporary matrix */
-    for (int i = 0; i < m; i++) {
-        free(H_temp[i]);
+    /* P[i][j] = A[pivot row of column k + j][i] */
+    for (int r = 0; r < pivot_row; r++) {
+        const uint64_t* row = H_temp + (size_t)r * row_words;
+        int j = pivot_col[r] - k;
+        uint64_t parity_bit = (uint64_t)1 << (j & 63);
+        
+        for (int i = 0; i < k; i++) {
+            if ((row[i >> 6] >> (i & 63)) & 1) {
+                parity_rows[(size_t)i * parity_words + (j >> 6)] |= parity_bit;
+            }
+        }
     }
+    
     free(H_temp);
+    free(pivot_col);
+    free(position);
     
-    FSO_LOG_DEBUG(LDPC_MODULE, "Generated systematic generator matrix with %d non-zero elements", nnz_count);
+    FSO_LOG_DEBUG(LDPC_MODULE, "Gaussian elimination found %d parity pivots", pivot_row);
     
     return FSO_SUCCESS;
 }
 
-int ldpc_estimate_min_distance(const LDPCCodec* ldpc)
+static FSOErrorCode ldpc_build_generator_csr(LDPCCodec* ldpc)
 {
-    if (!ldpc || !ldpc->H) {
-        return 0;
+    /* Rows are emitted already ordered (identity column, then parity
+     * columns ascending), so the CSR arrays are filled directly */
+    const int words = ldpc->parity_words;
+    int nnz = ldpc->k;
+    
+    for (size_t w = 0; w < (size_t)ldpc->k * words; w++) {
+        nnz += __builtin_popcountll(ldpc->parity_rows[w]);
     }
     
-    /* For regular LDPC codes, minimum distance is typically related to girth
-     * This is a rough estimate based on variable node degree */
-    int min_var_degree = ldpc->n;
-    for (int i = 0; i < ldpc->n; i++) {
-        if (ldpc->var_degree[i] > 0 && ldpc->var_degree[i] < min_var_degree) {
-            min_var_degree = ldpc->var_degree[i];
-        }
+    sparse_matrix_free(ldpc->G);
+    FSOErrorCode result = sparse_matrix_init(ldpc->G, ldpc->k, ldpc->n, nnz);
+    if (result != FSO_SUCCESS) {
+        return result;
     }
     
-    /* Conservative estimate: minimum distance is at least min_var_degree + 1 */
-    return min_var_degree + 1;
+    int e = 0;
+    for (int i = 0; i < ldpc->k; i++) {
+        const uint64_t* row = ldpc->parity_rows + (size_t)i * words;
+        ldpc->G->row_ptr[i] = e;
+        
+        ldpc->G->elements[e] = (SparseElement){ i, i, 1 };
+        ldpc->G->col_indices[e] = i;
+        ldpc->G->values[e] = 1;
+        e++;
+        
+        for (int j = 0; j < ldpc->m; j++) {
+            if ((row[j >> 6] >> (j & 63)) & 1) {
+                ldpc->G->elements[e] = (SparseElement){ i, ldpc->k + j, 1 };
+                ldpc->G->col_indices[e] = ldpc->k + j;
+                ldpc->G->values[e] = 1;
+                e++;
+            }
+        }
+    }
+    ldpc->G->row_ptr[ldpc->k] = e;
+    
+    return FSO_SUCCESS;
+}
+
+int ldpc_estimate_min_distance(const LDPCCodec* ldpc)
+{
+    if (!ldpc || !ldpc->H) {
+        return 0;
+    }
+    
+    /* For regular LDPC codes, minimum distance is typically related to girth
+     * This is a rough estimate based on variable node degree */
+    int min_var_degree = ldpc->n;
+    for (int i = 0; i < ldpc->n; i++) {
+        if (ldpc->var_degree[i] > 0 && ldpc->var_degree[i] < min_var_degree) {
+            min_var_degree = ldpc->var_degree[i];
+        }
+    }
+    
+    /* Conservative estimate: minimum distance is at least min_var_degree + 1 */
+    return min_var_degree + 1;
 }
 
 FSOErrorCode ldpc_soft_to_hard(const double* llr, uint8_t* bits, size_t length)
@@ -846,215 +1708,1818 @@ FSOErrorCode ldpc_hard_to_soft(const uint8_t* bits, double* llr, size_t length,
         /* Positive LLR for bit 0, negative LLR for bit 1 */
         llr[i] = (bits[i] == 0) ? llr_magnitude : -llr_magnitude;
     }
-    
-    return FSO_SUCCESS;
+    
+    return FSO_SUCCESS;
+}
+
+const char* ldpc_check_node_algorithm_string(LDPCCheckNodeAlgorithm algorithm)
+{
+    switch (algorithm) {
+        case LDPC_CHECK_SUM_PRODUCT: return "sum-product";
+        case LDPC_CHECK_NORMALIZED_MIN_SUM: return "normalized min-sum";
+        case LDPC_CHECK_OFFSET_MIN_SUM: return "offset min-sum";
+        default: return "unknown";
+    }
+}
+
+static int gcd(int a, int b)
+{
+    while (b != 0) {
+        int temp = b;
+        b = a % b;
+        a = temp;
+    }
+    return a;
+}
+
+FSOErrorCode ldpc_init_message_graph(LDPCCodec* ldpc)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(ldpc->H);
+    FSO_CHECK_NULL(ldpc->H->row_ptr);
+    FSO_CHECK_NULL(ldpc->var_edge_ptr);
+    
+    const SparseMatrix* H = ldpc->H;
+    int num_edges = H->nnz;
+    
+    /* Release buffers from a previous graph (e.g. matrix regeneration) */
+    free(ldpc->variable_to_check);
+    free(ldpc->check_to_variable);
+    free(ldpc->var_edge_index);
+    free(ldpc->edge_check);
+    ldpc->variable_to_check = NULL;
+    ldpc->check_to_variable = NULL;
+    ldpc->var_edge_index = NULL;
+    ldpc->edge_check = NULL;
+    ldpc->num_edges = 0;
+    ldpc_batch_workspace_free(ldpc->batch_workspace);
+    ldpc->batch_workspace = NULL;
+    ldpc_cuda_release(ldpc);
+    
+    /* Per-edge storage: memory scales with nnz(H) rather than n * m */
+    int alloc_edges = num_edges > 0 ? num_edges : 1;
+    ldpc->variable_to_check = (double*)calloc(alloc_edges, sizeof(double));
+    ldpc->check_to_variable = (double*)calloc(alloc_edges, sizeof(double));
+    ldpc->var_edge_index = (int*)malloc(alloc_edges * sizeof(int));
+    ldpc->edge_check = (int*)malloc(alloc_edges * sizeof(int));
+    
+    if (!ldpc->variable_to_check || !ldpc->check_to_variable || 
+        !ldpc->var_edge_index || !ldpc->edge_check) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate message arrays for %d edges", num_edges);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    /* Check degrees come straight from the CSR row pointer */
+    for (int c = 0; c < ldpc->m; c++) {
+        ldpc->check_degree[c] = H->row_ptr[c + 1] - H->row_ptr[c];
+        for (int e = H->row_ptr[c]; e < H->row_ptr[c + 1]; e++) {
+            ldpc->edge_check[e] = c;
+        }
+    }
+    
+    /* Count variable degrees and build the variable-view row pointer */
+    memset(ldpc->var_degree, 0, ldpc->n * sizeof(int));
+    for (int e = 0; e < num_edges; e++) {
+        ldpc->var_degree[H->col_indices[e]]++;
+    }
+    
+    ldpc->var_edge_ptr[0] = 0;
+    for (int v = 0; v < ldpc->n; v++) {
+        ldpc->var_edge_ptr[v + 1] = ldpc->var_edge_ptr[v] + ldpc->var_degree[v];
+    }
+    
+    /* Scatter check-view edge ids into the variable view. Walking H in CSR
+     * order keeps each variable's edges sorted by check index. */
+    int* fill = (int*)malloc(ldpc->n * sizeof(int));
+    if (!fill) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate edge permutation workspace");
+        return FSO_ERROR_MEMORY;
+    }
+    memcpy(fill, ldpc->var_edge_ptr, ldpc->n * sizeof(int));
+    
+    for (int e = 0; e < num_edges; e++) {
+        int v = H->col_indices[e];
+        ldpc->var_edge_index[fill[v]++] = e;
+    }
+    
+    free(fill);
+    ldpc->num_edges = num_edges;
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "Initialized message passing graph with %d variable nodes, %d check nodes, %d edges",
+                 ldpc->n, ldpc->m, num_edges);
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Decode from ldpc->channel_llr
+ * 
+ * Shared by the hard- and soft-input entry points: makes the channel hard
+ * decisions, iterates unless they already satisfy every check, and writes
+ * the systematic bits to decoded.
+ */
+static FSOErrorCode ldpc_decode_channel(LDPCCodec* ldpc, uint8_t* decoded)
+{
+    /* Hard decisions straight from the channel. A received word that
+     * already satisfies every parity check needs no iterations at all. */
+    for (int v = 0; v < ldpc->n; v++) {
+        ldpc->decoded_bits[v] = (ldpc->channel_llr[v] < 0.0) ? 1 : 0;
+    }
+    
+    FSOErrorCode result = ldpc_calculate_syndrome(ldpc);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    int iteration = 0;
+    int converged = ldpc_check_convergence(ldpc);
+    
+    if (!converged) {
+        if (ldpc->lifting_size > 0) {
+            result = ldpc_decode_qc_layered(ldpc, &iteration, &converged);
+        } else if (ldpc->schedule == LDPC_SCHEDULE_LAYERED) {
+            result = ldpc_decode_layered(ldpc, &iteration, &converged);
+        } else {
+            result = ldpc_decode_flooding(ldpc, &iteration, &converged);
+        }
+        
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    ldpc->last_iterations = iteration;
+    ldpc->last_converged = converged;
+    
+    /* Extract decoded information bits (systematic part) */
+    for (int i = 0; i < ldpc->k; i++) {
+        decoded[i] = ldpc->decoded_bits[i];
+    }
+    
+    if (!converged) {
+        FSO_LOG_WARNING(LDPC_MODULE, "LDPC decoder did not converge after %d iterations", 
+                       ldpc->max_iterations);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode ldpc_decode(LDPCCodec* ldpc, const uint8_t* received, size_t received_len,
+                         uint8_t* decoded, size_t decoded_len, int* errors_corrected)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(received_len == (size_t)ldpc->n);
+    FSO_CHECK_PARAM(decoded_len >= (size_t)ldpc->k);
+    
+    /* Check if message passing graph is initialized */
+    if (!ldpc->var_edge_index || !ldpc->variable_to_check || !ldpc->check_to_variable) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Message passing graph not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    /* Initialize channel LLRs from received hard bits
+     * For hard decision decoding, we use a large LLR magnitude */
+    const double hard_llr_magnitude = 10.0;
+    for (int i = 0; i < ldpc->n; i++) {
+        /* Positive LLR for bit 0, negative LLR for bit 1 */
+        ldpc->channel_llr[i] = (received[i] == 0) ? hard_llr_magnitude : -hard_llr_magnitude;
+    }
+    
+    FSOErrorCode result = ldpc_decode_channel(ldpc, decoded);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    /* Calculate number of errors corrected */
+    if (errors_corrected) {
+        *errors_corrected = 0;
+        for (int i = 0; i < ldpc->k; i++) {
+            if (decoded[i] != received[i]) {
+                (*errors_corrected)++;
+            }
+        }
+    }
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "LDPC decode completed: %d iterations, converged=%d, errors_corrected=%d",
+                 ldpc->last_iterations, ldpc->last_converged,
+                 errors_corrected ? *errors_corrected : 0);
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode ldpc_decode_soft(LDPCCodec* ldpc, const float* llr, size_t stride,
+                              uint8_t* decoded, size_t decoded_len, int* errors_corrected)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(stride > 0);
+    FSO_CHECK_PARAM(decoded_len >= (size_t)ldpc->k);
+    
+    if (!ldpc->var_edge_index || !ldpc->variable_to_check || !ldpc->check_to_variable) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Message passing graph not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    /* Channel LLRs come straight from the demodulator */
+    for (int i = 0; i < ldpc->n; i++) {
+        ldpc->channel_llr[i] = (double)llr[(size_t)i * stride];
+    }
+    
+    FSOErrorCode result = ldpc_decode_channel(ldpc, decoded);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    /* Errors corrected relative to the channel hard decisions */
+    if (errors_corrected) {
+        *errors_corrected = 0;
+        for (int i = 0; i < ldpc->k; i++) {
+            if (decoded[i] != (llr[(size_t)i * stride] < 0.0f)) {
+                (*errors_corrected)++;
+            }
+        }
+    }
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "LDPC soft decode completed: %d iterations, converged=%d",
+                 ldpc->last_iterations, ldpc->last_converged);
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Flooding schedule: every check, then every variable, per iteration
+ */
+static FSOErrorCode ldpc_decode_flooding(LDPCCodec* ldpc, int* iterations, int* converged)
+{
+    /* Initialize variable-to-check messages with channel LLRs */
+    const int* edge_var = ldpc->H->col_indices;
+    for (int e = 0; e < ldpc->num_edges; e++) {
+        ldpc->variable_to_check[e] = ldpc->channel_llr[edge_var[e]];
+    }
+    
+    /* Initialize check-to-variable messages to zero */
+    memset(ldpc->check_to_variable, 0, ldpc->num_edges * sizeof(double));
+    
+    *converged = 0;
+    *iterations = ldpc->max_iterations;
+    
+    for (int iteration = 0; iteration < ldpc->max_iterations; iteration++) {
+        /* Update check-to-variable messages */
+        FSOErrorCode result = ldpc_update_check_messages(ldpc);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update check messages at iteration %d", iteration);
+            return result;
+        }
+        
+        /* Update variable-to-check messages */
+        result = ldpc_update_variable_messages(ldpc);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update variable messages at iteration %d", iteration);
+            return result;
+        }
+        
+        /* Update posterior LLRs and make hard decisions */
+        result = ldpc_update_posteriors(ldpc);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update posteriors at iteration %d", iteration);
+            return result;
+        }
+        
+        /* Check for convergence (syndrome check) */
+        result = ldpc_calculate_syndrome(ldpc);
+        if (result != FSO_SUCCESS) {
+            FSO_LOG_ERROR(LDPC_MODULE, "Failed to calculate syndrome at iteration %d", iteration);
+            return result;
+        }
+        
+        if (ldpc_check_convergence(ldpc)) {
+            FSO_LOG_DEBUG(LDPC_MODULE, "LDPC decoder converged at iteration %d", iteration + 1);
+            *converged = 1;
+            *iterations = iteration + 1;
+            break;
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Layered (row-serial) schedule with per-layer early termination
+ * 
+ * Each check row reads its extrinsic inputs from the running posteriors,
+ * updates its outgoing messages, and writes the new posteriors back before
+ * the next row runs, so information propagates within an iteration.
+ * Hard-decision changes are folded into the syndrome incrementally, and
+ * decoding stops at the first layer boundary where no check is violated.
+ * 
+ * Expects decoded_bits and syndrome to hold the channel hard decisions.
+ */
+static FSOErrorCode ldpc_decode_layered(LDPCCodec* ldpc, int* iterations, int* converged)
+{
+    const int* row_ptr = ldpc->H->row_ptr;
+    const int* edge_var = ldpc->H->col_indices;
+    const int* edge_ptr = ldpc->var_edge_ptr;
+    const int* edge_index = ldpc->var_edge_index;
+    double* v2c = ldpc->variable_to_check;
+    double* c2v = ldpc->check_to_variable;
+    double* posterior = ldpc->posterior_llr;
+    int* bits = ldpc->decoded_bits;
+    int* syndrome = ldpc->syndrome;
+    
+    memset(c2v, 0, ldpc->num_edges * sizeof(double));
+    memcpy(posterior, ldpc->channel_llr, ldpc->n * sizeof(double));
+    
+    int unsatisfied = 0;
+    for (int c = 0; c < ldpc->m; c++) {
+        unsatisfied += syndrome[c];
+    }
+    
+    *converged = 0;
+    *iterations = ldpc->max_iterations;
+    
+    for (int iteration = 0; iteration < ldpc->max_iterations; iteration++) {
+        for (int layer_start = 0; layer_start < ldpc->m; layer_start += ldpc->layer_size) {
+            int layer_end = FSO_MIN(layer_start + ldpc->layer_size, ldpc->m);
+            
+            for (int c = layer_start; c < layer_end; c++) {
+                int row_start = row_ptr[c];
+                int row_end = row_ptr[c + 1];
+                
+                /* Extrinsic input: remove this row's previous contribution */
+                for (int e = row_start; e < row_end; e++) {
+                    v2c[e] = posterior[edge_var[e]] - c2v[e];
+                }
+                
+                FSOErrorCode result = ldpc_check_update_rows(ldpc, c, c + 1);
+                if (result != FSO_SUCCESS) {
+                    return result;
+                }
+                
+                /* Fold the new messages back into the posteriors */
+                for (int e = row_start; e < row_end; e++) {
+                    int v = edge_var[e];
+                    posterior[v] = v2c[e] + c2v[e];
+                    
+                    int bit = (posterior[v] < 0.0) ? 1 : 0;
+                    if (bit != bits[v]) {
+                        /* Hard decision flipped: toggle every check on v */
+                        bits[v] = bit;
+                        for (int s = edge_ptr[v]; s < edge_ptr[v + 1]; s++) {
+                            int cc = ldpc->edge_check[edge_index[s]];
+                            syndrome[cc] ^= 1;
+                            unsatisfied += syndrome[cc] ? 1 : -1;
+                        }
+                    }
+                }
+            }
+            
+            if (unsatisfied == 0) {
+                FSO_LOG_DEBUG(LDPC_MODULE, "Layered LDPC decoder converged at iteration %d, layer ending at row %d",
+                             iteration + 1, layer_end);
+                *converged = 1;
+                *iterations = iteration + 1;
+                return FSO_SUCCESS;
+            }
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+/* ============================================================================
+ * Quasi-Cyclic Codes
+ * ============================================================================ */
+
+/**
+ * @brief Whether a new info column shift would close a 4-cycle
+ * 
+ * Columns j and j2 sharing base rows r and r2 form a length-4 cycle in the
+ * lifted graph when s(r,j) - s(r2,j) = s(r,j2) - s(r2,j2) mod Z.
+ */
+static int ldpc_qc_closes_4cycle(const LDPCCodec* ldpc, int col, int row, int shift)
+{
+    const int Z = ldpc->lifting_size;
+    const int cols = ldpc->base_cols;
+    const int16_t* S = ldpc->qc_shifts;
+    
+    for (int r2 = 0; r2 < ldpc->base_rows; r2++) {
+        if (r2 == row || S[r2 * cols + col] < 0) continue;
+        int delta = shift - S[r2 * cols + col];
+        
+        for (int j2 = 0; j2 < cols; j2++) {
+            if (j2 == col || S[row * cols + j2] < 0 || S[r2 * cols + j2] < 0) continue;
+            int other = S[row * cols + j2] - S[r2 * cols + j2];
+            if (((delta - other) % Z + Z) % Z == 0) {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+FSOErrorCode ldpc_create_qc_base_graph(LDPCCodec* ldpc)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(ldpc->qc_shifts);
+    FSO_CHECK_PARAM(ldpc->lifting_size > 0 && ldpc->base_rows >= LDPC_QC_MIN_BASE_ROWS);
+    
+    const int Z = ldpc->lifting_size;
+    const int mb = ldpc->base_rows;
+    const int cols = ldpc->base_cols;
+    const int kb = cols - mb;
+    int16_t* S = ldpc->qc_shifts;
+    
+    for (int i = 0; i < mb * cols; i++) {
+        S[i] = -1;
+    }
+    
+    /* Dual-diagonal parity part */
+    S[0 * cols + kb] = (int16_t)(1 % Z);
+    S[(mb / 2) * cols + kb] = 0;
+    S[(mb - 1) * cols + kb] = (int16_t)(1 % Z);
+    for (int c = 1; c < mb; c++) {
+        S[(c - 1) * cols + kb + c] = 0;
+        S[c * cols + kb + c] = 0;
+    }
+    
+    int* row_weight = (int*)calloc(mb, sizeof(int));
+    if (!row_weight) {
+        return FSO_ERROR_MEMORY;
+    }
+    for (int i = 0; i < mb; i++) {
+        for (int j = kb; j < cols; j++) {
+            row_weight[i] += (S[i * cols + j] >= 0);
+        }
+    }
+    
+    /* Info columns: fixed degree, least-loaded rows, 4-cycle-free shifts
+     * where the seeded draws find one */
+    uint32_t state = ldpc->matrix_seed ? ldpc->matrix_seed : 0x9E3779B9u;
+    int cycles = 0;
+    
+    for (int j = 0; j < kb; j++) {
+        for (int d = 0; d < LDPC_QC_INFO_DEGREE; d++) {
+            int row = -1;
+            for (int t = 0; t < mb; t++) {
+                int i = (j * LDPC_QC_INFO_DEGREE + d + t) % mb;
+                if (S[i * cols + j] < 0 && (row < 0 || row_weight[i] < row_weight[row])) {
+                    row = i;
+                }
+            }
+            
+            int shift = (int)(ldpc_xorshift32(&state) % (uint32_t)Z);
+            int attempts = 0;
+            while (ldpc_qc_closes_4cycle(ldpc, j, row, shift) && ++attempts < 4 * Z) {
+                shift = (int)(ldpc_xorshift32(&state) % (uint32_t)Z);
+            }
+            cycles += (attempts == 4 * Z);
+            
+            S[row * cols + j] = (int16_t)shift;
+            row_weight[row]++;
+        }
+    }
+    
+    free(row_weight);
+    
+    if (cycles > 0) {
+        FSO_LOG_WARNING(LDPC_MODULE, "%d QC circulants could not avoid 4-cycles (Z=%d)", cycles, Z);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Build the QC base graph and lift it into the CSR H
+ * 
+ * The expanded H serves the generic and batched decoders; QC encode and
+ * decode work from the shift table alone.
+ */
+static FSOErrorCode ldpc_create_qc_matrix(LDPCCodec* ldpc)
+{
+    const int Z = ldpc->lifting_size;
+    const int cols = ldpc->base_cols;
+    
+    FSOErrorCode result = ldpc_create_qc_base_graph(ldpc);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    int blocks = 0;
+    for (int i = 0; i < ldpc->base_rows * cols; i++) {
+        blocks += (ldpc->qc_shifts[i] >= 0);
+    }
+    
+    result = sparse_matrix_init(ldpc->H, ldpc->m, ldpc->n, blocks * Z);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    int edge_count = 0;
+    for (int i = 0; i < ldpc->base_rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int s = ldpc->qc_shifts[i * cols + j];
+            if (s < 0) continue;
+            
+            for (int r = 0; r < Z; r++) {
+                ldpc->H->elements[edge_count].row = i * Z + r;
+                ldpc->H->elements[edge_count].col = j * Z + (r + s) % Z;
+                ldpc->H->elements[edge_count].value = 1;
+                edge_count++;
+            }
+        }
+    }
+    ldpc->H->nnz = edge_count;
+    
+    result = sparse_matrix_to_csr(ldpc->H);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to convert H matrix to CSR");
+        return result;
+    }
+    
+    result = ldpc_init_message_graph(ldpc);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to initialize message passing graph");
+        return result;
+    }
+    
+    FSO_LOG_INFO(LDPC_MODULE, "Created QC-LDPC matrix: %d circulants of size %d, %d edges",
+                blocks, Z, edge_count);
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief acc ^= P^s x for one Z-bit block, (P^s x)[r] = x[(r + s) mod Z]
+ */
+static inline void ldpc_qc_xor_rotated(uint8_t* acc, const uint8_t* x, int s, int Z)
+{
+    for (int r = 0; r < Z - s; r++) {
+        acc[r] ^= x[r + s];
+    }
+    for (int r = Z - s; r < Z; r++) {
+        acc[r] ^= x[r + s - Z];
+    }
+}
+
+/**
+ * @brief Linear-time systematic encoding over the dual-diagonal parity part
+ * 
+ * With lambda_i the info contribution of base row i, summing every row
+ * cancels the dual diagonal and leaves P^{s_mid} p0 = sum_i lambda_i; the
+ * remaining parity blocks then follow row by row. data and encoded may
+ * alias (the parity blocks never overlap the info bits).
+ */
+static void ldpc_qc_encode(LDPCCodec* ldpc, const uint8_t* data, uint8_t* encoded)
+{
+    const int Z = ldpc->lifting_size;
+    const int mb = ldpc->base_rows;
+    const int cols = ldpc->base_cols;
+    const int kb = cols - mb;
+    const int middle = mb / 2;
+    const int16_t* S = ldpc->qc_shifts;
+    uint8_t* lambda = ldpc->qc_encode_work;
+    
+    if (encoded != data) {
+        memcpy(encoded, data, (size_t)ldpc->k);
+    }
+    
+    memset(lambda, 0, (size_t)ldpc->m);
+    for (int i = 0; i < mb; i++) {
+        for (int j = 0; j < kb; j++) {
+            int s = S[i * cols + j];
+            if (s >= 0) {
+                ldpc_qc_xor_rotated(lambda + i * Z, encoded + j * Z, s, Z);
+            }
+        }
+    }
+    
+    /* p0: undo the middle rotation of the summed row contributions */
+    uint8_t* parity = encoded + ldpc->k;
+    const int s_mid = S[middle * cols + kb];
+    memset(parity, 0, (size_t)Z);
+    for (int i = 0; i < mb; i++) {
+        for (int r = 0; r < Z; r++) {
+            parity[(r + s_mid) % Z] ^= lambda[i * Z + r];
+        }
+    }
+    
+    /* p1 from the top row, then p_{i+1} = lambda_i + p_i (+ P^{s_mid} p0) */
+    memcpy(parity + Z, lambda, (size_t)Z);
+    ldpc_qc_xor_rotated(parity + Z, parity, S[kb], Z);
+    
+    for (int i = 1; i < mb - 1; i++) {
+        uint8_t* next = parity + (i + 1) * Z;
+        const uint8_t* current = parity + i * Z;
+        const uint8_t* row = lambda + i * Z;
+        for (int r = 0; r < Z; r++) {
+            next[r] = row[r] ^ current[r];
+        }
+        if (i == middle) {
+            ldpc_qc_xor_rotated(next, parity, s_mid, Z);
+        }
+    }
+}
+
+/**
+ * @brief Layered decoding with one base row (Z checks) per layer
+ * 
+ * Messages are kept block-major: the edge between check i*Z + r and its
+ * variable in block b of the base graph sits at b*Z + r. Every step is a
+ * Z-wide loop over contiguous memory split at the circulant wrap point,
+ * so the min-sum kernel vectorizes across the Z rows of a layer. Each
+ * row computes the same messages as ldpc_decode_layered; the syndrome is
+ * re-evaluated once per iteration rather than tracked per bit flip.
+ * 
+ * Expects decoded_bits and syndrome to hold the channel hard decisions.
+ */
+static FSOErrorCode ldpc_decode_qc_layered(LDPCCodec* ldpc, int* iterations, int* converged)
+{
+    const int Z = ldpc->lifting_size;
+    const int mb = ldpc->base_rows;
+    const int cols = ldpc->base_cols;
+    const int16_t* S = ldpc->qc_shifts;
+    double* v2c = ldpc->variable_to_check;
+    double* c2v = ldpc->check_to_variable;
+    double* posterior = ldpc->posterior_llr;
+    double* stat_a = ldpc->qc_row_work;
+    double* stat_b = ldpc->qc_row_work + Z;
+    double* sign = ldpc->qc_row_work + 2 * Z;
+    
+    double scale = 1.0;
+    double offset = 0.0;
+    switch (ldpc->check_node_algorithm) {
+        case LDPC_CHECK_SUM_PRODUCT:
+            break;
+        
+        case LDPC_CHECK_NORMALIZED_MIN_SUM:
+            scale = ldpc->min_sum_scale;
+            break;
+        
+        case LDPC_CHECK_OFFSET_MIN_SUM:
+            offset = ldpc->min_sum_offset;
+            break;
+        
+        default:
+            FSO_LOG_ERROR(LDPC_MODULE, "Unsupported check node algorithm: %d",
+                         ldpc->check_node_algorithm);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+    const int sum_product = (ldpc->check_node_algorithm == LDPC_CHECK_SUM_PRODUCT);
+    
+    memset(c2v, 0, ldpc->num_edges * sizeof(double));
+    memcpy(posterior, ldpc->channel_llr, ldpc->n * sizeof(double));
+    
+    *converged = 0;
+    *iterations = ldpc->max_iterations;
+    
+    for (int iteration = 0; iteration < ldpc->max_iterations; iteration++) {
+        int block = 0;
+        
+        for (int i = 0; i < mb; i++) {
+            const int first_block = block;
+            int degree = 0;
+            
+            for (int r = 0; r < Z; r++) {
+                stat_a[r] = sum_product ? 0.0 : INFINITY;
+                stat_b[r] = INFINITY;
+                sign[r] = 1.0;
+            }
+            
+            /* Gather the extrinsic inputs and the row statistics */
+            for (int j = 0; j < cols; j++) {
+                int s = S[i * cols + j];
+                if (s < 0) continue;
+                
+                const double* post = posterior + j * Z;
+                const double* old = c2v + block * Z;
+                double* in = v2c + block * Z;
+                for (int r = 0; r < Z - s; r++) {
+                    in[r] = post[r + s] - old[r];
+                }
+                for (int r = Z - s; r < Z; r++) {
+                    in[r] = post[r + s - Z] - old[r];
+                }
+                
+                if (sum_product) {
+                    /* c2v holds phi(|in|) until the output pass */
+                    double* phi = c2v + block * Z;
+                    for (int r = 0; r < Z; r++) {
+                        sign[r] *= (in[r] < 0.0) ? -1.0 : 1.0;
+                        phi[r] = ldpc_phi(fabs(in[r]));
+                        stat_a[r] += phi[r];
+                    }
+                } else {
+                    for (int r = 0; r < Z; r++) {
+                        double a = fabs(in[r]);
+                        sign[r] *= (in[r] < 0.0) ? -1.0 : 1.0;
+                        stat_b[r] = (a < stat_a[r]) ? stat_a[r] : ((a < stat_b[r]) ? a : stat_b[r]);
+                        stat_a[r] = (a < stat_a[r]) ? a : stat_a[r];
+                    }
+                }
+                
+                block++;
+                degree++;
+            }
+            
+            if (!sum_product) {
+                /* stat_b becomes the corrected min2 magnitude; ties give
+                 * min2 == min1, so (|in| == min1) picks min2 exactly where
+                 * the scalar kernel would */
+                for (int r = 0; r < Z; r++) {
+                    double min2 = (degree == 1) ? 0.0 : stat_b[r];
+                    stat_b[r] = FSO_MAX(min2 * scale - offset, 0.0);
+                }
+            }
+            
+            /* Check-to-variable messages and posterior update */
+            block = first_block;
+            for (int j = 0; j < cols; j++) {
+                int s = S[i * cols + j];
+                if (s < 0) continue;
+                
+                double* post = posterior + j * Z;
+                const double* in = v2c + block * Z;
+                double* out = c2v + block * Z;
+                
+                if (sum_product) {
+                    for (int r = 0; r < Z; r++) {
+                        double extrinsic = sign[r] * ((in[r] < 0.0) ? -1.0 : 1.0);
+                        double magnitude = ldpc_phi_inverse(stat_a[r] - out[r]);
+                        out[r] = (extrinsic < 0.0) ? -magnitude : magnitude;
+                    }
+                } else {
+                    for (int r = 0; r < Z; r++) {
+                        double extrinsic = sign[r] * ((in[r] < 0.0) ? -1.0 : 1.0);
+                        double mag1 = FSO_MAX(stat_a[r] * scale - offset, 0.0);
+                        double magnitude = (fabs(in[r]) == stat_a[r]) ? stat_b[r] : mag1;
+                        out[r] = (extrinsic < 0.0) ? -magnitude : magnitude;
+                    }
+                }
+                
+                for (int r = 0; r < Z - s; r++) {
+                    post[r + s] = in[r] + out[r];
+                }
+                for (int r = Z - s; r < Z; r++) {
+                    post[r + s - Z] = in[r] + out[r];
+                }
+                
+                block++;
+            }
+        }
+        
+        /* Hard decisions and block-wise syndrome */
+        int* bits = ldpc->decoded_bits;
+        int* syndrome = ldpc->syndrome;
+        for (int v = 0; v < ldpc->n; v++) {
+            bits[v] = (posterior[v] < 0.0) ? 1 : 0;
+        }
+        
+        memset(syndrome, 0, ldpc->m * sizeof(int));
+        for (int i = 0; i < mb; i++) {
+            int* check = syndrome + i * Z;
+            for (int j = 0; j < cols; j++) {
+                int s = S[i * cols + j];
+                if (s < 0) continue;
+                
+                const int* x = bits + j * Z;
+                for (int r = 0; r < Z - s; r++) {
+                    check[r] ^= x[r + s];
+                }
+                for (int r = Z - s; r < Z; r++) {
+                    check[r] ^= x[r + s - Z];
+                }
+            }
+        }
+        
+        int unsatisfied = 0;
+        for (int c = 0; c < ldpc->m; c++) {
+            unsatisfied += syndrome[c];
+        }
+        
+        if (unsatisfied == 0) {
+            FSO_LOG_DEBUG(LDPC_MODULE, "QC layered LDPC decoder converged at iteration %d",
+                         iteration + 1);
+            *converged = 1;
+            *iterations = iteration + 1;
+            return FSO_SUCCESS;
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Batched Decoding
+ * ============================================================================ */
+
+int ldpc_fixed_llr_limit(const LDPCCodec* ldpc)
+{
+    if (ldpc->llr_format == LDPC_LLR_INT8) {
+        return 127;
+    }
+    
+    int max_degree = 1;
+    for (int v = 0; ldpc->var_degree && v < ldpc->n; v++) {
+        max_degree = FSO_MAX(max_degree, ldpc->var_degree[v]);
+    }
+    return INT16_MAX / (max_degree + 1);
+}
+
+/**
+ * @brief Lane-interleaved buffers for ldpc_decode_batch
+ * 
+ * Every array holds LDPC_BATCH_LANES consecutive values per node or edge,
+ * so lane l of node v lives at [v * LDPC_BATCH_LANES + l].
+ */
+typedef struct {
+    LDPCLLRFormat format;       /* Element type: float or int16_t */
+    void* channel;              /* Channel LLRs (n lanes) */
+    void* posterior;            /* Current posteriors (n lanes) */
+    void* posterior_next;       /* Flooding accumulator (n lanes) */
+    void* v2c;                  /* Variable-to-check messages (num_edges lanes) */
+    void* c2v;                  /* Check-to-variable messages (num_edges lanes) */
+    uint8_t* hard;              /* Hard decisions (n lanes) */
+    int32_t limit;              /* Fixed-point saturation (ldpc_fixed_llr_limit()) */
+} LDPCBatchWorkspace;
+
+/**
+ * @brief Per-worker batch workspaces (ldpc->batch_workspace)
+ * 
+ * Slot w belongs to pool worker w, which allocates and first touches it,
+ * so its pages sit on that worker's NUMA node.
+ */
+typedef struct {
+    int count;                  /* Worker slots */
+    LDPCBatchWorkspace** slots; /* Workspace of each slot, or NULL */
+} LDPCBatchWorkspaceSet;
+
+static void* ldpc_batch_alloc(size_t count, size_t element_size)
+{
+    /* Cache-line aligned so each node's lane vector starts on a boundary */
+    size_t bytes = count * element_size;
+    bytes = (bytes + 63) & ~(size_t)63;
+    void* ptr = aligned_alloc(64, bytes > 0 ? bytes : 64);
+    if (ptr) {
+        memset(ptr, 0, bytes);
+    }
+    return ptr;
+}
+
+static void ldpc_batch_workspace_release(LDPCBatchWorkspace* ws)
+{
+    if (!ws) {
+        return;
+    }
+    
+    free(ws->channel);
+    free(ws->posterior);
+    free(ws->posterior_next);
+    free(ws->v2c);
+    free(ws->c2v);
+    free(ws->hard);
+    free(ws);
+}
+
+/**
+ * @brief Allocate (and first-touch) one workspace on the calling thread
+ */
+static LDPCBatchWorkspace* ldpc_batch_workspace_alloc(const LDPCCodec* ldpc)
+{
+    LDPCBatchWorkspace* ws = (LDPCBatchWorkspace*)calloc(1, sizeof(LDPCBatchWorkspace));
+    if (!ws) {
+        return NULL;
+    }
+    
+    size_t elem = (ldpc->llr_format == LDPC_LLR_FLOAT) ? sizeof(float) : sizeof(int16_t);
+    size_t node_lanes = (size_t)ldpc->n * LDPC_BATCH_LANES;
+    size_t edge_lanes = (size_t)ldpc->num_edges * LDPC_BATCH_LANES;
+    
+    ws->format = ldpc->llr_format;
+    ws->channel = ldpc_batch_alloc(node_lanes, elem);
+    ws->posterior = ldpc_batch_alloc(node_lanes, elem);
+    ws->posterior_next = ldpc_batch_alloc(node_lanes, elem);
+    ws->v2c = ldpc_batch_alloc(edge_lanes, elem);
+    ws->c2v = ldpc_batch_alloc(edge_lanes, elem);
+    ws->hard = (uint8_t*)ldpc_batch_alloc(node_lanes, sizeof(uint8_t));
+    
+    if (!ws->channel || !ws->posterior || !ws->posterior_next ||
+        !ws->v2c || !ws->c2v || !ws->hard) {
+        ldpc_batch_workspace_release(ws);
+        return NULL;
+    }
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "Allocated %d-lane batch workspace (%s messages)",
+                 LDPC_BATCH_LANES, ldpc->llr_format == LDPC_LLR_FLOAT ? "float" : "fixed-point");
+    
+    return ws;
+}
+
+static void ldpc_batch_workspace_free(void* workspace)
+{
+    LDPCBatchWorkspaceSet* set = (LDPCBatchWorkspaceSet*)workspace;
+    if (!set) {
+        return;
+    }
+    
+    for (int w = 0; w < set->count; w++) {
+        ldpc_batch_workspace_release(set->slots[w]);
+    }
+    free(set->slots);
+    free(set);
+}
+
+/**
+ * @brief The codec's workspace set, with at least count worker slots
+ * 
+ * Slots start empty; each worker fills its own on first use.
+ */
+static FSOErrorCode ldpc_batch_workspace_set(LDPCCodec* ldpc, int count, LDPCBatchWorkspaceSet** out)
+{
+    LDPCBatchWorkspaceSet* set = (LDPCBatchWorkspaceSet*)ldpc->batch_workspace;
+    if (!set) {
+        set = (LDPCBatchWorkspaceSet*)calloc(1, sizeof(LDPCBatchWorkspaceSet));
+        if (!set) {
+            return FSO_ERROR_MEMORY;
+        }
+        ldpc->batch_workspace = set;
+    }
+    
+    if (set->count < count) {
+        LDPCBatchWorkspace** slots = (LDPCBatchWorkspace**)realloc(set->slots,
+                                                                   (size_t)count * sizeof(*slots));
+        if (!slots) {
+            return FSO_ERROR_MEMORY;
+        }
+        for (int w = set->count; w < count; w++) {
+            slots[w] = NULL;
+        }
+        set->slots = slots;
+        set->count = count;
+    }
+    
+    *out = set;
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief One float iteration across all lanes (flooding or layered)
+ */
+static FSO_ALWAYS_INLINE void ldpc_batch_iterate_float_body(const LDPCCodec* ldpc,
+                                                            LDPCBatchWorkspace* ws)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int* row_ptr = ldpc->H->row_ptr;
+    const int* edge_var = ldpc->H->col_indices;
+    const int layered = (ldpc->schedule == LDPC_SCHEDULE_LAYERED);
+    const int min_sum = (ldpc->check_node_algorithm != LDPC_CHECK_SUM_PRODUCT);
+    const float scale = (ldpc->check_node_algorithm == LDPC_CHECK_NORMALIZED_MIN_SUM) ?
+                        (float)ldpc->min_sum_scale : 1.0f;
+    const float offset = (ldpc->check_node_algorithm == LDPC_CHECK_OFFSET_MIN_SUM) ?
+                         (float)ldpc->min_sum_offset : 0.0f;
+    
+    float* post = (float*)ws->posterior;
+    float* post_out = layered ? post : (float*)ws->posterior_next;
+    float* v2c = (float*)ws->v2c;
+    float* c2v = (float*)ws->c2v;
+    
+    if (!layered) {
+        memcpy(post_out, ws->channel, (size_t)ldpc->n * L * sizeof(float));
+    }
+    
+    for (int c = 0; c < ldpc->m; c++) {
+        int edge_start = row_ptr[c];
+        int edge_end = row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
+        
+        float min1[L], min2[L], sign[L];
+        int min1_edge[L];
+        
+        for (int l = 0; l < L; l++) {
+            min1[l] = INFINITY;
+            min2[l] = INFINITY;
+            sign[l] = 1.0f;
+            min1_edge[l] = -1;
+        }
+        
+        /* Extrinsic inputs and row statistics */
+        for (int e = edge_start; e < edge_end; e++) {
+            const float* pv = post + (size_t)edge_var[e] * L;
+            float* in = v2c + (size_t)e * L;
+            const float* old = c2v + (size_t)e * L;
+            
+            for (int l = 0; l < L; l++) {
+                /* Branch-free two-minimum update so the lane loop vectorizes */
+                float x = pv[l] - old[l];
+                float a = fabsf(x);
+                float m1 = min1[l];
+                float m2 = min2[l];
+                int is_min = a < m1;
+                
+                in[l] = x;
+                sign[l] = (x < 0.0f) ? -sign[l] : sign[l];
+                min2[l] = is_min ? m1 : (a < m2 ? a : m2);
+                min1_edge[l] = is_min ? e : min1_edge[l];
+                min1[l] = is_min ? a : m1;
+            }
+        }
+        
+        if (min_sum) {
+            float mag1[L], mag2[L];
+            for (int l = 0; l < L; l++) {
+                float m2 = (edge_end - edge_start == 1) ? 0.0f : min2[l];
+                float v1 = min1[l] * scale - offset;
+                float v2 = m2 * scale - offset;
+                mag1[l] = v1 > 0.0f ? v1 : 0.0f;
+                mag2[l] = v2 > 0.0f ? v2 : 0.0f;
+            }
+            
+            for (int e = edge_start; e < edge_end; e++) {
+                const float* in = v2c + (size_t)e * L;
+                float* out = c2v + (size_t)e * L;
+                
+                for (int l = 0; l < L; l++) {
+                    float mag = (e == min1_edge[l]) ? mag2[l] : mag1[l];
+                    float s = (in[l] < 0.0f) ? -sign[l] : sign[l];
+                    out[l] = s * mag;
+                }
+            }
+        } else {
+            /* Sum-product: phi is not vectorized, but lanes stay contiguous */
+            float total[L];
+            for (int l = 0; l < L; l++) {
+                total[l] = 0.0f;
+            }
+            
+            for (int e = edge_start; e < edge_end; e++) {
+                const float* in = v2c + (size_t)e * L;
+                float* out = c2v + (size_t)e * L;
+                for (int l = 0; l < L; l++) {
+                    out[l] = (float)ldpc_phi(fabs((double)in[l]));
+                    total[l] += out[l];
+                }
+            }
+            
+            for (int e = edge_start; e < edge_end; e++) {
+                const float* in = v2c + (size_t)e * L;
+                float* out = c2v + (size_t)e * L;
+                for (int l = 0; l < L; l++) {
+                    float mag = (float)ldpc_phi_inverse((double)(total[l] - out[l]));
+                    float s = (in[l] < 0.0f) ? -sign[l] : sign[l];
+                    out[l] = s * mag;
+                }
+            }
+        }
+        
+        /* Posterior write-back (layered) or accumulation (flooding) */
+        if (layered) {
+            for (int e = edge_start; e < edge_end; e++) {
+                float* pv = post_out + (size_t)edge_var[e] * L;
+                const float* in = v2c + (size_t)e * L;
+                const float* out = c2v + (size_t)e * L;
+                for (int l = 0; l < L; l++) {
+                    pv[l] = in[l] + out[l];
+                }
+            }
+        } else {
+            for (int e = edge_start; e < edge_end; e++) {
+                float* pv = post_out + (size_t)edge_var[e] * L;
+                const float* out = c2v + (size_t)e * L;
+                for (int l = 0; l < L; l++) {
+                    pv[l] += out[l];
+                }
+            }
+        }
+    }
+    
+    if (!layered) {
+        ws->posterior = post_out;
+        ws->posterior_next = post;
+    }
+    
+    /* Hard decisions for the syndrome test */
+    const float* final_post = (const float*)ws->posterior;
+    for (size_t i = 0; i < (size_t)ldpc->n * L; i++) {
+        ws->hard[i] = final_post[i] < 0.0f;
+    }
+}
+
+/**
+ * @brief One fixed-point min-sum iteration across all lanes
+ * 
+ * Channel LLRs and check messages are int16_t saturated to +/-ws->limit
+ * (ldpc_fixed_llr_limit()). A posterior is the channel LLR plus one
+ * message per edge, which that limit keeps inside int16_t, so the
+ * layered "posterior - old message" step is exact even when every
+ * message is saturated. The int16_t clamps below are never reached.
+ */
+static FSO_ALWAYS_INLINE void ldpc_batch_iterate_fixed_body(const LDPCCodec* ldpc,
+                                                            LDPCBatchWorkspace* ws)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int* row_ptr = ldpc->H->row_ptr;
+    const int* edge_var = ldpc->H->col_indices;
+    const int layered = (ldpc->schedule == LDPC_SCHEDULE_LAYERED);
+    const int32_t limit = ws->limit;
+    
+    /* Normalization as a Q8 multiply; offset in fixed-point steps */
+    int32_t scale_q8 = 256;
+    int32_t offset = 0;
+    if (ldpc->check_node_algorithm == LDPC_CHECK_OFFSET_MIN_SUM) {
+        offset = (int32_t)lround(ldpc->min_sum_offset * LDPC_FIXED_LLR_SCALE);
+    } else {
+        scale_q8 = (int32_t)lround(ldpc->min_sum_scale * 256.0);
+    }
+    
+    int16_t* post = (int16_t*)ws->posterior;
+    int16_t* post_out = layered ? post : (int16_t*)ws->posterior_next;
+    int16_t* v2c = (int16_t*)ws->v2c;
+    int16_t* c2v = (int16_t*)ws->c2v;
+    
+    if (!layered) {
+        memcpy(post_out, ws->channel, (size_t)ldpc->n * L * sizeof(int16_t));
+    }
+    
+    for (int c = 0; c < ldpc->m; c++) {
+        int edge_start = row_ptr[c];
+        int edge_end = row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
+        
+        int32_t min1[L], min2[L], mag1[L], mag2[L];
+        int32_t negative[L];
+        int32_t min1_edge[L];
+        
+        for (int l = 0; l < L; l++) {
+            min1[l] = limit;
+            min2[l] = limit;
+            negative[l] = 0;
+            min1_edge[l] = -1;
+        }
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            const int16_t* pv = post + (size_t)edge_var[e] * L;
+            int16_t* in = v2c + (size_t)e * L;
+            const int16_t* old = c2v + (size_t)e * L;
+            
+            for (int l = 0; l < L; l++) {
+                int32_t x = (int32_t)pv[l] - (int32_t)old[l];
+                x = FSO_CLAMP(x, -INT16_MAX, INT16_MAX);
+                int32_t a = x < 0 ? -x : x;
+                a = FSO_MIN(a, limit);
+                int32_t is_min = a < min1[l];
+                
+                in[l] = (int16_t)x;
+                negative[l] ^= (x < 0);
+                min2[l] = is_min ? min1[l] : FSO_MIN(min2[l], a);
+                min1_edge[l] = is_min ? e : min1_edge[l];
+                min1[l] = is_min ? a : min1[l];
+            }
+        }
+        
+        for (int l = 0; l < L; l++) {
+            int32_t m2 = (edge_end - edge_start == 1) ? 0 : min2[l];
+            mag1[l] = FSO_MAX(((min1[l] * scale_q8) >> 8) - offset, 0);
+            mag2[l] = FSO_MAX(((m2 * scale_q8) >> 8) - offset, 0);
+        }
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            const int16_t* in = v2c + (size_t)e * L;
+            int16_t* out = c2v + (size_t)e * L;
+            int16_t* pv = post_out + (size_t)edge_var[e] * L;
+            
+            for (int l = 0; l < L; l++) {
+                int32_t mag = (e == min1_edge[l]) ? mag2[l] : mag1[l];
+                int32_t msg = (negative[l] ^ (in[l] < 0)) ? -mag : mag;
+                int32_t p = layered ? (int32_t)in[l] + msg : (int32_t)pv[l] + msg;
+                
+                out[l] = (int16_t)msg;
+                pv[l] = (int16_t)FSO_CLAMP(p, -INT16_MAX, INT16_MAX);
+            }
+        }
+    }
+    
+    if (!layered) {
+        ws->posterior = post_out;
+        ws->posterior_next = post;
+    }
+    
+    const int16_t* final_post = (const int16_t*)ws->posterior;
+    for (size_t i = 0; i < (size_t)ldpc->n * L; i++) {
+        ws->hard[i] = final_post[i] < 0;
+    }
+}
+
+/*
+ * The lane loops above are written for the auto-vectorizer; each
+ * instruction-set family gets its own compiled copy so a baseline build
+ * still runs 16 lanes per AVX-512 register. Every copy performs the same
+ * operations per lane, so all of them decode identically.
+ */
+
+typedef struct {
+    void (*iterate_float)(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws);
+    void (*iterate_fixed)(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws);
+} LDPCBatchKernels;
+
+static void ldpc_batch_iterate_float_scalar(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_float_body(ldpc, ws);
+}
+
+static void ldpc_batch_iterate_fixed_scalar(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_fixed_body(ldpc, ws);
+}
+
+static const LDPCBatchKernels ldpc_batch_kernels_scalar = {
+    ldpc_batch_iterate_float_scalar, ldpc_batch_iterate_fixed_scalar
+};
+
+#if FSO_HAVE_X86_SIMD
+
+FSO_TARGET_SSE42
+static void ldpc_batch_iterate_float_sse42(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_float_body(ldpc, ws);
+}
+
+FSO_TARGET_SSE42
+static void ldpc_batch_iterate_fixed_sse42(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_fixed_body(ldpc, ws);
+}
+
+FSO_TARGET_AVX2
+static void ldpc_batch_iterate_float_avx2(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_float_body(ldpc, ws);
+}
+
+FSO_TARGET_AVX2
+static void ldpc_batch_iterate_fixed_avx2(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_fixed_body(ldpc, ws);
+}
+
+FSO_TARGET_AVX512
+static void ldpc_batch_iterate_float_avx512(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_float_body(ldpc, ws);
+}
+
+FSO_TARGET_AVX512
+static void ldpc_batch_iterate_fixed_avx512(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws)
+{
+    ldpc_batch_iterate_fixed_body(ldpc, ws);
+}
+
+static const LDPCBatchKernels ldpc_batch_kernels_sse42 = {
+    ldpc_batch_iterate_float_sse42, ldpc_batch_iterate_fixed_sse42
+};
+static const LDPCBatchKernels ldpc_batch_kernels_avx2 = {
+    ldpc_batch_iterate_float_avx2, ldpc_batch_iterate_fixed_avx2
+};
+static const LDPCBatchKernels ldpc_batch_kernels_avx512 = {
+    ldpc_batch_iterate_float_avx512, ldpc_batch_iterate_fixed_avx512
+};
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+/**
+ * @brief Lane kernels for the enabled family; NEON is the AArch64 baseline
+ */
+static const LDPCBatchKernels* ldpc_batch_kernels(void)
+{
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: return &ldpc_batch_kernels_avx512;
+        case FSO_SIMD_AVX2:   return &ldpc_batch_kernels_avx2;
+        case FSO_SIMD_SSE42:  return &ldpc_batch_kernels_sse42;
+#endif
+        default:              return &ldpc_batch_kernels_scalar;
+    }
+}
+
+/**
+ * @brief Per-lane syndrome test on ws->hard
+ * @return Bit mask with bit l set when lane l satisfies every check
+ */
+static uint32_t ldpc_batch_satisfied_lanes(const LDPCCodec* ldpc, const LDPCBatchWorkspace* ws)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int* row_ptr = ldpc->H->row_ptr;
+    const int* edge_var = ldpc->H->col_indices;
+    uint8_t violated[L];
+    
+    memset(violated, 0, sizeof(violated));
+    
+    for (int c = 0; c < ldpc->m; c++) {
+        uint8_t parity[L];
+        memset(parity, 0, sizeof(parity));
+        
+        for (int e = row_ptr[c]; e < row_ptr[c + 1]; e++) {
+            const uint8_t* hv = ws->hard + (size_t)edge_var[e] * L;
+            for (int l = 0; l < L; l++) {
+                parity[l] ^= hv[l];
+            }
+        }
+        
+        for (int l = 0; l < L; l++) {
+            violated[l] |= parity[l];
+        }
+    }
+    
+    uint32_t mask = 0;
+    for (int l = 0; l < L; l++) {
+        if (!violated[l]) {
+            mask |= (uint32_t)1 << l;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Transpose hard inputs into lanes with a fixed channel magnitude
+ * 
+ * Padding lanes carry the zero word.
+ */
+static void ldpc_batch_load_hard(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws,
+                                 const uint8_t* received, size_t base, int lanes)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int fixed = (ldpc->llr_format != LDPC_LLR_FLOAT);
+    const int16_t hard_fixed = (int16_t)FSO_MIN(lround(10.0 * LDPC_FIXED_LLR_SCALE), (long)ws->limit);
+    
+    for (int v = 0; v < ldpc->n; v++) {
+        for (int l = 0; l < L; l++) {
+            int bit = (l < lanes) ? (received[(base + l) * ldpc->n + v] != 0) : 0;
+            ws->hard[(size_t)v * L + l] = (uint8_t)bit;
+            if (fixed) {
+                ((int16_t*)ws->channel)[(size_t)v * L + l] = bit ? -hard_fixed : hard_fixed;
+            } else {
+                ((float*)ws->channel)[(size_t)v * L + l] = bit ? -10.0f : 10.0f;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transpose channel LLRs into lanes, quantizing for fixed-point formats
+ * 
+ * Codeword w, bit v is llr[(w * n + v) * stride]. Fixed-point LLRs are
+ * rounded to LDPC_FIXED_LLR_SCALE steps and saturated to ws->limit.
+ * Padding lanes carry a confident zero word.
+ */
+static void ldpc_batch_load_soft(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws,
+                                 const float* llr, size_t stride, size_t base, int lanes)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int fixed = (ldpc->llr_format != LDPC_LLR_FLOAT);
+    const float limit = (float)ws->limit;
+    const float scale = (float)LDPC_FIXED_LLR_SCALE;
+    
+    for (int v = 0; v < ldpc->n; v++) {
+        for (int l = 0; l < L; l++) {
+            float value = (l < lanes) ? llr[((base + l) * ldpc->n + v) * stride] : 10.0f;
+            ws->hard[(size_t)v * L + l] = (uint8_t)(value < 0.0f);
+            if (fixed) {
+                float q = rintf(value * scale);
+                ((int16_t*)ws->channel)[(size_t)v * L + l] = (int16_t)FSO_CLAMP(q, -limit, limit);
+            } else {
+                ((float*)ws->channel)[(size_t)v * L + l] = value;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decode the lane group starting at codeword base
+ * 
+ * The input is soft when llr is non-NULL, otherwise the hard bits in
+ * received.
+ */
+static void ldpc_batch_decode_group(const LDPCCodec* ldpc, LDPCBatchWorkspace* ws,
+                                    const uint8_t* received, const float* llr, size_t stride,
+                                    size_t num_codewords, size_t base,
+                                    uint8_t* decoded, int* iterations, int* converged)
+{
+    enum { L = LDPC_BATCH_LANES };
+    const int fixed = (ldpc->llr_format != LDPC_LLR_FLOAT);
+    const LDPCBatchKernels* kernels = ldpc_batch_kernels();
+    const size_t node_lanes = (size_t)ldpc->n * L;
+    const size_t edge_lanes = (size_t)ldpc->num_edges * L;
+    const size_t elem = fixed ? sizeof(int16_t) : sizeof(float);
+    
+    int lanes = (int)FSO_MIN((size_t)L, num_codewords - base);
+    uint32_t active_mask = (lanes == L) ? 0xFFFFFFFFu >> (32 - L) : (((uint32_t)1 << lanes) - 1);
+    uint32_t done = 0;
+    
+    ws->limit = ldpc_fixed_llr_limit(ldpc);
+    if (llr) {
+        ldpc_batch_load_soft(ldpc, ws, llr, stride, base, lanes);
+    } else {
+        ldpc_batch_load_hard(ldpc, ws, received, base, lanes);
+    }
+    
+    memcpy(ws->posterior, ws->channel, node_lanes * elem);
+    memset(ws->c2v, 0, edge_lanes * elem);
+    
+    int iteration = 0;
+    for (;;) {
+        uint32_t satisfied = ldpc_batch_satisfied_lanes(ldpc, ws) & active_mask & ~done;
+        
+        /* Capture lanes on the iteration they first satisfy H */
+        for (int l = 0; l < lanes; l++) {
+            if (!(satisfied & ((uint32_t)1 << l))) continue;
+            
+            uint8_t* out = decoded + (base + l) * ldpc->k;
+            for (int i = 0; i < ldpc->k; i++) {
+                out[i] = ws->hard[(size_t)i * L + l];
+            }
+            if (iterations) iterations[base + l] = iteration;
+            if (converged) converged[base + l] = 1;
+        }
+        done |= satisfied;
+        
+        if (done == active_mask || iteration == ldpc->max_iterations) {
+            break;
+        }
+        
+        if (fixed) {
+            kernels->iterate_fixed(ldpc, ws);
+        } else {
+            kernels->iterate_float(ldpc, ws);
+        }
+        iteration++;
+    }
+    
+    /* Lanes that never converged keep their final hard decisions */
+    for (int l = 0; l < lanes; l++) {
+        if (done & ((uint32_t)1 << l)) continue;
+        
+        uint8_t* out = decoded + (base + l) * ldpc->k;
+        for (int i = 0; i < ldpc->k; i++) {
+            out[i] = ws->hard[(size_t)i * L + l];
+        }
+        if (iterations) iterations[base + l] = ldpc->max_iterations;
+        if (converged) converged[base + l] = 0;
+    }
 }
 
-static int gcd(int a, int b)
-{
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
-}
+/**
+ * @brief Arguments of a pooled batch decode
+ */
+typedef struct {
+    const LDPCCodec* ldpc;
+    LDPCBatchWorkspaceSet* workspaces;
+    const uint8_t* received;
+    const float* llr;           /* Soft input (NULL for hard input) */
+    size_t stride;              /* LLR stride */
+    size_t num_codewords;
+    uint8_t* decoded;
+    int* iterations;
+    int* converged;
+    atomic_int failed;          /* Set when a worker cannot get a workspace */
+} LDPCBatchJob;
 
-FSOErrorCode ldpc_init_message_graph(LDPCCodec* ldpc)
+/**
+ * @brief Decode lane groups [begin, end) with the worker's own workspace
+ */
+static void ldpc_batch_decode_groups(void* context, size_t begin, size_t end, int worker)
 {
-    FSO_CHECK_NULL(ldpc);
-    FSO_CHECK_NULL(ldpc->H);
-    
-    /* Initialize degree arrays */
-    memset(ldpc->var_degree, 0, ldpc->n * sizeof(int));
-    memset(ldpc->check_degree, 0, ldpc->m * sizeof(int));
-    
-    /* Count degrees from parity-check matrix */
-    for (int i = 0; i < ldpc->H->nnz; i++) {
-        int row = ldpc->H->elements[i].row;
-        int col = ldpc->H->elements[i].col;
-        
-        if (row < ldpc->m && col < ldpc->n) {
-            ldpc->var_degree[col]++;
-            ldpc->check_degree[row]++;
+    LDPCBatchJob* job = (LDPCBatchJob*)context;
+    LDPCBatchWorkspace** slot = &job->workspaces->slots[worker];
+    
+    if (!*slot || (*slot)->format != job->ldpc->llr_format) {
+        ldpc_batch_workspace_release(*slot);
+        *slot = ldpc_batch_workspace_alloc(job->ldpc);
+        if (!*slot) {
+            atomic_store(&job->failed, 1);
+            return;
         }
     }
     
-    /* Allocate edge lists */
-    for (int i = 0; i < ldpc->n; i++) {
-        if (ldpc->var_degree[i] > 0) {
-            ldpc->var_to_check_edges[i] = (int*)calloc(ldpc->var_degree[i], sizeof(int));
-            if (!ldpc->var_to_check_edges[i]) {
-                FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate var-to-check edges for node %d", i);
-                return FSO_ERROR_MEMORY;
-            }
-        }
+    for (size_t g = begin; g < end; g++) {
+        ldpc_batch_decode_group(job->ldpc, *slot, job->received, job->llr, job->stride,
+                                job->num_codewords, g * LDPC_BATCH_LANES, job->decoded,
+                                job->iterations, job->converged);
+    }
+}
+
+/**
+ * @brief Run a prepared batch job over the worker pool
+ */
+static FSOErrorCode ldpc_batch_run(LDPCCodec* ldpc, LDPCBatchJob* job)
+{
+    if (!ldpc->H || !ldpc->H->row_ptr || !ldpc->var_edge_index) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Message passing graph not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
     }
     
-    for (int i = 0; i < ldpc->m; i++) {
-        if (ldpc->check_degree[i] > 0) {
-            ldpc->check_to_var_edges[i] = (int*)calloc(ldpc->check_degree[i], sizeof(int));
-            if (!ldpc->check_to_var_edges[i]) {
-                FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate check-to-var edges for node %d", i);
-                return FSO_ERROR_MEMORY;
-            }
+    /* Large batches go to the GPU unless it cannot match the CPU decisions */
+    if (ldpc->backend == LDPC_BACKEND_CUDA && job->num_codewords >= LDPC_CUDA_MIN_BATCH) {
+        FSOErrorCode result = ldpc_cuda_decode_batch(ldpc, job->received, job->llr, job->stride,
+                                                     job->num_codewords, job->decoded,
+                                                     job->iterations, job->converged);
+        if (result != FSO_ERROR_UNSUPPORTED) {
+            return result;
         }
     }
     
-    /* Fill edge lists */
-    int* var_edge_count = (int*)calloc(ldpc->n, sizeof(int));
-    int* check_edge_count = (int*)calloc(ldpc->m, sizeof(int));
+    atomic_init(&job->failed, 0);
     
-    if (!var_edge_count || !check_edge_count) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate edge count arrays");
-        if (var_edge_count) free(var_edge_count);
-        if (check_edge_count) free(check_edge_count);
+    if (ldpc_batch_workspace_set(ldpc, fso_threadpool_size(), &job->workspaces) != FSO_SUCCESS) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate batch workspace");
         return FSO_ERROR_MEMORY;
     }
     
-    for (int i = 0; i < ldpc->H->nnz; i++) {
-        int row = ldpc->H->elements[i].row;
-        int col = ldpc->H->elements[i].col;
-        
-        if (row < ldpc->m && col < ldpc->n) {
-            /* Add edge to variable node's list */
-            if (ldpc->var_to_check_edges[col] && var_edge_count[col] < ldpc->var_degree[col]) {
-                ldpc->var_to_check_edges[col][var_edge_count[col]] = row;
-                var_edge_count[col]++;
-            }
-            
-            /* Add edge to check node's list */
-            if (ldpc->check_to_var_edges[row] && check_edge_count[row] < ldpc->check_degree[row]) {
-                ldpc->check_to_var_edges[row][check_edge_count[row]] = col;
-                check_edge_count[row]++;
-            }
-        }
-    }
+    /* Lane groups converge at different rates, so workers claim them one at a time */
+    size_t groups = (job->num_codewords + LDPC_BATCH_LANES - 1) / LDPC_BATCH_LANES;
+    fso_parallel_for(groups, 1, 0, ldpc_batch_decode_groups, job);
     
-    free(var_edge_count);
-    free(check_edge_count);
+    if (atomic_load(&job->failed)) {
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate batch workspace");
+        return FSO_ERROR_MEMORY;
+    }
     
-    FSO_LOG_DEBUG(LDPC_MODULE, "Initialized message passing graph with %d variable nodes and %d check nodes",
-                 ldpc->n, ldpc->m);
+    FSO_LOG_DEBUG(LDPC_MODULE, "Batch decoded %zu codewords in %d-lane groups (%s input)",
+                 job->num_codewords, LDPC_BATCH_LANES, job->llr ? "soft" : "hard");
     
     return FSO_SUCCESS;
 }
 
-FSOErrorCode ldpc_decode(LDPCCodec* ldpc, const uint8_t* received, size_t received_len,
-                         uint8_t* decoded, size_t decoded_len, int* errors_corrected)
+FSOErrorCode ldpc_decode_batch(LDPCCodec* ldpc, const uint8_t* received, size_t num_codewords,
+                               uint8_t* decoded, int* iterations, int* converged)
 {
     FSO_CHECK_NULL(ldpc);
     FSO_CHECK_NULL(received);
     FSO_CHECK_NULL(decoded);
-    FSO_CHECK_PARAM(received_len == (size_t)ldpc->n);
-    FSO_CHECK_PARAM(decoded_len >= (size_t)ldpc->k);
-    
-    /* Check if message passing graph is initialized */
-    if (!ldpc->var_to_check_edges || !ldpc->check_to_var_edges) {
-        FSO_LOG_ERROR(LDPC_MODULE, "Message passing graph not initialized");
-        return FSO_ERROR_NOT_INITIALIZED;
+    FSO_CHECK_PARAM(num_codewords > 0);
+    
+    LDPCBatchJob job = {
+        .ldpc = ldpc,
+        .received = received,
+        .num_codewords = num_codewords,
+        .decoded = decoded,
+        .iterations = iterations,
+        .converged = converged
+    };
+    
+    return ldpc_batch_run(ldpc, &job);
+}
+
+FSOErrorCode ldpc_decode_batch_soft(LDPCCodec* ldpc, const float* llr, size_t stride,
+                                    size_t num_codewords, uint8_t* decoded,
+                                    int* iterations, int* converged)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(stride > 0);
+    FSO_CHECK_PARAM(num_codewords > 0);
+    
+    LDPCBatchJob job = {
+        .ldpc = ldpc,
+        .llr = llr,
+        .stride = stride,
+        .num_codewords = num_codewords,
+        .decoded = decoded,
+        .iterations = iterations,
+        .converged = converged
+    };
+    
+    return ldpc_batch_run(ldpc, &job);
+}
+
+/* ============================================================================
+ * Monte Carlo Simulation
+ * ============================================================================ */
+
+/**
+ * @brief Uniform double in (0, 1) from the next two stream words
+ * 
+ * Same construction as the device generator in ldpc_cuda.cu.
+ */
+static inline double ldpc_sim_uniform(FSORandomStream* stream)
+{
+    uint64_t hi = fso_random_stream_next(stream);
+    uint64_t lo = fso_random_stream_next(stream);
+    return ((double)(((hi << 32) | lo) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+/**
+ * @brief Arguments of a pooled channel draw
+ */
+typedef struct {
+    const LDPCCodec* ldpc;
+    const LDPCSimulationConfig* config;
+    float* llr;                 /* Output LLRs (n per codeword) */
+    size_t base;                /* Codeword index of llr[0] */
+    double sigma;               /* Noise standard deviation */
+} LDPCSimulationJob;
+
+/**
+ * @brief Channel LLRs of the all-zero codeword for codewords [begin, end)
+ * 
+ * Each Box-Muller pair consumes one Philox block: words 0-1 give the
+ * radius uniform and words 2-3 the angle uniform.
+ */
+static void ldpc_simulate_channel(void* context, size_t begin, size_t end, int worker)
+{
+    (void)worker;
+    const LDPCSimulationJob* job = (const LDPCSimulationJob*)context;
+    const int n = job->ldpc->n;
+    const double two_pi = 6.283185307179586;
+    const double llr_scale = 2.0 / (job->sigma * job->sigma);
+    
+    for (size_t w = begin; w < end; w++) {
+        uint32_t packet = (uint32_t)(job->base + w);
+        FSORandomStream stream;
+        double gain = 1.0;
+        
+        if (job->config->scintillation_index > 0.0) {
+            fso_random_stream_init(&stream, job->config->seed, packet, FSO_RNG_STREAM_CHANNEL);
+            double u1 = ldpc_sim_uniform(&stream);
+            double u2 = ldpc_sim_uniform(&stream);
+            double z = sqrt(-2.0 * log(u1)) * cos(two_pi * u2);
+            double log_var = log(1.0 + job->config->scintillation_index);
+            gain = exp(sqrt(log_var) * z - 0.5 * log_var);
+        }
+        
+        fso_random_stream_init(&stream, job->config->seed, packet, FSO_RNG_STREAM_NOISE);
+        float* out = job->llr + w * (size_t)n;
+        for (int v = 0; v < n; v += 2) {
+            double u1 = ldpc_sim_uniform(&stream);
+            double u2 = ldpc_sim_uniform(&stream);
+            double radius = sqrt(-2.0 * log(u1)) * job->sigma;
+            
+            out[v] = (float)(llr_scale * gain * (gain + radius * cos(two_pi * u2)));
+            if (v + 1 < n) {
+                out[v + 1] = (float)(llr_scale * gain * (gain + radius * sin(two_pi * u2)));
+            }
+        }
     }
+}
+
+FSOErrorCode ldpc_simulate(LDPCCodec* ldpc, const LDPCSimulationConfig* config,
+                           LDPCSimulationResult* result)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(result);
+    FSO_CHECK_PARAM(config->num_codewords > 0);
+    FSO_CHECK_PARAM(config->scintillation_index >= 0.0);
     
-    /* Initialize channel LLRs from received hard bits
-     * For hard decision decoding, we use a large LLR magnitude */
-    const double hard_llr_magnitude = 10.0;
-    for (int i = 0; i < ldpc->n; i++) {
-        /* Positive LLR for bit 0, negative LLR for bit 1 */
-        ldpc->channel_llr[i] = (received[i] == 0) ? hard_llr_magnitude : -hard_llr_magnitude;
-    }
+    memset(result, 0, sizeof(LDPCSimulationResult));
     
-    /* Initialize variable-to-check messages with channel LLRs */
-    for (int v = 0; v < ldpc->n; v++) {
-        for (int e = 0; e < ldpc->var_degree[v]; e++) {
-            int edge_idx = v * ldpc->m + e;
-            if (edge_idx < ldpc->n * ldpc->m) {
-                ldpc->variable_to_check[edge_idx] = ldpc->channel_llr[v];
-            }
+    if (ldpc->backend == LDPC_BACKEND_CUDA) {
+        FSOErrorCode status = ldpc_cuda_simulate(ldpc, config, result);
+        if (status != FSO_ERROR_UNSUPPORTED) {
+            return status;
         }
     }
     
-    /* Initialize check-to-variable messages to zero */
-    memset(ldpc->check_to_variable, 0, ldpc->n * ldpc->m * sizeof(double));
+    const size_t chunk = FSO_MIN((size_t)LDPC_SIM_CHUNK, config->num_codewords);
+    float* llr = (float*)malloc(chunk * ldpc->n * sizeof(float));
+    uint8_t* decoded = (uint8_t*)malloc(chunk * ldpc->k);
+    int* iterations = (int*)malloc(chunk * sizeof(int));
+    int* converged = (int*)malloc(chunk * sizeof(int));
     
-    /* Belief propagation iterations */
-    int iteration;
-    int converged = 0;
+    if (!llr || !decoded || !iterations || !converged) {
+        free(llr);
+        free(decoded);
+        free(iterations);
+        free(converged);
+        FSO_LOG_ERROR(LDPC_MODULE, "Failed to allocate simulation buffers");
+        return FSO_ERROR_MEMORY;
+    }
     
-    for (iteration = 0; iteration < ldpc->max_iterations; iteration++) {
-        /* Update check-to-variable messages */
-        FSOErrorCode result = ldpc_update_check_messages(ldpc);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update check messages at iteration %d", iteration);
-            return result;
-        }
-        
-        /* Update variable-to-check messages */
-        result = ldpc_update_variable_messages(ldpc);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update variable messages at iteration %d", iteration);
-            return result;
-        }
-        
-        /* Update posterior LLRs and make hard decisions */
-        result = ldpc_update_posteriors(ldpc);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR(LDPC_MODULE, "Failed to update posteriors at iteration %d", iteration);
-            return result;
-        }
+    LDPCSimulationJob job = {
+        .ldpc = ldpc,
+        .config = config,
+        .llr = llr,
+        .sigma = sqrt(1.0 / (2.0 * ldpc->code_rate * fso_db_to_linear(config->ebn0_db)))
+    };
+    
+    FSOErrorCode status = FSO_SUCCESS;
+    for (size_t base = 0; base < config->num_codewords; base += chunk) {
+        size_t count = FSO_MIN(chunk, config->num_codewords - base);
         
-        /* Check for convergence (syndrome check) */
-        result = ldpc_calculate_syndrome(ldpc);
-        if (result != FSO_SUCCESS) {
-            FSO_LOG_ERROR(LDPC_MODULE, "Failed to calculate syndrome at iteration %d", iteration);
-            return result;
-        }
+        job.base = base;
+        fso_parallel_for(count, 16, 0, ldpc_simulate_channel, &job);
         
-        converged = ldpc_check_convergence(ldpc);
-        if (converged) {
-            FSO_LOG_DEBUG(LDPC_MODULE, "LDPC decoder converged at iteration %d", iteration + 1);
+        status = ldpc_decode_batch_soft(ldpc, llr, 1, count, decoded, iterations, converged);
+        if (status != FSO_SUCCESS) {
             break;
         }
-    }
-    
-    /* Extract decoded information bits (systematic part) */
-    for (int i = 0; i < ldpc->k; i++) {
-        decoded[i] = ldpc->decoded_bits[i];
-    }
-    
-    /* Calculate number of errors corrected */
-    if (errors_corrected) {
-        *errors_corrected = 0;
-        for (int i = 0; i < ldpc->k; i++) {
-            if (decoded[i] != received[i]) {
-                (*errors_corrected)++;
+        
+        for (size_t w = 0; w < count; w++) {
+            uint64_t errors = 0;
+            for (int i = 0; i < ldpc->k; i++) {
+                errors += decoded[w * ldpc->k + i];
             }
+            result->bit_errors += errors;
+            result->frame_errors += (errors > 0);
+            result->unconverged += !converged[w];
+            result->total_iterations += (uint64_t)iterations[w];
         }
+        result->codewords += count;
     }
     
-    if (!converged) {
-        FSO_LOG_WARNING(LDPC_MODULE, "LDPC decoder did not converge after %d iterations", 
-                       ldpc->max_iterations);
-    }
+    free(llr);
+    free(decoded);
+    free(iterations);
+    free(converged);
     
-    FSO_LOG_DEBUG(LDPC_MODULE, "LDPC decode completed: %d iterations, converged=%d, errors_corrected=%d",
-                 iteration + 1, converged, errors_corrected ? *errors_corrected : 0);
+    FSO_LOG_DEBUG(LDPC_MODULE, "Simulated %llu codewords at %.2f dB: %llu bit errors",
+                 (unsigned long long)result->codewords, config->ebn0_db,
+                 (unsigned long long)result->bit_errors);
     
-    return FSO_SUCCESS;
+    return status;
+}
+
+#ifndef FSO_ENABLE_CUDA
+/* Built without CUDA=1: the backend is never available */
+
+int ldpc_cuda_available(void)
+{
+    return 0;
+}
+
+FSOErrorCode ldpc_cuda_decode_batch(LDPCCodec* ldpc, const uint8_t* received,
+                                    const float* llr, size_t stride, size_t num_codewords,
+                                    uint8_t* decoded, int* iterations, int* converged)
+{
+    (void)ldpc;
+    (void)received;
+    (void)llr;
+    (void)stride;
+    (void)num_codewords;
+    (void)decoded;
+    (void)iterations;
+    (void)converged;
+    return FSO_ERROR_UNSUPPORTED;
+}
+
+FSOErrorCode ldpc_cuda_simulate(LDPCCodec* ldpc, const LDPCSimulationConfig* config,
+                                LDPCSimulationResult* result)
+{
+    (void)ldpc;
+    (void)config;
+    (void)result;
+    return FSO_ERROR_UNSUPPORTED;
+}
+
+void ldpc_cuda_release(LDPCCodec* ldpc)
+{
+    (void)ldpc;
 }
+#endif /* FSO_ENABLE_CUDA */
+
 /* 
 ============================================================================
  * Belief Propagation Functions
  * ============================================================================ */
 
-FSOErrorCode ldpc_update_check_messages(LDPCCodec* ldpc)
+/**
+ * @brief phi(x) = -log(tanh(x/2)) with guards for very small and large x
+ */
+static inline double ldpc_phi(double x)
 {
-    FSO_CHECK_NULL(ldpc);
-    FSO_CHECK_NULL(ldpc->check_to_var_edges);
-    FSO_CHECK_NULL(ldpc->variable_to_check);
-    FSO_CHECK_NULL(ldpc->check_to_variable);
+    if (x < 1e-10) {
+        /* For very small values, phi(x) ≈ -log(x/2) */
+        return 10.0; /* Large value to avoid log(0) */
+    }
+    if (x > 10.0) {
+        /* For large values, phi(x) ≈ exp(-|x|) */
+        return exp(-x);
+    }
+    
+    double tanh_val = tanh(x / 2.0);
+    return (tanh_val > 1e-10) ? -log(tanh_val) : 10.0;
+}
+
+/**
+ * @brief Inverse of phi (phi is self-inverse; kept separate for the guards)
+ */
+static inline double ldpc_phi_inverse(double sum_phi)
+{
+    if (sum_phi < 1e-10) {
+        return 10.0; /* Large LLR */
+    }
+    if (sum_phi > 10.0) {
+        return exp(-sum_phi);
+    }
     
-    /* Update messages from check nodes to variable nodes
-     * Using the sum-product algorithm (belief propagation)
+    double tanh_val = exp(-sum_phi);
+    return (tanh_val < 1.0 - 1e-10) ? 2.0 * atanh(tanh_val) : 10.0;
+}
+
+static void ldpc_check_update_sum_product(LDPCCodec* ldpc, int row_begin, int row_end)
+{
+    /* Sum-product (belief propagation) check node update
      * 
      * For each check node c and connected variable node v:
      * m_c->v = 2 * atanh( prod_{v' in N(c)\v} tanh(m_v'->c / 2) )
@@ -1062,95 +3527,141 @@ FSOErrorCode ldpc_update_check_messages(LDPCCodec* ldpc)
      * To avoid numerical issues, we use the log-domain representation:
      * m_c->v = sign * phi( sum_{v' in N(c)\v} phi(|m_v'->c|) )
      * where phi(x) = -log(tanh(x/2)) and sign is the product of signs
+     * 
+     * The row total is formed once and each edge's own term is removed
+     * afterwards, so phi is evaluated once per edge rather than once per
+     * edge pair. The row's output slice holds phi values between passes.
      */
     
-    for (int c = 0; c < ldpc->m; c++) {
-        int degree = ldpc->check_degree[c];
-        if (degree == 0) continue;
+    const int* row_ptr = ldpc->H->row_ptr;
+    const double* v2c = ldpc->variable_to_check;
+    double* c2v = ldpc->check_to_variable;
+    
+    for (int c = row_begin; c < row_end; c++) {
+        int edge_start = row_ptr[c];
+        int edge_end = row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
         
-        int* connected_vars = ldpc->check_to_var_edges[c];
+        double total_phi = 0.0;
+        int negative_count = 0;
         
-        /* For each variable node connected to this check node */
-        for (int e = 0; e < degree; e++) {
-            int v = connected_vars[e];
-            if (v >= ldpc->n) continue;
-            
-            /* Compute product of tanh values from all other variable nodes */
-            double product_sign = 1.0;
-            double sum_phi = 0.0;
+        for (int e = edge_start; e < edge_end; e++) {
+            double msg = v2c[e];
+            negative_count += (msg < 0.0);
+            c2v[e] = ldpc_phi(fabs(msg));
+            total_phi += c2v[e];
+        }
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            /* Extrinsic sign: parity of all other signs */
+            int negative = (negative_count - (v2c[e] < 0.0)) & 1;
+            double magnitude = ldpc_phi_inverse(total_phi - c2v[e]);
+            c2v[e] = negative ? -magnitude : magnitude;
+        }
+    }
+}
+
+static void ldpc_check_update_min_sum(LDPCCodec* ldpc, int row_begin, int row_end,
+                                      double scale, double offset)
+{
+    /* Min-sum check node update using the two-minimum single pass
+     * 
+     * m_c->v = prod_{v' in N(c)\v} sign(m_v'->c) * min_{v' in N(c)\v} |m_v'->c|
+     * 
+     * The extrinsic minimum is min1 for every edge except the one that
+     * produced min1, which receives min2. The magnitude is corrected by
+     * scale (normalized min-sum) and/or offset (offset min-sum).
+     */
+    
+    const int* row_ptr = ldpc->H->row_ptr;
+    const double* v2c = ldpc->variable_to_check;
+    double* c2v = ldpc->check_to_variable;
+    
+    for (int c = row_begin; c < row_end; c++) {
+        int edge_start = row_ptr[c];
+        int edge_end = row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
+        
+        double min1 = INFINITY;
+        double min2 = INFINITY;
+        int min1_edge = -1;
+        int negative_count = 0;
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            double msg = v2c[e];
+            double abs_msg = fabs(msg);
+            negative_count += (msg < 0.0);
             
-            for (int e2 = 0; e2 < degree; e2++) {
-                if (e2 == e) continue; /* Exclude current variable node */
-                
-                int v2 = connected_vars[e2];
-                if (v2 >= ldpc->n) continue;
-                
-                /* Get variable-to-check message */
-                int msg_idx = v2 * ldpc->m + c;
-                if (msg_idx >= ldpc->n * ldpc->m) continue;
-                
-                double msg = ldpc->variable_to_check[msg_idx];
-                
-                /* Track sign */
-                if (msg < 0.0) {
-                    product_sign *= -1.0;
-                }
-                
-                /* Compute phi function: phi(x) = -log(tanh(|x|/2))
-                 * For numerical stability, use approximation for small and large values */
-                double abs_msg = fabs(msg);
-                double phi_val;
-                
-                if (abs_msg < 1e-10) {
-                    /* For very small values, phi(x) ≈ -log(x/2) */
-                    phi_val = 10.0; /* Large value to avoid log(0) */
-                } else if (abs_msg > 10.0) {
-                    /* For large values, phi(x) ≈ exp(-|x|) */
-                    phi_val = exp(-abs_msg);
-                } else {
-                    /* General case: phi(x) = -log(tanh(x/2)) */
-                    double tanh_val = tanh(abs_msg / 2.0);
-                    if (tanh_val > 1e-10) {
-                        phi_val = -log(tanh_val);
-                    } else {
-                        phi_val = 10.0;
-                    }
-                }
-                
-                sum_phi += phi_val;
+            if (abs_msg < min1) {
+                min2 = min1;
+                min1 = abs_msg;
+                min1_edge = e;
+            } else if (abs_msg < min2) {
+                min2 = abs_msg;
             }
+        }
+        
+        /* Degree-1 checks carry no extrinsic information */
+        if (edge_end - edge_start == 1) {
+            min2 = 0.0;
+        }
+        
+        double mag1 = FSO_MAX(min1 * scale - offset, 0.0);
+        double mag2 = FSO_MAX(min2 * scale - offset, 0.0);
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            int negative = (negative_count - (v2c[e] < 0.0)) & 1;
+            double magnitude = (e == min1_edge) ? mag2 : mag1;
+            c2v[e] = negative ? -magnitude : magnitude;
+        }
+    }
+}
+
+/**
+ * @brief Run the configured check-node kernel over rows [row_begin, row_end)
+ */
+static FSOErrorCode ldpc_check_update_rows(LDPCCodec* ldpc, int row_begin, int row_end)
+{
+    switch (ldpc->check_node_algorithm) {
+        case LDPC_CHECK_SUM_PRODUCT:
+            ldpc_check_update_sum_product(ldpc, row_begin, row_end);
+            break;
             
-            /* Compute check-to-variable message using inverse phi function
-             * phi^(-1)(x) = phi(x) since phi is self-inverse */
-            double msg_magnitude;
-            if (sum_phi < 1e-10) {
-                msg_magnitude = 10.0; /* Large LLR */
-            } else if (sum_phi > 10.0) {
-                msg_magnitude = exp(-sum_phi);
-            } else {
-                double tanh_val = exp(-sum_phi);
-                if (tanh_val < 1.0 - 1e-10) {
-                    msg_magnitude = 2.0 * atanh(tanh_val);
-                } else {
-                    msg_magnitude = 10.0;
-                }
-            }
+        case LDPC_CHECK_NORMALIZED_MIN_SUM:
+            ldpc_check_update_min_sum(ldpc, row_begin, row_end, ldpc->min_sum_scale, 0.0);
+            break;
             
-            /* Apply sign and store message */
-            int msg_idx = c * ldpc->n + v;
-            if (msg_idx < ldpc->n * ldpc->m) {
-                ldpc->check_to_variable[msg_idx] = product_sign * msg_magnitude;
-            }
-        }
+        case LDPC_CHECK_OFFSET_MIN_SUM:
+            ldpc_check_update_min_sum(ldpc, row_begin, row_end, 1.0, ldpc->min_sum_offset);
+            break;
+            
+        default:
+            FSO_LOG_ERROR(LDPC_MODULE, "Unsupported check node algorithm: %d",
+                         ldpc->check_node_algorithm);
+            return FSO_ERROR_UNSUPPORTED;
     }
     
     return FSO_SUCCESS;
 }
 
+FSOErrorCode ldpc_update_check_messages(LDPCCodec* ldpc)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(ldpc->H);
+    FSO_CHECK_NULL(ldpc->variable_to_check);
+    FSO_CHECK_NULL(ldpc->check_to_variable);
+    
+    /* Update messages from check nodes to variable nodes. The edges of a
+     * check node are contiguous in both message arrays, so every kernel
+     * only touches the row's slice of memory. */
+    return ldpc_check_update_rows(ldpc, 0, ldpc->m);
+}
+
 FSOErrorCode ldpc_update_variable_messages(LDPCCodec* ldpc)
 {
     FSO_CHECK_NULL(ldpc);
-    FSO_CHECK_NULL(ldpc->var_to_check_edges);
+    FSO_CHECK_NULL(ldpc->var_edge_ptr);
+    FSO_CHECK_NULL(ldpc->var_edge_index);
     FSO_CHECK_NULL(ldpc->variable_to_check);
     FSO_CHECK_NULL(ldpc->check_to_variable);
     FSO_CHECK_NULL(ldpc->channel_llr);
@@ -1160,42 +3671,29 @@ FSOErrorCode ldpc_update_variable_messages(LDPCCodec* ldpc)
      * For each variable node v and connected check node c:
      * m_v->c = m_channel_v + sum_{c' in N(v)\c} m_c'->v
      * 
-     * This is simply the sum of the channel LLR and all incoming
-     * check-to-variable messages except from the target check node.
+     * This is the full sum at v minus the message received from c, which
+     * makes the update O(degree) per variable node instead of O(degree^2).
      */
     
+    const int* edge_ptr = ldpc->var_edge_ptr;
+    const int* edge_index = ldpc->var_edge_index;
+    const double* c2v = ldpc->check_to_variable;
+    double* v2c = ldpc->variable_to_check;
+    
     for (int v = 0; v < ldpc->n; v++) {
-        int degree = ldpc->var_degree[v];
-        if (degree == 0) continue;
+        int start = edge_ptr[v];
+        int end = edge_ptr[v + 1];
         
-        int* connected_checks = ldpc->var_to_check_edges[v];
+        /* Sum channel LLR and all incoming check-to-variable messages */
+        double total = ldpc->channel_llr[v];
+        for (int s = start; s < end; s++) {
+            total += c2v[edge_index[s]];
+        }
         
-        /* For each check node connected to this variable node */
-        for (int e = 0; e < degree; e++) {
-            int c = connected_checks[e];
-            if (c >= ldpc->m) continue;
-            
-            /* Sum channel LLR and all check-to-variable messages except from c */
-            double msg_sum = ldpc->channel_llr[v];
-            
-            for (int e2 = 0; e2 < degree; e2++) {
-                if (e2 == e) continue; /* Exclude current check node */
-                
-                int c2 = connected_checks[e2];
-                if (c2 >= ldpc->m) continue;
-                
-                /* Get check-to-variable message */
-                int msg_idx = c2 * ldpc->n + v;
-                if (msg_idx < ldpc->n * ldpc->m) {
-                    msg_sum += ldpc->check_to_variable[msg_idx];
-                }
-            }
-            
-            /* Store variable-to-check message */
-            int msg_idx = v * ldpc->m + e;
-            if (msg_idx < ldpc->n * ldpc->m) {
-                ldpc->variable_to_check[msg_idx] = msg_sum;
-            }
+        /* Store extrinsic variable-to-check messages */
+        for (int s = start; s < end; s++) {
+            int e = edge_index[s];
+            v2c[e] = total - c2v[e];
         }
     }
     
@@ -1205,7 +3703,8 @@ FSOErrorCode ldpc_update_variable_messages(LDPCCodec* ldpc)
 FSOErrorCode ldpc_update_posteriors(LDPCCodec* ldpc)
 {
     FSO_CHECK_NULL(ldpc);
-    FSO_CHECK_NULL(ldpc->var_to_check_edges);
+    FSO_CHECK_NULL(ldpc->var_edge_ptr);
+    FSO_CHECK_NULL(ldpc->var_edge_index);
     FSO_CHECK_NULL(ldpc->check_to_variable);
     FSO_CHECK_NULL(ldpc->channel_llr);
     FSO_CHECK_NULL(ldpc->posterior_llr);
@@ -1220,25 +3719,17 @@ FSOErrorCode ldpc_update_posteriors(LDPCCodec* ldpc)
      * incoming check-to-variable messages.
      */
     
+    const int* edge_ptr = ldpc->var_edge_ptr;
+    const int* edge_index = ldpc->var_edge_index;
+    const double* c2v = ldpc->check_to_variable;
+    
     for (int v = 0; v < ldpc->n; v++) {
         /* Start with channel LLR */
         double posterior = ldpc->channel_llr[v];
         
         /* Add all check-to-variable messages */
-        int degree = ldpc->var_degree[v];
-        if (degree > 0 && ldpc->var_to_check_edges[v]) {
-            int* connected_checks = ldpc->var_to_check_edges[v];
-            
-            for (int e = 0; e < degree; e++) {
-                int c = connected_checks[e];
-                if (c >= ldpc->m) continue;
-                
-                /* Get check-to-variable message */
-                int msg_idx = c * ldpc->n + v;
-                if (msg_idx < ldpc->n * ldpc->m) {
-                    posterior += ldpc->check_to_variable[msg_idx];
-                }
-            }
+        for (int s = edge_ptr[v]; s < edge_ptr[v + 1]; s++) {
+            posterior += c2v[edge_index[s]];
         }
         
         /* Store posterior LLR */
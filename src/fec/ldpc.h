@@ -20,6 +20,16 @@
 #define LDPC_MAX_CODE_LENGTH 8192        /**< Maximum code length */
 #define LDPC_MAX_ITERATIONS 100          /**< Maximum decoding iterations */
 #define LDPC_DEFAULT_CONVERGENCE_THRESHOLD 1e-6  /**< Default convergence threshold */
+#define LDPC_DEFAULT_MIN_SUM_SCALE 0.75  /**< Default normalized min-sum factor */
+#define LDPC_DEFAULT_MIN_SUM_OFFSET 0.5  /**< Default offset min-sum correction */
+#define LDPC_BATCH_LANES 16              /**< Codewords decoded side by side by ldpc_decode_batch */
+#define LDPC_FIXED_LLR_SCALE 4.0         /**< Fixed-point steps per unit LLR (batch decoder) */
+#define LDPC_PARITY_WORD_ALIGN 4         /**< Packed parity rows are padded to 4 words (256 bits) */
+#define LDPC_QC_MIN_BASE_ROWS 3          /**< Smallest base graph parity part (dual-diagonal) */
+#define LDPC_QC_INFO_DEGREE 3            /**< Circulants per information column of a QC base graph */
+#define LDPC_CUDA_CHUNK 2048             /**< Codewords per CUDA kernel launch (and device buffer set) */
+#define LDPC_CUDA_MIN_BATCH 256          /**< Smaller batches stay on the CPU even with the CUDA backend */
+#define LDPC_SIM_CHUNK 1024              /**< Codewords generated and decoded together by ldpc_simulate */
 
 /* Standard LDPC code rates */
 #define LDPC_RATE_1_2 0.5               /**< Code rate 1/2 */
@@ -57,6 +67,36 @@ typedef struct {
     int* values;                /**< Values array (CSR format) */
 } SparseMatrix;
 
+/**
+ * @brief Immutable code structure shared between codecs
+ * 
+ * Built once per (n, k, code rate, seed) and kept by the process-wide
+ * graph cache. Codecs holding a reference point their H, G, parity rows
+ * and edge index arrays into the graph instead of owning copies.
+ */
+typedef struct LDPCGraph {
+    int n;                      /**< Code length */
+    int k;                      /**< Information bits */
+    double code_rate;           /**< Code rate used to pick the degree profile */
+    unsigned int seed;          /**< Construction seed (0 = structured) */
+    int lifting_size;           /**< QC lifting size (0 = unstructured) */
+    int refcount;               /**< Codecs currently attached */
+    
+    SparseMatrix* H;            /**< Parity-check matrix */
+    SparseMatrix* G;            /**< Generator matrix (empty for QC codes) */
+    int16_t* qc_shifts;         /**< QC base graph shift table, or NULL */
+    uint64_t* parity_rows;      /**< Packed parity part of G */
+    int parity_words;           /**< Words per packed parity row */
+    int num_edges;              /**< Edges in the Tanner graph */
+    int* var_degree;            /**< Degree of each variable node */
+    int* check_degree;          /**< Degree of each check node */
+    int* var_edge_ptr;          /**< Variable-view row pointer */
+    int* var_edge_index;        /**< Variable-view to check-view edge permutation */
+    int* edge_check;            /**< Check node of each edge */
+    
+    struct LDPCGraph* next;     /**< Next cache entry */
+} LDPCGraph;
+
 /**
  * @brief LDPC codec state
  * 
@@ -75,23 +115,63 @@ typedef struct {
     /* Generator matrix (for systematic encoding) */
     SparseMatrix* G;            /**< Generator matrix */
     
+    /* Shared code structure (NULL when the codec owns H, G and the edge arrays) */
+    LDPCGraph* graph;           /**< Cache entry this codec is attached to */
+    unsigned int matrix_seed;   /**< Seed for the random H construction (0 = structured) */
+    
+    /* Quasi-cyclic structure (lifting_size > 0). H is a base_rows x base_cols
+     * array of Z x Z blocks; a block with shift s has the 1 of its row r in
+     * column (r + s) mod Z, and shift -1 marks an all-zero block. The last
+     * base_rows columns are the dual-diagonal parity part, so encoding runs
+     * from the shift table and G / parity_rows are never built. */
+    int lifting_size;           /**< Lifting size Z (0 = unstructured H) */
+    int base_rows;              /**< Base graph rows (m / Z) */
+    int base_cols;              /**< Base graph columns (n / Z) */
+    int16_t* qc_shifts;         /**< Shift of block (i, j) at [i * base_cols + j] */
+    uint8_t* qc_encode_work;    /**< Encoder row sums and unpacked codeword (m + n bytes) */
+    double* qc_row_work;        /**< Layered decoder row statistics (3 * Z) */
+    
+    /* Packed parity part of G: bit j of information row i (parity bit j,
+     * codeword column k + j) is bit j % 64 of parity_rows[i * parity_words + j / 64] */
+    uint64_t* parity_rows;      /**< Parity rows as 64-bit words (k rows) */
+    uint64_t* parity_accum;     /**< Encoder accumulator (parity_words words) */
+    int parity_words;           /**< Words per parity row (multiple of LDPC_PARITY_WORD_ALIGN) */
+    
     /* Decoding parameters */
     int max_iterations;         /**< Maximum decoding iterations */
     double convergence_threshold; /**< Convergence threshold */
+    LDPCCheckNodeAlgorithm check_node_algorithm; /**< Check-node update rule */
+    double min_sum_scale;       /**< Normalized min-sum factor */
+    double min_sum_offset;      /**< Offset min-sum correction */
+    LDPCSchedule schedule;      /**< Message-passing schedule */
+    int layer_size;             /**< Check rows per layer (layered schedule) */
+    int last_iterations;        /**< Iterations used by the most recent decode */
+    int last_converged;         /**< 1 if the most recent decode satisfied all checks */
+    LDPCLLRFormat llr_format;   /**< Message format for batched decoding */
+    void* batch_workspace;      /**< Per-worker lane-interleaved batch buffers (allocated on first use) */
+    LDPCBackend backend;        /**< Batch decode backend (CPU unless CUDA is built in and present) */
+    void* device;               /**< CUDA state: device graph, streams, pinned buffers (first use) */
     
-    /* Workspace for decoding */
-    double* variable_to_check;  /**< Variable-to-check messages */
-    double* check_to_variable;  /**< Check-to-variable messages */
+    /* Workspace for decoding (messages are stored per edge, in H CSR order) */
+    double* variable_to_check;  /**< Variable-to-check messages (num_edges) */
+    double* check_to_variable;  /**< Check-to-variable messages (num_edges) */
     double* posterior_llr;      /**< Posterior log-likelihood ratios */
     double* channel_llr;        /**< Channel log-likelihood ratios */
     int* decoded_bits;          /**< Decoded bit estimates */
     int* syndrome;              /**< Syndrome vector */
     
-    /* Message passing graph connectivity */
+    /* Message passing graph connectivity
+     * 
+     * Edge e (0 <= e < num_edges) is the e-th non-zero of H in CSR order, so
+     * the edges of check c are H->row_ptr[c] .. H->row_ptr[c+1]-1 and the
+     * variable of edge e is H->col_indices[e]. The variable view is a second
+     * CSR index whose entries are permuted edge ids into the check view. */
+    int num_edges;              /**< Number of edges in the Tanner graph (nnz of H) */
     int* var_degree;            /**< Degree of each variable node */
     int* check_degree;          /**< Degree of each check node */
-    int** var_to_check_edges;   /**< Variable-to-check edge lists */
-    int** check_to_var_edges;   /**< Check-to-variable edge lists */
+    int* var_edge_ptr;          /**< Variable-view row pointer (n + 1 entries) */
+    int* var_edge_index;        /**< Variable-view to check-view edge permutation */
+    int* edge_check;            /**< Check node of each edge (num_edges) */
 } LDPCCodec;
 
 /* ============================================================================
@@ -121,7 +201,10 @@ FSOErrorCode ldpc_free(LDPCCodec* ldpc);
  * @brief Generate standard LDPC parity-check matrix
  * 
  * Creates a standard LDPC parity-check matrix for the specified code rate.
- * Uses structured construction for common rates (1/2, 2/3, 3/4, 5/6).
+ * Uses structured construction for common rates (1/2, 2/3, 3/4, 5/6),
+ * or a seeded random regular construction when ldpc->matrix_seed is set.
+ * With ldpc->lifting_size set, builds a quasi-cyclic base graph instead
+ * (see ldpc_create_qc_base_graph()) and expands it into H.
  * 
  * @param ldpc Pointer to LDPC codec
  * @param code_rate Desired code rate
@@ -133,7 +216,8 @@ FSOErrorCode ldpc_generate_standard_matrix(LDPCCodec* ldpc, double code_rate);
  * @brief Generate generator matrix from parity-check matrix
  * 
  * Computes the systematic generator matrix G from the parity-check matrix H
- * using Gaussian elimination to put H in systematic form [P | I].
+ * using Gaussian elimination to put H in systematic form [P | I]. QC codes
+ * encode from the base graph, so for them this does nothing.
  * 
  * @param ldpc Pointer to LDPC codec
  * @return FSO_SUCCESS on success, error code on failure
@@ -145,6 +229,8 @@ FSOErrorCode ldpc_generate_generator_matrix(LDPCCodec* ldpc);
  * 
  * Performs systematic LDPC encoding using the generator matrix.
  * The encoded output contains the information bits followed by parity bits.
+ * Input and output hold one bit per byte. QC codes solve the dual-diagonal
+ * parity part block by block instead, in O(edges) with no G.
  * 
  * @param ldpc Pointer to LDPC codec
  * @param data Input data bits
@@ -156,12 +242,53 @@ FSOErrorCode ldpc_generate_generator_matrix(LDPCCodec* ldpc);
 FSOErrorCode ldpc_encode(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
                          uint8_t* encoded, size_t* encoded_len);
 
+/**
+ * @brief Encode packed data using LDPC
+ * 
+ * Same code as ldpc_encode(), but input and output are packed eight bits
+ * per byte, most significant bit first. Parity is accumulated by XORing
+ * whole 64-bit parity rows (256-bit with AVX2) under a mask taken from
+ * each information bit, so the loop has no data-dependent branches.
+ * 
+ * @param ldpc Pointer to LDPC codec
+ * @param data Packed information bits ((k + 7) / 8 bytes)
+ * @param data_len Length of input data in bytes
+ * @param encoded Output packed codeword ((n + 7) / 8 bytes)
+ * @param encoded_len Length of output buffer in bytes (updated on return)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_encode_packed(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
+                                uint8_t* encoded, size_t* encoded_len);
+
+/**
+ * @brief Transmission order of a rate-compatible puncturing family
+ * 
+ * Lists all n codeword positions: the k information bits first, then the
+ * parity bits in a golden-ratio stride through [k, n). Sending the first
+ * n' positions of the order gives a punctured code of rate k/n' for any
+ * k <= n' <= n, and every shorter prefix is contained in every longer
+ * one, so retransmissions can send the next part of the order as
+ * incremental redundancy. The stride spreads each prefix evenly over the
+ * parity checks, which keeps heavily punctured codes decodable.
+ * 
+ * @param ldpc Pointer to initialized LDPC codec
+ * @param order Output codeword positions (n entries)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_rate_compatible_order(const LDPCCodec* ldpc, int* order);
+
 /**
  * @brief Decode received codeword using belief propagation
  * 
  * Performs LDPC decoding using the sum-product algorithm (belief propagation).
  * Iteratively exchanges messages between variable and check nodes until
- * convergence or maximum iterations reached.
+ * convergence or maximum iterations reached. Received words that already
+ * satisfy every parity check return without iterating. The number of
+ * iterations used is left in ldpc->last_iterations.
+ * 
+ * QC codes always use the layered schedule with one base row (Z checks
+ * sharing no variable) per layer: each circulant's Z messages are loaded
+ * by a cyclic shift of the posteriors and updated in one vector loop.
  * 
  * @param ldpc Pointer to LDPC codec
  * @param received Received codeword (may contain errors)
@@ -174,6 +301,259 @@ FSOErrorCode ldpc_encode(LDPCCodec* ldpc, const uint8_t* data, size_t data_len,
 FSOErrorCode ldpc_decode(LDPCCodec* ldpc, const uint8_t* received, size_t received_len,
                          uint8_t* decoded, size_t decoded_len, int* errors_corrected);
 
+/**
+ * @brief Decode LDPC codeword from channel log-likelihood ratios
+ * 
+ * Same decoder as ldpc_decode(), but the channel LLRs (positive for bit 0)
+ * are taken directly from the demodulator instead of being rebuilt from
+ * hard bits with a fixed magnitude. The LLR of code bit i is
+ * llr[i * stride].
+ * 
+ * @param ldpc Pointer to LDPC codec
+ * @param llr Channel LLRs
+ * @param stride Distance between consecutive code-bit LLRs (1 = dense)
+ * @param decoded Output decoded data (one bit per byte)
+ * @param decoded_len Length of output buffer
+ * @param errors_corrected Pointer to store the number of information bits
+ *        that differ from the channel hard decisions (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_decode_soft(LDPCCodec* ldpc, const float* llr, size_t stride,
+                              uint8_t* decoded, size_t decoded_len, int* errors_corrected);
+
+/**
+ * @brief Decode several codewords at once with inter-codeword SIMD lanes
+ * 
+ * All words share the codec's parity-check graph, so their messages are
+ * stored lane-interleaved (LDPC_BATCH_LANES codewords per edge) and every
+ * node update runs across the lanes in one vectorizable loop. The batch
+ * is processed in groups of LDPC_BATCH_LANES; a short final group is
+ * padded with all-zero words. Each lane stops contributing once its
+ * syndrome is zero. Messages use ldpc->llr_format. Groups are spread
+ * over the shared worker pool, each worker with its own workspace.
+ * 
+ * @param ldpc Pointer to LDPC codec
+ * @param received Received hard bits (num_codewords * n, back to back)
+ * @param num_codewords Number of codewords
+ * @param decoded Output information bits (num_codewords * k)
+ * @param iterations Optional per-codeword iterations used (can be NULL)
+ * @param converged Optional per-codeword convergence flags (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_decode_batch(LDPCCodec* ldpc, const uint8_t* received, size_t num_codewords,
+                               uint8_t* decoded, int* iterations, int* converged);
+
+/**
+ * @brief Soft-input counterpart of ldpc_decode_batch()
+ * 
+ * With a fixed-point ldpc->llr_format the channel LLRs are quantized to
+ * LDPC_FIXED_LLR_SCALE steps per unit and saturated to
+ * ldpc_fixed_llr_limit() before decoding, so the whole message path runs
+ * in integers.
+ * 
+ * @param ldpc Pointer to LDPC codec
+ * @param llr Channel LLRs; bit v of codeword w is llr[(w * n + v) * stride]
+ * @param stride Distance between consecutive code-bit LLRs (1 = dense)
+ * @param num_codewords Number of codewords
+ * @param decoded Output information bits (num_codewords * k)
+ * @param iterations Optional per-codeword iterations used (can be NULL)
+ * @param converged Optional per-codeword convergence flags (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_decode_batch_soft(LDPCCodec* ldpc, const float* llr, size_t stride,
+                                    size_t num_codewords, uint8_t* decoded,
+                                    int* iterations, int* converged);
+
+/**
+ * @brief Saturation limit of fixed-point batch messages, in LLR steps
+ * 
+ * 127 for LDPC_LLR_INT8. For LDPC_LLR_INT16 it is INT16_MAX divided by
+ * the largest variable degree plus one (8191 for degree 3), so a
+ * posterior (channel LLR plus every incoming message) always fits in
+ * int16_t and the layered update never loses the message it subtracts.
+ * 
+ * @param ldpc Pointer to LDPC codec with its code generated
+ * @return Limit in LDPC_FIXED_LLR_SCALE steps
+ */
+int ldpc_fixed_llr_limit(const LDPCCodec* ldpc);
+
+/**
+ * @brief Build a quasi-cyclic base graph with a dual-diagonal parity part
+ * 
+ * Fills ldpc->qc_shifts (base_rows x base_cols) in the IEEE 802.11n
+ * layout: parity column 0 has shift 1 in the first and last rows and
+ * shift 0 in the middle row, and parity column c > 0 has shift 0 in rows
+ * c - 1 and c. Every information column gets LDPC_QC_INFO_DEGREE
+ * circulants in the least-loaded rows, with seeded shifts that avoid
+ * 4-cycles whenever Z allows it.
+ * 
+ * @param ldpc Pointer to LDPC codec with lifting_size, base_rows and base_cols set
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_create_qc_base_graph(LDPCCodec* ldpc);
+
+/* ============================================================================
+ * Monte Carlo and GPU Backend
+ * ============================================================================ */
+
+/**
+ * @brief Coded BER run for ldpc_simulate()
+ * 
+ * BPSK over AWGN with optional log-normal block fading (one intensity
+ * draw per codeword, unit mean). The decoders are symmetric, so the
+ * all-zero codeword is sent and nothing but error counts leaves the
+ * decoder.
+ */
+typedef struct {
+    double ebn0_db;             /**< Eb/N0 per information bit (dB) */
+    double scintillation_index; /**< Fading scintillation index (0 = AWGN only) */
+    size_t num_codewords;       /**< Codewords to simulate */
+    uint64_t seed;              /**< Run seed; codeword w draws from Philox packet w */
+} LDPCSimulationConfig;
+
+/**
+ * @brief Error counts from ldpc_simulate()
+ */
+typedef struct {
+    uint64_t codewords;         /**< Codewords decoded */
+    uint64_t bit_errors;        /**< Information bit errors */
+    uint64_t frame_errors;      /**< Codewords with at least one information bit error */
+    uint64_t unconverged;       /**< Codewords that never satisfied every check */
+    uint64_t total_iterations;  /**< Sum of iterations over all codewords */
+} LDPCSimulationResult;
+
+/**
+ * @brief Monte Carlo coded BER with the batched decoder
+ * 
+ * Channel LLRs 2*h*y/sigma^2 are drawn per codeword from the
+ * FSO_RNG_STREAM_CHANNEL (fade) and FSO_RNG_STREAM_NOISE (Box-Muller
+ * noise) streams of (seed, codeword), so counts do not depend on chunking
+ * or thread count. With LDPC_BACKEND_CUDA the samples are generated on the
+ * device and only the counts cross PCIe; the CPU and GPU draw the same
+ * Philox words, with noise equal up to the last bits of log/sin/cos.
+ * 
+ * @param ldpc Pointer to LDPC codec with its code generated
+ * @param config Run parameters
+ * @param result Output counts
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_simulate(LDPCCodec* ldpc, const LDPCSimulationConfig* config,
+                           LDPCSimulationResult* result);
+
+/**
+ * @brief Number of CUDA devices usable by the backend
+ * 
+ * @return Device count, or 0 when built without CUDA=1 or none is present
+ */
+int ldpc_cuda_available(void);
+
+/**
+ * @brief Batch decode on the GPU (LDPC_BACKEND_CUDA)
+ * 
+ * The CSR H is uploaded once and stays resident until the codec is freed
+ * or its graph rebuilt. Codewords go through in LDPC_CUDA_CHUNK launches,
+ * one thread each, alternating between two streams and two pinned staging
+ * sets so copies overlap the other chunk's kernel. Each thread runs the
+ * CPU batch decoder's lane arithmetic, so decisions, iteration counts and
+ * convergence flags are bit-identical to ldpc_decode_batch() and
+ * ldpc_decode_batch_soft() for the same llr_format.
+ * 
+ * Returns FSO_ERROR_UNSUPPORTED, and the caller decodes on the CPU, for
+ * float sum-product (its transcendental check update would not match),
+ * for builds without CUDA and when device setup or a launch fails.
+ * 
+ * @param ldpc Pointer to LDPC codec
+ * @param received Hard input (num_codewords * n), or NULL with llr
+ * @param llr Soft input as for ldpc_decode_batch_soft(), or NULL
+ * @param stride LLR stride
+ * @param num_codewords Number of codewords
+ * @param decoded Output information bits (num_codewords * k)
+ * @param iterations Optional per-codeword iterations used (can be NULL)
+ * @param converged Optional per-codeword convergence flags (can be NULL)
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_cuda_decode_batch(LDPCCodec* ldpc, const uint8_t* received,
+                                    const float* llr, size_t stride, size_t num_codewords,
+                                    uint8_t* decoded, int* iterations, int* converged);
+
+/**
+ * @brief GPU ldpc_simulate(): noise, decoding and counting on the device
+ * 
+ * @return FSO_ERROR_UNSUPPORTED when the configuration cannot run on the GPU
+ */
+FSOErrorCode ldpc_cuda_simulate(LDPCCodec* ldpc, const LDPCSimulationConfig* config,
+                                LDPCSimulationResult* result);
+
+/**
+ * @brief Free the codec's device graph, streams and buffers (no-op without CUDA)
+ * 
+ * @param ldpc Pointer to LDPC codec
+ */
+void ldpc_cuda_release(LDPCCodec* ldpc);
+
+/* ============================================================================
+ * Code Construction Cache
+ * ============================================================================ */
+
+/**
+ * @brief Set up the standard code for a codec, sharing it when possible
+ * 
+ * Looks up (n, k, code_rate, matrix_seed, lifting_size) in the process-wide graph cache
+ * and attaches the codec to an existing entry. On a miss the matrices are
+ * loaded from the dump directory (if one is set and holds a matching
+ * file) or built with ldpc_generate_standard_matrix() and
+ * ldpc_generate_generator_matrix(), then published to the cache and
+ * written to the dump directory. QC codes are cheap to build and have no
+ * G, so they are never dumped. Cache entries outlive their codecs until
+ * ldpc_graph_cache_clear().
+ * 
+ * @param ldpc Pointer to initialized LDPC codec
+ * @param code_rate Code rate used to select the degree profile
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_acquire_standard_code(LDPCCodec* ldpc, double code_rate);
+
+/**
+ * @brief Release cache entries that no codec references
+ * 
+ * @return Number of entries still in use
+ */
+int ldpc_graph_cache_clear(void);
+
+/**
+ * @brief Set the directory used for on-disk matrix dumps
+ * 
+ * @param directory Existing directory, or NULL to disable dumps
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_graph_cache_set_directory(const char* directory);
+
+/**
+ * @brief Write a codec's H and packed generator rows to a binary file
+ * 
+ * The file stores native-endian integers: a header (magic, version, n, k,
+ * seed, code rate, nnz, parity words), followed by the CSR row pointer and
+ * column indices of H and the packed parity rows.
+ * 
+ * @param ldpc Pointer to LDPC codec with H and G generated
+ * @param path Output file path
+ * @return FSO_SUCCESS on success, error code on failure
+ */
+FSOErrorCode ldpc_save_code(const LDPCCodec* ldpc, const char* path);
+
+/**
+ * @brief Load H and the packed generator rows written by ldpc_save_code()
+ * 
+ * Rebuilds the sparse G and the message-passing graph without Gaussian
+ * elimination.
+ * 
+ * @param ldpc Pointer to initialized LDPC codec (dimensions must match)
+ * @param path Input file path
+ * @return FSO_SUCCESS on success, FSO_ERROR_IO if the file is missing or
+ *         does not match the codec
+ */
+FSOErrorCode ldpc_load_code(LDPCCodec* ldpc, const char* path);
+
 /* ============================================================================
  * Sparse Matrix Functions
  * ============================================================================ */
@@ -247,7 +627,8 @@ FSOErrorCode sparse_matrix_vector_multiply(const SparseMatrix* matrix,
  * @brief Initialize message passing graph
  * 
  * Sets up the connectivity information for variable and check nodes
- * based on the parity-check matrix structure.
+ * based on the parity-check matrix structure, and allocates the per-edge
+ * message arrays. H must already be in CSR format.
  * 
  * @param ldpc Pointer to LDPC codec
  * @return FSO_SUCCESS on success, error code on failure
@@ -269,7 +650,8 @@ FSOErrorCode ldpc_update_variable_messages(LDPCCodec* ldpc);
  * @brief Update check-to-variable messages
  * 
  * Computes messages sent from check nodes to variable nodes
- * in the belief propagation algorithm.
+ * in the belief propagation algorithm, using the check-node rule
+ * selected by LDPCConfig.check_node_algorithm.
  * 
  * @param ldpc Pointer to LDPC codec
  * @return FSO_SUCCESS on success, error code on failure
@@ -347,6 +729,14 @@ FSOErrorCode ldpc_validate_config(const LDPCConfig* config, int n, int k);
  */
 int ldpc_estimate_min_distance(const LDPCCodec* ldpc);
 
+/**
+ * @brief Get human-readable name of a check-node algorithm
+ * 
+ * @param algorithm Check-node algorithm
+ * @return Constant string name
+ */
+const char* ldpc_check_node_algorithm_string(LDPCCheckNodeAlgorithm algorithm);
+
 /**
  * @brief Convert soft bits to hard bits
  * 
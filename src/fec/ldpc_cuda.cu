@@ -0,0 +1,864 @@
+/**
+ * @file ldpc_cuda.cu
+ * @brief CUDA backend for batched LDPC decoding and Monte Carlo runs
+ *
+ * Compiled only with make CUDA=1 (FSO_ENABLE_CUDA); ldpc.c supplies
+ * stubs otherwise. One thread owns one codeword and runs the per-lane
+ * arithmetic of ldpc_batch_iterate_float() / ldpc_batch_iterate_fixed(),
+ * so the GPU reproduces the CPU decisions bit for bit. Device arrays are
+ * codeword-minor ([node * capacity + w]) so neighbouring threads touch
+ * neighbouring addresses.
+ */
+
+extern "C" {
+#include "ldpc.h"
+}
+
+#include <cuda_runtime.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LDPC_MODULE "LDPC"
+
+#define LDPC_CUDA_THREADS 128           /* Codewords per thread block */
+#define LDPC_CUDA_STREAMS 2             /* Chunks in flight (double buffering) */
+#define LDPC_CUDA_COUNTERS 4            /* Simulation counters per chunk */
+
+/* ============================================================================
+ * Device State
+ * ============================================================================ */
+
+/**
+ * @brief One chunk's device buffers, pinned staging and stream
+ */
+typedef struct {
+    cudaStream_t stream;
+    void* channel;                      /* Channel LLRs (n * capacity) */
+    void* posterior;                    /* Posteriors (n * capacity) */
+    void* posterior_next;               /* Flooding accumulator (n * capacity) */
+    void* v2c;                          /* Variable-to-check messages (num_edges * capacity) */
+    void* c2v;                          /* Check-to-variable messages (num_edges * capacity) */
+    uint8_t* hard;                      /* Hard decisions (n * capacity) */
+    void* input;                        /* Received bits or LLRs, codeword-major */
+    uint8_t* decoded;                   /* Information bits, codeword-major */
+    int* iterations;
+    int* converged;
+    unsigned long long* counters;       /* Simulation error counts */
+    
+    void* host_input;                   /* Pinned staging */
+    uint8_t* host_decoded;
+    int* host_iterations;
+    int* host_converged;
+    unsigned long long* host_counters;
+    
+    size_t base;                        /* First codeword of the chunk in flight */
+    size_t count;                       /* Codewords in flight (0 = idle) */
+} LDPCCudaSet;
+
+/**
+ * @brief Per-codec device context (ldpc->device)
+ */
+typedef struct {
+    LDPCLLRFormat format;               /* Message format the buffers were sized for */
+    size_t capacity;                    /* Codewords per chunk */
+    int* row_ptr;                       /* Resident CSR H */
+    int* col_indices;
+    LDPCCudaSet sets[LDPC_CUDA_STREAMS];
+} LDPCCudaContext;
+
+/**
+ * @brief Kernel arguments (passed by value)
+ */
+typedef struct {
+    const int* row_ptr;
+    const int* col_indices;
+    int n;
+    int k;
+    int m;
+    int max_iterations;
+    int layered;
+    int soft;                           /* Input holds float LLRs rather than bits */
+    size_t capacity;
+    
+    float scale;                        /* Float min-sum correction */
+    float offset;
+    int32_t scale_q8;                   /* Fixed-point min-sum correction */
+    int32_t offset_q;
+    int32_t limit;                      /* Message saturation */
+    int16_t hard_fixed;                 /* Fixed-point magnitude of a hard input bit */
+    
+    void* channel;
+    void* posterior;
+    void* posterior_next;
+    void* v2c;
+    void* c2v;
+    uint8_t* hard;
+    const void* input;
+    uint8_t* decoded;
+    int* iterations;
+    int* converged;
+} LDPCCudaArgs;
+
+/**
+ * @brief Channel parameters of a simulation kernel
+ */
+typedef struct {
+    uint64_t seed;
+    size_t base;                        /* Codeword index of thread 0 */
+    double sigma;
+    double llr_scale;                   /* 2 / sigma^2 */
+    double log_var;                     /* ln(1 + scintillation index), 0 = no fading */
+} LDPCCudaSimArgs;
+
+/**
+ * @brief Log a failed runtime call; returns 1 on success
+ */
+static int ldpc_cuda_ok(cudaError_t status, const char* what)
+{
+    if (status != cudaSuccess) {
+        FSO_LOG_ERROR(LDPC_MODULE, "%s failed: %s", what, cudaGetErrorString(status));
+        return 0;
+    }
+    return 1;
+}
+
+/* ============================================================================
+ * Device Code
+ * ============================================================================ */
+
+/**
+ * @brief Philox4x32-10 block, identical to philox_refill() in random.c
+ */
+__device__ static inline void ldpc_cuda_philox(uint64_t seed, uint64_t block, uint32_t packet,
+                                               uint32_t stream_id, uint32_t out[4])
+{
+    uint32_t x0 = (uint32_t)block;
+    uint32_t x1 = (uint32_t)(block >> 32);
+    uint32_t x2 = packet;
+    uint32_t x3 = stream_id;
+    uint32_t r0 = (uint32_t)seed;
+    uint32_t r1 = (uint32_t)(seed >> 32);
+    
+    for (int round = 0; round < 10; round++) {
+        uint32_t hi0 = __umulhi(0xD2511F53u, x0);
+        uint32_t lo0 = 0xD2511F53u * x0;
+        uint32_t hi1 = __umulhi(0xCD9E8D57u, x2);
+        uint32_t lo1 = 0xCD9E8D57u * x2;
+        uint32_t y0 = hi1 ^ x1 ^ r0;
+        uint32_t y2 = hi0 ^ x3 ^ r1;
+        x1 = lo1;
+        x3 = lo0;
+        x0 = y0;
+        x2 = y2;
+        r0 += 0x9E3779B9u;
+        r1 += 0xBB67AE85u;
+    }
+    
+    out[0] = x0;
+    out[1] = x1;
+    out[2] = x2;
+    out[3] = x3;
+}
+
+/**
+ * @brief Uniform double in (0, 1) from two words, as ldpc_sim_uniform()
+ */
+__device__ static inline double ldpc_cuda_uniform(uint32_t hi, uint32_t lo)
+{
+    uint64_t bits = ((uint64_t)hi << 32) | lo;
+    return ((double)(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/* Channel LLR stores: float as is, fixed-point as in ldpc_batch_load_soft() */
+__device__ static inline void ldpc_cuda_store_llr(float* dst, float value, const LDPCCudaArgs& a)
+{
+    (void)a;
+    *dst = value;
+}
+
+__device__ static inline void ldpc_cuda_store_llr(int16_t* dst, float value, const LDPCCudaArgs& a)
+{
+    float limit = (float)a.limit;
+    float q = rintf(__fmul_rn(value, (float)LDPC_FIXED_LLR_SCALE));
+    *dst = (int16_t)fmaxf(-limit, fminf(q, limit));
+}
+
+__device__ static inline void ldpc_cuda_store_hard(float* dst, int bit, const LDPCCudaArgs& a)
+{
+    (void)a;
+    *dst = bit ? -10.0f : 10.0f;
+}
+
+__device__ static inline void ldpc_cuda_store_hard(int16_t* dst, int bit, const LDPCCudaArgs& a)
+{
+    *dst = bit ? (int16_t)-a.hard_fixed : a.hard_fixed;
+}
+
+/**
+ * @brief One float min-sum iteration of codeword w (ldpc_batch_iterate_float lane)
+ */
+__device__ static void ldpc_cuda_iterate(const LDPCCudaArgs& a, int w, float* post, float* post_out,
+                                         float* v2c, float* c2v)
+{
+    const size_t C = a.capacity;
+    
+    for (int c = 0; c < a.m; c++) {
+        int edge_start = a.row_ptr[c];
+        int edge_end = a.row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
+        
+        float min1 = INFINITY;
+        float min2 = INFINITY;
+        float sign = 1.0f;
+        int min1_edge = -1;
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            float x = post[(size_t)a.col_indices[e] * C + w] - c2v[(size_t)e * C + w];
+            float abs_x = fabsf(x);
+            int is_min = abs_x < min1;
+            
+            v2c[(size_t)e * C + w] = x;
+            sign = (x < 0.0f) ? -sign : sign;
+            min2 = is_min ? min1 : (abs_x < min2 ? abs_x : min2);
+            min1_edge = is_min ? e : min1_edge;
+            min1 = is_min ? abs_x : min1;
+        }
+        
+        /* Rounded multiply: a fused multiply-subtract would not match the CPU */
+        float m2 = (edge_end - edge_start == 1) ? 0.0f : min2;
+        float v1 = __fsub_rn(__fmul_rn(min1, a.scale), a.offset);
+        float v2 = __fsub_rn(__fmul_rn(m2, a.scale), a.offset);
+        float mag1 = v1 > 0.0f ? v1 : 0.0f;
+        float mag2 = v2 > 0.0f ? v2 : 0.0f;
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            float in = v2c[(size_t)e * C + w];
+            float mag = (e == min1_edge) ? mag2 : mag1;
+            float s = (in < 0.0f) ? -sign : sign;
+            float out = s * mag;
+            float* pv = post_out + (size_t)a.col_indices[e] * C + w;
+            
+            c2v[(size_t)e * C + w] = out;
+            *pv = a.layered ? in + out : *pv + out;
+        }
+    }
+}
+
+/**
+ * @brief One fixed-point min-sum iteration of codeword w (ldpc_batch_iterate_fixed lane)
+ */
+__device__ static void ldpc_cuda_iterate(const LDPCCudaArgs& a, int w, int16_t* post, int16_t* post_out,
+                                         int16_t* v2c, int16_t* c2v)
+{
+    const size_t C = a.capacity;
+    
+    for (int c = 0; c < a.m; c++) {
+        int edge_start = a.row_ptr[c];
+        int edge_end = a.row_ptr[c + 1];
+        if (edge_end == edge_start) continue;
+        
+        int32_t min1 = a.limit;
+        int32_t min2 = a.limit;
+        int32_t negative = 0;
+        int32_t min1_edge = -1;
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            int32_t x = (int32_t)post[(size_t)a.col_indices[e] * C + w] -
+                        (int32_t)c2v[(size_t)e * C + w];
+            x = FSO_CLAMP(x, -INT16_MAX, INT16_MAX);
+            int32_t abs_x = x < 0 ? -x : x;
+            abs_x = FSO_MIN(abs_x, a.limit);
+            int32_t is_min = abs_x < min1;
+            
+            v2c[(size_t)e * C + w] = (int16_t)x;
+            negative ^= (x < 0);
+            min2 = is_min ? min1 : FSO_MIN(min2, abs_x);
+            min1_edge = is_min ? e : min1_edge;
+            min1 = is_min ? abs_x : min1;
+        }
+        
+        int32_t m2 = (edge_end - edge_start == 1) ? 0 : min2;
+        int32_t mag1 = FSO_MAX(((min1 * a.scale_q8) >> 8) - a.offset_q, 0);
+        int32_t mag2 = FSO_MAX(((m2 * a.scale_q8) >> 8) - a.offset_q, 0);
+        
+        for (int e = edge_start; e < edge_end; e++) {
+            int16_t in = v2c[(size_t)e * C + w];
+            int16_t* pv = post_out + (size_t)a.col_indices[e] * C + w;
+            int32_t mag = (e == min1_edge) ? mag2 : mag1;
+            int32_t msg = (negative ^ (in < 0)) ? -mag : mag;
+            int32_t p = a.layered ? (int32_t)in + msg : (int32_t)*pv + msg;
+            
+            c2v[(size_t)e * C + w] = (int16_t)msg;
+            *pv = (int16_t)FSO_CLAMP(p, -INT16_MAX, INT16_MAX);
+        }
+    }
+}
+
+/**
+ * @brief Whether codeword w's hard decisions satisfy every check
+ */
+__device__ static int ldpc_cuda_satisfied(const LDPCCudaArgs& a, int w)
+{
+    const size_t C = a.capacity;
+    
+    for (int c = 0; c < a.m; c++) {
+        int parity = 0;
+        for (int e = a.row_ptr[c]; e < a.row_ptr[c + 1]; e++) {
+            parity ^= a.hard[(size_t)a.col_indices[e] * C + w];
+        }
+        if (parity) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Iterate codeword w from its loaded channel LLRs and hard decisions
+ *
+ * Same stopping rule as ldpc_batch_decode_group(): the syndrome is tested
+ * before every iteration, and an unconverged word reports max_iterations.
+ */
+template <typename Msg>
+__device__ static void ldpc_cuda_decode_loaded(const LDPCCudaArgs& a, int w,
+                                               int* iterations, int* converged)
+{
+    const size_t C = a.capacity;
+    const Msg* channel = (const Msg*)a.channel;
+    Msg* post = (Msg*)a.posterior;
+    Msg* next = (Msg*)a.posterior_next;
+    Msg* v2c = (Msg*)a.v2c;
+    Msg* c2v = (Msg*)a.c2v;
+    
+    for (int v = 0; v < a.n; v++) {
+        post[(size_t)v * C + w] = channel[(size_t)v * C + w];
+    }
+    for (int e = 0; e < a.row_ptr[a.m]; e++) {
+        c2v[(size_t)e * C + w] = 0;
+    }
+    
+    int iteration = 0;
+    int done = 0;
+    for (;;) {
+        if (ldpc_cuda_satisfied(a, w)) {
+            done = 1;
+            break;
+        }
+        if (iteration == a.max_iterations) {
+            break;
+        }
+        
+        if (a.layered) {
+            ldpc_cuda_iterate(a, w, post, post, v2c, c2v);
+        } else {
+            for (int v = 0; v < a.n; v++) {
+                next[(size_t)v * C + w] = channel[(size_t)v * C + w];
+            }
+            ldpc_cuda_iterate(a, w, post, next, v2c, c2v);
+            Msg* swap = post;
+            post = next;
+            next = swap;
+        }
+        
+        for (int v = 0; v < a.n; v++) {
+            a.hard[(size_t)v * C + w] = post[(size_t)v * C + w] < (Msg)0;
+        }
+        iteration++;
+    }
+    
+    *iterations = done ? iteration : a.max_iterations;
+    *converged = done;
+}
+
+/**
+ * @brief Decode one chunk; thread w owns codeword w of the chunk
+ */
+template <typename Msg>
+__global__ void ldpc_cuda_decode_kernel(LDPCCudaArgs a, int count)
+{
+    int w = blockIdx.x * blockDim.x + threadIdx.x;
+    if (w >= count) return;
+    
+    const size_t C = a.capacity;
+    Msg* channel = (Msg*)a.channel;
+    
+    for (int v = 0; v < a.n; v++) {
+        size_t slot = (size_t)v * C + w;
+        if (a.soft) {
+            float value = ((const float*)a.input)[(size_t)w * a.n + v];
+            a.hard[slot] = value < 0.0f;
+            ldpc_cuda_store_llr(channel + slot, value, a);
+        } else {
+            int bit = ((const uint8_t*)a.input)[(size_t)w * a.n + v] != 0;
+            a.hard[slot] = (uint8_t)bit;
+            ldpc_cuda_store_hard(channel + slot, bit, a);
+        }
+    }
+    
+    ldpc_cuda_decode_loaded<Msg>(a, w, &a.iterations[w], &a.converged[w]);
+    
+    for (int i = 0; i < a.k; i++) {
+        a.decoded[(size_t)w * a.k + i] = a.hard[(size_t)i * C + w];
+    }
+}
+
+/**
+ * @brief Draw, decode and count one chunk of the all-zero codeword
+ *
+ * The channel draws follow ldpc_simulate_channel(): one Philox block per
+ * Box-Muller pair, fade from the channel stream, noise from the noise
+ * stream of packet base + w.
+ */
+template <typename Msg>
+__global__ void ldpc_cuda_simulate_kernel(LDPCCudaArgs a, LDPCCudaSimArgs s, int count,
+                                          unsigned long long* counters)
+{
+    int w = blockIdx.x * blockDim.x + threadIdx.x;
+    if (w >= count) return;
+    
+    const size_t C = a.capacity;
+    const double two_pi = 6.283185307179586;
+    const uint32_t packet = (uint32_t)(s.base + w);
+    Msg* channel = (Msg*)a.channel;
+    uint32_t x[4];
+    
+    double gain = 1.0;
+    if (s.log_var > 0.0) {
+        ldpc_cuda_philox(s.seed, 0, packet, FSO_RNG_STREAM_CHANNEL, x);
+        double z = sqrt(-2.0 * log(ldpc_cuda_uniform(x[0], x[1]))) *
+                   cos(two_pi * ldpc_cuda_uniform(x[2], x[3]));
+        gain = exp(__dsub_rn(__dmul_rn(sqrt(s.log_var), z), 0.5 * s.log_var));
+    }
+    
+    for (int v = 0; v < a.n; v += 2) {
+        ldpc_cuda_philox(s.seed, (uint64_t)(v / 2), packet, FSO_RNG_STREAM_NOISE, x);
+        double radius = sqrt(-2.0 * log(ldpc_cuda_uniform(x[0], x[1]))) * s.sigma;
+        double angle = two_pi * ldpc_cuda_uniform(x[2], x[3]);
+        
+        float llr = (float)(s.llr_scale * gain * __dadd_rn(gain, __dmul_rn(radius, cos(angle))));
+        a.hard[(size_t)v * C + w] = llr < 0.0f;
+        ldpc_cuda_store_llr(channel + (size_t)v * C + w, llr, a);
+        
+        if (v + 1 < a.n) {
+            llr = (float)(s.llr_scale * gain * __dadd_rn(gain, __dmul_rn(radius, sin(angle))));
+            a.hard[(size_t)(v + 1) * C + w] = llr < 0.0f;
+            ldpc_cuda_store_llr(channel + (size_t)(v + 1) * C + w, llr, a);
+        }
+    }
+    
+    int iterations = 0;
+    int converged = 0;
+    ldpc_cuda_decode_loaded<Msg>(a, w, &iterations, &converged);
+    
+    unsigned long long errors = 0;
+    for (int i = 0; i < a.k; i++) {
+        errors += a.hard[(size_t)i * C + w];
+    }
+    
+    atomicAdd(&counters[0], errors);
+    atomicAdd(&counters[1], errors > 0 ? 1ULL : 0ULL);
+    atomicAdd(&counters[2], converged ? 0ULL : 1ULL);
+    atomicAdd(&counters[3], (unsigned long long)iterations);
+}
+
+/* ============================================================================
+ * Host Side
+ * ============================================================================ */
+
+static void ldpc_cuda_set_free(LDPCCudaSet* set)
+{
+    if (set->stream) {
+        cudaStreamSynchronize(set->stream);
+        cudaStreamDestroy(set->stream);
+    }
+    
+    cudaFree(set->channel);
+    cudaFree(set->posterior);
+    cudaFree(set->posterior_next);
+    cudaFree(set->v2c);
+    cudaFree(set->c2v);
+    cudaFree(set->hard);
+    cudaFree(set->input);
+    cudaFree(set->decoded);
+    cudaFree(set->iterations);
+    cudaFree(set->converged);
+    cudaFree(set->counters);
+    
+    cudaFreeHost(set->host_input);
+    cudaFreeHost(set->host_decoded);
+    cudaFreeHost(set->host_iterations);
+    cudaFreeHost(set->host_converged);
+    cudaFreeHost(set->host_counters);
+    
+    memset(set, 0, sizeof(LDPCCudaSet));
+}
+
+static int ldpc_cuda_set_alloc(LDPCCudaSet* set, const LDPCCodec* ldpc, size_t capacity)
+{
+    size_t elem = (ldpc->llr_format == LDPC_LLR_FLOAT) ? sizeof(float) : sizeof(int16_t);
+    size_t nodes = (size_t)ldpc->n * capacity;
+    size_t edges = (size_t)ldpc->num_edges * capacity;
+    
+    return ldpc_cuda_ok(cudaStreamCreateWithFlags(&set->stream, cudaStreamNonBlocking), "cudaStreamCreate") &&
+           ldpc_cuda_ok(cudaMalloc(&set->channel, nodes * elem), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc(&set->posterior, nodes * elem), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc(&set->posterior_next, nodes * elem), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc(&set->v2c, edges * elem), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc(&set->c2v, edges * elem), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc((void**)&set->hard, nodes), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc(&set->input, nodes * sizeof(float)), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc((void**)&set->decoded, (size_t)ldpc->k * capacity), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc((void**)&set->iterations, capacity * sizeof(int)), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc((void**)&set->converged, capacity * sizeof(int)), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaMalloc((void**)&set->counters,
+                                   LDPC_CUDA_COUNTERS * sizeof(unsigned long long)), "cudaMalloc") &&
+           ldpc_cuda_ok(cudaHostAlloc(&set->host_input, nodes * sizeof(float),
+                                      cudaHostAllocDefault), "cudaHostAlloc") &&
+           ldpc_cuda_ok(cudaHostAlloc((void**)&set->host_decoded, (size_t)ldpc->k * capacity,
+                                      cudaHostAllocDefault), "cudaHostAlloc") &&
+           ldpc_cuda_ok(cudaHostAlloc((void**)&set->host_iterations, capacity * sizeof(int),
+                                      cudaHostAllocDefault), "cudaHostAlloc") &&
+           ldpc_cuda_ok(cudaHostAlloc((void**)&set->host_converged, capacity * sizeof(int),
+                                      cudaHostAllocDefault), "cudaHostAlloc") &&
+           ldpc_cuda_ok(cudaHostAlloc((void**)&set->host_counters,
+                                      LDPC_CUDA_COUNTERS * sizeof(unsigned long long),
+                                      cudaHostAllocDefault), "cudaHostAlloc");
+}
+
+/**
+ * @brief The codec's device context, built (graph upload included) on first use
+ */
+static LDPCCudaContext* ldpc_cuda_context(LDPCCodec* ldpc)
+{
+    LDPCCudaContext* ctx = (LDPCCudaContext*)ldpc->device;
+    if (ctx && ctx->format == ldpc->llr_format) {
+        return ctx;
+    }
+    ldpc_cuda_release(ldpc);
+    
+    ctx = (LDPCCudaContext*)calloc(1, sizeof(LDPCCudaContext));
+    if (!ctx) {
+        return NULL;
+    }
+    ldpc->device = ctx;
+    ctx->format = ldpc->llr_format;
+    ctx->capacity = LDPC_CUDA_CHUNK;
+    
+    const size_t ptr_bytes = (size_t)(ldpc->m + 1) * sizeof(int);
+    const size_t col_bytes = (size_t)(ldpc->num_edges > 0 ? ldpc->num_edges : 1) * sizeof(int);
+    int ok = ldpc_cuda_ok(cudaMalloc((void**)&ctx->row_ptr, ptr_bytes), "cudaMalloc") &&
+             ldpc_cuda_ok(cudaMalloc((void**)&ctx->col_indices, col_bytes), "cudaMalloc") &&
+             ldpc_cuda_ok(cudaMemcpy(ctx->row_ptr, ldpc->H->row_ptr, ptr_bytes,
+                                     cudaMemcpyHostToDevice), "cudaMemcpy") &&
+             ldpc_cuda_ok(cudaMemcpy(ctx->col_indices, ldpc->H->col_indices,
+                                     (size_t)ldpc->num_edges * sizeof(int),
+                                     cudaMemcpyHostToDevice), "cudaMemcpy");
+    
+    for (int s = 0; ok && s < LDPC_CUDA_STREAMS; s++) {
+        ok = ldpc_cuda_set_alloc(&ctx->sets[s], ldpc, ctx->capacity);
+    }
+    
+    if (!ok) {
+        ldpc_cuda_release(ldpc);
+        return NULL;
+    }
+    
+    FSO_LOG_INFO(LDPC_MODULE, "CUDA backend ready: %d edges resident, %zu codewords per launch",
+                ldpc->num_edges, ctx->capacity);
+    return ctx;
+}
+
+/**
+ * @brief Kernel arguments for one chunk in the given set
+ */
+static LDPCCudaArgs ldpc_cuda_args(const LDPCCodec* ldpc, const LDPCCudaContext* ctx,
+                                   const LDPCCudaSet* set, int soft)
+{
+    LDPCCudaArgs a;
+    memset(&a, 0, sizeof(a));
+    
+    a.row_ptr = ctx->row_ptr;
+    a.col_indices = ctx->col_indices;
+    a.n = ldpc->n;
+    a.k = ldpc->k;
+    a.m = ldpc->m;
+    a.max_iterations = ldpc->max_iterations;
+    a.layered = (ldpc->schedule == LDPC_SCHEDULE_LAYERED);
+    a.soft = soft;
+    a.capacity = ctx->capacity;
+    
+    /* Same corrections as the CPU batch kernels */
+    a.scale = (ldpc->check_node_algorithm == LDPC_CHECK_NORMALIZED_MIN_SUM) ?
+              (float)ldpc->min_sum_scale : 1.0f;
+    a.offset = (ldpc->check_node_algorithm == LDPC_CHECK_OFFSET_MIN_SUM) ?
+               (float)ldpc->min_sum_offset : 0.0f;
+    a.scale_q8 = 256;
+    a.offset_q = 0;
+    if (ldpc->check_node_algorithm == LDPC_CHECK_OFFSET_MIN_SUM) {
+        a.offset_q = (int32_t)lround(ldpc->min_sum_offset * LDPC_FIXED_LLR_SCALE);
+    } else {
+        a.scale_q8 = (int32_t)lround(ldpc->min_sum_scale * 256.0);
+    }
+    a.limit = ldpc_fixed_llr_limit(ldpc);
+    a.hard_fixed = (int16_t)FSO_MIN(lround(10.0 * LDPC_FIXED_LLR_SCALE), (long)a.limit);
+    
+    a.channel = set->channel;
+    a.posterior = set->posterior;
+    a.posterior_next = set->posterior_next;
+    a.v2c = set->v2c;
+    a.c2v = set->c2v;
+    a.hard = set->hard;
+    a.input = set->input;
+    a.decoded = set->decoded;
+    a.iterations = set->iterations;
+    a.converged = set->converged;
+    
+    return a;
+}
+
+/**
+ * @brief Whether the GPU reproduces the CPU batch decoder for this codec
+ */
+static int ldpc_cuda_supported(const LDPCCodec* ldpc)
+{
+    if (!ldpc->H || !ldpc->H->row_ptr || ldpc->num_edges <= 0) {
+        return 0;
+    }
+    /* Float sum-product needs phi(); device transcendentals differ in the last bits */
+    return !(ldpc->llr_format == LDPC_LLR_FLOAT &&
+             ldpc->check_node_algorithm == LDPC_CHECK_SUM_PRODUCT);
+}
+
+/**
+ * @brief Wait for a set's chunk and copy its decisions to the caller
+ */
+static int ldpc_cuda_drain_decode(const LDPCCodec* ldpc, LDPCCudaSet* set, uint8_t* decoded,
+                                  int* iterations, int* converged)
+{
+    if (set->count == 0) {
+        return 1;
+    }
+    if (!ldpc_cuda_ok(cudaStreamSynchronize(set->stream), "ldpc_cuda_decode_kernel")) {
+        return 0;
+    }
+    
+    memcpy(decoded + set->base * ldpc->k, set->host_decoded, set->count * ldpc->k);
+    if (iterations) {
+        memcpy(iterations + set->base, set->host_iterations, set->count * sizeof(int));
+    }
+    if (converged) {
+        memcpy(converged + set->base, set->host_converged, set->count * sizeof(int));
+    }
+    set->count = 0;
+    return 1;
+}
+
+extern "C" int ldpc_cuda_available(void)
+{
+    int count = 0;
+    if (cudaGetDeviceCount(&count) != cudaSuccess) {
+        return 0;
+    }
+    return count;
+}
+
+extern "C" FSOErrorCode ldpc_cuda_decode_batch(LDPCCodec* ldpc, const uint8_t* received,
+                                               const float* llr, size_t stride, size_t num_codewords,
+                                               uint8_t* decoded, int* iterations, int* converged)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(received != NULL || llr != NULL);
+    
+    if (!ldpc_cuda_supported(ldpc)) {
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    LDPCCudaContext* ctx = ldpc_cuda_context(ldpc);
+    if (!ctx) {
+        FSO_LOG_WARNING(LDPC_MODULE, "CUDA backend unavailable, decoding on the CPU");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    const size_t n = (size_t)ldpc->n;
+    const size_t k = (size_t)ldpc->k;
+    const int fixed = (ldpc->llr_format != LDPC_LLR_FLOAT);
+    const size_t input_elem = llr ? sizeof(float) : sizeof(uint8_t);
+    const dim3 threads(LDPC_CUDA_THREADS);
+    int ok = 1;
+    
+    for (size_t base = 0, chunk = 0; ok && base < num_codewords; base += ctx->capacity, chunk++) {
+        LDPCCudaSet* set = &ctx->sets[chunk % LDPC_CUDA_STREAMS];
+        size_t count = FSO_MIN(ctx->capacity, num_codewords - base);
+        
+        /* Reusing the set: collect its previous chunk first */
+        if (!ldpc_cuda_drain_decode(ldpc, set, decoded, iterations, converged)) {
+            ok = 0;
+            break;
+        }
+        
+        /* Stage into pinned memory (gathering strided LLRs) while the other set runs */
+        if (llr) {
+            float* staged = (float*)set->host_input;
+            for (size_t w = 0; w < count; w++) {
+                for (size_t v = 0; v < n; v++) {
+                    staged[w * n + v] = llr[((base + w) * n + v) * stride];
+                }
+            }
+        } else {
+            memcpy(set->host_input, received + base * n, count * n);
+        }
+        
+        LDPCCudaArgs args = ldpc_cuda_args(ldpc, ctx, set, llr != NULL);
+        dim3 blocks((unsigned int)((count + LDPC_CUDA_THREADS - 1) / LDPC_CUDA_THREADS));
+        
+        ok = ldpc_cuda_ok(cudaMemcpyAsync(set->input, set->host_input, count * n * input_elem,
+                                          cudaMemcpyHostToDevice, set->stream), "cudaMemcpyAsync");
+        if (ok) {
+            if (fixed) {
+                ldpc_cuda_decode_kernel<int16_t><<<blocks, threads, 0, set->stream>>>(args, (int)count);
+            } else {
+                ldpc_cuda_decode_kernel<float><<<blocks, threads, 0, set->stream>>>(args, (int)count);
+            }
+            ok = ldpc_cuda_ok(cudaGetLastError(), "ldpc_cuda_decode_kernel launch") &&
+                 ldpc_cuda_ok(cudaMemcpyAsync(set->host_decoded, set->decoded, count * k,
+                                              cudaMemcpyDeviceToHost, set->stream), "cudaMemcpyAsync") &&
+                 ldpc_cuda_ok(cudaMemcpyAsync(set->host_iterations, set->iterations, count * sizeof(int),
+                                              cudaMemcpyDeviceToHost, set->stream), "cudaMemcpyAsync") &&
+                 ldpc_cuda_ok(cudaMemcpyAsync(set->host_converged, set->converged, count * sizeof(int),
+                                              cudaMemcpyDeviceToHost, set->stream), "cudaMemcpyAsync");
+        }
+        
+        set->base = base;
+        set->count = count;
+    }
+    
+    for (int s = 0; ok && s < LDPC_CUDA_STREAMS; s++) {
+        ok = ldpc_cuda_drain_decode(ldpc, &ctx->sets[s], decoded, iterations, converged);
+    }
+    
+    if (!ok) {
+        /* The CPU redoes the whole batch */
+        ldpc_cuda_release(ldpc);
+        FSO_LOG_WARNING(LDPC_MODULE, "CUDA batch decode failed, decoding on the CPU");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    FSO_LOG_DEBUG(LDPC_MODULE, "CUDA batch decoded %zu codewords (%s input)",
+                 num_codewords, llr ? "soft" : "hard");
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Wait for a set's simulation chunk and add its counts
+ */
+static int ldpc_cuda_drain_simulate(LDPCCudaSet* set, LDPCSimulationResult* result)
+{
+    if (set->count == 0) {
+        return 1;
+    }
+    if (!ldpc_cuda_ok(cudaStreamSynchronize(set->stream), "ldpc_cuda_simulate_kernel")) {
+        return 0;
+    }
+    
+    result->bit_errors += set->host_counters[0];
+    result->frame_errors += set->host_counters[1];
+    result->unconverged += set->host_counters[2];
+    result->total_iterations += set->host_counters[3];
+    result->codewords += set->count;
+    set->count = 0;
+    return 1;
+}
+
+extern "C" FSOErrorCode ldpc_cuda_simulate(LDPCCodec* ldpc, const LDPCSimulationConfig* config,
+                                           LDPCSimulationResult* result)
+{
+    FSO_CHECK_NULL(ldpc);
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(result);
+    
+    if (!ldpc_cuda_supported(ldpc)) {
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    LDPCCudaContext* ctx = ldpc_cuda_context(ldpc);
+    if (!ctx) {
+        FSO_LOG_WARNING(LDPC_MODULE, "CUDA backend unavailable, simulating on the CPU");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    LDPCCudaSimArgs sim;
+    sim.seed = config->seed;
+    sim.sigma = sqrt(1.0 / (2.0 * ldpc->code_rate * fso_db_to_linear(config->ebn0_db)));
+    sim.llr_scale = 2.0 / (sim.sigma * sim.sigma);
+    sim.log_var = (config->scintillation_index > 0.0) ? log(1.0 + config->scintillation_index) : 0.0;
+    
+    const int fixed = (ldpc->llr_format != LDPC_LLR_FLOAT);
+    const dim3 threads(LDPC_CUDA_THREADS);
+    int ok = 1;
+    
+    memset(result, 0, sizeof(LDPCSimulationResult));
+    
+    for (size_t base = 0, chunk = 0; ok && base < config->num_codewords;
+         base += ctx->capacity, chunk++) {
+        LDPCCudaSet* set = &ctx->sets[chunk % LDPC_CUDA_STREAMS];
+        size_t count = FSO_MIN(ctx->capacity, config->num_codewords - base);
+        
+        if (!ldpc_cuda_drain_simulate(set, result)) {
+            ok = 0;
+            break;
+        }
+        
+        LDPCCudaArgs args = ldpc_cuda_args(ldpc, ctx, set, 1);
+        dim3 blocks((unsigned int)((count + LDPC_CUDA_THREADS - 1) / LDPC_CUDA_THREADS));
+        sim.base = base;
+        
+        ok = ldpc_cuda_ok(cudaMemsetAsync(set->counters, 0,
+                                          LDPC_CUDA_COUNTERS * sizeof(unsigned long long),
+                                          set->stream), "cudaMemsetAsync");
+        if (ok) {
+            if (fixed) {
+                ldpc_cuda_simulate_kernel<int16_t><<<blocks, threads, 0, set->stream>>>(args, sim, (int)count, set->counters);
+            } else {
+                ldpc_cuda_simulate_kernel<float><<<blocks, threads, 0, set->stream>>>(args, sim, (int)count, set->counters);
+            }
+            ok = ldpc_cuda_ok(cudaGetLastError(), "ldpc_cuda_simulate_kernel launch") &&
+                 ldpc_cuda_ok(cudaMemcpyAsync(set->host_counters, set->counters,
+                                              LDPC_CUDA_COUNTERS * sizeof(unsigned long long),
+                                              cudaMemcpyDeviceToHost, set->stream), "cudaMemcpyAsync");
+        }
+        
+        set->base = base;
+        set->count = count;
+    }
+    
+    for (int s = 0; ok && s < LDPC_CUDA_STREAMS; s++) {
+        ok = ldpc_cuda_drain_simulate(&ctx->sets[s], result);
+    }
+    
+    if (!ok) {
+        ldpc_cuda_release(ldpc);
+        memset(result, 0, sizeof(LDPCSimulationResult));
+        FSO_LOG_WARNING(LDPC_MODULE, "CUDA simulation failed, simulating on the CPU");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+extern "C" void ldpc_cuda_release(LDPCCodec* ldpc)
+{
+    if (!ldpc || !ldpc->device) {
+        return;
+    }
+    
+    LDPCCudaContext* ctx = (LDPCCudaContext*)ldpc->device;
+    for (int s = 0; s < LDPC_CUDA_STREAMS; s++) {
+        ldpc_cuda_set_free(&ctx->sets[s]);
+    }
+    cudaFree(ctx->row_ptr);
+    cudaFree(ctx->col_indices);
+    free(ctx);
+    ldpc->device = NULL;
+}
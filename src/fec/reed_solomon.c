@@ -3,19 +3,37 @@
  * @brief Reed-Solomon error correction code implementation
  * 
  * This file implements Reed-Solomon encoding using Galois Field arithmetic
- * and systematic encoding.
+ * and systematic encoding. 8-bit codes use split-nibble multiply tables so
+ * the encoder LFSR and the syndrome evaluation run 16/32/64 symbols per
+ * vector instruction; the SSE4.2, AVX2, AVX-512BW or NEON kernels are picked
+ * at run time (fso_cpu_simd_level()). Scalar dispatch and other field sizes
+ * use the log/antilog path.
  */
 
 #include "reed_solomon.h"
 #include <stdlib.h>
 #include <string.h>
 
+#if FSO_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+#if FSO_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#define RS_HAVE_SIMD (FSO_HAVE_X86_SIMD || FSO_HAVE_NEON)
+
 /* ============================================================================
  * Module Constants
  * ============================================================================ */
 
 #define RS_MODULE "RS"
 
+/* Split-nibble table layout: 32 bytes per multiplier (lo[16], hi[16]) */
+#define RS_NIBBLE_TABLE_BYTES 32
+/* Syndrome multipliers per root: alpha^((fcr+i) * {64, 32, 16, 8, 4, 2, 1}) */
+#define RS_SYNDROME_STEPS 7
+
 /* Primitive polynomials for common symbol sizes */
 static const struct {
     int symbol_size;
@@ -40,6 +58,18 @@ static const struct {
 
 static FSOErrorCode gf_build_tables(GaloisField* gf);
 static int gf_mul_no_table(int a, int b, int primitive_poly, int field_size);
+static FSOErrorCode rs_build_simd_tables(RSCodec* rs);
+static void rs_fill_nibble_table(const GaloisField* gf, int constant, uint8_t* table);
+static inline int gf_log_add(int log_a, int log_b, int order);
+
+/* Encode and syndrome kernels of one instruction-set family; the scalar
+ * table is empty, which keeps the log/antilog path */
+typedef struct {
+    void (*encode)(const RSCodec* rs, const uint8_t* data, uint8_t* parity);
+    void (*syndrome)(RSCodec* rs, const uint8_t* received);
+} RSKernels;
+
+static const RSKernels* rs_kernels(void);
 
 /* ============================================================================
  * Galois Field Functions
@@ -198,6 +228,59 @@ FSOErrorCode poly_mul(const GaloisField* gf, const int* a, int a_degree,
     return FSO_SUCCESS;
 }
 
+FSOErrorCode poly_div(const GaloisField* gf, const int* dividend, int dividend_degree,
+                      const int* divisor, int divisor_degree,
+                      int* quotient, int* quotient_degree,
+                      int* remainder, int* remainder_degree)
+{
+    FSO_CHECK_NULL(gf);
+    FSO_CHECK_NULL(dividend);
+    FSO_CHECK_NULL(divisor);
+    FSO_CHECK_PARAM(divisor_degree >= 0 && divisor[0] != 0);
+    
+    /* Coefficients are stored highest degree first, as in poly_eval() */
+    if (dividend_degree < divisor_degree) {
+        if (quotient_degree) *quotient_degree = -1;
+        if (remainder) {
+            memcpy(remainder, dividend, (size_t)(dividend_degree + 1) * sizeof(int));
+        }
+        if (remainder_degree) *remainder_degree = dividend_degree;
+        return FSO_SUCCESS;
+    }
+    
+    int* work = (int*)malloc((size_t)(dividend_degree + 1) * sizeof(int));
+    if (!work) {
+        FSO_LOG_ERROR(RS_MODULE, "Failed to allocate polynomial division workspace");
+        return FSO_ERROR_MEMORY;
+    }
+    memcpy(work, dividend, (size_t)(dividend_degree + 1) * sizeof(int));
+    
+    /* Synthetic division: work[0..q] becomes the quotient, the tail the remainder */
+    int q_degree = dividend_degree - divisor_degree;
+    int lead_inv = gf_inv(gf, divisor[0]);
+    for (int i = 0; i <= q_degree; i++) {
+        int coefficient = gf_mul(gf, work[i], lead_inv);
+        work[i] = coefficient;
+        if (coefficient != 0) {
+            for (int j = 1; j <= divisor_degree; j++) {
+                work[i + j] = gf_add(gf, work[i + j], gf_mul(gf, coefficient, divisor[j]));
+            }
+        }
+    }
+    
+    if (quotient) {
+        memcpy(quotient, work, (size_t)(q_degree + 1) * sizeof(int));
+    }
+    if (quotient_degree) *quotient_degree = q_degree;
+    if (remainder && divisor_degree > 0) {
+        memcpy(remainder, work + q_degree + 1, (size_t)divisor_degree * sizeof(int));
+    }
+    if (remainder_degree) *remainder_degree = divisor_degree - 1;
+    
+    free(work);
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Reed-Solomon Functions
  * ============================================================================ */
@@ -236,13 +319,16 @@ FSOErrorCode rs_init(RSCodec* rs, const RSConfig* config, int n, int k)
     /* Allocate workspace */
     rs->generator_poly = (int*)calloc(rs->num_roots + 1, sizeof(int));
     rs->syndrome = (int*)calloc(rs->num_roots, sizeof(int));
-    rs->error_locator = (int*)calloc(rs->t + 1, sizeof(int));
-    rs->error_evaluator = (int*)calloc(rs->t, sizeof(int));
-    rs->error_positions = (int*)calloc(rs->t, sizeof(int));
-    rs->error_values = (int*)calloc(rs->t, sizeof(int));
+    /* Erasures raise the locator degree up to num_roots */
+    rs->error_locator = (int*)calloc(rs->num_roots + 1, sizeof(int));
+    rs->error_evaluator = (int*)calloc(rs->num_roots, sizeof(int));
+    rs->error_positions = (int*)calloc(rs->num_roots, sizeof(int));
+    rs->error_values = (int*)calloc(rs->num_roots, sizeof(int));
+    rs->locator_scratch = (int*)calloc(2 * (rs->num_roots + 1), sizeof(int));
     
     if (!rs->generator_poly || !rs->syndrome || !rs->error_locator ||
-        !rs->error_evaluator || !rs->error_positions || !rs->error_values) {
+        !rs->error_evaluator || !rs->error_positions || !rs->error_values ||
+        !rs->locator_scratch) {
         FSO_LOG_ERROR(RS_MODULE, "Failed to allocate Reed-Solomon workspace");
         rs_free(rs);
         return FSO_ERROR_MEMORY;
@@ -256,6 +342,14 @@ FSOErrorCode rs_init(RSCodec* rs, const RSConfig* config, int n, int k)
         return result;
     }
     
+    /* Vectorized encode/syndrome tables for byte-sized symbols */
+    result = rs_build_simd_tables(rs);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(RS_MODULE, "Failed to build GF(2^8) multiply tables");
+        rs_free(rs);
+        return result;
+    }
+    
     FSO_LOG_INFO(RS_MODULE, "Reed-Solomon codec initialized: RS(%d,%d) t=%d",
                 n, k, rs->t);
     
@@ -302,6 +396,21 @@ FSOErrorCode rs_free(RSCodec* rs)
         rs->error_values = NULL;
     }
     
+    if (rs->locator_scratch) {
+        free(rs->locator_scratch);
+        rs->locator_scratch = NULL;
+    }
+    
+    if (rs->encode_tables) {
+        free(rs->encode_tables);
+        rs->encode_tables = NULL;
+    }
+    
+    if (rs->syndrome_tables) {
+        free(rs->syndrome_tables);
+        rs->syndrome_tables = NULL;
+    }
+    
     memset(rs, 0, sizeof(RSCodec));
     FSO_LOG_DEBUG(RS_MODULE, "Reed-Solomon codec freed");
     
@@ -361,16 +470,18 @@ FSOErrorCode rs_encode(RSCodec* rs, const uint8_t* data, size_t data_len,
         encoded[i] = data[i];
     }
     
-    /* Initialize parity symbols to zero */
-    for (int i = rs->k; i < rs->n; i++) {
-        encoded[i] = 0;
+    const RSKernels* kernels = rs_kernels();
+    if (rs->use_simd && kernels->encode) {
+        kernels->encode(rs, data, encoded + rs->k);
+        *encoded_len = rs->n;
+        FSO_LOG_DEBUG(RS_MODULE, "Encoded %zu symbols to %d symbols", data_len, rs->n);
+        return FSO_SUCCESS;
     }
     
-    /* Systematic encoding: compute parity symbols using polynomial division
-     * We compute the remainder of data(x) * x^(n-k) divided by g(x)
-     * This is equivalent to computing the parity check symbols */
-    
-    /* Create temporary array for polynomial division */
+    /* Systematic encoding: the parity symbols are the remainder of
+     * data(x) * x^(n-k) divided by g(x). Symbol 0 is the highest-degree
+     * coefficient, so the division walks the word front to back and each
+     * feedback symbol is subtracted against g(x) from x^(n-k-1) down. */
     int temp[RS_MAX_CODE_LENGTH];
     
     /* Copy data symbols and pad with zeros (multiply by x^(n-k)) */
@@ -386,17 +497,18 @@ FSOErrorCode rs_encode(RSCodec* rs, const uint8_t* data, size_t data_len,
         int feedback = temp[i];
         
         if (feedback != 0) {
-            /* Subtract feedback * generator_poly from temp */
-            for (int j = 0; j <= rs->gen_poly_degree; j++) {
-                temp[i + j] = gf_add(rs->gf, temp[i + j], 
-                                    gf_mul(rs->gf, feedback, rs->generator_poly[j]));
+            /* generator_poly is stored lowest degree first and is monic */
+            for (int j = 1; j <= rs->gen_poly_degree; j++) {
+                temp[i + j] = gf_add(rs->gf, temp[i + j],
+                                    gf_mul(rs->gf, feedback,
+                                          rs->generator_poly[rs->gen_poly_degree - j]));
             }
         }
     }
     
     /* Copy the remainder (parity symbols) to the encoded array */
     for (int i = 0; i < rs->num_roots; i++) {
-        encoded[rs->k + i] = temp[rs->k + i];
+        encoded[rs->k + i] = (uint8_t)temp[rs->k + i];
     }
     
     /* Set the actual encoded length */
@@ -413,17 +525,23 @@ FSOErrorCode rs_calculate_syndrome(RSCodec* rs, const uint8_t* received, size_t
     FSO_CHECK_NULL(received);
     FSO_CHECK_PARAM(received_len == (size_t)rs->n);
     
-    /* Calculate syndrome S_i = r(α^(fcr+i)) for i = 0, 1, ..., num_roots-1 */
+    const RSKernels* kernels = rs_kernels();
+    if (rs->use_simd && kernels->syndrome) {
+        kernels->syndrome(rs, received);
+        return FSO_SUCCESS;
+    }
+    
+    /* Calculate syndrome S_i = r(α^(fcr+i)) for i = 0, 1, ..., num_roots-1.
+     * received[0] is the highest-degree coefficient, so Horner's rule
+     * consumes the word in storage order. */
     for (int i = 0; i < rs->num_roots; i++) {
         int alpha_power = gf_pow(rs->gf, 2, rs->fcr + i);
-        rs->syndrome[i] = 0;
+        int syndrome = 0;
         
-        /* Evaluate received polynomial at α^(fcr+i) */
         for (int j = 0; j < rs->n; j++) {
-            rs->syndrome[i] = gf_add(rs->gf, rs->syndrome[i],
-                                    gf_mul(rs->gf, received[j],
-                                          gf_pow(rs->gf, alpha_power, j)));
+            syndrome = gf_add(rs->gf, gf_mul(rs->gf, syndrome, alpha_power), received[j]);
         }
+        rs->syndrome[i] = syndrome;
     }
     
     return FSO_SUCCESS;
@@ -443,6 +561,650 @@ int rs_has_errors(const RSCodec* rs)
     return 0;
 }
 
+/* ============================================================================
+ * Decoding Functions
+ * ============================================================================ */
+
+/*
+ * Codeword index p holds the coefficient of x^(n-1-p), so the errata
+ * locator for index p is X = α^(n-1-p). All locator and evaluator
+ * polynomials below are stored lowest degree first.
+ */
+
+int rs_berlekamp_massey(RSCodec* rs)
+{
+    if (!rs || !rs->gf || !rs->error_locator || !rs->locator_scratch) return -1;
+    
+    const GaloisField* gf = rs->gf;
+    const int num_roots = rs->num_roots;
+    const int num_erasures = rs->num_erasures;
+    int* lambda = rs->error_locator;
+    int* correction = rs->locator_scratch;
+    int* next = rs->locator_scratch + num_roots + 1;
+    
+    if (num_erasures > num_roots) return -1;
+    
+    /* Seed with the erasure locator Γ(x) = Π (1 - X_j x) */
+    memset(lambda, 0, (size_t)(num_roots + 1) * sizeof(int));
+    lambda[0] = 1;
+    for (int e = 0; e < num_erasures; e++) {
+        int locator = gf->exp_table[rs->n - 1 - rs->erasure_positions[e]];
+        for (int j = e + 1; j > 0; j--) {
+            lambda[j] = gf_add(gf, lambda[j], gf_mul(gf, locator, lambda[j - 1]));
+        }
+    }
+    memcpy(correction, lambda, (size_t)(num_roots + 1) * sizeof(int));
+    
+    int length = num_erasures;
+    for (int r = num_erasures; r < num_roots; r++) {
+        /* Discrepancy between the current locator and syndrome r */
+        int discrepancy = 0;
+        for (int j = 0; j <= length && j <= r; j++) {
+            discrepancy = gf_add(gf, discrepancy, gf_mul(gf, lambda[j], rs->syndrome[r - j]));
+        }
+        
+        if (discrepancy == 0) {
+            memmove(correction + 1, correction, (size_t)num_roots * sizeof(int));
+            correction[0] = 0;
+            continue;
+        }
+        
+        /* next(x) = Λ(x) - Δ x B(x) */
+        next[0] = lambda[0];
+        for (int j = 1; j <= num_roots; j++) {
+            next[j] = gf_add(gf, lambda[j], gf_mul(gf, discrepancy, correction[j - 1]));
+        }
+        
+        if (2 * length <= r + num_erasures) {
+            /* Length change: B(x) = Λ(x) / Δ */
+            int discrepancy_inv = gf_inv(gf, discrepancy);
+            length = r + 1 + num_erasures - length;
+            for (int j = 0; j <= num_roots; j++) {
+                correction[j] = gf_mul(gf, lambda[j], discrepancy_inv);
+            }
+        } else {
+            memmove(correction + 1, correction, (size_t)num_roots * sizeof(int));
+            correction[0] = 0;
+        }
+        memcpy(lambda, next, (size_t)(num_roots + 1) * sizeof(int));
+    }
+    
+    /* 2 * errors + erasures must fit within the parity budget */
+    if (2 * length - num_erasures > num_roots) {
+        return -1;
+    }
+    
+    int degree = num_roots;
+    while (degree > 0 && lambda[degree] == 0) {
+        degree--;
+    }
+    
+    return (degree == length) ? length : -1;
+}
+
+int rs_chien_search(RSCodec* rs, int num_errors)
+{
+    if (!rs || !rs->gf || num_errors <= 0 || num_errors > rs->num_roots) return 0;
+    
+    const GaloisField* gf = rs->gf;
+    const int order = gf->field_size - 1;
+    const int* lambda = rs->error_locator;
+    int term_log[RS_MAX_PARITY_SYMBOLS + 1];
+    int term_step[RS_MAX_PARITY_SYMBOLS + 1];
+    int num_terms = 0;
+    
+    /* Term j of Λ(α^-d) is Λ_j α^(-j d): track its log and step it by -j */
+    for (int j = 1; j <= num_errors; j++) {
+        if (lambda[j] != 0) {
+            term_log[num_terms] = gf->log_table[lambda[j]];
+            term_step[num_terms] = (order - j % order) % order;
+            num_terms++;
+        }
+    }
+    
+    int found = 0;
+    for (int degree = 0; degree < rs->n; degree++) {
+        int sum = lambda[0];
+        for (int t = 0; t < num_terms; t++) {
+            sum ^= gf->exp_table[term_log[t]];
+            term_log[t] = gf_log_add(term_log[t], term_step[t], order);
+        }
+        
+        if (sum == 0) {
+            rs->error_positions[found++] = rs->n - 1 - degree;
+            if (found == num_errors) break;
+        }
+    }
+    
+    return found;
+}
+
+FSOErrorCode rs_forney_algorithm(RSCodec* rs, int num_errors)
+{
+    FSO_CHECK_NULL(rs);
+    FSO_CHECK_NULL(rs->gf);
+    FSO_CHECK_PARAM(num_errors >= 0 && num_errors <= rs->num_roots);
+    
+    const GaloisField* gf = rs->gf;
+    const int order = gf->field_size - 1;
+    const int* lambda = rs->error_locator;
+    int* omega = rs->error_evaluator;
+    
+    /* Ω(x) = S(x) Λ(x) mod x^num_roots; only degrees below num_errors are non-zero */
+    for (int i = 0; i < num_errors; i++) {
+        int value = 0;
+        for (int j = 0; j <= i; j++) {
+            value = gf_add(gf, value, gf_mul(gf, lambda[j], rs->syndrome[i - j]));
+        }
+        omega[i] = value;
+    }
+    
+    for (int e = 0; e < num_errors; e++) {
+        int degree = rs->n - 1 - rs->error_positions[e];
+        int x_inv_log = (order - degree) % order;
+        
+        /* Evaluate Ω(X^-1) and Λ'(X^-1) (odd terms only in characteristic 2) */
+        int omega_value = 0;
+        int power_log = 0;
+        for (int i = 0; i < num_errors; i++) {
+            if (omega[i] != 0) {
+                omega_value ^= gf->exp_table[gf_log_add(gf->log_table[omega[i]], power_log, order)];
+            }
+            power_log = gf_log_add(power_log, x_inv_log, order);
+        }
+        
+        int derivative = 0;
+        power_log = 0;
+        int step_log = gf_log_add(x_inv_log, x_inv_log, order);
+        for (int j = 1; j <= num_errors; j += 2) {
+            if (lambda[j] != 0) {
+                derivative ^= gf->exp_table[gf_log_add(gf->log_table[lambda[j]], power_log, order)];
+            }
+            power_log = gf_log_add(power_log, step_log, order);
+        }
+        
+        if (derivative == 0) {
+            FSO_LOG_DEBUG(RS_MODULE, "Forney: zero locator derivative at position %d",
+                         rs->error_positions[e]);
+            return FSO_ERROR_CONVERGENCE;
+        }
+        
+        /* Y = X^(1-fcr) Ω(X^-1) / Λ'(X^-1) */
+        int scale_log = (int)(((long)degree * (1 - rs->fcr)) % order);
+        if (scale_log < 0) scale_log += order;
+        rs->error_values[e] = gf_mul(gf, gf_div(gf, omega_value, derivative),
+                                     gf->exp_table[scale_log]);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+FSOErrorCode rs_decode(RSCodec* rs, const uint8_t* received, size_t received_len,
+                       uint8_t* decoded, size_t decoded_len, int* errors_corrected)
+{
+    return rs_decode_erasures(rs, received, received_len, NULL, 0,
+                              decoded, decoded_len, errors_corrected);
+}
+
+FSOErrorCode rs_decode_erasures(RSCodec* rs, const uint8_t* received, size_t received_len,
+                                const int* erasure_positions, int num_erasures,
+                                uint8_t* decoded, size_t decoded_len, int* errors_corrected)
+{
+    FSO_CHECK_NULL(rs);
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(decoded);
+    FSO_CHECK_PARAM(received_len == (size_t)rs->n);
+    FSO_CHECK_PARAM(decoded_len >= (size_t)rs->k);
+    FSO_CHECK_PARAM(num_erasures >= 0 && num_erasures <= rs->num_roots);
+    if (num_erasures > 0) {
+        FSO_CHECK_NULL(erasure_positions);
+        for (int e = 0; e < num_erasures; e++) {
+            FSO_CHECK_PARAM(erasure_positions[e] >= 0 && erasure_positions[e] < rs->n);
+        }
+    }
+    
+    if (errors_corrected) {
+        *errors_corrected = 0;
+    }
+    
+    FSOErrorCode result = rs_calculate_syndrome(rs, received, received_len);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    memcpy(decoded, received, (size_t)rs->k);
+    
+    /* Fast path: a valid codeword needs no locator work */
+    if (!rs_has_errors(rs)) {
+        return FSO_SUCCESS;
+    }
+    
+    rs->erasure_positions = erasure_positions;
+    rs->num_erasures = num_erasures;
+    
+    int num_errata = rs_berlekamp_massey(rs);
+    if (num_errata > 0 && rs_chien_search(rs, num_errata) == num_errata) {
+        result = rs_forney_algorithm(rs, num_errata);
+    } else {
+        result = FSO_ERROR_CONVERGENCE;
+    }
+    
+    rs->erasure_positions = NULL;
+    rs->num_erasures = 0;
+    
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_DEBUG(RS_MODULE, "Uncorrectable codeword (%d erasures)", num_erasures);
+        return FSO_ERROR_CONVERGENCE;
+    }
+    
+    int corrected = 0;
+    for (int e = 0; e < num_errata; e++) {
+        if (rs->error_values[e] == 0) continue;
+        corrected++;
+        if (rs->error_positions[e] < rs->k) {
+            decoded[rs->error_positions[e]] ^= (uint8_t)rs->error_values[e];
+        }
+    }
+    
+    if (errors_corrected) {
+        *errors_corrected = corrected;
+    }
+    
+    FSO_LOG_DEBUG(RS_MODULE, "Corrected %d symbols (%d erasures)", corrected, num_erasures);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Vectorized GF(2^8) Kernels
+ * ============================================================================ */
+
+/*
+ * Multiplying by a fixed constant c is linear over GF(2), so
+ * x * c = (x & 0x0f) * c ^ (x & 0xf0) * c. Two 16-entry tables per constant
+ * are enough, and PSHUFB performs 16 (SSE4.2), 32 (AVX2) or 64 (AVX-512BW)
+ * of those lookups per instruction without touching the log/antilog
+ * tables; NEON uses TBL the same way.
+ */
+
+#if RS_HAVE_SIMD
+
+/**
+ * @brief Copy the word behind zero padding up to a multiple of lanes
+ * 
+ * @return Padded length
+ */
+static int rs_pad_word(const RSCodec* rs, const uint8_t* received, uint8_t* word, int lanes)
+{
+    const int padded = (rs->n + lanes - 1) / lanes * lanes;
+    const int pad = padded - rs->n;
+    
+    memset(word, 0, (size_t)pad);
+    memcpy(word + pad, received, (size_t)rs->n);
+    
+    return padded;
+}
+
+#endif /* RS_HAVE_SIMD */
+
+#if FSO_HAVE_X86_SIMD
+
+FSO_TARGET_SSE42
+static inline __m128i rs_gf_mul_const_128(__m128i x, const uint8_t* table)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i lo = _mm_load_si128((const __m128i*)table);
+    __m128i hi = _mm_load_si128((const __m128i*)(table + 16));
+    __m128i x_lo = _mm_and_si128(x, mask);
+    __m128i x_hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+    return _mm_xor_si128(_mm_shuffle_epi8(lo, x_lo), _mm_shuffle_epi8(hi, x_hi));
+}
+
+FSO_TARGET_AVX2
+static inline __m256i rs_gf_mul_const_256(__m256i x, const uint8_t* table)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table));
+    __m256i hi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(table + 16)));
+    __m256i x_lo = _mm256_and_si256(x, mask);
+    __m256i x_hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), mask);
+    return _mm256_xor_si256(_mm256_shuffle_epi8(lo, x_lo), _mm256_shuffle_epi8(hi, x_hi));
+}
+
+FSO_TARGET_AVX512
+static inline __m512i rs_gf_mul_const_512(__m512i x, const uint8_t* table)
+{
+    const __m512i mask = _mm512_set1_epi8(0x0f);
+    __m512i lo = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i*)table));
+    __m512i hi = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i*)(table + 16)));
+    __m512i x_lo = _mm512_and_si512(x, mask);
+    __m512i x_hi = _mm512_and_si512(_mm512_srli_epi16(x, 4), mask);
+    return _mm512_xor_si512(_mm512_shuffle_epi8(lo, x_lo), _mm512_shuffle_epi8(hi, x_hi));
+}
+
+/**
+ * @brief LFSR parity computation with vector tap updates
+ * 
+ * The division register lives in a sliding byte buffer: at step i the
+ * feedback symbol is buf[i] and the num_roots taps following it absorb
+ * feedback * g, so advancing the window replaces the register shift.
+ */
+FSO_TARGET_SSE42
+static void rs_encode_sse42(const RSCodec* rs, const uint8_t* data, uint8_t* parity)
+{
+    _Alignas(32) uint8_t buf[256 + 2 * RS_SIMD_MAX_ROOTS];
+    const uint8_t* lo_taps = rs->encode_tables;
+    const uint8_t* hi_taps = rs->encode_tables + 16 * RS_SIMD_MAX_ROOTS;
+    const int halves = rs->num_roots <= 16 ? 16 : 32;
+    
+    memcpy(buf, data, (size_t)rs->k);
+    memset(buf + rs->k, 0, 2 * RS_SIMD_MAX_ROOTS);
+    
+    for (int i = 0; i < rs->k; i++) {
+        int feedback = buf[i];
+        if (feedback == 0) continue;
+        const uint8_t* lo_row = lo_taps + (feedback & 0x0f) * RS_SIMD_MAX_ROOTS;
+        const uint8_t* hi_row = hi_taps + (feedback >> 4) * RS_SIMD_MAX_ROOTS;
+        for (int half = 0; half < halves; half += 16) {
+            __m128i taps = _mm_xor_si128(_mm_load_si128((const __m128i*)(lo_row + half)),
+                                         _mm_load_si128((const __m128i*)(hi_row + half)));
+            __m128i reg = _mm_loadu_si128((const __m128i*)(buf + i + 1 + half));
+            _mm_storeu_si128((__m128i*)(buf + i + 1 + half), _mm_xor_si128(reg, taps));
+        }
+    }
+    
+    memcpy(parity, buf + rs->k, (size_t)rs->num_roots);
+}
+
+/**
+ * @brief rs_encode_sse42() with one 32-byte update for 17..32 roots
+ */
+FSO_TARGET_AVX2
+static void rs_encode_avx2(const RSCodec* rs, const uint8_t* data, uint8_t* parity)
+{
+    if (rs->num_roots <= 16) {
+        rs_encode_sse42(rs, data, parity);
+        return;
+    }
+    
+    _Alignas(32) uint8_t buf[256 + 2 * RS_SIMD_MAX_ROOTS];
+    const uint8_t* lo_taps = rs->encode_tables;
+    const uint8_t* hi_taps = rs->encode_tables + 16 * RS_SIMD_MAX_ROOTS;
+    
+    memcpy(buf, data, (size_t)rs->k);
+    memset(buf + rs->k, 0, 2 * RS_SIMD_MAX_ROOTS);
+    
+    for (int i = 0; i < rs->k; i++) {
+        int feedback = buf[i];
+        if (feedback == 0) continue;
+        __m256i taps = _mm256_xor_si256(
+            _mm256_load_si256((const __m256i*)(lo_taps + (feedback & 0x0f) * RS_SIMD_MAX_ROOTS)),
+            _mm256_load_si256((const __m256i*)(hi_taps + (feedback >> 4) * RS_SIMD_MAX_ROOTS)));
+        __m256i reg = _mm256_loadu_si256((const __m256i*)(buf + i + 1));
+        _mm256_storeu_si256((__m256i*)(buf + i + 1), _mm256_xor_si256(reg, taps));
+    }
+    
+    memcpy(parity, buf + rs->k, (size_t)rs->num_roots);
+}
+
+/**
+ * @brief Fold 16 -> 8 -> 4 -> 2 -> 1 lanes; step points at the β^8 table
+ */
+FSO_TARGET_SSE42
+static inline int rs_fold_lanes_128(__m128i acc, const uint8_t* step)
+{
+    acc = _mm_xor_si128(rs_gf_mul_const_128(acc, step), _mm_srli_si128(acc, 8));
+    step += RS_NIBBLE_TABLE_BYTES;
+    acc = _mm_xor_si128(rs_gf_mul_const_128(acc, step), _mm_srli_si128(acc, 4));
+    step += RS_NIBBLE_TABLE_BYTES;
+    acc = _mm_xor_si128(rs_gf_mul_const_128(acc, step), _mm_srli_si128(acc, 2));
+    step += RS_NIBBLE_TABLE_BYTES;
+    acc = _mm_xor_si128(rs_gf_mul_const_128(acc, step), _mm_srli_si128(acc, 1));
+    
+    return _mm_cvtsi128_si32(acc) & 0xff;
+}
+
+/**
+ * @brief Fold 32 -> 16 lanes; step points at the β^16 table
+ */
+FSO_TARGET_AVX2
+static inline __m128i rs_fold_lanes_256(__m256i wide, const uint8_t* step)
+{
+    return _mm_xor_si128(rs_gf_mul_const_128(_mm256_castsi256_si128(wide), step),
+                         _mm256_extracti128_si256(wide, 1));
+}
+
+/**
+ * @brief Syndrome evaluation over interleaved sub-words
+ * 
+ * With L lanes, lane l accumulates the symbols at positions l, l+L, ...
+ * by Horner's rule with the common multiplier β^L (β = α^(fcr+i)); the word
+ * is front-padded with zeros to a multiple of L. The lanes are then folded
+ * pairwise, V[l] = V[l]·β^(L/2) ^ V[l + L/2], until one lane holds r(β).
+ */
+FSO_TARGET_SSE42
+static void rs_syndrome_sse42(RSCodec* rs, const uint8_t* received)
+{
+    enum { LANES = 16, FIRST_STEP = 2 };
+    _Alignas(64) uint8_t word[256];
+    const int padded = rs_pad_word(rs, received, word, LANES);
+    
+    for (int i = 0; i < rs->num_roots; i++) {
+        const uint8_t* step = rs->syndrome_tables +
+                              ((size_t)i * RS_SYNDROME_STEPS + FIRST_STEP) * RS_NIBBLE_TABLE_BYTES;
+        __m128i acc = _mm_setzero_si128();
+        for (int pos = 0; pos < padded; pos += LANES) {
+            acc = rs_gf_mul_const_128(acc, step);
+            acc = _mm_xor_si128(acc, _mm_load_si128((const __m128i*)(word + pos)));
+        }
+        rs->syndrome[i] = rs_fold_lanes_128(acc, step + RS_NIBBLE_TABLE_BYTES);
+    }
+}
+
+FSO_TARGET_AVX2
+static void rs_syndrome_avx2(RSCodec* rs, const uint8_t* received)
+{
+    enum { LANES = 32, FIRST_STEP = 1 };
+    _Alignas(64) uint8_t word[256];
+    const int padded = rs_pad_word(rs, received, word, LANES);
+    
+    for (int i = 0; i < rs->num_roots; i++) {
+        const uint8_t* step = rs->syndrome_tables +
+                              ((size_t)i * RS_SYNDROME_STEPS + FIRST_STEP) * RS_NIBBLE_TABLE_BYTES;
+        __m256i wide = _mm256_setzero_si256();
+        for (int pos = 0; pos < padded; pos += LANES) {
+            wide = rs_gf_mul_const_256(wide, step);
+            wide = _mm256_xor_si256(wide, _mm256_load_si256((const __m256i*)(word + pos)));
+        }
+        step += RS_NIBBLE_TABLE_BYTES;
+        __m128i acc = rs_fold_lanes_256(wide, step);
+        rs->syndrome[i] = rs_fold_lanes_128(acc, step + RS_NIBBLE_TABLE_BYTES);
+    }
+}
+
+/**
+ * @brief 64-lane syndrome evaluation with AVX-512BW byte shuffles
+ */
+FSO_TARGET_AVX512
+static void rs_syndrome_avx512(RSCodec* rs, const uint8_t* received)
+{
+    enum { LANES = 64, FIRST_STEP = 0 };
+    _Alignas(64) uint8_t word[256];
+    const int padded = rs_pad_word(rs, received, word, LANES);
+    
+    for (int i = 0; i < rs->num_roots; i++) {
+        const uint8_t* step = rs->syndrome_tables +
+                              ((size_t)i * RS_SYNDROME_STEPS + FIRST_STEP) * RS_NIBBLE_TABLE_BYTES;
+        __m512i wide = _mm512_setzero_si512();
+        for (int pos = 0; pos < padded; pos += LANES) {
+            wide = rs_gf_mul_const_512(wide, step);
+            wide = _mm512_xor_si512(wide, _mm512_load_si512((const void*)(word + pos)));
+        }
+        step += RS_NIBBLE_TABLE_BYTES;
+        __m256i half = _mm256_xor_si256(rs_gf_mul_const_256(_mm512_castsi512_si256(wide), step),
+                                        _mm512_extracti64x4_epi64(wide, 1));
+        step += RS_NIBBLE_TABLE_BYTES;
+        __m128i acc = rs_fold_lanes_256(half, step);
+        rs->syndrome[i] = rs_fold_lanes_128(acc, step + RS_NIBBLE_TABLE_BYTES);
+    }
+}
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+#if FSO_HAVE_NEON
+
+static inline uint8x16_t rs_gf_mul_const_neon(uint8x16_t x, const uint8_t* table)
+{
+    uint8x16_t lo = vld1q_u8(table);
+    uint8x16_t hi = vld1q_u8(table + 16);
+    return veorq_u8(vqtbl1q_u8(lo, vandq_u8(x, vdupq_n_u8(0x0f))),
+                    vqtbl1q_u8(hi, vshrq_n_u8(x, 4)));
+}
+
+/**
+ * @brief NEON LFSR parity computation, same register layout as rs_encode_sse42()
+ */
+static void rs_encode_neon(const RSCodec* rs, const uint8_t* data, uint8_t* parity)
+{
+    _Alignas(32) uint8_t buf[256 + 2 * RS_SIMD_MAX_ROOTS];
+    const uint8_t* lo_taps = rs->encode_tables;
+    const uint8_t* hi_taps = rs->encode_tables + 16 * RS_SIMD_MAX_ROOTS;
+    const int halves = rs->num_roots <= 16 ? 16 : 32;
+    
+    memcpy(buf, data, (size_t)rs->k);
+    memset(buf + rs->k, 0, 2 * RS_SIMD_MAX_ROOTS);
+    
+    for (int i = 0; i < rs->k; i++) {
+        int feedback = buf[i];
+        if (feedback == 0) continue;
+        const uint8_t* lo_row = lo_taps + (feedback & 0x0f) * RS_SIMD_MAX_ROOTS;
+        const uint8_t* hi_row = hi_taps + (feedback >> 4) * RS_SIMD_MAX_ROOTS;
+        for (int half = 0; half < halves; half += 16) {
+            uint8x16_t taps = veorq_u8(vld1q_u8(lo_row + half), vld1q_u8(hi_row + half));
+            uint8x16_t reg = vld1q_u8(buf + i + 1 + half);
+            vst1q_u8(buf + i + 1 + half, veorq_u8(reg, taps));
+        }
+    }
+    
+    memcpy(parity, buf + rs->k, (size_t)rs->num_roots);
+}
+
+/**
+ * @brief 16-lane syndrome evaluation with TBL lookups
+ * 
+ * EXT against a zero vector gives the byte shifts of the lane folds.
+ */
+static void rs_syndrome_neon(RSCodec* rs, const uint8_t* received)
+{
+    enum { LANES = 16, FIRST_STEP = 2 };
+    _Alignas(64) uint8_t word[256];
+    const int padded = rs_pad_word(rs, received, word, LANES);
+    const uint8x16_t zero = vdupq_n_u8(0);
+    
+    for (int i = 0; i < rs->num_roots; i++) {
+        const uint8_t* step = rs->syndrome_tables +
+                              ((size_t)i * RS_SYNDROME_STEPS + FIRST_STEP) * RS_NIBBLE_TABLE_BYTES;
+        uint8x16_t acc = zero;
+        for (int pos = 0; pos < padded; pos += LANES) {
+            acc = veorq_u8(rs_gf_mul_const_neon(acc, step), vld1q_u8(word + pos));
+        }
+        
+        step += RS_NIBBLE_TABLE_BYTES;
+        acc = veorq_u8(rs_gf_mul_const_neon(acc, step), vextq_u8(acc, zero, 8));
+        step += RS_NIBBLE_TABLE_BYTES;
+        acc = veorq_u8(rs_gf_mul_const_neon(acc, step), vextq_u8(acc, zero, 4));
+        step += RS_NIBBLE_TABLE_BYTES;
+        acc = veorq_u8(rs_gf_mul_const_neon(acc, step), vextq_u8(acc, zero, 2));
+        step += RS_NIBBLE_TABLE_BYTES;
+        acc = veorq_u8(rs_gf_mul_const_neon(acc, step), vextq_u8(acc, zero, 1));
+        
+        rs->syndrome[i] = vgetq_lane_u8(acc, 0);
+    }
+}
+
+#endif /* FSO_HAVE_NEON */
+
+static const RSKernels rs_kernels_scalar = { NULL, NULL };
+
+#if FSO_HAVE_X86_SIMD
+static const RSKernels rs_kernels_sse42 = { rs_encode_sse42, rs_syndrome_sse42 };
+static const RSKernels rs_kernels_avx2 = { rs_encode_avx2, rs_syndrome_avx2 };
+static const RSKernels rs_kernels_avx512 = { rs_encode_avx2, rs_syndrome_avx512 };
+#endif
+
+#if FSO_HAVE_NEON
+static const RSKernels rs_kernels_neon = { rs_encode_neon, rs_syndrome_neon };
+#endif
+
+static const RSKernels* rs_kernels(void)
+{
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: return &rs_kernels_avx512;
+        case FSO_SIMD_AVX2:   return &rs_kernels_avx2;
+        case FSO_SIMD_SSE42:  return &rs_kernels_sse42;
+#endif
+#if FSO_HAVE_NEON
+        case FSO_SIMD_NEON:   return &rs_kernels_neon;
+#endif
+        default:              return &rs_kernels_scalar;
+    }
+}
+
+/**
+ * @brief Fill the split-nibble tables for multiplication by a constant
+ */
+static void rs_fill_nibble_table(const GaloisField* gf, int constant, uint8_t* table)
+{
+    for (int x = 0; x < 16; x++) {
+        table[x] = (uint8_t)gf_mul(gf, x, constant);
+        table[16 + x] = (uint8_t)gf_mul(gf, x << 4, constant);
+    }
+}
+
+static FSOErrorCode rs_build_simd_tables(RSCodec* rs)
+{
+    rs->use_simd = 0;
+    
+    if (!RS_HAVE_SIMD || rs->gf->symbol_size != 8 || rs->num_roots > RS_SIMD_MAX_ROOTS) {
+        return FSO_SUCCESS;
+    }
+    
+    size_t encode_bytes = 2 * 16 * RS_SIMD_MAX_ROOTS;
+    size_t syndrome_bytes = (size_t)rs->num_roots * RS_SYNDROME_STEPS * RS_NIBBLE_TABLE_BYTES;
+    rs->encode_tables = (uint8_t*)aligned_alloc(32, encode_bytes);
+    rs->syndrome_tables = (uint8_t*)aligned_alloc(32, (syndrome_bytes + 31) & ~(size_t)31);
+    if (!rs->encode_tables || !rs->syndrome_tables) {
+        return FSO_ERROR_MEMORY;
+    }
+    memset(rs->encode_tables, 0, encode_bytes);
+    
+    /* Tap j of the register multiplies by the coefficient of x^(num_roots-1-j) */
+    uint8_t* hi_taps = rs->encode_tables + 16 * RS_SIMD_MAX_ROOTS;
+    for (int x = 0; x < 16; x++) {
+        for (int j = 0; j < rs->num_roots; j++) {
+            int coefficient = rs->generator_poly[rs->gen_poly_degree - 1 - j];
+            rs->encode_tables[x * RS_SIMD_MAX_ROOTS + j] = (uint8_t)gf_mul(rs->gf, x, coefficient);
+            hi_taps[x * RS_SIMD_MAX_ROOTS + j] = (uint8_t)gf_mul(rs->gf, x << 4, coefficient);
+        }
+    }
+    
+    for (int i = 0; i < rs->num_roots; i++) {
+        int root = gf_pow(rs->gf, 2, rs->fcr + i);
+        uint8_t* tables = rs->syndrome_tables +
+                          (size_t)i * RS_SYNDROME_STEPS * RS_NIBBLE_TABLE_BYTES;
+        for (int s = 0; s < RS_SYNDROME_STEPS; s++) {
+            int multiplier = gf_pow(rs->gf, root, 1 << (RS_SYNDROME_STEPS - 1 - s));
+            rs_fill_nibble_table(rs->gf, multiplier, tables + s * RS_NIBBLE_TABLE_BYTES);
+        }
+    }
+    
+    rs->use_simd = 1;
+    FSO_LOG_DEBUG(RS_MODULE, "Split-nibble GF(2^8) kernels enabled for %d roots", rs->num_roots);
+    
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -507,6 +1269,15 @@ static FSOErrorCode gf_build_tables(GaloisField* gf)
     return FSO_SUCCESS;
 }
 
+/**
+ * @brief Add two GF logarithms modulo the multiplicative order
+ */
+static inline int gf_log_add(int log_a, int log_b, int order)
+{
+    int sum = log_a + log_b;
+    return (sum >= order) ? sum - order : sum;
+}
+
 static int gf_mul_no_table(int a, int b, int primitive_poly, int field_size)
 {
     int result = 0;
@@ -25,6 +25,7 @@
 /* Common Reed-Solomon configurations */
 #define RS_SYMBOL_SIZE_8 8           /**< 8-bit symbols (most common) */
 #define RS_PRIMITIVE_POLY_8 0x11d    /**< Primitive polynomial for GF(256) */
+#define RS_SIMD_MAX_ROOTS 32         /**< Largest 2t handled by the vectorized GF(2^8) kernels */
 
 /* ============================================================================
  * Reed-Solomon Structures
@@ -69,10 +70,20 @@ typedef struct {
     
     /* Workspace for encoding/decoding */
     int* syndrome;          /**< Syndrome calculation workspace */
-    int* error_locator;     /**< Error locator polynomial */
-    int* error_evaluator;   /**< Error evaluator polynomial */
-    int* error_positions;   /**< Error position array */
-    int* error_values;      /**< Error value array */
+    int* error_locator;     /**< Errata locator polynomial (num_roots + 1 coefficients) */
+    int* error_evaluator;   /**< Errata evaluator polynomial (num_roots coefficients) */
+    int* error_positions;   /**< Errata positions as codeword indices */
+    int* error_values;      /**< Errata magnitudes matching error_positions */
+    int* locator_scratch;   /**< Berlekamp-Massey correction/temporary polynomials */
+    
+    /* Erasures supplied to the current decode (codeword indices) */
+    const int* erasure_positions; /**< Erased symbol positions, or NULL */
+    int num_erasures;       /**< Number of erased symbols */
+    
+    /* Split-nibble GF(2^8) multiply tables: x * c = lo[x & 15] ^ hi[x >> 4] */
+    int use_simd;           /**< 1 when the vectorized encode/syndrome kernels are active */
+    uint8_t* encode_tables; /**< Generator tap products: [2][16][RS_SIMD_MAX_ROOTS] bytes */
+    uint8_t* syndrome_tables; /**< Per root: multiply by alpha^((fcr+i)*2^s), s = 6..0, as lo/hi pairs */
 } RSCodec;
 
 /* ============================================================================
@@ -251,6 +262,9 @@ FSOErrorCode rs_generate_generator_polynomial(RSCodec* rs);
  * 
  * Performs systematic Reed-Solomon encoding. The input data is treated as
  * the information part of the codeword, and parity symbols are appended.
+ * Symbol 0 is the highest-degree coefficient of the codeword polynomial.
+ * 8-bit codes with up to RS_SIMD_MAX_ROOTS roots run the LFSR division
+ * with 16/32-byte vector XORs on CPUs with SSE4.2/AVX2 or NEON.
  * 
  * @param rs Pointer to Reed-Solomon codec
  * @param data Input data symbols
@@ -266,7 +280,9 @@ FSOErrorCode rs_encode(RSCodec* rs, const uint8_t* data, size_t data_len,
  * @brief Calculate syndrome for received codeword
  * 
  * Computes the syndrome S_i = r(α^(fcr+i)) for i = 0, 1, ..., num_roots-1
- * where r(x) is the received polynomial.
+ * where r(x) is the received polynomial. For 8-bit codes built with SSSE3
+ * the word is split into 16 (32 with AVX2) interleaved sub-words that are
+ * evaluated together with PSHUFB multiplies and folded at the end.
  * 
  * @param rs Pointer to Reed-Solomon codec
  * @param received Received codeword
@@ -286,10 +302,12 @@ int rs_has_errors(const RSCodec* rs);
 /**
  * @brief Berlekamp-Massey algorithm for error locator polynomial
  * 
- * Computes the error locator polynomial Λ(x) from the syndrome.
+ * Computes the error locator polynomial Λ(x) from the syndrome. When
+ * rs->num_erasures is non-zero the iteration is seeded with the erasure
+ * locator, so the result locates erasures and errors together (errata).
  * 
  * @param rs Pointer to Reed-Solomon codec
- * @return Number of errors found, or -1 on failure
+ * @return Degree of the errata locator, or -1 if it exceeds the capability
  */
 int rs_berlekamp_massey(RSCodec* rs);
 
@@ -297,11 +315,13 @@ int rs_berlekamp_massey(RSCodec* rs);
  * @brief Chien search for error locations
  * 
  * Finds the roots of the error locator polynomial to determine
- * error positions in the received codeword.
+ * error positions in the received codeword. Each locator term is kept in
+ * the log domain and advanced by a constant step per position, so no
+ * polynomial evaluation or exponentiation runs inside the search loop.
  * 
  * @param rs Pointer to Reed-Solomon codec
  * @param num_errors Number of errors from Berlekamp-Massey
- * @return Number of error positions found
+ * @return Number of error positions found (differs from num_errors when uncorrectable)
  */
 int rs_chien_search(RSCodec* rs, int num_errors);
 
@@ -323,7 +343,8 @@ FSOErrorCode rs_forney_algorithm(RSCodec* rs, int num_errors);
  * Performs Reed-Solomon decoding with error correction. The function
  * calculates syndromes, finds error locations using Berlekamp-Massey
  * and Chien search, computes error values using Forney algorithm,
- * and corrects the errors.
+ * and corrects the errors. A zero syndrome returns immediately after
+ * copying the information symbols, without touching the locator workspace.
  * 
  * @param rs Pointer to Reed-Solomon codec
  * @param received Received codeword (may contain errors)
@@ -331,11 +352,34 @@ FSOErrorCode rs_forney_algorithm(RSCodec* rs, int num_errors);
  * @param decoded Output decoded data
  * @param decoded_len Length of output buffer
  * @param errors_corrected Pointer to store number of errors corrected (can be NULL)
- * @return FSO_SUCCESS on success, error code on failure
+ * @return FSO_SUCCESS on success, FSO_ERROR_CONVERGENCE if uncorrectable
  */
 FSOErrorCode rs_decode(RSCodec* rs, const uint8_t* received, size_t received_len,
                        uint8_t* decoded, size_t decoded_len, int* errors_corrected);
 
+/**
+ * @brief Decode received codeword with known erasure positions
+ * 
+ * Like rs_decode(), but symbols listed in erasure_positions (for example
+ * slots the demodulator flagged as low confidence) are treated as
+ * erasures. A code with num_roots parity symbols corrects any combination
+ * of e errors and f erasures with 2e + f <= num_roots, so erasures cost
+ * half as much correction capability as unknown errors.
+ * 
+ * @param rs Pointer to Reed-Solomon codec
+ * @param received Received codeword (may contain errors)
+ * @param received_len Length of received codeword
+ * @param erasure_positions Codeword indices of erased symbols (can be NULL if num_erasures is 0)
+ * @param num_erasures Number of erased symbols (<= num_roots)
+ * @param decoded Output decoded data
+ * @param decoded_len Length of output buffer
+ * @param errors_corrected Pointer to store number of symbols corrected (can be NULL)
+ * @return FSO_SUCCESS on success, FSO_ERROR_CONVERGENCE if uncorrectable
+ */
+FSOErrorCode rs_decode_erasures(RSCodec* rs, const uint8_t* received, size_t received_len,
+                                const int* erasure_positions, int num_erasures,
+                                uint8_t* decoded, size_t decoded_len, int* errors_corrected);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -14,6 +14,16 @@
 #include <stdio.h>
 #include <time.h>
 
+/* ============================================================================
+ * Library Version
+ * ============================================================================ */
+
+/** Bump when a change alters simulation results (keys the result cache) */
+#define FSO_VERSION_MAJOR 1
+#define FSO_VERSION_MINOR 0
+#define FSO_VERSION_PATCH 0
+#define FSO_VERSION_STRING "1.0.0"
+
 /* ============================================================================
  * Error Codes
  * ============================================================================ */
@@ -34,6 +44,8 @@ typedef enum {
 
 /**
  * @brief Complex number representation
+ * 
+ * Same memory layout as C99 double complex and fftw_complex.
  */
 typedef struct {
     double real;  /**< Real component */
@@ -50,6 +62,52 @@ typedef struct {
     double timestamp;        /**< Timestamp of first sample */
 } SignalBuffer;
 
+/**
+ * @brief Numeric format of the sample and LLR path
+ * 
+ * Single precision halves the memory traffic of symbol buffers and
+ * doubles the SIMD width of the kernels that touch them. The fixed-point
+ * modes also quantize the decoder's LLR messages.
+ */
+typedef enum {
+    FSO_PRECISION_DOUBLE = 0, /**< double symbols, float LLRs, double decoder messages */
+    FSO_PRECISION_SINGLE,     /**< float symbols and LLRs */
+    FSO_PRECISION_INT16,      /**< float symbols, 16-bit fixed-point decoder messages */
+    FSO_PRECISION_INT8        /**< float symbols, 8-bit range decoder messages */
+} FSOPrecision;
+
+/**
+ * @brief Alignment of FSOComplexBuffer storage in bytes (one cache line)
+ */
+#define FSO_BUFFER_ALIGN 64
+
+/**
+ * @brief Memory layout of an FSOComplexBuffer
+ */
+typedef enum {
+    FSO_LAYOUT_INTERLEAVED = 0, /**< re, im pairs (ComplexSample, double complex, fftw_complex) */
+    FSO_LAYOUT_SPLIT            /**< Separate real and imaginary planes (SoA) */
+} FSOComplexLayout;
+
+/**
+ * @brief Aligned complex sample buffer shared by FFT, DSP and DPSK code
+ * 
+ * Sample i is (real[i * stride], imag[i * stride]) in either layout, so
+ * kernels can be written once. Interleaved buffers can be handed to code
+ * that takes ComplexSample or double complex arrays without copying;
+ * split buffers keep each plane contiguous for vector loops. Both planes
+ * of a split buffer start on an FSO_BUFFER_ALIGN boundary.
+ */
+typedef struct {
+    FSOComplexLayout layout; /**< Interleaved or split */
+    size_t length;           /**< Samples in use */
+    size_t capacity;         /**< Samples the storage holds */
+    size_t stride;           /**< Doubles between consecutive samples (2 or 1) */
+    double* real;            /**< Real part of sample 0 */
+    double* imag;            /**< Imaginary part of sample 0 */
+    double* storage;         /**< Owned aligned storage (NULL for wrapped views) */
+} FSOComplexBuffer;
+
 /**
  * @brief Modulation type enumeration
  */
@@ -128,6 +186,74 @@ static inline char* fso_get_timestamp(char* buffer) {
     return buffer;
 }
 
+/**
+ * @brief Lowest log level compiled in
+ * 
+ * FSO_LOG calls below this level fold to a constant false test and
+ * compile away, arguments included. Release builds (NDEBUG) default to
+ * LOG_INFO; build with -DFSO_LOG_COMPILE_LEVEL=LOG_DEBUG to keep debug
+ * messages there.
+ */
+#ifndef FSO_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define FSO_LOG_COMPILE_LEVEL LOG_INFO
+#else
+#define FSO_LOG_COMPILE_LEVEL LOG_DEBUG
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define FSO_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define FSO_PRINTF_FORMAT(fmt, args)
+#endif
+
+/**
+ * @brief Emit one log record (use the FSO_LOG macros instead)
+ * 
+ * Formats "[timestamp] [LEVEL] [module] message". Synchronous mode writes
+ * the line to stderr at once. After fso_log_async_start(), the record goes
+ * to the calling thread's ring buffer and the flusher thread writes it.
+ * 
+ * @param level Log level
+ * @param module Module name
+ * @param format Printf-style format string
+ * @param ... Variable arguments
+ */
+void fso_log_message(LogLevel level, const char* module, const char* format, ...)
+    FSO_PRINTF_FORMAT(3, 4);
+
+/**
+ * @brief Move logging to per-thread rings drained by a background thread
+ * 
+ * Each logging thread gets a lock-free single-producer ring on its first
+ * message. Producers stamp records with the monotonic clock and never
+ * block on the stream. The flusher merges the rings by timestamp. When a
+ * ring is full, DEBUG/INFO/WARN records are dropped and counted, while
+ * ERROR records wait for space.
+ * 
+ * @param stream Output stream (NULL for stderr)
+ * @return FSO_SUCCESS on success, FSO_ERROR_UNSUPPORTED without POSIX
+ *         threads, FSO_ERROR_MEMORY if the flusher cannot start
+ */
+int fso_log_async_start(FILE* stream);
+
+/**
+ * @brief Flush every queued record, stop the flusher and log synchronously
+ * 
+ * Warns if any records were dropped. Safe to call when asynchronous
+ * logging is not running; start and stop are not thread-safe with each
+ * other.
+ */
+void fso_log_async_stop(void);
+
+/**
+ * @brief Records dropped on full rings since fso_log_async_start()
+ * 
+ * @return Dropped record count
+ */
+unsigned long long fso_log_async_dropped(void);
+
 /**
  * @brief Log a message with specified level
  * @param level Log level
@@ -137,12 +263,8 @@ static inline char* fso_get_timestamp(char* buffer) {
  */
 #define FSO_LOG(level, module, format, ...) \
     do { \
-        if (level >= g_log_level) { \
-            char timestamp[32]; \
-            fso_get_timestamp(timestamp); \
-            const char* level_str[] = {"DEBUG", "INFO", "WARN", "ERROR"}; \
-            fprintf(stderr, "[%s] [%s] [%s] " format "\n", \
-                    timestamp, level_str[level], module, ##__VA_ARGS__); \
+        if ((level) >= FSO_LOG_COMPILE_LEVEL && (level) >= g_log_level) { \
+            fso_log_message((level), (module), format, ##__VA_ARGS__); \
         } \
     } while(0)
 
@@ -154,6 +276,318 @@ static inline char* fso_get_timestamp(char* buffer) {
 #define FSO_LOG_WARNING(module, format, ...) FSO_LOG(LOG_WARNING, module, format, ##__VA_ARGS__)
 #define FSO_LOG_ERROR(module, format, ...)   FSO_LOG(LOG_ERROR, module, format, ##__VA_ARGS__)
 
+/**
+ * @brief Debug logging on per-packet and per-sample paths
+ * 
+ * Compiled out of release builds (NDEBUG) even when
+ * FSO_LOG_COMPILE_LEVEL keeps other debug messages; the arguments are
+ * still type-checked. Same as FSO_LOG_DEBUG otherwise.
+ */
+#ifdef NDEBUG
+#define FSO_LOG_HOT(module, format, ...) \
+    do { if (0) FSO_LOG_DEBUG(module, format, ##__VA_ARGS__); } while(0)
+#else
+#define FSO_LOG_HOT(module, format, ...)     FSO_LOG_DEBUG(module, format, ##__VA_ARGS__)
+#endif
+
+/* ============================================================================
+ * Profiling
+ * ============================================================================ */
+
+/**
+ * @brief Instrumented pipeline stages
+ */
+typedef enum {
+    FSO_PROF_ENCODE = 0,     /**< FEC encoding */
+    FSO_PROF_INTERLEAVE,     /**< Transmit-side interleaving */
+    FSO_PROF_MODULATE,       /**< Symbol mapping */
+    FSO_PROF_FADE,           /**< Fade sample / profile generation */
+    FSO_PROF_CHANNEL,        /**< Gain, AWGN and importance-sampling shift */
+    FSO_PROF_DEMODULATE,     /**< Hard or soft demodulation */
+    FSO_PROF_DEINTERLEAVE,   /**< Receive-side deinterleaving */
+    FSO_PROF_DECODE,         /**< FEC decoding */
+    FSO_PROF_FFT,            /**< Forward and inverse FFTs */
+    FSO_PROF_TRACKING,       /**< Beam-tracking controller updates */
+    FSO_PROF_ZONE_COUNT
+} FSOProfileZone;
+
+/**
+ * @brief Latency statistics of one zone
+ */
+typedef struct {
+    uint64_t count;          /**< Completed zone entries */
+    double total_ns;         /**< Summed time in nanoseconds */
+    double mean_ns;          /**< Mean latency in nanoseconds */
+    double p50_ns;           /**< Median latency in nanoseconds */
+    double p99_ns;           /**< 99th-percentile latency in nanoseconds */
+    double max_ns;           /**< Longest entry in nanoseconds */
+} FSOProfileStats;
+
+/**
+ * @brief Open and close a profiling zone
+ *
+ * FSO_PROF_BEGIN declares a local holding the start timestamp, so a zone
+ * opens and closes in the same block and each zone appears at most once
+ * per block. Both compile to nothing unless FSO_ENABLE_PROFILING is
+ * defined (make PROFILE=1).
+ */
+#ifdef FSO_ENABLE_PROFILING
+#define FSO_PROF_BEGIN(zone) const uint64_t fso_prof_start_##zone = fso_profile_now()
+#define FSO_PROF_END(zone)   fso_profile_record((zone), fso_prof_start_##zone)
+#else
+#define FSO_PROF_BEGIN(zone) ((void)0)
+#define FSO_PROF_END(zone)   ((void)0)
+#endif
+
+/**
+ * @brief Whether this build records profiling zones
+ *
+ * @return 1 if compiled with FSO_ENABLE_PROFILING, 0 otherwise
+ */
+int fso_profile_available(void);
+
+/**
+ * @brief Current profiler timestamp in ticks (TSC on x86, nanoseconds elsewhere)
+ */
+uint64_t fso_profile_now(void);
+
+/**
+ * @brief Record one completed zone entry on the calling thread
+ *
+ * @param zone Zone being closed
+ * @param start_ticks Timestamp from fso_profile_now() at zone entry
+ */
+void fso_profile_record(FSOProfileZone zone, uint64_t start_ticks);
+
+/**
+ * @brief Clear every thread's counters and trace events
+ *
+ * Call between runs, while no zone is open.
+ */
+void fso_profile_reset(void);
+
+/**
+ * @brief Aggregate all threads' counters since the last reset
+ *
+ * @param stats Output array of FSO_PROF_ZONE_COUNT entries
+ */
+void fso_profile_snapshot(FSOProfileStats* stats);
+
+/**
+ * @brief Short lowercase name of a zone
+ */
+const char* fso_profile_zone_name(FSOProfileZone zone);
+
+/**
+ * @brief Keep individual zone entries for trace export
+ *
+ * @param events_per_thread Entries kept per thread after each reset (0 disables)
+ * @return FSO_SUCCESS or FSO_ERROR_UNSUPPORTED without FSO_ENABLE_PROFILING
+ */
+int fso_profile_trace_enable(size_t events_per_thread);
+
+/**
+ * @brief Write kept entries as Chrome trace-event JSON
+ *
+ * The file loads in chrome://tracing and Perfetto, one track per thread.
+ *
+ * @param filename Output path
+ * @return FSO_SUCCESS or error code
+ */
+int fso_profile_write_trace(const char* filename);
+
+/* ============================================================================
+ * Thread Pool
+ * ============================================================================ */
+
+/**
+ * @brief Placement of pool workers on cores
+ */
+typedef enum {
+    FSO_AFFINITY_NONE = 0,   /**< Unpinned; the scheduler places workers */
+    FSO_AFFINITY_COMPACT,    /**< Fill one NUMA node's cores before the next */
+    FSO_AFFINITY_SCATTER     /**< Deal workers round-robin across NUMA nodes */
+} FSOAffinityMode;
+
+/**
+ * @brief Thread pool configuration
+ */
+typedef struct {
+    int num_threads;         /**< Workers (0 = omp_get_max_threads() or allowed CPUs) */
+    FSOAffinityMode affinity;/**< Core placement */
+} FSOThreadPoolConfig;
+
+/**
+ * @brief Body of a parallel loop
+ *
+ * @param context Caller data
+ * @param begin First index of the range
+ * @param end One past the last index
+ * @param worker Worker slot in [0, workers); never run by two threads at once
+ */
+typedef void (*FSOParallelFn)(void* context, size_t begin, size_t end, int worker);
+
+/**
+ * @brief Start the process-wide worker pool
+ *
+ * Workers are spawned once and sleep between jobs. With an affinity mode
+ * each worker pins itself before running anything, so memory it
+ * allocates and first touches stays on its NUMA node. The first
+ * configuration wins: while a pool is running this returns FSO_SUCCESS
+ * without changes; call fso_threadpool_shutdown() to reconfigure.
+ * fso_parallel_for() starts a default pool if none is running.
+ *
+ * @param config Configuration (NULL for defaults, unpinned)
+ * @return FSO_SUCCESS, or FSO_ERROR_MEMORY if no worker could start
+ */
+int fso_threadpool_init(const FSOThreadPoolConfig* config);
+
+/**
+ * @brief Stop and join the workers
+ *
+ * Must not race with fso_parallel_for() or fso_threadpool_init().
+ */
+void fso_threadpool_shutdown(void);
+
+/**
+ * @brief Workers in the running pool (1 when none is running)
+ */
+int fso_threadpool_size(void);
+
+/**
+ * @brief Worker index of the calling thread, or -1 outside the pool
+ */
+int fso_threadpool_worker(void);
+
+/**
+ * @brief Run fn over [0, count) on the pool and wait for it
+ *
+ * With grain 0 the range is split into one contiguous block per worker
+ * and block w always runs on worker w, so per-worker data first touched
+ * by worker w stays local across calls. With grain > 0 workers claim
+ * chunks of grain indices dynamically. Calls from inside a pool worker,
+ * or while another thread's job holds the pool, run on the caller; static
+ * blocks then run in turn with their own worker slots.
+ *
+ * @param count Number of indices
+ * @param grain Indices per dynamic chunk (0 = static blocks)
+ * @param max_workers Upper bound on workers (0 = pool size)
+ * @param fn Loop body
+ * @param context Passed to fn
+ */
+void fso_parallel_for(size_t count, size_t grain, int max_workers,
+                      FSOParallelFn fn, void* context);
+
+/* ============================================================================
+ * CPU Feature Dispatch
+ * ============================================================================ */
+
+/**
+ * @brief Instruction-set features found at run time
+ */
+typedef enum {
+    FSO_CPU_SSE2 = 1u << 0,
+    FSO_CPU_SSSE3 = 1u << 1,
+    FSO_CPU_SSE42 = 1u << 2,
+    FSO_CPU_POPCNT = 1u << 3,
+    FSO_CPU_AVX2 = 1u << 4,
+    FSO_CPU_FMA = 1u << 5,
+    FSO_CPU_AVX512F = 1u << 6,
+    FSO_CPU_AVX512BW = 1u << 7,
+    FSO_CPU_AVX512VL = 1u << 8,
+    FSO_CPU_NEON = 1u << 9
+} FSOCpuFeature;
+
+/**
+ * @brief Kernel variant families, in order of preference on x86
+ */
+typedef enum {
+    FSO_SIMD_SCALAR = 0,     /**< Portable C, vectorized only for the build's baseline ISA */
+    FSO_SIMD_SSE42,          /**< SSE4.2 + POPCNT (x86-64-v2) */
+    FSO_SIMD_AVX2,           /**< AVX2 + POPCNT (x86-64-v3 without FMA) */
+    FSO_SIMD_AVX512,         /**< AVX-512 F/BW/VL */
+    FSO_SIMD_NEON,           /**< AArch64 Advanced SIMD */
+    FSO_SIMD_LEVELS
+} FSOSimdLevel;
+
+/*
+ * Attributes for kernel variants compiled beside the baseline code. They
+ * add to the command-line ISA, so a -march=native build still compiles
+ * every variant. FMA is left out and contraction is off for AVX-512
+ * (which encodes FMA), so float kernels round like the scalar path.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FSO_HAVE_X86_SIMD 1
+#define FSO_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define FSO_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define FSO_TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512bw,avx512vl,avx2,popcnt"), optimize("fp-contract=off")))
+#else
+#define FSO_HAVE_X86_SIMD 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FSO_HAVE_NEON 1
+#else
+#define FSO_HAVE_NEON 0
+#endif
+
+/** Body shared by several target variants; inlined into each */
+#if defined(__GNUC__)
+#define FSO_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define FSO_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief Features of the running CPU (FSOCpuFeature bits)
+ *
+ * Probed once on first use, including OS support for the AVX state.
+ */
+unsigned int fso_cpu_features(void);
+
+/**
+ * @brief Widest kernel family the running CPU supports
+ */
+FSOSimdLevel fso_cpu_best_level(void);
+
+/**
+ * @brief Kernel family in use
+ *
+ * Starts at fso_cpu_best_level(), capped by the FSO_SIMD environment
+ * variable (a name accepted by fso_cpu_parse_simd_level()). Kernels
+ * without a variant for this family use the next narrower one.
+ */
+FSOSimdLevel fso_cpu_simd_level(void);
+
+/**
+ * @brief Select the kernel family, e.g. to compare variants on one machine
+ *
+ * Not synchronized with running kernels; call between runs.
+ *
+ * @param level Kernel family
+ * @return FSO_SUCCESS, or FSO_ERROR_UNSUPPORTED if the CPU lacks it
+ */
+int fso_cpu_set_simd_level(FSOSimdLevel level);
+
+/**
+ * @brief Whether the running CPU can execute a kernel family
+ */
+int fso_cpu_simd_supported(FSOSimdLevel level);
+
+/**
+ * @brief Name of a kernel family ("scalar", "sse4.2", "avx2", "avx512", "neon")
+ */
+const char* fso_cpu_simd_name(FSOSimdLevel level);
+
+/**
+ * @brief Parse a kernel family name
+ * @param name Name as printed by fso_cpu_simd_name() (case-insensitive)
+ * @param level Output family
+ * @return FSO_SUCCESS or FSO_ERROR_INVALID_PARAM
+ */
+int fso_cpu_parse_simd_level(const char* name, FSOSimdLevel* level);
+
 /* ============================================================================
  * Utility Macros
  * ============================================================================ */
@@ -275,6 +709,224 @@ ComplexSample fso_complex_from_polar(double magnitude, double phase);
  */
 ComplexSample fso_complex_scale(ComplexSample c, double scalar);
 
+/* ============================================================================
+ * Complex Buffers
+ * ============================================================================ */
+
+/**
+ * @brief Allocate an aligned complex buffer
+ * @param buffer Buffer to initialize (length starts at 0)
+ * @param capacity Number of samples to hold
+ * @param layout Interleaved or split
+ * @return FSO_SUCCESS or error code
+ */
+int fso_complex_buffer_init(FSOComplexBuffer* buffer, size_t capacity,
+                            FSOComplexLayout layout);
+
+/**
+ * @brief Wrap an existing sample array as an interleaved buffer view
+ * 
+ * No memory is copied or owned; the array must outlive the view. Works
+ * for double complex and fftw_complex arrays cast to ComplexSample*.
+ * 
+ * @param buffer View to initialize (length = capacity = length)
+ * @param samples Sample array
+ * @param length Number of samples
+ */
+void fso_complex_buffer_wrap(FSOComplexBuffer* buffer, ComplexSample* samples,
+                             size_t length);
+
+/**
+ * @brief Free a buffer's storage (views are only reset)
+ * @param buffer Buffer to free
+ */
+void fso_complex_buffer_free(FSOComplexBuffer* buffer);
+
+/**
+ * @brief Interleaved sample array of a buffer
+ * @param buffer Complex buffer
+ * @return Samples, or NULL for a split buffer
+ */
+ComplexSample* fso_complex_buffer_samples(const FSOComplexBuffer* buffer);
+
+/**
+ * @brief Change a buffer's layout, keeping its samples
+ * 
+ * Converting an owned buffer reallocates it; wrapped views cannot change
+ * layout.
+ * 
+ * @param buffer Buffer to convert
+ * @param layout Target layout
+ * @return FSO_SUCCESS or error code
+ */
+int fso_complex_buffer_set_layout(FSOComplexBuffer* buffer, FSOComplexLayout layout);
+
+/**
+ * @brief Copy samples into a buffer and set its length
+ * @param buffer Destination buffer (either layout)
+ * @param samples Source samples
+ * @param length Number of samples (<= capacity)
+ * @return FSO_SUCCESS or error code
+ */
+int fso_complex_buffer_import(FSOComplexBuffer* buffer, const ComplexSample* samples,
+                              size_t length);
+
+/**
+ * @brief Copy a buffer's samples out to an interleaved array
+ * @param buffer Source buffer (either layout)
+ * @param samples Destination array (size >= buffer length)
+ * @return FSO_SUCCESS or error code
+ */
+int fso_complex_buffer_export(const FSOComplexBuffer* buffer, ComplexSample* samples);
+
+/* ============================================================================
+ * Capture Files
+ * ============================================================================ */
+
+/**
+ * @brief Sample format of a capture file
+ */
+typedef enum {
+    FSO_CAPTURE_REAL_F64 = 0,   /**< double detector samples */
+    FSO_CAPTURE_REAL_F32,       /**< float detector samples */
+    FSO_CAPTURE_COMPLEX_F64     /**< ComplexSample (re, im double pairs) */
+} FSOCaptureType;
+
+/** Bytes before sample 0; keeps the samples cache-line aligned in a mapping */
+#define FSO_CAPTURE_HEADER_SIZE 64
+
+/**
+ * @brief Capture header fields
+ */
+typedef struct {
+    FSOCaptureType type;        /**< Sample format */
+    double sample_rate;         /**< Sampling rate in Hz */
+    double timestamp;           /**< Time of sample 0 in seconds (e.g. UNIX time) */
+    uint64_t num_samples;       /**< Samples in the file */
+} FSOCaptureInfo;
+
+/**
+ * @brief Capture file opened through a copy-on-write memory mapping
+ */
+typedef struct {
+    FSOCaptureInfo info;        /**< Header */
+    uint8_t* map;               /**< Whole-file mapping (NULL when closed) */
+    size_t map_size;            /**< Mapped bytes */
+    uint8_t* samples;           /**< Sample 0 */
+    size_t sample_size;         /**< Bytes per sample */
+} FSOCaptureReader;
+
+/**
+ * @brief Capture file being written
+ */
+typedef struct {
+    FILE* fp;                   /**< Output file */
+    FSOCaptureInfo info;        /**< Header; num_samples counts appended samples */
+    int error;                  /**< First write error (FSO_SUCCESS if none) */
+} FSOCaptureWriter;
+
+/**
+ * @brief Bytes per sample of a capture format
+ * @param type Sample format
+ * @return Sample size, or 0 for an unknown format
+ */
+size_t fso_capture_sample_size(FSOCaptureType type);
+
+/**
+ * @brief Create a capture file and write its header
+ * @param writer Writer to initialize
+ * @param path Output file
+ * @param type Sample format
+ * @param sample_rate Sampling rate in Hz
+ * @param timestamp Time of the first sample in seconds
+ * @return FSO_SUCCESS or error code
+ */
+int fso_capture_writer_open(FSOCaptureWriter* writer, const char* path, FSOCaptureType type,
+                            double sample_rate, double timestamp);
+
+/**
+ * @brief Append samples in the writer's format
+ * @param writer Open writer
+ * @param samples Sample array
+ * @param count Number of samples
+ * @return FSO_SUCCESS or error code
+ */
+int fso_capture_writer_append(FSOCaptureWriter* writer, const void* samples, size_t count);
+
+/**
+ * @brief Write the final sample count into the header and close the file
+ * 
+ * A file whose writer never closed has a count of 0, and readers take the
+ * count from the file size instead.
+ * 
+ * @param writer Writer to close
+ * @return FSO_SUCCESS or the first error seen while writing
+ */
+int fso_capture_writer_close(FSOCaptureWriter* writer);
+
+/**
+ * @brief Map a capture file and validate its header
+ * 
+ * The file is mapped copy-on-write, so views may be modified in place
+ * without touching the file. The whole mapping is advised sequential;
+ * nothing is read until samples are touched.
+ * 
+ * @param reader Reader to initialize
+ * @param path Capture file
+ * @return FSO_SUCCESS, FSO_ERROR_IO if the file cannot be mapped or is not
+ *         a capture, FSO_ERROR_UNSUPPORTED for another byte order
+ */
+int fso_capture_open(FSOCaptureReader* reader, const char* path);
+
+/**
+ * @brief Unmap a capture file
+ * @param reader Reader to close
+ */
+void fso_capture_close(FSOCaptureReader* reader);
+
+/**
+ * @brief Pointer to sample first in the mapping (any format)
+ * @param reader Open reader
+ * @param first Sample index
+ * @return Samples in the header's format, or NULL past the end
+ */
+const void* fso_capture_samples(const FSOCaptureReader* reader, size_t first);
+
+/**
+ * @brief SignalBuffer view of samples [first, first + count) of a complex capture
+ * 
+ * No samples are copied: view->samples points into the mapping, and
+ * view->timestamp is the header timestamp plus first / sample_rate.
+ * 
+ * @param reader Open reader of an FSO_CAPTURE_COMPLEX_F64 file
+ * @param first First sample
+ * @param count Number of samples (clamped to the end of the file)
+ * @param view Output view
+ * @return FSO_SUCCESS, FSO_ERROR_UNSUPPORTED for real captures
+ */
+int fso_capture_view(const FSOCaptureReader* reader, size_t first, size_t count,
+                     SignalBuffer* view);
+
+/**
+ * @brief Ask the kernel to start reading samples [first, first + count)
+ * @param reader Open reader
+ * @param first First sample
+ * @param count Number of samples
+ */
+void fso_capture_prefetch(const FSOCaptureReader* reader, size_t first, size_t count);
+
+/**
+ * @brief Drop the pages of consumed samples [first, first + count)
+ * 
+ * Keeps the resident set bounded when streaming files larger than memory.
+ * Only pages entirely inside the range are released.
+ * 
+ * @param reader Open reader
+ * @param first First sample
+ * @param count Number of samples
+ */
+void fso_capture_release(const FSOCaptureReader* reader, size_t first, size_t count);
+
 /* ============================================================================
  * Signal Power Calculations
  * ============================================================================ */
@@ -295,6 +947,16 @@ double fso_signal_power_real(const double* signal, size_t length);
  */
 double fso_signal_power_complex(const ComplexSample* signal, size_t length);
 
+/**
+ * @brief Calculate average power of a complex buffer
+ * 
+ * Split buffers run as a vector loop over the two planes.
+ * 
+ * @param buffer Complex buffer (either layout)
+ * @return Average power of the buffer's length samples
+ */
+double fso_complex_buffer_power(const FSOComplexBuffer* buffer);
+
 /**
  * @brief Calculate RMS value of real signal
  * @param signal Array of signal samples
@@ -319,6 +981,23 @@ double fso_signal_peak_power(const double* signal, size_t length);
  */
 double fso_calculate_snr(double signal_power, double noise_power);
 
+/* ============================================================================
+ * Bit Error Counting
+ * ============================================================================ */
+
+/**
+ * @brief Count differing bits between two byte buffers
+ * 
+ * XOR + popcount over 8-byte words (POPCNT), 32/64-byte vectors
+ * (AVX2/AVX-512BW nibble lookup) or NEON CNT, picked at run time.
+ * 
+ * @param a First buffer
+ * @param b Second buffer
+ * @param length Bytes to compare
+ * @return Number of differing bits (0 for NULL or empty input)
+ */
+size_t fso_count_bit_errors(const uint8_t* a, const uint8_t* b, size_t length);
+
 /* ============================================================================
  * dB Conversion Utilities
  * ============================================================================ */
@@ -369,6 +1048,109 @@ double fso_db_to_amplitude(double db_value);
  * Random Number Generation
  * ============================================================================ */
 
+/*
+ * Generator: Philox4x32-10 (counter-based). The 128-bit counter is
+ * (block index, packet, stream id) and the key is the 64-bit run seed, so
+ * each (run, packet, stream) triple names an independent, reproducible
+ * sequence regardless of thread count or scheduling.
+ */
+
+/** 32-bit words buffered per stream (16 Philox blocks per refill) */
+#define FSO_RNG_BUFFER_WORDS 64
+
+/**
+ * @brief Stream ids used by the simulator for per-packet draws
+ */
+typedef enum {
+    FSO_RNG_STREAM_DATA = 0,      /**< Payload bits */
+    FSO_RNG_STREAM_NOISE = 1,     /**< Receiver AWGN */
+    FSO_RNG_STREAM_CHANNEL = 2,   /**< Fading and channel noise */
+    FSO_RNG_STREAM_PHASE_SCREEN = 3, /**< Turbulence phase screens (packet word = draw index) */
+    FSO_RNG_STREAM_TRACKING = 4   /**< Beam tracking measurements and jitter */
+} FSORandomStreamId;
+
+/** Stream id of a packet stream for HARQ transmission round (round 0 = the stream itself) */
+#define FSO_RNG_STREAM_ROUND(stream, round) ((uint32_t)(stream) | ((uint32_t)(round) << 8))
+
+/**
+ * @brief Counter-based random stream
+ */
+typedef struct {
+    uint64_t seed;                /**< Run seed (Philox key) */
+    uint32_t key[2];              /**< Key words */
+    uint32_t packet;              /**< Counter word: packet index */
+    uint32_t stream_id;           /**< Counter word: stream id */
+    uint64_t block;               /**< Next counter block index */
+    uint32_t buffer[FSO_RNG_BUFFER_WORDS]; /**< Generated words */
+    int position;                 /**< Next unread word in buffer */
+    int initialized;              /**< Non-zero once seeded */
+} FSORandomStream;
+
+/**
+ * @brief Seed a stream for a (run, packet, stream id) triple
+ * @param stream Stream to initialize
+ * @param run_seed Run seed
+ * @param packet Packet index
+ * @param stream_id Stream id within the packet (see FSORandomStreamId)
+ */
+void fso_random_stream_init(FSORandomStream* stream, uint64_t run_seed,
+                            uint32_t packet, uint32_t stream_id);
+
+/**
+ * @brief Next 32 random bits from a stream
+ * @param stream Initialized stream
+ * @return Uniform 32-bit value
+ */
+uint32_t fso_random_stream_next(FSORandomStream* stream);
+
+/**
+ * @brief Uniform random number in [0, 1) with 53-bit resolution
+ * @param stream Initialized stream
+ * @return Random number in [0, 1)
+ */
+double fso_random_stream_uniform(FSORandomStream* stream);
+
+/**
+ * @brief Gaussian random number from a stream (Ziggurat)
+ * @param stream Initialized stream
+ * @param mean Mean of the distribution
+ * @param stddev Standard deviation of the distribution
+ * @return Random number from N(mean, stddev^2)
+ */
+double fso_random_stream_gaussian(FSORandomStream* stream, double mean, double stddev);
+
+/**
+ * @brief Fill an array with zero-mean Gaussian samples
+ * @param stream Initialized stream
+ * @param output Output array
+ * @param count Number of samples
+ * @param stddev Standard deviation
+ */
+void fso_random_stream_gaussian_fill(FSORandomStream* stream, double* output,
+                                     size_t count, double stddev);
+
+/**
+ * @brief Single-precision fso_random_stream_gaussian_fill()
+ * 
+ * Consumes the same draws as the double version, so both precisions see
+ * the same noise realization up to rounding.
+ * 
+ * @param stream Initialized stream
+ * @param output Output array
+ * @param count Number of samples
+ * @param stddev Standard deviation
+ */
+void fso_random_stream_gaussian_fill_f32(FSORandomStream* stream, float* output,
+                                         size_t count, double stddev);
+
+/**
+ * @brief Fill a buffer with random bytes
+ * @param stream Initialized stream
+ * @param output Output buffer
+ * @param count Number of bytes
+ */
+void fso_random_stream_bytes_fill(FSORandomStream* stream, uint8_t* output, size_t count);
+
 /**
  * @brief Initialize random number generator with seed
  * @param seed Seed value (use 0 for time-based seed)
@@ -387,6 +1169,14 @@ void fso_random_set_seed(unsigned int seed);
  */
 unsigned int fso_random_get_seed(void);
 
+/**
+ * @brief Point the current thread's generator at a (run, packet, stream) triple
+ * @param run_seed Run seed
+ * @param packet Packet index
+ * @param stream_id Stream id within the packet
+ */
+void fso_random_select_stream(uint64_t run_seed, uint32_t packet, uint32_t stream_id);
+
 /**
  * @brief Generate uniform random number in [0, 1)
  * @return Random number in [0, 1)
@@ -402,7 +1192,7 @@ double fso_random_uniform(void);
 double fso_random_uniform_range(double min, double max);
 
 /**
- * @brief Generate Gaussian (normal) random number using Box-Muller transform
+ * @brief Generate Gaussian (normal) random number using the Ziggurat method
  * @param mean Mean of the distribution
  * @param stddev Standard deviation of the distribution
  * @return Random number from N(mean, stddev^2)
@@ -423,6 +1213,29 @@ double fso_random_normal(void);
  */
 int fso_random_int(int min, int max);
 
+/**
+ * @brief Fill an array with zero-mean Gaussian samples (current thread's stream)
+ * @param output Output array
+ * @param count Number of samples
+ * @param stddev Standard deviation
+ */
+void fso_random_gaussian_fill(double* output, size_t count, double stddev);
+
+/**
+ * @brief Fill a float array with zero-mean Gaussian samples (current thread's stream)
+ * @param output Output array
+ * @param count Number of samples
+ * @param stddev Standard deviation
+ */
+void fso_random_gaussian_fill_f32(float* output, size_t count, double stddev);
+
+/**
+ * @brief Fill a buffer with random bytes (current thread's stream)
+ * @param output Output buffer
+ * @param count Number of bytes
+ */
+void fso_random_bytes_fill(uint8_t* output, size_t count);
+
 /* ============================================================================
  * Constants
  * ============================================================================ */
@@ -30,13 +30,31 @@
 int dpsk_modulate(const uint8_t* data, size_t data_len,
                   ComplexSample* symbols, size_t* symbol_len,
                   DPSKState* state) {
-    FSO_CHECK_NULL(data);
     FSO_CHECK_NULL(symbols);
     FSO_CHECK_NULL(symbol_len);
+    
+    FSOComplexBuffer view;
+    fso_complex_buffer_wrap(&view, symbols, data_len * 8);
+    
+    int result = dpsk_modulate_buffer(data, data_len, &view, state);
+    if (result == FSO_SUCCESS) {
+        *symbol_len = view.length;
+    }
+    return result;
+}
+
+int dpsk_modulate_buffer(const uint8_t* data, size_t data_len,
+                         FSOComplexBuffer* symbols, DPSKState* state) {
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(symbols);
     FSO_CHECK_NULL(state);
     FSO_CHECK_PARAM(data_len > 0);
+    FSO_CHECK_PARAM(data_len * 8 <= symbols->capacity);
     
     size_t num_bits = data_len * 8;
+    double* real = symbols->real;
+    double* imag = symbols->imag;
+    const size_t stride = symbols->stride;
     double current_phase;
     
     // Initialize phase if this is the first call
@@ -74,7 +92,8 @@ int dpsk_modulate(const uint8_t* data, size_t data_len,
             }
             
             // Generate complex symbol with unit magnitude
-            symbols[symbol_idx] = fso_complex_from_polar(1.0, current_phase);
+            real[symbol_idx * stride] = cos(current_phase);
+            imag[symbol_idx * stride] = sin(current_phase);
             symbol_idx++;
         }
     }
@@ -82,7 +101,7 @@ int dpsk_modulate(const uint8_t* data, size_t data_len,
     // Save last phase for next call
     state->last_phase = current_phase;
     
-    *symbol_len = num_bits;
+    symbols->length = num_bits;
     
     FSO_LOG_DEBUG(MODULE_NAME, "Modulated %zu bytes to %zu DPSK symbols (final phase=%.3f rad)",
                  data_len, num_bits, current_phase);
@@ -98,13 +117,28 @@ int dpsk_demodulate(const ComplexSample* symbols, size_t symbol_len,
                     uint8_t* data, size_t* data_len,
                     DPSKState* state) {
     FSO_CHECK_NULL(symbols);
+    
+    FSOComplexBuffer view;
+    fso_complex_buffer_wrap(&view, (ComplexSample*)symbols, symbol_len);
+    
+    return dpsk_demodulate_buffer(&view, data, data_len, state);
+}
+
+int dpsk_demodulate_buffer(const FSOComplexBuffer* symbols,
+                           uint8_t* data, size_t* data_len,
+                           DPSKState* state) {
+    FSO_CHECK_NULL(symbols);
     FSO_CHECK_NULL(data);
     FSO_CHECK_NULL(data_len);
     FSO_CHECK_NULL(state);
-    FSO_CHECK_PARAM(symbol_len > 0);
-    FSO_CHECK_PARAM(symbol_len % 8 == 0);  // Must be multiple of 8 bits
+    FSO_CHECK_PARAM(symbols->length > 0);
+    FSO_CHECK_PARAM(symbols->length % 8 == 0);  // Must be multiple of 8 bits
     
+    size_t symbol_len = symbols->length;
     size_t num_bytes = symbol_len / 8;
+    const double* real = symbols->real;
+    const double* imag = symbols->imag;
+    const size_t stride = symbols->stride;
     ComplexSample prev_symbol;
     
     // Initialize previous symbol
@@ -126,7 +160,8 @@ int dpsk_demodulate(const ComplexSample* symbols, size_t symbol_len,
         
         // Process 8 symbols to form one byte (MSB first)
         for (int bit_idx = 7; bit_idx >= 0; bit_idx--) {
-            ComplexSample current_symbol = symbols[symbol_idx];
+            ComplexSample current_symbol = { real[symbol_idx * stride],
+                                             imag[symbol_idx * stride] };
             
             // Differential detection: multiply by conjugate of previous symbol
             // This gives us the phase difference
@@ -160,3 +195,70 @@ int dpsk_demodulate(const ComplexSample* symbols, size_t symbol_len,
     
     return FSO_SUCCESS;
 }
+
+/* ============================================================================
+ * DPSK Soft Demodulation
+ * ============================================================================ */
+
+int dpsk_demodulate_soft(const ComplexSample* symbols, size_t symbol_len,
+                         const SoftDemodParams* params, float* llr, size_t* llr_len,
+                         DPSKState* state) {
+    FSO_CHECK_NULL(symbols);
+    
+    FSOComplexBuffer view;
+    fso_complex_buffer_wrap(&view, (ComplexSample*)symbols, symbol_len);
+    
+    return dpsk_demodulate_soft_buffer(&view, params, llr, llr_len, state);
+}
+
+int dpsk_demodulate_soft_buffer(const FSOComplexBuffer* symbols,
+                                const SoftDemodParams* params, float* llr, size_t* llr_len,
+                                DPSKState* state) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_NULL(state);
+    FSO_CHECK_PARAM(symbols->length > 0);
+    FSO_CHECK_PARAM(params->noise_variance > 0.0);
+    
+    size_t symbol_len = symbols->length;
+    const double* real = symbols->real;
+    const double* imag = symbols->imag;
+    const size_t stride = symbols->stride;
+    ComplexSample prev_symbol;
+    
+    // The reference before the first symbol is noise-free, at the received amplitude
+    if (!state->initialized) {
+        prev_symbol = fso_complex_from_polar(params->amplitude, 0.0);
+        state->initialized = 1;
+    } else {
+        prev_symbol = fso_complex_from_polar(params->amplitude, state->last_phase);
+    }
+    
+    // Averaging over the unknown carrier phase gives
+    // LLR = ln I0(2A|r_n + r_(n-1)|/σ²) - ln I0(2A|r_n - r_(n-1)|/σ²);
+    // ln I0(x) ≈ x keeps only the magnitudes
+    const double scale = 2.0 * params->amplitude / params->noise_variance;
+    
+    for (size_t i = 0; i < symbol_len; i++) {
+        ComplexSample current_symbol = { real[i * stride], imag[i * stride] };
+        ComplexSample sum = fso_complex_add(current_symbol, prev_symbol);
+        ComplexSample diff = fso_complex_sub(current_symbol, prev_symbol);
+        
+        double value = scale * (fso_complex_magnitude(sum) - fso_complex_magnitude(diff));
+        llr[i] = (float)FSO_CLAMP(value, -MOD_LLR_CLIP, MOD_LLR_CLIP);
+        
+        prev_symbol = current_symbol;
+    }
+    
+    // Save last symbol phase for next call
+    state->last_phase = fso_complex_phase(prev_symbol);
+    
+    *llr_len = symbol_len;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Soft-demodulated %zu DPSK symbols (final phase=%.3f rad)",
+                 symbol_len, state->last_phase);
+    
+    return FSO_SUCCESS;
+}
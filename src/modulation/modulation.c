@@ -168,3 +168,114 @@ int demodulate(Modulator* mod, const double* symbols, size_t symbol_len,
     
     return result;
 }
+
+int demodulate_soft(Modulator* mod, const double* symbols, size_t symbol_len,
+                    const SoftDemodParams* params, float* llr, size_t* llr_len) {
+    FSO_CHECK_NULL(mod);
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_PARAM(mod->initialized);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    
+    switch (mod->type) {
+        case MOD_OOK:
+            return ook_demodulate_soft(symbols, symbol_len, params, llr, llr_len);
+            
+        case MOD_PPM:
+            return ppm_demodulate_soft(symbols, symbol_len, params, llr, llr_len,
+                                       mod->config.ppm.order);
+            
+        case MOD_DPSK:
+            // DPSK uses complex symbols, so this is a special case
+            FSO_LOG_ERROR(MODULE_NAME, 
+                         "Use dpsk_demodulate_soft() for DPSK (requires complex symbols)");
+            return FSO_ERROR_UNSUPPORTED;
+            
+        default:
+            FSO_LOG_ERROR(MODULE_NAME, "Unsupported modulation type: %d", mod->type);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+}
+
+/* ============================================================================
+ * Single-Precision Modulation Functions
+ * ============================================================================ */
+
+int modulate_f32(Modulator* mod, const uint8_t* data, size_t data_len,
+                 float* symbols, size_t* symbol_len) {
+    FSO_CHECK_NULL(mod);
+    FSO_CHECK_PARAM(mod->initialized);
+    
+    switch (mod->type) {
+        case MOD_OOK:
+            return ook_modulate_f32(data, data_len, symbols, symbol_len);
+        
+        case MOD_PPM:
+            return ppm_modulate_f32(data, data_len, symbols, symbol_len,
+                                    mod->config.ppm.order);
+        
+        default:
+            FSO_LOG_ERROR(MODULE_NAME, "No single-precision path for modulation type %d",
+                         mod->type);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+}
+
+int demodulate_f32(Modulator* mod, const float* symbols, size_t symbol_len,
+                   uint8_t* data, size_t* data_len, double snr) {
+    FSO_CHECK_NULL(mod);
+    FSO_CHECK_PARAM(mod->initialized);
+    
+    switch (mod->type) {
+        case MOD_OOK:
+            return ook_demodulate_f32(symbols, symbol_len, data, data_len, snr);
+        
+        case MOD_PPM:
+            return ppm_demodulate_f32(symbols, symbol_len, data, data_len,
+                                      mod->config.ppm.order);
+        
+        default:
+            FSO_LOG_ERROR(MODULE_NAME, "No single-precision path for modulation type %d",
+                         mod->type);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+}
+
+int demodulate_soft_f32(Modulator* mod, const float* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len) {
+    FSO_CHECK_NULL(mod);
+    FSO_CHECK_PARAM(mod->initialized);
+    
+    switch (mod->type) {
+        case MOD_OOK:
+            return ook_demodulate_soft_f32(symbols, symbol_len, params, llr, llr_len);
+        
+        case MOD_PPM:
+            return ppm_demodulate_soft_f32(symbols, symbol_len, params, llr, llr_len,
+                                           mod->config.ppm.order);
+        
+        default:
+            FSO_LOG_ERROR(MODULE_NAME, "No single-precision path for modulation type %d",
+                         mod->type);
+            return FSO_ERROR_UNSUPPORTED;
+    }
+}
+
+/* ============================================================================
+ * LLR Utilities
+ * ============================================================================ */
+
+int llr_quantize_int8(const float* llr, size_t length, float scale, int8_t* out) {
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(out);
+    FSO_CHECK_PARAM(scale > 0.0f);
+    
+    for (size_t i = 0; i < length; i++) {
+        float q = rintf(llr[i] * scale);
+        out[i] = (int8_t)FSO_CLAMP(q, -127.0f, 127.0f);
+    }
+    
+    return FSO_SUCCESS;
+}
@@ -33,6 +33,20 @@ typedef struct {
     int initialized;     /**< Whether phase tracking is initialized */
 } DPSKState;
 
+/**
+ * @brief Receiver state for soft-output demodulation
+ * 
+ * The LLR of a bit is log(P(bit = 0) / P(bit = 1)), so positive values
+ * favour 0 (the convention of the LDPC decoder).
+ */
+typedef struct {
+    double amplitude;         /**< Received level of a '1' symbol / pulse (fade-scaled transmit level) */
+    double noise_variance;    /**< AWGN variance per real sample (> 0) */
+} SoftDemodParams;
+
+/** Magnitude at which output LLRs are clipped */
+#define MOD_LLR_CLIP 64.0f
+
 /**
  * @brief Modulator structure
  */
@@ -106,6 +120,63 @@ int modulate(Modulator* mod, const uint8_t* data, size_t data_len,
 int demodulate(Modulator* mod, const double* symbols, size_t symbol_len,
                uint8_t* data, size_t* data_len, double snr);
 
+/**
+ * @brief Demodulate symbols to per-bit log-likelihood ratios
+ * 
+ * Writes one LLR per demodulated bit, MSB first within each byte, in the
+ * same bit order demodulate() packs into bytes. LLRs are clipped to
+ * ±MOD_LLR_CLIP.
+ * 
+ * @param mod Pointer to initialized modulator
+ * @param symbols Input symbol array
+ * @param symbol_len Number of input symbols
+ * @param params Received amplitude and noise variance
+ * @param llr Output LLR array (must be pre-allocated, one entry per bit)
+ * @param llr_len Pointer to store number of LLRs written
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int demodulate_soft(Modulator* mod, const double* symbols, size_t symbol_len,
+                    const SoftDemodParams* params, float* llr, size_t* llr_len);
+
+/* ============================================================================
+ * Single-Precision Modulation Functions
+ * ============================================================================ */
+
+/**
+ * @brief modulate() on float symbols (OOK and PPM)
+ * @return FSO_SUCCESS, or FSO_ERROR_UNSUPPORTED for DPSK
+ */
+int modulate_f32(Modulator* mod, const uint8_t* data, size_t data_len,
+                 float* symbols, size_t* symbol_len);
+
+/**
+ * @brief demodulate() on float symbols (OOK and PPM)
+ * @return FSO_SUCCESS, or FSO_ERROR_UNSUPPORTED for DPSK
+ */
+int demodulate_f32(Modulator* mod, const float* symbols, size_t symbol_len,
+                   uint8_t* data, size_t* data_len, double snr);
+
+/**
+ * @brief demodulate_soft() on float symbols (OOK and PPM)
+ * @return FSO_SUCCESS, or FSO_ERROR_UNSUPPORTED for DPSK
+ */
+int demodulate_soft_f32(Modulator* mod, const float* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len);
+
+/**
+ * @brief Quantize LLRs to saturating 8-bit fixed point
+ * 
+ * out[i] = clamp(round(llr[i] * scale), -127, 127), keeping 0 and the
+ * sign convention of the float LLRs.
+ * 
+ * @param llr Input LLRs
+ * @param length Number of LLRs
+ * @param scale Quantization steps per unit LLR (> 0)
+ * @param out Output quantized LLRs
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int llr_quantize_int8(const float* llr, size_t length, float scale, int8_t* out);
+
 /* ============================================================================
  * OOK-Specific Functions
  * ============================================================================ */
@@ -140,6 +211,33 @@ int ook_demodulate(const double* symbols, size_t symbol_len,
  */
 double ook_calculate_threshold(double snr);
 
+/**
+ * @brief Soft-demodulate OOK symbols to per-bit LLRs
+ * 
+ * For r = A*b + n with n ~ N(0, σ²): LLR = A * (A/2 - r) / σ².
+ * 
+ * @param symbols Input symbol array
+ * @param symbol_len Number of input symbols (one bit each)
+ * @param params Received amplitude and noise variance
+ * @param llr Output LLR array (size >= symbol_len)
+ * @param llr_len Pointer to store number of LLRs written
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int ook_demodulate_soft(const double* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len);
+
+/** @brief Single-precision ook_modulate() */
+int ook_modulate_f32(const uint8_t* data, size_t data_len,
+                     float* symbols, size_t* symbol_len);
+
+/** @brief Single-precision ook_demodulate() */
+int ook_demodulate_f32(const float* symbols, size_t symbol_len,
+                       uint8_t* data, size_t* data_len, double snr);
+
+/** @brief Single-precision ook_demodulate_soft() */
+int ook_demodulate_soft_f32(const float* symbols, size_t symbol_len,
+                            const SoftDemodParams* params, float* llr, size_t* llr_len);
+
 /* ============================================================================
  * PPM-Specific Functions
  * ============================================================================ */
@@ -168,6 +266,38 @@ int ppm_modulate(const uint8_t* data, size_t data_len,
 int ppm_demodulate(const double* symbols, size_t symbol_len,
                    uint8_t* data, size_t* data_len, int ppm_order);
 
+/**
+ * @brief Soft-demodulate PPM symbols to per-bit LLRs
+ * 
+ * Slot k of a symbol has log-likelihood A * r_k / σ² (up to a common
+ * constant); each bit's LLR is the log-sum-exp over the slots whose index
+ * has that bit clear minus the one over the slots where it is set.
+ * 
+ * @param symbols Input symbol array
+ * @param symbol_len Number of input slots (multiple of ppm_order)
+ * @param params Received pulse amplitude and noise variance
+ * @param llr Output LLR array (size >= symbol_len / ppm_order * log2(ppm_order))
+ * @param llr_len Pointer to store number of LLRs written
+ * @param ppm_order PPM order (2, 4, 8, or 16)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int ppm_demodulate_soft(const double* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len,
+                        int ppm_order);
+
+/** @brief Single-precision ppm_modulate() */
+int ppm_modulate_f32(const uint8_t* data, size_t data_len,
+                     float* symbols, size_t* symbol_len, int ppm_order);
+
+/** @brief Single-precision ppm_demodulate() */
+int ppm_demodulate_f32(const float* symbols, size_t symbol_len,
+                       uint8_t* data, size_t* data_len, int ppm_order);
+
+/** @brief Single-precision ppm_demodulate_soft() */
+int ppm_demodulate_soft_f32(const float* symbols, size_t symbol_len,
+                            const SoftDemodParams* params, float* llr, size_t* llr_len,
+                            int ppm_order);
+
 /* ============================================================================
  * DPSK-Specific Functions
  * ============================================================================ */
@@ -185,6 +315,17 @@ int dpsk_modulate(const uint8_t* data, size_t data_len,
                   ComplexSample* symbols, size_t* symbol_len,
                   DPSKState* state);
 
+/**
+ * @brief Modulate data into a complex buffer of either layout
+ * @param data Input data bytes
+ * @param data_len Length of input data in bytes
+ * @param symbols Output buffer (capacity >= 8 * data_len; length is set)
+ * @param state DPSK state for phase tracking
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int dpsk_modulate_buffer(const uint8_t* data, size_t data_len,
+                         FSOComplexBuffer* symbols, DPSKState* state);
+
 /**
  * @brief Demodulate DPSK symbols to data
  * @param symbols Input complex symbol array
@@ -198,4 +339,49 @@ int dpsk_demodulate(const ComplexSample* symbols, size_t symbol_len,
                     uint8_t* data, size_t* data_len,
                     DPSKState* state);
 
+/**
+ * @brief Demodulate the symbols of a complex buffer of either layout
+ * @param symbols Input buffer (length a multiple of 8)
+ * @param data Output data bytes (must be pre-allocated)
+ * @param data_len Pointer to store length of output data in bytes
+ * @param state DPSK state for phase tracking
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int dpsk_demodulate_buffer(const FSOComplexBuffer* symbols,
+                           uint8_t* data, size_t* data_len,
+                           DPSKState* state);
+
+/**
+ * @brief Soft-demodulate DPSK symbols to per-bit LLRs
+ * 
+ * Uses the max-log form of the noncoherent differential detector,
+ * LLR = 2A * (|r_n + r_(n-1)| - |r_n - r_(n-1)|) / σ², with σ² the
+ * complex noise variance. Phase tracking state is shared with
+ * dpsk_demodulate().
+ * 
+ * @param symbols Input complex symbol array
+ * @param symbol_len Number of input symbols (one bit each)
+ * @param params Received amplitude and complex noise variance
+ * @param llr Output LLR array (size >= symbol_len)
+ * @param llr_len Pointer to store number of LLRs written
+ * @param state DPSK state for phase tracking
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int dpsk_demodulate_soft(const ComplexSample* symbols, size_t symbol_len,
+                         const SoftDemodParams* params, float* llr, size_t* llr_len,
+                         DPSKState* state);
+
+/**
+ * @brief Soft-demodulate the symbols of a complex buffer of either layout
+ * @param symbols Input buffer (one bit per sample)
+ * @param params Received amplitude and complex noise variance
+ * @param llr Output LLR array (size >= symbols->length)
+ * @param llr_len Pointer to store number of LLRs written
+ * @param state DPSK state for phase tracking
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int dpsk_demodulate_soft_buffer(const FSOComplexBuffer* symbols,
+                                const SoftDemodParams* params, float* llr, size_t* llr_len,
+                                DPSKState* state);
+
 #endif /* MODULATION_H */
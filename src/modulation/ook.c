@@ -5,14 +5,352 @@
  * OOK is the simplest form of amplitude-shift keying (ASK) modulation.
  * Binary '1' is represented by light on (symbol value 1.0)
  * Binary '0' is represented by light off (symbol value 0.0)
+ * 
+ * Both directions work a byte at a time: modulation expands a byte into
+ * eight symbols by broadcast-and-mask, demodulation packs eight threshold
+ * decisions into a byte with compare + movemask. Kernels come from a
+ * per-family table picked at run time (fso_cpu_simd_level()): SSE4.2,
+ * AVX2, AVX-512 and NEON packing, AVX2 expansion, and branch-free scalar
+ * code elsewhere. The single-precision path fits a whole byte in one
+ * 256-bit register.
  */
 
 #include "modulation/modulation.h"
 #include <string.h>
 #include <math.h>
 
+#if FSO_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+#if FSO_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #define MODULE_NAME "OOK"
 
+/* ============================================================================
+ * Byte Kernels
+ * ============================================================================ */
+
+/**
+ * @brief Expand bytes into 0.0/1.0 symbols, MSB first
+ */
+static void ook_expand_scalar(const uint8_t* data, size_t data_len, double* symbols) {
+    for (size_t byte_idx = 0; byte_idx < data_len; byte_idx++) {
+        unsigned int byte = data[byte_idx];
+        for (int bit_idx = 0; bit_idx < 8; bit_idx++) {
+            symbols[bit_idx] = (double)((byte >> (7 - bit_idx)) & 1u);
+        }
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief Pack threshold decisions (symbol >= threshold) into bytes, MSB first
+ */
+static void ook_pack_scalar(const double* symbols, size_t num_bytes,
+                            uint8_t* data, double threshold) {
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        unsigned int byte = 0;
+        for (int bit_idx = 0; bit_idx < 8; bit_idx++) {
+            byte = (byte << 1) | (unsigned int)(symbols[bit_idx] >= threshold);
+        }
+        data[byte_idx] = (uint8_t)byte;
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief Single-precision ook_expand_scalar()
+ */
+static void ook_expand_scalar_f32(const uint8_t* data, size_t data_len, float* symbols) {
+    for (size_t byte_idx = 0; byte_idx < data_len; byte_idx++) {
+        unsigned int byte = data[byte_idx];
+        for (int bit_idx = 0; bit_idx < 8; bit_idx++) {
+            symbols[bit_idx] = (float)((byte >> (7 - bit_idx)) & 1u);
+        }
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief Single-precision ook_pack_scalar()
+ */
+static void ook_pack_scalar_f32(const float* symbols, size_t num_bytes,
+                                uint8_t* data, float threshold) {
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        unsigned int byte = 0;
+        for (int bit_idx = 0; bit_idx < 8; bit_idx++) {
+            byte = (byte << 1) | (unsigned int)(symbols[bit_idx] >= threshold);
+        }
+        data[byte_idx] = (uint8_t)byte;
+        symbols += 8;
+    }
+}
+
+#if FSO_HAVE_X86_SIMD
+
+/**
+ * @brief SSE4.2 threshold packing, two symbols per compare
+ * 
+ * Lanes are swapped before movemask so the earlier symbol lands in the
+ * higher bit.
+ */
+FSO_TARGET_SSE42
+static void ook_pack_sse42(const double* symbols, size_t num_bytes,
+                           uint8_t* data, double threshold) {
+    const __m128d thresh = _mm_set1_pd(threshold);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        unsigned int byte = 0;
+        for (int pair = 0; pair < 4; pair++) {
+            __m128d v = _mm_loadu_pd(symbols + 2 * pair);
+            v = _mm_shuffle_pd(v, v, 0x1);
+            byte = (byte << 2) | (unsigned int)_mm_movemask_pd(_mm_cmpge_pd(v, thresh));
+        }
+        data[byte_idx] = (uint8_t)byte;
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief SSE4.2 single-precision threshold packing, four symbols per compare
+ */
+FSO_TARGET_SSE42
+static void ook_pack_sse42_f32(const float* symbols, size_t num_bytes,
+                               uint8_t* data, float threshold) {
+    const __m128 thresh = _mm_set1_ps(threshold);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        __m128 hi = _mm_loadu_ps(symbols);
+        __m128 lo = _mm_loadu_ps(symbols + 4);
+        hi = _mm_shuffle_ps(hi, hi, 0x1b);
+        lo = _mm_shuffle_ps(lo, lo, 0x1b);
+        int hi_mask = _mm_movemask_ps(_mm_cmpge_ps(hi, thresh));
+        int lo_mask = _mm_movemask_ps(_mm_cmpge_ps(lo, thresh));
+        data[byte_idx] = (uint8_t)((hi_mask << 4) | lo_mask);
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX2 byte expansion
+ * 
+ * The byte is broadcast to four 64-bit lanes and ANDed with the per-lane
+ * bit masks {128, 64, 32, 16} / {8, 4, 2, 1}; an equality compare turns
+ * each set bit into an all-ones lane that selects the bit pattern of 1.0.
+ */
+FSO_TARGET_AVX2
+static void ook_expand_avx2(const uint8_t* data, size_t data_len, double* symbols) {
+    const __m256i hi_bits = _mm256_setr_epi64x(128, 64, 32, 16);
+    const __m256i lo_bits = _mm256_setr_epi64x(8, 4, 2, 1);
+    const __m256d one = _mm256_set1_pd(1.0);
+    
+    for (size_t byte_idx = 0; byte_idx < data_len; byte_idx++) {
+        __m256i byte = _mm256_set1_epi64x(data[byte_idx]);
+        __m256i hi = _mm256_cmpeq_epi64(_mm256_and_si256(byte, hi_bits), hi_bits);
+        __m256i lo = _mm256_cmpeq_epi64(_mm256_and_si256(byte, lo_bits), lo_bits);
+        _mm256_storeu_pd(symbols, _mm256_and_pd(_mm256_castsi256_pd(hi), one));
+        _mm256_storeu_pd(symbols + 4, _mm256_and_pd(_mm256_castsi256_pd(lo), one));
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX2 threshold packing
+ * 
+ * movemask puts lane 0 in bit 0, so each half is lane-reversed before the
+ * compare to keep the first symbol in the byte's MSB. _CMP_GE_OQ is false
+ * for NaN, matching the scalar >= comparison.
+ */
+FSO_TARGET_AVX2
+static void ook_pack_avx2(const double* symbols, size_t num_bytes,
+                          uint8_t* data, double threshold) {
+    const __m256d thresh = _mm256_set1_pd(threshold);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        __m256d hi = _mm256_permute4x64_pd(_mm256_loadu_pd(symbols), 0x1b);
+        __m256d lo = _mm256_permute4x64_pd(_mm256_loadu_pd(symbols + 4), 0x1b);
+        int hi_mask = _mm256_movemask_pd(_mm256_cmp_pd(hi, thresh, _CMP_GE_OQ));
+        int lo_mask = _mm256_movemask_pd(_mm256_cmp_pd(lo, thresh, _CMP_GE_OQ));
+        data[byte_idx] = (uint8_t)((hi_mask << 4) | lo_mask);
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX2 single-precision byte expansion, one byte per register
+ */
+FSO_TARGET_AVX2
+static void ook_expand_avx2_f32(const uint8_t* data, size_t data_len, float* symbols) {
+    const __m256i bits = _mm256_setr_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    
+    for (size_t byte_idx = 0; byte_idx < data_len; byte_idx++) {
+        __m256i byte = _mm256_set1_epi32(data[byte_idx]);
+        __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(byte, bits), bits);
+        _mm256_storeu_ps(symbols, _mm256_and_ps(_mm256_castsi256_ps(set), one));
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX2 single-precision threshold packing, one byte per register
+ */
+FSO_TARGET_AVX2
+static void ook_pack_avx2_f32(const float* symbols, size_t num_bytes,
+                              uint8_t* data, float threshold) {
+    const __m256 thresh = _mm256_set1_ps(threshold);
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        __m256 v = _mm256_permutevar8x32_ps(_mm256_loadu_ps(symbols), reverse);
+        data[byte_idx] = (uint8_t)_mm256_movemask_ps(_mm256_cmp_ps(v, thresh, _CMP_GE_OQ));
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX-512 threshold packing, one byte per mask compare
+ * 
+ * The eight symbols are lane-reversed so the mask register is the byte.
+ */
+FSO_TARGET_AVX512
+static void ook_pack_avx512(const double* symbols, size_t num_bytes,
+                            uint8_t* data, double threshold) {
+    const __m512d thresh = _mm512_set1_pd(threshold);
+    const __m512i reverse = _mm512_setr_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        __m512d v = _mm512_permutexvar_pd(reverse, _mm512_loadu_pd(symbols));
+        data[byte_idx] = (uint8_t)_mm512_cmp_pd_mask(v, thresh, _CMP_GE_OQ);
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief AVX-512 single-precision threshold packing, two bytes per compare
+ */
+FSO_TARGET_AVX512
+static void ook_pack_avx512_f32(const float* symbols, size_t num_bytes,
+                                uint8_t* data, float threshold) {
+    const __m512 thresh = _mm512_set1_ps(threshold);
+    const __m512i reverse = _mm512_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0,
+                                              15, 14, 13, 12, 11, 10, 9, 8);
+    size_t byte_idx = 0;
+    
+    for (; byte_idx + 2 <= num_bytes; byte_idx += 2) {
+        __m512 v = _mm512_permutexvar_ps(reverse, _mm512_loadu_ps(symbols));
+        __mmask16 mask = _mm512_cmp_ps_mask(v, thresh, _CMP_GE_OQ);
+        data[byte_idx] = (uint8_t)mask;
+        data[byte_idx + 1] = (uint8_t)(mask >> 8);
+        symbols += 16;
+    }
+    if (byte_idx < num_bytes) {
+        ook_pack_avx2_f32(symbols, 1, data + byte_idx, threshold);
+    }
+}
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+#if FSO_HAVE_NEON
+
+/**
+ * @brief NEON threshold packing
+ * 
+ * Compare results are all-ones lanes; masking them with each symbol's bit
+ * weight and adding across lanes gives the byte.
+ */
+static void ook_pack_neon(const double* symbols, size_t num_bytes,
+                          uint8_t* data, double threshold) {
+    const float64x2_t thresh = vdupq_n_f64(threshold);
+    const uint64_t weights[8] = { 128, 64, 32, 16, 8, 4, 2, 1 };
+    uint64x2_t w[4];
+    for (int pair = 0; pair < 4; pair++) {
+        w[pair] = vld1q_u64(weights + 2 * pair);
+    }
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        uint64x2_t bits = vdupq_n_u64(0);
+        for (int pair = 0; pair < 4; pair++) {
+            uint64x2_t ge = vcgeq_f64(vld1q_f64(symbols + 2 * pair), thresh);
+            bits = vorrq_u64(bits, vandq_u64(ge, w[pair]));
+        }
+        data[byte_idx] = (uint8_t)vaddvq_u64(bits);
+        symbols += 8;
+    }
+}
+
+/**
+ * @brief NEON single-precision threshold packing
+ */
+static void ook_pack_neon_f32(const float* symbols, size_t num_bytes,
+                              uint8_t* data, float threshold) {
+    const float32x4_t thresh = vdupq_n_f32(threshold);
+    const uint32_t weights[8] = { 128, 64, 32, 16, 8, 4, 2, 1 };
+    const uint32x4_t w_hi = vld1q_u32(weights);
+    const uint32x4_t w_lo = vld1q_u32(weights + 4);
+    
+    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
+        uint32x4_t hi = vandq_u32(vcgeq_f32(vld1q_f32(symbols), thresh), w_hi);
+        uint32x4_t lo = vandq_u32(vcgeq_f32(vld1q_f32(symbols + 4), thresh), w_lo);
+        data[byte_idx] = (uint8_t)vaddvq_u32(vorrq_u32(hi, lo));
+        symbols += 8;
+    }
+}
+
+#endif /* FSO_HAVE_NEON */
+
+/* ============================================================================
+ * Kernel Tables
+ * ============================================================================ */
+
+/**
+ * @brief Byte kernels of one instruction-set family
+ */
+typedef struct {
+    void (*expand)(const uint8_t* data, size_t data_len, double* symbols);
+    void (*pack)(const double* symbols, size_t num_bytes, uint8_t* data, double threshold);
+    void (*expand_f32)(const uint8_t* data, size_t data_len, float* symbols);
+    void (*pack_f32)(const float* symbols, size_t num_bytes, uint8_t* data, float threshold);
+} OOKKernels;
+
+static const OOKKernels ook_kernels_scalar = {
+    ook_expand_scalar, ook_pack_scalar, ook_expand_scalar_f32, ook_pack_scalar_f32
+};
+
+#if FSO_HAVE_X86_SIMD
+static const OOKKernels ook_kernels_sse42 = {
+    ook_expand_scalar, ook_pack_sse42, ook_expand_scalar_f32, ook_pack_sse42_f32
+};
+static const OOKKernels ook_kernels_avx2 = {
+    ook_expand_avx2, ook_pack_avx2, ook_expand_avx2_f32, ook_pack_avx2_f32
+};
+static const OOKKernels ook_kernels_avx512 = {
+    ook_expand_avx2, ook_pack_avx512, ook_expand_avx2_f32, ook_pack_avx512_f32
+};
+#endif
+
+#if FSO_HAVE_NEON
+static const OOKKernels ook_kernels_neon = {
+    ook_expand_scalar, ook_pack_neon, ook_expand_scalar_f32, ook_pack_neon_f32
+};
+#endif
+
+static const OOKKernels* ook_kernels(void) {
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: return &ook_kernels_avx512;
+        case FSO_SIMD_AVX2:   return &ook_kernels_avx2;
+        case FSO_SIMD_SSE42:  return &ook_kernels_sse42;
+#endif
+#if FSO_HAVE_NEON
+        case FSO_SIMD_NEON:   return &ook_kernels_neon;
+#endif
+        default:              return &ook_kernels_scalar;
+    }
+}
+
 /* ============================================================================
  * OOK Modulation
  * ============================================================================ */
@@ -25,18 +363,9 @@ int ook_modulate(const uint8_t* data, size_t data_len,
     FSO_CHECK_PARAM(data_len > 0);
     
     size_t num_bits = data_len * 8;
-    size_t symbol_idx = 0;
     
-    // Convert each bit to a symbol
-    for (size_t byte_idx = 0; byte_idx < data_len; byte_idx++) {
-        uint8_t byte = data[byte_idx];
-        
-        // Process each bit in the byte (MSB first)
-        for (int bit_idx = 7; bit_idx >= 0; bit_idx--) {
-            int bit = (byte >> bit_idx) & 0x01;
-            symbols[symbol_idx++] = bit ? 1.0 : 0.0;
-        }
-    }
+    // Convert each byte to 8 symbols (MSB first)
+    ook_kernels()->expand(data, data_len, symbols);
     
     *symbol_len = num_bits;
     
@@ -46,6 +375,20 @@ int ook_modulate(const uint8_t* data, size_t data_len,
     return FSO_SUCCESS;
 }
 
+int ook_modulate_f32(const uint8_t* data, size_t data_len,
+                     float* symbols, size_t* symbol_len) {
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(symbol_len);
+    FSO_CHECK_PARAM(data_len > 0);
+    
+    ook_kernels()->expand_f32(data, data_len, symbols);
+    
+    *symbol_len = data_len * 8;
+    
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * OOK Demodulation
  * ============================================================================ */
@@ -93,26 +436,9 @@ int ook_demodulate(const double* symbols, size_t symbol_len,
     double threshold = ook_calculate_threshold(snr);
     
     size_t num_bytes = symbol_len / 8;
-    size_t symbol_idx = 0;
     
-    // Convert symbols back to bytes
-    for (size_t byte_idx = 0; byte_idx < num_bytes; byte_idx++) {
-        uint8_t byte = 0;
-        
-        // Process 8 symbols to form one byte (MSB first)
-        for (int bit_idx = 7; bit_idx >= 0; bit_idx--) {
-            double symbol = symbols[symbol_idx++];
-            
-            // Threshold detection
-            int bit = (symbol >= threshold) ? 1 : 0;
-            
-            if (bit) {
-                byte |= (1 << bit_idx);
-            }
-        }
-        
-        data[byte_idx] = byte;
-    }
+    // Threshold detection, 8 symbols per byte (MSB first)
+    ook_kernels()->pack(symbols, num_bytes, data, threshold);
     
     *data_len = num_bytes;
     
@@ -121,3 +447,77 @@ int ook_demodulate(const double* symbols, size_t symbol_len,
     
     return FSO_SUCCESS;
 }
+
+int ook_demodulate_f32(const float* symbols, size_t symbol_len,
+                       uint8_t* data, size_t* data_len, double snr) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(data_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(symbol_len % 8 == 0);
+    
+    float threshold = (float)ook_calculate_threshold(snr);
+    size_t num_bytes = symbol_len / 8;
+    
+    ook_kernels()->pack_f32(symbols, num_bytes, data, threshold);
+    
+    *data_len = num_bytes;
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * OOK Soft Demodulation
+ * ============================================================================ */
+
+int ook_demodulate_soft(const double* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(params->noise_variance > 0.0);
+    
+    // LLR = log N(r; 0, σ²) - log N(r; A, σ²) = A * (A/2 - r) / σ²
+    const double scale = params->amplitude / params->noise_variance;
+    const double midpoint = 0.5 * params->amplitude;
+    
+    for (size_t i = 0; i < symbol_len; i++) {
+        double value = scale * (midpoint - symbols[i]);
+        llr[i] = (float)FSO_CLAMP(value, -MOD_LLR_CLIP, MOD_LLR_CLIP);
+    }
+    
+    *llr_len = symbol_len;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Soft-demodulated %zu OOK symbols (A=%.3e, noise var=%.3e)",
+                 symbol_len, params->amplitude, params->noise_variance);
+    
+    return FSO_SUCCESS;
+}
+
+int ook_demodulate_soft_f32(const float* symbols, size_t symbol_len,
+                            const SoftDemodParams* params, float* llr, size_t* llr_len) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(params->noise_variance > 0.0);
+    
+    const float scale = (float)(params->amplitude / params->noise_variance);
+    const float midpoint = (float)(0.5 * params->amplitude);
+    const float clip = (float)MOD_LLR_CLIP;
+    
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (size_t i = 0; i < symbol_len; i++) {
+        float value = scale * (midpoint - symbols[i]);
+        llr[i] = FSO_CLAMP(value, -clip, clip);
+    }
+    
+    *llr_len = symbol_len;
+    
+    return FSO_SUCCESS;
+}
@@ -16,12 +16,25 @@
  * - Bits 01 -> pulse in slot 1: [0.0, 1.0, 0.0, 0.0]
  * - Bits 10 -> pulse in slot 2: [0.0, 0.0, 1.0, 0.0]
  * - Bits 11 -> pulse in slot 3: [0.0, 0.0, 0.0, 1.0]
+ * 
+ * Bits are cut from and packed into a 64-bit window rather than one at a
+ * time, and demodulation uses a vector slot argmax for 4-, 8- and 16-PPM
+ * taken from a per-family table at run time (SSE4.2, AVX2, AVX-512 or
+ * NEON, see fso_cpu_simd_level()). The AVX2 single-precision variant holds
+ * eight slots per register, so 8- and 16-PPM symbols take one or two loads.
  */
 
 #include "modulation/modulation.h"
 #include <string.h>
 #include <math.h>
 
+#if FSO_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+#if FSO_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #define MODULE_NAME "PPM"
 
 /* ============================================================================
@@ -42,69 +55,406 @@ static int ppm_bits_per_symbol(int ppm_order) {
 }
 
 /**
- * @brief Extract bits from data buffer
+ * @brief Big-endian bit stream cursor over a byte buffer
+ * 
+ * Bits are staged in a 64-bit window so symbols are cut with one shift and
+ * mask instead of walking byte boundaries bit by bit; the window is
+ * refilled (reader) or drained (writer) a byte at a time.
+ */
+typedef struct {
+    uint64_t window;      /**< Pending bits in the low window_bits positions */
+    int window_bits;      /**< Number of valid bits in window */
+    size_t byte_idx;      /**< Next byte to read or write */
+} PPMBitCursor;
+
+/**
+ * @brief Read the next num_bits (1-4) bits, zero-padding past the end
+ * @param cur Bit cursor
  * @param data Data buffer
- * @param bit_offset Bit offset from start of buffer
- * @param num_bits Number of bits to extract (1-8)
- * @return Extracted bits as integer
+ * @param data_len Data buffer length in bytes
+ * @param num_bits Number of bits to read
+ * @return Bits as integer, first bit in the MSB
  */
-static uint8_t extract_bits(const uint8_t* data, size_t bit_offset, int num_bits) {
-    size_t byte_idx = bit_offset / 8;
-    int bit_in_byte = bit_offset % 8;
+static inline unsigned int ppm_read_bits(PPMBitCursor* cur, const uint8_t* data,
+                                         size_t data_len, int num_bits) {
+    if (cur->window_bits < num_bits) {
+        while (cur->window_bits <= 56 && cur->byte_idx < data_len) {
+            cur->window = (cur->window << 8) | data[cur->byte_idx++];
+            cur->window_bits += 8;
+        }
+        if (cur->window_bits < num_bits) {
+            // Last symbol may have fewer bits - pad with zeros
+            unsigned int bits = (unsigned int)(cur->window << (num_bits - cur->window_bits)) &
+                                ((1u << num_bits) - 1u);
+            cur->window_bits = 0;
+            return bits;
+        }
+    }
     
-    uint8_t result = 0;
-    int bits_extracted = 0;
+    cur->window_bits -= num_bits;
+    return (unsigned int)(cur->window >> cur->window_bits) & ((1u << num_bits) - 1u);
+}
+
+/**
+ * @brief Append num_bits (1-4) bits, flushing completed bytes
+ * @param cur Bit cursor
+ * @param data Data buffer
+ * @param bits Bits to append, first bit in the MSB
+ * @param num_bits Number of bits to append
+ */
+static inline void ppm_write_bits(PPMBitCursor* cur, uint8_t* data,
+                                  unsigned int bits, int num_bits) {
+    cur->window = (cur->window << num_bits) | bits;
+    cur->window_bits += num_bits;
+    if (cur->window_bits >= 8) {
+        cur->window_bits -= 8;
+        data[cur->byte_idx++] = (uint8_t)(cur->window >> cur->window_bits);
+    }
+}
+
+/**
+ * @brief Flush a trailing partial byte, zero-filling its low bits
+ */
+static inline void ppm_flush_bits(PPMBitCursor* cur, uint8_t* data) {
+    if (cur->window_bits > 0) {
+        data[cur->byte_idx++] = (uint8_t)(cur->window << (8 - cur->window_bits));
+        cur->window_bits = 0;
+    }
+}
+
+/* ============================================================================
+ * Slot Argmax Kernels
+ * ============================================================================ */
+
+/**
+ * @brief Index of the first slot holding the maximum value
+ * 
+ * Ties resolve to the lowest slot and NaN slots never win (strict >), which
+ * the vector kernel reproduces.
+ */
+static inline int ppm_argmax_scalar(const double* slots, int ppm_order) {
+    int max_slot = 0;
+    double max_value = slots[0];
     
-    while (bits_extracted < num_bits) {
-        int bits_available = 8 - bit_in_byte;
-        int bits_to_extract = FSO_MIN(num_bits - bits_extracted, bits_available);
-        
-        // Extract bits from current byte
-        uint8_t mask = ((1 << bits_to_extract) - 1);
-        uint8_t bits = (data[byte_idx] >> (bits_available - bits_to_extract)) & mask;
-        
-        // Add to result
-        result = (result << bits_to_extract) | bits;
-        
-        bits_extracted += bits_to_extract;
-        byte_idx++;
-        bit_in_byte = 0;
+    for (int slot = 1; slot < ppm_order; slot++) {
+        if (slots[slot] > max_value) {
+            max_value = slots[slot];
+            max_slot = slot;
+        }
     }
     
-    return result;
+    return max_slot;
 }
 
 /**
- * @brief Insert bits into data buffer
- * @param data Data buffer
- * @param bit_offset Bit offset from start of buffer
- * @param bits Bits to insert
- * @param num_bits Number of bits to insert (1-8)
+ * @brief Single-precision ppm_argmax_scalar()
  */
-static void insert_bits(uint8_t* data, size_t bit_offset, uint8_t bits, int num_bits) {
-    size_t byte_idx = bit_offset / 8;
-    int bit_in_byte = bit_offset % 8;
+static inline int ppm_argmax_scalar_f32(const float* slots, int ppm_order) {
+    int max_slot = 0;
+    float max_value = slots[0];
     
-    int bits_inserted = 0;
+    for (int slot = 1; slot < ppm_order; slot++) {
+        if (slots[slot] > max_value) {
+            max_value = slots[slot];
+            max_slot = slot;
+        }
+    }
     
-    while (bits_inserted < num_bits) {
-        int bits_available = 8 - bit_in_byte;
-        int bits_to_insert = FSO_MIN(num_bits - bits_inserted, bits_available);
-        
-        // Extract bits to insert
-        uint8_t mask = ((1 << bits_to_insert) - 1);
-        uint8_t bits_value = (bits >> (num_bits - bits_inserted - bits_to_insert)) & mask;
-        
-        // Clear target bits
-        uint8_t clear_mask = ~(mask << (bits_available - bits_to_insert));
-        data[byte_idx] &= clear_mask;
-        
-        // Insert bits
-        data[byte_idx] |= (bits_value << (bits_available - bits_to_insert));
-        
-        bits_inserted += bits_to_insert;
-        byte_idx++;
-        bit_in_byte = 0;
+    return max_slot;
+}
+
+typedef int (*PPMArgmaxFn)(const double* slots, int ppm_order);
+typedef int (*PPMArgmaxF32Fn)(const float* slots, int ppm_order);
+
+#if FSO_HAVE_X86_SIMD
+
+/**
+ * @brief SSE4.2 argmax over 4, 8 or 16 slots, two per vector
+ * 
+ * Same reduction as ppm_argmax_avx2().
+ */
+FSO_TARGET_SSE42
+static int ppm_argmax_sse42(const double* slots, int ppm_order) {
+    __m128d v[8];
+    int num_vec = ppm_order / 2;
+    
+    v[0] = _mm_loadu_pd(slots);
+    __m128d max = v[0];
+    __m128d nan = _mm_cmpunord_pd(v[0], v[0]);
+    for (int i = 1; i < num_vec; i++) {
+        v[i] = _mm_loadu_pd(slots + 2 * i);
+        max = _mm_max_pd(max, v[i]);
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(v[i], v[i]));
+    }
+    if (_mm_movemask_pd(nan)) {
+        return ppm_argmax_scalar(slots, ppm_order);
+    }
+    
+    max = _mm_max_pd(max, _mm_shuffle_pd(max, max, 0x1));
+    
+    unsigned int mask = 0;
+    for (int i = 0; i < num_vec; i++) {
+        mask |= (unsigned int)_mm_movemask_pd(_mm_cmpeq_pd(v[i], max)) << (2 * i);
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief SSE4.2 single-precision argmax over 4, 8 or 16 slots
+ */
+FSO_TARGET_SSE42
+static int ppm_argmax_sse42_f32(const float* slots, int ppm_order) {
+    __m128 v[4];
+    int num_vec = ppm_order / 4;
+    
+    v[0] = _mm_loadu_ps(slots);
+    __m128 max = v[0];
+    __m128 nan = _mm_cmpunord_ps(v[0], v[0]);
+    for (int i = 1; i < num_vec; i++) {
+        v[i] = _mm_loadu_ps(slots + 4 * i);
+        max = _mm_max_ps(max, v[i]);
+        nan = _mm_or_ps(nan, _mm_cmpunord_ps(v[i], v[i]));
+    }
+    if (_mm_movemask_ps(nan)) {
+        return ppm_argmax_scalar_f32(slots, ppm_order);
+    }
+    
+    max = _mm_max_ps(max, _mm_shuffle_ps(max, max, 0xb1));
+    max = _mm_max_ps(max, _mm_shuffle_ps(max, max, 0x4e));
+    
+    unsigned int mask = 0;
+    for (int i = 0; i < num_vec; i++) {
+        mask |= (unsigned int)_mm_movemask_ps(_mm_cmpeq_ps(v[i], max)) << (4 * i);
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief AVX2 argmax over 4, 8 or 16 slots
+ * 
+ * The vectors are reduced to a broadcast maximum, compared back for
+ * equality, and the first matching slot is the lowest set movemask bit.
+ * A symbol containing NaN would poison the max reduction and takes the
+ * scalar path instead.
+ */
+FSO_TARGET_AVX2
+static int ppm_argmax_avx2(const double* slots, int ppm_order) {
+    __m256d v[4];
+    int num_vec = ppm_order / 4;
+    
+    v[0] = _mm256_loadu_pd(slots);
+    __m256d max = v[0];
+    __m256d nan = _mm256_cmp_pd(v[0], v[0], _CMP_UNORD_Q);
+    for (int i = 1; i < num_vec; i++) {
+        v[i] = _mm256_loadu_pd(slots + 4 * i);
+        max = _mm256_max_pd(max, v[i]);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(v[i], v[i], _CMP_UNORD_Q));
+    }
+    if (_mm256_movemask_pd(nan)) {
+        return ppm_argmax_scalar(slots, ppm_order);
+    }
+    
+    max = _mm256_max_pd(max, _mm256_permute_pd(max, 0x5));
+    max = _mm256_max_pd(max, _mm256_permute2f128_pd(max, max, 0x01));
+    
+    unsigned int mask = 0;
+    for (int i = 0; i < num_vec; i++) {
+        mask |= (unsigned int)_mm256_movemask_pd(_mm256_cmp_pd(v[i], max, _CMP_EQ_OQ)) << (4 * i);
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief AVX2 single-precision argmax over 8 or 16 slots
+ * 
+ * Same reduction as ppm_argmax_avx2() with eight lanes per vector.
+ */
+FSO_TARGET_AVX2
+static int ppm_argmax_avx2_f32(const float* slots, int ppm_order) {
+    __m256 v0 = _mm256_loadu_ps(slots);
+    __m256 v1 = (ppm_order == 16) ? _mm256_loadu_ps(slots + 8) : v0;
+    __m256 nan = _mm256_or_ps(_mm256_cmp_ps(v0, v0, _CMP_UNORD_Q),
+                              _mm256_cmp_ps(v1, v1, _CMP_UNORD_Q));
+    if (_mm256_movemask_ps(nan)) {
+        return ppm_argmax_scalar_f32(slots, ppm_order);
+    }
+    
+    __m256 max = _mm256_max_ps(v0, v1);
+    max = _mm256_max_ps(max, _mm256_permute_ps(max, 0xb1));
+    max = _mm256_max_ps(max, _mm256_permute_ps(max, 0x4e));
+    max = _mm256_max_ps(max, _mm256_permute2f128_ps(max, max, 0x01));
+    
+    unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(v0, max, _CMP_EQ_OQ));
+    if (ppm_order == 16) {
+        mask |= (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(v1, max, _CMP_EQ_OQ)) << 8;
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief AVX-512 argmax over 8 or 16 slots, 4-PPM goes to AVX2
+ * 
+ * The equality compare writes a mask register directly.
+ */
+FSO_TARGET_AVX512
+static int ppm_argmax_avx512(const double* slots, int ppm_order) {
+    if (ppm_order < 8) {
+        return ppm_argmax_avx2(slots, ppm_order);
+    }
+    
+    __m512d v0 = _mm512_loadu_pd(slots);
+    __m512d v1 = ppm_order == 16 ? _mm512_loadu_pd(slots + 8) : v0;
+    if (_mm512_cmp_pd_mask(v0, v0, _CMP_UNORD_Q) | _mm512_cmp_pd_mask(v1, v1, _CMP_UNORD_Q)) {
+        return ppm_argmax_scalar(slots, ppm_order);
+    }
+    
+    __m512d max = _mm512_set1_pd(_mm512_reduce_max_pd(_mm512_max_pd(v0, v1)));
+    unsigned int mask = _mm512_cmp_pd_mask(v0, max, _CMP_EQ_OQ);
+    if (ppm_order == 16) {
+        mask |= (unsigned int)_mm512_cmp_pd_mask(v1, max, _CMP_EQ_OQ) << 8;
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief AVX-512 single-precision argmax, 16-PPM in one register
+ */
+FSO_TARGET_AVX512
+static int ppm_argmax_avx512_f32(const float* slots, int ppm_order) {
+    if (ppm_order < 16) {
+        return ppm_argmax_avx2_f32(slots, ppm_order);
+    }
+    
+    __m512 v = _mm512_loadu_ps(slots);
+    if (_mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q)) {
+        return ppm_argmax_scalar_f32(slots, ppm_order);
+    }
+    
+    __m512 max = _mm512_set1_ps(_mm512_reduce_max_ps(v));
+    return __builtin_ctz((unsigned int)_mm512_cmp_ps_mask(v, max, _CMP_EQ_OQ));
+}
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+#if FSO_HAVE_NEON
+
+/**
+ * @brief NEON argmax over 4, 8 or 16 slots
+ * 
+ * Equality lanes are weighted by their bit and summed across the vector
+ * to form the same match mask as the x86 movemask kernels.
+ */
+static int ppm_argmax_neon(const double* slots, int ppm_order) {
+    float64x2_t v[8];
+    int num_vec = ppm_order / 2;
+    
+    v[0] = vld1q_f64(slots);
+    float64x2_t max = v[0];
+    uint64x2_t ordered = vceqq_f64(v[0], v[0]);
+    for (int i = 1; i < num_vec; i++) {
+        v[i] = vld1q_f64(slots + 2 * i);
+        max = vmaxq_f64(max, v[i]);
+        ordered = vandq_u64(ordered, vceqq_f64(v[i], v[i]));
+    }
+    if (vminvq_u32(vreinterpretq_u32_u64(ordered)) == 0) {
+        return ppm_argmax_scalar(slots, ppm_order);
+    }
+    
+    max = vdupq_n_f64(vmaxvq_f64(max));
+    
+    const uint64_t lane_bits[2] = { 1, 2 };
+    const uint64x2_t bits = vld1q_u64(lane_bits);
+    unsigned int mask = 0;
+    for (int i = 0; i < num_vec; i++) {
+        mask |= (unsigned int)vaddvq_u64(vandq_u64(vceqq_f64(v[i], max), bits)) << (2 * i);
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief NEON single-precision argmax over 4, 8 or 16 slots
+ */
+static int ppm_argmax_neon_f32(const float* slots, int ppm_order) {
+    float32x4_t v[4];
+    int num_vec = ppm_order / 4;
+    
+    v[0] = vld1q_f32(slots);
+    float32x4_t max = v[0];
+    uint32x4_t ordered = vceqq_f32(v[0], v[0]);
+    for (int i = 1; i < num_vec; i++) {
+        v[i] = vld1q_f32(slots + 4 * i);
+        max = vmaxq_f32(max, v[i]);
+        ordered = vandq_u32(ordered, vceqq_f32(v[i], v[i]));
+    }
+    if (vminvq_u32(ordered) == 0) {
+        return ppm_argmax_scalar_f32(slots, ppm_order);
+    }
+    
+    max = vdupq_n_f32(vmaxvq_f32(max));
+    
+    const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t bits = vld1q_u32(lane_bits);
+    unsigned int mask = 0;
+    for (int i = 0; i < num_vec; i++) {
+        mask |= vaddvq_u32(vandq_u32(vceqq_f32(v[i], max), bits)) << (4 * i);
+    }
+    
+    return __builtin_ctz(mask);
+}
+
+#endif /* FSO_HAVE_NEON */
+
+/**
+ * @brief Argmax kernels of one instruction-set family
+ * 
+ * Orders below the minimum use the scalar loop.
+ */
+typedef struct {
+    PPMArgmaxFn argmax;
+    int min_order;
+    PPMArgmaxF32Fn argmax_f32;
+    int min_order_f32;
+} PPMKernels;
+
+static const PPMKernels ppm_kernels_scalar = {
+    ppm_argmax_scalar, 2, ppm_argmax_scalar_f32, 2
+};
+
+#if FSO_HAVE_X86_SIMD
+static const PPMKernels ppm_kernels_sse42 = {
+    ppm_argmax_sse42, 4, ppm_argmax_sse42_f32, 4
+};
+static const PPMKernels ppm_kernels_avx2 = {
+    ppm_argmax_avx2, 4, ppm_argmax_avx2_f32, 8
+};
+static const PPMKernels ppm_kernels_avx512 = {
+    ppm_argmax_avx512, 4, ppm_argmax_avx512_f32, 8
+};
+#endif
+
+#if FSO_HAVE_NEON
+static const PPMKernels ppm_kernels_neon = {
+    ppm_argmax_neon, 4, ppm_argmax_neon_f32, 4
+};
+#endif
+
+static const PPMKernels* ppm_kernels(void) {
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: return &ppm_kernels_avx512;
+        case FSO_SIMD_AVX2:   return &ppm_kernels_avx2;
+        case FSO_SIMD_SSE42:  return &ppm_kernels_sse42;
+#endif
+#if FSO_HAVE_NEON
+        case FSO_SIMD_NEON:   return &ppm_kernels_neon;
+#endif
+        default:              return &ppm_kernels_scalar;
     }
 }
 
@@ -129,29 +479,14 @@ int ppm_modulate(const uint8_t* data, size_t data_len,
     // Initialize all slots to 0.0
     memset(symbols, 0, total_slots * sizeof(double));
     
-    size_t bit_offset = 0;
-    size_t slot_offset = 0;
+    PPMBitCursor cur = {0, 0, 0};
+    double* slots = symbols;
     
     for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
-        // Extract bits for this symbol
-        uint8_t bits = 0;
-        if (bit_offset + bits_per_sym <= total_bits) {
-            bits = extract_bits(data, bit_offset, bits_per_sym);
-        } else {
-            // Last symbol may have fewer bits - pad with zeros
-            int remaining_bits = total_bits - bit_offset;
-            if (remaining_bits > 0) {
-                bits = extract_bits(data, bit_offset, remaining_bits);
-                bits <<= (bits_per_sym - remaining_bits);  // Pad with zeros
-            }
-        }
-        
         // Place pulse in the slot corresponding to the bit pattern
-        int pulse_slot = bits;
-        symbols[slot_offset + pulse_slot] = 1.0;
-        
-        bit_offset += bits_per_sym;
-        slot_offset += ppm_order;
+        unsigned int pulse_slot = ppm_read_bits(&cur, data, data_len, bits_per_sym);
+        slots[pulse_slot] = 1.0;
+        slots += ppm_order;
     }
     
     *symbol_len = total_slots;
@@ -162,6 +497,34 @@ int ppm_modulate(const uint8_t* data, size_t data_len,
     return FSO_SUCCESS;
 }
 
+int ppm_modulate_f32(const uint8_t* data, size_t data_len,
+                     float* symbols, size_t* symbol_len, int ppm_order) {
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(symbol_len);
+    FSO_CHECK_PARAM(data_len > 0);
+    FSO_CHECK_PARAM(ppm_order == 2 || ppm_order == 4 || 
+                    ppm_order == 8 || ppm_order == 16);
+    
+    int bits_per_sym = ppm_bits_per_symbol(ppm_order);
+    size_t num_symbols = (data_len * 8 + bits_per_sym - 1) / bits_per_sym;
+    size_t total_slots = num_symbols * ppm_order;
+    
+    memset(symbols, 0, total_slots * sizeof(float));
+    
+    PPMBitCursor cur = {0, 0, 0};
+    float* slots = symbols;
+    
+    for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
+        slots[ppm_read_bits(&cur, data, data_len, bits_per_sym)] = 1.0f;
+        slots += ppm_order;
+    }
+    
+    *symbol_len = total_slots;
+    
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * PPM Demodulation
  * ============================================================================ */
@@ -181,47 +544,173 @@ int ppm_demodulate(const double* symbols, size_t symbol_len,
     size_t total_bits = num_symbols * bits_per_sym;
     size_t num_bytes = (total_bits + 7) / 8;  // Ceiling division
     
-    // Initialize output buffer
-    memset(data, 0, num_bytes);
-    
-    size_t bit_offset = 0;
-    size_t slot_offset = 0;
+    PPMBitCursor cur = {0, 0, 0};
+    const double* slots = symbols;
+    const PPMKernels* kernels = ppm_kernels();
+    PPMArgmaxFn argmax = ppm_order >= kernels->min_order ? kernels->argmax
+                                                         : ppm_argmax_scalar;
     
     for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
         // Maximum likelihood detection: find slot with highest energy
-        int max_slot = 0;
-        double max_value = symbols[slot_offset];
+        int max_slot = argmax(slots, ppm_order);
         
+        // The slot index directly gives us the bit pattern
+        ppm_write_bits(&cur, data, (unsigned int)max_slot, bits_per_sym);
+        slots += ppm_order;
+    }
+    ppm_flush_bits(&cur, data);
+    
+    *data_len = num_bytes;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Demodulated %zu %d-PPM symbols (%zu slots) to %zu bytes",
+                 num_symbols, ppm_order, symbol_len, num_bytes);
+    
+    return FSO_SUCCESS;
+}
+
+int ppm_demodulate_f32(const float* symbols, size_t symbol_len,
+                       uint8_t* data, size_t* data_len, int ppm_order) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_NULL(data_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(symbol_len % ppm_order == 0);
+    FSO_CHECK_PARAM(ppm_order == 2 || ppm_order == 4 || 
+                    ppm_order == 8 || ppm_order == 16);
+    
+    int bits_per_sym = ppm_bits_per_symbol(ppm_order);
+    size_t num_symbols = symbol_len / ppm_order;
+    
+    PPMBitCursor cur = {0, 0, 0};
+    const float* slots = symbols;
+    const PPMKernels* kernels = ppm_kernels();
+    PPMArgmaxF32Fn argmax = ppm_order >= kernels->min_order_f32 ? kernels->argmax_f32
+                                                                : ppm_argmax_scalar_f32;
+    
+    for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
+        int max_slot = argmax(slots, ppm_order);
+        ppm_write_bits(&cur, data, (unsigned int)max_slot, bits_per_sym);
+        slots += ppm_order;
+    }
+    ppm_flush_bits(&cur, data);
+    
+    *data_len = (num_symbols * bits_per_sym + 7) / 8;
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * PPM Soft Demodulation
+ * ============================================================================ */
+
+int ppm_demodulate_soft(const double* symbols, size_t symbol_len,
+                        const SoftDemodParams* params, float* llr, size_t* llr_len,
+                        int ppm_order) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(ppm_order == 2 || ppm_order == 4 || 
+                    ppm_order == 8 || ppm_order == 16);
+    FSO_CHECK_PARAM(symbol_len % ppm_order == 0);
+    FSO_CHECK_PARAM(params->noise_variance > 0.0);
+    
+    int bits_per_sym = ppm_bits_per_symbol(ppm_order);
+    size_t num_symbols = symbol_len / ppm_order;
+    const double scale = params->amplitude / params->noise_variance;
+    const double* slots = symbols;
+    float* out = llr;
+    
+    for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
+        // Slot likelihoods relative to the best slot, so the largest term is 1
+        double weight[16];
+        double max_value = slots[0];
         for (int slot = 1; slot < ppm_order; slot++) {
-            if (symbols[slot_offset + slot] > max_value) {
-                max_value = symbols[slot_offset + slot];
-                max_slot = slot;
+            max_value = FSO_MAX(max_value, slots[slot]);
+        }
+        for (int slot = 0; slot < ppm_order; slot++) {
+            weight[slot] = exp(scale * (slots[slot] - max_value));
+        }
+        
+        // Bit j (MSB first) splits the slots by bit (bits_per_sym - 1 - j) of the index
+        for (int j = 0; j < bits_per_sym; j++) {
+            unsigned int mask = 1u << (bits_per_sym - 1 - j);
+            double sum_zero = 0.0;
+            double sum_one = 0.0;
+            for (int slot = 0; slot < ppm_order; slot++) {
+                if ((unsigned int)slot & mask) {
+                    sum_one += weight[slot];
+                } else {
+                    sum_zero += weight[slot];
+                }
             }
+            double value = log(sum_zero) - log(sum_one);
+            out[j] = (float)FSO_CLAMP(value, -MOD_LLR_CLIP, MOD_LLR_CLIP);
         }
         
-        // The slot index directly gives us the bit pattern
-        uint8_t bits = (uint8_t)max_slot;
+        slots += ppm_order;
+        out += bits_per_sym;
+    }
+    
+    *llr_len = num_symbols * bits_per_sym;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Soft-demodulated %zu %d-PPM symbols to %zu LLRs",
+                 num_symbols, ppm_order, *llr_len);
+    
+    return FSO_SUCCESS;
+}
+
+int ppm_demodulate_soft_f32(const float* symbols, size_t symbol_len,
+                            const SoftDemodParams* params, float* llr, size_t* llr_len,
+                            int ppm_order) {
+    FSO_CHECK_NULL(symbols);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_NULL(llr);
+    FSO_CHECK_NULL(llr_len);
+    FSO_CHECK_PARAM(symbol_len > 0);
+    FSO_CHECK_PARAM(ppm_order == 2 || ppm_order == 4 || 
+                    ppm_order == 8 || ppm_order == 16);
+    FSO_CHECK_PARAM(symbol_len % ppm_order == 0);
+    FSO_CHECK_PARAM(params->noise_variance > 0.0);
+    
+    int bits_per_sym = ppm_bits_per_symbol(ppm_order);
+    size_t num_symbols = symbol_len / ppm_order;
+    const float scale = (float)(params->amplitude / params->noise_variance);
+    const float clip = (float)MOD_LLR_CLIP;
+    const float* slots = symbols;
+    float* out = llr;
+    
+    for (size_t sym_idx = 0; sym_idx < num_symbols; sym_idx++) {
+        float weight[16];
+        float max_value = slots[0];
+        for (int slot = 1; slot < ppm_order; slot++) {
+            max_value = FSO_MAX(max_value, slots[slot]);
+        }
+        for (int slot = 0; slot < ppm_order; slot++) {
+            weight[slot] = expf(scale * (slots[slot] - max_value));
+        }
         
-        // Insert bits into output buffer
-        if (bit_offset + bits_per_sym <= total_bits) {
-            insert_bits(data, bit_offset, bits, bits_per_sym);
-        } else {
-            // Last symbol - only insert remaining bits
-            int remaining_bits = total_bits - bit_offset;
-            if (remaining_bits > 0) {
-                bits >>= (bits_per_sym - remaining_bits);
-                insert_bits(data, bit_offset, bits, remaining_bits);
+        for (int j = 0; j < bits_per_sym; j++) {
+            unsigned int mask = 1u << (bits_per_sym - 1 - j);
+            float sum_zero = 0.0f;
+            float sum_one = 0.0f;
+            for (int slot = 0; slot < ppm_order; slot++) {
+                if ((unsigned int)slot & mask) {
+                    sum_one += weight[slot];
+                } else {
+                    sum_zero += weight[slot];
+                }
             }
+            float value = logf(sum_zero) - logf(sum_one);
+            out[j] = FSO_CLAMP(value, -clip, clip);
         }
         
-        bit_offset += bits_per_sym;
-        slot_offset += ppm_order;
+        slots += ppm_order;
+        out += bits_per_sym;
     }
     
-    *data_len = num_bytes;
-    
-    FSO_LOG_DEBUG(MODULE_NAME, "Demodulated %zu %d-PPM symbols (%zu slots) to %zu bytes",
-                 num_symbols, ppm_order, symbol_len, num_bytes);
+    *llr_len = num_symbols * bits_per_sym;
     
     return FSO_SUCCESS;
 }
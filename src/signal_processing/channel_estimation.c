@@ -10,6 +10,428 @@
 
 #define MODULE_NAME "ChannelEstimation"
 
+/* Estimation work (outputs * inner iterations) above which the pool is used */
+#define SP_ESTIMATION_PARALLEL_WORK 32768
+
+/* Workspace regions start on a 64-byte boundary (8 doubles), so every
+ * region has the alignment of the processor's own FFT buffers */
+#define SP_WORKSPACE_REGION(doubles) (((doubles) + 7) & ~(size_t)7)
+
+/* ============================================================================
+ * Workspace
+ * ============================================================================ */
+
+/**
+ * @brief Grow the processor's estimation workspace to at least the given size
+ * 
+ * The workspace comes from fftw_malloc and is kept until sp_free(), so
+ * estimation calls after the first one at a given size allocate nothing.
+ */
+static double* sp_estimation_workspace(SignalProcessor* sp, size_t doubles) {
+    if (sp->estimation_workspace_length >= doubles) {
+        return sp->estimation_workspace;
+    }
+    
+    double* workspace = (double*)fftw_malloc(doubles * sizeof(double));
+    if (workspace == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate %zu-double estimation workspace",
+                      doubles);
+        return NULL;
+    }
+    
+    if (sp->estimation_workspace != NULL) {
+        fftw_free(sp->estimation_workspace);
+    }
+    sp->estimation_workspace = workspace;
+    sp->estimation_workspace_length = doubles;
+    
+    return workspace;
+}
+
+/* ============================================================================
+ * Range Kernels
+ * ============================================================================ */
+
+/**
+ * @brief Arrays of a pilot interpolation
+ */
+typedef struct {
+    const size_t* pilot_positions;
+    const double* pilot_real;     /* Pilot estimates, real parts */
+    const double* pilot_imag;     /* Pilot estimates, imaginary parts */
+    const double* curve_real;     /* Spline second derivatives, NULL for linear */
+    const double* curve_imag;
+    size_t num_pilots;
+    FSOComplexBuffer* channel_estimate;
+} SPPilotInterpolationJob;
+
+/**
+ * @brief Hold one pilot estimate over positions [begin, end)
+ */
+static void sp_hold_pilot(const SPPilotInterpolationJob* job, size_t pilot,
+                          size_t begin, size_t end) {
+    double* real = job->channel_estimate->real;
+    double* imag = job->channel_estimate->imag;
+    const size_t stride = job->channel_estimate->stride;
+    const double value_re = job->pilot_real[pilot];
+    const double value_im = job->pilot_imag[pilot];
+    
+    for (size_t n = begin; n < end; n++) {
+        real[n * stride] = value_re;
+        imag[n * stride] = value_im;
+    }
+}
+
+/**
+ * @brief Interpolate positions [begin, end) between pilots i and i + 1
+ * 
+ * With t the fractional position in the segment and u = 1 - t, linear
+ * interpolation is u y0 + t y1; the natural spline adds
+ * h^2 / 6 ((u^3 - u) M0 + (t^3 - t) M1) for second derivatives M.
+ */
+static void sp_interpolate_segment(const SPPilotInterpolationJob* job, size_t i,
+                                   size_t begin, size_t end) {
+    double* real = job->channel_estimate->real;
+    double* imag = job->channel_estimate->imag;
+    const size_t stride = job->channel_estimate->stride;
+    const size_t left = job->pilot_positions[i];
+    const double span = (double)(job->pilot_positions[i + 1] - left);
+    const double inv_span = 1.0 / span;
+    const double y0_re = job->pilot_real[i];
+    const double y1_re = job->pilot_real[i + 1];
+    const double y0_im = job->pilot_imag[i];
+    const double y1_im = job->pilot_imag[i + 1];
+    const size_t first = begin - left;
+    const size_t count = end - begin;
+    double* out_re = real + begin * stride;
+    double* out_im = imag + begin * stride;
+    
+    if (job->curve_real == NULL) {
+        const double slope_re = y1_re - y0_re;
+        const double slope_im = y1_im - y0_im;
+#ifdef _OPENMP
+        #pragma omp simd
+#endif
+        for (size_t j = 0; j < count; j++) {
+            double t = (double)(first + j) * inv_span;
+            out_re[j * stride] = y0_re + t * slope_re;
+            out_im[j * stride] = y0_im + t * slope_im;
+        }
+        return;
+    }
+    
+    const double scale = span * span / 6.0;
+    const double m0_re = job->curve_real[i] * scale;
+    const double m1_re = job->curve_real[i + 1] * scale;
+    const double m0_im = job->curve_imag[i] * scale;
+    const double m1_im = job->curve_imag[i + 1] * scale;
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (size_t j = 0; j < count; j++) {
+        double t = (double)(first + j) * inv_span;
+        double u = 1.0 - t;
+        double a = u * u * u - u;
+        double b = t * t * t - t;
+        out_re[j * stride] = u * y0_re + t * y1_re + a * m0_re + b * m1_re;
+        out_im[j * stride] = u * y0_im + t * y1_im + a * m0_im + b * m1_im;
+    }
+}
+
+/**
+ * @brief Interpolation between pilots for positions [begin, end)
+ * 
+ * Finds the segment holding begin by binary search, then walks segments
+ * in order, so the cost is O(count + log P) rather than O(count * P).
+ */
+static void sp_interpolate_pilots_range(void* context, size_t begin, size_t end, int worker) {
+    const SPPilotInterpolationJob* job = (const SPPilotInterpolationJob*)context;
+    const size_t* positions = job->pilot_positions;
+    const size_t last = job->num_pilots - 1;
+    size_t n = begin;
+    (void)worker;
+    
+    // Before the first pilot
+    if (n < positions[0]) {
+        size_t stop = FSO_MIN(end, positions[0]);
+        sp_hold_pilot(job, 0, n, stop);
+        n = stop;
+    }
+    if (n >= end) {
+        return;
+    }
+    
+    // Last pilot at or before n
+    size_t lo = 0;
+    size_t hi = last;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        if (positions[mid] <= n) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    
+    for (size_t i = lo; i < last && n < end; i++) {
+        size_t stop = FSO_MIN(end, positions[i + 1]);
+        if (stop > n) {
+            sp_interpolate_segment(job, i, n, stop);
+            n = stop;
+        }
+    }
+    
+    // After the last pilot
+    if (n < end) {
+        sp_hold_pilot(job, last, n, end);
+    }
+}
+
+/**
+ * @brief Second derivatives of the natural cubic splines through the pilots
+ * 
+ * Solves the tridiagonal system for the real and imaginary parts in one
+ * Thomas sweep (the matrix depends only on the positions). scratch holds
+ * num_pilots doubles.
+ */
+static void sp_pilot_spline(const size_t* positions, const double* y_re, const double* y_im,
+                            size_t num_pilots, double* m_re, double* m_im, double* scratch) {
+    m_re[0] = m_im[0] = 0.0;
+    m_re[num_pilots - 1] = m_im[num_pilots - 1] = 0.0;
+    if (num_pilots < 3) {
+        return;
+    }
+    
+    // Forward elimination: scratch holds the modified super-diagonal
+    scratch[0] = 0.0;
+    for (size_t i = 1; i < num_pilots - 1; i++) {
+        double h0 = (double)(positions[i] - positions[i - 1]);
+        double h1 = (double)(positions[i + 1] - positions[i]);
+        double rhs_re = 6.0 * ((y_re[i + 1] - y_re[i]) / h1 - (y_re[i] - y_re[i - 1]) / h0);
+        double rhs_im = 6.0 * ((y_im[i + 1] - y_im[i]) / h1 - (y_im[i] - y_im[i - 1]) / h0);
+        double pivot = 2.0 * (h0 + h1) - h0 * scratch[i - 1];
+        scratch[i] = h1 / pivot;
+        m_re[i] = (rhs_re - h0 * m_re[i - 1]) / pivot;
+        m_im[i] = (rhs_im - h0 * m_im[i - 1]) / pivot;
+    }
+    
+    // Back substitution (M at the last pilot stays zero)
+    for (size_t i = num_pilots - 2; i > 0; i--) {
+        m_re[i] -= scratch[i] * m_re[i + 1];
+        m_im[i] -= scratch[i] * m_im[i + 1];
+    }
+}
+
+/**
+ * @brief Arrays of a least-squares tap estimate
+ */
+typedef struct {
+    const FSOComplexBuffer* received;
+    const FSOComplexBuffer* transmitted;
+    FSOComplexBuffer* channel_estimate;
+} SPLeastSquaresJob;
+
+/**
+ * @brief Correlation estimate of taps [begin, end)
+ * 
+ * Works on the real and imaginary parts directly, so split buffers run
+ * as unit-stride vector loops.
+ */
+static void sp_least_squares_range(void* context, size_t begin, size_t end, int worker) {
+    const SPLeastSquaresJob* job = (const SPLeastSquaresJob*)context;
+    const double* rx_re = job->received->real;
+    const double* rx_im = job->received->imag;
+    const size_t rx_stride = job->received->stride;
+    const double* tx_re = job->transmitted->real;
+    const double* tx_im = job->transmitted->imag;
+    const size_t tx_stride = job->transmitted->stride;
+    const size_t length = job->received->length;
+    (void)worker;
+    
+    for (size_t k = begin; k < end; k++) {
+        double numerator_re = 0.0;
+        double numerator_im = 0.0;
+        double denominator = 0.0;
+        
+        // Correlation between received and delayed transmitted:
+        // sum r[n] * conj(x[n - k]) over sum |x[n - k]|^2
+        for (size_t n = k; n < length; n++) {
+            double yr = rx_re[n * rx_stride];
+            double yi = rx_im[n * rx_stride];
+            double xr = tx_re[(n - k) * tx_stride];
+            double xi = tx_im[(n - k) * tx_stride];
+            numerator_re += yr * xr + yi * xi;
+            numerator_im += yi * xr - yr * xi;
+            denominator += xr * xr + xi * xi;
+        }
+        
+        FSOComplexBuffer* estimate = job->channel_estimate;
+        if (denominator > 1e-10) {
+            estimate->real[k * estimate->stride] = numerator_re / denominator;
+            estimate->imag[k * estimate->stride] = numerator_im / denominator;
+        } else {
+            estimate->real[k * estimate->stride] = 0.0;
+            estimate->imag[k * estimate->stride] = 0.0;
+        }
+    }
+}
+
+/**
+ * @brief Least-squares taps through FFT cross-correlation
+ * 
+ * With y = yr + i yi and x = xr + i xi, the numerator
+ * sum y[n] conj(x[n - k]) splits into four real cross-correlations,
+ * computed from four r2c transforms and two c2r transforms of size
+ * M >= N + L - 1 (no circular wrap over lags 0..L-1). The denominators
+ * sum |x[m]|^2 over m <= N - 1 - k are built by adding samples as k
+ * falls, so there is no cancellation. All buffers live in the processor's
+ * estimation workspace and all plans come from its cache.
+ */
+static int sp_least_squares_fft(SignalProcessor* sp, const FSOComplexBuffer* received,
+                                const FSOComplexBuffer* transmitted,
+                                FSOComplexBuffer* channel_estimate, size_t channel_length) {
+    const size_t length = received->length;
+    size_t fft_size = 64;
+    while (fft_size < length + channel_length - 1) {
+        fft_size *= 2;
+    }
+    const size_t bins = (fft_size / 2) + 1;
+    const size_t time_region = SP_WORKSPACE_REGION(fft_size);
+    const size_t spectrum_region = SP_WORKSPACE_REGION(2 * bins);
+    
+    double* workspace = sp_estimation_workspace(sp, 3 * time_region + 4 * spectrum_region);
+    if (workspace == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    double* staging = workspace;
+    double* correlation_re = workspace + time_region;
+    double* correlation_im = workspace + 2 * time_region;
+    double complex* spectra[4];
+    for (int s = 0; s < 4; s++) {
+        spectra[s] = (double complex*)(workspace + 3 * time_region + s * spectrum_region);
+    }
+    
+    // Spectra of yr, yi, xr, xi (zero-padded to the FFT size)
+    const double* planes[4] = { received->real, received->imag,
+                                transmitted->real, transmitted->imag };
+    const size_t strides[4] = { received->stride, received->stride,
+                                transmitted->stride, transmitted->stride };
+    for (int s = 0; s < 4; s++) {
+        for (size_t n = 0; n < length; n++) {
+            staging[n] = planes[s][n * strides[s]];
+        }
+        memset(staging + length, 0, (fft_size - length) * sizeof(double));
+        
+        int result = sp_fft(sp, staging, spectra[s], fft_size);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    // Re numerator: Yr Xr* + Yi Xi*; Im numerator: Yi Xr* - Yr Xi*
+    double complex* y_re = spectra[0];
+    double complex* y_im = spectra[1];
+    double complex* x_re = spectra[2];
+    double complex* x_im = spectra[3];
+    for (size_t b = 0; b < bins; b++) {
+        double complex xr = conj(x_re[b]);
+        double complex xi = conj(x_im[b]);
+        x_re[b] = y_re[b] * xr + y_im[b] * xi;
+        x_im[b] = y_im[b] * xr - y_re[b] * xi;
+    }
+    
+    int result = sp_ifft(sp, x_re, correlation_re, fft_size);
+    if (result == FSO_SUCCESS) {
+        result = sp_ifft(sp, x_im, correlation_im, fft_size);
+    }
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    // Energy of x[0 .. N - L], then one more sample per smaller lag
+    const double* tx_re = transmitted->real;
+    const double* tx_im = transmitted->imag;
+    const size_t tx_stride = transmitted->stride;
+    double denominator = 0.0;
+    for (size_t m = 0; m + channel_length <= length; m++) {
+        double xr = tx_re[m * tx_stride];
+        double xi = tx_im[m * tx_stride];
+        denominator += xr * xr + xi * xi;
+    }
+    
+    double* est_re = channel_estimate->real;
+    double* est_im = channel_estimate->imag;
+    const size_t est_stride = channel_estimate->stride;
+    for (size_t k = channel_length; k-- > 0; ) {
+        if (k < channel_length - 1) {
+            double xr = tx_re[(length - 1 - k) * tx_stride];
+            double xi = tx_im[(length - 1 - k) * tx_stride];
+            denominator += xr * xr + xi * xi;
+        }
+        
+        if (denominator > 1e-10) {
+            est_re[k * est_stride] = correlation_re[k] / denominator;
+            est_im[k * est_stride] = correlation_im[k] / denominator;
+        } else {
+            est_re[k * est_stride] = 0.0;
+            est_im[k * est_stride] = 0.0;
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Arrays of a squared-error sum
+ */
+typedef struct {
+    const FSOComplexBuffer* received;
+    const FSOComplexBuffer* expected;
+    double** partials;            /* Worker w accumulates into partials[w][0] */
+} SPSquaredErrorJob;
+
+/**
+ * @brief Squared error over samples [begin, end)
+ */
+static double sp_squared_error_sum(const FSOComplexBuffer* received,
+                                   const FSOComplexBuffer* expected,
+                                   size_t begin, size_t end) {
+    const double* rx_re = received->real;
+    const double* rx_im = received->imag;
+    const double* ex_re = expected->real;
+    const double* ex_im = expected->imag;
+    double sum = 0.0;
+    
+    if (received->stride == 1 && expected->stride == 1) {
+#ifdef _OPENMP
+        #pragma omp simd reduction(+:sum)
+#endif
+        for (size_t i = begin; i < end; i++) {
+            double er = rx_re[i] - ex_re[i];
+            double ei = rx_im[i] - ex_im[i];
+            sum += er * er + ei * ei;
+        }
+    } else {
+        const size_t rs = received->stride;
+        const size_t es = expected->stride;
+        for (size_t i = begin; i < end; i++) {
+            double er = rx_re[i * rs] - ex_re[i * es];
+            double ei = rx_im[i * rs] - ex_im[i * es];
+            sum += er * er + ei * ei;
+        }
+    }
+    
+    return sum;
+}
+
+/**
+ * @brief Squared error over samples [begin, end) into the worker's buffer
+ */
+static void sp_squared_error_range(void* context, size_t begin, size_t end, int worker) {
+    const SPSquaredErrorJob* job = (const SPSquaredErrorJob*)context;
+    job->partials[worker][0] = sp_squared_error_sum(job->received, job->expected, begin, end);
+}
+
 /* ============================================================================
  * Channel Estimation Algorithms
  * ============================================================================ */
@@ -21,122 +443,111 @@ int sp_channel_estimate_pilot(SignalProcessor* sp,
                                size_t num_pilots,
                                double complex* channel_estimate,
                                size_t estimate_length) {
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(pilots);
+    FSO_CHECK_NULL(channel_estimate);
+    
+    // Interleaved views over the caller's arrays; nothing is copied
+    FSOComplexBuffer received_view, pilot_view, estimate_view;
+    fso_complex_buffer_wrap(&received_view, (ComplexSample*)received, estimate_length);
+    fso_complex_buffer_wrap(&pilot_view, (ComplexSample*)pilots, num_pilots);
+    fso_complex_buffer_wrap(&estimate_view, (ComplexSample*)channel_estimate, estimate_length);
+    
+    return sp_channel_estimate_pilot_buffer(sp, &received_view, &pilot_view,
+                                            pilot_positions, &estimate_view,
+                                            estimate_length);
+}
+
+int sp_channel_estimate_pilot_buffer(SignalProcessor* sp,
+                                     const FSOComplexBuffer* received,
+                                     const FSOComplexBuffer* pilots,
+                                     const size_t* pilot_positions,
+                                     FSOComplexBuffer* channel_estimate,
+                                     size_t estimate_length) {
+    return sp_channel_estimate_pilot_interp(sp, received, pilots, pilot_positions,
+                                            SP_PILOT_LINEAR, channel_estimate,
+                                            estimate_length);
+}
+
+int sp_channel_estimate_pilot_interp(SignalProcessor* sp,
+                                     const FSOComplexBuffer* received,
+                                     const FSOComplexBuffer* pilots,
+                                     const size_t* pilot_positions,
+                                     SPPilotInterpolation interpolation,
+                                     FSOComplexBuffer* channel_estimate,
+                                     size_t estimate_length) {
     FSO_CHECK_NULL(sp);
     FSO_CHECK_NULL(received);
     FSO_CHECK_NULL(pilots);
     FSO_CHECK_NULL(pilot_positions);
     FSO_CHECK_NULL(channel_estimate);
-    FSO_CHECK_PARAM(num_pilots > 0);
+    FSO_CHECK_PARAM(pilots->length > 0);
     FSO_CHECK_PARAM(estimate_length > 0);
+    FSO_CHECK_PARAM(estimate_length <= channel_estimate->capacity);
+    FSO_CHECK_PARAM(interpolation == SP_PILOT_LINEAR || interpolation == SP_PILOT_SPLINE);
+    
+    size_t num_pilots = pilots->length;
+    
+    // Segments are walked in order; the spline also needs distinct positions
+    for (size_t i = 1; i < num_pilots; i++) {
+        if (pilot_positions[i] < pilot_positions[i - 1] ||
+            (interpolation == SP_PILOT_SPLINE && pilot_positions[i] == pilot_positions[i - 1])) {
+            FSO_LOG_ERROR(MODULE_NAME, "Pilot positions must increase (index %zu)", i);
+            return FSO_ERROR_INVALID_PARAM;
+        }
+    }
     
-    FSO_LOG_DEBUG(MODULE_NAME, "Pilot-based estimation: %zu pilots, length=%zu",
-                  num_pilots, estimate_length);
+    FSO_LOG_DEBUG(MODULE_NAME, "Pilot-based estimation: %zu pilots, length=%zu, %s",
+                  num_pilots, estimate_length,
+                  interpolation == SP_PILOT_SPLINE ? "spline" : "linear");
     
-    // Allocate array for pilot channel estimates
-    double complex* pilot_estimates = (double complex*)malloc(
-        num_pilots * sizeof(double complex));
-    if (pilot_estimates == NULL) {
-        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate pilot estimates");
+    // Pilot estimates (and spline curvature) in the processor's workspace
+    const size_t region = SP_WORKSPACE_REGION(num_pilots);
+    const int planes = (interpolation == SP_PILOT_SPLINE) ? 5 : 2;
+    double* workspace = sp_estimation_workspace(sp, planes * region);
+    if (workspace == NULL) {
         return FSO_ERROR_MEMORY;
     }
+    double* pilot_real = workspace;
+    double* pilot_imag = workspace + region;
     
-    // Compute channel estimate at pilot positions (parallel)
-#ifdef _OPENMP
-    if (sp->openmp_available) {
-        #pragma omp parallel for num_threads(sp->num_threads)
-        for (size_t i = 0; i < num_pilots; i++) {
-            size_t pos = pilot_positions[i];
-            if (pos < estimate_length) {
-                // H = Y / X (received / transmitted)
-                double complex pilot = pilots[i];
-                if (cabs(pilot) > 1e-10) {
-                    pilot_estimates[i] = received[pos] / pilot;
-                } else {
-                    pilot_estimates[i] = 0.0 + 0.0 * I;
-                }
-            } else {
-                pilot_estimates[i] = 0.0 + 0.0 * I;
-            }
-        }
-    } else
-#endif
-    {
-        // Serial computation
-        for (size_t i = 0; i < num_pilots; i++) {
-            size_t pos = pilot_positions[i];
-            if (pos < estimate_length) {
-                double complex pilot = pilots[i];
-                if (cabs(pilot) > 1e-10) {
-                    pilot_estimates[i] = received[pos] / pilot;
-                } else {
-                    pilot_estimates[i] = 0.0 + 0.0 * I;
-                }
-            } else {
-                pilot_estimates[i] = 0.0 + 0.0 * I;
+    // Compute channel estimate at pilot positions (one division per pilot,
+    // too little work to hand to the pool)
+    for (size_t i = 0; i < num_pilots; i++) {
+        size_t pos = pilot_positions[i];
+        double complex estimate = 0.0 + 0.0 * I;
+        if (pos < estimate_length) {
+            // H = Y / X (received / transmitted)
+            double complex pilot = pilots->real[i * pilots->stride] +
+                                   pilots->imag[i * pilots->stride] * I;
+            if (cabs(pilot) > 1e-10) {
+                double complex sample = received->real[pos * received->stride] +
+                                        received->imag[pos * received->stride] * I;
+                estimate = sample / pilot;
             }
         }
+        pilot_real[i] = creal(estimate);
+        pilot_imag[i] = cimag(estimate);
     }
     
-    // Interpolate channel estimates for all positions
-    // Using linear interpolation between pilots
-#ifdef _OPENMP
-    if (sp->openmp_available) {
-        #pragma omp parallel for num_threads(sp->num_threads)
-        for (size_t n = 0; n < estimate_length; n++) {
-            // Find surrounding pilots
-            size_t left_idx = 0;
-            size_t right_idx = num_pilots - 1;
-            
-            for (size_t i = 0; i < num_pilots - 1; i++) {
-                if (pilot_positions[i] <= n && pilot_positions[i + 1] > n) {
-                    left_idx = i;
-                    right_idx = i + 1;
-                    break;
-                }
-            }
-            
-            // Linear interpolation
-            if (left_idx == right_idx) {
-                channel_estimate[n] = pilot_estimates[left_idx];
-            } else {
-                size_t left_pos = pilot_positions[left_idx];
-                size_t right_pos = pilot_positions[right_idx];
-                double alpha = (double)(n - left_pos) / (double)(right_pos - left_pos);
-                
-                channel_estimate[n] = (1.0 - alpha) * pilot_estimates[left_idx] +
-                                     alpha * pilot_estimates[right_idx];
-            }
-        }
-    } else
-#endif
-    {
-        // Serial interpolation
-        for (size_t n = 0; n < estimate_length; n++) {
-            size_t left_idx = 0;
-            size_t right_idx = num_pilots - 1;
-            
-            for (size_t i = 0; i < num_pilots - 1; i++) {
-                if (pilot_positions[i] <= n && pilot_positions[i + 1] > n) {
-                    left_idx = i;
-                    right_idx = i + 1;
-                    break;
-                }
-            }
-            
-            if (left_idx == right_idx) {
-                channel_estimate[n] = pilot_estimates[left_idx];
-            } else {
-                size_t left_pos = pilot_positions[left_idx];
-                size_t right_pos = pilot_positions[right_idx];
-                double alpha = (double)(n - left_pos) / (double)(right_pos - left_pos);
-                
-                channel_estimate[n] = (1.0 - alpha) * pilot_estimates[left_idx] +
-                                     alpha * pilot_estimates[right_idx];
-            }
-        }
+    SPPilotInterpolationJob job = { pilot_positions, pilot_real, pilot_imag, NULL, NULL,
+                                    num_pilots, channel_estimate };
+    if (interpolation == SP_PILOT_SPLINE) {
+        double* curve_real = workspace + 2 * region;
+        double* curve_imag = workspace + 3 * region;
+        sp_pilot_spline(pilot_positions, pilot_real, pilot_imag, num_pilots,
+                        curve_real, curve_imag, workspace + 4 * region);
+        job.curve_real = curve_real;
+        job.curve_imag = curve_imag;
     }
     
-    free(pilot_estimates);
+    // Interpolate channel estimates for all positions
+    if (sp->num_threads > 1 && estimate_length >= SP_ESTIMATION_PARALLEL_WORK) {
+        fso_parallel_for(estimate_length, 0, sp->num_threads, sp_interpolate_pilots_range, &job);
+    } else {
+        sp_interpolate_pilots_range(&job, 0, estimate_length, 0);
+    }
+    channel_estimate->length = estimate_length;
     
     return FSO_SUCCESS;
 }
@@ -147,63 +558,56 @@ int sp_channel_estimate_ls(SignalProcessor* sp,
                             size_t length,
                             double complex* channel_estimate,
                             size_t channel_length) {
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(transmitted);
+    FSO_CHECK_NULL(channel_estimate);
+    
+    FSOComplexBuffer received_view, transmitted_view, estimate_view;
+    fso_complex_buffer_wrap(&received_view, (ComplexSample*)received, length);
+    fso_complex_buffer_wrap(&transmitted_view, (ComplexSample*)transmitted, length);
+    fso_complex_buffer_wrap(&estimate_view, (ComplexSample*)channel_estimate, channel_length);
+    
+    return sp_channel_estimate_ls_buffer(sp, &received_view, &transmitted_view,
+                                         &estimate_view, channel_length);
+}
+
+int sp_channel_estimate_ls_buffer(SignalProcessor* sp,
+                                  const FSOComplexBuffer* received,
+                                  const FSOComplexBuffer* transmitted,
+                                  FSOComplexBuffer* channel_estimate,
+                                  size_t channel_length) {
     FSO_CHECK_NULL(sp);
     FSO_CHECK_NULL(received);
     FSO_CHECK_NULL(transmitted);
     FSO_CHECK_NULL(channel_estimate);
-    FSO_CHECK_PARAM(length > 0);
+    FSO_CHECK_PARAM(received->length > 0);
+    FSO_CHECK_PARAM(transmitted->length >= received->length);
     FSO_CHECK_PARAM(channel_length > 0);
-    FSO_CHECK_PARAM(channel_length <= length);
+    FSO_CHECK_PARAM(channel_length <= received->length);
+    FSO_CHECK_PARAM(channel_length <= channel_estimate->capacity);
+    
+    size_t length = received->length;
     
     FSO_LOG_DEBUG(MODULE_NAME, "Least-squares estimation: length=%zu, channel_len=%zu",
                   length, channel_length);
     
     // Simple least-squares: minimize ||Y - X*H||^2
-    // For each tap of the channel, compute correlation
-    
-    // Initialize channel estimate to zero
-    memset(channel_estimate, 0, channel_length * sizeof(double complex));
-    
-    // Compute each channel tap (parallel over taps)
-#ifdef _OPENMP
-    if (sp->openmp_available) {
-        #pragma omp parallel for num_threads(sp->num_threads)
-        for (size_t k = 0; k < channel_length; k++) {
-            double complex numerator = 0.0 + 0.0 * I;
-            double denominator = 0.0;
-            
-            // Correlation between received and delayed transmitted
-            for (size_t n = k; n < length; n++) {
-                numerator += received[n] * conj(transmitted[n - k]);
-                denominator += cabs(transmitted[n - k]) * cabs(transmitted[n - k]);
-            }
-            
-            if (denominator > 1e-10) {
-                channel_estimate[k] = numerator / denominator;
-            } else {
-                channel_estimate[k] = 0.0 + 0.0 * I;
-            }
+    // Long channels correlate by FFT; short ones tap by tap (parallel over taps)
+    if (channel_length >= SP_LS_FFT_MIN_TAPS) {
+        int result = sp_least_squares_fft(sp, received, transmitted, channel_estimate,
+                                          channel_length);
+        if (result != FSO_SUCCESS) {
+            return result;
         }
-    } else
-#endif
-    {
-        // Serial computation
-        for (size_t k = 0; k < channel_length; k++) {
-            double complex numerator = 0.0 + 0.0 * I;
-            double denominator = 0.0;
-            
-            for (size_t n = k; n < length; n++) {
-                numerator += received[n] * conj(transmitted[n - k]);
-                denominator += cabs(transmitted[n - k]) * cabs(transmitted[n - k]);
-            }
-            
-            if (denominator > 1e-10) {
-                channel_estimate[k] = numerator / denominator;
-            } else {
-                channel_estimate[k] = 0.0 + 0.0 * I;
-            }
+    } else {
+        SPLeastSquaresJob job = { received, transmitted, channel_estimate };
+        if (sp->num_threads > 1 && channel_length * length >= SP_ESTIMATION_PARALLEL_WORK) {
+            fso_parallel_for(channel_length, 0, sp->num_threads, sp_least_squares_range, &job);
+        } else {
+            sp_least_squares_range(&job, 0, channel_length, 0);
         }
     }
+    channel_estimate->length = channel_length;
     
     return FSO_SUCCESS;
 }
@@ -213,32 +617,51 @@ int sp_noise_variance_estimate(SignalProcessor* sp,
                                 const double complex* expected,
                                 size_t length,
                                 double* noise_variance) {
+    FSO_CHECK_NULL(received);
+    FSO_CHECK_NULL(expected);
+    
+    FSOComplexBuffer received_view, expected_view;
+    fso_complex_buffer_wrap(&received_view, (ComplexSample*)received, length);
+    fso_complex_buffer_wrap(&expected_view, (ComplexSample*)expected, length);
+    
+    return sp_noise_variance_estimate_buffer(sp, &received_view, &expected_view,
+                                             noise_variance);
+}
+
+int sp_noise_variance_estimate_buffer(SignalProcessor* sp,
+                                      const FSOComplexBuffer* received,
+                                      const FSOComplexBuffer* expected,
+                                      double* noise_variance) {
     FSO_CHECK_NULL(sp);
     FSO_CHECK_NULL(received);
     FSO_CHECK_NULL(expected);
     FSO_CHECK_NULL(noise_variance);
-    FSO_CHECK_PARAM(length > 0);
+    FSO_CHECK_PARAM(received->length > 0);
+    FSO_CHECK_PARAM(expected->length >= received->length);
+    
+    size_t length = received->length;
     
     FSO_LOG_DEBUG(MODULE_NAME, "Noise variance estimation: length=%zu", length);
     
-    // Compute mean squared error between received and expected
+    // Compute mean squared error between received and expected. Partial
+    // sums go to each worker's own buffer and are added in worker order,
+    // so the result does not depend on scheduling
     double sum_squared_error = 0.0;
     
-#ifdef _OPENMP
-    if (sp->openmp_available) {
-        #pragma omp parallel for reduction(+:sum_squared_error) num_threads(sp->num_threads)
-        for (size_t i = 0; i < length; i++) {
-            double complex error = received[i] - expected[i];
-            sum_squared_error += cabs(error) * cabs(error);
+    if (sp->num_threads > 1 && sp->thread_buffers != NULL &&
+        length >= SP_ESTIMATION_PARALLEL_WORK) {
+        for (int w = 0; w < sp->num_threads; w++) {
+            sp->thread_buffers[w][0] = 0.0;
         }
-    } else
-#endif
-    {
-        // Serial computation
-        for (size_t i = 0; i < length; i++) {
-            double complex error = received[i] - expected[i];
-            sum_squared_error += cabs(error) * cabs(error);
+        
+        SPSquaredErrorJob job = { received, expected, sp->thread_buffers };
+        fso_parallel_for(length, 0, sp->num_threads, sp_squared_error_range, &job);
+        
+        for (int w = 0; w < sp->num_threads; w++) {
+            sum_squared_error += sp->thread_buffers[w][0];
         }
+    } else {
+        sum_squared_error = sp_squared_error_sum(received, expected, 0, length);
     }
     
     // Variance is average squared error
@@ -248,3 +671,128 @@ int sp_noise_variance_estimate(SignalProcessor* sp,
     
     return FSO_SUCCESS;
 }
+
+/* ============================================================================
+ * Recursive Least-Squares Tracking
+ * ============================================================================ */
+
+int sp_rls_tracker_init(SPRlsTracker* tracker, int num_taps,
+                        double forgetting_factor, double delta) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_PARAM(num_taps > 0);
+    FSO_CHECK_PARAM(forgetting_factor > 0.0 && forgetting_factor <= 1.0);
+    FSO_CHECK_PARAM(delta > 0.0);
+    
+    memset(tracker, 0, sizeof(SPRlsTracker));
+    tracker->num_taps = num_taps;
+    tracker->forgetting_factor = forgetting_factor;
+    tracker->delta = delta;
+    
+    size_t taps = (size_t)num_taps;
+    tracker->taps = (double complex*)calloc(taps, sizeof(double complex));
+    tracker->inverse_correlation = (double complex*)calloc(taps * taps, sizeof(double complex));
+    tracker->gain = (double complex*)calloc(taps, sizeof(double complex));
+    tracker->projection = (double complex*)calloc(taps, sizeof(double complex));
+    tracker->delay_line = (double complex*)calloc(2 * taps, sizeof(double complex));
+    if (!tracker->taps || !tracker->inverse_correlation || !tracker->gain ||
+        !tracker->projection || !tracker->delay_line) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate RLS tracker buffers");
+        sp_rls_tracker_free(tracker);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    sp_rls_tracker_reset(tracker);
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "RLS tracker: %d taps, lambda=%f, delta=%f",
+                  num_taps, forgetting_factor, delta);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_rls_tracker_update(SPRlsTracker* tracker, const double complex* transmitted,
+                          const double complex* received, size_t count) {
+    FSO_CHECK_NULL(tracker);
+    FSO_CHECK_NULL(tracker->taps);
+    FSO_CHECK_NULL(transmitted);
+    FSO_CHECK_NULL(received);
+    
+    const int taps = tracker->num_taps;
+    const double lambda = tracker->forgetting_factor;
+    const double inv_lambda = 1.0 / lambda;
+    double complex* h = tracker->taps;
+    double complex* P = tracker->inverse_correlation;
+    double complex* k = tracker->gain;
+    double complex* pi = tracker->projection;
+    
+    // With regressor v = conj(u), u[j] = x[n - j]: y = v^H h, so the
+    // standard RLS recursion applies with P = (sum lambda^(n-i) v v^H)^-1
+    for (size_t s = 0; s < count; s++) {
+        int p = (tracker->position == 0) ? taps - 1 : tracker->position - 1;
+        tracker->delay_line[p] = transmitted[s];
+        tracker->delay_line[p + taps] = transmitted[s];
+        tracker->position = p;
+        const double complex* u = tracker->delay_line + p;
+        
+        // pi = P v, a priori error e = y - u^T h
+        double complex error = received[s];
+        double complex power = lambda;
+        for (int i = 0; i < taps; i++) {
+            const double complex* row = P + (size_t)i * taps;
+            double complex sum = 0.0;
+            for (int j = 0; j < taps; j++) {
+                sum += row[j] * conj(u[j]);
+            }
+            pi[i] = sum;
+            power += u[i] * sum;
+            error -= u[i] * h[i];
+        }
+        
+        // k = pi / (lambda + v^H pi); h += k e
+        double inv_power = 1.0 / creal(power);
+        for (int i = 0; i < taps; i++) {
+            k[i] = pi[i] * inv_power;
+            h[i] += k[i] * error;
+        }
+        
+        // P = (P - k pi^H) / lambda (rank-one, stays Hermitian)
+        for (int i = 0; i < taps; i++) {
+            double complex* row = P + (size_t)i * taps;
+            const double complex ki = k[i];
+            for (int j = 0; j < taps; j++) {
+                row[j] = (row[j] - ki * conj(pi[j])) * inv_lambda;
+            }
+        }
+    }
+    tracker->samples += count;
+    
+    return FSO_SUCCESS;
+}
+
+void sp_rls_tracker_reset(SPRlsTracker* tracker) {
+    if (tracker == NULL || tracker->taps == NULL) {
+        return;
+    }
+    
+    size_t taps = (size_t)tracker->num_taps;
+    memset(tracker->taps, 0, taps * sizeof(double complex));
+    memset(tracker->inverse_correlation, 0, taps * taps * sizeof(double complex));
+    for (size_t i = 0; i < taps; i++) {
+        tracker->inverse_correlation[i * taps + i] = tracker->delta;
+    }
+    memset(tracker->delay_line, 0, 2 * taps * sizeof(double complex));
+    tracker->position = 0;
+    tracker->samples = 0;
+}
+
+void sp_rls_tracker_free(SPRlsTracker* tracker) {
+    if (tracker == NULL) {
+        return;
+    }
+    
+    free(tracker->taps);
+    free(tracker->inverse_correlation);
+    free(tracker->gain);
+    free(tracker->projection);
+    free(tracker->delay_line);
+    memset(tracker, 0, sizeof(SPRlsTracker));
+}
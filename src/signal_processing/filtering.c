@@ -1,6 +1,6 @@
 /**
  * @file filtering.c
- * @brief Parallel filtering operations implementation
+ * @brief Parallel filtering operations implementation (shared worker pool)
  */
 
 #include "signal_processing.h"
@@ -10,10 +10,109 @@
 
 #define MODULE_NAME "Filtering"
 
+/* Block LMS filtering work (outputs * taps) above which the pool is used */
+#define SP_LMS_PARALLEL_WORK 32768
+
+/* Moving-average length above which the pool is used */
+#define SP_MOVING_AVERAGE_PARALLEL_MIN 4096
+
+/* Direct convolution work (outputs * taps) above which the pool is used */
+#define SP_CONVOLUTION_PARALLEL_WORK 32768
+
 /* ============================================================================
  * Filtering Operations
  * ============================================================================ */
 
+/**
+ * @brief Sample-by-sample LMS over [begin, end)
+ * 
+ * Samples before index 0 are treated as zero. Once the tap line is full the
+ * inner loops have no bounds checks and vectorize.
+ */
+static void sp_lms_sample_range(double* weights, int num_taps, const double* input,
+                                const double* desired, double* output,
+                                size_t begin, size_t end, double mu) {
+    const size_t taps = (size_t)num_taps;
+    
+    for (size_t n = begin; n < end; n++) {
+        size_t span = FSO_MIN(taps, n + 1);
+        const double* x = input + n;
+        
+        double y = 0.0;
+#ifdef _OPENMP
+        #pragma omp simd reduction(+:y)
+#endif
+        for (size_t k = 0; k < span; k++) {
+            y += weights[k] * x[-(ptrdiff_t)k];
+        }
+        output[n] = y;
+        
+        double step = 2.0 * mu * (desired[n] - y);
+#ifdef _OPENMP
+        #pragma omp simd
+#endif
+        for (size_t k = 0; k < span; k++) {
+            weights[k] += step * x[-(ptrdiff_t)k];
+        }
+    }
+}
+
+/**
+ * @brief Arrays of a pooled moving average
+ */
+typedef struct {
+    const double* input;
+    double* output;
+    size_t length;
+    int window;
+} SPMovingAverageJob;
+
+/**
+ * @brief Sliding-sum moving average over output samples [begin, end)
+ * 
+ * The window sum for begin is computed directly (this is the chunk's halo),
+ * then each step adds the sample entering the window and removes the one
+ * leaving it. Compensated (Kahan) updates keep the running sum from
+ * drifting over long chunks.
+ */
+static void sp_moving_average_range(const double* input, double* output, size_t length,
+                                    int window, size_t begin, size_t end) {
+    const long half = window / 2;
+    long start = (long)begin - half;
+    long stop = start + window;
+    double sum = 0.0;
+    double compensation = 0.0;
+    
+    for (long j = FSO_MAX(start, 0L); j < FSO_MIN(stop, (long)length); j++) {
+        sum += input[j];
+    }
+    
+    for (size_t i = begin; i < end; i++) {
+        long lo = FSO_MAX(start, 0L);
+        long hi = FSO_MIN(stop, (long)length);
+        output[i] = sum / (double)(hi - lo);
+        
+        // Slide the window by one sample
+        double delta = 0.0;
+        if (stop < (long)length) delta += input[stop];
+        if (start >= 0) delta -= input[start];
+        
+        double y = delta - compensation;
+        double t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+        
+        start++;
+        stop++;
+    }
+}
+
+static void sp_moving_average_chunk(void* context, size_t begin, size_t end, int worker) {
+    const SPMovingAverageJob* job = (const SPMovingAverageJob*)context;
+    (void)worker;
+    sp_moving_average_range(job->input, job->output, job->length, job->window, begin, end);
+}
+
 int sp_moving_average(SignalProcessor* sp, const double* input,
                       double* output, size_t length, int window) {
     FSO_CHECK_NULL(sp);
@@ -30,50 +129,14 @@ int sp_moving_average(SignalProcessor* sp, const double* input,
     FSO_LOG_DEBUG(MODULE_NAME, "Moving average: length=%zu, window=%d, threads=%d",
                   length, window, sp->num_threads);
     
-    // Parallel implementation using OpenMP
-#ifdef _OPENMP
-    if (sp->openmp_available) {
-        #pragma omp parallel for num_threads(sp->num_threads)
-        for (size_t i = 0; i < length; i++) {
-            double sum = 0.0;
-            int count = 0;
-            
-            // Determine window bounds (handle edges)
-            int start = (int)i - window / 2;
-            int end = start + window;
-            
-            if (start < 0) start = 0;
-            if (end > (int)length) end = (int)length;
-            
-            // Compute average
-            for (int j = start; j < end; j++) {
-                sum += input[j];
-                count++;
-            }
-            
-            output[i] = sum / count;
-        }
-    } else
-#endif
-    {
+    // O(N) sliding sum; workers take contiguous chunks and each seeds its
+    // own window sum, so the cost is O(N + threads * W)
+    if (sp->num_threads > 1 && length >= SP_MOVING_AVERAGE_PARALLEL_MIN) {
+        SPMovingAverageJob job = { input, output, length, window };
+        fso_parallel_for(length, 0, sp->num_threads, sp_moving_average_chunk, &job);
+    } else {
         // Serial fallback
-        for (size_t i = 0; i < length; i++) {
-            double sum = 0.0;
-            int count = 0;
-            
-            int start = (int)i - window / 2;
-            int end = start + window;
-            
-            if (start < 0) start = 0;
-            if (end > (int)length) end = (int)length;
-            
-            for (int j = start; j < end; j++) {
-                sum += input[j];
-                count++;
-            }
-            
-            output[i] = sum / count;
-        }
+        sp_moving_average_range(input, output, length, window, 0, length);
     }
     
     return FSO_SUCCESS;
@@ -101,53 +164,299 @@ int sp_adaptive_filter(SignalProcessor* sp, const double* input,
                      sp->filter_length);
     }
     
-    int filter_len = sp->filter_length;
-    double* weights = sp->filter_coeffs;
-    
     FSO_LOG_DEBUG(MODULE_NAME, "Adaptive LMS filter: length=%zu, mu=%f, taps=%d",
-                  length, mu, filter_len);
+                  length, mu, sp->filter_length);
+    
+    // LMS is sequential in n; a parallel region per sample costs far more
+    // than the tap loop, so only the tap loops are vectorized
+    sp_lms_sample_range(sp->filter_coeffs, sp->filter_length, input, desired,
+                        output, 0, length, mu);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Block and Frequency-Domain Adaptive Filtering
+ * ============================================================================ */
+
+/**
+ * @brief Resize the adaptive weights to num_taps (resets them on change)
+ */
+static int sp_prepare_weights(SignalProcessor* sp, int num_taps) {
+    if (sp->filter_coeffs != NULL && sp->filter_length == num_taps) {
+        return FSO_SUCCESS;
+    }
+    
+    double* weights = (double*)calloc((size_t)num_taps, sizeof(double));
+    if (weights == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate filter coefficients");
+        return FSO_ERROR_MEMORY;
+    }
     
-    // LMS algorithm - must be sequential due to weight updates
-    for (size_t n = 0; n < length; n++) {
-        // Compute filter output
+    free(sp->filter_coeffs);
+    sp->filter_coeffs = weights;
+    sp->filter_length = num_taps;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Initialized adaptive filter with %d taps", num_taps);
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Arrays of a pooled block LMS filtering pass
+ */
+typedef struct {
+    const double* weights;
+    size_t taps;
+    const double* input;
+    const double* desired;
+    double* output;
+    double* error;
+    size_t begin;
+} SPLMSFilterJob;
+
+/**
+ * @brief Block outputs and errors for block offsets [first, last)
+ */
+static void sp_lms_filter_range(void* context, size_t first, size_t last, int worker) {
+    const SPLMSFilterJob* job = (const SPLMSFilterJob*)context;
+    (void)worker;
+    
+    for (size_t i = first; i < last; i++) {
+        size_t n = job->begin + i;
+        size_t span = FSO_MIN(job->taps, n + 1);
+        const double* x = job->input + n;
         double y = 0.0;
-        for (int k = 0; k < filter_len; k++) {
-            int idx = (int)n - k;
-            if (idx >= 0) {
-                y += weights[k] * input[idx];
-            }
+#ifdef _OPENMP
+        #pragma omp simd reduction(+:y)
+#endif
+        for (size_t k = 0; k < span; k++) {
+            y += job->weights[k] * x[-(ptrdiff_t)k];
         }
-        output[n] = y;
-        
-        // Compute error
-        double error = desired[n] - y;
-        
-        // Update weights in parallel
+        job->output[n] = y;
+        job->error[i] = job->desired[n] - y;
+    }
+}
+
+/**
+ * @brief Block LMS over samples [begin, begin + count) with weights held fixed
+ * 
+ * Outputs and errors for the whole block use the same weights, then the
+ * accumulated gradient is applied once: w += 2 mu sum_n e[n] x_n.
+ */
+static void sp_lms_block(SignalProcessor* sp, double* weights, int num_taps,
+                         const double* input, const double* desired, double* output,
+                         double* error, size_t begin, size_t count, double mu) {
+    const size_t taps = (size_t)num_taps;
+    
+    // Filtering: independent outputs, parallel only when the block is large
+    SPLMSFilterJob job = { weights, taps, input, desired, output, error, begin };
+    if (sp->num_threads > 1 && count * taps >= SP_LMS_PARALLEL_WORK) {
+        fso_parallel_for(count, 0, sp->num_threads, sp_lms_filter_range, &job);
+    } else {
+        sp_lms_filter_range(&job, 0, count, 0);
+    }
+    
+    // Gradient: one correlation per tap
+    for (size_t k = 0; k < taps; k++) {
+        double gradient = 0.0;
+        size_t first = (begin >= k) ? 0 : k - begin;
 #ifdef _OPENMP
-        if (sp->openmp_available) {
-            #pragma omp parallel for num_threads(sp->num_threads)
-            for (int k = 0; k < filter_len; k++) {
-                int idx = (int)n - k;
-                if (idx >= 0) {
-                    weights[k] += 2.0 * mu * error * input[idx];
-                }
-            }
-        } else
+        #pragma omp simd reduction(+:gradient)
 #endif
-        {
-            // Serial weight update
-            for (int k = 0; k < filter_len; k++) {
-                int idx = (int)n - k;
-                if (idx >= 0) {
-                    weights[k] += 2.0 * mu * error * input[idx];
-                }
+        for (size_t i = first; i < count; i++) {
+            gradient += error[i] * input[begin + i - k];
+        }
+        weights[k] += 2.0 * mu * gradient;
+    }
+}
+
+/**
+ * @brief Frequency-domain block LMS (constrained overlap-save FDAF)
+ * 
+ * For a block of B samples and M taps with N >= M + B - 1, the FFT window
+ * holds the N inputs ending at the block's last sample. The last B samples
+ * of IFFT(X W) are the block outputs, and the first M samples of
+ * IFFT(conj(X) E), with the errors placed at the window's last B positions,
+ * are the gradient correlations. The gradient constraint (kept in the time
+ * domain) makes the update identical to block LMS at O(N log N) per block.
+ */
+static int sp_fdaf(SignalProcessor* sp, double* weights, int num_taps,
+                   const double* input, const double* desired, double* output,
+                   size_t length, size_t block_size, double mu, size_t* processed) {
+    const size_t taps = (size_t)num_taps;
+    size_t fft_size = 64;
+    while (fft_size < taps + block_size - 1) {
+        fft_size *= 2;
+    }
+    const size_t bins = (fft_size / 2) + 1;
+    
+    double* window = (double*)fftw_malloc(fft_size * sizeof(double));
+    double complex* x_spectrum = (double complex*)fftw_malloc(bins * sizeof(double complex));
+    double complex* w_spectrum = (double complex*)fftw_malloc(bins * sizeof(double complex));
+    double complex* scratch = (double complex*)fftw_malloc(bins * sizeof(double complex));
+    
+    if (!window || !x_spectrum || !w_spectrum || !scratch) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FDAF buffers");
+        if (window) fftw_free(window);
+        if (x_spectrum) fftw_free(x_spectrum);
+        if (w_spectrum) fftw_free(w_spectrum);
+        if (scratch) fftw_free(scratch);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    int ret = FSO_SUCCESS;
+    const size_t error_start = fft_size - block_size;
+    size_t begin = 0;
+    
+    for (; begin + block_size <= length && ret == FSO_SUCCESS; begin += block_size) {
+        size_t end = begin + block_size;
+        
+        // Input window: N samples ending at the block's last sample
+        size_t available = FSO_MIN(end, fft_size);
+        memset(window, 0, (fft_size - available) * sizeof(double));
+        memcpy(window + fft_size - available, input + end - available,
+               available * sizeof(double));
+        ret = sp_fft(sp, window, x_spectrum, fft_size);
+        
+        // Weight spectrum from the current time-domain weights
+        if (ret == FSO_SUCCESS) {
+            memcpy(window, weights, taps * sizeof(double));
+            memset(window + taps, 0, (fft_size - taps) * sizeof(double));
+            ret = sp_fft(sp, window, w_spectrum, fft_size);
+        }
+        
+        // Outputs: last B samples of the circular convolution
+        if (ret == FSO_SUCCESS) {
+            for (size_t i = 0; i < bins; i++) {
+                scratch[i] = x_spectrum[i] * w_spectrum[i];
             }
+            ret = sp_ifft(sp, scratch, window, fft_size);
+        }
+        if (ret != FSO_SUCCESS) break;
+        
+        for (size_t i = 0; i < block_size; i++) {
+            output[begin + i] = window[error_start + i];
+        }
+        
+        // Errors at the last B window positions, zeros elsewhere
+        memset(window, 0, error_start * sizeof(double));
+        for (size_t i = 0; i < block_size; i++) {
+            window[error_start + i] = desired[begin + i] - output[begin + i];
+        }
+        ret = sp_fft(sp, window, scratch, fft_size);
+        if (ret != FSO_SUCCESS) break;
+        
+        // Gradient: first M lags of the circular cross-correlation
+        for (size_t i = 0; i < bins; i++) {
+            scratch[i] *= conj(x_spectrum[i]);
+        }
+        ret = sp_ifft(sp, scratch, window, fft_size);
+        if (ret != FSO_SUCCESS) break;
+        
+        for (size_t k = 0; k < taps; k++) {
+            weights[k] += 2.0 * mu * window[k];
         }
     }
     
+    *processed = begin;
+    
+    fftw_free(window);
+    fftw_free(x_spectrum);
+    fftw_free(w_spectrum);
+    fftw_free(scratch);
+    
+    return ret;
+}
+
+int sp_adaptive_filter_block(SignalProcessor* sp, const SPAdaptiveConfig* config,
+                             const double* input, const double* desired,
+                             double* output, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(desired);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0);
+    FSO_CHECK_PARAM(config->num_taps > 0);
+    FSO_CHECK_PARAM(config->mu > 0.0 && config->mu < 1.0);
+    FSO_CHECK_PARAM(config->mode == SP_LMS_SAMPLE || config->block_size > 0);
+    
+    int ret = sp_prepare_weights(sp, config->num_taps);
+    if (ret != FSO_SUCCESS) {
+        return ret;
+    }
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Adaptive filter (%s): length=%zu, taps=%d, block=%zu",
+                  config->mode == SP_LMS_SAMPLE ? "sample" :
+                  config->mode == SP_LMS_BLOCK ? "block" : "frequency",
+                  length, config->num_taps, config->block_size);
+    
+    if (config->mode == SP_LMS_SAMPLE) {
+        sp_lms_sample_range(sp->filter_coeffs, sp->filter_length, input, desired,
+                            output, 0, length, config->mu);
+        return FSO_SUCCESS;
+    }
+    
+    size_t begin = 0;
+    if (config->mode == SP_LMS_FREQUENCY) {
+        ret = sp_fdaf(sp, sp->filter_coeffs, sp->filter_length, input, desired, output,
+                      length, config->block_size, config->mu, &begin);
+        if (ret != FSO_SUCCESS) {
+            return ret;
+        }
+    } else if (config->mode != SP_LMS_BLOCK) {
+        FSO_LOG_ERROR(MODULE_NAME, "Unknown adaptive filter mode: %d", config->mode);
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    // Block LMS (also the trailing partial block of the frequency-domain mode)
+    if (begin < length) {
+        double* error = (double*)malloc(FSO_MIN(config->block_size, length) * sizeof(double));
+        if (error == NULL) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate block LMS error buffer");
+            return FSO_ERROR_MEMORY;
+        }
+        
+        for (; begin < length; begin += config->block_size) {
+            size_t count = FSO_MIN(config->block_size, length - begin);
+            sp_lms_block(sp, sp->filter_coeffs, sp->filter_length, input, desired,
+                         output, error, begin, count, config->mu);
+        }
+        free(error);
+    }
+    
     return FSO_SUCCESS;
 }
 
+/**
+ * @brief Arrays of a direct convolution
+ */
+typedef struct {
+    const double* signal;
+    const double* kernel;
+    double* output;
+    size_t sig_len;
+    size_t kernel_len;
+} SPDirectConvolutionJob;
+
+/**
+ * @brief Direct convolution outputs [begin, end)
+ */
+static void sp_convolve_direct_range(void* context, size_t begin, size_t end, int worker) {
+    const SPDirectConvolutionJob* job = (const SPDirectConvolutionJob*)context;
+    (void)worker;
+    
+    for (size_t n = begin; n < end; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < job->kernel_len; k++) {
+            if (n >= k && (n - k) < job->sig_len) {
+                sum += job->signal[n - k] * job->kernel[k];
+            }
+        }
+        job->output[n] = sum;
+    }
+}
+
 int sp_convolution(SignalProcessor* sp, const double* signal,
                    const double* kernel, double* output,
                    size_t sig_len, size_t kernel_len) {
@@ -166,123 +475,188 @@ int sp_convolution(SignalProcessor* sp, const double* signal,
     // For small kernels, use direct convolution
     if (kernel_len < 64) {
         // Direct convolution with parallel outer loop
-#ifdef _OPENMP
-        if (sp->openmp_available) {
-            #pragma omp parallel for num_threads(sp->num_threads)
-            for (size_t n = 0; n < output_len; n++) {
-                double sum = 0.0;
-                for (size_t k = 0; k < kernel_len; k++) {
-                    if (n >= k && (n - k) < sig_len) {
-                        sum += signal[n - k] * kernel[k];
-                    }
-                }
-                output[n] = sum;
-            }
-        } else
-#endif
-        {
-            // Serial direct convolution
-            for (size_t n = 0; n < output_len; n++) {
-                double sum = 0.0;
-                for (size_t k = 0; k < kernel_len; k++) {
-                    if (n >= k && (n - k) < sig_len) {
-                        sum += signal[n - k] * kernel[k];
-                    }
-                }
-                output[n] = sum;
-            }
+        SPDirectConvolutionJob job = { signal, kernel, output, sig_len, kernel_len };
+        if (sp->num_threads > 1 && output_len * kernel_len >= SP_CONVOLUTION_PARALLEL_WORK) {
+            fso_parallel_for(output_len, 0, sp->num_threads, sp_convolve_direct_range, &job);
+        } else {
+            sp_convolve_direct_range(&job, 0, output_len, 0);
         }
     } else {
-        // FFT-based convolution for large kernels (overlap-add method)
-        size_t fft_size = 1;
-        while (fft_size < (sig_len + kernel_len - 1)) {
-            fft_size *= 2;
+        // FFT-based convolution for large kernels: overlap-save blocks with
+        // a fixed FFT size, so memory stays O(kernel) for any signal length
+        SPConvolver conv;
+        int ret = sp_convolver_init(&conv, sp, kernel, kernel_len, 0);
+        if (ret != FSO_SUCCESS) {
+            return ret;
         }
         
-        // Allocate FFT buffers
-        double* sig_padded = (double*)fftw_malloc(fft_size * sizeof(double));
-        double* ker_padded = (double*)fftw_malloc(fft_size * sizeof(double));
-        double complex* sig_fft = (double complex*)fftw_malloc(
-            ((fft_size / 2) + 1) * sizeof(double complex));
-        double complex* ker_fft = (double complex*)fftw_malloc(
-            ((fft_size / 2) + 1) * sizeof(double complex));
-        double complex* prod_fft = (double complex*)fftw_malloc(
-            ((fft_size / 2) + 1) * sizeof(double complex));
-        double* result = (double*)fftw_malloc(fft_size * sizeof(double));
-        
-        if (!sig_padded || !ker_padded || !sig_fft || !ker_fft || !prod_fft || !result) {
-            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT convolution buffers");
-            if (sig_padded) fftw_free(sig_padded);
-            if (ker_padded) fftw_free(ker_padded);
-            if (sig_fft) fftw_free(sig_fft);
-            if (ker_fft) fftw_free(ker_fft);
-            if (prod_fft) fftw_free(prod_fft);
-            if (result) fftw_free(result);
-            return FSO_ERROR_MEMORY;
+        ret = sp_convolver_process(&conv, signal, output, sig_len);
+        if (ret == FSO_SUCCESS) {
+            ret = sp_convolver_flush(&conv, output + sig_len);
         }
         
-        // Zero-pad inputs
-        memcpy(sig_padded, signal, sig_len * sizeof(double));
-        memset(sig_padded + sig_len, 0, (fft_size - sig_len) * sizeof(double));
-        
-        memcpy(ker_padded, kernel, kernel_len * sizeof(double));
-        memset(ker_padded + kernel_len, 0, (fft_size - kernel_len) * sizeof(double));
+        sp_convolver_free(&conv);
         
-        // Compute FFTs
-        int ret1 = sp_fft(sp, sig_padded, sig_fft, fft_size);
-        int ret2 = sp_fft(sp, ker_padded, ker_fft, fft_size);
-        
-        if (ret1 != FSO_SUCCESS || ret2 != FSO_SUCCESS) {
+        if (ret != FSO_SUCCESS) {
             FSO_LOG_ERROR(MODULE_NAME, "FFT failed in convolution");
-            fftw_free(sig_padded);
-            fftw_free(ker_padded);
-            fftw_free(sig_fft);
-            fftw_free(ker_fft);
-            fftw_free(prod_fft);
-            fftw_free(result);
-            return FSO_ERROR_MEMORY;
+            return ret;
         }
-        
-        // Multiply in frequency domain (parallel)
-        size_t fft_len = (fft_size / 2) + 1;
-#ifdef _OPENMP
-        if (sp->openmp_available) {
-            #pragma omp parallel for num_threads(sp->num_threads)
-            for (size_t i = 0; i < fft_len; i++) {
-                prod_fft[i] = sig_fft[i] * ker_fft[i];
-            }
-        } else
-#endif
-        {
-            for (size_t i = 0; i < fft_len; i++) {
-                prod_fft[i] = sig_fft[i] * ker_fft[i];
-            }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Streaming Overlap-Save Convolution
+ * ============================================================================ */
+
+/**
+ * @brief Convolve one block of up to block_size new samples
+ * 
+ * The FFT window holds the previous kernel_length - 1 inputs followed by
+ * the new samples and zero padding. Outputs at window positions
+ * kernel_length - 1 onward are free of circular wrap-around, and since the
+ * filter is causal a partial block yields exact outputs for the samples it
+ * has. A NULL input feeds zeros (used by the flush).
+ */
+static int sp_convolver_block(SPConvolver* conv, const double* input,
+                              double* output, size_t count) {
+    const size_t history = conv->kernel_length - 1;
+    const size_t bins = (conv->fft_size / 2) + 1;
+    
+    memcpy(conv->time_buffer, conv->history, history * sizeof(double));
+    if (input != NULL) {
+        memcpy(conv->time_buffer + history, input, count * sizeof(double));
+    } else {
+        memset(conv->time_buffer + history, 0, count * sizeof(double));
+    }
+    memset(conv->time_buffer + history + count, 0,
+           (conv->fft_size - history - count) * sizeof(double));
+    
+    int ret = sp_fft(conv->sp, conv->time_buffer, conv->freq_buffer, conv->fft_size);
+    if (ret != FSO_SUCCESS) {
+        return ret;
+    }
+    
+    for (size_t i = 0; i < bins; i++) {
+        conv->freq_buffer[i] *= conv->kernel_spectrum[i];
+    }
+    
+    // The time buffer still holds this block's inputs for the history update
+    if (history > 0) {
+        memcpy(conv->history, conv->time_buffer + count, history * sizeof(double));
+    }
+    
+    ret = sp_ifft(conv->sp, conv->freq_buffer, conv->time_buffer, conv->fft_size);
+    if (ret != FSO_SUCCESS) {
+        return ret;
+    }
+    
+    memcpy(output, conv->time_buffer + history, count * sizeof(double));
+    
+    return FSO_SUCCESS;
+}
+
+int sp_convolver_init(SPConvolver* conv, SignalProcessor* sp,
+                      const double* kernel, size_t kernel_len, size_t fft_size) {
+    FSO_CHECK_NULL(conv);
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(kernel);
+    FSO_CHECK_PARAM(kernel_len > 0);
+    
+    memset(conv, 0, sizeof(SPConvolver));
+    
+    // Default FFT size: power of two with about 3/4 of each block useful
+    if (fft_size == 0) {
+        fft_size = 64;
+        while (fft_size < 4 * kernel_len) {
+            fft_size *= 2;
         }
-        
-        // Inverse FFT
-        int ret3 = sp_ifft(sp, prod_fft, result, fft_size);
-        if (ret3 != FSO_SUCCESS) {
-            FSO_LOG_ERROR(MODULE_NAME, "Inverse FFT failed in convolution");
-            fftw_free(sig_padded);
-            fftw_free(ker_padded);
-            fftw_free(sig_fft);
-            fftw_free(ker_fft);
-            fftw_free(prod_fft);
-            fftw_free(result);
-            return FSO_ERROR_MEMORY;
+    }
+    FSO_CHECK_PARAM(fft_size >= kernel_len);
+    
+    conv->sp = sp;
+    conv->kernel_length = kernel_len;
+    conv->fft_size = fft_size;
+    conv->block_size = fft_size - kernel_len + 1;
+    
+    size_t bins = (fft_size / 2) + 1;
+    conv->kernel_spectrum = (double complex*)fftw_malloc(bins * sizeof(double complex));
+    conv->freq_buffer = (double complex*)fftw_malloc(bins * sizeof(double complex));
+    conv->time_buffer = (double*)fftw_malloc(fft_size * sizeof(double));
+    conv->history = (double*)calloc(kernel_len, sizeof(double));
+    
+    if (!conv->kernel_spectrum || !conv->freq_buffer || !conv->time_buffer || !conv->history) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate overlap-save buffers");
+        sp_convolver_free(conv);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    // Kernel spectrum is computed once; the FFT plan is shared through the cache
+    memcpy(conv->time_buffer, kernel, kernel_len * sizeof(double));
+    memset(conv->time_buffer + kernel_len, 0, (fft_size - kernel_len) * sizeof(double));
+    int ret = sp_fft(sp, conv->time_buffer, conv->kernel_spectrum, fft_size);
+    if (ret != FSO_SUCCESS) {
+        sp_convolver_free(conv);
+        return ret;
+    }
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Overlap-save convolver: kernel=%zu, fft=%zu, block=%zu",
+                  kernel_len, fft_size, conv->block_size);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_convolver_process(SPConvolver* conv, const double* input,
+                         double* output, size_t length) {
+    FSO_CHECK_NULL(conv);
+    FSO_CHECK_NULL(conv->sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    
+    for (size_t offset = 0; offset < length; offset += conv->block_size) {
+        size_t count = FSO_MIN(conv->block_size, length - offset);
+        int ret = sp_convolver_block(conv, input + offset, output + offset, count);
+        if (ret != FSO_SUCCESS) {
+            return ret;
         }
-        
-        // Copy result
-        memcpy(output, result, output_len * sizeof(double));
-        
-        // Cleanup
-        fftw_free(sig_padded);
-        fftw_free(ker_padded);
-        fftw_free(sig_fft);
-        fftw_free(ker_fft);
-        fftw_free(prod_fft);
-        fftw_free(result);
     }
     
     return FSO_SUCCESS;
 }
+
+int sp_convolver_flush(SPConvolver* conv, double* output) {
+    FSO_CHECK_NULL(conv);
+    FSO_CHECK_NULL(output);
+    
+    size_t tail = conv->kernel_length - 1;
+    for (size_t offset = 0; offset < tail; offset += conv->block_size) {
+        size_t count = FSO_MIN(conv->block_size, tail - offset);
+        int ret = sp_convolver_block(conv, NULL, output + offset, count);
+        if (ret != FSO_SUCCESS) {
+            return ret;
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+void sp_convolver_reset(SPConvolver* conv) {
+    if (conv == NULL || conv->history == NULL) {
+        return;
+    }
+    memset(conv->history, 0, conv->kernel_length * sizeof(double));
+}
+
+void sp_convolver_free(SPConvolver* conv) {
+    if (conv == NULL) {
+        return;
+    }
+    
+    if (conv->kernel_spectrum) fftw_free(conv->kernel_spectrum);
+    if (conv->freq_buffer) fftw_free(conv->freq_buffer);
+    if (conv->time_buffer) fftw_free(conv->time_buffer);
+    free(conv->history);
+    
+    memset(conv, 0, sizeof(SPConvolver));
+}
@@ -1,15 +1,67 @@
 /**
  * @file signal_processing.c
- * @brief Signal processing implementation with OpenMP parallelization
+ * @brief Signal processing implementation on the shared worker pool
  */
 
 #include "signal_processing.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
+#include <pthread.h>
 
 #define MODULE_NAME "SignalProcessing"
 
+/* The FFTW planner is not thread-safe; this lock serializes every plan
+ * creation, destruction and wisdom call, and guards sp_live_processors */
+static pthread_mutex_t sp_fftw_planner_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Live processors sharing FFTW's global state (see sp_free) */
+static int sp_live_processors = 0;
+
+static SPFFTPlan* sp_get_plan(SignalProcessor* sp, size_t length,
+                              SPFFTDirection direction, int in_place);
+static SPFFTPlan* sp_get_split_plan(SignalProcessor* sp, size_t length,
+                                    SPFFTDirection direction);
+static SPFFTPlan* sp_get_plan_f32(SignalProcessor* sp, size_t length,
+                                  SPFFTDirection direction);
+static int sp_ensure_fft_buffers(SignalProcessor* sp, size_t length);
+static int sp_ensure_fft_buffers_f32(SignalProcessor* sp, size_t length);
+static int sp_ensure_batch_buffers(SignalProcessor* sp, size_t real_length,
+                                   size_t complex_length);
+static int sp_same_alignment(const void* a, const void* b);
+static SPFFTPlan* sp_get_batch_plan(SignalProcessor* sp, SPFFTDirection direction,
+                                    size_t length, size_t batch,
+                                    size_t in_stride, size_t in_distance,
+                                    size_t out_stride, size_t out_distance);
+static void sp_execute_batch_plan(const SPFFTPlan* entry, void* input, void* output);
+static SPFFTPlan* sp_get_2d_plan(SignalProcessor* sp, size_t rows, size_t cols,
+                                 SPFFTDirection direction);
+static void sp_destroy_plan_entry(SPFFTPlan* entry);
+
+/**
+ * @brief Allocation state for the per-worker buffers
+ */
+typedef struct {
+    SignalProcessor* sp;
+} SPThreadBufferJob;
+
+/**
+ * @brief Allocate and first-touch worker w's buffer on worker w
+ */
+static void sp_alloc_thread_buffer(void* context, size_t begin, size_t end, int worker) {
+    SPThreadBufferJob* job = (SPThreadBufferJob*)context;
+    (void)worker;
+    
+    for (size_t i = begin; i < end; i++) {
+        double* buffer = (double*)fftw_malloc(job->sp->thread_buffer_size * sizeof(double));
+        if (buffer != NULL) {
+            memset(buffer, 0, job->sp->thread_buffer_size * sizeof(double));
+        }
+        job->sp->thread_buffers[i] = buffer;
+    }
+}
+
 /* ============================================================================
  * Initialization and Cleanup
  * ============================================================================ */
@@ -23,59 +75,53 @@ int sp_init(SignalProcessor* sp, int num_threads, size_t buffer_size) {
     memset(sp, 0, sizeof(SignalProcessor));
     sp->buffer_size = buffer_size;
     
-    // Check OpenMP availability and configure threads
-#ifdef _OPENMP
-    sp->openmp_available = 1;
+    // Kernels run on the shared worker pool. A pool started earlier with
+    // fso_threadpool_init() keeps its size and placement; num_threads only
+    // bounds how many of its workers this processor uses
+    if (fso_threadpool_init(NULL) != FSO_SUCCESS) {
+        FSO_LOG_WARNING(MODULE_NAME, "Thread pool unavailable, falling back to serial processing");
+    }
     
-    // Auto-detect thread count if requested
     if (num_threads == 0) {
-        num_threads = omp_get_max_threads();
-        FSO_LOG_INFO(MODULE_NAME, "Auto-detected %d OpenMP threads", num_threads);
+        num_threads = fso_threadpool_size();
+        FSO_LOG_INFO(MODULE_NAME, "Auto-detected %d threads", num_threads);
     }
     
     // Clamp to valid range
-    num_threads = FSO_CLAMP(num_threads, 1, 16);
+    num_threads = FSO_CLAMP(FSO_MIN(num_threads, fso_threadpool_size()), 1, 16);
     sp->num_threads = num_threads;
     
-    // Set OpenMP thread count
-    omp_set_num_threads(num_threads);
-    
-    FSO_LOG_INFO(MODULE_NAME, "Initialized with OpenMP support (%d threads)", 
-                 num_threads);
-#else
-    sp->openmp_available = 0;
-    sp->num_threads = 1;
-    
-    if (num_threads > 1) {
-        FSO_LOG_WARNING(MODULE_NAME, 
-                       "OpenMP not available, falling back to serial processing");
-    } else {
-        FSO_LOG_INFO(MODULE_NAME, "Initialized in serial mode");
-    }
-#endif
+    FSO_LOG_INFO(MODULE_NAME, "Initialized on %d pool worker(s)", num_threads);
     
     // Initialize FFTW with thread support if available
 #ifdef _OPENMP
+    sp->openmp_available = 1;
     if (fftw_init_threads() == 0) {
         FSO_LOG_WARNING(MODULE_NAME, "Failed to initialize FFTW threads");
         sp->openmp_available = 0;
-        sp->num_threads = 1;
     } else {
         fftw_plan_with_nthreads(sp->num_threads);
         FSO_LOG_DEBUG(MODULE_NAME, "FFTW threads initialized");
     }
+    if (fftwf_init_threads() != 0) {
+        fftwf_plan_with_nthreads(sp->num_threads);
+    }
 #endif
     
-    // FFT plans will be created on-demand
-    sp->fft_forward_plan = NULL;
-    sp->fft_inverse_plan = NULL;
-    sp->fft_size = 0;
+    // FFT plans and work buffers are created on demand
+    sp->fft_plans = NULL;
+    sp->num_fft_plans = 0;
+    sp->fft_planner_flags = FFTW_MEASURE;
+    sp->fft_real_buffer = NULL;
+    sp->fft_complex_buffer = NULL;
+    sp->fft_buffer_length = 0;
     
     // Initialize filter state
     sp->filter_coeffs = NULL;
     sp->filter_length = 0;
     
-    // Allocate thread-local buffers
+    // Per-worker buffers, allocated and first touched by the worker that
+    // uses them so the pages sit on its NUMA node
     sp->thread_buffer_size = buffer_size;
     sp->thread_buffers = (double**)calloc(sp->num_threads, sizeof(double*));
     if (sp->thread_buffers == NULL) {
@@ -83,15 +129,20 @@ int sp_init(SignalProcessor* sp, int num_threads, size_t buffer_size) {
         return FSO_ERROR_MEMORY;
     }
     
+    SPThreadBufferJob buffer_job = { sp };
+    fso_parallel_for((size_t)sp->num_threads, 0, sp->num_threads,
+                     sp_alloc_thread_buffer, &buffer_job);
+    
     for (int i = 0; i < sp->num_threads; i++) {
-        sp->thread_buffers[i] = (double*)fftw_malloc(buffer_size * sizeof(double));
         if (sp->thread_buffers[i] == NULL) {
             FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate thread buffer %d", i);
-            // Clean up previously allocated buffers
-            for (int j = 0; j < i; j++) {
-                fftw_free(sp->thread_buffers[j]);
+            for (int j = 0; j < sp->num_threads; j++) {
+                if (sp->thread_buffers[j] != NULL) {
+                    fftw_free(sp->thread_buffers[j]);
+                }
             }
             free(sp->thread_buffers);
+            sp->thread_buffers = NULL;
             return FSO_ERROR_MEMORY;
         }
     }
@@ -99,6 +150,10 @@ int sp_init(SignalProcessor* sp, int num_threads, size_t buffer_size) {
     FSO_LOG_DEBUG(MODULE_NAME, "Allocated %d thread buffers of size %zu", 
                   sp->num_threads, buffer_size);
     
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    sp_live_processors++;
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
     return FSO_SUCCESS;
 }
 
@@ -107,16 +162,62 @@ void sp_free(SignalProcessor* sp) {
         return;
     }
     
-    // Destroy FFT plans
-    if (sp->fft_forward_plan != NULL) {
-        fftw_destroy_plan(sp->fft_forward_plan);
-        sp->fft_forward_plan = NULL;
+    // Destroy cached FFT plans (the FFTW planner is not thread-safe)
+    int last_processor = 0;
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    SPFFTPlan* entry = sp->fft_plans;
+    while (entry != NULL) {
+        SPFFTPlan* next = entry->next;
+        sp_destroy_plan_entry(entry);
+        entry = next;
+    }
+    sp->fft_plans = NULL;
+    sp->num_fft_plans = 0;
+    
+    if (sp->thread_buffers != NULL && sp_live_processors > 0) {
+        last_processor = (--sp_live_processors == 0);
+    }
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (sp->fft_real_buffer != NULL) {
+        fftw_free(sp->fft_real_buffer);
+        sp->fft_real_buffer = NULL;
     }
     
-    if (sp->fft_inverse_plan != NULL) {
-        fftw_destroy_plan(sp->fft_inverse_plan);
-        sp->fft_inverse_plan = NULL;
+    if (sp->fft_complex_buffer != NULL) {
+        fftw_free(sp->fft_complex_buffer);
+        sp->fft_complex_buffer = NULL;
     }
+    sp->fft_buffer_length = 0;
+    
+    if (sp->fft_batch_real != NULL) {
+        fftw_free(sp->fft_batch_real);
+        sp->fft_batch_real = NULL;
+    }
+    
+    if (sp->fft_batch_complex != NULL) {
+        fftw_free(sp->fft_batch_complex);
+        sp->fft_batch_complex = NULL;
+    }
+    sp->fft_batch_real_length = 0;
+    sp->fft_batch_complex_length = 0;
+    
+    if (sp->fft_real_buffer_f32 != NULL) {
+        fftwf_free(sp->fft_real_buffer_f32);
+        sp->fft_real_buffer_f32 = NULL;
+    }
+    
+    if (sp->fft_complex_buffer_f32 != NULL) {
+        fftwf_free(sp->fft_complex_buffer_f32);
+        sp->fft_complex_buffer_f32 = NULL;
+    }
+    sp->fft_buffer_length_f32 = 0;
+    
+    if (sp->estimation_workspace != NULL) {
+        fftw_free(sp->estimation_workspace);
+        sp->estimation_workspace = NULL;
+    }
+    sp->estimation_workspace_length = 0;
     
     // Free filter coefficients
     if (sp->filter_coeffs != NULL) {
@@ -135,12 +236,18 @@ void sp_free(SignalProcessor* sp) {
         sp->thread_buffers = NULL;
     }
     
-    // Cleanup FFTW threads
+    // Global FFTW cleanup invalidates every plan, so only the last
+    // processor may run it
+    if (last_processor) {
+        pthread_mutex_lock(&sp_fftw_planner_lock);
 #ifdef _OPENMP
-    fftw_cleanup_threads();
+        fftw_cleanup_threads();
+        fftwf_cleanup_threads();
 #endif
-    
-    fftw_cleanup();
+        fftw_cleanup();
+        fftwf_cleanup();
+        pthread_mutex_unlock(&sp_fftw_planner_lock);
+    }
     
     FSO_LOG_DEBUG(MODULE_NAME, "Signal processor freed");
 }
@@ -170,161 +277,1099 @@ int sp_fft(SignalProcessor* sp, const double* input,
     FSO_CHECK_NULL(output);
     FSO_CHECK_PARAM(length > 0);
     
-    // Check if we need to create or recreate FFT plan
-    if (sp->fft_forward_plan == NULL || sp->fft_size != length) {
-        // Destroy old plan if it exists
-        if (sp->fft_forward_plan != NULL) {
-            fftw_destroy_plan(sp->fft_forward_plan);
-            FSO_LOG_DEBUG(MODULE_NAME, "Destroyed old FFT plan (size %zu)", sp->fft_size);
-        }
-        
-        // Allocate temporary buffers for planning
-        double* in_temp = (double*)fftw_malloc(length * sizeof(double));
-        fftw_complex* out_temp = (fftw_complex*)fftw_malloc(
-            ((length / 2) + 1) * sizeof(fftw_complex));
-        
-        if (in_temp == NULL || out_temp == NULL) {
-            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT planning buffers");
-            if (in_temp) fftw_free(in_temp);
-            if (out_temp) fftw_free(out_temp);
-            return FSO_ERROR_MEMORY;
+    SPFFTPlan* entry = sp_get_plan(sp, length, SP_FFT_FORWARD, 0);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t output_length = (length / 2) + 1;
+    
+    // r2c preserves its input, so aligned caller arrays are used directly
+    // (double complex and fftw_complex share the same layout)
+    if (sp_same_alignment(input, sp->fft_real_buffer) &&
+        sp_same_alignment(output, sp->fft_complex_buffer)) {
+        fftw_execute_dft_r2c(entry->plan, (double*)input, (fftw_complex*)output);
+    } else {
+        memcpy(sp->fft_real_buffer, input, length * sizeof(double));
+        fftw_execute_dft_r2c(entry->plan, sp->fft_real_buffer, sp->fft_complex_buffer);
+        memcpy(output, sp->fft_complex_buffer, output_length * sizeof(fftw_complex));
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed FFT on %zu samples", length);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_ifft(SignalProcessor* sp, const double complex* input,
+            double* output, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0);
+    
+    SPFFTPlan* entry = sp_get_plan(sp, length, SP_FFT_INVERSE, 0);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t input_length = (length / 2) + 1;
+    
+    // c2r destroys its input, so the spectrum always goes through the owned buffer
+    memcpy(sp->fft_complex_buffer, input, input_length * sizeof(fftw_complex));
+    
+    double* target = sp_same_alignment(output, sp->fft_real_buffer) ?
+                     output : sp->fft_real_buffer;
+    fftw_execute_dft_c2r(entry->plan, sp->fft_complex_buffer, target);
+    
+    // Normalize output (FFTW doesn't normalize)
+    double norm_factor = 1.0 / (double)length;
+    for (size_t i = 0; i < length; i++) {
+        output[i] = target[i] * norm_factor;
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed inverse FFT on %zu samples", length);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_fft_inplace(SignalProcessor* sp, double complex* data, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_PARAM(length > 0);
+    
+    SPFFTPlan* entry = sp_get_plan(sp, length, SP_FFT_FORWARD, 1);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t complex_length = (length / 2) + 1;
+    
+    if (sp_same_alignment(data, sp->fft_complex_buffer)) {
+        fftw_execute_dft_r2c(entry->plan, (double*)data, (fftw_complex*)data);
+    } else {
+        memcpy(sp->fft_complex_buffer, data, length * sizeof(double));
+        fftw_execute_dft_r2c(entry->plan, (double*)sp->fft_complex_buffer,
+                             sp->fft_complex_buffer);
+        memcpy(data, sp->fft_complex_buffer, complex_length * sizeof(fftw_complex));
+    }
+    FSO_PROF_END(FSO_PROF_FFT);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_ifft_inplace(SignalProcessor* sp, double complex* data, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_PARAM(length > 0);
+    
+    SPFFTPlan* entry = sp_get_plan(sp, length, SP_FFT_INVERSE, 1);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t complex_length = (length / 2) + 1;
+    double* samples = (double*)data;
+    double norm_factor = 1.0 / (double)length;
+    
+    if (sp_same_alignment(data, sp->fft_complex_buffer)) {
+        fftw_execute_dft_c2r(entry->plan, (fftw_complex*)data, samples);
+        for (size_t i = 0; i < length; i++) {
+            samples[i] *= norm_factor;
         }
-        
-        // Create new plan with FFTW_MEASURE for optimal performance
-        // Note: FFTW_MEASURE may take some time but provides better performance
-        sp->fft_forward_plan = fftw_plan_dft_r2c_1d(
-            (int)length, in_temp, out_temp, FFTW_MEASURE);
-        
-        if (sp->fft_forward_plan == NULL) {
-            FSO_LOG_ERROR(MODULE_NAME, "Failed to create FFT plan");
-            fftw_free(in_temp);
-            fftw_free(out_temp);
-            return FSO_ERROR_MEMORY;
+    } else {
+        memcpy(sp->fft_complex_buffer, data, complex_length * sizeof(fftw_complex));
+        double* buffer = (double*)sp->fft_complex_buffer;
+        fftw_execute_dft_c2r(entry->plan, sp->fft_complex_buffer, buffer);
+        for (size_t i = 0; i < length; i++) {
+            samples[i] = buffer[i] * norm_factor;
         }
-        
-        sp->fft_size = length;
-        
-        fftw_free(in_temp);
-        fftw_free(out_temp);
-        
-        FSO_LOG_DEBUG(MODULE_NAME, "Created FFT plan for size %zu", length);
     }
+    FSO_PROF_END(FSO_PROF_FFT);
     
-    // Allocate aligned buffers for actual computation
-    double* in_aligned = (double*)fftw_malloc(length * sizeof(double));
-    fftw_complex* out_aligned = (fftw_complex*)fftw_malloc(
-        ((length / 2) + 1) * sizeof(fftw_complex));
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Single-Precision FFT Operations
+ * ============================================================================ */
+
+int sp_fft_f32(SignalProcessor* sp, const float* input,
+               float complex* output, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0);
     
-    if (in_aligned == NULL || out_aligned == NULL) {
-        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT computation buffers");
-        if (in_aligned) fftw_free(in_aligned);
-        if (out_aligned) fftw_free(out_aligned);
+    SPFFTPlan* entry = sp_get_plan_f32(sp, length, SP_FFT_FORWARD);
+    if (entry == NULL) {
         return FSO_ERROR_MEMORY;
     }
     
-    // Copy input data
-    memcpy(in_aligned, input, length * sizeof(double));
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t output_length = (length / 2) + 1;
     
-    // Execute FFT with the existing plan
-    fftw_execute_dft_r2c(sp->fft_forward_plan, in_aligned, out_aligned);
+    if (fftwf_alignment_of((float*)input) == fftwf_alignment_of(sp->fft_real_buffer_f32) &&
+        fftwf_alignment_of((float*)output) ==
+        fftwf_alignment_of((float*)sp->fft_complex_buffer_f32)) {
+        fftwf_execute_dft_r2c(entry->plan_f32, (float*)input, (fftwf_complex*)output);
+    } else {
+        memcpy(sp->fft_real_buffer_f32, input, length * sizeof(float));
+        fftwf_execute_dft_r2c(entry->plan_f32, sp->fft_real_buffer_f32,
+                              sp->fft_complex_buffer_f32);
+        memcpy(output, sp->fft_complex_buffer_f32, output_length * sizeof(fftwf_complex));
+    }
     
-    // Copy output data (convert fftw_complex to double complex)
-    size_t output_length = (length / 2) + 1;
-    for (size_t i = 0; i < output_length; i++) {
-        output[i] = out_aligned[i][0] + I * out_aligned[i][1];
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed single-precision FFT on %zu samples", length);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_ifft_f32(SignalProcessor* sp, const float complex* input,
+                float* output, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0);
+    
+    SPFFTPlan* entry = sp_get_plan_f32(sp, length, SP_FFT_INVERSE);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
     }
     
-    fftw_free(in_aligned);
-    fftw_free(out_aligned);
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t input_length = (length / 2) + 1;
+    
+    // c2r destroys its input, so the spectrum always goes through the owned buffer
+    memcpy(sp->fft_complex_buffer_f32, input, input_length * sizeof(fftwf_complex));
     
-    FSO_LOG_DEBUG(MODULE_NAME, "Executed FFT on %zu samples", length);
+    float* target = (fftwf_alignment_of(output) == fftwf_alignment_of(sp->fft_real_buffer_f32)) ?
+                    output : sp->fft_real_buffer_f32;
+    fftwf_execute_dft_c2r(entry->plan_f32, sp->fft_complex_buffer_f32, target);
+    
+    const float norm_factor = 1.0f / (float)length;
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (size_t i = 0; i < length; i++) {
+        output[i] = target[i] * norm_factor;
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed single-precision inverse FFT on %zu samples", length);
     
     return FSO_SUCCESS;
 }
 
-int sp_ifft(SignalProcessor* sp, const double complex* input,
-            double* output, size_t length) {
+/* ============================================================================
+ * Complex Buffer FFT Operations
+ * ============================================================================ */
+
+int sp_fft_buffer(SignalProcessor* sp, const double* input,
+                  FSOComplexBuffer* spectrum, size_t length) {
     FSO_CHECK_NULL(sp);
     FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(spectrum);
+    FSO_CHECK_PARAM(length > 0);
+    
+    size_t output_length = (length / 2) + 1;
+    FSO_CHECK_PARAM(spectrum->capacity >= output_length);
+    
+    if (spectrum->layout == FSO_LAYOUT_INTERLEAVED) {
+        int result = sp_fft(sp, input, sp_buffer_complex(spectrum), length);
+        if (result == FSO_SUCCESS) {
+            spectrum->length = output_length;
+        }
+        return result;
+    }
+    
+    SPFFTPlan* entry = sp_get_split_plan(sp, length, SP_FFT_FORWARD);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    
+    // Split planes are always aligned; only the real input may need staging
+    double* source = (double*)input;
+    if (!sp_same_alignment(input, sp->fft_real_buffer)) {
+        memcpy(sp->fft_real_buffer, input, length * sizeof(double));
+        source = sp->fft_real_buffer;
+    }
+    fftw_execute_split_dft_r2c(entry->plan, source, spectrum->real, spectrum->imag);
+    spectrum->length = output_length;
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed split FFT on %zu samples", length);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_ifft_buffer(SignalProcessor* sp, FSOComplexBuffer* spectrum,
+                   double* output, size_t length) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(spectrum);
     FSO_CHECK_NULL(output);
     FSO_CHECK_PARAM(length > 0);
     
     size_t input_length = (length / 2) + 1;
+    FSO_CHECK_PARAM(spectrum->length >= input_length);
+    
+    int split = (spectrum->layout == FSO_LAYOUT_SPLIT);
+    SPFFTPlan* entry = split ? sp_get_split_plan(sp, length, SP_FFT_INVERSE) :
+                               sp_get_plan(sp, length, SP_FFT_INVERSE, 0);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
     
-    // Check if we need to create or recreate inverse FFT plan
-    if (sp->fft_inverse_plan == NULL || sp->fft_size != length) {
-        // Destroy old plan if it exists
-        if (sp->fft_inverse_plan != NULL) {
-            fftw_destroy_plan(sp->fft_inverse_plan);
-            FSO_LOG_DEBUG(MODULE_NAME, "Destroyed old inverse FFT plan (size %zu)", 
-                         sp->fft_size);
+    // c2r destroys its input; the caller's spectrum is the scratch here
+    double* target = sp_same_alignment(output, sp->fft_real_buffer) ?
+                     output : sp->fft_real_buffer;
+    if (split) {
+        fftw_execute_split_dft_c2r(entry->plan, spectrum->real, spectrum->imag, target);
+    } else {
+        fftw_complex* source = (fftw_complex*)spectrum->real;
+        if (!sp_same_alignment(source, sp->fft_complex_buffer)) {
+            memcpy(sp->fft_complex_buffer, source, input_length * sizeof(fftw_complex));
+            source = sp->fft_complex_buffer;
         }
-        
-        // Allocate temporary buffers for planning
-        fftw_complex* in_temp = (fftw_complex*)fftw_malloc(
-            input_length * sizeof(fftw_complex));
-        double* out_temp = (double*)fftw_malloc(length * sizeof(double));
-        
-        if (in_temp == NULL || out_temp == NULL) {
-            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate inverse FFT planning buffers");
-            if (in_temp) fftw_free(in_temp);
-            if (out_temp) fftw_free(out_temp);
+        fftw_execute_dft_c2r(entry->plan, source, target);
+    }
+    
+    double norm_factor = 1.0 / (double)length;
+    for (size_t i = 0; i < length; i++) {
+        output[i] = target[i] * norm_factor;
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed inverse %sFFT on %zu samples",
+                  split ? "split " : "", length);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Batched FFT Operations
+ * ============================================================================ */
+
+/**
+ * @brief Arrays of a batched inverse normalization
+ */
+typedef struct {
+    const double* target;
+    double* output;
+    size_t length;
+    size_t stride;
+    size_t distance;
+    double norm_factor;
+} SPBatchNormalizeJob;
+
+/**
+ * @brief Scale transforms [begin, end) into the output
+ */
+static void sp_normalize_batch(void* context, size_t begin, size_t end, int worker) {
+    const SPBatchNormalizeJob* job = (const SPBatchNormalizeJob*)context;
+    (void)worker;
+    
+    for (size_t b = begin; b < end; b++) {
+        for (size_t i = 0; i < job->length; i++) {
+            size_t idx = b * job->distance + i * job->stride;
+            job->output[idx] = job->target[idx] * job->norm_factor;
+        }
+    }
+}
+
+/**
+ * @brief Number of elements spanned by a strided batch layout
+ */
+static size_t sp_batch_span(size_t length, size_t batch, size_t stride, size_t distance) {
+    return (batch - 1) * distance + (length - 1) * stride + 1;
+}
+
+int sp_fft_batch(SignalProcessor* sp, const double* input, double complex* output,
+                 size_t length, size_t batch,
+                 size_t input_stride, size_t input_distance,
+                 size_t output_stride, size_t output_distance) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0 && length <= INT_MAX);
+    FSO_CHECK_PARAM(batch > 0 && batch <= INT_MAX);
+    FSO_CHECK_PARAM(input_stride > 0 && input_stride <= INT_MAX && input_distance <= INT_MAX);
+    FSO_CHECK_PARAM(output_stride > 0 && output_stride <= INT_MAX && output_distance <= INT_MAX);
+    
+    SPFFTPlan* entry = sp_get_batch_plan(sp, SP_FFT_FORWARD, length, batch,
+                                         input_stride, input_distance,
+                                         output_stride, output_distance);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t bins = (length / 2) + 1;
+    int direct_output = sp_same_alignment(output, sp->fft_batch_complex);
+    double* source = (double*)input;
+    
+    if (!sp_same_alignment(input, sp->fft_batch_real)) {
+        size_t span = sp_batch_span(length, batch, input_stride, input_distance);
+        memcpy(sp->fft_batch_real, input, span * sizeof(double));
+        source = sp->fft_batch_real;
+    }
+    
+    sp_execute_batch_plan(entry, source,
+                          direct_output ? (void*)output : (void*)sp->fft_batch_complex);
+    
+    if (!direct_output) {
+        // Copy only the addressed bins; gaps in the caller's layout are untouched
+        const double complex* spectra = (const double complex*)sp->fft_batch_complex;
+        for (size_t b = 0; b < batch; b++) {
+            for (size_t j = 0; j < bins; j++) {
+                size_t idx = b * output_distance + j * output_stride;
+                output[idx] = spectra[idx];
+            }
+        }
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed batched FFT: %zu x %zu samples", batch, length);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_ifft_batch(SignalProcessor* sp, const double complex* input, double* output,
+                  size_t length, size_t batch,
+                  size_t input_stride, size_t input_distance,
+                  size_t output_stride, size_t output_distance) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(length > 0 && length <= INT_MAX);
+    FSO_CHECK_PARAM(batch > 0 && batch <= INT_MAX);
+    FSO_CHECK_PARAM(input_stride > 0 && input_stride <= INT_MAX && input_distance <= INT_MAX);
+    FSO_CHECK_PARAM(output_stride > 0 && output_stride <= INT_MAX && output_distance <= INT_MAX);
+    
+    SPFFTPlan* entry = sp_get_batch_plan(sp, SP_FFT_INVERSE, length, batch,
+                                         input_stride, input_distance,
+                                         output_stride, output_distance);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    // c2r destroys its input, so the spectra always go through the scratch buffer
+    size_t bins = (length / 2) + 1;
+    size_t span = sp_batch_span(bins, batch, input_stride, input_distance);
+    memcpy(sp->fft_batch_complex, input, span * sizeof(fftw_complex));
+    
+    double* target = sp_same_alignment(output, sp->fft_batch_real) ?
+                     output : sp->fft_batch_real;
+    sp_execute_batch_plan(entry, sp->fft_batch_complex, target);
+    
+    // Normalize (and copy out when the scratch buffer was used); the static
+    // split gives each worker the transforms its chunk just produced
+    SPBatchNormalizeJob job = { target, output, length, output_stride, output_distance,
+                                1.0 / (double)length };
+    fso_parallel_for(batch, 0, sp->num_threads, sp_normalize_batch, &job);
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed batched inverse FFT: %zu x %zu samples", batch, length);
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * 2D FFT Operations
+ * ============================================================================ */
+
+/**
+ * @brief Shared body of sp_fft2d() and sp_ifft2d()
+ */
+static int sp_execute_2d(SignalProcessor* sp, double complex* data, size_t rows, size_t cols,
+                         SPFFTDirection direction) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(data);
+    FSO_CHECK_PARAM(rows > 0 && rows <= INT_MAX && cols > 0 && cols <= INT_MAX);
+    
+    SPFFTPlan* entry = sp_get_2d_plan(sp, rows, cols, direction);
+    if (entry == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_PROF_BEGIN(FSO_PROF_FFT);
+    size_t count = rows * cols;
+    fftw_complex* grid = (fftw_complex*)data;
+    
+    // The plan is in-place on the scratch buffer; aligned grids run directly
+    if (!sp_same_alignment(data, sp->fft_batch_complex)) {
+        memcpy(sp->fft_batch_complex, data, count * sizeof(fftw_complex));
+        grid = sp->fft_batch_complex;
+    }
+    fftw_execute_dft(entry->plan, grid, grid);
+    
+    const double complex* result = (const double complex*)grid;
+    if (direction == SP_FFT_INVERSE) {
+        double norm_factor = 1.0 / (double)count;
+        for (size_t i = 0; i < count; i++) {
+            data[i] = result[i] * norm_factor;
+        }
+    } else if (grid != (fftw_complex*)data) {
+        memcpy(data, grid, count * sizeof(fftw_complex));
+    }
+    
+    FSO_PROF_END(FSO_PROF_FFT);
+    FSO_LOG_DEBUG(MODULE_NAME, "Executed %s 2D FFT on %zu x %zu samples",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse", rows, cols);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_fft2d(SignalProcessor* sp, double complex* data, size_t rows, size_t cols) {
+    return sp_execute_2d(sp, data, rows, cols, SP_FFT_FORWARD);
+}
+
+int sp_ifft2d(SignalProcessor* sp, double complex* data, size_t rows, size_t cols) {
+    return sp_execute_2d(sp, data, rows, cols, SP_FFT_INVERSE);
+}
+
+/* ============================================================================
+ * FFTW Wisdom
+ * ============================================================================ */
+
+int sp_save_wisdom(const SignalProcessor* sp, const char* path) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(path);
+    
+    int ok;
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    ok = fftw_export_wisdom_to_filename(path);
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (!ok) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to write FFTW wisdom to %s", path);
+        return FSO_ERROR_IO;
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Saved FFTW wisdom to %s (%d cached plans)",
+                 path, sp->num_fft_plans);
+    return FSO_SUCCESS;
+}
+
+int sp_load_wisdom(SignalProcessor* sp, const char* path) {
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(path);
+    
+    int ok;
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    ok = fftw_import_wisdom_from_filename(path);
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (!ok) {
+        FSO_LOG_WARNING(MODULE_NAME, "Could not load FFTW wisdom from %s", path);
+        return FSO_ERROR_IO;
+    }
+    
+    FSO_LOG_INFO(MODULE_NAME, "Loaded FFTW wisdom from %s", path);
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Static Helper Functions
+ * ============================================================================ */
+
+/**
+ * @brief Check that two arrays have the same SIMD alignment as FFTW sees it
+ */
+static int sp_same_alignment(const void* a, const void* b) {
+    return fftw_alignment_of((double*)a) == fftw_alignment_of((double*)b);
+}
+
+/**
+ * @brief Destroy a plan cache entry and all of its FFTW plans
+ */
+static void sp_destroy_plan_entry(SPFFTPlan* entry) {
+    if (entry->plan != NULL) {
+        fftw_destroy_plan(entry->plan);
+    }
+    if (entry->plan_f32 != NULL) {
+        fftwf_destroy_plan(entry->plan_f32);
+    }
+    if (entry->tail_plan != NULL) {
+        fftw_destroy_plan(entry->tail_plan);
+    }
+    free(entry);
+}
+
+/**
+ * @brief Grow the owned work buffers to hold a transform of the given length
+ * 
+ * The buffers always come from fftw_malloc, so their alignment never
+ * changes and cached plans stay valid across reallocation.
+ */
+static int sp_ensure_fft_buffers(SignalProcessor* sp, size_t length) {
+    if (sp->fft_buffer_length >= length) {
+        return FSO_SUCCESS;
+    }
+    
+    double* real_buffer = (double*)fftw_malloc(length * sizeof(double));
+    fftw_complex* complex_buffer = (fftw_complex*)fftw_malloc(
+        ((length / 2) + 1) * sizeof(fftw_complex));
+    
+    if (real_buffer == NULL || complex_buffer == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT work buffers");
+        if (real_buffer) fftw_free(real_buffer);
+        if (complex_buffer) fftw_free(complex_buffer);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    if (sp->fft_real_buffer) fftw_free(sp->fft_real_buffer);
+    if (sp->fft_complex_buffer) fftw_free(sp->fft_complex_buffer);
+    sp->fft_real_buffer = real_buffer;
+    sp->fft_complex_buffer = complex_buffer;
+    sp->fft_buffer_length = length;
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Look up or create the cached plan for (length, direction, in-place)
+ * 
+ * Hits are moved to the front of the list. Misses plan against the owned
+ * work buffers (FFTW_MEASURE overwrites them) inside the planner critical
+ * section; with wisdom loaded the measurement is skipped.
+ */
+static SPFFTPlan* sp_get_plan(SignalProcessor* sp, size_t length,
+                              SPFFTDirection direction, int in_place) {
+    if (sp_ensure_fft_buffers(sp, length) != FSO_SUCCESS) {
+        return NULL;
+    }
+    
+    SPFFTPlan* previous = NULL;
+    for (SPFFTPlan* entry = sp->fft_plans; entry != NULL; entry = entry->next) {
+        if (entry->batch == 0 && entry->rows == 0 && !entry->split && !entry->single &&
+            entry->length == length &&
+            entry->direction == direction && entry->in_place == in_place) {
+            if (previous != NULL) {
+                previous->next = entry->next;
+                entry->next = sp->fft_plans;
+                sp->fft_plans = entry;
+            }
+            return entry;
+        }
+        previous = entry;
+    }
+    
+    SPFFTPlan* entry = (SPFFTPlan*)calloc(1, sizeof(SPFFTPlan));
+    if (entry == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT plan cache entry");
+        return NULL;
+    }
+    
+    double* real_buffer = in_place ? (double*)sp->fft_complex_buffer : sp->fft_real_buffer;
+    
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    if (direction == SP_FFT_FORWARD) {
+        entry->plan = fftw_plan_dft_r2c_1d((int)length, real_buffer,
+                                           sp->fft_complex_buffer,
+                                           sp->fft_planner_flags);
+    } else {
+        entry->plan = fftw_plan_dft_c2r_1d((int)length, sp->fft_complex_buffer,
+                                           real_buffer, sp->fft_planner_flags);
+    }
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (entry->plan == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create %s FFT plan for size %zu",
+                      direction == SP_FFT_FORWARD ? "forward" : "inverse", length);
+        free(entry);
+        return NULL;
+    }
+    
+    entry->length = length;
+    entry->direction = direction;
+    entry->in_place = in_place;
+    entry->next = sp->fft_plans;
+    sp->fft_plans = entry;
+    sp->num_fft_plans++;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Created %s%s FFT plan for size %zu (%d cached)",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse",
+                  in_place ? " in-place" : "", length, sp->num_fft_plans);
+    
+    return entry;
+}
+
+/**
+ * @brief Grow the owned single-precision work buffers
+ */
+static int sp_ensure_fft_buffers_f32(SignalProcessor* sp, size_t length) {
+    if (sp->fft_buffer_length_f32 >= length) {
+        return FSO_SUCCESS;
+    }
+    
+    float* real_buffer = (float*)fftwf_malloc(length * sizeof(float));
+    fftwf_complex* complex_buffer = (fftwf_complex*)fftwf_malloc(
+        ((length / 2) + 1) * sizeof(fftwf_complex));
+    
+    if (real_buffer == NULL || complex_buffer == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate single-precision FFT work buffers");
+        if (real_buffer) fftwf_free(real_buffer);
+        if (complex_buffer) fftwf_free(complex_buffer);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    if (sp->fft_real_buffer_f32) fftwf_free(sp->fft_real_buffer_f32);
+    if (sp->fft_complex_buffer_f32) fftwf_free(sp->fft_complex_buffer_f32);
+    sp->fft_real_buffer_f32 = real_buffer;
+    sp->fft_complex_buffer_f32 = complex_buffer;
+    sp->fft_buffer_length_f32 = length;
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Look up or create the cached single-precision plan for (length, direction)
+ * 
+ * Same caching as sp_get_plan(), planned with fftwf against the
+ * single-precision work buffers.
+ */
+static SPFFTPlan* sp_get_plan_f32(SignalProcessor* sp, size_t length,
+                                  SPFFTDirection direction) {
+    if (sp_ensure_fft_buffers_f32(sp, length) != FSO_SUCCESS) {
+        return NULL;
+    }
+    
+    SPFFTPlan* previous = NULL;
+    for (SPFFTPlan* entry = sp->fft_plans; entry != NULL; entry = entry->next) {
+        if (entry->single && entry->length == length && entry->direction == direction) {
+            if (previous != NULL) {
+                previous->next = entry->next;
+                entry->next = sp->fft_plans;
+                sp->fft_plans = entry;
+            }
+            return entry;
+        }
+        previous = entry;
+    }
+    
+    SPFFTPlan* entry = (SPFFTPlan*)calloc(1, sizeof(SPFFTPlan));
+    if (entry == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT plan cache entry");
+        return NULL;
+    }
+    
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    if (direction == SP_FFT_FORWARD) {
+        entry->plan_f32 = fftwf_plan_dft_r2c_1d((int)length, sp->fft_real_buffer_f32,
+                                                sp->fft_complex_buffer_f32,
+                                                sp->fft_planner_flags);
+    } else {
+        entry->plan_f32 = fftwf_plan_dft_c2r_1d((int)length, sp->fft_complex_buffer_f32,
+                                                sp->fft_real_buffer_f32,
+                                                sp->fft_planner_flags);
+    }
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (entry->plan_f32 == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create single-precision %s FFT plan for size %zu",
+                      direction == SP_FFT_FORWARD ? "forward" : "inverse", length);
+        free(entry);
+        return NULL;
+    }
+    
+    entry->length = length;
+    entry->direction = direction;
+    entry->single = 1;
+    entry->next = sp->fft_plans;
+    sp->fft_plans = entry;
+    sp->num_fft_plans++;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Created single-precision %s FFT plan for size %zu (%d cached)",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse",
+                  length, sp->num_fft_plans);
+    
+    return entry;
+}
+
+/**
+ * @brief Look up or create the cached split-layout plan for (length, direction)
+ * 
+ * Split plans read or write separate real and imaginary planes
+ * (FSOComplexBuffer's SoA layout). They are planned against the batch
+ * scratch, with the imaginary plane at the same FSO_BUFFER_ALIGN offset
+ * an owned split buffer uses, so any split buffer can be executed
+ * directly.
+ */
+static SPFFTPlan* sp_get_split_plan(SignalProcessor* sp, size_t length,
+                                    SPFFTDirection direction) {
+    if (sp_ensure_fft_buffers(sp, length) != FSO_SUCCESS) {
+        return NULL;
+    }
+    
+    SPFFTPlan* previous = NULL;
+    for (SPFFTPlan* entry = sp->fft_plans; entry != NULL; entry = entry->next) {
+        if (entry->batch == 0 && entry->split && entry->length == length &&
+            entry->direction == direction) {
+            if (previous != NULL) {
+                previous->next = entry->next;
+                entry->next = sp->fft_plans;
+                sp->fft_plans = entry;
+            }
+            return entry;
+        }
+        previous = entry;
+    }
+    
+    size_t align = FSO_BUFFER_ALIGN / sizeof(double);
+    size_t plane = (((length / 2) + 1 + align - 1) / align) * align;
+    if (sp_ensure_batch_buffers(sp, length, plane) != FSO_SUCCESS) {
+        return NULL;
+    }
+    
+    SPFFTPlan* entry = (SPFFTPlan*)calloc(1, sizeof(SPFFTPlan));
+    if (entry == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT plan cache entry");
+        return NULL;
+    }
+    
+    fftw_iodim dim = { (int)length, 1, 1 };
+    double* real_plane = (double*)sp->fft_batch_complex;
+    double* imag_plane = real_plane + plane;
+    
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    if (direction == SP_FFT_FORWARD) {
+        entry->plan = fftw_plan_guru_split_dft_r2c(1, &dim, 0, NULL, sp->fft_batch_real,
+                                                   real_plane, imag_plane,
+                                                   sp->fft_planner_flags);
+    } else {
+        entry->plan = fftw_plan_guru_split_dft_c2r(1, &dim, 0, NULL, real_plane,
+                                                   imag_plane, sp->fft_batch_real,
+                                                   sp->fft_planner_flags);
+    }
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (entry->plan == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create split %s FFT plan for size %zu",
+                      direction == SP_FFT_FORWARD ? "forward" : "inverse", length);
+        free(entry);
+        return NULL;
+    }
+    
+    entry->length = length;
+    entry->direction = direction;
+    entry->split = 1;
+    entry->next = sp->fft_plans;
+    sp->fft_plans = entry;
+    sp->num_fft_plans++;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Created split %s FFT plan for size %zu (%d cached)",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse",
+                  length, sp->num_fft_plans);
+    
+    return entry;
+}
+
+/**
+ * @brief Grow the batched planning scratch buffers
+ */
+static int sp_ensure_batch_buffers(SignalProcessor* sp, size_t real_length,
+                                   size_t complex_length) {
+    if (sp->fft_batch_real_length < real_length) {
+        double* buffer = (double*)fftw_malloc(real_length * sizeof(double));
+        if (buffer == NULL) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate batched FFT scratch");
             return FSO_ERROR_MEMORY;
         }
-        
-        // Create new inverse plan
-        sp->fft_inverse_plan = fftw_plan_dft_c2r_1d(
-            (int)length, in_temp, out_temp, FFTW_MEASURE);
-        
-        if (sp->fft_inverse_plan == NULL) {
-            FSO_LOG_ERROR(MODULE_NAME, "Failed to create inverse FFT plan");
-            fftw_free(in_temp);
-            fftw_free(out_temp);
+        if (sp->fft_batch_real) fftw_free(sp->fft_batch_real);
+        sp->fft_batch_real = buffer;
+        sp->fft_batch_real_length = real_length;
+    }
+    
+    if (sp->fft_batch_complex_length < complex_length) {
+        fftw_complex* buffer = (fftw_complex*)fftw_malloc(complex_length * sizeof(fftw_complex));
+        if (buffer == NULL) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate batched FFT scratch");
             return FSO_ERROR_MEMORY;
         }
+        if (sp->fft_batch_complex) fftw_free(sp->fft_batch_complex);
+        sp->fft_batch_complex = buffer;
+        sp->fft_batch_complex_length = complex_length;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Plan a howmany-transform r2c/c2r over the batch scratch buffers
+ */
+static fftw_plan sp_plan_many(SignalProcessor* sp, SPFFTDirection direction,
+                              size_t length, size_t howmany,
+                              size_t in_stride, size_t in_distance,
+                              size_t out_stride, size_t out_distance,
+                              unsigned int flags) {
+    int n = (int)length;
+    
+    if (direction == SP_FFT_FORWARD) {
+        return fftw_plan_many_dft_r2c(1, &n, (int)howmany,
+                                      sp->fft_batch_real, NULL,
+                                      (int)in_stride, (int)in_distance,
+                                      sp->fft_batch_complex, NULL,
+                                      (int)out_stride, (int)out_distance, flags);
+    }
+    
+    return fftw_plan_many_dft_c2r(1, &n, (int)howmany,
+                                  sp->fft_batch_complex, NULL,
+                                  (int)in_stride, (int)in_distance,
+                                  sp->fft_batch_real, NULL,
+                                  (int)out_stride, (int)out_distance, flags);
+}
+
+/**
+ * @brief Look up or create the cached plan for a batched transform
+ * 
+ * With more than one OpenMP thread the batch is planned twice: once as a
+ * single FFTW-threaded plan, and once split into one single-threaded chunk
+ * per thread. The planner's cost estimate (fftw_cost) of the threaded plan
+ * is compared against that of the largest chunk, which bounds the wall
+ * time of the concurrent chunks, and the cheaper variant is cached.
+ */
+static SPFFTPlan* sp_get_batch_plan(SignalProcessor* sp, SPFFTDirection direction,
+                                    size_t length, size_t batch,
+                                    size_t in_stride, size_t in_distance,
+                                    size_t out_stride, size_t out_distance) {
+    size_t bins = (length / 2) + 1;
+    size_t in_length = (direction == SP_FFT_FORWARD) ? length : bins;
+    size_t out_length = (direction == SP_FFT_FORWARD) ? bins : length;
+    size_t in_span = sp_batch_span(in_length, batch, in_stride, in_distance);
+    size_t out_span = sp_batch_span(out_length, batch, out_stride, out_distance);
+    size_t real_span = (direction == SP_FFT_FORWARD) ? in_span : out_span;
+    size_t complex_span = (direction == SP_FFT_FORWARD) ? out_span : in_span;
+    
+    if (sp_ensure_batch_buffers(sp, real_span, complex_span) != FSO_SUCCESS) {
+        return NULL;
+    }
+    
+    SPFFTPlan* previous = NULL;
+    for (SPFFTPlan* entry = sp->fft_plans; entry != NULL; entry = entry->next) {
+        if (entry->batch == batch && entry->length == length &&
+            entry->direction == direction &&
+            entry->in_stride == in_stride && entry->in_distance == in_distance &&
+            entry->out_stride == out_stride && entry->out_distance == out_distance) {
+            if (previous != NULL) {
+                previous->next = entry->next;
+                entry->next = sp->fft_plans;
+                sp->fft_plans = entry;
+            }
+            return entry;
+        }
+        previous = entry;
+    }
+    
+    SPFFTPlan* entry = (SPFFTPlan*)calloc(1, sizeof(SPFFTPlan));
+    if (entry == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT plan cache entry");
+        return NULL;
+    }
+    
+    entry->length = length;
+    entry->direction = direction;
+    entry->batch = batch;
+    entry->in_stride = in_stride;
+    entry->in_distance = in_distance;
+    entry->out_stride = out_stride;
+    entry->out_distance = out_distance;
+    
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    entry->plan = sp_plan_many(sp, direction, length, batch, in_stride, in_distance,
+                               out_stride, out_distance, sp->fft_planner_flags);
+    
+    if (entry->plan != NULL && sp->num_threads > 1 && batch > 1) {
+        size_t num_chunks = FSO_MIN((size_t)sp->num_threads, batch);
+        size_t chunk_size = batch / num_chunks;
+        size_t remainder = batch - chunk_size * num_chunks;
+        
+        // Chunk bases must keep the scratch buffer's SIMD alignment
+        // for FFTW's aligned codelets; otherwise plan unaligned
+        const size_t in_bytes = (direction == SP_FFT_FORWARD) ?
+                                sizeof(double) : sizeof(fftw_complex);
+        const size_t out_bytes = (direction == SP_FFT_FORWARD) ?
+                                 sizeof(fftw_complex) : sizeof(double);
+        unsigned int flags = sp->fft_planner_flags;
+        for (size_t k = 1; k < num_chunks; k++) {
+            size_t start = k * chunk_size + FSO_MIN(k, remainder);
+            if ((start * in_distance * in_bytes) % 64 != 0 ||
+                (start * out_distance * out_bytes) % 64 != 0) {
+                flags |= FFTW_UNALIGNED;
+                break;
+            }
+        }
         
-        // Update size if forward plan wasn't created yet
-        if (sp->fft_size != length) {
-            sp->fft_size = length;
+#ifdef _OPENMP
+        fftw_plan_with_nthreads(1);
+#endif
+        fftw_plan chunk_plan = sp_plan_many(sp, direction, length, chunk_size,
+                                            in_stride, in_distance,
+                                            out_stride, out_distance, flags);
+        fftw_plan tail_plan = NULL;
+        if (chunk_plan != NULL && remainder > 0) {
+            tail_plan = sp_plan_many(sp, direction, length, chunk_size + 1,
+                                     in_stride, in_distance,
+                                     out_stride, out_distance, flags);
         }
+#ifdef _OPENMP
+        fftw_plan_with_nthreads(sp->num_threads);
+#endif
         
-        fftw_free(in_temp);
-        fftw_free(out_temp);
+        int chunks_valid = (chunk_plan != NULL) && (remainder == 0 || tail_plan != NULL);
+        double chunk_cost = 0.0;
+        if (chunks_valid) {
+            chunk_cost = fftw_cost(tail_plan != NULL ? tail_plan : chunk_plan);
+        }
         
-        FSO_LOG_DEBUG(MODULE_NAME, "Created inverse FFT plan for size %zu", length);
+        if (chunks_valid && chunk_cost < fftw_cost(entry->plan)) {
+            fftw_destroy_plan(entry->plan);
+            entry->plan = chunk_plan;
+            entry->tail_plan = tail_plan;
+            entry->num_chunks = (int)num_chunks;
+            entry->chunk_size = chunk_size;
+        } else {
+            if (chunk_plan != NULL) fftw_destroy_plan(chunk_plan);
+            if (tail_plan != NULL) fftw_destroy_plan(tail_plan);
+        }
     }
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
     
-    // Allocate aligned buffers for actual computation
-    fftw_complex* in_aligned = (fftw_complex*)fftw_malloc(
-        input_length * sizeof(fftw_complex));
-    double* out_aligned = (double*)fftw_malloc(length * sizeof(double));
+    if (entry->plan == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create batched FFT plan (%zu x %zu)",
+                      batch, length);
+        free(entry);
+        return NULL;
+    }
     
-    if (in_aligned == NULL || out_aligned == NULL) {
-        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate inverse FFT computation buffers");
-        if (in_aligned) fftw_free(in_aligned);
-        if (out_aligned) fftw_free(out_aligned);
-        return FSO_ERROR_MEMORY;
+    entry->next = sp->fft_plans;
+    sp->fft_plans = entry;
+    sp->num_fft_plans++;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Created batched %s FFT plan %zu x %zu (%s)",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse", batch, length,
+                  entry->num_chunks > 0 ? "OpenMP chunks" : "FFTW threads");
+    
+    return entry;
+}
+
+/**
+ * @brief Look up or create the cached in-place 2D complex plan
+ * 
+ * Planned on the batch scratch buffer with the processor's FFTW thread
+ * count, so one transform of a large grid runs on several threads.
+ */
+static SPFFTPlan* sp_get_2d_plan(SignalProcessor* sp, size_t rows, size_t cols,
+                                 SPFFTDirection direction) {
+    if (sp_ensure_batch_buffers(sp, 0, rows * cols) != FSO_SUCCESS) {
+        return NULL;
     }
     
-    // Copy input data (convert double complex to fftw_complex)
-    for (size_t i = 0; i < input_length; i++) {
-        in_aligned[i][0] = creal(input[i]);
-        in_aligned[i][1] = cimag(input[i]);
+    SPFFTPlan* previous = NULL;
+    for (SPFFTPlan* entry = sp->fft_plans; entry != NULL; entry = entry->next) {
+        if (entry->rows == rows && entry->length == cols && entry->direction == direction) {
+            if (previous != NULL) {
+                previous->next = entry->next;
+                entry->next = sp->fft_plans;
+                sp->fft_plans = entry;
+            }
+            return entry;
+        }
+        previous = entry;
     }
     
-    // Execute inverse FFT
-    fftw_execute_dft_c2r(sp->fft_inverse_plan, in_aligned, out_aligned);
+    SPFFTPlan* entry = (SPFFTPlan*)calloc(1, sizeof(SPFFTPlan));
+    if (entry == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FFT plan cache entry");
+        return NULL;
+    }
     
-    // Copy and normalize output (FFTW doesn't normalize)
-    double norm_factor = 1.0 / (double)length;
-    for (size_t i = 0; i < length; i++) {
-        output[i] = out_aligned[i] * norm_factor;
+    pthread_mutex_lock(&sp_fftw_planner_lock);
+    entry->plan = fftw_plan_dft_2d((int)rows, (int)cols,
+                                   sp->fft_batch_complex, sp->fft_batch_complex,
+                                   direction == SP_FFT_FORWARD ? FFTW_FORWARD : FFTW_BACKWARD,
+                                   sp->fft_planner_flags);
+    pthread_mutex_unlock(&sp_fftw_planner_lock);
+    
+    if (entry->plan == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create 2D FFT plan (%zu x %zu)", rows, cols);
+        free(entry);
+        return NULL;
     }
     
-    fftw_free(in_aligned);
-    fftw_free(out_aligned);
+    entry->length = cols;
+    entry->rows = rows;
+    entry->direction = direction;
+    entry->in_place = 1;
+    entry->next = sp->fft_plans;
+    sp->fft_plans = entry;
+    sp->num_fft_plans++;
     
-    FSO_LOG_DEBUG(MODULE_NAME, "Executed inverse FFT on %zu samples", length);
+    FSO_LOG_DEBUG(MODULE_NAME, "Created %s 2D FFT plan %zu x %zu (%d cached)",
+                  direction == SP_FFT_FORWARD ? "forward" : "inverse", rows, cols,
+                  sp->num_fft_plans);
     
-    return FSO_SUCCESS;
+    return entry;
+}
+
+/**
+ * @brief Arrays of a chunked batch execution
+ */
+typedef struct {
+    const SPFFTPlan* entry;
+    void* input;
+    void* output;
+} SPBatchChunkJob;
+
+/**
+ * @brief Execute chunks [begin, end) of a batched plan
+ */
+static void sp_execute_batch_chunks(void* context, size_t begin, size_t end, int worker) {
+    const SPBatchChunkJob* job = (const SPBatchChunkJob*)context;
+    const SPFFTPlan* entry = job->entry;
+    const size_t remainder = entry->batch - entry->chunk_size * (size_t)entry->num_chunks;
+    (void)worker;
+    
+    for (size_t k = begin; k < end; k++) {
+        size_t start = k * entry->chunk_size + FSO_MIN(k, remainder);
+        fftw_plan plan = (k < remainder) ? entry->tail_plan : entry->plan;
+        
+        if (entry->direction == SP_FFT_FORWARD) {
+            fftw_execute_dft_r2c(plan, (double*)job->input + start * entry->in_distance,
+                                 (fftw_complex*)job->output + start * entry->out_distance);
+        } else {
+            fftw_execute_dft_c2r(plan, (fftw_complex*)job->input + start * entry->in_distance,
+                                 (double*)job->output + start * entry->out_distance);
+        }
+    }
+}
+
+/**
+ * @brief Execute a batched plan on caller or scratch arrays
+ */
+static void sp_execute_batch_plan(const SPFFTPlan* entry, void* input, void* output) {
+    if (entry->num_chunks == 0) {
+        if (entry->direction == SP_FFT_FORWARD) {
+            fftw_execute_dft_r2c(entry->plan, (double*)input, (fftw_complex*)output);
+        } else {
+            fftw_execute_dft_c2r(entry->plan, (fftw_complex*)input, (double*)output);
+        }
+        return;
+    }
+    
+    // One chunk per worker; chunk k always runs on worker k
+    SPBatchChunkJob job = { entry, input, output };
+    fso_parallel_for((size_t)entry->num_chunks, 0, entry->num_chunks,
+                     sp_execute_batch_chunks, &job);
 }
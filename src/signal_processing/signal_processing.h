@@ -17,34 +17,197 @@
 #include <omp.h>
 #endif
 
+/** Channel length from which least-squares estimation correlates by FFT */
+#define SP_LS_FFT_MIN_TAPS 32
+
 /* ============================================================================
  * Signal Processor Structure
  * ============================================================================ */
 
+/**
+ * @brief Transform direction of a cached FFT plan
+ */
+typedef enum {
+    SP_FFT_FORWARD = 0,           /**< Real-to-complex transform */
+    SP_FFT_INVERSE = 1            /**< Complex-to-real transform */
+} SPFFTDirection;
+
+/**
+ * @brief Cached FFTW plan
+ * 
+ * Plans are keyed by (length, direction, in-place, split, single) and kept for
+ * the lifetime of the signal processor, so switching between transform
+ * sizes never re-plans a size that has been seen before. Batched plans add
+ * the batch count and the caller's strides/distances to the key; 2D plans
+ * add the row count.
+ */
+typedef struct SPFFTPlan {
+    size_t length;                /**< Transform length (real samples) */
+    SPFFTDirection direction;     /**< Forward (r2c) or inverse (c2r) */
+    int in_place;                 /**< 1 if planned for in-place execution */
+    int split;                    /**< 1 if the spectrum is split real/imag planes */
+    int single;                   /**< 1 for a single-precision (fftwf) plan in plan_f32 */
+    size_t batch;                 /**< Transforms per execution (0 for single sp_fft plans) */
+    size_t rows;                  /**< Rows of a 2D complex plan (0 for 1D plans) */
+    size_t in_stride;             /**< Input element stride (batched plans) */
+    size_t in_distance;           /**< Input distance between transforms (batched plans) */
+    size_t out_stride;            /**< Output element stride (batched plans) */
+    size_t out_distance;          /**< Output distance between transforms (batched plans) */
+    fftw_plan plan;               /**< FFTW plan (whole batch, or one OpenMP chunk) */
+    fftw_plan tail_plan;          /**< Plan for chunk_size + 1 transforms, or NULL */
+    fftwf_plan plan_f32;          /**< Single-precision plan (single plans only) */
+    int num_chunks;               /**< Pool chunks, 0 when FFTW threads run the batch */
+    size_t chunk_size;            /**< Transforms per pool chunk */
+    struct SPFFTPlan* next;       /**< Next plan, most recently used first */
+} SPFFTPlan;
+
 /**
  * @brief Signal processing context
  * 
  * Contains configuration and state for parallel signal processing operations.
  */
 typedef struct {
-    int num_threads;              /**< Number of OpenMP threads */
+    int num_threads;              /**< Pool workers used by the kernels */
     size_t buffer_size;           /**< Processing buffer size */
-    int openmp_available;         /**< Flag indicating OpenMP availability */
+    int openmp_available;         /**< Flag indicating FFTW's OpenMP threads are available */
+    
+    /* FFT plan cache and processor-owned aligned buffers */
+    SPFFTPlan* fft_plans;         /**< Cached plans, most recently used first */
+    int num_fft_plans;            /**< Number of cached plans */
+    unsigned int fft_planner_flags; /**< FFTW planner flags for new plans (FFTW_MEASURE) */
+    double* fft_real_buffer;      /**< Aligned real work buffer */
+    fftw_complex* fft_complex_buffer; /**< Aligned complex work buffer */
+    size_t fft_buffer_length;     /**< Transform length the work buffers can hold */
+    double* fft_batch_real;       /**< Aligned real scratch for batched planning */
+    fftw_complex* fft_batch_complex; /**< Aligned complex scratch for batched planning */
+    size_t fft_batch_real_length; /**< Doubles held by fft_batch_real */
+    size_t fft_batch_complex_length; /**< Complex samples held by fft_batch_complex */
+    float* fft_real_buffer_f32;   /**< Aligned single-precision real work buffer */
+    fftwf_complex* fft_complex_buffer_f32; /**< Aligned single-precision complex work buffer */
+    size_t fft_buffer_length_f32; /**< Transform length the single-precision buffers can hold */
     
-    /* FFT plans */
-    fftw_plan fft_forward_plan;   /**< Forward FFT plan */
-    fftw_plan fft_inverse_plan;   /**< Inverse FFT plan */
-    size_t fft_size;              /**< Size of FFT plans */
+    /* Channel estimation workspace (grown on demand, reused across calls) */
+    double* estimation_workspace; /**< Aligned scratch for pilot and LS estimation */
+    size_t estimation_workspace_length; /**< Doubles held by estimation_workspace */
     
     /* Filter state */
     double* filter_coeffs;        /**< Filter coefficients */
     int filter_length;            /**< Number of filter taps */
     
-    /* Thread-local buffers (allocated per thread) */
-    double** thread_buffers;      /**< Per-thread work buffers */
+    /* Per-worker buffers (allocated and first touched by their worker) */
+    double** thread_buffers;      /**< Work buffer of pool worker slot w */
     size_t thread_buffer_size;    /**< Size of each thread buffer */
 } SignalProcessor;
 
+/**
+ * @brief Adaptive filter update schedule
+ */
+typedef enum {
+    SP_LMS_SAMPLE = 0,            /**< Classic LMS, weights updated every sample */
+    SP_LMS_BLOCK = 1,             /**< Block LMS, one accumulated update per block */
+    SP_LMS_FREQUENCY = 2          /**< Block LMS computed with FFTs (constrained FDAF) */
+} SPAdaptiveMode;
+
+/**
+ * @brief Adaptive filter configuration
+ */
+typedef struct {
+    SPAdaptiveMode mode;          /**< Update schedule */
+    int num_taps;                 /**< Number of filter taps */
+    size_t block_size;            /**< Samples per weight update (block modes) */
+    double mu;                    /**< Step size */
+} SPAdaptiveConfig;
+
+/**
+ * @brief Streaming overlap-save FIR convolver
+ * 
+ * Convolves an arbitrarily long signal with a fixed kernel using a fixed
+ * FFT size. Input may be fed in pieces of any size; memory use depends
+ * only on the kernel and FFT size.
+ */
+typedef struct {
+    SignalProcessor* sp;          /**< Signal processor providing cached FFT plans */
+    size_t kernel_length;         /**< Kernel taps (L) */
+    size_t fft_size;              /**< FFT size (N >= L) */
+    size_t block_size;            /**< New samples per full block (N - L + 1) */
+    double complex* kernel_spectrum; /**< FFT of the zero-padded kernel */
+    double complex* freq_buffer;  /**< Block spectrum workspace */
+    double* time_buffer;          /**< Block time-domain workspace (N samples) */
+    double* history;              /**< Last L - 1 input samples */
+} SPConvolver;
+
+/**
+ * @brief Streaming FIR filter
+ * 
+ * Keeps the tap history between pushes. Kernels of 64 taps or more use an
+ * embedded SPConvolver; shorter kernels run direct-form.
+ */
+typedef struct {
+    int num_taps;                 /**< Kernel length */
+    int use_fft;                  /**< Non-zero when the convolver is in use */
+    double* taps;                 /**< Kernel copy (direct form) */
+    double* delay_line;           /**< Mirrored history, 2 * num_taps samples */
+    int position;                 /**< Index of the newest sample in delay_line */
+    SPConvolver convolver;        /**< Overlap-save engine (long kernels) */
+} SPFirStream;
+
+/**
+ * @brief Streaming trailing moving average
+ */
+typedef struct {
+    int window;                   /**< Window length (W) */
+    double* ring;                 /**< Last W input samples */
+    int position;                 /**< Next ring slot to overwrite */
+    int filled;                   /**< Samples in the window (<= W) */
+    double sum;                   /**< Running window sum */
+    double compensation;          /**< Kahan compensation for sum */
+} SPMovingAvgStream;
+
+/**
+ * @brief Streaming LMS adaptive filter
+ * 
+ * Weights, tap history and any partially accumulated block gradient
+ * persist across pushes.
+ */
+typedef struct {
+    int num_taps;                 /**< Number of filter taps */
+    double mu;                    /**< Step size */
+    size_t block_size;            /**< Samples per weight update (1 = sample LMS) */
+    size_t block_fill;            /**< Samples accumulated in the current block */
+    double* weights;              /**< Adaptive weights */
+    double* gradient;             /**< Block gradient accumulator */
+    double* delay_line;           /**< Mirrored history, 2 * num_taps samples */
+    int position;                 /**< Index of the newest sample in delay_line */
+} SPLmsStream;
+
+/**
+ * @brief Interpolation between pilot estimates
+ */
+typedef enum {
+    SP_PILOT_LINEAR = 0,          /**< Piecewise linear between neighbouring pilots */
+    SP_PILOT_SPLINE = 1           /**< Natural cubic spline through all pilots */
+} SPPilotInterpolation;
+
+/**
+ * @brief Recursive least-squares channel tracker
+ * 
+ * Tracks the taps h of y[n] = sum h[k] x[n - k] one sample at a time with
+ * exponential forgetting. Each update costs O(L^2), independent of how
+ * many samples came before.
+ */
+typedef struct {
+    int num_taps;                 /**< Channel taps (L) */
+    double forgetting_factor;     /**< Lambda, 0 < lambda <= 1 */
+    double delta;                 /**< Initial inverse correlation scale (P = delta * I) */
+    double complex* taps;         /**< Current tap estimate h */
+    double complex* inverse_correlation; /**< P, L x L row-major */
+    double complex* gain;         /**< Gain vector workspace */
+    double complex* projection;   /**< P u workspace */
+    double complex* delay_line;   /**< Mirrored history of x, 2 * num_taps samples */
+    int position;                 /**< Index of the newest sample in delay_line */
+    size_t samples;               /**< Samples processed since init or reset */
+} SPRlsTracker;
+
 /* ============================================================================
  * Initialization and Cleanup
  * ============================================================================ */
@@ -53,15 +216,16 @@ typedef struct {
  * @brief Initialize signal processor
  * 
  * Creates a signal processor context with specified configuration.
- * If OpenMP is unavailable, falls back to serial processing with a warning.
+ * Kernels run on the shared worker pool (fso_parallel_for), which is
+ * started with defaults unless fso_threadpool_init() ran first.
  * 
  * @param sp Pointer to signal processor structure
  * @param num_threads Desired number of threads (1-16), 0 for auto-detect
  * @param buffer_size Processing buffer size in samples
  * @return FSO_SUCCESS on success, error code otherwise
  * 
- * @note If num_threads is 0, uses omp_get_max_threads() or 1 if OpenMP unavailable
- * @note FFT plans are created on-demand when sp_fft is first called
+ * @note num_threads is capped at the pool size; 0 uses the whole pool
+ * @note FFT plans are created on demand and cached per (length, direction, in-place)
  */
 int sp_init(SignalProcessor* sp, int num_threads, size_t buffer_size);
 
@@ -69,6 +233,8 @@ int sp_init(SignalProcessor* sp, int num_threads, size_t buffer_size);
  * @brief Free signal processor resources
  * 
  * Cleans up all allocated resources including FFT plans and thread buffers.
+ * FFTW's global state (including accumulated wisdom) is released when the
+ * last live signal processor is freed; call sp_save_wisdom() first to keep it.
  * 
  * @param sp Pointer to signal processor structure
  */
@@ -107,7 +273,9 @@ int sp_is_openmp_available(const SignalProcessor* sp);
  * @return FSO_SUCCESS on success, error code otherwise
  * 
  * @note Output array must have space for (length/2 + 1) complex samples for real input
- * @note FFT plan is created on first call and reused for subsequent calls of same size
+ * @note The plan for each length is created once and cached; input and output
+ *       are used directly when their SIMD alignment matches the owned buffers
+ * @note Not reentrant on the same processor; use one processor per thread
  */
 int sp_fft(SignalProcessor* sp, const double* input, 
            double complex* output, size_t length);
@@ -127,6 +295,203 @@ int sp_fft(SignalProcessor* sp, const double* input,
 int sp_ifft(SignalProcessor* sp, const double complex* input,
             double* output, size_t length);
 
+/**
+ * @brief Single-precision sp_fft()
+ * 
+ * Runs a cached fftwf plan on float data, halving the memory traffic and
+ * doubling the SIMD width of the transform at about 1e-7 relative error.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param input Input real signal array
+ * @param output Output spectrum (length/2 + 1 complex samples)
+ * @param length Transform length
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fft_f32(SignalProcessor* sp, const float* input,
+               float complex* output, size_t length);
+
+/**
+ * @brief Single-precision sp_ifft() (normalized by 1/length)
+ * @param sp Pointer to signal processor structure
+ * @param input Input spectrum (length/2 + 1 complex samples)
+ * @param output Output real signal array
+ * @param length Transform length
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_ifft_f32(SignalProcessor* sp, const float complex* input,
+                float* output, size_t length);
+
+/**
+ * @brief Perform in-place forward FFT
+ * 
+ * The first length doubles of data hold the real input; on return data
+ * holds the length/2 + 1 complex output samples.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param data In/out buffer of (length/2 + 1) complex samples
+ * @param length Transform length (real samples)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fft_inplace(SignalProcessor* sp, double complex* data, size_t length);
+
+/**
+ * @brief Perform in-place inverse FFT
+ * 
+ * data holds length/2 + 1 complex samples on entry; on return its first
+ * length doubles hold the normalized real output.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param data In/out buffer of (length/2 + 1) complex samples
+ * @param length Transform length (real samples)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_ifft_inplace(SignalProcessor* sp, double complex* data, size_t length);
+
+/**
+ * @brief double complex view of an interleaved complex buffer
+ * @param buffer Complex buffer
+ * @return Sample array, or NULL for a split buffer
+ */
+static inline double complex* sp_buffer_complex(const FSOComplexBuffer* buffer) {
+    return (double complex*)fso_complex_buffer_samples(buffer);
+}
+
+/**
+ * @brief Forward FFT into a complex buffer without copying the spectrum
+ * 
+ * Interleaved buffers run the r2c plan straight into their storage; split
+ * buffers use a split-plane plan (fftw_plan_guru_split_dft_r2c) that
+ * writes the real and imaginary planes directly.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param input Input real signal (length samples)
+ * @param spectrum Output buffer (capacity >= length/2 + 1; length is set)
+ * @param length Transform length (real samples)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fft_buffer(SignalProcessor* sp, const double* input,
+                  FSOComplexBuffer* spectrum, size_t length);
+
+/**
+ * @brief Inverse FFT from a complex buffer without copying the spectrum
+ * 
+ * The c2r transform runs directly on the buffer, so its contents are
+ * overwritten; use sp_ifft() to keep the spectrum.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param spectrum Input buffer of length/2 + 1 bins (destroyed)
+ * @param output Output real signal (length samples, normalized)
+ * @param length Transform length (real samples)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_ifft_buffer(SignalProcessor* sp, FSOComplexBuffer* spectrum,
+                   double* output, size_t length);
+
+/**
+ * @brief Forward FFT of a batch of equal-length real signals
+ * 
+ * Transforms batch signals in one planned call (fftw_plan_many_dft_r2c).
+ * Sample i of signal b is input[b * input_distance + i * input_stride] and
+ * bin j of its spectrum is output[b * output_distance + j * output_stride].
+ * For back-to-back buffers use strides of 1, input_distance = length and
+ * output_distance = length/2 + 1; for channel-interleaved data use
+ * input_stride = batch and input_distance = 1.
+ * 
+ * With OpenMP, the plan is measured both with FFTW threads and as one
+ * single-threaded chunk per OpenMP thread, and the cheaper variant (by
+ * fftw_cost) is kept in the plan cache.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param input Input real signals
+ * @param output Output spectra (length/2 + 1 bins each)
+ * @param length Transform length (real samples)
+ * @param batch Number of signals
+ * @param input_stride Stride between samples of one signal
+ * @param input_distance Distance between the first samples of consecutive signals
+ * @param output_stride Stride between bins of one spectrum
+ * @param output_distance Distance between the first bins of consecutive spectra
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fft_batch(SignalProcessor* sp, const double* input, double complex* output,
+                 size_t length, size_t batch,
+                 size_t input_stride, size_t input_distance,
+                 size_t output_stride, size_t output_distance);
+
+/**
+ * @brief Inverse FFT of a batch of equal-length spectra
+ * 
+ * Counterpart of sp_fft_batch() (fftw_plan_many_dft_c2r) with the same
+ * layout rules; input holds length/2 + 1 bins per spectrum and the real
+ * outputs are normalized by 1/length. The input is not modified.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param input Input spectra
+ * @param output Output real signals
+ * @param length Transform length (real samples)
+ * @param batch Number of spectra
+ * @param input_stride Stride between bins of one spectrum
+ * @param input_distance Distance between the first bins of consecutive spectra
+ * @param output_stride Stride between samples of one signal
+ * @param output_distance Distance between the first samples of consecutive signals
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_ifft_batch(SignalProcessor* sp, const double complex* input, double* output,
+                  size_t length, size_t batch,
+                  size_t input_stride, size_t input_distance,
+                  size_t output_stride, size_t output_distance);
+
+/**
+ * @brief In-place forward 2D FFT of a complex grid
+ * 
+ * Complex-to-complex over rows x cols samples in row-major order, with a
+ * cached FFTW plan made with the processor's thread count, so large grids
+ * split across FFTW threads. Unnormalized, like sp_fft().
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param data Grid, replaced by its spectrum
+ * @param rows Number of rows
+ * @param cols Number of columns (contiguous)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fft2d(SignalProcessor* sp, double complex* data, size_t rows, size_t cols);
+
+/**
+ * @brief In-place inverse 2D FFT of a complex grid
+ * 
+ * Counterpart of sp_fft2d(); the output is normalized by 1/(rows * cols).
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param data Spectrum, replaced by the grid
+ * @param rows Number of rows
+ * @param cols Number of columns (contiguous)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_ifft2d(SignalProcessor* sp, double complex* data, size_t rows, size_t cols);
+
+/**
+ * @brief Save accumulated FFTW wisdom to a file
+ * 
+ * Exports the planner's wisdom so the next run can load it with
+ * sp_load_wisdom() and skip FFTW_MEASURE planning for known sizes.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param path Wisdom file path
+ * @return FSO_SUCCESS on success, FSO_ERROR_IO if the file cannot be written
+ */
+int sp_save_wisdom(const SignalProcessor* sp, const char* path);
+
+/**
+ * @brief Load FFTW wisdom from a file
+ * 
+ * Imports wisdom saved by sp_save_wisdom(). Plans created afterwards reuse
+ * it, so planning a previously measured size is nearly free.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param path Wisdom file path
+ * @return FSO_SUCCESS on success, FSO_ERROR_IO if the file is missing or invalid
+ */
+int sp_load_wisdom(SignalProcessor* sp, const char* path);
+
 /* ============================================================================
  * Filtering Operations
  * ============================================================================ */
@@ -146,14 +511,15 @@ int sp_ifft(SignalProcessor* sp, const double complex* input,
  * 
  * @note Output array must be pre-allocated with same size as input
  * @note Edge samples use partial windows
+ * @note O(N) sliding window sum; cost does not grow with the window size
  */
 int sp_moving_average(SignalProcessor* sp, const double* input,
                       double* output, size_t length, int window);
 
 /**
- * @brief Apply adaptive LMS filter with parallel weight updates
+ * @brief Apply adaptive LMS filter
  * 
- * Implements Least Mean Squares adaptive filter with parallel processing.
+ * Implements the Least Mean Squares adaptive filter, one update per sample.
  * Updates filter weights to minimize error between output and desired signal.
  * 
  * @param sp Pointer to signal processor structure
@@ -166,16 +532,44 @@ int sp_moving_average(SignalProcessor* sp, const double* input,
  * 
  * @note Filter coefficients are stored in sp->filter_coeffs
  * @note Filter length is sp->filter_length
+ * @note Runs serially with vectorized tap loops; see sp_adaptive_filter_block()
+ *       for block and frequency-domain variants
  */
 int sp_adaptive_filter(SignalProcessor* sp, const double* input,
                        const double* desired, double* output,
                        size_t length, double mu);
 
 /**
- * @brief Perform convolution using overlap-add method with parallel FFT
+ * @brief Adaptive LMS filter with selectable block schedule
+ * 
+ * SP_LMS_SAMPLE matches sp_adaptive_filter() with config->num_taps taps.
+ * SP_LMS_BLOCK holds the weights fixed for block_size samples and then
+ * applies w += 2 mu sum(e[n] x_n); large blocks filter in parallel.
+ * SP_LMS_FREQUENCY computes the same block update with overlap-save FFTs
+ * (FFT size: power of two >= num_taps + block_size - 1) using the
+ * processor's cached plans, which pays off for long filters.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param config Adaptive filter configuration
+ * @param input Input signal array
+ * @param desired Desired output signal array
+ * @param output Actual output signal array
+ * @param length Length of input/output arrays
+ * @return FSO_SUCCESS on success, error code otherwise
+ * 
+ * @note Weights persist in sp->filter_coeffs and are reset if num_taps changes
+ * @note Block updates take mu steps of B samples at once; use a smaller mu
+ *       than sample LMS for large blocks
+ */
+int sp_adaptive_filter_block(SignalProcessor* sp, const SPAdaptiveConfig* config,
+                             const double* input, const double* desired,
+                             double* output, size_t length);
+
+/**
+ * @brief Perform convolution with direct or overlap-save FFT method
  * 
- * Computes linear convolution of signal with kernel using FFT-based
- * overlap-add method for efficiency with long kernels.
+ * Computes linear convolution of signal with kernel. Kernels of 64 taps or
+ * more use the overlap-save SPConvolver with a fixed FFT size.
  * 
  * @param sp Pointer to signal processor structure
  * @param signal Input signal array
@@ -192,6 +586,192 @@ int sp_convolution(SignalProcessor* sp, const double* signal,
                    const double* kernel, double* output,
                    size_t sig_len, size_t kernel_len);
 
+/**
+ * @brief Initialize a streaming overlap-save convolver
+ * 
+ * @param conv Pointer to convolver structure
+ * @param sp Signal processor used for FFTs (must outlive the convolver)
+ * @param kernel Convolution kernel array
+ * @param kernel_len Length of kernel
+ * @param fft_size FFT size (>= kernel_len), 0 for the next power of two >= 4 * kernel_len
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_convolver_init(SPConvolver* conv, SignalProcessor* sp,
+                      const double* kernel, size_t kernel_len, size_t fft_size);
+
+/**
+ * @brief Feed samples through the convolver
+ * 
+ * Produces exactly one output sample per input sample: output[i] is the
+ * convolution sum ending at input[i], with earlier calls providing the
+ * history. Partial blocks are exact because the filter is causal.
+ * 
+ * @param conv Pointer to initialized convolver
+ * @param input Input samples
+ * @param output Output samples (same length as input)
+ * @param length Number of samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_convolver_process(SPConvolver* conv, const double* input,
+                         double* output, size_t length);
+
+/**
+ * @brief Emit the kernel_len - 1 tail samples of the convolution
+ * 
+ * @param conv Pointer to initialized convolver
+ * @param output Output array of kernel_len - 1 samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_convolver_flush(SPConvolver* conv, double* output);
+
+/**
+ * @brief Clear the convolver history to start a new signal
+ * 
+ * @param conv Pointer to convolver
+ */
+void sp_convolver_reset(SPConvolver* conv);
+
+/**
+ * @brief Free convolver buffers
+ * 
+ * @param conv Pointer to convolver
+ */
+void sp_convolver_free(SPConvolver* conv);
+
+/* ============================================================================
+ * Streaming Filters
+ * ============================================================================ */
+
+/*
+ * Stream objects carry their state across push calls, so feeding a signal
+ * in chunks of any size gives the same result as one long push. Buffers are
+ * allocated at init; push never allocates. Every push emits exactly one
+ * output per input sample with a fixed, chunk-independent latency.
+ */
+
+/**
+ * @brief Initialize a streaming FIR filter
+ * 
+ * @param stream Pointer to stream structure
+ * @param sp Signal processor for long kernels (NULL forces direct form;
+ *           must outlive the stream)
+ * @param taps Kernel coefficients (copied)
+ * @param num_taps Kernel length
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fir_stream_init(SPFirStream* stream, SignalProcessor* sp,
+                       const double* taps, int num_taps);
+
+/**
+ * @brief Filter a chunk of samples
+ * 
+ * output[i] is the causal convolution sum ending at input[i] (zero added
+ * latency; the stream starts from zero history).
+ * 
+ * @param stream Pointer to initialized stream
+ * @param input Input samples
+ * @param output Output samples (same length as input)
+ * @param count Number of samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_fir_stream_push(SPFirStream* stream, const double* input,
+                       double* output, size_t count);
+
+/**
+ * @brief Clear the FIR history
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_fir_stream_reset(SPFirStream* stream);
+
+/**
+ * @brief Free FIR stream buffers
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_fir_stream_free(SPFirStream* stream);
+
+/**
+ * @brief Initialize a streaming moving average
+ * 
+ * @param stream Pointer to stream structure
+ * @param window Window length
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_moving_avg_stream_init(SPMovingAvgStream* stream, int window);
+
+/**
+ * @brief Average a chunk of samples
+ * 
+ * output[i] is the mean of the last window samples up to and including
+ * input[i] (fewer during warm-up). Once warm, this equals the centered
+ * sp_moving_average() result delayed by window - 1 - window / 2 samples.
+ * 
+ * @param stream Pointer to initialized stream
+ * @param input Input samples
+ * @param output Output samples (same length as input)
+ * @param count Number of samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_moving_avg_stream_push(SPMovingAvgStream* stream, const double* input,
+                              double* output, size_t count);
+
+/**
+ * @brief Clear the moving average window
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_moving_avg_stream_reset(SPMovingAvgStream* stream);
+
+/**
+ * @brief Free moving average buffers
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_moving_avg_stream_free(SPMovingAvgStream* stream);
+
+/**
+ * @brief Initialize a streaming LMS filter
+ * 
+ * SP_LMS_BLOCK and SP_LMS_FREQUENCY both stream as time-domain block LMS
+ * (identical updates); SP_LMS_SAMPLE updates every sample.
+ * 
+ * @param stream Pointer to stream structure
+ * @param config Adaptive filter configuration
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_lms_stream_init(SPLmsStream* stream, const SPAdaptiveConfig* config);
+
+/**
+ * @brief Filter and adapt on a chunk of samples
+ * 
+ * output[i] uses the weights in effect when input[i] arrives. Block updates
+ * are applied when a block completes, even if it spans several pushes.
+ * 
+ * @param stream Pointer to initialized stream
+ * @param input Input samples
+ * @param desired Reference samples, or NULL to filter with frozen weights
+ * @param output Output samples (same length as input)
+ * @param count Number of samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_lms_stream_push(SPLmsStream* stream, const double* input, const double* desired,
+                       double* output, size_t count);
+
+/**
+ * @brief Zero the weights and history
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_lms_stream_reset(SPLmsStream* stream);
+
+/**
+ * @brief Free LMS stream buffers
+ * 
+ * @param stream Pointer to stream
+ */
+void sp_lms_stream_free(SPLmsStream* stream);
+
 /* ============================================================================
  * Channel Estimation
  * ============================================================================ */
@@ -218,6 +798,54 @@ int sp_channel_estimate_pilot(SignalProcessor* sp,
                                double complex* channel_estimate,
                                size_t estimate_length);
 
+/**
+ * @brief Pilot-based channel estimation on complex buffers
+ * 
+ * Same estimate as sp_channel_estimate_pilot(); every buffer may use
+ * either layout. sp_channel_estimate_pilot() wraps its arrays and calls
+ * this, so neither path copies samples. Interpolation is linear; see
+ * sp_channel_estimate_pilot_interp().
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param received Received signal
+ * @param pilots Known pilot symbols (length = number of pilots)
+ * @param pilot_positions Positions of pilots in received signal
+ * @param channel_estimate Output estimate (capacity >= estimate_length; length is set)
+ * @param estimate_length Length of channel estimate
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_channel_estimate_pilot_buffer(SignalProcessor* sp,
+                                     const FSOComplexBuffer* received,
+                                     const FSOComplexBuffer* pilots,
+                                     const size_t* pilot_positions,
+                                     FSOComplexBuffer* channel_estimate,
+                                     size_t estimate_length);
+
+/**
+ * @brief Pilot-based channel estimation with a choice of interpolation
+ * 
+ * Pilot estimates live in the processor's estimation workspace, so calls
+ * after the first allocate nothing. Positions between two pilots are
+ * filled segment by segment in vector loops; positions before the first
+ * or after the last pilot hold that pilot's estimate.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param received Received signal
+ * @param pilots Known pilot symbols (length = number of pilots)
+ * @param pilot_positions Positions of pilots, in increasing order
+ * @param interpolation Interpolation between pilot estimates
+ * @param channel_estimate Output estimate (capacity >= estimate_length; length is set)
+ * @param estimate_length Length of channel estimate
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_channel_estimate_pilot_interp(SignalProcessor* sp,
+                                     const FSOComplexBuffer* received,
+                                     const FSOComplexBuffer* pilots,
+                                     const size_t* pilot_positions,
+                                     SPPilotInterpolation interpolation,
+                                     FSOComplexBuffer* channel_estimate,
+                                     size_t estimate_length);
+
 /**
  * @brief Least-squares channel estimation
  * 
@@ -238,6 +866,27 @@ int sp_channel_estimate_ls(SignalProcessor* sp,
                             double complex* channel_estimate,
                             size_t channel_length);
 
+/**
+ * @brief Least-squares channel estimation on complex buffers
+ * 
+ * The correlation runs on real and imaginary parts directly, so split
+ * buffers vectorize over unit-stride planes. Channels of
+ * SP_LS_FFT_MIN_TAPS taps or more correlate through cached real FFT plans
+ * in O(N log N) instead of O(L N); shorter ones use the direct loop.
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param received Received signal (its length is the signal length)
+ * @param transmitted Known transmitted signal (at least as long)
+ * @param channel_estimate Output taps (capacity >= channel_length; length is set)
+ * @param channel_length Length of channel impulse response
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_channel_estimate_ls_buffer(SignalProcessor* sp,
+                                  const FSOComplexBuffer* received,
+                                  const FSOComplexBuffer* transmitted,
+                                  FSOComplexBuffer* channel_estimate,
+                                  size_t channel_length);
+
 /**
  * @brief Estimate noise variance
  * 
@@ -257,4 +906,59 @@ int sp_noise_variance_estimate(SignalProcessor* sp,
                                 size_t length,
                                 double* noise_variance);
 
+/**
+ * @brief Estimate noise variance from complex buffers
+ * 
+ * @param sp Pointer to signal processor structure
+ * @param received Received signal (its length is the sample count)
+ * @param expected Expected signal (at least as long)
+ * @param noise_variance Output noise variance estimate
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_noise_variance_estimate_buffer(SignalProcessor* sp,
+                                      const FSOComplexBuffer* received,
+                                      const FSOComplexBuffer* expected,
+                                      double* noise_variance);
+
+/**
+ * @brief Initialize a recursive least-squares channel tracker
+ * 
+ * @param tracker Pointer to tracker structure
+ * @param num_taps Channel taps to track
+ * @param forgetting_factor Lambda in (0, 1]; 1 - lambda sets how fast old samples fade
+ * @param delta Initial P = delta * I (large for an uninformed start, e.g. 100)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_rls_tracker_init(SPRlsTracker* tracker, int num_taps,
+                        double forgetting_factor, double delta);
+
+/**
+ * @brief Update the tap estimate with a chunk of known samples
+ * 
+ * Chunked updates match a single update over the concatenated samples.
+ * tracker->taps holds the estimate after the last sample.
+ * 
+ * @param tracker Pointer to initialized tracker
+ * @param transmitted Known transmitted samples
+ * @param received Received samples (same length)
+ * @param count Number of samples
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int sp_rls_tracker_update(SPRlsTracker* tracker, const double complex* transmitted,
+                          const double complex* received, size_t count);
+
+/**
+ * @brief Forget the estimate and history (P back to delta * I)
+ * 
+ * @param tracker Pointer to tracker
+ */
+void sp_rls_tracker_reset(SPRlsTracker* tracker);
+
+/**
+ * @brief Free tracker buffers
+ * 
+ * @param tracker Pointer to tracker
+ */
+void sp_rls_tracker_free(SPRlsTracker* tracker);
+
 #endif /* SIGNAL_PROCESSING_H */
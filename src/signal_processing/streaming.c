@@ -0,0 +1,321 @@
+/**
+ * @file streaming.c
+ * @brief Stateful streaming filters for chunked, online processing
+ * 
+ * Each stream keeps its tap history, running sums and adaptive weights
+ * between push calls, so a signal fed in arbitrary chunks produces the
+ * same output as one long call. All buffers are allocated at init time;
+ * push never allocates and emits exactly one output per input sample.
+ */
+
+#include "signal_processing.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MODULE_NAME "Streaming"
+
+/* Kernels at least this long are run through the overlap-save convolver */
+#define SP_FIR_STREAM_FFT_TAPS 64
+
+/* ============================================================================
+ * Delay Line Helpers
+ * ============================================================================ */
+
+/*
+ * Delay lines are stored twice (2 * taps doubles), so the most recent taps
+ * samples are always contiguous: line[pos] is x[n], line[pos + 1] is
+ * x[n - 1], and so on. Dot products therefore run without wrap checks.
+ */
+
+static inline void sp_delay_line_push(double* line, int taps, int* pos, double sample) {
+    int p = (*pos == 0) ? taps - 1 : *pos - 1;
+    line[p] = sample;
+    line[p + taps] = sample;
+    *pos = p;
+}
+
+static inline double sp_delay_line_dot(const double* line, int pos,
+                                       const double* weights, int taps) {
+    const double* x = line + pos;
+    double sum = 0.0;
+#ifdef _OPENMP
+    #pragma omp simd reduction(+:sum)
+#endif
+    for (int k = 0; k < taps; k++) {
+        sum += weights[k] * x[k];
+    }
+    return sum;
+}
+
+/* ============================================================================
+ * FIR Stream
+ * ============================================================================ */
+
+int sp_fir_stream_init(SPFirStream* stream, SignalProcessor* sp,
+                       const double* taps, int num_taps) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_NULL(taps);
+    FSO_CHECK_PARAM(num_taps > 0);
+    
+    memset(stream, 0, sizeof(SPFirStream));
+    stream->num_taps = num_taps;
+    
+    // Long kernels use overlap-save blocks; partial blocks stay exact
+    if (sp != NULL && num_taps >= SP_FIR_STREAM_FFT_TAPS) {
+        int ret = sp_convolver_init(&stream->convolver, sp, taps, (size_t)num_taps, 0);
+        if (ret != FSO_SUCCESS) {
+            return ret;
+        }
+        stream->use_fft = 1;
+        FSO_LOG_DEBUG(MODULE_NAME, "FIR stream: %d taps via overlap-save", num_taps);
+        return FSO_SUCCESS;
+    }
+    
+    stream->taps = (double*)malloc((size_t)num_taps * sizeof(double));
+    stream->delay_line = (double*)calloc(2 * (size_t)num_taps, sizeof(double));
+    if (stream->taps == NULL || stream->delay_line == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate FIR stream buffers");
+        sp_fir_stream_free(stream);
+        return FSO_ERROR_MEMORY;
+    }
+    memcpy(stream->taps, taps, (size_t)num_taps * sizeof(double));
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "FIR stream: %d taps direct", num_taps);
+    return FSO_SUCCESS;
+}
+
+int sp_fir_stream_push(SPFirStream* stream, const double* input,
+                       double* output, size_t count) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    
+    if (stream->use_fft) {
+        return sp_convolver_process(&stream->convolver, input, output, count);
+    }
+    
+    FSO_CHECK_NULL(stream->delay_line);
+    
+    for (size_t i = 0; i < count; i++) {
+        sp_delay_line_push(stream->delay_line, stream->num_taps, &stream->position, input[i]);
+        output[i] = sp_delay_line_dot(stream->delay_line, stream->position,
+                                      stream->taps, stream->num_taps);
+    }
+    
+    return FSO_SUCCESS;
+}
+
+void sp_fir_stream_reset(SPFirStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+    
+    if (stream->use_fft) {
+        sp_convolver_reset(&stream->convolver);
+    } else if (stream->delay_line != NULL) {
+        memset(stream->delay_line, 0, 2 * (size_t)stream->num_taps * sizeof(double));
+        stream->position = 0;
+    }
+}
+
+void sp_fir_stream_free(SPFirStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+    
+    if (stream->use_fft) {
+        sp_convolver_free(&stream->convolver);
+    }
+    free(stream->taps);
+    free(stream->delay_line);
+    
+    memset(stream, 0, sizeof(SPFirStream));
+}
+
+/* ============================================================================
+ * Moving Average Stream
+ * ============================================================================ */
+
+int sp_moving_avg_stream_init(SPMovingAvgStream* stream, int window) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_PARAM(window > 0);
+    
+    memset(stream, 0, sizeof(SPMovingAvgStream));
+    stream->window = window;
+    stream->ring = (double*)calloc((size_t)window, sizeof(double));
+    if (stream->ring == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate moving average ring");
+        return FSO_ERROR_MEMORY;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+int sp_moving_avg_stream_push(SPMovingAvgStream* stream, const double* input,
+                              double* output, size_t count) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_NULL(stream->ring);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    
+    double sum = stream->sum;
+    double compensation = stream->compensation;
+    
+    for (size_t i = 0; i < count; i++) {
+        // Replace the oldest sample; compensated update keeps the sum exact
+        double delta = input[i] - stream->ring[stream->position];
+        stream->ring[stream->position] = input[i];
+        if (++stream->position == stream->window) {
+            stream->position = 0;
+        }
+        if (stream->filled < stream->window) {
+            stream->filled++;
+        }
+        
+        double y = delta - compensation;
+        double t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+        
+        output[i] = sum / (double)stream->filled;
+    }
+    
+    stream->sum = sum;
+    stream->compensation = compensation;
+    
+    return FSO_SUCCESS;
+}
+
+void sp_moving_avg_stream_reset(SPMovingAvgStream* stream) {
+    if (stream == NULL || stream->ring == NULL) {
+        return;
+    }
+    
+    memset(stream->ring, 0, (size_t)stream->window * sizeof(double));
+    stream->position = 0;
+    stream->filled = 0;
+    stream->sum = 0.0;
+    stream->compensation = 0.0;
+}
+
+void sp_moving_avg_stream_free(SPMovingAvgStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+    
+    free(stream->ring);
+    memset(stream, 0, sizeof(SPMovingAvgStream));
+}
+
+/* ============================================================================
+ * LMS Stream
+ * ============================================================================ */
+
+int sp_lms_stream_init(SPLmsStream* stream, const SPAdaptiveConfig* config) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_NULL(config);
+    FSO_CHECK_PARAM(config->num_taps > 0);
+    FSO_CHECK_PARAM(config->mu > 0.0 && config->mu < 1.0);
+    FSO_CHECK_PARAM(config->mode == SP_LMS_SAMPLE || config->block_size > 0);
+    
+    memset(stream, 0, sizeof(SPLmsStream));
+    stream->num_taps = config->num_taps;
+    stream->mu = config->mu;
+    
+    // The frequency-domain schedule computes the block update; per-sample
+    // streaming uses the equivalent time-domain block form
+    stream->block_size = (config->mode == SP_LMS_SAMPLE) ? 1 : config->block_size;
+    
+    size_t taps = (size_t)config->num_taps;
+    stream->weights = (double*)calloc(taps, sizeof(double));
+    stream->gradient = (double*)calloc(taps, sizeof(double));
+    stream->delay_line = (double*)calloc(2 * taps, sizeof(double));
+    if (!stream->weights || !stream->gradient || !stream->delay_line) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate LMS stream buffers");
+        sp_lms_stream_free(stream);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "LMS stream: %d taps, block %zu, mu=%f",
+                  stream->num_taps, stream->block_size, stream->mu);
+    
+    return FSO_SUCCESS;
+}
+
+int sp_lms_stream_push(SPLmsStream* stream, const double* input, const double* desired,
+                       double* output, size_t count) {
+    FSO_CHECK_NULL(stream);
+    FSO_CHECK_NULL(stream->weights);
+    FSO_CHECK_NULL(input);
+    FSO_CHECK_NULL(output);
+    
+    const int taps = stream->num_taps;
+    
+    for (size_t i = 0; i < count; i++) {
+        sp_delay_line_push(stream->delay_line, taps, &stream->position, input[i]);
+        const double* x = stream->delay_line + stream->position;
+        double y = sp_delay_line_dot(stream->delay_line, stream->position,
+                                     stream->weights, taps);
+        output[i] = y;
+        
+        // Without a reference the weights stay frozen
+        if (desired == NULL) {
+            continue;
+        }
+        
+        double error = desired[i] - y;
+        if (stream->block_size == 1) {
+            double step = 2.0 * stream->mu * error;
+#ifdef _OPENMP
+            #pragma omp simd
+#endif
+            for (int k = 0; k < taps; k++) {
+                stream->weights[k] += step * x[k];
+            }
+            continue;
+        }
+        
+        // Block LMS: accumulate across pushes, update once per block
+#ifdef _OPENMP
+        #pragma omp simd
+#endif
+        for (int k = 0; k < taps; k++) {
+            stream->gradient[k] += error * x[k];
+        }
+        
+        if (++stream->block_fill == stream->block_size) {
+            for (int k = 0; k < taps; k++) {
+                stream->weights[k] += 2.0 * stream->mu * stream->gradient[k];
+                stream->gradient[k] = 0.0;
+            }
+            stream->block_fill = 0;
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
+
+void sp_lms_stream_reset(SPLmsStream* stream) {
+    if (stream == NULL || stream->weights == NULL) {
+        return;
+    }
+    
+    size_t taps = (size_t)stream->num_taps;
+    memset(stream->weights, 0, taps * sizeof(double));
+    memset(stream->gradient, 0, taps * sizeof(double));
+    memset(stream->delay_line, 0, 2 * taps * sizeof(double));
+    stream->position = 0;
+    stream->block_fill = 0;
+}
+
+void sp_lms_stream_free(SPLmsStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+    
+    free(stream->weights);
+    free(stream->gradient);
+    free(stream->delay_line);
+    memset(stream, 0, sizeof(SPLmsStream));
+}
@@ -20,6 +20,8 @@
 #define DEFAULT_CORRELATION_TIME 0.001  /* 1 ms */
 #define DEFAULT_HISTORY_LENGTH 100
 #define DEFAULT_BEAM_DIVERGENCE 1e-3    /* 1 mrad */
+#define DEFAULT_MALAGA_OMEGA 0.86       /* LOS share of the mean power */
+#define DEFAULT_MALAGA_RHO 0.6          /* Coupled share of the scattered power */
 
 /* Parameter validation ranges */
 #define MIN_DISTANCE 100.0              /* 100 meters */
@@ -29,6 +31,16 @@
 #define MIN_CN2 1e-17
 #define MAX_CN2 1e-12
 
+/* Inverse-CDF table construction */
+#define ICDF_CDF_POINTS 2048            /* Log-spaced irradiance grid for the CDF */
+#define ICDF_I_MIN 1e-4                 /* Lowest tabulated irradiance; power-law tail below */
+#define BESSEL_POINTS 256               /* Trapezoid nodes for K_ν */
+
+/* Fade trace generation */
+#define TRACE_CHUNK 256                 /* Samples per blocked AR pass (power of 2) */
+#define TRACE_LOG_FADE_MIN -4.605170185988091  /* ln(0.01): -20 dB clamp */
+#define TRACE_LOG_FADE_MAX 4.605170185988091   /* ln(100): +20 dB clamp */
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -73,6 +85,22 @@ const char* channel_get_weather_name(WeatherCondition weather) {
     }
 }
 
+/**
+ * @brief Get fading model name
+ */
+const char* channel_get_fading_model_name(ChannelFadingModel model) {
+    switch (model) {
+        case CHANNEL_FADING_LOG_NORMAL:
+            return "Log-normal";
+        case CHANNEL_FADING_GAMMA_GAMMA:
+            return "Gamma-gamma";
+        case CHANNEL_FADING_MALAGA:
+            return "Malaga";
+        default:
+            return "Unknown";
+    }
+}
+
 /**
  * @brief Validate channel parameters
  */
@@ -98,6 +126,282 @@ int channel_validate_params(double distance, double wavelength, double cn2) {
     return FSO_SUCCESS;
 }
 
+/* ============================================================================
+ * Fading Distribution Tables
+ * ============================================================================ */
+
+/**
+ * @brief ln K_ν(x), the modified Bessel function of the second kind
+ * 
+ * K_ν(x) = ∫₀^∞ exp(-x·cosh t)·cosh(νt) dt. The integrand is even and
+ * decays double-exponentially, so the trapezoid rule converges fast; it
+ * is evaluated relative to its peak at t* = asinh(ν/x) so neither large
+ * orders nor large arguments overflow.
+ */
+static double channel_log_bessel_k(double nu, double x) {
+    nu = fabs(nu);
+    
+    double t_peak = asinh(nu / x);
+    double g_peak = -x * (cosh(t_peak) - 1.0) + nu * t_peak;
+    
+    /* Extend until the integrand is e^-40 below its peak */
+    double t_end = t_peak + 1.0;
+    while (-x * (cosh(t_end) - 1.0) + nu * t_end > g_peak - 40.0) {
+        t_end += (t_end - t_peak);
+    }
+    
+    double h = t_end / (BESSEL_POINTS - 1);
+    double sum = 0.0;
+    for (int i = 0; i < BESSEL_POINTS; i++) {
+        double t = i * h;
+        double g = -x * (cosh(t) - 1.0) + nu * t;
+        double weight = (i == 0) ? 0.5 : 1.0;
+        sum += weight * exp(g - g_peak) * 0.5 * (1.0 + exp(-2.0 * nu * t));
+    }
+    
+    return -x + g_peak + log(sum * h);
+}
+
+/**
+ * @brief ln of the unit-mean gamma-gamma irradiance pdf
+ * 
+ * f(I) = 2(αβ)^((α+β)/2) / (Γ(α)Γ(β)) · I^((α+β)/2 - 1) · K_(α-β)(2√(αβI))
+ */
+static double channel_log_pdf_gamma_gamma(double alpha, double beta, double log_i) {
+    double ab = alpha * beta;
+    return log(2.0) + 0.5 * (alpha + beta) * log(ab) - lgamma(alpha) - lgamma(beta) +
+           (0.5 * (alpha + beta) - 1.0) * log_i +
+           channel_log_bessel_k(alpha - beta, 2.0 * sqrt(ab * exp(log_i)));
+}
+
+/**
+ * @brief ln of the unit-mean Málaga irradiance pdf (integer β)
+ * 
+ * f(I) = A Σ_{k=1..β} a_k I^((α+k)/2 - 1) K_(α-k)(2√(αβI / (gβ + Ω')))
+ * with g = 2b₀(1 - ρ) and Ω' = Ω + 2b₀ρ (LOS and coupled scatter in
+ * quadrature); the terms are combined with log-sum-exp.
+ */
+static double channel_log_pdf_malaga(double alpha, int beta, double omega, double rho,
+                                     double log_i) {
+    double two_b0 = 1.0 - omega;
+    double g = two_b0 * (1.0 - rho);
+    double omega_p = omega + two_b0 * rho;
+    double scale = g * beta + omega_p;
+    
+    double log_a = log(2.0) + 0.5 * alpha * log(alpha) - (1.0 + 0.5 * alpha) * log(g) -
+                   lgamma(alpha) + (beta + 0.5 * alpha) * log(g * beta / scale);
+    double x = 2.0 * sqrt(alpha * beta * exp(log_i) / scale);
+    
+    double terms[64];
+    int num_terms = beta < 64 ? beta : 64;
+    double max_term = -INFINITY;
+    for (int k = 1; k <= num_terms; k++) {
+        double log_choose = lgamma(beta) - lgamma(k) - lgamma(beta - k + 1);
+        double log_ak = log_choose + (1.0 - 0.5 * k) * log(scale) - lgamma(k) +
+                        (k - 1) * log(omega_p / g) + 0.5 * k * log(alpha / beta);
+        terms[k - 1] = log_ak + (0.5 * (alpha + k) - 1.0) * log_i +
+                       channel_log_bessel_k(alpha - k, x);
+        if (terms[k - 1] > max_term) {
+            max_term = terms[k - 1];
+        }
+    }
+    
+    double sum = 0.0;
+    for (int k = 0; k < num_terms; k++) {
+        sum += exp(terms[k] - max_term);
+    }
+    
+    return log_a + max_term + log(sum);
+}
+
+/**
+ * @brief Build the inverse-CDF table for the current gamma-gamma or Málaga parameters
+ * 
+ * The pdf is integrated on a log-spaced irradiance grid (dF = f(I)·I·d ln I),
+ * with the power-law start F(I_min) = f(I_min)·I_min / p from the local
+ * log-slope p. Each normal quantile z then maps to ln I by interpolating
+ * the CDF, or by extending the power law below I_min.
+ */
+static int channel_build_icdf(ChannelModel* channel) {
+    ChannelFadingModel model = channel->fading_model;
+    double alpha = channel->gg_alpha;
+    double beta = channel->gg_beta;
+    int beta_int = (int)beta;
+    double omega = channel->malaga_omega;
+    double rho = channel->malaga_rho;
+    
+    /* Upper end where the exp(-2√(αβI / scale)) tail is below e^-40 */
+    double scale = 1.0;
+    if (model == CHANNEL_FADING_MALAGA) {
+        scale = (1.0 - omega) * (1.0 - rho) * beta + omega + (1.0 - omega) * rho;
+    }
+    double i_max = 400.0 * scale / (alpha * beta);
+    if (i_max < 10.0) {
+        i_max = 10.0;
+    }
+    
+    double* log_i = (double*)malloc(ICDF_CDF_POINTS * sizeof(double));
+    double* cdf = (double*)malloc(ICDF_CDF_POINTS * sizeof(double));
+    if (channel->icdf_table == NULL) {
+        channel->icdf_table = (double*)malloc(CHANNEL_ICDF_POINTS * sizeof(double));
+    }
+    if (log_i == NULL || cdf == NULL || channel->icdf_table == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate fading table");
+        free(log_i);
+        free(cdf);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    /* In weak turbulence the grid narrows to ±14 log-normal widths of the
+     * gamma-gamma scintillation index so the peak stays resolved */
+    double scint = 1.0 / alpha + 1.0 / beta + 1.0 / (alpha * beta);
+    double width = 14.0 * sqrt(log(1.0 + scint));
+    double log_lo = FSO_MAX(log(ICDF_I_MIN), -width);
+    double log_hi = FSO_MIN(log(i_max), width);
+    
+    /* ln(f(I)·I) on the grid; cdf[] holds it until the integration pass */
+    double step = (log_hi - log_lo) / (ICDF_CDF_POINTS - 1);
+    for (int i = 0; i < ICDF_CDF_POINTS; i++) {
+        log_i[i] = log_lo + i * step;
+        double log_pdf = (model == CHANNEL_FADING_MALAGA) ?
+            channel_log_pdf_malaga(alpha, beta_int, omega, rho, log_i[i]) :
+            channel_log_pdf_gamma_gamma(alpha, beta, log_i[i]);
+        cdf[i] = log_pdf + log_i[i];
+    }
+    
+    double tail_slope = (cdf[1] - cdf[0]) / step;
+    if (tail_slope < 1e-3) {
+        tail_slope = 1e-3;
+    }
+    
+    double density_prev = exp(cdf[0]);
+    double running = density_prev / tail_slope;
+    cdf[0] = running;
+    for (int i = 1; i < ICDF_CDF_POINTS; i++) {
+        double density = exp(cdf[i]);
+        running += 0.5 * (density + density_prev) * step;
+        density_prev = density;
+        cdf[i] = running;
+    }
+    
+    /* Absorb the quadrature and truncation error */
+    double total = cdf[ICDF_CDF_POINTS - 1];
+    for (int i = 0; i < ICDF_CDF_POINTS; i++) {
+        cdf[i] /= total;
+    }
+    
+    int j = 0;
+    for (int q = 0; q < CHANNEL_ICDF_POINTS; q++) {
+        double z = -CHANNEL_ICDF_Z_MAX + q * (2.0 * CHANNEL_ICDF_Z_MAX / (CHANNEL_ICDF_POINTS - 1));
+        double u = 0.5 * erfc(-z / sqrt(2.0));
+        
+        if (u <= cdf[0]) {
+            channel->icdf_table[q] = log_i[0] + log(u / cdf[0]) / tail_slope;
+            continue;
+        }
+        
+        /* Quantiles rise with q, so the search resumes where it stopped */
+        while (j < ICDF_CDF_POINTS - 2 && cdf[j + 1] < u) {
+            j++;
+        }
+        double span = cdf[j + 1] - cdf[j];
+        double frac = (span > 0.0) ? (u - cdf[j]) / span : 0.0;
+        if (frac > 1.0) {
+            frac = 1.0;
+        }
+        channel->icdf_table[q] = log_i[j] + frac * step;
+    }
+    
+    free(log_i);
+    free(cdf);
+    
+    channel->icdf_params[0] = (double)model;
+    channel->icdf_params[1] = alpha;
+    channel->icdf_params[2] = beta;
+    channel->icdf_params[3] = omega;
+    channel->icdf_params[4] = rho;
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Built %s fading table: alpha=%.3f, beta=%.3f, total mass %.6f",
+                 channel_get_fading_model_name(model), alpha, beta, total);
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Refresh α, β and, for non-log-normal models, the inverse-CDF table
+ */
+static int channel_update_fading_distribution(ChannelModel* channel) {
+    channel_calculate_gamma_gamma_params(channel->rytov_variance,
+                                         &channel->gg_alpha, &channel->gg_beta);
+    
+    /* Málaga's β counts the small-scale terms and has to be a natural number */
+    if (channel->fading_model == CHANNEL_FADING_MALAGA) {
+        channel->gg_beta = floor(channel->gg_beta + 0.5);
+        if (channel->gg_beta < 1.0) {
+            channel->gg_beta = 1.0;
+        }
+    }
+    
+    if (channel->fading_model == CHANNEL_FADING_LOG_NORMAL || channel->rytov_variance < 1e-6) {
+        return FSO_SUCCESS;
+    }
+    
+    if (channel->icdf_table != NULL &&
+        channel->icdf_params[0] == (double)channel->fading_model &&
+        channel->icdf_params[1] == channel->gg_alpha &&
+        channel->icdf_params[2] == channel->gg_beta &&
+        channel->icdf_params[3] == channel->malaga_omega &&
+        channel->icdf_params[4] == channel->malaga_rho) {
+        return FSO_SUCCESS;
+    }
+    
+    return channel_build_icdf(channel);
+}
+
+/**
+ * @brief ln I at normal quantile z, interpolated from the table
+ */
+static inline double channel_icdf_lookup(const double* table, double z) {
+    double pos = (z + CHANNEL_ICDF_Z_MAX) *
+                 ((CHANNEL_ICDF_POINTS - 1) / (2.0 * CHANNEL_ICDF_Z_MAX));
+    if (pos <= 0.0) {
+        return table[0];
+    }
+    if (pos >= CHANNEL_ICDF_POINTS - 1) {
+        return table[CHANNEL_ICDF_POINTS - 1];
+    }
+    
+    int i = (int)pos;
+    double frac = pos - i;
+    return table[i] + frac * (table[i + 1] - table[i]);
+}
+
+/**
+ * @brief Fading coefficient for log-amplitude X under the channel's model
+ * 
+ * Log-normal: I = exp(2X - 2σ_χ²). Otherwise z = X/σ_χ is a standard
+ * normal quantile and I = F⁻¹(Φ(z)) comes from the table. The result is
+ * clamped to [-20 dB, +20 dB] for every model.
+ */
+static double channel_fade_from_log_amplitude(const ChannelModel* channel, double X) {
+    double fading_coefficient;
+    
+    if (channel->fading_model == CHANNEL_FADING_LOG_NORMAL || channel->icdf_table == NULL) {
+        fading_coefficient = exp(2.0 * X - 2.0 * channel->rytov_variance);
+    } else {
+        double z = X / sqrt(channel->rytov_variance);
+        fading_coefficient = exp(channel_icdf_lookup(channel->icdf_table, z));
+    }
+    
+    if (fading_coefficient < 0.01) {
+        fading_coefficient = 0.01;  /* -20 dB fade */
+    } else if (fading_coefficient > 100.0) {
+        fading_coefficient = 100.0;  /* +20 dB fade */
+    }
+    
+    return fading_coefficient;
+}
+
 /* ============================================================================
  * Initialization Functions
  * ============================================================================ */
@@ -179,6 +483,12 @@ int channel_init_extended(ChannelModel* channel, double distance,
     channel->history_length = DEFAULT_HISTORY_LENGTH;
     channel->history_index = 0;
     channel->last_fade_value = 1.0;  /* Start with no fading */
+    channel->last_log_amplitude = 0.0;
+    
+    /* Log-normal until a stronger-turbulence model is selected */
+    channel->fading_model = CHANNEL_FADING_LOG_NORMAL;
+    channel->malaga_omega = DEFAULT_MALAGA_OMEGA;
+    channel->malaga_rho = DEFAULT_MALAGA_RHO;
     
     /* Allocate fade history buffer */
     channel->fade_history = (double*)calloc(channel->history_length, sizeof(double));
@@ -196,15 +506,16 @@ int channel_init_extended(ChannelModel* channel, double distance,
     channel->rng_seed = (unsigned int)time(NULL);
     fso_random_set_seed(channel->rng_seed);
     
-    /* Calculate initial values */
+    /* Calculate initial values (requires the initialized flag) */
+    channel->initialized = 1;
     result = channel_update_calculations(channel);
     if (result != FSO_SUCCESS) {
+        channel->initialized = 0;
         free(channel->fade_history);
+        free(channel->icdf_table);
         return result;
     }
     
-    channel->initialized = 1;
-    
     FSO_LOG_INFO(MODULE_NAME, "Channel initialized: distance=%.1f m, wavelength=%.0f nm, weather=%s",
                 distance, wavelength * 1e9, channel_get_weather_name(weather));
     FSO_LOG_DEBUG(MODULE_NAME, "Cn2=%.2e, Rytov variance=%.4f, Scintillation index=%.4f",
@@ -277,6 +588,64 @@ int channel_set_beam_divergence(ChannelModel* channel, double divergence) {
     return FSO_SUCCESS;
 }
 
+/**
+ * @brief Select the irradiance fading distribution
+ */
+int channel_set_fading_model(ChannelModel* channel, ChannelFadingModel model) {
+    FSO_CHECK_NULL(channel);
+    
+    if (!channel->initialized) {
+        FSO_LOG_ERROR(MODULE_NAME, "Channel not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    FSO_CHECK_PARAM(model >= CHANNEL_FADING_LOG_NORMAL && model <= CHANNEL_FADING_MALAGA);
+    
+    channel->fading_model = model;
+    
+    /* Rebuild the sampling table if needed */
+    return channel_update_calculations(channel);
+}
+
+/**
+ * @brief Set the Málaga line-of-sight parameters
+ */
+int channel_set_malaga_params(ChannelModel* channel, double omega, double rho) {
+    FSO_CHECK_NULL(channel);
+    
+    if (!channel->initialized) {
+        FSO_LOG_ERROR(MODULE_NAME, "Channel not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    FSO_CHECK_PARAM(omega > 0.0 && omega < 1.0);
+    FSO_CHECK_PARAM(rho >= 0.0 && rho < 1.0);
+    
+    channel->malaga_omega = omega;
+    channel->malaga_rho = rho;
+    
+    return channel_update_calculations(channel);
+}
+
+/**
+ * @brief Cache the receiver noise power
+ */
+int channel_set_noise_power(ChannelModel* channel, double noise_power) {
+    FSO_CHECK_NULL(channel);
+    
+    if (!channel->initialized) {
+        FSO_LOG_ERROR(MODULE_NAME, "Channel not initialized");
+        return FSO_ERROR_NOT_INITIALIZED;
+    }
+    
+    FSO_CHECK_PARAM(noise_power >= 0.0);
+    
+    channel->link_budget.noise_power = noise_power;
+    channel->link_budget.noise_stddev = sqrt(noise_power);
+    
+    return FSO_SUCCESS;
+}
+
 /**
  * @brief Update channel model calculations
  */
@@ -303,6 +672,21 @@ int channel_update_calculations(ChannelModel* channel) {
     /* Calculate weather attenuation */
     channel->attenuation_db = channel_calculate_attenuation(channel);
     
+    /* Static link budget: everything but the fade and the noise draw */
+    ChannelLinkBudget* budget = &channel->link_budget;
+    budget->absorption_db = channel_calculate_atmospheric_absorption(
+        channel->wavelength, channel->link_distance, channel->humidity);
+    budget->total_loss_db = channel->path_loss_db +
+                            channel->attenuation_db * (channel->link_distance / 1000.0) +
+                            budget->absorption_db;
+    budget->loss_linear = fso_db_to_linear(budget->total_loss_db);
+    
+    /* Gamma-gamma / Málaga parameters and sampling table */
+    int result = channel_update_fading_distribution(channel);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
     FSO_LOG_DEBUG(MODULE_NAME, "Updated calculations: Rytov=%.4f, Scint=%.4f, PathLoss=%.2f dB, Atten=%.2f dB",
                  channel->rytov_variance, channel->scintillation_index,
                  channel->path_loss_db, channel->attenuation_db);
@@ -323,6 +707,9 @@ void channel_free(ChannelModel* channel) {
         channel->fade_history = NULL;
     }
     
+    free(channel->icdf_table);
+    channel->icdf_table = NULL;
+    
     channel->initialized = 0;
     
     FSO_LOG_DEBUG(MODULE_NAME, "Channel freed");
@@ -348,6 +735,7 @@ int channel_get_info(const ChannelModel* channel, char* buffer, size_t buffer_si
         "  Cn2: %.2e m^(-2/3)\n"
         "  Rytov variance: %.4f\n"
         "  Scintillation index: %.4f\n"
+        "  Fading model: %s (alpha=%.3f, beta=%.3f)\n"
         "  Path loss: %.2f dB\n"
         "  Attenuation: %.2f dB/km\n"
         "  Temperature: %.1f °C\n"
@@ -358,6 +746,9 @@ int channel_get_info(const ChannelModel* channel, char* buffer, size_t buffer_si
         channel->cn2,
         channel->rytov_variance,
         channel->scintillation_index,
+        channel_get_fading_model_name(channel->fading_model),
+        channel->gg_alpha,
+        channel->gg_beta,
         channel->path_loss_db,
         channel->attenuation_db,
         channel->temperature,
@@ -412,6 +803,25 @@ double channel_calculate_scintillation_index(double rytov_variance) {
     return scint_index;
 }
 
+/**
+ * @brief Gamma-gamma α and β from the Rytov variance
+ * 
+ * σ_R² = 4σ_χ² matches the weak-turbulence scintillation index used above;
+ * both parameters tend to 1 in saturation and grow without bound as the
+ * turbulence vanishes.
+ */
+void channel_calculate_gamma_gamma_params(double rytov_variance, double* alpha, double* beta) {
+    double sigma_r2 = 4.0 * rytov_variance;
+    double sigma_r125 = pow(sigma_r2, 1.2);  /* σ_R^(12/5) */
+    
+    double a = exp(0.49 * sigma_r2 / pow(1.0 + 1.11 * sigma_r125, 7.0 / 6.0)) - 1.0;
+    double b = exp(0.51 * sigma_r2 / pow(1.0 + 0.69 * sigma_r125, 5.0 / 6.0)) - 1.0;
+    
+    /* Guard the weak-turbulence limit, where both go to infinity */
+    *alpha = (a > 1e-6) ? 1.0 / a : 1e6;
+    *beta = (b > 1e-6) ? 1.0 / b : 1e6;
+}
+
 /**
  * @brief Generate log-normal fading sample
  * 
@@ -432,20 +842,12 @@ double channel_generate_fading(ChannelModel* channel) {
     /* Generate Gaussian random variable X ~ N(0, σ_χ) */
     double sigma_chi = sqrt(channel->rytov_variance);
     double X = fso_random_gaussian(0.0, sigma_chi);
+    channel->last_log_amplitude = X;
     
-    /* Calculate log-normal fading: I = exp(2X - 2σ_χ²) */
-    /* The subtraction of 2σ_χ² normalizes the mean to 1.0 */
-    double log_amplitude = 2.0 * X - 2.0 * channel->rytov_variance;
-    double fading_coefficient = exp(log_amplitude);
-    
-    /* Clamp to reasonable range to avoid numerical issues */
-    if (fading_coefficient < 0.01) {
-        fading_coefficient = 0.01;  /* -20 dB fade */
-    } else if (fading_coefficient > 100.0) {
-        fading_coefficient = 100.0;  /* +20 dB fade */
-    }
-    
-    return fading_coefficient;
+    /* Log-normal: I = exp(2X - 2σ_χ²), where the subtraction of 2σ_χ²
+     * normalizes the mean to 1.0; otherwise X picks the table quantile.
+     * Clamped to a reasonable range to avoid numerical issues */
+    return channel_fade_from_log_amplitude(channel, X);
 }
 
 /**
@@ -479,29 +881,14 @@ double channel_generate_correlated_fading(ChannelModel* channel, double time_ste
     double sigma_chi = sqrt(channel->rytov_variance);
     double white_noise = fso_random_gaussian(0.0, sigma_chi);
     
-    /* Get previous log-amplitude value */
-    /* Convert last fade value back to log-amplitude */
-    double last_log_amplitude;
-    if (channel->last_fade_value > 0.0) {
-        last_log_amplitude = log(channel->last_fade_value) / 2.0 + channel->rytov_variance;
-    } else {
-        last_log_amplitude = 0.0;
-    }
-    
     /* AR(1) process: X(t) = ρ*X(t-1) + sqrt(1-ρ²)*W(t) */
-    double current_log_amplitude = rho * last_log_amplitude + 
+    /* The recursion runs on the unclamped log-amplitude so X stays N(0, σ_χ²) */
+    double current_log_amplitude = rho * channel->last_log_amplitude + 
                                    sqrt(1.0 - rho * rho) * white_noise;
+    channel->last_log_amplitude = current_log_amplitude;
     
-    /* Calculate log-normal fading: I = exp(2X - 2σ_χ²) */
-    double log_amplitude = 2.0 * current_log_amplitude - 2.0 * channel->rytov_variance;
-    double fading_coefficient = exp(log_amplitude);
-    
-    /* Clamp to reasonable range */
-    if (fading_coefficient < 0.01) {
-        fading_coefficient = 0.01;  /* -20 dB fade */
-    } else if (fading_coefficient > 100.0) {
-        fading_coefficient = 100.0;  /* +20 dB fade */
-    }
+    /* Map to the fading distribution (log-normal: I = exp(2X - 2σ_χ²)) */
+    double fading_coefficient = channel_fade_from_log_amplitude(channel, current_log_amplitude);
     
     /* Store in history buffer (circular buffer) */
     channel->fade_history[channel->history_index] = fading_coefficient;
@@ -513,6 +900,237 @@ double channel_generate_correlated_fading(ChannelModel* channel, double time_ste
     return fading_coefficient;
 }
 
+/**
+ * @brief Continue the fading process from a given log-amplitude
+ * 
+ * Same AR(1) step as channel_generate_correlated_fading(), from the
+ * caller's X rather than the channel state.
+ */
+double channel_continue_fade(const ChannelModel* channel, double* log_amplitude, double time_step) {
+    if (channel == NULL || !channel->initialized || log_amplitude == NULL) {
+        return 1.0;  /* No fading */
+    }
+    
+    if (channel->rytov_variance < 1e-6) {
+        return 1.0;
+    }
+    
+    double rho = exp(-time_step / channel->correlation_time);
+    double sigma_chi = sqrt(channel->rytov_variance);
+    double white_noise = fso_random_gaussian(0.0, sigma_chi);
+    
+    *log_amplitude = rho * *log_amplitude + sqrt(1.0 - rho * rho) * white_noise;
+    return channel_fade_from_log_amplitude(channel, *log_amplitude);
+}
+
+/**
+ * @brief Tilt the last fading sample for importance sampling
+ * 
+ * With X ~ f = N(0, σ²) and X' = X + m ~ g = N(m, σ²):
+ * log(f(X')/g(X')) = (m² - 2·m·X') / (2σ²)
+ */
+double channel_tilt_fade(const ChannelModel* channel, double shift, double* log_weight) {
+    if (log_weight != NULL) {
+        *log_weight = 0.0;
+    }
+    
+    if (channel == NULL || !channel->initialized) {
+        return 1.0;  /* No fading */
+    }
+    
+    if (channel->rytov_variance < 1e-6) {
+        return 1.0;
+    }
+    
+    double sigma_chi = sqrt(channel->rytov_variance);
+    double m = shift * sigma_chi;
+    double X = channel->last_log_amplitude + m;
+    
+    if (log_weight != NULL) {
+        *log_weight = (m * m - 2.0 * m * X) / (2.0 * channel->rytov_variance);
+    }
+    
+    /* Same mapping and clamp as the untilted sample */
+    return channel_fade_from_log_amplitude(channel, X);
+}
+
+/* ============================================================================
+ * Fade Trace Generation
+ * ============================================================================ */
+
+/**
+ * @brief Branch-free exp() for arguments inside the fade clamp range
+ * 
+ * Cody-Waite reduction x = k·ln2 + r with |r| <= ln2/2 and a degree-12
+ * Taylor polynomial (relative error below 2e-16). k is rounded with the
+ * 1.5·2^52 trick and 2^k is built from the exponent bits, so a loop over
+ * this function vectorizes. Valid for |x| < 700.
+ */
+static inline double trace_exp(double x) {
+    const double log2e = 1.4426950408889634;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+    const double round_magic = 6755399441055744.0;   /* 1.5 * 2^52 */
+    
+    double t = x * log2e + round_magic;
+    double k = t - round_magic;
+    double r = (x - k * ln2_hi) - k * ln2_lo;
+    
+    double p = 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+    
+    /* The low mantissa bits of t hold k; shift it into the exponent */
+    int64_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    int64_t scale_bits = (int64_t)((uint64_t)(bits + 1023) << 52);
+    double scale;
+    memcpy(&scale, &scale_bits, sizeof(scale));
+    
+    return p * scale;
+}
+
+/**
+ * @brief Run the AR(1) recursion over one chunk as a doubling scan
+ * 
+ * x[i] = ρ·x[i-1] + e[i] with x[-1] = carry. After the pass with stride
+ * d each entry holds the sum of its own and the preceding 2d - 1
+ * innovations, so log2(TRACE_CHUNK) contiguous, vectorizable passes
+ * replace the serial chain. The carry then enters through powers[i] = ρ^(i+1).
+ * 
+ * @param x Innovations on input, log-amplitudes on output
+ * @param tmp Scratch of len doubles
+ * @param len Chunk length (<= TRACE_CHUNK)
+ * @param powers ρ^(i+1) for i < TRACE_CHUNK
+ * @param carry Log-amplitude preceding the chunk
+ */
+static void trace_ar_scan(double* x, double* tmp, size_t len, const double* powers, double carry) {
+    double* src = x;
+    double* dst = tmp;
+    
+    for (size_t d = 1; d < len; d <<= 1) {
+        double rho_d = powers[d - 1];
+        for (size_t i = 0; i < d; i++) {
+            dst[i] = src[i];
+        }
+#ifdef _OPENMP
+        #pragma omp simd
+#endif
+        for (size_t i = d; i < len; i++) {
+            dst[i] = src[i] + rho_d * src[i - d];
+        }
+        double* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (size_t i = 0; i < len; i++) {
+        x[i] = src[i] + powers[i] * carry;
+    }
+}
+
+/**
+ * @brief Generate a correlated fading trace in bulk
+ * 
+ * Innovations are drawn TRACE_CHUNK at a time, the AR(1) recursion runs
+ * as a blocked scan and the log-normal mapping uses trace_exp(), with
+ * the clamp applied to the exponent so no sample can overflow. The
+ * gamma-gamma and Málaga models map through the inverse-CDF table.
+ */
+int channel_generate_fade_trace(ChannelModel* channel, double time_step, size_t n,
+                                double* output) {
+    FSO_CHECK_NULL(channel);
+    FSO_CHECK_NULL(output);
+    FSO_CHECK_PARAM(channel->initialized);
+    FSO_CHECK_PARAM(time_step > 0.0);
+    
+    if (n == 0) {
+        return FSO_SUCCESS;
+    }
+    
+    /* Same short-cut as the per-sample generators */
+    if (channel->rytov_variance < 1e-6) {
+        for (size_t i = 0; i < n; i++) {
+            output[i] = 1.0;
+        }
+        channel->last_fade_value = 1.0;
+        return FSO_SUCCESS;
+    }
+    
+    double rho = exp(-time_step / channel->correlation_time);
+    double sigma_chi = sqrt(channel->rytov_variance);
+    double innovation_scale = sqrt(1.0 - rho * rho) * sigma_chi;
+    double mean_offset = 2.0 * channel->rytov_variance;
+    double inv_sigma_chi = 1.0 / sigma_chi;
+    
+    double powers[TRACE_CHUNK];
+    powers[0] = rho;
+    for (int i = 1; i < TRACE_CHUNK; i++) {
+        powers[i] = powers[i - 1] * rho;
+    }
+    
+    double x[TRACE_CHUNK];
+    double tmp[TRACE_CHUNK];
+    double carry = channel->last_log_amplitude;
+    
+    for (size_t start = 0; start < n; start += TRACE_CHUNK) {
+        size_t len = (n - start < TRACE_CHUNK) ? n - start : TRACE_CHUNK;
+        double* out = output + start;
+        
+        /* Innovations come from the current stream in sample order, as
+         * with repeated channel_generate_correlated_fading() calls */
+        fso_random_gaussian_fill(x, len, innovation_scale);
+        trace_ar_scan(x, tmp, len, powers, carry);
+        carry = x[len - 1];
+        
+        if (channel->fading_model != CHANNEL_FADING_LOG_NORMAL && channel->icdf_table != NULL) {
+            for (size_t i = 0; i < len; i++) {
+                double log_fade = channel_icdf_lookup(channel->icdf_table, x[i] * inv_sigma_chi);
+                log_fade = log_fade < TRACE_LOG_FADE_MIN ? TRACE_LOG_FADE_MIN : log_fade;
+                log_fade = log_fade > TRACE_LOG_FADE_MAX ? TRACE_LOG_FADE_MAX : log_fade;
+                out[i] = trace_exp(log_fade);
+            }
+            continue;
+        }
+        
+#ifdef _OPENMP
+        #pragma omp simd
+#endif
+        for (size_t i = 0; i < len; i++) {
+            double log_fade = 2.0 * x[i] - mean_offset;
+            log_fade = log_fade < TRACE_LOG_FADE_MIN ? TRACE_LOG_FADE_MIN : log_fade;
+            log_fade = log_fade > TRACE_LOG_FADE_MAX ? TRACE_LOG_FADE_MAX : log_fade;
+            out[i] = trace_exp(log_fade);
+        }
+    }
+    
+    /* Leave the channel as if the samples had been drawn one by one */
+    channel->last_log_amplitude = carry;
+    channel->last_fade_value = output[n - 1];
+    size_t keep = (n < (size_t)channel->history_length) ? n : (size_t)channel->history_length;
+    channel->history_index = (int)(((size_t)channel->history_index + (n - keep)) %
+                                   (size_t)channel->history_length);
+    for (size_t i = n - keep; i < n; i++) {
+        channel->fade_history[channel->history_index] = output[i];
+        channel->history_index = (channel->history_index + 1) % channel->history_length;
+    }
+    
+    return FSO_SUCCESS;
+}
+
 /* ============================================================================
  * Attenuation Model Functions
  * ============================================================================ */
@@ -824,30 +1442,44 @@ double channel_apply_effects(ChannelModel* channel, double input_power,
         fading_coefficient = channel_generate_fading(channel);
     }
     
-    /* 2. Calculate total loss in dB */
-    /* Path loss (already calculated and cached) */
-    double total_loss_db = channel->path_loss_db;
-    
-    /* Weather attenuation (dB/km * distance_km) */
-    double distance_km = channel->link_distance / 1000.0;
-    total_loss_db += channel->attenuation_db * distance_km;
+    return channel_apply_fade(channel, input_power, fading_coefficient, noise_power);
+}
+
+/**
+ * @brief Apply channel effects with a precomputed fading coefficient
+ * 
+ * Loss and AWGN stages of channel_apply_effects(); reads the channel
+ * without modifying it.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param input_power Input signal power in watts
+ * @param fading_coefficient Fading coefficient for this interval
+ * @param noise_power Noise power in watts (0 for no noise)
+ * @return Received signal power in watts
+ */
+double channel_apply_fade(const ChannelModel* channel, double input_power,
+                          double fading_coefficient, double noise_power) {
+    if (channel == NULL || !channel->initialized) {
+        FSO_LOG_ERROR(MODULE_NAME, "Channel not initialized");
+        return 0.0;
+    }
     
-    /* Atmospheric absorption */
-    double absorption_db = channel_calculate_atmospheric_absorption(
-        channel->wavelength, channel->link_distance, channel->humidity);
-    total_loss_db += absorption_db;
+    if (input_power < 0.0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Invalid input power: %.2e W", input_power);
+        return 0.0;
+    }
     
-    /* 3. Convert total loss to linear scale */
-    double loss_linear = fso_db_to_linear(total_loss_db);
+    /* 2-4. Static loss, cached by channel_update_calculations() */
+    const ChannelLinkBudget* budget = &channel->link_budget;
     
-    /* 4. Calculate received signal power */
     /* P_rx = P_tx * h_fade / loss_linear */
-    double received_power = input_power * fading_coefficient / loss_linear;
+    double received_power = input_power * fading_coefficient / budget->loss_linear;
     
     /* 5. Add AWGN if specified */
     if (noise_power > 0.0) {
         /* Generate Gaussian noise with specified power */
-        double noise_stddev = sqrt(noise_power);
+        double noise_stddev = (noise_power == budget->noise_power) ?
+                              budget->noise_stddev : sqrt(noise_power);
         double noise_sample = fso_random_gaussian(0.0, noise_stddev);
         
         /* Add noise to received power (can be negative due to noise) */
@@ -859,10 +1491,10 @@ double channel_apply_effects(ChannelModel* channel, double input_power,
         }
     }
     
-    /* Log detailed information at debug level */
-    FSO_LOG_DEBUG(MODULE_NAME, 
+    /* Compiled out of release builds */
+    FSO_LOG_HOT(MODULE_NAME, 
         "Channel effects: P_in=%.2e W, fade=%.3f, loss=%.2f dB, P_out=%.2e W",
-        input_power, fading_coefficient, total_loss_db, received_power);
+        input_power, fading_coefficient, budget->total_loss_db, received_power);
     
     return received_power;
 }
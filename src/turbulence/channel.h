@@ -3,7 +3,7 @@
  * @brief Atmospheric turbulence channel modeling for FSO communications
  * 
  * This module implements realistic atmospheric channel effects including:
- * - Log-normal fading and scintillation
+ * - Log-normal, gamma-gamma and Málaga fading and scintillation
  * - Weather-based attenuation (fog, rain, snow)
  * - Path loss calculations
  * - Temporal correlation modeling
@@ -23,6 +23,40 @@
  * Channel Model Structures
  * ============================================================================ */
 
+/** Normal quantiles tabulated by the inverse-CDF fading table */
+#define CHANNEL_ICDF_POINTS 1025
+
+/** The table spans z in [-CHANNEL_ICDF_Z_MAX, CHANNEL_ICDF_Z_MAX] */
+#define CHANNEL_ICDF_Z_MAX 8.0
+
+/**
+ * @brief Irradiance fading distribution
+ * 
+ * Log-normal is valid for weak turbulence only. Gamma-gamma and Málaga
+ * cover the moderate-to-strong regimes; both take α and β from the
+ * Rytov variance.
+ */
+typedef enum {
+    CHANNEL_FADING_LOG_NORMAL = 0, /**< I = exp(2X - 2σ_χ²) */
+    CHANNEL_FADING_GAMMA_GAMMA,    /**< Product of Gamma(α) and Gamma(β) unit-mean variates */
+    CHANNEL_FADING_MALAGA          /**< Málaga (M): gamma large scale, shadowed-Rician small scale */
+} ChannelFadingModel;
+
+/**
+ * @brief Static part of the link budget
+ * 
+ * Everything in the received power except the fade and the noise draw,
+ * refreshed by channel_update_calculations() (and so by the
+ * channel_set_* setters) and only read per packet.
+ */
+typedef struct {
+    double absorption_db;        /**< Atmospheric absorption over the link in dB */
+    double total_loss_db;        /**< Path loss + weather attenuation + absorption in dB */
+    double loss_linear;          /**< Total static loss as a linear power ratio (>= 1) */
+    double noise_power;          /**< Noise power noise_stddev was computed for, in watts */
+    double noise_stddev;         /**< sqrt(noise_power) */
+} ChannelLinkBudget;
+
 /**
  * @brief Channel model state and configuration
  * 
@@ -50,12 +84,23 @@ typedef struct {
     int history_index;           /**< Current position in circular buffer */
     double correlation_time;     /**< Correlation time in seconds */
     double last_fade_value;      /**< Last generated fade value */
+    double last_log_amplitude;   /**< Log-amplitude X of the last sample (before clamping) */
+    
+    /* Fading distribution */
+    ChannelFadingModel fading_model; /**< Irradiance distribution (default log-normal) */
+    double gg_alpha;             /**< Large-scale scintillation parameter α */
+    double gg_beta;              /**< Small-scale scintillation parameter β (rounded for Málaga) */
+    double malaga_omega;         /**< Málaga LOS power Ω as a fraction of the mean (0-1) */
+    double malaga_rho;           /**< Málaga fraction of scattered power coupled to the LOS [0-1) */
+    double* icdf_table;          /**< ln I at CHANNEL_ICDF_POINTS normal quantiles (NULL for log-normal) */
+    double icdf_params[5];       /**< Model, α, β, Ω, ρ the table was built for */
     
     /* Cached calculations */
     double rytov_variance;       /**< Cached Rytov variance σ_χ² */
     double scintillation_index;  /**< Cached scintillation index σ_I² */
     double path_loss_db;         /**< Cached path loss in dB */
     double attenuation_db;       /**< Cached weather attenuation in dB */
+    ChannelLinkBudget link_budget; /**< Cached static loss for channel_apply_fade() */
     
     /* Random number generation */
     unsigned int rng_seed;       /**< Random number generator seed */
@@ -133,15 +178,74 @@ int channel_set_beam_divergence(ChannelModel* channel, double divergence);
 /**
  * @brief Update channel model calculations
  * 
- * Recalculates Rytov variance, scintillation index, path loss, and
- * attenuation based on current parameters. Should be called after
- * changing any channel parameters.
+ * Recalculates Rytov variance, scintillation index, path loss,
+ * attenuation and the link budget based on current parameters. Should be
+ * called after changing any channel parameters.
  * 
  * @param channel Pointer to channel model structure
  * @return FSO_SUCCESS on success, error code otherwise
  */
 int channel_update_calculations(ChannelModel* channel);
 
+/**
+ * @brief Select the irradiance fading distribution
+ * 
+ * Gamma-gamma and Málaga samples are drawn by mapping the same Gaussian
+ * state X as the log-normal model through a tabulated inverse CDF,
+ * I = F⁻¹(Φ(X/σ_χ)), so the AR(1) correlation, bulk traces and
+ * importance-sampling tilt work unchanged. The table is built by
+ * channel_update_calculations() whenever its parameters change.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param model Fading distribution
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int channel_set_fading_model(ChannelModel* channel, ChannelFadingModel model);
+
+/**
+ * @brief Set the Málaga line-of-sight parameters
+ * 
+ * @param channel Pointer to channel model structure
+ * @param omega LOS power Ω relative to the mean irradiance, in (0, 1)
+ *              (the scattered power 2b₀ is 1 - Ω)
+ * @param rho Fraction of the scattered power coupled to the LOS, in [0, 1)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int channel_set_malaga_params(ChannelModel* channel, double omega, double rho);
+
+/**
+ * @brief Cache the receiver noise power used by channel_apply_fade()
+ * 
+ * Optional: other noise powers still work, computing their standard
+ * deviation per call.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param noise_power Noise power in watts (>= 0)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int channel_set_noise_power(ChannelModel* channel, double noise_power);
+
+/**
+ * @brief Gamma-gamma α and β from the Rytov variance
+ * 
+ * Plane-wave expressions with σ_R² = 4σ_χ²:
+ * α = [exp(0.49σ_R² / (1 + 1.11σ_R^(12/5))^(7/6)) - 1]⁻¹
+ * β = [exp(0.51σ_R² / (1 + 0.69σ_R^(12/5))^(5/6)) - 1]⁻¹
+ * 
+ * @param rytov_variance Rytov variance σ_χ²
+ * @param alpha Output α
+ * @param beta Output β
+ */
+void channel_calculate_gamma_gamma_params(double rytov_variance, double* alpha, double* beta);
+
+/**
+ * @brief Get fading model name
+ * 
+ * @param model Fading distribution
+ * @return String name of fading model
+ */
+const char* channel_get_fading_model_name(ChannelFadingModel model);
+
 /**
  * @brief Free channel model resources
  * 
@@ -187,10 +291,10 @@ double channel_calculate_rytov_variance(double cn2, double wavelength, double di
 double channel_calculate_scintillation_index(double rytov_variance);
 
 /**
- * @brief Generate log-normal fading sample
+ * @brief Generate a fading sample
  * 
- * Generates a random fading coefficient from log-normal distribution
- * based on the scintillation index.
+ * Generates a random fading coefficient from the selected distribution
+ * (log-normal by default) based on the turbulence strength.
  * 
  * @param channel Pointer to channel model structure
  * @return Fading coefficient (linear scale)
@@ -210,6 +314,62 @@ double channel_generate_fading(ChannelModel* channel);
  */
 double channel_generate_correlated_fading(ChannelModel* channel, double time_step);
 
+/**
+ * @brief Continue the fading process from a given log-amplitude
+ * 
+ * One step of channel_generate_correlated_fading() taken from X instead
+ * of the channel's last sample, with the innovation drawn from the
+ * calling thread's generator. The channel is not modified, so a packet
+ * can follow its own fade forward in time (HARQ retransmissions) while
+ * other threads read the channel.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param log_amplitude Log-amplitude X at the start of the step; updated
+ *        to the new sample
+ * @param time_step Time step in seconds
+ * @return Fading coefficient at the end of the step (linear scale)
+ */
+double channel_continue_fade(const ChannelModel* channel, double* log_amplitude, double time_step);
+
+/**
+ * @brief Generate a temporally correlated fading trace in bulk
+ * 
+ * Produces the same AR(1) log-normal process as n successive
+ * channel_generate_correlated_fading() calls, drawing the innovations
+ * from the current random stream in the same order, and leaves the
+ * channel state as those calls would. Samples agree with the
+ * per-sample path to within rounding (~1e-15 relative). The recursion
+ * runs as a blocked scan and exp() is a vectorizable polynomial, so a
+ * long trace costs little more than its Gaussian draws; parallel
+ * workers can then index one precomputed trace.
+ * 
+ * @param channel Pointer to initialized channel model
+ * @param time_step Sample spacing in seconds (> 0)
+ * @param n Number of samples
+ * @param output Output trace of n fading coefficients (linear scale)
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int channel_generate_fade_trace(ChannelModel* channel, double time_step, size_t n,
+                                double* output);
+
+/**
+ * @brief Tilt the last fading sample for importance sampling
+ * 
+ * Shifts the log-amplitude of the most recent sample by shift·σ_χ and
+ * returns the resulting (clamped) fading coefficient. The channel state
+ * is not modified, so the fading process itself keeps its statistics.
+ * Since X is N(0, σ_χ²) at every time step, *log_weight is the marginal
+ * log-likelihood ratio log(f(X')/g(X')) of the shifted sample X'. A
+ * packet's error depends on its own fade only, so weighting by it gives
+ * unbiased per-packet averages even for the correlated process.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param shift Mean shift in units of σ_χ (negative = deeper fades)
+ * @param log_weight Output log-likelihood ratio (0 when there is no fading)
+ * @return Tilted fading coefficient (linear scale)
+ */
+double channel_tilt_fade(const ChannelModel* channel, double shift, double* log_weight);
+
 /**
  * @brief Calculate weather-based attenuation
  * 
@@ -275,6 +435,23 @@ double channel_calculate_atmospheric_absorption(double wavelength, double distan
 double channel_apply_effects(ChannelModel* channel, double input_power,
                              double noise_power, double time_step);
 
+/**
+ * @brief Apply channel effects with a precomputed fading coefficient
+ * 
+ * Same as channel_apply_effects() but leaves the fading state untouched,
+ * so packets can be processed in parallel once their fades are known.
+ * Reads the static loss from channel->link_budget; only the noise draw
+ * is computed per call.
+ * 
+ * @param channel Pointer to channel model structure
+ * @param input_power Input signal power in watts
+ * @param fading_coefficient Fading coefficient for this interval
+ * @param noise_power Noise power in watts (0 for no noise)
+ * @return Received signal power in watts
+ */
+double channel_apply_fade(const ChannelModel* channel, double input_power,
+                          double fading_coefficient, double noise_power);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -0,0 +1,384 @@
+/**
+ * @file phase_screen.c
+ * @brief Implementation of FFT turbulence phase screens
+ */
+
+#include "phase_screen.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Module name for logging */
+#define MODULE_NAME "PHASE_SCREEN"
+
+/* Kolmogorov phase spectrum constant and inner-scale cutoff (κm l0) */
+#define PSD_CONSTANT 0.023
+#define INNER_SCALE_CUTOFF 5.92
+
+/* ============================================================================
+ * Spectrum
+ * ============================================================================ */
+
+/**
+ * @brief Phase power spectral density at squared frequency f2 (cycles²/m²)
+ */
+static double phase_screen_psd(const PhaseScreenParams* params, double f2) {
+    double f0 = params->outer_scale > 0.0 ? 1.0 / params->outer_scale : 0.0;
+    double psd = PSD_CONSTANT * pow(params->r0, -5.0 / 3.0) *
+                 pow(f2 + f0 * f0, -11.0 / 6.0);
+    
+    if (params->inner_scale > 0.0) {
+        double fm = INNER_SCALE_CUTOFF / (2.0 * FSO_PI * params->inner_scale);
+        psd *= exp(-f2 / (fm * fm));
+    }
+    
+    return psd;
+}
+
+/**
+ * @brief Frequency of FFT bin index in cycles/m
+ */
+static double phase_screen_bin_frequency(size_t index, size_t size, double df) {
+    return (index < size / 2 ? (double)index : (double)index - (double)size) * df;
+}
+
+/**
+ * @brief Add subharmonic components to both screens of a draw
+ * 
+ * Level p puts a 3x3 grid of frequencies spaced Δκ/3^p around zero (the
+ * center excluded). Each frequency is separable, exp(i2π(fx x + fy y)), so
+ * a level costs three complex multiply-adds per pixel once the row sums
+ * are formed.
+ */
+static int phase_screen_add_subharmonics(PhaseScreen* screen, FSORandomStream* stream) {
+    const PhaseScreenParams* params = &screen->params;
+    size_t n = params->size;
+    double df = 1.0 / ((double)n * params->spacing);
+    
+    double complex* wave = (double complex*)malloc(n * sizeof(double complex));
+    if (wave == NULL) {
+        return FSO_ERROR_MEMORY;
+    }
+    
+    for (int level = 1; level <= params->subharmonics; level++) {
+        double dfp = df / pow(3.0, level);
+        
+        // Coefficients c[a][b] for fy = (a - 1) dfp, fx = (b - 1) dfp
+        double complex coeff[3][3];
+        double noise[18];
+        fso_random_stream_gaussian_fill(stream, noise, 18, 1.0);
+        for (int a = 0; a < 3; a++) {
+            for (int b = 0; b < 3; b++) {
+                double fy = (a - 1) * dfp;
+                double fx = (b - 1) * dfp;
+                double f2 = fx * fx + fy * fy;
+                double scale = f2 > 0.0 ? sqrt(phase_screen_psd(params, f2)) * dfp : 0.0;
+                coeff[a][b] = (noise[2 * (3 * a + b)] + I * noise[2 * (3 * a + b) + 1]) * scale;
+            }
+        }
+        
+        // exp(i2π dfp x) along a row; the same values serve the columns
+        for (size_t j = 0; j < n; j++) {
+            double x = ((double)j - (double)(n / 2)) * params->spacing;
+            wave[j] = cexp(I * 2.0 * FSO_PI * dfp * x);
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            double complex ey = wave[i];
+            double complex row[3];
+            for (int b = 0; b < 3; b++) {
+                row[b] = coeff[0][b] * conj(ey) + coeff[1][b] + coeff[2][b] * ey;
+            }
+            
+            double* phase = screen->phase + i * n;
+            double* spare = screen->spare + i * n;
+            for (size_t j = 0; j < n; j++) {
+                double complex value = row[0] * conj(wave[j]) + row[1] + row[2] * wave[j];
+                phase[j] += creal(value);
+                spare[j] += cimag(value);
+            }
+        }
+    }
+    
+    free(wave);
+    
+    // The FFT part has no DC bin; remove the subharmonics' piston
+    size_t total = n * n;
+    double phase_mean = 0.0;
+    double spare_mean = 0.0;
+    for (size_t k = 0; k < total; k++) {
+        phase_mean += screen->phase[k];
+        spare_mean += screen->spare[k];
+    }
+    phase_mean /= (double)total;
+    spare_mean /= (double)total;
+    for (size_t k = 0; k < total; k++) {
+        screen->phase[k] -= phase_mean;
+        screen->spare[k] -= spare_mean;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Draw a transform: two independent screens into phase and spare
+ */
+static int phase_screen_draw(PhaseScreen* screen) {
+    size_t n = screen->params.size;
+    size_t total = n * n;
+    
+    FSORandomStream stream;
+    fso_random_stream_init(&stream, screen->seed, screen->draws, FSO_RNG_STREAM_PHASE_SCREEN);
+    
+    // Complex white noise with unit-variance real and imaginary parts,
+    // shaped by the spectrum
+    fso_random_stream_gaussian_fill(&stream, (double*)screen->spectrum, 2 * total, 1.0);
+    for (size_t k = 0; k < total; k++) {
+        screen->spectrum[k] *= screen->filter[k];
+    }
+    
+    int result = sp_ifft2d(screen->sp, screen->spectrum, n, n);
+    if (result != FSO_SUCCESS) {
+        FSO_LOG_ERROR(MODULE_NAME, "Inverse FFT of %zux%zu screen failed", n, n);
+        return result;
+    }
+    
+    for (size_t k = 0; k < total; k++) {
+        screen->phase[k] = creal(screen->spectrum[k]);
+        screen->spare[k] = cimag(screen->spectrum[k]);
+    }
+    
+    if (screen->params.subharmonics > 0) {
+        result = phase_screen_add_subharmonics(screen, &stream);
+        if (result != FSO_SUCCESS) {
+            return result;
+        }
+    }
+    
+    screen->draws++;
+    screen->spare_ready = 1;
+    
+    return FSO_SUCCESS;
+}
+
+/* ============================================================================
+ * Phase Screen Functions
+ * ============================================================================ */
+
+void phase_screen_params_init(PhaseScreenParams* params, size_t size,
+                              double spacing, double r0) {
+    if (params == NULL) {
+        return;
+    }
+    
+    memset(params, 0, sizeof(PhaseScreenParams));
+    params->size = size;
+    params->spacing = spacing;
+    params->r0 = r0;
+    params->subharmonics = PHASE_SCREEN_DEFAULT_SUBHARMONICS;
+}
+
+double phase_screen_fried_parameter(double cn2, double wavelength, double distance) {
+    /* Wave number k = 2π/λ */
+    double k = 2.0 * FSO_PI / wavelength;
+    
+    return pow(0.423 * k * k * cn2 * distance, -3.0 / 5.0);
+}
+
+int phase_screen_init(PhaseScreen* screen, SignalProcessor* sp,
+                      const PhaseScreenParams* params, uint64_t seed) {
+    FSO_CHECK_NULL(screen);
+    FSO_CHECK_NULL(sp);
+    FSO_CHECK_NULL(params);
+    FSO_CHECK_PARAM(params->size >= PHASE_SCREEN_MIN_SIZE &&
+                    params->size <= PHASE_SCREEN_MAX_SIZE);
+    FSO_CHECK_PARAM((params->size & (params->size - 1)) == 0);
+    FSO_CHECK_PARAM(params->spacing > 0.0 && params->r0 > 0.0);
+    FSO_CHECK_PARAM(params->outer_scale >= 0.0 && params->inner_scale >= 0.0);
+    FSO_CHECK_PARAM(params->subharmonics >= 0 &&
+                    params->subharmonics <= PHASE_SCREEN_MAX_SUBHARMONICS);
+    
+    memset(screen, 0, sizeof(PhaseScreen));
+    screen->params = *params;
+    screen->sp = sp;
+    screen->seed = seed;
+    
+    size_t n = params->size;
+    size_t total = n * n;
+    screen->filter = (double*)malloc(total * sizeof(double));
+    screen->spectrum = (double complex*)fftw_malloc(total * sizeof(double complex));
+    screen->phase = (double*)malloc(total * sizeof(double));
+    screen->spare = (double*)malloc(total * sizeof(double));
+    if (screen->filter == NULL || screen->spectrum == NULL ||
+        screen->phase == NULL || screen->spare == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate %zux%zu screen", n, n);
+        phase_screen_free(screen);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    // sqrt(Φ_φ) Δκ per bin, times N² to undo the sp_ifft2d() normalization
+    double df = 1.0 / ((double)n * params->spacing);
+    double gain = (double)total;
+    for (size_t i = 0; i < n; i++) {
+        double fy = phase_screen_bin_frequency(i, n, df);
+        for (size_t j = 0; j < n; j++) {
+            double fx = phase_screen_bin_frequency(j, n, df);
+            double f2 = fx * fx + fy * fy;
+            screen->filter[i * n + j] = f2 > 0.0 ?
+                sqrt(phase_screen_psd(params, f2)) * df * gain : 0.0;
+        }
+    }
+    
+    screen->initialized = 1;
+    
+    int result = phase_screen_draw(screen);
+    if (result != FSO_SUCCESS) {
+        phase_screen_free(screen);
+        return result;
+    }
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "Initialized %zux%zu screen: %.3g m spacing, r0 %.3g m, "
+                  "%d subharmonic level(s)", n, n, params->spacing, params->r0,
+                  params->subharmonics);
+    
+    return FSO_SUCCESS;
+}
+
+void phase_screen_free(PhaseScreen* screen) {
+    if (screen == NULL) {
+        return;
+    }
+    
+    free(screen->filter);
+    if (screen->spectrum != NULL) {
+        fftw_free(screen->spectrum);
+    }
+    free(screen->phase);
+    free(screen->spare);
+    
+    memset(screen, 0, sizeof(PhaseScreen));
+}
+
+int phase_screen_generate(PhaseScreen* screen) {
+    FSO_CHECK_NULL(screen);
+    FSO_CHECK_PARAM(screen->initialized);
+    
+    screen->offset_x = 0.0;
+    screen->offset_y = 0.0;
+    
+    if (screen->spare_ready) {
+        double* next = screen->spare;
+        screen->spare = screen->phase;
+        screen->phase = next;
+        screen->spare_ready = 0;
+        return FSO_SUCCESS;
+    }
+    
+    return phase_screen_draw(screen);
+}
+
+void phase_screen_advance(PhaseScreen* screen, double time_step) {
+    if (screen == NULL || !screen->initialized) {
+        return;
+    }
+    
+    double period = (double)screen->params.size * screen->params.spacing;
+    
+    screen->offset_x = fmod(screen->offset_x + screen->params.wind_x * time_step, period);
+    screen->offset_y = fmod(screen->offset_y + screen->params.wind_y * time_step, period);
+    if (screen->offset_x < 0.0) {
+        screen->offset_x += period;
+    }
+    if (screen->offset_y < 0.0) {
+        screen->offset_y += period;
+    }
+}
+
+double phase_screen_sample(const PhaseScreen* screen, double x, double y) {
+    if (screen == NULL || !screen->initialized) {
+        return 0.0;
+    }
+    
+    size_t n = screen->params.size;
+    long size = (long)n;
+    
+    // The pattern moves with the wind, so a fixed point sees x - offset
+    double u = (x - screen->offset_x) / screen->params.spacing + (double)(n / 2);
+    double v = (y - screen->offset_y) / screen->params.spacing + (double)(n / 2);
+    double u_floor = floor(u);
+    double v_floor = floor(v);
+    double fu = u - u_floor;
+    double fv = v - v_floor;
+    
+    // Periodic grid: wrap both corners (n is a power of two)
+    long j0 = (long)u_floor & (size - 1);
+    long i0 = (long)v_floor & (size - 1);
+    long j1 = (j0 + 1) & (size - 1);
+    long i1 = (i0 + 1) & (size - 1);
+    
+    const double* row0 = screen->phase + (size_t)i0 * n;
+    const double* row1 = screen->phase + (size_t)i1 * n;
+    
+    double top = row0[j0] + fu * (row0[j1] - row0[j0]);
+    double bottom = row1[j0] + fu * (row1[j1] - row1[j0]);
+    
+    return top + fv * (bottom - top);
+}
+
+int phase_screen_aperture(const PhaseScreen* screen, double center_x, double center_y,
+                          double diameter, double wavelength,
+                          PhaseScreenAperture* aperture) {
+    FSO_CHECK_NULL(screen);
+    FSO_CHECK_NULL(aperture);
+    FSO_CHECK_PARAM(screen->initialized);
+    FSO_CHECK_PARAM(diameter > 0.0 && wavelength > 0.0);
+    
+    double spacing = screen->params.spacing;
+    
+    // Apertures under two grid points still fit a tilt over the 5-point cross
+    double radius = FSO_MAX(0.5 * diameter, spacing);
+    int extent = (int)floor(radius / spacing);
+    double radius_sq = radius * radius;
+    
+    // Points are symmetric about the center, so Σx = Σy = Σxy = 0 and the
+    // plane fit decouples into piston, x slope and y slope
+    double sum = 0.0, sum_sq = 0.0;
+    double sum_x = 0.0, sum_y = 0.0;
+    double moment = 0.0;
+    int samples = 0;
+    
+    for (int iy = -extent; iy <= extent; iy++) {
+        double dy = iy * spacing;
+        for (int ix = -extent; ix <= extent; ix++) {
+            double dx = ix * spacing;
+            if (dx * dx + dy * dy > radius_sq) {
+                continue;
+            }
+            
+            double phase = phase_screen_sample(screen, center_x + dx, center_y + dy);
+            sum += phase;
+            sum_sq += phase * phase;
+            sum_x += dx * phase;
+            sum_y += dy * phase;
+            moment += dx * dx;
+            samples++;
+        }
+    }
+    
+    double piston = sum / samples;
+    double slope_x = sum_x / moment;
+    double slope_y = sum_y / moment;
+    
+    double residual = sum_sq / samples - piston * piston -
+                      (slope_x * sum_x + slope_y * sum_y) / samples;
+    residual = FSO_MAX(residual, 0.0);
+    
+    aperture->tilt_x = slope_x * wavelength / (2.0 * FSO_PI);
+    aperture->tilt_y = slope_y * wavelength / (2.0 * FSO_PI);
+    aperture->piston = piston;
+    aperture->residual_variance = residual;
+    aperture->strehl = exp(-residual);
+    aperture->samples = samples;
+    
+    return FSO_SUCCESS;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file phase_screen.h
+ * @brief FFT turbulence phase screens for beam wander and aperture effects
+ * 
+ * Screens are Gaussian random phase fields with a Kolmogorov or von Kármán
+ * spectrum, drawn by filtering complex white noise in the frequency domain
+ * and inverse transforming with a SignalProcessor 2D FFT. The real and
+ * imaginary parts of one transform are two independent screens, so every
+ * other screen costs no FFT. A grid only holds frequencies down to
+ * 1/(N Δx); subharmonics add the missing low-order (tilt-dominant) part.
+ * 
+ * Frozen flow (Taylor's hypothesis) moves one large cached screen past the
+ * aperture at the wind velocity, so a time step costs one interpolated read
+ * per aperture pixel rather than a new screen.
+ * 
+ * Mathematical models:
+ * - Phase spectrum: Φ_φ(κ) = 0.023 r0^(-5/3) exp(-κ²/κm²) / (κ² + κ0²)^(11/6),
+ *   κ in cycles/m, κ0 = 1/L0, κm = 5.92/(2π l0)
+ * - Fried parameter (plane wave): r0 = (0.423 k² C_n² L)^(-3/5)
+ * - Structure function (Kolmogorov): D_φ(r) = 6.88 (r/r0)^(5/3)
+ */
+
+#ifndef PHASE_SCREEN_H
+#define PHASE_SCREEN_H
+
+#include "../fso.h"
+#include "../signal_processing/signal_processing.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <complex.h>
+
+/* ============================================================================
+ * Phase Screen Constants
+ * ============================================================================ */
+
+#define PHASE_SCREEN_MIN_SIZE 16            /**< Smallest grid side */
+#define PHASE_SCREEN_MAX_SIZE 4096          /**< Largest grid side */
+#define PHASE_SCREEN_DEFAULT_SUBHARMONICS 3 /**< Subharmonic levels (3^-p of the grid frequency) */
+#define PHASE_SCREEN_MAX_SUBHARMONICS 8     /**< Deepest subharmonic level */
+
+/* ============================================================================
+ * Phase Screen Structures
+ * ============================================================================ */
+
+/**
+ * @brief Screen statistics, grid and motion
+ * 
+ * size * spacing is the screen period: frozen flow wraps around it, so
+ * keep it well beyond the distance the wind covers between regenerations.
+ */
+typedef struct {
+    size_t size;                 /**< Grid points per side (power of two) */
+    double spacing;              /**< Grid spacing Δx in meters */
+    double r0;                   /**< Fried parameter in meters */
+    double outer_scale;          /**< Outer scale L0 in meters (0 = Kolmogorov) */
+    double inner_scale;          /**< Inner scale l0 in meters (0 = none) */
+    int subharmonics;            /**< Subharmonic levels (0 = FFT frequencies only) */
+    double wind_x;               /**< Frozen-flow velocity along x in m/s */
+    double wind_y;               /**< Frozen-flow velocity along y in m/s */
+} PhaseScreenParams;
+
+/**
+ * @brief Phase screen state
+ * 
+ * The grid is row-major with x along a row; screen coordinates are
+ * meters from the grid center. Draws come from the
+ * FSO_RNG_STREAM_PHASE_SCREEN stream with the draw index as packet word,
+ * so a (seed, index) pair always yields the same screen.
+ */
+typedef struct {
+    PhaseScreenParams params;    /**< Parameters the screen was built with */
+    SignalProcessor* sp;         /**< Processor running the 2D FFTs (borrowed) */
+    double* filter;              /**< sqrt(Φ_φ) Δκ per FFT bin, scaled for sp_ifft2d() */
+    double complex* spectrum;    /**< FFT work grid (size * size) */
+    double* phase;               /**< Current screen in radians (size * size) */
+    double* spare;               /**< Independent screen from the same transform */
+    int spare_ready;             /**< Non-zero while spare is unused */
+    uint64_t seed;               /**< Seed of the screen draws */
+    uint32_t draws;              /**< Transforms drawn so far */
+    double offset_x;             /**< Frozen-flow displacement along x in meters */
+    double offset_y;             /**< Frozen-flow displacement along y in meters */
+    int initialized;             /**< Non-zero once initialized */
+} PhaseScreen;
+
+/**
+ * @brief Wavefront over a circular aperture
+ */
+typedef struct {
+    double tilt_x;               /**< Angle of arrival along x in radians (least-squares tilt) */
+    double tilt_y;               /**< Angle of arrival along y in radians */
+    double piston;               /**< Mean phase in radians */
+    double residual_variance;    /**< Piston- and tilt-removed phase variance in rad² */
+    double strehl;               /**< Maréchal estimate exp(-residual_variance) */
+    int samples;                 /**< Grid points inside the aperture */
+} PhaseScreenAperture;
+
+/* ============================================================================
+ * Phase Screen Functions
+ * ============================================================================ */
+
+/**
+ * @brief Fill screen parameters with defaults
+ * 
+ * Kolmogorov spectrum, PHASE_SCREEN_DEFAULT_SUBHARMONICS levels, no wind.
+ * 
+ * @param params Parameters to fill
+ * @param size Grid points per side (power of two)
+ * @param spacing Grid spacing in meters
+ * @param r0 Fried parameter in meters
+ */
+void phase_screen_params_init(PhaseScreenParams* params, size_t size,
+                              double spacing, double r0);
+
+/**
+ * @brief Plane-wave Fried parameter of a uniform path
+ * 
+ * r0 = (0.423 k² C_n² L)^(-3/5), k = 2π/λ
+ * 
+ * @param cn2 Refractive index structure parameter (m^(-2/3))
+ * @param wavelength Optical wavelength in meters
+ * @param distance Path length in meters
+ * @return Fried parameter in meters
+ */
+double phase_screen_fried_parameter(double cn2, double wavelength, double distance);
+
+/**
+ * @brief Allocate a screen and draw its first realization
+ * 
+ * The spectral filter is computed once here; later draws only generate
+ * noise, scale it and run one inverse FFT.
+ * 
+ * @param screen Screen to initialize
+ * @param sp Initialized signal processor (must outlive the screen)
+ * @param params Screen parameters
+ * @param seed Seed of the screen draws
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int phase_screen_init(PhaseScreen* screen, SignalProcessor* sp,
+                      const PhaseScreenParams* params, uint64_t seed);
+
+/**
+ * @brief Free screen resources
+ * @param screen Screen to free
+ */
+void phase_screen_free(PhaseScreen* screen);
+
+/**
+ * @brief Replace the screen with an independent realization
+ * 
+ * Uses the spare screen of the last transform when there is one, so only
+ * every other call runs an FFT. Resets the frozen-flow offset.
+ * 
+ * @param screen Initialized screen
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int phase_screen_generate(PhaseScreen* screen);
+
+/**
+ * @brief Move the screen by the wind velocity over a time step
+ * 
+ * Frozen flow: the offset wraps around the screen period.
+ * 
+ * @param screen Initialized screen
+ * @param time_step Time step in seconds
+ */
+void phase_screen_advance(PhaseScreen* screen, double time_step);
+
+/**
+ * @brief Phase at a point, bilinearly interpolated
+ * 
+ * @param screen Initialized screen
+ * @param x Position along x in meters from the screen center
+ * @param y Position along y in meters from the screen center
+ * @return Phase in radians
+ */
+double phase_screen_sample(const PhaseScreen* screen, double x, double y);
+
+/**
+ * @brief Tilt and residual phase over a circular aperture
+ * 
+ * Least-squares plane fit over the grid points inside the aperture. The
+ * tilt is the angle of arrival (beam wander seen by the receiver):
+ * θ = (λ/2π) ∂φ/∂x. Costs O((diameter/spacing)²), no FFT.
+ * 
+ * @param screen Initialized screen
+ * @param center_x Aperture center along x in meters
+ * @param center_y Aperture center along y in meters
+ * @param diameter Aperture diameter in meters
+ * @param wavelength Optical wavelength in meters
+ * @param aperture Output wavefront statistics
+ * @return FSO_SUCCESS on success, error code otherwise
+ */
+int phase_screen_aperture(const PhaseScreen* screen, double center_x, double center_y,
+                          double diameter, double wavelength,
+                          PhaseScreenAperture* aperture);
+
+#endif /* PHASE_SCREEN_H */
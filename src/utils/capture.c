@@ -0,0 +1,354 @@
+/**
+ * @file capture.c
+ * @brief Recorded detector sample files
+ *
+ * Layout (host byte order):
+ *
+ *   header (64 bytes): "FSOCAP01", u32 byte-order mark 0x01020304,
+ *            u32 sample type, f64 sample rate, f64 timestamp,
+ *            u64 sample count (0 = up to the end of the file),
+ *            u32 header size, then zero padding
+ *   samples: back to back from the header size on
+ *
+ * Readers map the file instead of parsing it, so the receive chain reads
+ * samples straight out of the page cache.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "../fso.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MODULE_NAME "Capture"
+
+#define FSO_CAPTURE_MAGIC "FSOCAP01"
+#define FSO_CAPTURE_BYTE_ORDER 0x01020304u
+
+/* Header field offsets */
+#define FSO_CAPTURE_OFF_ORDER 8
+#define FSO_CAPTURE_OFF_TYPE 12
+#define FSO_CAPTURE_OFF_RATE 16
+#define FSO_CAPTURE_OFF_TIME 24
+#define FSO_CAPTURE_OFF_COUNT 32
+#define FSO_CAPTURE_OFF_HEADER 40
+
+size_t fso_capture_sample_size(FSOCaptureType type) {
+    switch (type) {
+        case FSO_CAPTURE_REAL_F64:
+            return sizeof(double);
+        case FSO_CAPTURE_REAL_F32:
+            return sizeof(float);
+        case FSO_CAPTURE_COMPLEX_F64:
+            return sizeof(ComplexSample);
+        default:
+            return 0;
+    }
+}
+
+/* ============================================================================
+ * Writer
+ * ============================================================================ */
+
+static void fso_capture_encode_header(const FSOCaptureInfo* info,
+                                      uint8_t header[FSO_CAPTURE_HEADER_SIZE]) {
+    uint32_t order = FSO_CAPTURE_BYTE_ORDER;
+    uint32_t type = (uint32_t)info->type;
+    uint32_t header_size = FSO_CAPTURE_HEADER_SIZE;
+
+    memset(header, 0, FSO_CAPTURE_HEADER_SIZE);
+    memcpy(header, FSO_CAPTURE_MAGIC, 8);
+    memcpy(header + FSO_CAPTURE_OFF_ORDER, &order, sizeof(order));
+    memcpy(header + FSO_CAPTURE_OFF_TYPE, &type, sizeof(type));
+    memcpy(header + FSO_CAPTURE_OFF_RATE, &info->sample_rate, sizeof(double));
+    memcpy(header + FSO_CAPTURE_OFF_TIME, &info->timestamp, sizeof(double));
+    memcpy(header + FSO_CAPTURE_OFF_COUNT, &info->num_samples, sizeof(uint64_t));
+    memcpy(header + FSO_CAPTURE_OFF_HEADER, &header_size, sizeof(header_size));
+}
+
+int fso_capture_writer_open(FSOCaptureWriter* writer, const char* path, FSOCaptureType type,
+                            double sample_rate, double timestamp) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(path);
+    FSO_CHECK_PARAM(fso_capture_sample_size(type) > 0);
+    FSO_CHECK_PARAM(sample_rate > 0.0);
+
+    memset(writer, 0, sizeof(FSOCaptureWriter));
+    writer->info.type = type;
+    writer->info.sample_rate = sample_rate;
+    writer->info.timestamp = timestamp;
+
+    writer->fp = fopen(path, "wb");
+    if (writer->fp == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to create capture file: %s", path);
+        return FSO_ERROR_IO;
+    }
+
+    // Count 0 until close, so a cut-short file is sized from its length
+    uint8_t header[FSO_CAPTURE_HEADER_SIZE];
+    fso_capture_encode_header(&writer->info, header);
+    if (fwrite(header, 1, sizeof(header), writer->fp) != sizeof(header)) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to write capture header: %s", path);
+        fclose(writer->fp);
+        writer->fp = NULL;
+        return FSO_ERROR_IO;
+    }
+
+    return FSO_SUCCESS;
+}
+
+int fso_capture_writer_append(FSOCaptureWriter* writer, const void* samples, size_t count) {
+    FSO_CHECK_NULL(writer);
+    FSO_CHECK_NULL(writer->fp);
+    FSO_CHECK_NULL(samples);
+
+    if (writer->error != FSO_SUCCESS) {
+        return writer->error;
+    }
+
+    size_t sample_size = fso_capture_sample_size(writer->info.type);
+    if (fwrite(samples, sample_size, count, writer->fp) != count) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to write capture samples");
+        writer->error = FSO_ERROR_IO;
+        return writer->error;
+    }
+    writer->info.num_samples += count;
+
+    return FSO_SUCCESS;
+}
+
+int fso_capture_writer_close(FSOCaptureWriter* writer) {
+    FSO_CHECK_NULL(writer);
+
+    if (writer->fp == NULL) {
+        return writer->error;
+    }
+
+    if (writer->error == FSO_SUCCESS) {
+        uint8_t header[FSO_CAPTURE_HEADER_SIZE];
+        fso_capture_encode_header(&writer->info, header);
+        if (fseek(writer->fp, 0, SEEK_SET) != 0 ||
+            fwrite(header, 1, sizeof(header), writer->fp) != sizeof(header)) {
+            FSO_LOG_ERROR(MODULE_NAME, "Failed to finalize capture header");
+            writer->error = FSO_ERROR_IO;
+        }
+    }
+    if (fclose(writer->fp) != 0 && writer->error == FSO_SUCCESS) {
+        writer->error = FSO_ERROR_IO;
+    }
+    writer->fp = NULL;
+
+    return writer->error;
+}
+
+/* ============================================================================
+ * Reader
+ * ============================================================================ */
+
+#ifndef _WIN32
+
+/**
+ * @brief Page-aligned byte range of samples [first, first + count)
+ *
+ * inward selects the pages entirely inside the range, otherwise every
+ * page the range touches. Returns 0 when the range covers no page.
+ */
+static size_t fso_capture_page_range(const FSOCaptureReader* reader, size_t first, size_t count,
+                                     int inward, uint8_t** start) {
+    if (reader->map == NULL || first >= reader->info.num_samples) {
+        return 0;
+    }
+    count = FSO_MIN(count, (size_t)reader->info.num_samples - first);
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin = (size_t)(reader->samples - reader->map) + first * reader->sample_size;
+    size_t end = begin + count * reader->sample_size;
+    if (inward) {
+        begin = (begin + page - 1) / page * page;
+        end = end / page * page;
+    } else {
+        begin = begin / page * page;
+        end = FSO_MIN((end + page - 1) / page * page, reader->map_size);
+    }
+    if (end <= begin) {
+        return 0;
+    }
+
+    *start = reader->map + begin;
+    return end - begin;
+}
+
+int fso_capture_open(FSOCaptureReader* reader, const char* path) {
+    FSO_CHECK_NULL(reader);
+    FSO_CHECK_NULL(path);
+
+    memset(reader, 0, sizeof(FSOCaptureReader));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to open capture file: %s", path);
+        return FSO_ERROR_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < FSO_CAPTURE_HEADER_SIZE) {
+        FSO_LOG_ERROR(MODULE_NAME, "Not a capture file (too short): %s", path);
+        close(fd);
+        return FSO_ERROR_IO;
+    }
+
+    // Private writable mapping: views may be edited in place, copy-on-write
+    size_t map_size = (size_t)st.st_size;
+    void* map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to map capture file: %s", path);
+        return FSO_ERROR_IO;
+    }
+
+    const uint8_t* header = (const uint8_t*)map;
+    uint32_t order, type, header_size;
+    FSOCaptureInfo info;
+    memcpy(&order, header + FSO_CAPTURE_OFF_ORDER, sizeof(order));
+    memcpy(&type, header + FSO_CAPTURE_OFF_TYPE, sizeof(type));
+    memcpy(&info.sample_rate, header + FSO_CAPTURE_OFF_RATE, sizeof(double));
+    memcpy(&info.timestamp, header + FSO_CAPTURE_OFF_TIME, sizeof(double));
+    memcpy(&info.num_samples, header + FSO_CAPTURE_OFF_COUNT, sizeof(uint64_t));
+    memcpy(&header_size, header + FSO_CAPTURE_OFF_HEADER, sizeof(header_size));
+    info.type = (FSOCaptureType)type;
+
+    int result = FSO_SUCCESS;
+    size_t sample_size = fso_capture_sample_size(info.type);
+    if (memcmp(header, FSO_CAPTURE_MAGIC, 8) != 0) {
+        FSO_LOG_ERROR(MODULE_NAME, "Not a capture file: %s", path);
+        result = FSO_ERROR_IO;
+    } else if (order != FSO_CAPTURE_BYTE_ORDER) {
+        FSO_LOG_ERROR(MODULE_NAME, "Capture written with another byte order: %s", path);
+        result = FSO_ERROR_UNSUPPORTED;
+    } else if (sample_size == 0 || !(info.sample_rate > 0.0) ||
+               header_size < FSO_CAPTURE_HEADER_SIZE || header_size % sizeof(double) != 0 ||
+               header_size > map_size) {
+        FSO_LOG_ERROR(MODULE_NAME, "Corrupt capture header: %s", path);
+        result = FSO_ERROR_IO;
+    }
+    if (result != FSO_SUCCESS) {
+        munmap(map, map_size);
+        return result;
+    }
+
+    // A count of 0 (writer never closed) or past the end: size from the file
+    uint64_t available = (map_size - header_size) / sample_size;
+    if (info.num_samples == 0 || info.num_samples > available) {
+        if (info.num_samples > available) {
+            FSO_LOG_WARNING(MODULE_NAME, "Capture truncated: %llu of %llu samples present",
+                            (unsigned long long)available,
+                            (unsigned long long)info.num_samples);
+        }
+        info.num_samples = available;
+    }
+
+    reader->info = info;
+    reader->map = (uint8_t*)map;
+    reader->map_size = map_size;
+    reader->samples = reader->map + header_size;
+    reader->sample_size = sample_size;
+
+    madvise(map, map_size, MADV_SEQUENTIAL);
+
+    FSO_LOG_INFO(MODULE_NAME, "Mapped %s: %llu samples at %.3f MHz",
+                 path, (unsigned long long)info.num_samples, info.sample_rate / 1e6);
+
+    return FSO_SUCCESS;
+}
+
+void fso_capture_close(FSOCaptureReader* reader) {
+    if (reader == NULL) {
+        return;
+    }
+
+    if (reader->map != NULL) {
+        munmap(reader->map, reader->map_size);
+    }
+    memset(reader, 0, sizeof(FSOCaptureReader));
+}
+
+void fso_capture_prefetch(const FSOCaptureReader* reader, size_t first, size_t count) {
+    uint8_t* start;
+    size_t length = (reader != NULL) ? fso_capture_page_range(reader, first, count, 0, &start) : 0;
+    if (length > 0) {
+        madvise(start, length, MADV_WILLNEED);
+    }
+}
+
+void fso_capture_release(const FSOCaptureReader* reader, size_t first, size_t count) {
+    uint8_t* start;
+    size_t length = (reader != NULL) ? fso_capture_page_range(reader, first, count, 1, &start) : 0;
+    if (length > 0) {
+        madvise(start, length, MADV_DONTNEED);
+    }
+}
+
+#else
+
+int fso_capture_open(FSOCaptureReader* reader, const char* path) {
+    (void)path;
+    FSO_CHECK_NULL(reader);
+
+    memset(reader, 0, sizeof(FSOCaptureReader));
+    FSO_LOG_ERROR(MODULE_NAME, "Capture replay needs mmap (not available on Windows)");
+    return FSO_ERROR_UNSUPPORTED;
+}
+
+void fso_capture_close(FSOCaptureReader* reader) {
+    if (reader != NULL) {
+        memset(reader, 0, sizeof(FSOCaptureReader));
+    }
+}
+
+void fso_capture_prefetch(const FSOCaptureReader* reader, size_t first, size_t count) {
+    (void)reader;
+    (void)first;
+    (void)count;
+}
+
+void fso_capture_release(const FSOCaptureReader* reader, size_t first, size_t count) {
+    (void)reader;
+    (void)first;
+    (void)count;
+}
+
+#endif /* _WIN32 */
+
+const void* fso_capture_samples(const FSOCaptureReader* reader, size_t first) {
+    if (reader == NULL || reader->map == NULL || first >= reader->info.num_samples) {
+        return NULL;
+    }
+    return reader->samples + first * reader->sample_size;
+}
+
+int fso_capture_view(const FSOCaptureReader* reader, size_t first, size_t count,
+                     SignalBuffer* view) {
+    FSO_CHECK_NULL(reader);
+    FSO_CHECK_NULL(reader->map);
+    FSO_CHECK_NULL(view);
+    FSO_CHECK_PARAM(first < reader->info.num_samples);
+
+    if (reader->info.type != FSO_CAPTURE_COMPLEX_F64) {
+        FSO_LOG_ERROR(MODULE_NAME, "SignalBuffer views need a complex capture");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+
+    view->samples = (ComplexSample*)(reader->samples + first * reader->sample_size);
+    view->length = FSO_MIN(count, (size_t)reader->info.num_samples - first);
+    view->sample_rate = reader->info.sample_rate;
+    view->timestamp = reader->info.timestamp + (double)first / reader->info.sample_rate;
+
+    return FSO_SUCCESS;
+}
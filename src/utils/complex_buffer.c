@@ -0,0 +1,164 @@
+/**
+ * @file complex_buffer.c
+ * @brief Aligned complex sample buffers
+ *
+ * An FSOComplexBuffer keeps its samples either interleaved, binary
+ * compatible with ComplexSample, double complex and fftw_complex, or as
+ * two split planes. Storage is a single FSO_BUFFER_ALIGN-aligned block;
+ * in split layout the imaginary plane starts at the first aligned offset
+ * after the real plane.
+ */
+
+#include "../fso.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MODULE_NAME "ComplexBuffer"
+
+/* Doubles per alignment unit */
+#define FSO_BUFFER_ALIGN_DOUBLES (FSO_BUFFER_ALIGN / sizeof(double))
+
+/**
+ * @brief Round a sample count up to a whole number of alignment units
+ */
+static size_t fso_buffer_plane_length(size_t capacity) {
+    return (capacity + FSO_BUFFER_ALIGN_DOUBLES - 1) & ~(FSO_BUFFER_ALIGN_DOUBLES - 1);
+}
+
+/**
+ * @brief Allocate storage for capacity samples and point the planes into it
+ */
+static int fso_buffer_allocate(FSOComplexBuffer* buffer, size_t capacity,
+                               FSOComplexLayout layout) {
+    size_t plane = fso_buffer_plane_length(capacity > 0 ? capacity : 1);
+    double* storage = (double*)aligned_alloc(FSO_BUFFER_ALIGN, 2 * plane * sizeof(double));
+    if (storage == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to allocate %zu-sample buffer", capacity);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    buffer->layout = layout;
+    buffer->capacity = capacity;
+    buffer->storage = storage;
+    buffer->real = storage;
+    if (layout == FSO_LAYOUT_SPLIT) {
+        buffer->imag = storage + plane;
+        buffer->stride = 1;
+    } else {
+        buffer->imag = storage + 1;
+        buffer->stride = 2;
+    }
+    
+    return FSO_SUCCESS;
+}
+
+int fso_complex_buffer_init(FSOComplexBuffer* buffer, size_t capacity,
+                            FSOComplexLayout layout) {
+    FSO_CHECK_NULL(buffer);
+    FSO_CHECK_PARAM(layout == FSO_LAYOUT_INTERLEAVED || layout == FSO_LAYOUT_SPLIT);
+    
+    memset(buffer, 0, sizeof(FSOComplexBuffer));
+    return fso_buffer_allocate(buffer, capacity, layout);
+}
+
+void fso_complex_buffer_wrap(FSOComplexBuffer* buffer, ComplexSample* samples,
+                             size_t length) {
+    if (buffer == NULL) {
+        return;
+    }
+    
+    buffer->layout = FSO_LAYOUT_INTERLEAVED;
+    buffer->length = length;
+    buffer->capacity = length;
+    buffer->stride = 2;
+    buffer->real = (double*)samples;
+    buffer->imag = (samples != NULL) ? (double*)samples + 1 : NULL;
+    buffer->storage = NULL;
+}
+
+void fso_complex_buffer_free(FSOComplexBuffer* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+    
+    free(buffer->storage);
+    memset(buffer, 0, sizeof(FSOComplexBuffer));
+}
+
+ComplexSample* fso_complex_buffer_samples(const FSOComplexBuffer* buffer) {
+    if (buffer == NULL || buffer->layout != FSO_LAYOUT_INTERLEAVED) {
+        return NULL;
+    }
+    return (ComplexSample*)buffer->real;
+}
+
+int fso_complex_buffer_set_layout(FSOComplexBuffer* buffer, FSOComplexLayout layout) {
+    FSO_CHECK_NULL(buffer);
+    FSO_CHECK_PARAM(layout == FSO_LAYOUT_INTERLEAVED || layout == FSO_LAYOUT_SPLIT);
+    
+    if (buffer->layout == layout) {
+        return FSO_SUCCESS;
+    }
+    if (buffer->storage == NULL) {
+        FSO_LOG_ERROR(MODULE_NAME, "Cannot change the layout of a wrapped buffer");
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    
+    FSOComplexBuffer converted = {0};
+    int result = fso_buffer_allocate(&converted, buffer->capacity, layout);
+    if (result != FSO_SUCCESS) {
+        return result;
+    }
+    
+    const size_t in = buffer->stride;
+    const size_t out = converted.stride;
+    for (size_t i = 0; i < buffer->length; i++) {
+        converted.real[i * out] = buffer->real[i * in];
+        converted.imag[i * out] = buffer->imag[i * in];
+    }
+    converted.length = buffer->length;
+    
+    free(buffer->storage);
+    *buffer = converted;
+    
+    return FSO_SUCCESS;
+}
+
+int fso_complex_buffer_import(FSOComplexBuffer* buffer, const ComplexSample* samples,
+                              size_t length) {
+    FSO_CHECK_NULL(buffer);
+    FSO_CHECK_NULL(samples);
+    FSO_CHECK_PARAM(length <= buffer->capacity);
+    
+    if (buffer->layout == FSO_LAYOUT_INTERLEAVED) {
+        if ((const double*)samples != buffer->real) {
+            memmove(buffer->real, samples, length * sizeof(ComplexSample));
+        }
+    } else {
+        for (size_t i = 0; i < length; i++) {
+            buffer->real[i] = samples[i].real;
+            buffer->imag[i] = samples[i].imag;
+        }
+    }
+    buffer->length = length;
+    
+    return FSO_SUCCESS;
+}
+
+int fso_complex_buffer_export(const FSOComplexBuffer* buffer, ComplexSample* samples) {
+    FSO_CHECK_NULL(buffer);
+    FSO_CHECK_NULL(samples);
+    
+    if (buffer->layout == FSO_LAYOUT_INTERLEAVED) {
+        if ((double*)samples != buffer->real) {
+            memmove(samples, buffer->real, buffer->length * sizeof(ComplexSample));
+        }
+    } else {
+        for (size_t i = 0; i < buffer->length; i++) {
+            samples[i].real = buffer->real[i];
+            samples[i].imag = buffer->imag[i];
+        }
+    }
+    
+    return FSO_SUCCESS;
+}
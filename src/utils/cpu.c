@@ -0,0 +1,187 @@
+/**
+ * @file cpu.c
+ * @brief Run-time CPU feature detection for the SIMD kernel tables
+ *
+ * Features are probed once, on first use. Modules with ISA-specific
+ * kernels keep one table of function pointers per family and pick a table
+ * through fso_cpu_simd_level(), so a binary built for the baseline ISA
+ * runs the widest variant each machine supports.
+ */
+
+#include "../fso.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdatomic.h>
+
+#define MODULE_NAME "CPU"
+
+/* Every AVX-512 variant needs all three */
+#define FSO_CPU_AVX512_SET (FSO_CPU_AVX512F | FSO_CPU_AVX512BW | FSO_CPU_AVX512VL)
+
+static const char* const cpu_level_names[FSO_SIMD_LEVELS] = {
+    "scalar", "sse4.2", "avx2", "avx512", "neon"
+};
+
+static atomic_uint cpu_features;
+static atomic_int cpu_best = -1;     /* -1 until probed */
+static atomic_int cpu_level = -1;    /* -1 until probed or set */
+
+static unsigned int cpu_detect_features(void) {
+    unsigned int features = 0;
+    
+#if FSO_HAVE_X86_SIMD
+    // libgcc checks XCR0, so AVX and AVX-512 count only if the OS saves their state
+    __builtin_cpu_init();
+    features |= __builtin_cpu_supports("sse2") ? FSO_CPU_SSE2 : 0;
+    features |= __builtin_cpu_supports("ssse3") ? FSO_CPU_SSSE3 : 0;
+    features |= __builtin_cpu_supports("sse4.2") ? FSO_CPU_SSE42 : 0;
+    features |= __builtin_cpu_supports("popcnt") ? FSO_CPU_POPCNT : 0;
+    features |= __builtin_cpu_supports("avx2") ? FSO_CPU_AVX2 : 0;
+    features |= __builtin_cpu_supports("fma") ? FSO_CPU_FMA : 0;
+    features |= __builtin_cpu_supports("avx512f") ? FSO_CPU_AVX512F : 0;
+    features |= __builtin_cpu_supports("avx512bw") ? FSO_CPU_AVX512BW : 0;
+    features |= __builtin_cpu_supports("avx512vl") ? FSO_CPU_AVX512VL : 0;
+#elif FSO_HAVE_NEON
+    // Advanced SIMD is mandatory on AArch64
+    features |= FSO_CPU_NEON;
+#endif
+    
+    return features;
+}
+
+static FSOSimdLevel cpu_level_for(unsigned int features) {
+    if ((features & FSO_CPU_AVX512_SET) == FSO_CPU_AVX512_SET && (features & FSO_CPU_POPCNT)) {
+        return FSO_SIMD_AVX512;
+    }
+    if ((features & FSO_CPU_AVX2) && (features & FSO_CPU_POPCNT)) {
+        return FSO_SIMD_AVX2;
+    }
+    if ((features & FSO_CPU_SSE42) && (features & FSO_CPU_POPCNT)) {
+        return FSO_SIMD_SSE42;
+    }
+    if (features & FSO_CPU_NEON) {
+        return FSO_SIMD_NEON;
+    }
+    return FSO_SIMD_SCALAR;
+}
+
+/**
+ * @brief Whether a CPU whose widest family is best can run level
+ */
+static int cpu_level_runs(FSOSimdLevel best, FSOSimdLevel level) {
+    if (level == FSO_SIMD_SCALAR) {
+        return 1;
+    }
+    if (level == FSO_SIMD_NEON || best == FSO_SIMD_NEON) {
+        return level == best;
+    }
+    return level <= best;
+}
+
+/**
+ * @brief Probe once; racing first callers compute the same values
+ */
+static void cpu_probe(void) {
+    if (atomic_load_explicit(&cpu_best, memory_order_acquire) >= 0) {
+        return;
+    }
+    
+    unsigned int features = cpu_detect_features();
+    FSOSimdLevel best = cpu_level_for(features);
+    FSOSimdLevel level = best;
+    
+    const char* requested = getenv("FSO_SIMD");
+    if (requested != NULL && requested[0] != '\0') {
+        FSOSimdLevel cap;
+        if (fso_cpu_parse_simd_level(requested, &cap) != FSO_SUCCESS) {
+            FSO_LOG_WARNING(MODULE_NAME, "Ignoring unknown FSO_SIMD=%s", requested);
+        } else if (cpu_level_runs(best, cap)) {
+            level = cap;
+        } else {
+            FSO_LOG_WARNING(MODULE_NAME, "FSO_SIMD=%s is not supported here, using %s",
+                            requested, cpu_level_names[best]);
+        }
+    }
+    
+    atomic_store_explicit(&cpu_features, features, memory_order_relaxed);
+    int unset = -1;
+    atomic_compare_exchange_strong(&cpu_level, &unset, (int)level);
+    atomic_store_explicit(&cpu_best, (int)best, memory_order_release);
+    
+    FSO_LOG_DEBUG(MODULE_NAME, "CPU features 0x%x, kernels: %s", features,
+                  cpu_level_names[level]);
+}
+
+unsigned int fso_cpu_features(void) {
+    cpu_probe();
+    return atomic_load_explicit(&cpu_features, memory_order_relaxed);
+}
+
+FSOSimdLevel fso_cpu_best_level(void) {
+    cpu_probe();
+    return (FSOSimdLevel)atomic_load_explicit(&cpu_best, memory_order_relaxed);
+}
+
+FSOSimdLevel fso_cpu_simd_level(void) {
+    int level = atomic_load_explicit(&cpu_level, memory_order_relaxed);
+    if (level < 0) {
+        cpu_probe();
+        level = atomic_load_explicit(&cpu_level, memory_order_relaxed);
+    }
+    return (FSOSimdLevel)level;
+}
+
+int fso_cpu_simd_supported(FSOSimdLevel level) {
+    if (level < FSO_SIMD_SCALAR || level >= FSO_SIMD_LEVELS) {
+        return 0;
+    }
+    return cpu_level_runs(fso_cpu_best_level(), level);
+}
+
+int fso_cpu_set_simd_level(FSOSimdLevel level) {
+    FSO_CHECK_PARAM(level >= FSO_SIMD_SCALAR && level < FSO_SIMD_LEVELS);
+    
+    if (!fso_cpu_simd_supported(level)) {
+        FSO_LOG_ERROR(MODULE_NAME, "%s kernels are not supported on this CPU",
+                      cpu_level_names[level]);
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    
+    atomic_store_explicit(&cpu_level, (int)level, memory_order_relaxed);
+    return FSO_SUCCESS;
+}
+
+const char* fso_cpu_simd_name(FSOSimdLevel level) {
+    if (level < FSO_SIMD_SCALAR || level >= FSO_SIMD_LEVELS) {
+        return "unknown";
+    }
+    return cpu_level_names[level];
+}
+
+int fso_cpu_parse_simd_level(const char* name, FSOSimdLevel* level) {
+    FSO_CHECK_NULL(name);
+    FSO_CHECK_NULL(level);
+    
+    char lower[16];
+    size_t length = strlen(name);
+    if (length >= sizeof(lower)) {
+        return FSO_ERROR_INVALID_PARAM;
+    }
+    for (size_t i = 0; i <= length; i++) {
+        lower[i] = (char)tolower((unsigned char)name[i]);
+    }
+    
+    for (int i = 0; i < FSO_SIMD_LEVELS; i++) {
+        if (strcmp(lower, cpu_level_names[i]) == 0) {
+            *level = (FSOSimdLevel)i;
+            return FSO_SUCCESS;
+        }
+    }
+    if (strcmp(lower, "sse42") == 0) {
+        *level = FSO_SIMD_SSE42;
+        return FSO_SUCCESS;
+    }
+    
+    return FSO_ERROR_INVALID_PARAM;
+}
@@ -1,9 +1,35 @@
 /**
  * @file logging.c
  * @brief Implementation of logging system for FSO Communication Suite
+ * 
+ * Messages are written to stderr synchronously by default. The
+ * asynchronous mode gives each logging thread a lock-free ring that one
+ * background thread drains, so parallel workers never serialize on the
+ * stream.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "../fso.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#define FSO_LOG_HAVE_THREADS 1
+#endif
+
+/* Asynchronous logging limits */
+#define FSO_LOG_RING_SLOTS 256        /* Records per thread ring (power of two) */
+#define FSO_LOG_MODULE_MAX 24         /* Module name bytes kept per record */
+#define FSO_LOG_TEXT_MAX 232          /* Message bytes kept per record */
+#define FSO_LOG_LINE_MAX 1024         /* Message bytes in synchronous mode */
+#define FSO_LOG_IDLE_NS 1000000L      /* Flusher sleep when every ring is empty */
+
+static const char* const fso_log_level_names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
 
 /**
  * @brief Global log level - can be set by user to filter messages
@@ -52,3 +78,310 @@ const char* fso_error_string(FSOErrorCode error_code) {
             return "Unknown error";
     }
 }
+
+/* ============================================================================
+ * Timestamps
+ * ============================================================================ */
+
+/**
+ * @brief Formatted wall-clock second, reused until the second changes
+ */
+typedef struct {
+    time_t second;               /**< Second the text was formatted for */
+    char text[32];               /**< "YYYY-mm-dd HH:MM:SS" */
+} FSOLogClock;
+
+/**
+ * @brief Timestamp text for a wall-clock second
+ * 
+ * localtime() and strftime() run once per second per clock instead of
+ * once per message.
+ */
+static const char* fso_log_format_time(FSOLogClock* clock, time_t second) {
+    if (clock->text[0] == '\0' || second != clock->second) {
+        struct tm tm_info;
+#ifdef _WIN32
+        localtime_s(&tm_info, &second);
+#else
+        localtime_r(&second, &tm_info);
+#endif
+        strftime(clock->text, sizeof(clock->text), "%Y-%m-%d %H:%M:%S", &tm_info);
+        clock->second = second;
+    }
+    return clock->text;
+}
+
+static void fso_log_write_line(FILE* stream, const char* timestamp, LogLevel level,
+                               const char* module, const char* text) {
+    fprintf(stream, "[%s] [%s] [%s] %s\n", timestamp, fso_log_level_names[level], module, text);
+}
+
+/* ============================================================================
+ * Asynchronous Logging
+ * ============================================================================ */
+
+#ifdef FSO_LOG_HAVE_THREADS
+
+/**
+ * @brief One queued message
+ */
+typedef struct {
+    uint64_t time_ns;                    /**< CLOCK_MONOTONIC timestamp */
+    LogLevel level;                      /**< Log level */
+    char module[FSO_LOG_MODULE_MAX];     /**< Module name (truncated) */
+    char text[FSO_LOG_TEXT_MAX];         /**< Formatted message (truncated) */
+} FSOLogRecord;
+
+/**
+ * @brief Single-producer/single-consumer record ring of one thread
+ * 
+ * tail is written only by the owning thread and head only by the
+ * flusher. Rings are pushed onto a list on first use and freed by
+ * fso_log_async_stop().
+ */
+typedef struct FSOLogRing {
+    _Alignas(64) atomic_size_t head;     /**< Next record to write out (flusher) */
+    _Alignas(64) atomic_size_t tail;     /**< Next free record (owning thread) */
+    struct FSOLogRing* next;             /**< Next registered ring */
+    FSOLogRecord records[FSO_LOG_RING_SLOTS];
+} FSOLogRing;
+
+static struct {
+    _Atomic(FSOLogRing*) rings;          /**< Registered rings (push-only until stop) */
+    atomic_int active;                   /**< 1 while messages go to the rings */
+    atomic_int writers;                  /**< Producers between the active check and publish */
+    atomic_int stop;                     /**< Asks the flusher to drain and exit */
+    atomic_uint generation;              /**< Bumped per start; retires cached thread rings */
+    atomic_ullong dropped;               /**< Records dropped on full rings */
+    FILE* stream;                        /**< Output stream */
+    uint64_t start_ns;                   /**< Monotonic time at start */
+    struct timespec start_wall;          /**< Wall-clock time at start */
+    pthread_t flusher;                   /**< Background writer */
+} g_log_async;
+
+static _Thread_local FSOLogRing* t_log_ring;
+static _Thread_local unsigned int t_log_generation;
+
+static uint64_t fso_log_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief The calling thread's ring for the current run, registered on first use
+ */
+static FSOLogRing* fso_log_thread_ring(void) {
+    unsigned int generation = atomic_load(&g_log_async.generation);
+    if (t_log_ring != NULL && t_log_generation == generation) {
+        return t_log_ring;
+    }
+    
+    FSOLogRing* ring = (FSOLogRing*)aligned_alloc(64, sizeof(FSOLogRing));
+    if (ring == NULL) {
+        return NULL;
+    }
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    
+    ring->next = atomic_load(&g_log_async.rings);
+    while (!atomic_compare_exchange_weak(&g_log_async.rings, &ring->next, ring)) {
+    }
+    
+    t_log_ring = ring;
+    t_log_generation = generation;
+    return ring;
+}
+
+/**
+ * @brief Queue a message on the calling thread's ring
+ * 
+ * @return 1 if the message was queued or dropped, 0 to log synchronously
+ */
+static int fso_log_enqueue(LogLevel level, const char* module, const char* format,
+                           va_list args) {
+    if (!atomic_load_explicit(&g_log_async.active, memory_order_relaxed)) {
+        return 0;
+    }
+    
+    // Pairs with fso_log_async_stop(): either it sees this writer or this
+    // writer sees the mode switched off
+    atomic_fetch_add(&g_log_async.writers, 1);
+    FSOLogRing* ring = atomic_load(&g_log_async.active) ? fso_log_thread_ring() : NULL;
+    if (ring == NULL) {
+        atomic_fetch_sub(&g_log_async.writers, 1);
+        return 0;
+    }
+    
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) >= FSO_LOG_RING_SLOTS) {
+        if (level < LOG_ERROR) {
+            atomic_fetch_add_explicit(&g_log_async.dropped, 1, memory_order_relaxed);
+            atomic_fetch_sub(&g_log_async.writers, 1);
+            return 1;
+        }
+        sched_yield();
+    }
+    
+    FSOLogRecord* record = &ring->records[tail & (FSO_LOG_RING_SLOTS - 1)];
+    record->time_ns = fso_log_monotonic_ns();
+    record->level = level;
+    snprintf(record->module, sizeof(record->module), "%s", module);
+    vsnprintf(record->text, sizeof(record->text), format, args);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    
+    atomic_fetch_sub(&g_log_async.writers, 1);
+    return 1;
+}
+
+/**
+ * @brief Write out every queued record, oldest first across rings
+ * 
+ * @return Number of records written
+ */
+static size_t fso_log_drain(FSOLogClock* clock) {
+    size_t written = 0;
+    
+    for (;;) {
+        FSOLogRing* oldest = NULL;
+        uint64_t oldest_ns = 0;
+        for (FSOLogRing* ring = atomic_load(&g_log_async.rings); ring != NULL; ring = ring->next) {
+            size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+            if (head == atomic_load_explicit(&ring->tail, memory_order_acquire)) {
+                continue;
+            }
+            uint64_t t = ring->records[head & (FSO_LOG_RING_SLOTS - 1)].time_ns;
+            if (oldest == NULL || t < oldest_ns) {
+                oldest = ring;
+                oldest_ns = t;
+            }
+        }
+        if (oldest == NULL) {
+            break;
+        }
+        
+        size_t head = atomic_load_explicit(&oldest->head, memory_order_relaxed);
+        const FSOLogRecord* record = &oldest->records[head & (FSO_LOG_RING_SLOTS - 1)];
+        
+        // Monotonic stamp to wall-clock second
+        uint64_t elapsed_ns = record->time_ns - g_log_async.start_ns +
+                              (uint64_t)g_log_async.start_wall.tv_nsec;
+        time_t second = g_log_async.start_wall.tv_sec + (time_t)(elapsed_ns / 1000000000ull);
+        fso_log_write_line(g_log_async.stream, fso_log_format_time(clock, second),
+                           record->level, record->module, record->text);
+        
+        atomic_store_explicit(&oldest->head, head + 1, memory_order_release);
+        written++;
+    }
+    
+    if (written > 0) {
+        fflush(g_log_async.stream);
+    }
+    return written;
+}
+
+static void* fso_log_flusher(void* arg) {
+    (void)arg;
+    FSOLogClock clock = {0};
+    
+    while (!atomic_load(&g_log_async.stop)) {
+        if (fso_log_drain(&clock) == 0) {
+            struct timespec idle = {0, FSO_LOG_IDLE_NS};
+            nanosleep(&idle, NULL);
+        }
+    }
+    fso_log_drain(&clock);
+    
+    return NULL;
+}
+
+#endif /* FSO_LOG_HAVE_THREADS */
+
+int fso_log_async_start(FILE* stream) {
+#ifdef FSO_LOG_HAVE_THREADS
+    if (atomic_load(&g_log_async.active)) {
+        return FSO_SUCCESS;
+    }
+    
+    g_log_async.stream = (stream != NULL) ? stream : stderr;
+    g_log_async.start_ns = fso_log_monotonic_ns();
+    clock_gettime(CLOCK_REALTIME, &g_log_async.start_wall);
+    atomic_store(&g_log_async.dropped, 0);
+    atomic_store(&g_log_async.stop, 0);
+    atomic_fetch_add(&g_log_async.generation, 1);
+    
+    if (pthread_create(&g_log_async.flusher, NULL, fso_log_flusher, NULL) != 0) {
+        return FSO_ERROR_MEMORY;
+    }
+    atomic_store(&g_log_async.active, 1);
+    
+    return FSO_SUCCESS;
+#else
+    (void)stream;
+    return FSO_ERROR_UNSUPPORTED;
+#endif
+}
+
+void fso_log_async_stop(void) {
+#ifdef FSO_LOG_HAVE_THREADS
+    if (!atomic_load(&g_log_async.active)) {
+        return;
+    }
+    
+    // New messages go straight to stderr; wait out the ones being queued
+    atomic_store(&g_log_async.active, 0);
+    while (atomic_load(&g_log_async.writers) > 0) {
+        sched_yield();
+    }
+    
+    atomic_store(&g_log_async.stop, 1);
+    pthread_join(g_log_async.flusher, NULL);
+    
+    FSOLogRing* ring = atomic_exchange(&g_log_async.rings, NULL);
+    while (ring != NULL) {
+        FSOLogRing* next = ring->next;
+        free(ring);
+        ring = next;
+    }
+    
+    unsigned long long dropped = atomic_load(&g_log_async.dropped);
+    if (dropped > 0) {
+        FSO_LOG_WARNING("Logging", "Dropped %llu records on full log rings", dropped);
+    }
+#endif
+}
+
+unsigned long long fso_log_async_dropped(void) {
+#ifdef FSO_LOG_HAVE_THREADS
+    return atomic_load(&g_log_async.dropped);
+#else
+    return 0;
+#endif
+}
+
+/* ============================================================================
+ * Message Output
+ * ============================================================================ */
+
+void fso_log_message(LogLevel level, const char* module, const char* format, ...) {
+    if (level < LOG_DEBUG || level > LOG_ERROR) {
+        level = LOG_ERROR;
+    }
+    
+    va_list args;
+    va_start(args, format);
+    
+#ifdef FSO_LOG_HAVE_THREADS
+    if (fso_log_enqueue(level, module, format, args)) {
+        va_end(args);
+        return;
+    }
+#endif
+    
+    char text[FSO_LOG_LINE_MAX];
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    
+    static _Thread_local FSOLogClock clock;
+    fso_log_write_line(stderr, fso_log_format_time(&clock, time(NULL)), level, module, text);
+}
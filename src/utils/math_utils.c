@@ -3,11 +3,21 @@
  * @brief Mathematical utility functions for FSO Communication Suite
  * 
  * Implements complex number operations, signal power calculations,
- * and dB conversion utilities.
+ * bit error counting and dB conversion utilities. The sum-of-squares and
+ * popcount kernels come from a per-family table picked at run time
+ * (fso_cpu_simd_level()).
  */
 
 #include "../fso.h"
 #include <math.h>
+#include <string.h>
+
+#if FSO_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+#if FSO_HAVE_NEON
+#include <arm_neon.h>
+#endif
 
 /* ============================================================================
  * Complex Number Operations
@@ -139,6 +149,202 @@ ComplexSample fso_complex_scale(ComplexSample c, double scalar) {
     return result;
 }
 
+/* ============================================================================
+ * Vector Kernels
+ * ============================================================================ */
+
+/**
+ * @brief Sum of squares, compiled once per instruction-set family
+ * 
+ * The reduction is reassociated across vector lanes, so the result can
+ * differ from a sequential sum in the last bits between families.
+ */
+static FSO_ALWAYS_INLINE double math_sum_squares_body(const double* x, size_t length) {
+    double sum = 0.0;
+    
+#ifdef _OPENMP
+    #pragma omp simd reduction(+:sum)
+#endif
+    for (size_t i = 0; i < length; i++) {
+        sum += x[i] * x[i];
+    }
+    
+    return sum;
+}
+
+/**
+ * @brief Differing bits of two buffers, eight bytes per popcount
+ */
+static FSO_ALWAYS_INLINE size_t math_bit_errors_body(const uint8_t* a, const uint8_t* b,
+                                                     size_t length) {
+    size_t errors = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= length; i += 8) {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, sizeof(wa));
+        memcpy(&wb, b + i, sizeof(wb));
+        errors += (size_t)__builtin_popcountll(wa ^ wb);
+    }
+    for (; i < length; i++) {
+        errors += (size_t)__builtin_popcount((unsigned int)(a[i] ^ b[i]));
+    }
+    
+    return errors;
+}
+
+static double math_sum_squares_scalar(const double* x, size_t length) {
+    return math_sum_squares_body(x, length);
+}
+
+static size_t math_bit_errors_scalar(const uint8_t* a, const uint8_t* b, size_t length) {
+    return math_bit_errors_body(a, b, length);
+}
+
+#if FSO_HAVE_X86_SIMD
+
+FSO_TARGET_SSE42
+static double math_sum_squares_sse42(const double* x, size_t length) {
+    return math_sum_squares_body(x, length);
+}
+
+FSO_TARGET_AVX2
+static double math_sum_squares_avx2(const double* x, size_t length) {
+    return math_sum_squares_body(x, length);
+}
+
+FSO_TARGET_AVX512
+static double math_sum_squares_avx512(const double* x, size_t length) {
+    return math_sum_squares_body(x, length);
+}
+
+/**
+ * @brief Hardware POPCNT on 64-bit words
+ */
+FSO_TARGET_SSE42
+static size_t math_bit_errors_sse42(const uint8_t* a, const uint8_t* b, size_t length) {
+    return math_bit_errors_body(a, b, length);
+}
+
+/**
+ * @brief Nibble-LUT popcount, 32 bytes per step
+ * 
+ * PSHUFB looks up the set bits of each nibble and PSADBW folds the byte
+ * counts into four 64-bit lanes, which cannot overflow.
+ */
+FSO_TARGET_AVX2
+static size_t math_bit_errors_avx2(const uint8_t* a, const uint8_t* b, size_t length) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                     _mm256_loadu_si256((const __m256i*)(b + i)));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, mask));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi),
+                                                    _mm256_setzero_si256()));
+    }
+    
+    size_t errors = (size_t)(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                             _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+    return errors + math_bit_errors_body(a + i, b + i, length - i);
+}
+
+/**
+ * @brief math_bit_errors_avx2() with 64-byte AVX-512BW steps
+ */
+FSO_TARGET_AVX512
+static size_t math_bit_errors_avx512(const uint8_t* a, const uint8_t* b, size_t length) {
+    const __m512i lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                                             1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i mask = _mm512_set1_epi8(0x0f);
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    
+    for (; i + 64 <= length; i += 64) {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512((const void*)(a + i)),
+                                     _mm512_loadu_si512((const void*)(b + i)));
+        __m512i lo = _mm512_shuffle_epi8(lut, _mm512_and_si512(x, mask));
+        __m512i hi = _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(x, 4), mask));
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(_mm512_add_epi8(lo, hi),
+                                                    _mm512_setzero_si512()));
+    }
+    
+    size_t errors = (size_t)_mm512_reduce_add_epi64(acc);
+    return errors + math_bit_errors_body(a + i, b + i, length - i);
+}
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+#if FSO_HAVE_NEON
+
+/**
+ * @brief CNT popcount, 16 bytes per step
+ */
+static size_t math_bit_errors_neon(const uint8_t* a, const uint8_t* b, size_t length) {
+    size_t errors = 0;
+    size_t i = 0;
+    
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t x = veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        errors += vaddlvq_u8(vcntq_u8(x));
+    }
+    
+    return errors + math_bit_errors_body(a + i, b + i, length - i);
+}
+
+#endif /* FSO_HAVE_NEON */
+
+/**
+ * @brief Kernels of one instruction-set family
+ * 
+ * NEON is the AArch64 baseline, so its sum of squares is the plain clone.
+ */
+typedef struct {
+    double (*sum_squares)(const double* x, size_t length);
+    size_t (*bit_errors)(const uint8_t* a, const uint8_t* b, size_t length);
+} MathKernels;
+
+static const MathKernels math_kernels_scalar = {
+    math_sum_squares_scalar, math_bit_errors_scalar
+};
+
+#if FSO_HAVE_X86_SIMD
+static const MathKernels math_kernels_sse42 = {
+    math_sum_squares_sse42, math_bit_errors_sse42
+};
+static const MathKernels math_kernels_avx2 = {
+    math_sum_squares_avx2, math_bit_errors_avx2
+};
+static const MathKernels math_kernels_avx512 = {
+    math_sum_squares_avx512, math_bit_errors_avx512
+};
+#endif
+
+#if FSO_HAVE_NEON
+static const MathKernels math_kernels_neon = {
+    math_sum_squares_scalar, math_bit_errors_neon
+};
+#endif
+
+static const MathKernels* math_kernels(void) {
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: return &math_kernels_avx512;
+        case FSO_SIMD_AVX2:   return &math_kernels_avx2;
+        case FSO_SIMD_SSE42:  return &math_kernels_sse42;
+#endif
+#if FSO_HAVE_NEON
+        case FSO_SIMD_NEON:   return &math_kernels_neon;
+#endif
+        default:              return &math_kernels_scalar;
+    }
+}
+
 /* ============================================================================
  * Signal Power Calculations
  * ============================================================================ */
@@ -155,12 +361,7 @@ double fso_signal_power_real(const double* signal, size_t length) {
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (size_t i = 0; i < length; i++) {
-        sum += signal[i] * signal[i];
-    }
-    
-    return sum / (double)length;
+    return math_kernels()->sum_squares(signal, length) / (double)length;
 }
 
 /**
@@ -175,12 +376,39 @@ double fso_signal_power_complex(const ComplexSample* signal, size_t length) {
         return 0.0;
     }
     
+    // Interleaved re, im pairs are one contiguous run of doubles
+    return math_kernels()->sum_squares(&signal[0].real, 2 * length) / (double)length;
+}
+
+/**
+ * @brief Calculate average power of a complex buffer
+ * @param buffer Complex buffer (either layout)
+ * @return Average power (mean of squared magnitudes)
+ */
+double fso_complex_buffer_power(const FSOComplexBuffer* buffer) {
+    if (buffer == NULL || buffer->length == 0) {
+        FSO_LOG_ERROR("MATH", "Invalid parameters for signal power calculation");
+        return 0.0;
+    }
+    
+    const double* real = buffer->real;
+    const double* imag = buffer->imag;
+    const size_t stride = buffer->stride;
+    const MathKernels* kernels = math_kernels();
     double sum = 0.0;
-    for (size_t i = 0; i < length; i++) {
-        sum += fso_complex_magnitude_squared(signal[i]);
+    
+    if (stride == 1) {
+        sum = kernels->sum_squares(real, buffer->length) +
+              kernels->sum_squares(imag, buffer->length);
+    } else if (stride == 2 && imag == real + 1) {
+        sum = kernels->sum_squares(real, 2 * buffer->length);
+    } else {
+        for (size_t i = 0; i < buffer->length; i++) {
+            sum += real[i * stride] * real[i * stride] + imag[i * stride] * imag[i * stride];
+        }
     }
     
-    return sum / (double)length;
+    return sum / (double)buffer->length;
 }
 
 /**
@@ -231,6 +459,25 @@ double fso_calculate_snr(double signal_power, double noise_power) {
     return fso_linear_to_db(signal_power / noise_power);
 }
 
+/* ============================================================================
+ * Bit Error Counting
+ * ============================================================================ */
+
+/**
+ * @brief Count differing bits between two byte buffers
+ * @param a First buffer
+ * @param b Second buffer
+ * @param length Bytes to compare
+ * @return Number of bit positions where a and b differ
+ */
+size_t fso_count_bit_errors(const uint8_t* a, const uint8_t* b, size_t length) {
+    if (a == NULL || b == NULL || length == 0) {
+        return 0;
+    }
+    
+    return math_kernels()->bit_errors(a, b, length);
+}
+
 /* ============================================================================
  * dB Conversion Utilities
  * ============================================================================ */
@@ -0,0 +1,346 @@
+/**
+ * @file profile.c
+ * @brief Scoped-zone profiler for the FSO Communication Suite
+ *
+ * Each thread that closes a zone gets its own counter block, registered
+ * on a lock-free list on first use, so recording never contends. A block
+ * keeps per-zone counts, totals and a log-scale latency histogram (eight
+ * sub-buckets per octave, so percentiles are within ~6%), plus an
+ * optional buffer of individual entries for trace export. Blocks live for
+ * the rest of the process; fso_profile_reset() clears them in place.
+ *
+ * Timestamps come from the TSC on x86 and CLOCK_MONOTONIC elsewhere;
+ * ticks are converted to nanoseconds against the monotonic clock.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../fso.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FSO_PROF_HAVE_TSC 1
+#endif
+
+/* Histogram layout: values below 8 ticks are exact, then 8 buckets per octave */
+#define FSO_PROF_SUB_BUCKETS 8
+#define FSO_PROF_BUCKETS (62 * FSO_PROF_SUB_BUCKETS)
+#define FSO_PROF_CALIBRATE_NS 2000000ull   /* Spin used when no reset reference exists */
+
+static const char* const fso_prof_zone_names[FSO_PROF_ZONE_COUNT] = {
+    "encode", "interleave", "modulate", "fade", "channel",
+    "demodulate", "deinterleave", "decode", "fft", "tracking"
+};
+
+/**
+ * @brief One kept zone entry
+ */
+typedef struct {
+    uint64_t start;                      /**< Entry timestamp (ticks) */
+    uint64_t ticks;                      /**< Duration (ticks) */
+    int zone;                            /**< FSOProfileZone */
+} FSOProfileEvent;
+
+/**
+ * @brief Counters of one recording thread
+ *
+ * Written only by the owning thread; read by snapshot and trace export
+ * once the zones are closed.
+ */
+typedef struct FSOProfileThread {
+    uint64_t count[FSO_PROF_ZONE_COUNT];                      /**< Entries per zone */
+    uint64_t total[FSO_PROF_ZONE_COUNT];                      /**< Summed ticks per zone */
+    uint64_t max[FSO_PROF_ZONE_COUNT];                        /**< Longest entry per zone */
+    uint64_t histogram[FSO_PROF_ZONE_COUNT][FSO_PROF_BUCKETS];/**< Latency histogram */
+    FSOProfileEvent* events;             /**< Kept entries (trace export) */
+    size_t event_count;                  /**< Entries kept since reset */
+    size_t event_capacity;               /**< Allocated entries */
+    uint64_t events_dropped;             /**< Entries past capacity */
+    int thread_index;                    /**< Registration order, used as trace tid */
+    struct FSOProfileThread* next;       /**< Next registered thread */
+} FSOProfileThread;
+
+static struct {
+    _Atomic(FSOProfileThread*) threads;  /**< Registered threads (push-only) */
+    atomic_int thread_count;             /**< Threads registered so far */
+    atomic_size_t trace_capacity;        /**< Entries kept per thread (0 = off) */
+    uint64_t reset_ticks;                /**< Tick reference taken at reset */
+    uint64_t reset_ns;                   /**< Monotonic time at reset */
+} g_prof;
+
+static _Thread_local FSOProfileThread* t_prof_thread;
+
+static uint64_t fso_prof_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int fso_profile_available(void) {
+#ifdef FSO_ENABLE_PROFILING
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+uint64_t fso_profile_now(void) {
+#ifdef FSO_PROF_HAVE_TSC
+    return __builtin_ia32_rdtsc();
+#else
+    return fso_prof_monotonic_ns();
+#endif
+}
+
+/**
+ * @brief Nanoseconds per tick, from the reset reference when it spans long enough
+ */
+static double fso_prof_ns_per_tick(void) {
+#ifdef FSO_PROF_HAVE_TSC
+    uint64_t ticks0 = g_prof.reset_ticks;
+    uint64_t ns0 = g_prof.reset_ns;
+    uint64_t now_ns = fso_prof_monotonic_ns();
+    
+    if (ticks0 == 0 || now_ns - ns0 < FSO_PROF_CALIBRATE_NS) {
+        ticks0 = fso_profile_now();
+        ns0 = fso_prof_monotonic_ns();
+        do {
+            now_ns = fso_prof_monotonic_ns();
+        } while (now_ns - ns0 < FSO_PROF_CALIBRATE_NS);
+    }
+    
+    uint64_t ticks = fso_profile_now() - ticks0;
+    return (ticks > 0) ? (double)(now_ns - ns0) / (double)ticks : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * @brief Histogram bucket of a duration
+ */
+static int fso_prof_bucket(uint64_t ticks) {
+    if (ticks < FSO_PROF_SUB_BUCKETS) {
+        return (int)ticks;
+    }
+    int octave = 63 - __builtin_clzll(ticks);
+    int sub = (int)((ticks >> (octave - 3)) & (FSO_PROF_SUB_BUCKETS - 1));
+    return (octave - 2) * FSO_PROF_SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Midpoint of a bucket in ticks
+ */
+static double fso_prof_bucket_value(int bucket) {
+    if (bucket < FSO_PROF_SUB_BUCKETS) {
+        return (double)bucket;
+    }
+    int octave = bucket / FSO_PROF_SUB_BUCKETS + 2;
+    int sub = bucket % FSO_PROF_SUB_BUCKETS;
+    double width = (double)(1ull << (octave - 3));
+    return (double)(FSO_PROF_SUB_BUCKETS + sub) * width + 0.5 * width;
+}
+
+/**
+ * @brief The calling thread's counters, registered on first use
+ */
+static FSOProfileThread* fso_prof_thread(void) {
+    if (t_prof_thread != NULL) {
+        return t_prof_thread;
+    }
+    
+    FSOProfileThread* thread = (FSOProfileThread*)calloc(1, sizeof(FSOProfileThread));
+    if (thread == NULL) {
+        return NULL;
+    }
+    thread->thread_index = atomic_fetch_add(&g_prof.thread_count, 1);
+    
+    thread->next = atomic_load(&g_prof.threads);
+    while (!atomic_compare_exchange_weak(&g_prof.threads, &thread->next, thread)) {
+    }
+    
+    t_prof_thread = thread;
+    return thread;
+}
+
+void fso_profile_record(FSOProfileZone zone, uint64_t start_ticks) {
+    uint64_t end = fso_profile_now();
+    FSOProfileThread* thread = fso_prof_thread();
+    if (thread == NULL || (unsigned)zone >= FSO_PROF_ZONE_COUNT) {
+        return;
+    }
+    
+    uint64_t ticks = end - start_ticks;
+    thread->count[zone]++;
+    thread->total[zone] += ticks;
+    thread->max[zone] = FSO_MAX(thread->max[zone], ticks);
+    thread->histogram[zone][fso_prof_bucket(ticks)]++;
+    
+    size_t capacity = atomic_load_explicit(&g_prof.trace_capacity, memory_order_relaxed);
+    if (capacity == 0) {
+        return;
+    }
+    if (thread->event_capacity != capacity) {
+        FSOProfileEvent* events = (FSOProfileEvent*)realloc(thread->events,
+                                                            capacity * sizeof(FSOProfileEvent));
+        if (events == NULL) {
+            thread->events_dropped++;
+            return;
+        }
+        thread->events = events;
+        thread->event_capacity = capacity;
+        thread->event_count = FSO_MIN(thread->event_count, capacity);
+    }
+    if (thread->event_count < thread->event_capacity) {
+        thread->events[thread->event_count++] = (FSOProfileEvent){
+            .start = start_ticks, .ticks = ticks, .zone = (int)zone
+        };
+    } else {
+        thread->events_dropped++;
+    }
+}
+
+void fso_profile_reset(void) {
+    for (FSOProfileThread* thread = atomic_load(&g_prof.threads); thread != NULL;
+         thread = thread->next) {
+        memset(thread->count, 0, sizeof(thread->count));
+        memset(thread->total, 0, sizeof(thread->total));
+        memset(thread->max, 0, sizeof(thread->max));
+        memset(thread->histogram, 0, sizeof(thread->histogram));
+        thread->event_count = 0;
+        thread->events_dropped = 0;
+    }
+    
+    g_prof.reset_ns = fso_prof_monotonic_ns();
+    g_prof.reset_ticks = fso_profile_now();
+}
+
+void fso_profile_snapshot(FSOProfileStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, FSO_PROF_ZONE_COUNT * sizeof(FSOProfileStats));
+    
+    FSOProfileThread* head = atomic_load(&g_prof.threads);
+    if (head == NULL) {
+        return;
+    }
+    double ns_per_tick = fso_prof_ns_per_tick();
+    
+    for (int zone = 0; zone < FSO_PROF_ZONE_COUNT; zone++) {
+        uint64_t count = 0, total = 0, max = 0;
+        for (FSOProfileThread* thread = head; thread != NULL; thread = thread->next) {
+            count += thread->count[zone];
+            total += thread->total[zone];
+            max = FSO_MAX(max, thread->max[zone]);
+        }
+        if (count == 0) {
+            continue;
+        }
+        
+        // Percentiles from the merged histogram, capped at the observed maximum
+        uint64_t rank50 = (count + 1) / 2;
+        uint64_t rank99 = count - count / 100;
+        double p50 = 0.0, p99 = 0.0;
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < FSO_PROF_BUCKETS && seen < rank99; bucket++) {
+            uint64_t in_bucket = 0;
+            for (FSOProfileThread* thread = head; thread != NULL; thread = thread->next) {
+                in_bucket += thread->histogram[zone][bucket];
+            }
+            if (seen < rank50 && seen + in_bucket >= rank50) {
+                p50 = fso_prof_bucket_value(bucket);
+            }
+            if (seen + in_bucket >= rank99) {
+                p99 = fso_prof_bucket_value(bucket);
+            }
+            seen += in_bucket;
+        }
+        
+        stats[zone] = (FSOProfileStats){
+            .count = count,
+            .total_ns = (double)total * ns_per_tick,
+            .mean_ns = (double)total * ns_per_tick / (double)count,
+            .p50_ns = FSO_MIN(p50, (double)max) * ns_per_tick,
+            .p99_ns = FSO_MIN(p99, (double)max) * ns_per_tick,
+            .max_ns = (double)max * ns_per_tick
+        };
+    }
+}
+
+const char* fso_profile_zone_name(FSOProfileZone zone) {
+    if ((unsigned)zone >= FSO_PROF_ZONE_COUNT) {
+        return "unknown";
+    }
+    return fso_prof_zone_names[zone];
+}
+
+/* ============================================================================
+ * Trace Export
+ * ============================================================================ */
+
+int fso_profile_trace_enable(size_t events_per_thread) {
+    if (!fso_profile_available() && events_per_thread > 0) {
+        FSO_LOG_WARNING("Profile", "Built without FSO_ENABLE_PROFILING; no trace is recorded");
+        return FSO_ERROR_UNSUPPORTED;
+    }
+    atomic_store(&g_prof.trace_capacity, events_per_thread);
+    return FSO_SUCCESS;
+}
+
+int fso_profile_write_trace(const char* filename) {
+    FSO_CHECK_NULL(filename);
+    
+    FILE* fp = fopen(filename, "w");
+    if (fp == NULL) {
+        FSO_LOG_ERROR("Profile", "Failed to open trace file: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    
+    // Timestamps start at the earliest kept entry
+    FSOProfileThread* head = atomic_load(&g_prof.threads);
+    uint64_t origin = UINT64_MAX;
+    uint64_t dropped = 0;
+    for (FSOProfileThread* thread = head; thread != NULL; thread = thread->next) {
+        for (size_t i = 0; i < thread->event_count; i++) {
+            origin = FSO_MIN(origin, thread->events[i].start);
+        }
+        dropped += thread->events_dropped;
+    }
+    double us_per_tick = fso_prof_ns_per_tick() * 1e-3;
+    
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    const char* separator = "\n";
+    for (FSOProfileThread* thread = head; thread != NULL; thread = thread->next) {
+        fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"thread %d\"}}",
+                separator, thread->thread_index, thread->thread_index);
+        separator = ",\n";
+        
+        for (size_t i = 0; i < thread->event_count; i++) {
+            const FSOProfileEvent* event = &thread->events[i];
+            fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"fso\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f}",
+                    fso_prof_zone_names[event->zone], thread->thread_index,
+                    (double)(event->start - origin) * us_per_tick,
+                    (double)event->ticks * us_per_tick);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    
+    int failed = ferror(fp);
+    fclose(fp);
+    if (failed) {
+        FSO_LOG_ERROR("Profile", "Failed to write trace file: %s", filename);
+        return FSO_ERROR_IO;
+    }
+    
+    if (dropped > 0) {
+        FSO_LOG_WARNING("Profile", "Trace omits %llu entries past the per-thread capacity",
+                        (unsigned long long)dropped);
+    }
+    FSO_LOG_INFO("Profile", "Trace written to %s", filename);
+    return FSO_SUCCESS;
+}
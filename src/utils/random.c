@@ -2,35 +2,348 @@
  * @file random.c
  * @brief Thread-safe random number generation utilities
  * 
- * Implements thread-safe random number generators including uniform
- * and Gaussian distributions using Box-Muller transform.
+ * Implements a counter-based Philox4x32-10 generator. A stream is keyed by
+ * the run seed and addressed by (packet, stream id), so every packet draws
+ * the same numbers no matter which thread processes it or how many threads
+ * run. Gaussian variates use the Marsaglia-Tsang Ziggurat; bulk fill
+ * functions generate whole counter blocks with vectorized loops, compiled
+ * once per instruction-set family and picked at run time. All variants
+ * produce identical words.
  */
 
 #include "../fso.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
+#include <pthread.h>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+/* ============================================================================
+ * Philox4x32-10 Core
+ * ============================================================================ */
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/* Counter blocks generated per refill (4 words each) */
+#define FSO_RNG_BLOCKS (FSO_RNG_BUFFER_WORDS / 4)
+
+/**
+ * @brief Fill the stream buffer with the next FSO_RNG_BLOCKS counter blocks
+ * 
+ * Blocks are independent, so the loop vectorizes across counters.
+ */
+static FSO_ALWAYS_INLINE void philox_refill_body(FSORandomStream* stream) {
+    const uint32_t k0 = stream->key[0];
+    const uint32_t k1 = stream->key[1];
+    const uint32_t c2 = stream->packet;
+    const uint32_t c3 = stream->stream_id;
+    const uint64_t base = stream->block;
+    uint32_t* out = stream->buffer;
+    
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (int b = 0; b < FSO_RNG_BLOCKS; b++) {
+        uint64_t index = base + (uint64_t)b;
+        uint32_t x0 = (uint32_t)index;
+        uint32_t x1 = (uint32_t)(index >> 32);
+        uint32_t x2 = c2;
+        uint32_t x3 = c3;
+        uint32_t r0 = k0;
+        uint32_t r1 = k1;
+        
+        for (int round = 0; round < PHILOX_ROUNDS; round++) {
+            uint64_t p0 = (uint64_t)PHILOX_M0 * x0;
+            uint64_t p1 = (uint64_t)PHILOX_M1 * x2;
+            uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ r0;
+            uint32_t y2 = (uint32_t)(p0 >> 32) ^ x3 ^ r1;
+            x1 = (uint32_t)p1;
+            x3 = (uint32_t)p0;
+            x0 = y0;
+            x2 = y2;
+            r0 += PHILOX_W0;
+            r1 += PHILOX_W1;
+        }
+        
+        out[4 * b] = x0;
+        out[4 * b + 1] = x1;
+        out[4 * b + 2] = x2;
+        out[4 * b + 3] = x3;
+    }
+    
+    stream->block = base + FSO_RNG_BLOCKS;
+    stream->position = 0;
+}
+
+static void philox_refill_scalar(FSORandomStream* stream) {
+    philox_refill_body(stream);
+}
+
+#if FSO_HAVE_X86_SIMD
+
+FSO_TARGET_SSE42
+static void philox_refill_sse42(FSORandomStream* stream) {
+    philox_refill_body(stream);
+}
+
+FSO_TARGET_AVX2
+static void philox_refill_avx2(FSORandomStream* stream) {
+    philox_refill_body(stream);
+}
+
+FSO_TARGET_AVX512
+static void philox_refill_avx512(FSORandomStream* stream) {
+    philox_refill_body(stream);
+}
+
+#endif /* FSO_HAVE_X86_SIMD */
+
+/**
+ * @brief Refill with the widest enabled clone
+ * 
+ * NEON is the AArch64 baseline, so it shares the plain clone.
+ */
+static void philox_refill(FSORandomStream* stream) {
+    switch (fso_cpu_simd_level()) {
+#if FSO_HAVE_X86_SIMD
+        case FSO_SIMD_AVX512: philox_refill_avx512(stream); break;
+        case FSO_SIMD_AVX2:   philox_refill_avx2(stream); break;
+        case FSO_SIMD_SSE42:  philox_refill_sse42(stream); break;
+#endif
+        default:              philox_refill_scalar(stream); break;
+    }
+}
+
+static inline uint32_t rng_next(FSORandomStream* stream) {
+    if (stream->position >= FSO_RNG_BUFFER_WORDS) {
+        philox_refill(stream);
+    }
+    return stream->buffer[stream->position++];
+}
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits
+ */
+static inline double rng_uniform(FSORandomStream* stream) {
+    uint64_t hi = rng_next(stream);
+    uint64_t lo = rng_next(stream);
+    return (double)(((hi << 32) | lo) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Uniform double in (0, 1), safe for log()
+ */
+static inline double rng_uniform_open(FSORandomStream* stream) {
+    uint64_t hi = rng_next(stream);
+    uint64_t lo = rng_next(stream);
+    return ((double)(((hi << 32) | lo) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+/* ============================================================================
+ * Ziggurat Tables
+ * ============================================================================ */
+
+#define ZIG_LAYERS 128
+#define ZIG_R 3.442619855899
+
+static uint32_t zig_k[ZIG_LAYERS];
+static double zig_w[ZIG_LAYERS];
+static double zig_f[ZIG_LAYERS];
+static pthread_once_t zig_once = PTHREAD_ONCE_INIT;
+
 /**
- * @brief Random number generator state
+ * @brief Build Marsaglia-Tsang Ziggurat tables
  */
-typedef struct {
-    unsigned int seed;           /**< Current seed value */
-    int has_spare;              /**< Flag for Box-Muller spare value */
-    double spare;               /**< Spare Gaussian value from Box-Muller */
-} RandomState;
+static void zig_build_tables(void) {
+    const double m1 = 2147483648.0;
+    const double vn = 9.91256303526217e-3;
+    double dn = ZIG_R;
+    double tn = dn;
+    double q = vn / exp(-0.5 * dn * dn);
+    
+    zig_k[0] = (uint32_t)((dn / q) * m1);
+    zig_k[1] = 0;
+    zig_w[0] = q / m1;
+    zig_w[ZIG_LAYERS - 1] = dn / m1;
+    zig_f[0] = 1.0;
+    zig_f[ZIG_LAYERS - 1] = exp(-0.5 * dn * dn);
+    
+    for (int i = ZIG_LAYERS - 2; i >= 1; i--) {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        zig_k[i + 1] = (uint32_t)((dn / tn) * m1);
+        tn = dn;
+        zig_f[i] = exp(-0.5 * dn * dn);
+        zig_w[i] = dn / m1;
+    }
+}
+
+/**
+ * @brief Build the Ziggurat tables once per process, from any thread
+ */
+static void zig_init_tables(void) {
+    pthread_once(&zig_once, zig_build_tables);
+}
+
+/**
+ * @brief Rejection path for a Ziggurat candidate outside the fast region
+ */
+static double zig_slow(FSORandomStream* stream, int32_t hz, uint32_t iz) {
+    for (;;) {
+        double x = (double)hz * zig_w[iz];
+        
+        // Base layer: sample the tail beyond R exactly
+        if (iz == 0) {
+            double y;
+            do {
+                x = -log(rng_uniform_open(stream)) / ZIG_R;
+                y = -log(rng_uniform_open(stream));
+            } while (y + y < x * x);
+            return (hz > 0) ? ZIG_R + x : -ZIG_R - x;
+        }
+        
+        if (zig_f[iz] + rng_uniform(stream) * (zig_f[iz - 1] - zig_f[iz]) <
+            exp(-0.5 * x * x)) {
+            return x;
+        }
+        
+        // Value and layer come from separate words to avoid correlation
+        hz = (int32_t)rng_next(stream);
+        iz = rng_next(stream) & (ZIG_LAYERS - 1);
+        uint32_t magnitude = (hz < 0) ? 0u - (uint32_t)hz : (uint32_t)hz;
+        if (magnitude < zig_k[iz]) {
+            return (double)hz * zig_w[iz];
+        }
+    }
+}
+
+static inline double zig_normal(FSORandomStream* stream) {
+    int32_t hz = (int32_t)rng_next(stream);
+    uint32_t iz = rng_next(stream) & (ZIG_LAYERS - 1);
+    uint32_t magnitude = (hz < 0) ? 0u - (uint32_t)hz : (uint32_t)hz;
+    if (magnitude < zig_k[iz]) {
+        return (double)hz * zig_w[iz];
+    }
+    return zig_slow(stream, hz, iz);
+}
+
+/* ============================================================================
+ * Explicit Streams
+ * ============================================================================ */
+
+void fso_random_stream_init(FSORandomStream* stream, uint64_t run_seed,
+                            uint32_t packet, uint32_t stream_id) {
+    if (stream == NULL) {
+        return;
+    }
+    
+    zig_init_tables();
+    
+    stream->seed = run_seed;
+    stream->key[0] = (uint32_t)run_seed;
+    stream->key[1] = (uint32_t)(run_seed >> 32);
+    stream->packet = packet;
+    stream->stream_id = stream_id;
+    stream->block = 0;
+    stream->position = FSO_RNG_BUFFER_WORDS;  // Refill on first draw
+    stream->initialized = 1;
+}
+
+uint32_t fso_random_stream_next(FSORandomStream* stream) {
+    return rng_next(stream);
+}
+
+double fso_random_stream_uniform(FSORandomStream* stream) {
+    return rng_uniform(stream);
+}
+
+double fso_random_stream_gaussian(FSORandomStream* stream, double mean, double stddev) {
+    return mean + stddev * zig_normal(stream);
+}
+
+void fso_random_stream_gaussian_fill(FSORandomStream* stream, double* output,
+                                     size_t count, double stddev) {
+    if (stream == NULL || output == NULL) {
+        return;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        output[i] = stddev * zig_normal(stream);
+    }
+}
+
+void fso_random_stream_gaussian_fill_f32(FSORandomStream* stream, float* output,
+                                         size_t count, double stddev) {
+    if (stream == NULL || output == NULL) {
+        return;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        output[i] = (float)(stddev * zig_normal(stream));
+    }
+}
+
+void fso_random_stream_bytes_fill(FSORandomStream* stream, uint8_t* output, size_t count) {
+    if (stream == NULL || output == NULL) {
+        return;
+    }
+    
+    size_t done = 0;
+    while (done < count) {
+        if (stream->position >= FSO_RNG_BUFFER_WORDS) {
+            philox_refill(stream);
+        }
+        
+        // Copy whole buffered words; a trailing partial word is consumed
+        size_t words = (size_t)(FSO_RNG_BUFFER_WORDS - stream->position);
+        size_t bytes = FSO_MIN(words * sizeof(uint32_t), count - done);
+        memcpy(output + done, stream->buffer + stream->position, bytes);
+        stream->position += (int)((bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        done += bytes;
+    }
+}
+
+/* ============================================================================
+ * Thread-Local Generator
+ * ============================================================================ */
 
 /**
  * @brief Thread-local random state
  */
+static _Thread_local FSORandomStream tls_random_state;
+
+/**
+ * @brief Index of the calling thread: its pool worker slot, else its OpenMP id
+ */
+static inline int random_thread_index(void) {
+    int worker = fso_threadpool_worker();
+    if (worker >= 0) {
+        return worker;
+    }
 #ifdef _OPENMP
-#pragma omp threadprivate(tls_random_state)
+    return omp_get_thread_num();
+#else
+    return 0;
 #endif
-static RandomState tls_random_state = {0, 0, 0.0};
+}
+
+/**
+ * @brief Thread-local stream, seeded from the thread id on first use
+ */
+static inline FSORandomStream* tls_stream(void) {
+    if (!tls_random_state.initialized) {
+        uint64_t seed = 1 + (uint64_t)random_thread_index();
+        fso_random_stream_init(&tls_random_state, seed, 0, 0);
+    }
+    return &tls_random_state;
+}
 
 /**
  * @brief Initialize random number generator with seed
@@ -38,15 +351,10 @@ static RandomState tls_random_state = {0, 0, 0.0};
  */
 void fso_random_init(unsigned int seed) {
     if (seed == 0) {
-        seed = (unsigned int)time(NULL);
-#ifdef _OPENMP
-        seed += omp_get_thread_num();
-#endif
+        seed = (unsigned int)time(NULL) + (unsigned int)random_thread_index();
     }
     
-    tls_random_state.seed = seed;
-    tls_random_state.has_spare = 0;
-    tls_random_state.spare = 0.0;
+    fso_random_stream_init(&tls_random_state, seed, 0, 0);
 }
 
 /**
@@ -54,8 +362,7 @@ void fso_random_init(unsigned int seed) {
  * @param seed Seed value
  */
 void fso_random_set_seed(unsigned int seed) {
-    tls_random_state.seed = seed;
-    tls_random_state.has_spare = 0;
+    fso_random_stream_init(&tls_random_state, seed, 0, 0);
 }
 
 /**
@@ -63,7 +370,11 @@ void fso_random_set_seed(unsigned int seed) {
  * @return Current seed value
  */
 unsigned int fso_random_get_seed(void) {
-    return tls_random_state.seed;
+    return (unsigned int)tls_random_state.seed;
+}
+
+void fso_random_select_stream(uint64_t run_seed, uint32_t packet, uint32_t stream_id) {
+    fso_random_stream_init(&tls_random_state, run_seed, packet, stream_id);
 }
 
 /**
@@ -71,11 +382,7 @@ unsigned int fso_random_get_seed(void) {
  * @return Random number in [0, 1)
  */
 double fso_random_uniform(void) {
-    // Thread-safe random number generation
-    // Use a simple LCG (Linear Congruential Generator) for portability
-    tls_random_state.seed = tls_random_state.seed * 1103515245 + 12345;
-    unsigned int r = (tls_random_state.seed / 65536) % 32768;
-    return (double)r / 32768.0;
+    return rng_uniform(tls_stream());
 }
 
 /**
@@ -89,41 +396,13 @@ double fso_random_uniform_range(double min, double max) {
 }
 
 /**
- * @brief Generate Gaussian (normal) random number using Box-Muller transform
+ * @brief Generate Gaussian (normal) random number using the Ziggurat method
  * @param mean Mean of the distribution
  * @param stddev Standard deviation of the distribution
  * @return Random number from N(mean, stddev^2)
  */
 double fso_random_gaussian(double mean, double stddev) {
-    // Box-Muller transform generates two independent Gaussian values
-    // We save one for the next call to improve efficiency
-    
-    if (tls_random_state.has_spare) {
-        tls_random_state.has_spare = 0;
-        return mean + stddev * tls_random_state.spare;
-    }
-    
-    // Generate two uniform random numbers
-    double u1, u2;
-    do {
-        u1 = fso_random_uniform();
-    } while (u1 == 0.0);  // Avoid log(0)
-    
-    u2 = fso_random_uniform();
-    
-    // Box-Muller transform
-    double r = sqrt(-2.0 * log(u1));
-    double theta = 2.0 * FSO_PI * u2;
-    
-    // Generate two independent Gaussian values
-    double z0 = r * cos(theta);
-    double z1 = r * sin(theta);
-    
-    // Save one for next call
-    tls_random_state.spare = z1;
-    tls_random_state.has_spare = 1;
-    
-    return mean + stddev * z0;
+    return mean + stddev * zig_normal(tls_stream());
 }
 
 /**
@@ -147,8 +426,20 @@ int fso_random_int(int min, int max) {
         max = temp;
     }
     
-    int range = max - min + 1;
-    tls_random_state.seed = tls_random_state.seed * 1103515245 + 12345;
-    unsigned int r = (tls_random_state.seed / 65536) % 32768;
-    return min + (r % range);
+    // Multiply-shift maps 32 random bits onto the range without modulo bias
+    uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    uint64_t r = ((uint64_t)rng_next(tls_stream()) * range) >> 32;
+    return (int)((int64_t)min + (int64_t)r);
+}
+
+void fso_random_gaussian_fill(double* output, size_t count, double stddev) {
+    fso_random_stream_gaussian_fill(tls_stream(), output, count, stddev);
+}
+
+void fso_random_gaussian_fill_f32(float* output, size_t count, double stddev) {
+    fso_random_stream_gaussian_fill_f32(tls_stream(), output, count, stddev);
+}
+
+void fso_random_bytes_fill(uint8_t* output, size_t count) {
+    fso_random_stream_bytes_fill(tls_stream(), output, count);
 }
@@ -0,0 +1,520 @@
+/**
+ * @file threadpool.c
+ * @brief Persistent worker pool shared by the simulator, codecs and kernels
+ *
+ * Workers are spawned once and wait on a condition variable between jobs
+ * (after a short spin, so back-to-back loops do not pay a wake-up). A job
+ * is published with one atomic ticket holding its generation and worker
+ * count; the submitting thread waits for the participants to finish.
+ *
+ * Pinned workers are placed from the NUMA layout in sysfs, restricted to
+ * the process's allowed CPUs: compact fills node 0 first, scatter deals
+ * workers across nodes. Without sysfs all CPUs count as one node.
+ */
+
+#define _GNU_SOURCE
+
+#include "../fso.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#define FSO_POOL_HAVE_THREADS 1
+#endif
+
+#define MODULE_NAME "ThreadPool"
+
+/* Pool limits */
+#define FSO_POOL_MAX_THREADS 256      /* Workers (ticket keeps 16 bits for the count) */
+#define FSO_POOL_MAX_NODES 64         /* NUMA nodes probed in sysfs */
+#define FSO_POOL_MAX_CPUS 1024        /* CPU ids considered for placement */
+#define FSO_POOL_SPIN 4000            /* Polls before a thread sleeps */
+
+static _Thread_local int t_pool_worker = -1;
+
+#ifdef FSO_POOL_HAVE_THREADS
+
+/**
+ * @brief Loop being executed
+ *
+ * Written by the submitter before the ticket is published and read only
+ * by participants, which all finish before the next job can be written.
+ */
+typedef struct {
+    FSOParallelFn fn;                    /**< Loop body */
+    void* context;                       /**< Caller data */
+    size_t count;                        /**< Indices in the loop */
+    size_t grain;                        /**< Dynamic chunk (0 = static blocks) */
+    atomic_size_t next;                  /**< Next unclaimed index (dynamic) */
+} FSOPoolJob;
+
+/**
+ * @brief One worker thread
+ */
+typedef struct {
+    pthread_t thread;                    /**< Thread handle */
+    int index;                           /**< Worker slot */
+    int cpu;                             /**< Pinned CPU (-1 = unpinned) */
+    uint64_t start_ticket;               /**< Ticket when spawned (a job may precede the thread) */
+} FSOPoolWorker;
+
+static struct {
+    pthread_mutex_t control;             /**< Serializes init and shutdown */
+    pthread_mutex_t submit;              /**< Held by the thread whose job runs */
+    pthread_mutex_t wake_lock;           /**< Guards the sleep/wake handshake */
+    pthread_cond_t wake;                 /**< Signals a new ticket or stop */
+    pthread_mutex_t done_lock;           /**< Guards the completion handshake */
+    pthread_cond_t done;                 /**< Signals the last participant */
+    _Atomic(uint64_t) ticket;            /**< (generation << 16) | participating workers */
+    atomic_int pending;                  /**< Participants still running */
+    atomic_int stop;                     /**< Asks workers to exit */
+    atomic_int size;                     /**< Running workers (0 = no pool) */
+    int spin;                            /**< Polls before sleeping (0 when oversubscribed) */
+    FSOPoolWorker* workers;              /**< Worker array */
+    FSOPoolJob job;                      /**< Current loop */
+} g_pool = {
+    .control = PTHREAD_MUTEX_INITIALIZER,
+    .submit = PTHREAD_MUTEX_INITIALIZER,
+    .wake_lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done_lock = PTHREAD_MUTEX_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER
+};
+
+#endif /* FSO_POOL_HAVE_THREADS */
+
+/* ============================================================================
+ * Work Distribution
+ * ============================================================================ */
+
+/**
+ * @brief Block w of a static split into n contiguous blocks
+ */
+static void fso_pool_static_range(size_t count, int n, int w, size_t* begin, size_t* end) {
+    *begin = count * (size_t)w / (size_t)n;
+    *end = count * (size_t)(w + 1) / (size_t)n;
+}
+
+/**
+ * @brief Run a loop on the calling thread, keeping the worker slots
+ */
+static void fso_pool_run_inline(size_t count, size_t grain, int workers,
+                                FSOParallelFn fn, void* context) {
+    if (grain > 0) {
+        fn(context, 0, count, 0);
+        return;
+    }
+    
+    for (int w = 0; w < workers; w++) {
+        size_t begin, end;
+        fso_pool_static_range(count, workers, w, &begin, &end);
+        if (begin < end) {
+            fn(context, begin, end, w);
+        }
+    }
+}
+
+#ifdef FSO_POOL_HAVE_THREADS
+
+/**
+ * @brief Worker w's share of the current job
+ */
+static void fso_pool_run_share(FSOPoolJob* job, int workers, int w) {
+    if (job->grain == 0) {
+        size_t begin, end;
+        fso_pool_static_range(job->count, workers, w, &begin, &end);
+        if (begin < end) {
+            job->fn(job->context, begin, end, w);
+        }
+        return;
+    }
+    
+    for (;;) {
+        size_t begin = atomic_fetch_add(&job->next, job->grain);
+        if (begin >= job->count) {
+            break;
+        }
+        job->fn(job->context, begin, FSO_MIN(begin + job->grain, job->count), w);
+    }
+}
+
+/* ============================================================================
+ * Topology and Placement
+ * ============================================================================ */
+
+/**
+ * @brief Parse a sysfs CPU list ("0-15,32-47") into a node map
+ */
+static void fso_pool_parse_cpulist(const char* list, int node, int* cpu_node) {
+    const char* p = list;
+    while (*p != '\0' && *p != '\n') {
+        char* stop;
+        long first = strtol(p, &stop, 10);
+        if (stop == p) {
+            break;
+        }
+        long last = first;
+        p = stop;
+        if (*p == '-') {
+            last = strtol(p + 1, &stop, 10);
+            p = stop;
+        }
+        for (long cpu = first; cpu <= last && cpu < FSO_POOL_MAX_CPUS; cpu++) {
+            if (cpu >= 0) {
+                cpu_node[cpu] = node;
+            }
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+}
+
+/**
+ * @brief Order the allowed CPUs for placement
+ *
+ * @param affinity Compact (node by node) or scatter (round-robin over nodes)
+ * @param order Receives CPU ids
+ * @param num_nodes Receives the number of nodes with allowed CPUs
+ * @return Number of CPUs in order
+ */
+static int fso_pool_cpu_order(FSOAffinityMode affinity, int* order, int* num_nodes) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return 0;
+    }
+    
+    static int cpu_node[FSO_POOL_MAX_CPUS];
+    for (int cpu = 0; cpu < FSO_POOL_MAX_CPUS; cpu++) {
+        cpu_node[cpu] = 0;
+    }
+    for (int node = 0; node < FSO_POOL_MAX_NODES; node++) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* file = fopen(path, "r");
+        if (file == NULL) {
+            continue;
+        }
+        char list[1024];
+        if (fgets(list, sizeof(list), file) != NULL) {
+            fso_pool_parse_cpulist(list, node, cpu_node);
+        }
+        fclose(file);
+    }
+    
+    // Allowed CPUs per node, ascending (physical cores usually precede siblings)
+    static int node_cpus[FSO_POOL_MAX_NODES][FSO_POOL_MAX_CPUS];
+    int node_count[FSO_POOL_MAX_NODES] = {0};
+    int limit = FSO_MIN(FSO_POOL_MAX_CPUS, CPU_SETSIZE);
+    for (int cpu = 0; cpu < limit; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            int node = cpu_node[cpu];
+            node_cpus[node][node_count[node]++] = cpu;
+        }
+    }
+    
+    int total = 0;
+    *num_nodes = 0;
+    for (int node = 0; node < FSO_POOL_MAX_NODES; node++) {
+        if (node_count[node] > 0) {
+            (*num_nodes)++;
+        }
+    }
+    
+    if (affinity == FSO_AFFINITY_SCATTER) {
+        for (int rank = 0; total < FSO_POOL_MAX_CPUS; rank++) {
+            int added = 0;
+            for (int node = 0; node < FSO_POOL_MAX_NODES; node++) {
+                if (rank < node_count[node]) {
+                    order[total++] = node_cpus[node][rank];
+                    added = 1;
+                }
+            }
+            if (!added) {
+                break;
+            }
+        }
+    } else {
+        for (int node = 0; node < FSO_POOL_MAX_NODES; node++) {
+            for (int i = 0; i < node_count[node]; i++) {
+                order[total++] = node_cpus[node][i];
+            }
+        }
+    }
+    
+    return total;
+}
+
+/* ============================================================================
+ * Workers
+ * ============================================================================ */
+
+/**
+ * @brief Wait until the ticket moves past seen or the pool stops
+ */
+static uint64_t fso_pool_wait_ticket(uint64_t seen) {
+    for (int spin = 0; spin < g_pool.spin; spin++) {
+        uint64_t ticket = atomic_load_explicit(&g_pool.ticket, memory_order_acquire);
+        if (ticket != seen || atomic_load(&g_pool.stop)) {
+            return ticket;
+        }
+    }
+    
+    pthread_mutex_lock(&g_pool.wake_lock);
+    uint64_t ticket;
+    while ((ticket = atomic_load(&g_pool.ticket)) == seen && !atomic_load(&g_pool.stop)) {
+        pthread_cond_wait(&g_pool.wake, &g_pool.wake_lock);
+    }
+    pthread_mutex_unlock(&g_pool.wake_lock);
+    return ticket;
+}
+
+static void* fso_pool_worker_main(void* arg) {
+    FSOPoolWorker* self = (FSOPoolWorker*)arg;
+    t_pool_worker = self->index;
+    
+    // Pin before touching any memory so first-touch pages land locally
+    if (self->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(self->cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            FSO_LOG_WARNING(MODULE_NAME, "Worker %d could not be pinned to CPU %d",
+                            self->index, self->cpu);
+        }
+    }
+    
+    uint64_t seen = self->start_ticket;
+    for (;;) {
+        uint64_t ticket = fso_pool_wait_ticket(seen);
+        if (atomic_load(&g_pool.stop)) {
+            break;
+        }
+        seen = ticket;
+        
+        int workers = (int)(ticket & 0xFFFF);
+        if (self->index >= workers) {
+            continue;
+        }
+        
+        fso_pool_run_share(&g_pool.job, workers, self->index);
+        
+        if (atomic_fetch_sub(&g_pool.pending, 1) == 1) {
+            pthread_mutex_lock(&g_pool.done_lock);
+            pthread_cond_signal(&g_pool.done);
+            pthread_mutex_unlock(&g_pool.done_lock);
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief CPUs the process may run on
+ */
+static int fso_pool_allowed_cpus(void) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        return CPU_COUNT(&allowed);
+    }
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return (online > 0) ? (int)online : 1;
+}
+
+/**
+ * @brief Default worker count: OpenMP's setting, else the allowed CPUs
+ */
+static int fso_pool_default_threads(void) {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return fso_pool_allowed_cpus();
+#endif
+}
+
+#endif /* FSO_POOL_HAVE_THREADS */
+
+/* ============================================================================
+ * Public Interface
+ * ============================================================================ */
+
+int fso_threadpool_init(const FSOThreadPoolConfig* config) {
+#ifdef FSO_POOL_HAVE_THREADS
+    pthread_mutex_lock(&g_pool.control);
+    if (atomic_load(&g_pool.size) > 0) {
+        pthread_mutex_unlock(&g_pool.control);
+        return FSO_SUCCESS;
+    }
+    
+    int num_threads = (config != NULL) ? config->num_threads : 0;
+    FSOAffinityMode affinity = (config != NULL) ? config->affinity : FSO_AFFINITY_NONE;
+    if (num_threads <= 0) {
+        num_threads = fso_pool_default_threads();
+    }
+    num_threads = FSO_CLAMP(num_threads, 1, FSO_POOL_MAX_THREADS);
+    
+    static int order[FSO_POOL_MAX_CPUS];
+    int num_cpus = 0;
+    int num_nodes = 1;
+    if (affinity != FSO_AFFINITY_NONE) {
+        num_cpus = fso_pool_cpu_order(affinity, order, &num_nodes);
+        if (num_cpus == 0) {
+            FSO_LOG_WARNING(MODULE_NAME, "CPU topology unavailable; workers are not pinned");
+        } else if (num_threads > num_cpus) {
+            FSO_LOG_WARNING(MODULE_NAME, "%d workers share %d allowed CPUs",
+                            num_threads, num_cpus);
+        }
+    }
+    
+    g_pool.workers = (FSOPoolWorker*)calloc((size_t)num_threads, sizeof(FSOPoolWorker));
+    if (g_pool.workers == NULL) {
+        pthread_mutex_unlock(&g_pool.control);
+        return FSO_ERROR_MEMORY;
+    }
+    
+    atomic_store(&g_pool.stop, 0);
+    atomic_store(&g_pool.pending, 0);
+    
+    // Spinning only pays when every worker (and the submitter) has a CPU
+    g_pool.spin = (num_threads < fso_pool_allowed_cpus()) ? FSO_POOL_SPIN : 0;
+    
+    int started = 0;
+    for (; started < num_threads; started++) {
+        FSOPoolWorker* worker = &g_pool.workers[started];
+        worker->index = started;
+        worker->cpu = (num_cpus > 0) ? order[started % num_cpus] : -1;
+        worker->start_ticket = atomic_load(&g_pool.ticket);
+        if (pthread_create(&worker->thread, NULL, fso_pool_worker_main, worker) != 0) {
+            break;
+        }
+    }
+    
+    if (started == 0) {
+        free(g_pool.workers);
+        g_pool.workers = NULL;
+        pthread_mutex_unlock(&g_pool.control);
+        FSO_LOG_ERROR(MODULE_NAME, "Failed to start any worker thread");
+        return FSO_ERROR_MEMORY;
+    }
+    if (started < num_threads) {
+        FSO_LOG_WARNING(MODULE_NAME, "Started %d of %d workers", started, num_threads);
+    }
+    atomic_store(&g_pool.size, started);
+    
+    static const char* const mode_names[] = {"unpinned", "compact", "scatter"};
+    FSO_LOG_INFO(MODULE_NAME, "Started %d workers (%s, %d NUMA node(s))", started,
+                 mode_names[num_cpus > 0 ? affinity : FSO_AFFINITY_NONE], num_nodes);
+    
+    pthread_mutex_unlock(&g_pool.control);
+    return FSO_SUCCESS;
+#else
+    (void)config;
+    return FSO_SUCCESS;
+#endif
+}
+
+void fso_threadpool_shutdown(void) {
+#ifdef FSO_POOL_HAVE_THREADS
+    pthread_mutex_lock(&g_pool.control);
+    int size = atomic_load(&g_pool.size);
+    if (size == 0) {
+        pthread_mutex_unlock(&g_pool.control);
+        return;
+    }
+    
+    pthread_mutex_lock(&g_pool.wake_lock);
+    atomic_store(&g_pool.stop, 1);
+    pthread_cond_broadcast(&g_pool.wake);
+    pthread_mutex_unlock(&g_pool.wake_lock);
+    
+    for (int w = 0; w < size; w++) {
+        pthread_join(g_pool.workers[w].thread, NULL);
+    }
+    free(g_pool.workers);
+    g_pool.workers = NULL;
+    atomic_store(&g_pool.size, 0);
+    
+    pthread_mutex_unlock(&g_pool.control);
+#endif
+}
+
+int fso_threadpool_size(void) {
+#ifdef FSO_POOL_HAVE_THREADS
+    int size = atomic_load(&g_pool.size);
+    return (size > 0) ? size : 1;
+#else
+    return 1;
+#endif
+}
+
+int fso_threadpool_worker(void) {
+    return t_pool_worker;
+}
+
+void fso_parallel_for(size_t count, size_t grain, int max_workers,
+                      FSOParallelFn fn, void* context) {
+    if (count == 0 || fn == NULL) {
+        return;
+    }
+    
+#ifdef FSO_POOL_HAVE_THREADS
+    if (atomic_load(&g_pool.size) == 0 && t_pool_worker < 0) {
+        fso_threadpool_init(NULL);
+    }
+#endif
+    
+    int workers = fso_threadpool_size();
+    if (max_workers > 0) {
+        workers = FSO_MIN(workers, max_workers);
+    }
+    size_t units = (grain > 0) ? (count + grain - 1) / grain : count;
+    if (units < (size_t)workers) {
+        workers = (int)units;
+    }
+    
+#ifdef FSO_POOL_HAVE_THREADS
+    // Nested calls and calls during another thread's job stay on the caller
+    if (workers <= 1 || t_pool_worker >= 0 || pthread_mutex_trylock(&g_pool.submit) != 0) {
+        fso_pool_run_inline(count, grain, workers, fn, context);
+        return;
+    }
+    
+    g_pool.job.fn = fn;
+    g_pool.job.context = context;
+    g_pool.job.count = count;
+    g_pool.job.grain = grain;
+    atomic_store(&g_pool.job.next, 0);
+    atomic_store(&g_pool.pending, workers);
+    
+    uint64_t generation = (atomic_load(&g_pool.ticket) >> 16) + 1;
+    pthread_mutex_lock(&g_pool.wake_lock);
+    atomic_store_explicit(&g_pool.ticket, (generation << 16) | (uint64_t)workers,
+                          memory_order_release);
+    pthread_cond_broadcast(&g_pool.wake);
+    pthread_mutex_unlock(&g_pool.wake_lock);
+    
+    int finished = 0;
+    for (int spin = 0; spin < g_pool.spin && !finished; spin++) {
+        finished = (atomic_load_explicit(&g_pool.pending, memory_order_acquire) == 0);
+    }
+    if (!finished) {
+        pthread_mutex_lock(&g_pool.done_lock);
+        while (atomic_load(&g_pool.pending) > 0) {
+            pthread_cond_wait(&g_pool.done, &g_pool.done_lock);
+        }
+        pthread_mutex_unlock(&g_pool.done_lock);
+    }
+    
+    pthread_mutex_unlock(&g_pool.submit);
+#else
+    fso_pool_run_inline(count, grain, workers, fn, context);
+#endif
+}
@@ -64,6 +64,36 @@ double mock_signal_strength(double azimuth, double elevation, void* user_data) {
     return exp(-(az_term + el_term));
 }
 
+/**
+ * @brief Batched version of mock_signal_strength
+ * 
+ * user_data, if not NULL, counts the calls.
+ */
+int mock_signal_strength_batch(const double* azimuths, const double* elevations,
+                               size_t count, double* strengths, void* user_data) {
+    for (size_t i = 0; i < count; i++) {
+        strengths[i] = mock_signal_strength(azimuths[i], elevations[i], NULL);
+    }
+    if (user_data) {
+        (*(int*)user_data)++;
+    }
+    return FSO_SUCCESS;
+}
+
+/**
+ * @brief Batched measurement of a peak at a moving position
+ * 
+ * user_data points to the peak (azimuth, elevation).
+ */
+int mock_signal_strength_moving_batch(const double* azimuths, const double* elevations,
+                                      size_t count, double* strengths, void* user_data) {
+    const double* peak = (const double*)user_data;
+    for (size_t i = 0; i < count; i++) {
+        strengths[i] = mock_signal_strength(azimuths[i] - peak[0], elevations[i] - peak[1], NULL);
+    }
+    return FSO_SUCCESS;
+}
+
 /**
  * @brief Offset signal strength function for misalignment testing
  */
@@ -218,6 +248,61 @@ void test_beam_scanning(void) {
     beam_track_free(&tracker);
 }
 
+void test_batched_scan_modes(void) {
+    printf("\n=== Test: Batched Scan Modes ===\n");
+    
+    BeamTracker raster, tracker;
+    beam_track_init(&raster, 0.0, 0.0,
+                   TEST_MAP_SIZE, TEST_MAP_SIZE,
+                   TEST_MAP_RANGE, TEST_MAP_RANGE);
+    beam_track_init(&tracker, 0.0, 0.0,
+                   TEST_MAP_SIZE, TEST_MAP_SIZE,
+                   TEST_MAP_RANGE, TEST_MAP_RANGE);
+    
+    // Batched raster matches the point-by-point scan
+    BeamScanParams params;
+    BeamScanStats stats;
+    int calls = 0;
+    beam_scan_params_init(&params, BEAM_SCAN_RASTER, 0.02);
+    params.batch_size = 64;
+    beam_track_scan(&raster, 0.2, 0.2, 0.02, mock_signal_strength, NULL);
+    int result = beam_track_scan_batch(&tracker, 0.2, 0.2, &params,
+                                       mock_signal_strength_batch, &calls, &stats);
+    TEST_ASSERT(result == FSO_SUCCESS, "Batched raster scan completed");
+    TEST_ASSERT(stats.points_measured == 121 && stats.batches == 2 && calls == 2,
+                "Raster measured in batches of 64");
+    TEST_ASSERT(tracker.azimuth == raster.azimuth && tracker.elevation == raster.elevation,
+                "Batched raster peak matches point-by-point scan");
+    
+    // Hierarchical: far fewer points than a raster at the final resolution
+    tracker.azimuth = 0.13;
+    tracker.elevation = -0.11;
+    beam_scan_params_init(&params, BEAM_SCAN_HIERARCHICAL, 0.005);
+    result = beam_track_scan_batch(&tracker, 0.4, 0.4, &params,
+                                   mock_signal_strength_batch, NULL, &stats);
+    TEST_ASSERT(result == FSO_SUCCESS, "Hierarchical scan completed");
+    TEST_ASSERT(stats.levels == 3, "Hierarchical scan refined twice");
+    TEST_ASSERT(stats.points_measured < 81 * 81 / 10, "Hierarchical scan uses <10% of raster points");
+    TEST_ASSERT(fabs(tracker.azimuth) < 0.005 && fabs(tracker.elevation) < 0.005,
+                "Hierarchical peak within final resolution");
+    
+    // Spiral: stops once a measurement reaches the threshold
+    tracker.azimuth = 0.04;
+    tracker.elevation = 0.0;
+    beam_scan_params_init(&params, BEAM_SCAN_SPIRAL, 0.01);
+    params.stop_threshold = 0.9;
+    params.batch_size = 8;
+    result = beam_track_scan_batch(&tracker, 0.4, 0.4, &params,
+                                   mock_signal_strength_batch, NULL, &stats);
+    TEST_ASSERT(result == FSO_SUCCESS, "Spiral scan completed");
+    TEST_ASSERT(stats.early_stop == 1, "Spiral scan stopped early");
+    TEST_ASSERT(stats.points_measured < 41 * 41, "Spiral scan skipped the outer rings");
+    TEST_ASSERT(tracker.signal_strength >= 0.9, "Spiral peak above threshold");
+    
+    beam_track_free(&raster);
+    beam_track_free(&tracker);
+}
+
 void test_peak_finding(void) {
     printf("\n=== Test: Peak Finding ===\n");
     
@@ -344,6 +429,82 @@ void test_reacquisition(void) {
     beam_track_free(&tracker);
 }
 
+void test_batched_reacquisition(void) {
+    printf("\n=== Test: Batched Reacquisition ===\n");
+    
+    BeamTracker tracker;
+    beam_track_init(&tracker, 0.0, 0.0,
+                   TEST_MAP_SIZE, TEST_MAP_SIZE,
+                   TEST_MAP_RANGE, TEST_MAP_RANGE);
+    
+    // Simulate signal loss by moving far from peak
+    tracker.azimuth = 0.15;
+    tracker.elevation = 0.15;
+    tracker.signal_strength = 0.01;
+    tracker.misaligned = 1;
+    
+    BeamScanParams params;
+    BeamScanStats stats;
+    beam_scan_params_init(&params, BEAM_SCAN_HIERARCHICAL, 0.02);
+    int result = beam_track_reacquire_batch(&tracker, 0.4, 0.4, &params,
+                                            mock_signal_strength_batch, NULL, &stats);
+    TEST_ASSERT(result == FSO_SUCCESS, "Batched reacquisition successful");
+    TEST_ASSERT(fabs(tracker.azimuth) < 0.02, "Reacquired azimuth");
+    TEST_ASSERT(fabs(tracker.elevation) < 0.02, "Reacquired elevation");
+    TEST_ASSERT(tracker.misaligned == 0 && tracker.reacquisition_mode == 0, "Alignment restored");
+    TEST_ASSERT(stats.points_measured < 21 * 21, "Fewer measurements than a raster reacquisition");
+    
+    beam_track_free(&tracker);
+}
+
+void test_kalman_tracking(void) {
+    printf("\n=== Test: Kalman Tracking ===\n");
+    
+    BeamTracker tracker;
+    beam_track_init(&tracker, 0.0, 0.0,
+                   TEST_MAP_SIZE, TEST_MAP_SIZE,
+                   TEST_MAP_RANGE, TEST_MAP_RANGE);
+    
+    BeamKalmanParams params;
+    beam_kalman_params_init(&params, 100.0, 0.01);
+    TEST_ASSERT(beam_track_configure_kalman(&tracker, &params) == FSO_SUCCESS,
+                "Kalman tracking configured");
+    
+    // Platform sway: the peak circles at 0.5 Hz with 0.02 rad amplitude
+    int steps = 400;
+    int measured_steps = 0;
+    double error_sum = 0.0;
+    int error_count = 0;
+    for (int i = 0; i < steps; i++) {
+        double t = (i + 1) / 100.0;
+        double peak[2] = { 0.02 * sin(FSO_PI * t), 0.02 * cos(FSO_PI * t) - 0.02 };
+        int measured;
+        beam_track_kalman_update(&tracker, mock_signal_strength_moving_batch, peak, &measured);
+        measured_steps += measured;
+    
+        // Pointing error once the filter has picked up the motion
+        if (i >= 100) {
+            double az_error = tracker.azimuth - peak[0];
+            double el_error = tracker.elevation - peak[1];
+            error_sum += az_error * az_error + el_error * el_error;
+            error_count++;
+        }
+    }
+    double rms_error = sqrt(error_sum / error_count);
+    
+    TEST_ASSERT(rms_error < 0.01, "Kalman tracker follows the sway");
+    TEST_ASSERT(tracker.kalman->measurements * 3 <= steps,
+                "At least 3x fewer measurements than one per control step");
+    TEST_ASSERT(measured_steps == tracker.kalman->dithers, "Dither steps reported");
+    TEST_ASSERT(tracker.kalman->rejected == 0, "Every dither gave a position fix");
+    
+    params.dither_interval = 0;
+    TEST_ASSERT(beam_track_configure_kalman(&tracker, &params) == FSO_ERROR_INVALID_PARAM,
+                "Invalid dither interval rejected");
+    
+    beam_track_free(&tracker);
+}
+
 void test_pid_tracking(void) {
     printf("\n=== Test: PID Tracking ===\n");
     
@@ -371,6 +532,103 @@ void test_pid_tracking(void) {
     beam_track_free(&tracker);
 }
 
+void test_tracker_bank(void) {
+    printf("\n=== Test: Tracker Bank ===\n");
+    
+    enum { BANK_SIZE = 64 };
+    double initial_az[BANK_SIZE], initial_el[BANK_SIZE];
+    for (int i = 0; i < BANK_SIZE; i++) {
+        initial_az[i] = 0.001 * (i - BANK_SIZE / 2);
+        initial_el[i] = 0.0005 * (i % 7);
+    }
+    
+    BeamTrackerBank bank;
+    TEST_ASSERT(beam_bank_init(&bank, BANK_SIZE, initial_az, initial_el) == FSO_SUCCESS,
+                "Bank initialization successful");
+    beam_bank_configure_pid(&bank, 0.5, 0.05, 0.01, 100.0, 0.5);
+    
+    // Reference trackers, stepped one at a time
+    BeamTracker reference[BANK_SIZE];
+    for (int i = 0; i < BANK_SIZE; i++) {
+        beam_track_init(&reference[i], initial_az[i], initial_el[i],
+                       TEST_MAP_SIZE, TEST_MAP_SIZE, TEST_MAP_RANGE, TEST_MAP_RANGE);
+        beam_track_configure_pid(&reference[i], 0.5, 0.05, 0.01, 100.0, 0.5);
+    }
+    
+    double target_az[BANK_SIZE] = {0.0}, target_el[BANK_SIZE] = {0.0};
+    double strengths[BANK_SIZE];
+    for (int step = 0; step < 20; step++) {
+        for (int i = 0; i < BANK_SIZE; i++) {
+            strengths[i] = mock_signal_strength(bank.azimuth[i], bank.elevation[i], NULL);
+            beam_track_pid_update(&reference[i], target_az[i], target_el[i], strengths[i]);
+        }
+        beam_bank_pid_update(&bank, target_az, target_el, strengths);
+    }
+    
+    double max_diff = 0.0;
+    for (int i = 0; i < BANK_SIZE; i++) {
+        max_diff = fmax(max_diff, fabs(bank.azimuth[i] - reference[i].azimuth));
+        max_diff = fmax(max_diff, fabs(bank.elevation[i] - reference[i].elevation));
+    }
+    TEST_ASSERT(max_diff < 1e-12, "Bank PID matches single-tracker PID");
+    
+    // Gradient ascent with the analytic gradient of the mock peak, with
+    // steps scaled to its width
+    double grad_az[BANK_SIZE], grad_el[BANK_SIZE];
+    double before = 0.0, after = 0.0;
+    bank.momentum = 0.5;
+    bank.step_size_min = 1e-5;
+    bank.step_size_max = 1e-3;
+    for (int i = 0; i < BANK_SIZE; i++) {
+        bank.azimuth[i] = initial_az[i];
+        bank.elevation[i] = initial_el[i];
+        bank.step_size[i] = 1e-4;
+        before += mock_signal_strength(bank.azimuth[i], bank.elevation[i], NULL);
+    }
+    for (int step = 0; step < 20; step++) {
+        for (int i = 0; i < BANK_SIZE; i++) {
+            strengths[i] = mock_signal_strength(bank.azimuth[i], bank.elevation[i], NULL);
+            grad_az[i] = -strengths[i] * bank.azimuth[i] / (0.05 * 0.05);
+            grad_el[i] = -strengths[i] * bank.elevation[i] / (0.05 * 0.05);
+        }
+        beam_bank_update(&bank, strengths, grad_az, grad_el);
+    }
+    for (int i = 0; i < BANK_SIZE; i++) {
+        after += mock_signal_strength(bank.azimuth[i], bank.elevation[i], NULL);
+    }
+    TEST_ASSERT(after > before, "Bank gradient update improved signal strength");
+    
+    // Half the links lose signal
+    size_t misaligned = 0;
+    for (int i = 0; i < BANK_SIZE; i++) {
+        strengths[i] = (i % 2) ? 0.05 : 0.9;
+    }
+    beam_bank_check_misalignment(&bank, strengths, &misaligned);
+    TEST_ASSERT(misaligned == BANK_SIZE / 2, "Misaligned trackers counted");
+    TEST_ASSERT(bank.misaligned[1] == 1 && bank.misaligned[0] == 0, "Misalignment flags set");
+    
+    strengths[0] = -1.0;
+    TEST_ASSERT(beam_bank_check_misalignment(&bank, strengths, NULL) == FSO_ERROR_INVALID_PARAM,
+                "Negative strength rejected");
+    
+    // Single-tracker view round trip
+    BeamTracker view;
+    beam_track_init(&view, 0.0, 0.0, TEST_MAP_SIZE, TEST_MAP_SIZE, TEST_MAP_RANGE, TEST_MAP_RANGE);
+    TEST_ASSERT(beam_bank_load(&bank, 5, &view) == FSO_SUCCESS, "Tracker view loaded");
+    TEST_ASSERT(view.azimuth == bank.azimuth[5] && view.pid->kp == 0.5, "View holds bank state");
+    view.azimuth = 0.0125;
+    beam_bank_store(&bank, 5, &view);
+    TEST_ASSERT(bank.azimuth[5] == 0.0125, "View stored back into bank");
+    TEST_ASSERT(beam_bank_load(&bank, BANK_SIZE, &view) == FSO_ERROR_INVALID_PARAM,
+                "Out-of-range index rejected");
+    
+    beam_track_free(&view);
+    for (int i = 0; i < BANK_SIZE; i++) {
+        beam_track_free(&reference[i]);
+    }
+    beam_bank_free(&bank);
+}
+
 /* ============================================================================
  * Main Test Runner
  * ============================================================================ */
@@ -390,12 +648,16 @@ int main(void) {
     test_beam_tracker_init();
     test_gradient_estimation();
     test_beam_scanning();
+    test_batched_scan_modes();
     test_peak_finding();
     test_gradient_descent_update();
     test_misalignment_detection();
     test_calibration();
     test_reacquisition();
+    test_batched_reacquisition();
+    test_kalman_tracking();
     test_pid_tracking();
+    test_tracker_bank();
     
     // Print summary
     printf("\n========================================\n");
@@ -0,0 +1,480 @@
+/**
+ * @file test_fec.c
+ * @brief Test suite for forward error correction and interleaving
+ */
+
+#include "../src/fec/fec.h"
+#include "../src/fec/ldpc.h"
+#include "../src/fec/reed_solomon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test configuration */
+#define TEST_SEED 20240611ULL
+#define TEST_BATCH_WORDS 40          // Two full lane groups and a short one
+#define TEST_EBN0_DB 3.0             // Every word decodes, the raw input does not
+
+/* Global test state */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Helper macros */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            tests_passed++; \
+            printf("  [PASS] %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("  [FAIL] %s\n", message); \
+        } \
+    } while(0)
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Set up an LDPC codec for the standard code of a rate
+ *
+ * seed selects the random regular construction (0 = structured).
+ */
+static int init_ldpc(LDPCCodec* ldpc, int n, int k, unsigned int seed, int lifting_size) {
+    LDPCConfig config = {
+        .num_variable_nodes = n,
+        .num_check_nodes = n - k,
+        .max_iterations = 50,
+        .convergence_threshold = 0.001,
+        .parity_check_matrix = NULL,
+        .matrix_rows = n - k,
+        .matrix_cols = n,
+        .check_node_algorithm = LDPC_CHECK_NORMALIZED_MIN_SUM,
+        .schedule = LDPC_SCHEDULE_FLOODING,
+        .llr_format = LDPC_LLR_FLOAT,
+        .matrix_seed = seed,
+        .lifting_size = lifting_size
+    };
+    
+    if (ldpc_init(ldpc, &config, n, k) != FSO_SUCCESS) {
+        return 0;
+    }
+    if (ldpc_acquire_standard_code(ldpc, (double)k / n) != FSO_SUCCESS) {
+        ldpc_free(ldpc);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Whether a one-bit-per-byte word satisfies every check of H
+ */
+static int ldpc_syndrome_zero(const LDPCCodec* ldpc, const uint8_t* codeword) {
+    for (int c = 0; c < ldpc->m; c++) {
+        int parity = 0;
+        for (int e = ldpc->H->row_ptr[c]; e < ldpc->H->row_ptr[c + 1]; e++) {
+            parity ^= codeword[ldpc->H->col_indices[e]] & 1;
+        }
+        if (parity) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Encode random words and send them over BPSK/AWGN
+ *
+ * Fills data (words * k bits), codewords (words * n bits) and the channel
+ * LLRs (words * n); returns the number of raw hard-decision errors.
+ */
+static int make_noisy_words(LDPCCodec* ldpc, int words, uint8_t* data, uint8_t* codewords,
+                            float* llr) {
+    const double rate = (double)ldpc->k / ldpc->n;
+    const double sigma2 = 1.0 / (2.0 * rate * pow(10.0, TEST_EBN0_DB / 10.0));
+    int raw_errors = 0;
+    
+    for (int w = 0; w < words; w++) {
+        FSORandomStream stream;
+        uint8_t* bits = data + (size_t)w * ldpc->k;
+        uint8_t* cw = codewords + (size_t)w * ldpc->n;
+        
+        fso_random_stream_init(&stream, TEST_SEED, (uint32_t)w, FSO_RNG_STREAM_DATA);
+        fso_random_stream_bytes_fill(&stream, bits, (size_t)ldpc->k);
+        for (int i = 0; i < ldpc->k; i++) {
+            bits[i] &= 1;
+        }
+        size_t encoded_len = (size_t)ldpc->n;
+        ldpc_encode(ldpc, bits, (size_t)ldpc->k, cw, &encoded_len);
+        
+        fso_random_stream_init(&stream, TEST_SEED, (uint32_t)w, FSO_RNG_STREAM_NOISE);
+        for (int i = 0; i < ldpc->n; i++) {
+            double y = (cw[i] ? -1.0 : 1.0) + fso_random_stream_gaussian(&stream, 0.0, sqrt(sigma2));
+            llr[(size_t)w * ldpc->n + i] = (float)(2.0 * y / sigma2);
+            raw_errors += (y < 0.0) != (cw[i] != 0);
+        }
+    }
+    return raw_errors;
+}
+
+/* ============================================================================
+ * LDPC Tests
+ * ============================================================================ */
+
+/**
+ * @brief Packed and unpacked encoders give the same valid codewords
+ */
+static void test_ldpc_encoders(void) {
+    printf("\n=== Test: LDPC Packed vs Unpacked Encoding ===\n");
+    
+    static const struct { int n, k, lifting; const char* name; } codes[] = {
+        { 1024, 512, 0, "structured (1024, 512)" },
+        { 1536, 1024, 0, "structured (1536, 1024)" },
+        { 1944, 972, 81, "quasi-cyclic (1944, 972), Z = 81" }
+    };
+    
+    for (size_t c = 0; c < sizeof(codes) / sizeof(codes[0]); c++) {
+        LDPCCodec ldpc;
+        char message[128];
+        
+        if (!init_ldpc(&ldpc, codes[c].n, codes[c].k, 0, codes[c].lifting)) {
+            snprintf(message, sizeof(message), "%s codec initialized", codes[c].name);
+            TEST_ASSERT(0, message);
+            continue;
+        }
+        
+        const int n = ldpc.n;
+        const int k = ldpc.k;
+        uint8_t* bits = (uint8_t*)malloc((size_t)k);
+        uint8_t* packed = (uint8_t*)malloc((size_t)(k + 7) / 8);
+        uint8_t* encoded = (uint8_t*)malloc((size_t)n);
+        uint8_t* encoded_packed = (uint8_t*)malloc((size_t)(n + 7) / 8);
+        int same = 1;
+        int valid = 1;
+        
+        for (int w = 0; w < 8; w++) {
+            FSORandomStream stream;
+            fso_random_stream_init(&stream, TEST_SEED, (uint32_t)w, FSO_RNG_STREAM_DATA);
+            fso_random_stream_bytes_fill(&stream, bits, (size_t)k);
+            memset(packed, 0, (size_t)(k + 7) / 8);
+            for (int i = 0; i < k; i++) {
+                bits[i] &= 1;
+                packed[i / 8] |= (uint8_t)(bits[i] << (7 - i % 8));
+            }
+            
+            size_t encoded_len = (size_t)n;
+            size_t packed_len = (size_t)(n + 7) / 8;
+            if (ldpc_encode(&ldpc, bits, (size_t)k, encoded, &encoded_len) != FSO_SUCCESS ||
+                ldpc_encode_packed(&ldpc, packed, (size_t)(k + 7) / 8, encoded_packed,
+                                   &packed_len) != FSO_SUCCESS) {
+                same = 0;
+                valid = 0;
+                break;
+            }
+            
+            for (int i = 0; i < n; i++) {
+                same &= encoded[i] == ((encoded_packed[i / 8] >> (7 - i % 8)) & 1);
+            }
+            valid &= ldpc_syndrome_zero(&ldpc, encoded) && memcmp(encoded, bits, (size_t)k) == 0;
+        }
+        
+        snprintf(message, sizeof(message), "%s: packed encoder matches unpacked", codes[c].name);
+        TEST_ASSERT(same, message);
+        snprintf(message, sizeof(message), "%s: systematic codewords with zero syndrome",
+                 codes[c].name);
+        TEST_ASSERT(valid, message);
+        
+        free(bits);
+        free(packed);
+        free(encoded);
+        free(encoded_packed);
+        ldpc_free(&ldpc);
+    }
+}
+
+/**
+ * @brief Batched decoding matches the single-word float decoder
+ *
+ * Every schedule and message format decodes the same noisy words. On the
+ * random code the single-word decoder corrects every word and each batched
+ * configuration must too. The structured codes leave words uncorrected,
+ * which runs the decoder to max_iterations and drives the fixed-point
+ * messages into saturation; there the batched result must stay within 10%
+ * of the single-word bit errors for the same schedule.
+ */
+static void test_ldpc_batch_decode(void) {
+    printf("\n=== Test: LDPC Batch vs Single-Word Decoding ===\n");
+    
+    static const LDPCSchedule schedules[] = { LDPC_SCHEDULE_FLOODING, LDPC_SCHEDULE_LAYERED };
+    static const char* schedule_names[] = { "flooding", "layered" };
+    static const LDPCLLRFormat formats[] = { LDPC_LLR_FLOAT, LDPC_LLR_INT16, LDPC_LLR_INT8 };
+    static const char* format_names[] = { "float", "int16", "int8" };
+    static const struct { int n, k; unsigned int seed; } codes[] = {
+        { 1024, 512, 1 }, { 1024, 512, 0 }, { 1536, 768, 0 }
+    };
+    
+    for (size_t c = 0; c < sizeof(codes) / sizeof(codes[0]); c++) {
+        LDPCCodec ldpc;
+        char name[64];
+        char message[160];
+        
+        snprintf(name, sizeof(name), "(%d, %d) %s", codes[c].n, codes[c].k,
+                 codes[c].seed ? "random" : "structured");
+        if (!init_ldpc(&ldpc, codes[c].n, codes[c].k, codes[c].seed, 0)) {
+            snprintf(message, sizeof(message), "%s codec initialized", name);
+            TEST_ASSERT(0, message);
+            continue;
+        }
+        
+        const int n = ldpc.n;
+        const int k = ldpc.k;
+        const int words = TEST_BATCH_WORDS;
+        uint8_t* data = (uint8_t*)malloc((size_t)words * k);
+        uint8_t* codewords = (uint8_t*)malloc((size_t)words * n);
+        uint8_t* decoded = (uint8_t*)malloc((size_t)words * k);
+        float* llr = (float*)malloc((size_t)words * n * sizeof(float));
+        
+        int raw_errors = make_noisy_words(&ldpc, words, data, codewords, llr);
+        snprintf(message, sizeof(message), "%s: channel leaves %d raw bit errors", name, raw_errors);
+        TEST_ASSERT(raw_errors > 0, message);
+        
+        for (int s = 0; s < 2; s++) {
+            // Reference: single-word decoder, float messages
+            ldpc.schedule = schedules[s];
+            ldpc.llr_format = LDPC_LLR_FLOAT;
+            for (int w = 0; w < words; w++) {
+                ldpc_decode_soft(&ldpc, llr + (size_t)w * n, 1, decoded + (size_t)w * k,
+                                 (size_t)k, NULL);
+            }
+            int single_errors = (int)fso_count_bit_errors(data, decoded, (size_t)words * k);
+            if (codes[c].seed) {
+                snprintf(message, sizeof(message), "%s %s: single-word decoder corrects every word",
+                         name, schedule_names[s]);
+                TEST_ASSERT(single_errors == 0, message);
+            }
+            
+            for (int f = 0; f < 3; f++) {
+                int converged[TEST_BATCH_WORDS];
+                
+                ldpc.llr_format = formats[f];
+                memset(decoded, 0xFF, (size_t)words * k);
+                int result = ldpc_decode_batch_soft(&ldpc, llr, 1, (size_t)words, decoded,
+                                                    NULL, converged);
+                
+                int errors = (int)fso_count_bit_errors(data, decoded, (size_t)words * k);
+                int all_converged = 1;
+                for (int w = 0; w < words; w++) {
+                    all_converged &= converged[w];
+                }
+                
+                snprintf(message, sizeof(message), "%s %s %s: %d bit errors (single-word %d)",
+                         name, schedule_names[s], format_names[f], errors, single_errors);
+                if (single_errors == 0) {
+                    TEST_ASSERT(result == FSO_SUCCESS && errors == 0 && all_converged, message);
+                } else {
+                    TEST_ASSERT(result == FSO_SUCCESS && errors <= single_errors * 11 / 10,
+                                message);
+                }
+            }
+        }
+        
+        free(data);
+        free(codewords);
+        free(decoded);
+        free(llr);
+        ldpc_free(&ldpc);
+    }
+}
+
+/**
+ * @brief Codecs of the same code share one cache entry
+ */
+static void test_ldpc_graph_cache(void) {
+    printf("\n=== Test: LDPC Graph Cache ===\n");
+    
+    LDPCCodec a, b;
+    int ok_a = init_ldpc(&a, 1024, 512, 0, 0);
+    int ok_b = init_ldpc(&b, 1024, 512, 0, 0);
+    TEST_ASSERT(ok_a && ok_b, "Two codecs of one code initialized");
+    if (!ok_a || !ok_b) {
+        if (ok_a) ldpc_free(&a);
+        if (ok_b) ldpc_free(&b);
+        return;
+    }
+    
+    TEST_ASSERT(a.graph != NULL && a.graph == b.graph, "Codecs attached to the same entry");
+    TEST_ASSERT(a.H == b.H, "Parity-check matrix shared");
+    TEST_ASSERT(ldpc_graph_cache_clear() >= 1, "Entry in use survives a clear");
+    
+    ldpc_free(&a);
+    TEST_ASSERT(b.H != NULL && b.H->rows == 512, "Entry outlives one of its codecs");
+    ldpc_free(&b);
+    TEST_ASSERT(ldpc_graph_cache_clear() == 0, "Unreferenced entries released");
+}
+
+/* ============================================================================
+ * Reed-Solomon Tests
+ * ============================================================================ */
+
+/**
+ * @brief RS(255, 223) corrects errors and erasures within 2e + f <= 32
+ */
+static void test_reed_solomon(void) {
+    printf("\n=== Test: Reed-Solomon Errors and Erasures ===\n");
+    
+    RSConfig config = {
+        .symbol_size = 8,
+        .num_roots = 32,
+        .first_root = 1,
+        .primitive_poly = 0x11d,
+        .fcr = 1
+    };
+    RSCodec rs;
+    TEST_ASSERT(rs_init(&rs, &config, 255, 223) == FSO_SUCCESS, "RS(255, 223) initialized");
+    
+    uint8_t data[223];
+    uint8_t encoded[255];
+    uint8_t received[255];
+    uint8_t decoded[223];
+    FSORandomStream stream;
+    
+    fso_random_stream_init(&stream, TEST_SEED, 0, FSO_RNG_STREAM_DATA);
+    fso_random_stream_bytes_fill(&stream, data, sizeof(data));
+    size_t encoded_len = sizeof(encoded);
+    rs_encode(&rs, data, sizeof(data), encoded, &encoded_len);
+    
+    static const struct { int errors, erasures; } cases[] = {
+        { 0, 0 }, { 16, 0 }, { 0, 32 }, { 8, 16 }, { 12, 8 }
+    };
+    
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int positions[64];
+        int corrected = -1;
+        char message[128];
+        
+        // Distinct positions: erasures first, then errors
+        memcpy(received, encoded, sizeof(received));
+        int total = cases[c].erasures + cases[c].errors;
+        for (int i = 0; i < total; i++) {
+            positions[i] = (37 + i * 53) % 255;
+            received[positions[i]] ^= (uint8_t)(1 + (i * 29) % 255);
+        }
+        
+        int result = rs_decode_erasures(&rs, received, sizeof(received), positions,
+                                        cases[c].erasures, decoded, sizeof(decoded), &corrected);
+        snprintf(message, sizeof(message), "%d errors + %d erasures corrected",
+                 cases[c].errors, cases[c].erasures);
+        TEST_ASSERT(result == FSO_SUCCESS && memcmp(decoded, data, sizeof(data)) == 0, message);
+    }
+    
+    // One symbol past the capability
+    memcpy(received, encoded, sizeof(received));
+    for (int i = 0; i < 17; i++) {
+        received[(37 + i * 53) % 255] ^= 0x5A;
+    }
+    int result = rs_decode(&rs, received, sizeof(received), decoded, sizeof(decoded), NULL);
+    TEST_ASSERT(result == FSO_ERROR_CONVERGENCE, "17 errors reported uncorrectable");
+    
+    rs_free(&rs);
+}
+
+/* ============================================================================
+ * Interleaver Tests
+ * ============================================================================ */
+
+/**
+ * @brief Every permutation family round-trips and moves the data
+ */
+static void test_interleavers(void) {
+    printf("\n=== Test: Interleaver Round Trips ===\n");
+    
+    enum { BLOCK = 16, DEPTH = 8, FRAME = BLOCK * DEPTH, LENGTH = 3 * FRAME + 37 };
+    static const InterleaverType types[] = {
+        INTERLEAVER_BLOCK, INTERLEAVER_RANDOM, INTERLEAVER_S_RANDOM,
+        INTERLEAVER_CONVOLUTIONAL, INTERLEAVER_CUSTOM
+    };
+    
+    uint8_t input[LENGTH];
+    uint8_t interleaved[LENGTH];
+    uint8_t restored[LENGTH];
+    for (int i = 0; i < LENGTH; i++) {
+        input[i] = (uint8_t)(i * 7 + 3);
+    }
+    
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        InterleaverConfig config;
+        char message[128];
+        int result;
+        
+        if (types[t] == INTERLEAVER_CUSTOM) {
+            int table[FRAME];
+            for (int i = 0; i < FRAME; i++) {
+                table[i] = (i * 37 + 11) % FRAME;
+            }
+            result = interleaver_set_permutation(&config, table, BLOCK, DEPTH);
+        } else {
+            result = interleaver_init_permutation(&config, types[t], BLOCK, DEPTH, 7, 0);
+        }
+        snprintf(message, sizeof(message), "%s interleaver initialized",
+                 interleaver_type_string(types[t]));
+        TEST_ASSERT(result == FSO_SUCCESS, message);
+        if (result != FSO_SUCCESS) {
+            continue;
+        }
+        
+        interleave(&config, input, LENGTH, interleaved, LENGTH);
+        deinterleave(&config, interleaved, LENGTH, restored, LENGTH);
+        
+        snprintf(message, sizeof(message), "%s: deinterleave restores the input",
+                 interleaver_type_string(types[t]));
+        TEST_ASSERT(memcmp(input, restored, LENGTH) == 0, message);
+        snprintf(message, sizeof(message), "%s: frames permuted, partial tail copied",
+                 interleaver_type_string(types[t]));
+        TEST_ASSERT(memcmp(input, interleaved, 3 * FRAME) != 0 &&
+                    memcmp(input + 3 * FRAME, interleaved + 3 * FRAME, LENGTH - 3 * FRAME) == 0,
+                    message);
+        
+        interleaver_free(&config);
+    }
+    
+    // Rejected tables
+    InterleaverConfig config;
+    int duplicate[FRAME];
+    for (int i = 0; i < FRAME; i++) {
+        duplicate[i] = i / 2;
+    }
+    TEST_ASSERT(interleaver_set_permutation(&config, duplicate, BLOCK, DEPTH) ==
+                FSO_ERROR_INVALID_PARAM, "Non-permutation table rejected");
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void) {
+    printf("========================================\n");
+    printf("FEC Test Suite\n");
+    printf("========================================\n");
+    
+    // Uncorrectable words are expected; keep their warnings out of the output
+    fso_set_log_level(LOG_ERROR);
+    
+    // Run tests
+    test_ldpc_encoders();
+    test_ldpc_batch_decode();
+    test_ldpc_graph_cache();
+    test_reed_solomon();
+    test_interleavers();
+    
+    // Print summary
+    printf("\n========================================\n");
+    printf("Test Summary\n");
+    printf("========================================\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+    printf("Total:  %d\n", tests_passed + tests_failed);
+    printf("========================================\n");
+    
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file test_random.c
+ * @brief Test suite for counter-based random streams and their thread independence
+ */
+
+#include "../src/fso.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test configuration */
+#define TEST_SEED 20240611ULL
+#define TEST_SAMPLES 20000           // Moment checks: ~0.007 standard error on the mean
+#define TEST_PACKETS 257             // Not a multiple of any worker count
+#define TEST_DRAWS_PER_PACKET 150    // Crosses a Philox buffer boundary
+
+/* Global test state */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Helper macros */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            tests_passed++; \
+            printf("  [PASS] %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("  [FAIL] %s\n", message); \
+        } \
+    } while(0)
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Whether two streams produce the same first count words
+ */
+static int streams_match(FSORandomStream* a, FSORandomStream* b, int count) {
+    for (int i = 0; i < count; i++) {
+        if (fso_random_stream_next(a) != fso_random_stream_next(b)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Whether the stream of (seed, packet, stream_id) matches the reference stream
+ */
+static int triple_matches(uint64_t seed, uint32_t packet, uint32_t stream_id,
+                          uint64_t ref_seed, uint32_t ref_packet, uint32_t ref_stream_id) {
+    FSORandomStream a;
+    FSORandomStream b;
+    
+    fso_random_stream_init(&a, seed, packet, stream_id);
+    fso_random_stream_init(&b, ref_seed, ref_packet, ref_stream_id);
+    return streams_match(&a, &b, 2 * FSO_RNG_BUFFER_WORDS);
+}
+
+/**
+ * @brief Sample correlation of the uniforms of two streams
+ */
+static double uniform_correlation(FSORandomStream* a, FSORandomStream* b, int count) {
+    double sum_a = 0.0, sum_b = 0.0, sum_aa = 0.0, sum_bb = 0.0, sum_ab = 0.0;
+    
+    for (int i = 0; i < count; i++) {
+        double x = fso_random_stream_uniform(a);
+        double y = fso_random_stream_uniform(b);
+        sum_a += x;
+        sum_b += y;
+        sum_aa += x * x;
+        sum_bb += y * y;
+        sum_ab += x * y;
+    }
+    
+    double cov = sum_ab / count - (sum_a / count) * (sum_b / count);
+    double var_a = sum_aa / count - (sum_a / count) * (sum_a / count);
+    double var_b = sum_bb / count - (sum_b / count) * (sum_b / count);
+    return cov / sqrt(var_a * var_b);
+}
+
+/* ============================================================================
+ * Stream Tests
+ * ============================================================================ */
+
+/**
+ * @brief Each (seed, packet, stream) triple names one reproducible, distinct stream
+ */
+static void test_stream_independence(void) {
+    printf("\n=== Test: Stream Determinism and Independence ===\n");
+    
+    TEST_ASSERT(triple_matches(TEST_SEED, 7, FSO_RNG_STREAM_NOISE,
+                               TEST_SEED, 7, FSO_RNG_STREAM_NOISE),
+                "Same (seed, packet, stream) reproduces the stream");
+    TEST_ASSERT(!triple_matches(TEST_SEED + 1, 7, FSO_RNG_STREAM_NOISE,
+                                TEST_SEED, 7, FSO_RNG_STREAM_NOISE),
+                "Different run seeds give different streams");
+    TEST_ASSERT(!triple_matches(TEST_SEED, 8, FSO_RNG_STREAM_NOISE,
+                                TEST_SEED, 7, FSO_RNG_STREAM_NOISE),
+                "Different packets give different streams");
+    TEST_ASSERT(!triple_matches(TEST_SEED, 7, FSO_RNG_STREAM_ROUND(FSO_RNG_STREAM_NOISE, 1),
+                                TEST_SEED, 7, FSO_RNG_STREAM_NOISE),
+                "HARQ rounds give different streams");
+    TEST_ASSERT(!triple_matches(TEST_SEED, 1, 0, TEST_SEED, 0, 1),
+                "Packet and stream words are not interchangeable");
+    
+    int distinct = 1;
+    for (uint32_t a = FSO_RNG_STREAM_DATA; a <= FSO_RNG_STREAM_TRACKING; a++) {
+        for (uint32_t b = a + 1; b <= FSO_RNG_STREAM_TRACKING; b++) {
+            if (triple_matches(TEST_SEED, 7, a, TEST_SEED, 7, b)) {
+                distinct = 0;
+            }
+        }
+    }
+    TEST_ASSERT(distinct, "Every stream id of a packet gives a different stream");
+    
+    // Neighbouring counters must not be correlated (|r| < 5 standard errors)
+    FSORandomStream a;
+    FSORandomStream b;
+    double limit = 5.0 / sqrt((double)TEST_SAMPLES);
+    
+    fso_random_stream_init(&a, TEST_SEED, 0, FSO_RNG_STREAM_DATA);
+    fso_random_stream_init(&b, TEST_SEED, 1, FSO_RNG_STREAM_DATA);
+    double r_packet = uniform_correlation(&a, &b, TEST_SAMPLES);
+    fso_random_stream_init(&a, TEST_SEED, 0, FSO_RNG_STREAM_NOISE);
+    fso_random_stream_init(&b, TEST_SEED, 0, FSO_RNG_STREAM_CHANNEL);
+    double r_stream = uniform_correlation(&a, &b, TEST_SAMPLES);
+    printf("  Correlation: adjacent packets %.4f, adjacent streams %.4f\n", r_packet, r_stream);
+    TEST_ASSERT(fabs(r_packet) < limit, "Adjacent packets uncorrelated");
+    TEST_ASSERT(fabs(r_stream) < limit, "Adjacent stream ids uncorrelated");
+}
+
+/**
+ * @brief Uniform and Gaussian draws have the right moments
+ */
+static void test_stream_moments(void) {
+    printf("\n=== Test: Stream Moments ===\n");
+    
+    FSORandomStream stream;
+    double sum = 0.0, sum_sq = 0.0;
+    double min = 1.0, max = 0.0;
+    
+    fso_random_stream_init(&stream, TEST_SEED, 3, FSO_RNG_STREAM_CHANNEL);
+    for (int i = 0; i < TEST_SAMPLES; i++) {
+        double u = fso_random_stream_uniform(&stream);
+        sum += u;
+        sum_sq += u * u;
+        min = fmin(min, u);
+        max = fmax(max, u);
+    }
+    double mean = sum / TEST_SAMPLES;
+    double var = sum_sq / TEST_SAMPLES - mean * mean;
+    printf("  Uniform: mean %.4f, variance %.5f\n", mean, var);
+    TEST_ASSERT(min >= 0.0 && max < 1.0, "Uniform draws in [0, 1)");
+    TEST_ASSERT(fabs(mean - 0.5) < 0.01 && fabs(var - 1.0 / 12.0) < 0.003,
+                "Uniform mean 1/2, variance 1/12");
+    
+    double* samples = malloc(TEST_SAMPLES * sizeof(double));
+    if (samples == NULL) {
+        TEST_ASSERT(0, "Sample buffer allocated");
+        return;
+    }
+    
+    fso_random_stream_init(&stream, TEST_SEED, 3, FSO_RNG_STREAM_NOISE);
+    fso_random_stream_gaussian_fill(&stream, samples, TEST_SAMPLES, 2.0);
+    sum = 0.0;
+    sum_sq = 0.0;
+    for (int i = 0; i < TEST_SAMPLES; i++) {
+        sum += samples[i];
+        sum_sq += samples[i] * samples[i];
+    }
+    mean = sum / TEST_SAMPLES;
+    var = sum_sq / TEST_SAMPLES - mean * mean;
+    printf("  Gaussian (stddev 2): mean %.4f, variance %.4f\n", mean, var);
+    TEST_ASSERT(fabs(mean) < 0.05 && fabs(var - 4.0) < 0.2, "Gaussian mean 0, variance 4");
+    
+    free(samples);
+}
+
+/**
+ * @brief Bulk fills and the thread-local API consume the same draws as single calls
+ */
+static void test_fill_consistency(void) {
+    printf("\n=== Test: Fill and Thread-Local Consistency ===\n");
+    
+    enum { COUNT = 3 * FSO_RNG_BUFFER_WORDS + 5 };
+    double filled[COUNT];
+    double single[COUNT];
+    double local[COUNT];
+    float filled_f32[COUNT];
+    FSORandomStream stream;
+    
+    fso_random_stream_init(&stream, TEST_SEED, 11, FSO_RNG_STREAM_NOISE);
+    fso_random_stream_gaussian_fill(&stream, filled, COUNT, 0.5);
+    fso_random_stream_init(&stream, TEST_SEED, 11, FSO_RNG_STREAM_NOISE);
+    for (int i = 0; i < COUNT; i++) {
+        single[i] = fso_random_stream_gaussian(&stream, 0.0, 0.5);
+    }
+    TEST_ASSERT(memcmp(filled, single, sizeof(filled)) == 0,
+                "Gaussian fill matches single draws");
+    
+    fso_random_stream_init(&stream, TEST_SEED, 11, FSO_RNG_STREAM_NOISE);
+    fso_random_stream_gaussian_fill_f32(&stream, filled_f32, COUNT, 0.5);
+    int rounded = 1;
+    for (int i = 0; i < COUNT; i++) {
+        if (filled_f32[i] != (float)filled[i]) {
+            rounded = 0;
+        }
+    }
+    TEST_ASSERT(rounded, "Single-precision fill is the rounded double fill");
+    
+    fso_random_select_stream(TEST_SEED, 11, FSO_RNG_STREAM_NOISE);
+    fso_random_gaussian_fill(local, COUNT, 0.5);
+    TEST_ASSERT(memcmp(filled, local, sizeof(filled)) == 0,
+                "Selected thread stream matches the explicit stream");
+    
+    // Re-selecting restarts the stream regardless of earlier draws
+    fso_random_select_stream(TEST_SEED, 11, FSO_RNG_STREAM_NOISE);
+    double first = fso_random_gaussian(0.0, 0.5);
+    TEST_ASSERT(first == filled[0], "Re-selecting a stream restarts it");
+    
+    uint8_t bytes_a[2 * FSO_RNG_BUFFER_WORDS * 4 + 3];
+    uint8_t bytes_b[sizeof(bytes_a)];
+    fso_random_stream_init(&stream, TEST_SEED, 11, FSO_RNG_STREAM_DATA);
+    fso_random_stream_bytes_fill(&stream, bytes_a, sizeof(bytes_a));
+    fso_random_select_stream(TEST_SEED, 11, FSO_RNG_STREAM_DATA);
+    fso_random_bytes_fill(bytes_b, sizeof(bytes_b));
+    TEST_ASSERT(memcmp(bytes_a, bytes_b, sizeof(bytes_a)) == 0,
+                "Byte fill matches between thread and explicit streams");
+}
+
+/* ============================================================================
+ * Thread Pool Tests
+ * ============================================================================ */
+
+/**
+ * @brief Per-packet draws written by a parallel loop
+ */
+typedef struct {
+    double* noise;
+    double* uniform;
+} PacketDraws;
+
+/**
+ * @brief Loop body: each packet selects its own streams on whichever worker runs it
+ */
+static void draw_packets(void* context, size_t begin, size_t end, int worker) {
+    PacketDraws* draws = (PacketDraws*)context;
+    (void)worker;
+    
+    for (size_t p = begin; p < end; p++) {
+        fso_random_select_stream(TEST_SEED, (uint32_t)p, FSO_RNG_STREAM_NOISE);
+        fso_random_gaussian_fill(draws->noise + p * TEST_DRAWS_PER_PACKET,
+                                 TEST_DRAWS_PER_PACKET, 1.0);
+        
+        fso_random_select_stream(TEST_SEED, (uint32_t)p, FSO_RNG_STREAM_CHANNEL);
+        for (int i = 0; i < TEST_DRAWS_PER_PACKET; i++) {
+            draws->uniform[p * TEST_DRAWS_PER_PACKET + i] = fso_random_uniform();
+        }
+    }
+}
+
+/**
+ * @brief Run draw_packets on a pool of num_threads workers
+ */
+static int run_on_pool(int num_threads, size_t grain, PacketDraws* draws) {
+    FSOThreadPoolConfig config = { .num_threads = num_threads, .affinity = FSO_AFFINITY_NONE };
+    
+    fso_threadpool_shutdown();
+    if (fso_threadpool_init(&config) != FSO_SUCCESS) {
+        return 0;
+    }
+    fso_parallel_for(TEST_PACKETS, grain, 0, draw_packets, draws);
+    return 1;
+}
+
+/**
+ * @brief Draws depend only on (seed, packet, stream), not on the pool size or schedule
+ */
+static void test_threadpool_reproducibility(void) {
+    printf("\n=== Test: Thread Pool Reproducibility ===\n");
+    
+    static const struct { int threads; size_t grain; } runs[] = {
+        { 4, 0 }, { 4, 3 }, { 3, 1 }, { 8, 0 }
+    };
+    size_t total = (size_t)TEST_PACKETS * TEST_DRAWS_PER_PACKET;
+    PacketDraws reference = {
+        .noise = malloc(total * sizeof(double)),
+        .uniform = malloc(total * sizeof(double))
+    };
+    PacketDraws trial = {
+        .noise = malloc(total * sizeof(double)),
+        .uniform = malloc(total * sizeof(double))
+    };
+    if (reference.noise == NULL || reference.uniform == NULL ||
+        trial.noise == NULL || trial.uniform == NULL) {
+        TEST_ASSERT(0, "Draw buffers allocated");
+        goto cleanup;
+    }
+    
+    TEST_ASSERT(run_on_pool(1, 0, &reference) && fso_threadpool_size() == 1,
+                "Single-worker pool started");
+    
+    // The serial loop on the caller's own thread must agree as well
+    memset(trial.noise, 0, total * sizeof(double));
+    memset(trial.uniform, 0, total * sizeof(double));
+    draw_packets(&trial, 0, TEST_PACKETS, 0);
+    TEST_ASSERT(memcmp(reference.noise, trial.noise, total * sizeof(double)) == 0 &&
+                memcmp(reference.uniform, trial.uniform, total * sizeof(double)) == 0,
+                "Pool results match a plain serial loop");
+    
+    for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        char message[128];
+        
+        memset(trial.noise, 0, total * sizeof(double));
+        memset(trial.uniform, 0, total * sizeof(double));
+        int started = run_on_pool(runs[r].threads, runs[r].grain, &trial);
+        
+        snprintf(message, sizeof(message), "%d workers, grain %zu: identical draws",
+                 runs[r].threads, runs[r].grain);
+        TEST_ASSERT(started &&
+                    memcmp(reference.noise, trial.noise, total * sizeof(double)) == 0 &&
+                    memcmp(reference.uniform, trial.uniform, total * sizeof(double)) == 0,
+                    message);
+    }
+    
+cleanup:
+    fso_threadpool_shutdown();
+    free(reference.noise);
+    free(reference.uniform);
+    free(trial.noise);
+    free(trial.uniform);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void) {
+    printf("========================================\n");
+    printf("Random Stream Test Suite\n");
+    printf("========================================\n");
+    
+    fso_set_log_level(LOG_ERROR);
+    
+    // Run tests
+    test_stream_independence();
+    test_stream_moments();
+    test_fill_consistency();
+    test_threadpool_reproducibility();
+    
+    // Print summary
+    printf("\n========================================\n");
+    printf("Test Summary\n");
+    printf("========================================\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+    printf("Total:  %d\n", tests_passed + tests_failed);
+    printf("========================================\n");
+    
+    return (tests_failed == 0) ? 0 : 1;
+}